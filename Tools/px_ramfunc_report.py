@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (C) 2017 PX4 Development Team. All rights reserved.
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+
+"""
+px_ramfunc_report.py:
+Report occupancy of the RAM-resident .ramfunc section.
+
+Functions annotated with PX4_HOT_RAMFUNC are linked between the _sramfunc
+and _eramfunc markers inside .data and execute from SRAM instead of
+wait-stated flash. This script lists those functions with their sizes so
+the hot set can be kept in check: every byte here is taken from the RAM
+available for .data/.bss and the heap.
+"""
+
+from __future__ import print_function
+import argparse
+import subprocess
+import sys
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=".ramfunc section occupancy report")
+    parser.add_argument("--nm", default="nm",
+                        help="nm binary of the cross toolchain")
+    parser.add_argument("firmware", metavar="ELF",
+                        help="linked firmware ELF file")
+    args = parser.parse_args()
+
+    try:
+        out = subprocess.check_output(
+            [args.nm, "-S", "-C", args.firmware]).decode("utf-8", "replace")
+
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("Failed to run {:}: {:}".format(args.nm, e), file=sys.stderr)
+        return 1
+
+    start = end = None
+    symbols = []
+
+    for line in out.splitlines():
+        fields = line.split(None, 3)
+
+        if len(fields) < 3:
+            continue
+
+        if fields[-1] == "_sramfunc":
+            start = int(fields[0], 16)
+
+        elif fields[-1] == "_eramfunc":
+            end = int(fields[0], 16)
+
+        elif len(fields) == 4 and fields[2] in ("t", "T"):
+            symbols.append((int(fields[0], 16), int(fields[1], 16),
+                            fields[3]))
+
+    if start is None or end is None:
+        print("No _sramfunc/_eramfunc markers found in {:}".format(
+            args.firmware), file=sys.stderr)
+        print("(is this an STM32 target with .ramfunc in its ld.script?)",
+              file=sys.stderr)
+        return 1
+
+    print(".ramfunc section of {:}".format(args.firmware))
+
+    for addr, size, name in sorted(s for s in symbols
+                                   if start <= s[0] < end):
+        print("  0x{:08x} {:6d} B  {:}".format(addr, size, name))
+
+    print("total: {:} B of SRAM used for hot functions".format(end - start))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,10 +1,16 @@
 #!/bin/bash
 # run multiple instances of the 'px4' binary, but w/o starting the simulator.
 # It assumes px4 is already built, with 'make posix_sitl_default'
+#
+# The number of instances can be passed as the first argument (default 2).
+# Each vehicle runs 'px4 -i <n>', which creates its own instance_<n> working
+# directory and offsets the simulator UDP port by 10*<n>, so one simulator
+# host can serve the whole group from a single template config.
 
 sitl_num=2
+[ -n "$1" ] && sitl_num="$1"
 
-sim_port=15019
+sim_port=14560
 mav_port=15010
 mav_port2=15011
 
@@ -30,24 +36,19 @@ user=`whoami`
 n=1
 while [ $n -le $sitl_num ]; do
 	working_dir="instance_$n"
-	if [ ! -d $working_dir ]; then
-		mkdir -p "$working_dir"
-		pushd "$working_dir" &>/dev/null
-
-		# replace template config with configured ports of current instance
-		cat ${src_path}/${rc_script} | sed s/_SIMPORT_/${sim_port}/ | \
-			sed s/_MAVPORT_/${mav_port}/g | sed s/_MAVOPORT_/${mav_oport}/ | \
-			sed s/_MAVPORT2_/${mav_port2}/ | sed s/_MAVOPORT2_/${mav_oport2}/ > rcS
-		popd &>/dev/null
-	fi
-
-	pushd "$working_dir" &>/dev/null
-	echo "starting instance $n in $(pwd)"
-	sudo -b -u $user ../src/firmware/posix/px4 -d "$src_path" rcS >out.log 2>err.log
-	popd &>/dev/null
+	mkdir -p "$working_dir"
+
+	# replace template config with configured ports of current instance.
+	# The simulator port is left at the base value - the px4 binary offsets
+	# it per instance itself.
+	cat ${src_path}/${rc_script} | sed s/_SIMPORT_/${sim_port}/ | \
+		sed s/_MAVPORT_/${mav_port}/g | sed s/_MAVOPORT_/${mav_oport}/ | \
+		sed s/_MAVPORT2_/${mav_port2}/ | sed s/_MAVOPORT2_/${mav_oport2}/ > "$working_dir/rcS"
+
+	echo "starting instance $n in $(pwd)/$working_dir"
+	sudo -b -u $user ./src/firmware/posix/px4 -i $n -d "$src_path" "$build_path/$working_dir/rcS" >$working_dir/out.log 2>$working_dir/err.log
 
 	n=$(($n + 1))
-	sim_port=$(($sim_port + $port_step))
 	mav_port=$(($mav_port + $port_step))
 	mav_port2=$(($mav_port2 + $port_step))
 	mav_oport=$(($mav_oport + $port_step))
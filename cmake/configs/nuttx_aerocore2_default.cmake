@@ -49,6 +49,7 @@ set(config_module_list
 	systemcmds/perf
 	systemcmds/pwm
 	systemcmds/reboot
+	systemcmds/startup
 	#systemcmds/sd_bench
 	systemcmds/top
 	#systemcmds/topic_listener
@@ -37,6 +37,7 @@ set(config_module_list
 	systemcmds/hardfault_log
 	systemcmds/motor_test
 	systemcmds/reboot
+	systemcmds/startup
 	systemcmds/top
 	systemcmds/config
 	systemcmds/nshterm
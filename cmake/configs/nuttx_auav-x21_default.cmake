@@ -70,6 +70,7 @@ set(config_module_list
 	systemcmds/pwm
 	systemcmds/reboot
 	systemcmds/sd_bench
+	systemcmds/startup
 	systemcmds/top
 	systemcmds/topic_listener
 	systemcmds/ver
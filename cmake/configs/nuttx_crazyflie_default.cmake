@@ -28,6 +28,7 @@ set(config_module_list
 	systemcmds/pwm
 	systemcmds/esc_calib
 	systemcmds/reboot
+	systemcmds/startup
 	systemcmds/top
 	systemcmds/config
 	systemcmds/nshterm
@@ -74,6 +74,7 @@ set(config_module_list
 	systemcmds/dumpfile
 	systemcmds/ver
 	systemcmds/sd_bench
+	systemcmds/startup
 	systemcmds/motor_ramp
 
 	#
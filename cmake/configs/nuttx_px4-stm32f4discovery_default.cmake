@@ -21,6 +21,7 @@ set(config_module_list
 	systemcmds/param
 	systemcmds/perf
 	systemcmds/reboot
+	systemcmds/startup
 	systemcmds/top
 	systemcmds/config
 	systemcmds/nshterm
@@ -4,6 +4,10 @@ px4_nuttx_configure(HWCLASS m4 CONFIG nsh ROMFS y ROMFSROOT px4fmu_common)
 
 set(CMAKE_TOOLCHAIN_FILE ${PX4_SOURCE_DIR}/cmake/toolchains/Toolchain-arm-none-eabi.cmake)
 
+# FMUv1 carries at most two instances of any sensor type (mpu6000 + l3gd20
+# gyros); cap the sensors module state arrays accordingly to save RAM/cycles
+add_definitions(-DBOARD_MAX_SENSOR_INSTANCES=2)
+
 set(config_module_list
 	#
 	# Board support modules
@@ -49,14 +53,18 @@ set(config_module_list
 	# System commands
 	#
 	systemcmds/bl_update
+	systemcmds/bootlog
+	systemcmds/imu_capture
 	systemcmds/mixer
 	systemcmds/param
 	systemcmds/perf
 	systemcmds/pwm
 	systemcmds/esc_calib
 	systemcmds/reboot
+	systemcmds/startup
 	systemcmds/top
 	systemcmds/config
+	systemcmds/dmesg
 	systemcmds/nshterm
 	systemcmds/mtd
 	systemcmds/dumpfile
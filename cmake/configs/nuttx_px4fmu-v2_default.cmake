@@ -59,10 +59,14 @@ set(config_module_list
 	# System commands
 	#
 	systemcmds/bl_update
+	systemcmds/bootlog
 	systemcmds/config
+	systemcmds/dmesg
 	#systemcmds/dumpfile
 	#systemcmds/esc_calib
 	systemcmds/hardfault_log
+	systemcmds/heapinfo
+	systemcmds/imu_capture
 	systemcmds/mixer
 	#systemcmds/motor_ramp
 	systemcmds/mtd
@@ -71,6 +75,8 @@ set(config_module_list
 	systemcmds/perf
 	systemcmds/pwm
 	systemcmds/reboot
+	systemcmds/scope_trace
+	systemcmds/startup
 	#systemcmds/sd_bench
 	systemcmds/top
 	#systemcmds/topic_listener
@@ -62,10 +62,14 @@ set(config_module_list
 	# System commands
 	#
 	systemcmds/bl_update
+	systemcmds/bootlog
 	systemcmds/config
+	systemcmds/dmesg
 	systemcmds/dumpfile
 	systemcmds/esc_calib
 	systemcmds/hardfault_log
+	systemcmds/heapinfo
+	systemcmds/imu_capture
 	systemcmds/led_control
 	systemcmds/mixer
 	systemcmds/motor_ramp
@@ -76,7 +80,9 @@ set(config_module_list
 	systemcmds/perf
 	systemcmds/pwm
 	systemcmds/reboot
+	systemcmds/scope_trace
 	systemcmds/sd_bench
+	systemcmds/startup
 	systemcmds/top
 	systemcmds/topic_listener
 	systemcmds/ver
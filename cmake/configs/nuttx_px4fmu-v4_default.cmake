@@ -63,22 +63,29 @@ set(config_module_list
 	# System commands
 	#
 	systemcmds/bl_update
+	systemcmds/bootlog
 	systemcmds/led_control
 	systemcmds/mixer
 	systemcmds/param
 	systemcmds/perf
+	systemcmds/profiler
 	systemcmds/pwm
 	systemcmds/esc_calib
 	systemcmds/hardfault_log
+	systemcmds/heapinfo
+	systemcmds/imu_capture
 	systemcmds/reboot
+	systemcmds/scope_trace
 	systemcmds/topic_listener
 	systemcmds/top
 	systemcmds/config
+	systemcmds/dmesg
 	systemcmds/nshterm
 	systemcmds/mtd
 	systemcmds/dumpfile
 	systemcmds/ver
 	systemcmds/sd_bench
+	systemcmds/startup
 	systemcmds/motor_ramp
 
 	#
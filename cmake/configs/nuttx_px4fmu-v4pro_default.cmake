@@ -63,10 +63,14 @@ set(config_module_list
 	# System commands
 	#
 	systemcmds/bl_update
+	systemcmds/bootlog
 	systemcmds/config
+	systemcmds/dmesg
 	systemcmds/dumpfile
 	systemcmds/esc_calib
 	systemcmds/hardfault_log
+	systemcmds/heapinfo
+	systemcmds/imu_capture
 	systemcmds/led_control
 	systemcmds/mixer
 	systemcmds/motor_ramp
@@ -74,9 +78,12 @@ set(config_module_list
 	systemcmds/nshterm
 	systemcmds/param
 	systemcmds/perf
+	systemcmds/profiler
 	systemcmds/pwm
 	systemcmds/reboot
+	systemcmds/scope_trace
 	systemcmds/sd_bench
+	systemcmds/startup
 	systemcmds/top
 	systemcmds/topic_listener
 	systemcmds/ver
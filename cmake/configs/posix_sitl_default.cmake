@@ -32,6 +32,7 @@ set(config_module_list
 	#systemcmds/bl_update
 	#systemcmds/config
 	#systemcmds/dumpfile
+	systemcmds/bootlog
 	systemcmds/esc_calib
 	systemcmds/led_control
 	systemcmds/mixer
@@ -42,10 +43,12 @@ set(config_module_list
 	systemcmds/perf
 	systemcmds/pwm
 	systemcmds/reboot
+	systemcmds/scope_trace
 	systemcmds/sd_bench
 	systemcmds/top
 	systemcmds/topic_listener
 	systemcmds/ver
+	systemcmds/wqstat
 
 	#
 	# Testing
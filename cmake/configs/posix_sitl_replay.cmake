@@ -10,6 +10,7 @@ set(config_module_list
 	platforms/posix/work_queue
 	systemcmds/param
 	systemcmds/ver
+	systemcmds/wqstat
 	systemcmds/perf
 	modules/uORB
 	modules/systemlib/param
@@ -96,7 +96,7 @@ function(px4_posix_generate_builtin_commands)
 		endforeach()
 		if (MAIN)
 			set(builtin_apps_string
-				"${builtin_apps_string}\tapps[\"${MAIN}\"] = ${MAIN}_main;\n")
+				"${builtin_apps_string}\t{\"${MAIN}\", ${MAIN}_main},\n")
 			set(builtin_apps_decl_string
 				"${builtin_apps_decl_string}int ${MAIN}_main(int argc, char *argv[]);\n")
 			math(EXPR command_count "${command_count}+1")
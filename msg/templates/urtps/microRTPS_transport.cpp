@@ -29,13 +29,18 @@
  * POSSIBILITY OF SUCH DAMAGE.
  *
  ****************************************************************************/
-#include <unistd.h>
 #include <fcntl.h>
 #include <termios.h>
 #include <stdio.h>
 #include <errno.h>
+#include <unistd.h>
 #include <sys/socket.h>
 
+#ifndef __PX4_NUTTX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif /* __PX4_NUTTX */
+
 #include "microRTPS_transport.h"
 
 #define DEFAULT_UART "/dev/ttyACM0"
@@ -76,7 +81,7 @@ uint16_t const crc16_table[256] = {
 	0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
 };
 
-Transport_node::Transport_node(): rx_buff_pos(0)
+Transport_node::Transport_node(): rx_buff_pos(0), tx_seq(0)
 {
 }
 
@@ -210,14 +215,12 @@ ssize_t Transport_node::write(const uint8_t topic_ID, char buffer[], size_t leng
 
 	};
 
-	static uint8_t seq = 0;
-
 	// [>,>,>,topic_ID,seq,payload_length,CRCHigh,CRCLow,payload_start, ... ,payload_end]
 
 	uint16_t crc = crc16((uint8_t *)buffer, length);
 
 	header.topic_ID = topic_ID;
-	header.seq = seq++;
+	header.seq = tx_seq++;
 	header.payload_len_h = (length >> 8) & 0xff;
 	header.payload_len_l = length & 0xff;
 	header.crc_h = (crc >> 8) & 0xff;
@@ -245,6 +248,40 @@ err:
 	return len;
 }
 
+ssize_t Transport_node::frame_message(const uint8_t topic_ID, const char *buffer, size_t length, char *out_buffer)
+{
+	if (nullptr == buffer || nullptr == out_buffer) {
+		return -1;
+	}
+
+	struct Header *header = reinterpret_cast<struct Header *>(out_buffer);
+
+	uint16_t crc = crc16((uint8_t const *)buffer, length);
+
+	header->marker[0] = '>';
+	header->marker[1] = '>';
+	header->marker[2] = '>';
+	header->topic_ID = topic_ID;
+	header->seq = tx_seq++;
+	header->payload_len_h = (length >> 8) & 0xff;
+	header->payload_len_l = length & 0xff;
+	header->crc_h = (crc >> 8) & 0xff;
+	header->crc_l = crc & 0xff;
+
+	memcpy(out_buffer + sizeof(struct Header), buffer, length);
+
+	return length + sizeof(struct Header);
+}
+
+ssize_t Transport_node::write_raw(char *buffer, size_t length)
+{
+	if (!fds_OK()) {
+		return -1;
+	}
+
+	return node_write(buffer, length);
+}
+
 UART_node::UART_node(const char *_uart_name, uint32_t _baudrate, uint32_t _poll_ms):
 	uart_fd(-1),
 	baudrate(_baudrate),
@@ -500,3 +537,257 @@ ssize_t UDP_node::node_write(void *buffer, size_t len)
 #endif /* __PX4_NUTTX */
 	return ret;
 }
+
+
+SHM_node::SHM_node(const char *_shm_name, uint32_t _ring_size, bool _is_creator):
+	shm_fd(-1),
+	ring_size(_ring_size),
+	is_creator(_is_creator),
+	region(nullptr),
+	pending_payload(nullptr),
+	pending_head(0)
+{
+	if (nullptr != _shm_name) {
+		strcpy(shm_name, _shm_name);
+	}
+
+	// round the ring up to a multiple of the record alignment
+	ring_size = (ring_size + 3u) & ~3u;
+}
+
+SHM_node::~SHM_node()
+{
+	close();
+}
+
+#define SHM_REGION_MAGIC 0x75525053u	// "uRPS"
+
+int SHM_node::init()
+{
+#ifndef __PX4_NUTTX
+	size_t region_size = sizeof(RegionHeader) + 2 * ring_size;
+
+	shm_fd = shm_open(shm_name, is_creator ? (O_RDWR | O_CREAT) : O_RDWR, 0666);
+
+	if (shm_fd < 0) {
+		printf("failed to open shared memory %s (%d)\n", shm_name, errno);
+		return -errno;
+	}
+
+	if (is_creator && ftruncate(shm_fd, region_size) != 0) {
+		int errno_bkp = errno;
+		printf("failed to size shared memory %s (%d)\n", shm_name, errno);
+		close();
+		return -errno_bkp;
+	}
+
+	void *map = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+
+	if (MAP_FAILED == map) {
+		int errno_bkp = errno;
+		printf("failed to map shared memory %s (%d)\n", shm_name, errno);
+		close();
+		return -errno_bkp;
+	}
+
+	region = (RegionHeader *)map;
+
+	if (is_creator) {
+		memset(region, 0, sizeof(RegionHeader));
+		region->ring_size = ring_size;
+		// publish the magic last so an attacher never sees a half-built region
+		__atomic_store_n(&region->magic, SHM_REGION_MAGIC, __ATOMIC_RELEASE);
+
+	} else {
+		if (__atomic_load_n(&region->magic, __ATOMIC_ACQUIRE) != SHM_REGION_MAGIC
+		    || region->ring_size != ring_size) {
+			printf("shared memory %s not initialized or ring size mismatch\n", shm_name);
+			close();
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+#else
+	printf("shared-memory transport not supported on this platform\n");
+	return -1;
+#endif /* __PX4_NUTTX */
+}
+
+uint8_t SHM_node::close()
+{
+#ifndef __PX4_NUTTX
+
+	if (nullptr != region) {
+		printf("Close shared memory\n");
+		munmap(region, sizeof(RegionHeader) + 2 * ring_size);
+		region = nullptr;
+	}
+
+	if (-1 != shm_fd) {
+		::close(shm_fd);
+		shm_fd = -1;
+
+		if (is_creator) {
+			shm_unlink(shm_name);
+		}
+	}
+
+#endif /* __PX4_NUTTX */
+	return 0;
+}
+
+bool SHM_node::fds_OK()
+{
+	return (nullptr != region);
+}
+
+uint8_t *SHM_node::ring_data(unsigned ring_index)
+{
+	return (uint8_t *)(region + 1) + ring_index * ring_size;
+}
+
+/*
+ * Reserve header + payload space in the outgoing ring. The record stays
+ * invisible to the consumer until write_commit() publishes the new head.
+ */
+bool SHM_node::ring_reserve(size_t payload_len)
+{
+	RingControl *ring = &region->ring[is_creator ? 0 : 1];
+	uint8_t *data = ring_data(is_creator ? 0 : 1);
+
+	uint32_t record_len = sizeof(RecordHeader) + ((payload_len + 3u) & ~3u);
+
+	if (record_len >= ring_size) {
+		return false;
+	}
+
+	uint32_t head = ring->head;
+	uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+	uint32_t offset = head % ring_size;
+
+	// records are contiguous: if the record would wrap, pad to the ring start
+	if (offset + record_len > ring_size) {
+		uint32_t pad_len = ring_size - offset;
+
+		if (ring_size - (head - tail) < pad_len + record_len) {
+			return false;	// ring full, drop at the producer
+		}
+
+		struct RecordHeader *pad = (struct RecordHeader *)(data + offset);
+		pad->payload_len = 0xFFFFu;
+		pad->topic_ID = 0xFFu;
+		pad->padding = 0u;
+		__atomic_store_n(&ring->head, head + pad_len, __ATOMIC_RELEASE);
+
+		head += pad_len;
+		offset = 0;
+
+	} else if (ring_size - (head - tail) < record_len) {
+		return false;		// ring full, drop at the producer
+	}
+
+	pending_payload = (char *)(data + offset + sizeof(RecordHeader));
+	pending_head = head;
+	return true;
+}
+
+char *SHM_node::write_reserve(size_t length)
+{
+	if (!fds_OK() || !ring_reserve(length)) {
+		return nullptr;
+	}
+
+	return pending_payload;
+}
+
+ssize_t SHM_node::write_commit(const uint8_t topic_ID, size_t length)
+{
+	if (!fds_OK() || nullptr == pending_payload) {
+		return -1;
+	}
+
+	RingControl *ring = &region->ring[is_creator ? 0 : 1];
+	uint8_t *data = ring_data(is_creator ? 0 : 1);
+
+	struct RecordHeader *header = (struct RecordHeader *)(data + pending_head % ring_size);
+	header->payload_len = length;
+	header->topic_ID = topic_ID;
+	header->padding = 0u;
+
+	// publish header and payload to the consumer in one step
+	__atomic_store_n(&ring->head, pending_head + sizeof(RecordHeader) + ((length + 3u) & ~3u), __ATOMIC_RELEASE);
+
+	pending_payload = nullptr;
+	return length;
+}
+
+ssize_t SHM_node::write(const uint8_t topic_ID, char buffer[], size_t length)
+{
+	// copying fallback for callers that serialized into their own buffer
+	char *out = write_reserve(length);
+
+	if (nullptr == out) {
+		return -1;
+	}
+
+	memcpy(out, buffer, length);
+	return write_commit(topic_ID, length);
+}
+
+ssize_t SHM_node::read(uint8_t *topic_ID, char out_buffer[], size_t buffer_len)
+{
+	if (nullptr == out_buffer || nullptr == topic_ID || !fds_OK()) {
+		return -1;
+	}
+
+	RingControl *ring = &region->ring[is_creator ? 1 : 0];
+	uint8_t *data = ring_data(is_creator ? 1 : 0);
+
+	*topic_ID = 255;
+
+	for (;;) {
+		uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+		uint32_t tail = ring->tail;
+
+		if (head == tail) {
+			return 0;	// nothing pending
+		}
+
+		uint32_t offset = tail % ring_size;
+		struct RecordHeader *header = (struct RecordHeader *)(data + offset);
+
+		if (header->payload_len == 0xFFFFu) {
+			// pad record: the producer wrapped to the ring start
+			__atomic_store_n(&ring->tail, tail + (ring_size - offset), __ATOMIC_RELEASE);
+			continue;
+		}
+
+		uint32_t payload_len = header->payload_len;
+
+		if (buffer_len < payload_len) {
+			return -EMSGSIZE;
+		}
+
+		memcpy(out_buffer, data + offset + sizeof(RecordHeader), payload_len);
+		*topic_ID = header->topic_ID;
+
+		__atomic_store_n(&ring->tail, tail + sizeof(RecordHeader) + ((payload_len + 3u) & ~3u), __ATOMIC_RELEASE);
+
+		return payload_len;
+	}
+}
+
+ssize_t SHM_node::node_read(void *buffer, size_t len)
+{
+	(void)buffer;
+	(void)len;
+	return -1;
+}
+
+ssize_t SHM_node::node_write(void *buffer, size_t len)
+{
+	(void)buffer;
+	(void)len;
+	return -1;
+}
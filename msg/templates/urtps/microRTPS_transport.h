@@ -45,8 +45,24 @@ public:
 
 	virtual int init() {return 0;}
 	virtual uint8_t close() {return 0;}
-	ssize_t read(uint8_t *topic_ID, char out_buffer[], size_t buffer_len);
-	ssize_t write(const uint8_t topic_ID, char buffer[], size_t length);
+	virtual ssize_t read(uint8_t *topic_ID, char out_buffer[], size_t buffer_len);
+	virtual ssize_t write(const uint8_t topic_ID, char buffer[], size_t length);
+
+	/** Zero-copy write path: reserve space in the transport's outgoing buffer so the
+	 *  caller can serialize directly into it, then commit the finished message.
+	 *  Transports that cannot hand out an in-place buffer return nullptr from
+	 *  write_reserve() and callers fall back to write(). */
+	virtual char *write_reserve(size_t length) {(void)length; return nullptr;}
+	virtual ssize_t write_commit(const uint8_t topic_ID, size_t length) {(void)topic_ID; (void)length; return -1;}
+
+	/** Frame a message into a caller provided buffer without sending it.
+	 *  Several framed messages can then go out in a single write_raw() call -
+	 *  on a UART link that is one syscall and one start of transmission for
+	 *  the whole batch. The byte stream is identical to repeated write()
+	 *  calls, so the receive side needs no changes. */
+	ssize_t frame_message(const uint8_t topic_ID, const char *buffer, size_t length, char *out_buffer);
+	ssize_t write_raw(char *buffer, size_t length);
+	size_t header_length() const {return sizeof(struct Header);}
 
 protected:
 	virtual ssize_t node_read(void *buffer, size_t len) = 0;
@@ -58,6 +74,7 @@ protected:
 protected:
 	uint32_t rx_buff_pos;
 	char rx_buffer[1024] = {};
+	uint8_t tx_seq;
 
 private:
 	struct __attribute__((packed)) Header {
@@ -116,3 +133,72 @@ protected:
 	struct sockaddr_in receiver_inaddr;
 	struct sockaddr_in receiver_outaddr;
 };
+
+/**
+ * Shared-memory transport for boards where the companion processor shares RAM
+ * with the flight controller (Snapdragon-style). A POSIX shared-memory region
+ * holds two single-producer/single-consumer byte rings, one per direction, so
+ * a message crosses to the other side without a serial link and without the
+ * marker/CRC framing the byte-stream transports need. write_reserve() hands
+ * out a pointer straight into the outgoing ring, which lets the caller do the
+ * CDR serialization in place (one copy from the uORB buffer, nothing more).
+ *
+ * The creator side (the flight stack) sizes and initializes the region; the
+ * attacher side (the agent) maps the existing region and uses the rings with
+ * the directions swapped.
+ */
+class SHM_node: public Transport_node
+{
+public:
+	SHM_node(const char *shm_name, uint32_t ring_size, bool is_creator);
+	virtual ~SHM_node();
+
+	int init();
+	uint8_t close();
+
+	virtual ssize_t read(uint8_t *topic_ID, char out_buffer[], size_t buffer_len);
+	virtual ssize_t write(const uint8_t topic_ID, char buffer[], size_t length);
+	virtual char *write_reserve(size_t length);
+	virtual ssize_t write_commit(const uint8_t topic_ID, size_t length);
+
+protected:
+	// unused: the ring transport overrides read()/write() as a whole
+	ssize_t node_read(void *buffer, size_t len);
+	ssize_t node_write(void *buffer, size_t len);
+	bool fds_OK();
+
+private:
+	/* control block of one ring. head is only written by the producer, tail
+	 * only by the consumer; both are free-running counters (index = pos % size) */
+	struct __attribute__((aligned(8))) RingControl {
+		uint32_t head;
+		uint32_t tail;
+	};
+
+	/* every record is 4-byte aligned so CDR can serialize into the payload in
+	 * place. A payload_len of 0xFFFF is a pad record: skip to the ring start */
+	struct __attribute__((packed)) RecordHeader {
+		uint16_t payload_len;
+		uint8_t topic_ID;
+		uint8_t padding;
+	};
+
+	struct RegionHeader {
+		uint32_t magic;
+		uint32_t ring_size;
+		RingControl ring[2];	/**< [0]: creator->attacher, [1]: attacher->creator */
+	};
+
+	uint8_t *ring_data(unsigned ring_index);
+	bool ring_reserve(size_t payload_len);
+
+	int shm_fd;
+	char shm_name[64] = {};
+	uint32_t ring_size;
+	bool is_creator;
+	RegionHeader *region;
+
+	/* reservation state between write_reserve() and write_commit() */
+	char *pending_payload;
+	uint32_t pending_head;
+};
@@ -41,6 +41,8 @@
 #include <px4_config.h>
 #include <drivers/device/device.h>
 
+#include <math.h>
+
 #include <drivers/device/i2c.h>
 
 #include <systemlib/airspeed.h>
@@ -72,7 +74,10 @@ Airspeed::Airspeed(int bus, int address, unsigned conversion_interval, const cha
 	_class_instance(-1),
 	_conversion_interval(conversion_interval),
 	_sample_perf(perf_alloc(PC_ELAPSED, "aspd_read")),
-	_comms_errors(perf_alloc(PC_COUNT, "aspd_com_err"))
+	_comms_errors(perf_alloc(PC_COUNT, "aspd_com_err")),
+	_spike_rejects(perf_alloc(PC_COUNT, "aspd_spike")),
+	_spike_buf{},
+	_spike_fill(0)
 {
 	// enable debug() calls
 	_debug_enabled = false;
@@ -98,6 +103,7 @@ Airspeed::~Airspeed()
 	// free perf counters
 	perf_free(_sample_perf);
 	perf_free(_comms_errors);
+	perf_free(_spike_rejects);
 }
 
 int
@@ -385,10 +391,40 @@ Airspeed::print_info()
 {
 	perf_print_counter(_sample_perf);
 	perf_print_counter(_comms_errors);
+	perf_print_counter(_spike_rejects);
 	warnx("poll interval:  %u ticks", _measure_ticks);
 	_reports->print_info("report queue");
 }
 
+float
+Airspeed::spike_filter(float sample)
+{
+	_spike_buf[0] = _spike_buf[1];
+	_spike_buf[1] = _spike_buf[2];
+	_spike_buf[2] = sample;
+
+	if (_spike_fill < 3) {
+		/* history not filled yet */
+		_spike_fill++;
+		return sample;
+	}
+
+	const float a = _spike_buf[0];
+	const float b = _spike_buf[1];
+	const float c = _spike_buf[2];
+
+	/* median of the last three conversions */
+	float median = (a < b) ? ((b < c) ? b : ((a < c) ? c : a))
+		       : ((a < c) ? a : ((b < c) ? c : b));
+
+	/* only count rejections clearly beyond conversion noise */
+	if (fabsf(sample - median) > 10.0f) {
+		perf_count(_spike_rejects);
+	}
+
+	return median;
+}
+
 void
 Airspeed::new_report(const differential_pressure_s &report)
 {
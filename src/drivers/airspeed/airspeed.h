@@ -117,6 +117,21 @@ protected:
 
 	perf_counter_t		_sample_perf;
 	perf_counter_t		_comms_errors;
+	perf_counter_t		_spike_rejects;
+
+	float			_spike_buf[3];
+	uint8_t			_spike_fill;
+
+	/**
+	* Median-of-3 spike rejection on the raw differential pressure.
+	*
+	* A single-conversion glitch is replaced by one of its neighbours
+	* and counted; real pressure steps pass with one sample of delay.
+	*
+	* @param sample	latest raw conversion in Pa
+	* @return	median of the last three conversions
+	*/
+	float	spike_filter(float sample);
 
 
 	/**
@@ -565,14 +565,15 @@ BATT_SMBUS::start()
 	// reset the report ring and state machine
 	_reports->flush();
 
-	// schedule a cycle to start things
-	work_queue(HPWORK, &_work, (worker_t)&BATT_SMBUS::cycle_trampoline, this, 1);
+	// schedule a cycle to start things; the slow SMBus block reads run on the
+	// low priority queue so they cannot delay time-critical sensor cycles
+	work_queue(LPWORK, &_work, (worker_t)&BATT_SMBUS::cycle_trampoline, this, 1);
 }
 
 void
 BATT_SMBUS::stop()
 {
-	work_cancel(HPWORK, &_work);
+	work_cancel(LPWORK, &_work);
 }
 
 void
@@ -731,7 +732,7 @@ BATT_SMBUS::cycle()
 	}
 
 	// schedule a fresh cycle call when the measurement is done
-	work_queue(HPWORK, &_work, (worker_t)&BATT_SMBUS::cycle_trampoline, this,
+	work_queue(LPWORK, &_work, (worker_t)&BATT_SMBUS::cycle_trampoline, this,
 		   USEC2TICK(BATT_SMBUS_MEASUREMENT_INTERVAL_US));
 }
 
@@ -252,6 +252,10 @@
 #define GPIO_TIM4_CH3IN              GPIO_TIM4_CH3IN_2
 #define DIRECT_INPUT_TIMER_CHANNELS  6
 
+/* DShot output: DMA streams serving the update event of each io_timer
+ * (TIM1_UP on DMA2 and TIM4_UP on DMA1) */
+#define BOARD_DSHOT_DMAMAP           {DMAMAP_TIM1_UP, DMAMAP_TIM4_UP}
+
 /* USB OTG FS
  *
  * PA9  OTG_FS_VBUS VBUS sensing
@@ -65,6 +65,7 @@
 #include <uORB/topics/vehicle_global_position.h>
 
 #include <drivers/drv_hrt.h>
+#include <drivers/drv_input_capture.h>
 
 #include "interfaces/src/camera_interface.h"
 #include "interfaces/src/gpio.h"
@@ -160,6 +161,31 @@ private:
 
 	static struct work_s	_work;
 
+	/**
+	 * A trigger waiting for its hardware capture event. Filled in interrupt
+	 * context by engage(), matched against capture edges in the work queue.
+	 */
+	struct correlation_entry_t {
+		uint32_t	seq;		///< trigger sequence number
+		hrt_abstime	trigger_time;	///< time the trigger command went out
+		uint64_t	trigger_utc;	///< UTC time of the trigger command
+	};
+
+	static const unsigned	_capture_queue_len = 8;
+
+	correlation_entry_t	_pending_triggers[_capture_queue_len];
+	volatile unsigned	_pending_head;
+	volatile unsigned	_pending_tail;
+
+	hrt_abstime		_capture_times[_capture_queue_len];
+	volatile unsigned	_capture_head;
+	volatile unsigned	_capture_tail;
+
+	int			_capture_channel;	///< input capture channel, -1 if disabled
+	uint32_t		_capture_matched;	///< captures correlated to a trigger
+	uint32_t		_capture_expired;	///< triggers published without a capture event
+	uint32_t		_capture_overruns;	///< queue overruns / stray capture edges
+
 	float			_activation_time;
 	float			_interval;
 	float 			_distance;
@@ -183,12 +209,26 @@ private:
 	param_t			_p_interval;
 	param_t			_p_distance;
 	param_t			_p_interface;
+	param_t			_p_capture_channel;
 
 	trigger_mode_t		_trigger_mode;
 
 	camera_interface_mode_t	_camera_interface_mode;
 	CameraInterface		*_camera_interface;  ///< instance of camera interface
 
+	/**
+	 * Publish a camera_trigger message for one exposure
+	 */
+	void		publish_trigger(const hrt_abstime &timestamp, uint64_t timestamp_utc, uint32_t seq);
+	/**
+	 * Match queued hardware capture events against pending triggers
+	 */
+	void		update_capture_correlation();
+	/**
+	 * Hardware input capture handler (interrupt context)
+	 */
+	static void	capture_trampoline(void *context, uint32_t chan_index,
+					   hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow);
 	/**
 	 * Vehicle command handler
 	 */
@@ -235,6 +275,16 @@ CameraTrigger::CameraTrigger() :
 	_disengage_turn_on_off_call {},
 	_keepalivecall_up {},
 	_keepalivecall_down {},
+	_pending_triggers {},
+	_pending_head(0),
+	_pending_tail(0),
+	_capture_times {},
+	_capture_head(0),
+	_capture_tail(0),
+	_capture_channel(-1),
+	_capture_matched(0),
+	_capture_expired(0),
+	_capture_overruns(0),
 	_activation_time(0.5f /* ms */),
 	_interval(100.0f /* ms */),
 	_distance(25.0f /* m */),
@@ -269,6 +319,7 @@ CameraTrigger::CameraTrigger() :
 	_p_activation_time = param_find("TRIG_ACT_TIME");
 	_p_mode = param_find("TRIG_MODE");
 	_p_interface = param_find("TRIG_INTERFACE");
+	_p_capture_channel = param_find("TRIG_CAP_CHAN");
 
 	param_get(_p_activation_time, &_activation_time);
 	param_get(_p_interval, &_interval);
@@ -276,6 +327,14 @@ CameraTrigger::CameraTrigger() :
 	param_get(_p_mode, &_trigger_mode);
 	param_get(_p_interface, &_camera_interface_mode);
 
+	// capture channel is 1-based in the parameter, -1 when feedback is disabled
+	int32_t capture_channel = 0;
+	param_get(_p_capture_channel, &capture_channel);
+
+	if (capture_channel >= 1 && capture_channel <= INPUT_CAPTURE_MAX_CHANNELS) {
+		_capture_channel = capture_channel - 1;
+	}
+
 	switch (_camera_interface_mode) {
 #ifdef __PX4_NUTTX
 
@@ -459,6 +518,21 @@ CameraTrigger::start()
 		_trigger_enabled = true;
 	}
 
+#ifdef __PX4_NUTTX
+
+	// attach to the exposure feedback line (e.g. camera hot shoe) if configured
+	if (_capture_channel >= 0) {
+		if (up_input_capture_set(_capture_channel, Rising, 0,
+					 &CameraTrigger::capture_trampoline, this) != 0) {
+			PX4_WARN("capture channel %i setup failed, feedback disabled", _capture_channel + 1);
+			_capture_channel = -1;
+		}
+	}
+
+#else
+	_capture_channel = -1;
+#endif
+
 	// start to monitor at high rate for trigger enable command
 	work_queue(LPWORK, &_work, (worker_t)&CameraTrigger::cycle_trampoline, this, USEC2TICK(1));
 
@@ -475,6 +549,14 @@ CameraTrigger::stop()
 	hrt_cancel(&_keepalivecall_up);
 	hrt_cancel(&_keepalivecall_down);
 
+#ifdef __PX4_NUTTX
+
+	if (_capture_channel >= 0) {
+		up_input_capture_set(_capture_channel, Disabled, 0, nullptr, nullptr);
+	}
+
+#endif
+
 	if (camera_trigger::g_camera_trigger != nullptr) {
 		delete (camera_trigger::g_camera_trigger);
 	}
@@ -707,6 +789,11 @@ CameraTrigger::cycle_trampoline(void *arg)
 
 	}
 
+	// match hardware capture events against pending triggers
+	if (trig->_capture_channel >= 0) {
+		trig->update_capture_correlation();
+	}
+
 	// One shot command-based capture handling
 	if (trig->_one_shot && !trig->_turning_on) {
 
@@ -761,27 +848,128 @@ CameraTrigger::engage(void *arg)
 		return;
 	}
 
-	// Send camera trigger message. This messages indicates that we sent
-	// the camera trigger request. Does not guarantee capture.
-
-	struct camera_trigger_s	trigger = {};
-
 	// Set timestamp the instant after the trigger goes off
-	trigger.timestamp = hrt_absolute_time();
+	hrt_abstime now = hrt_absolute_time();
 
 	timespec tv = {};
 	px4_clock_gettime(CLOCK_REALTIME, &tv);
-	trigger.timestamp_utc = (uint64_t) tv.tv_sec * 1000000 + tv.tv_nsec / 1000;
+	uint64_t utc = (uint64_t) tv.tv_sec * 1000000 + tv.tv_nsec / 1000;
+
+	if (trig->_capture_channel >= 0) {
+		// hardware feedback enabled - queue the trigger and wait for the
+		// capture edge before publishing the (corrected) message
+		unsigned next = (trig->_pending_head + 1) % _capture_queue_len;
+
+		if (next != trig->_pending_tail) {
+			trig->_pending_triggers[trig->_pending_head].seq = trig->_trigger_seq;
+			trig->_pending_triggers[trig->_pending_head].trigger_time = now;
+			trig->_pending_triggers[trig->_pending_head].trigger_utc = utc;
+			trig->_pending_head = next;
 
-	trigger.seq = trig->_trigger_seq;
+		} else {
+			trig->_capture_overruns++;
+		}
 
-	orb_publish(ORB_ID(camera_trigger), trig->_trigger_pub, &trigger);
+	} else {
+		// Send camera trigger message. This messages indicates that we sent
+		// the camera trigger request. Does not guarantee capture.
+		struct camera_trigger_s	trigger = {};
+
+		trigger.timestamp = now;
+		trigger.timestamp_utc = utc;
+		trigger.seq = trig->_trigger_seq;
+
+		orb_publish(ORB_ID(camera_trigger), trig->_trigger_pub, &trigger);
+	}
 
 	// increment frame count
 	trig->_trigger_seq++;
 
 }
 
+void
+CameraTrigger::publish_trigger(const hrt_abstime &timestamp, uint64_t timestamp_utc, uint32_t seq)
+{
+	struct camera_trigger_s	trigger = {};
+
+	trigger.timestamp = timestamp;
+	trigger.timestamp_utc = timestamp_utc;
+	trigger.seq = seq;
+
+	orb_publish(ORB_ID(camera_trigger), _trigger_pub, &trigger);
+}
+
+void
+CameraTrigger::capture_trampoline(void *context, uint32_t chan_index,
+				  hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow)
+{
+	CameraTrigger *trig = reinterpret_cast<CameraTrigger *>(context);
+
+	// queue the edge timestamp, correlation happens in the work queue
+	unsigned next = (trig->_capture_head + 1) % _capture_queue_len;
+
+	if (next != trig->_capture_tail) {
+		trig->_capture_times[trig->_capture_head] = edge_time;
+		trig->_capture_head = next;
+
+	} else {
+		trig->_capture_overruns++;
+	}
+}
+
+void
+CameraTrigger::update_capture_correlation()
+{
+	// a trigger which has not seen its capture edge after this time is
+	// published with the (uncorrected) trigger command timestamp, so
+	// geotagging keeps working with a broken feedback line
+	static const hrt_abstime capture_timeout = 1000000;
+
+	while (_capture_tail != _capture_head) {
+
+		hrt_abstime capture_time = _capture_times[_capture_tail];
+
+		if (_pending_tail == _pending_head) {
+			// capture edge without a pending trigger (noise or manual shot)
+			_capture_overruns++;
+			_capture_tail = (_capture_tail + 1) % _capture_queue_len;
+			continue;
+		}
+
+		const correlation_entry_t &entry = _pending_triggers[_pending_tail];
+
+		if (capture_time < entry.trigger_time) {
+			// edge predates the oldest pending trigger, discard it
+			_capture_overruns++;
+			_capture_tail = (_capture_tail + 1) % _capture_queue_len;
+			continue;
+		}
+
+		// matched - publish with the exposure timestamp, shifting UTC by the
+		// measured trigger-to-exposure delay
+		publish_trigger(capture_time, entry.trigger_utc + (capture_time - entry.trigger_time), entry.seq);
+		_capture_matched++;
+
+		_capture_tail = (_capture_tail + 1) % _capture_queue_len;
+		_pending_tail = (_pending_tail + 1) % _capture_queue_len;
+	}
+
+	// time out triggers which never got a capture edge
+	while (_pending_tail != _pending_head) {
+
+		const correlation_entry_t &entry = _pending_triggers[_pending_tail];
+
+		if (hrt_elapsed_time(&entry.trigger_time) < capture_timeout) {
+			break;
+		}
+
+		publish_trigger(entry.trigger_time, entry.trigger_utc, entry.seq);
+		_capture_expired++;
+
+		_pending_tail = (_pending_tail + 1) % _capture_queue_len;
+	}
+}
+
 void
 CameraTrigger::disengage(void *arg)
 {
@@ -843,6 +1031,12 @@ CameraTrigger::status()
 	}
 
 	PX4_INFO("activation time : %.2f [ms]", (double)_activation_time);
+
+	if (_capture_channel >= 0) {
+		PX4_INFO("capture feedback : channel %i, %u matched, %u timed out, %u overruns",
+			 _capture_channel + 1, _capture_matched, _capture_expired, _capture_overruns);
+	}
+
 	_camera_interface->info();
 }
 
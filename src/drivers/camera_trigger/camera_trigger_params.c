@@ -124,6 +124,22 @@ PARAM_DEFINE_INT32(TRIG_MODE, 0);
  */
 PARAM_DEFINE_INT32(TRIG_PINS, 56);
 
+/**
+ * Camera trigger capture feedback channel
+ *
+ * Input capture channel connected to the camera exposure feedback line
+ * (e.g. hot shoe or flash output). When set, the camera_trigger message is
+ * published with the hardware-measured exposure timestamp instead of the
+ * trigger command time. Set to 0 to disable.
+ *
+ * @value 0 Disabled
+ * @min 0
+ * @max 6
+ * @reboot_required true
+ * @group Camera trigger
+ */
+PARAM_DEFINE_INT32(TRIG_CAP_CHAN, 0);
+
 /**
  * Camera trigger distance
  *
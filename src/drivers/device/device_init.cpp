@@ -0,0 +1,210 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file device_init.cpp
+ *
+ * Driver bring-up helpers: per-driver init timing and optional parallel
+ * initialisation.
+ */
+
+#include "device_init.h"
+
+#include <px4_config.h>
+#include <px4_tasks.h>
+#include <px4_sem.h>
+#include <px4_defines.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
+
+namespace device
+{
+
+namespace
+{
+
+struct init_entry {
+	char		name[24];	/**< perf counter name, "init: <driver>" */
+	int		(*init_fn)(void);
+	perf_counter_t	counter;
+	uint64_t	start_time;
+	int		result;
+	bool		done;
+};
+
+const unsigned		MAX_INIT_ENTRIES = 16;
+
+init_entry		_entries[MAX_INIT_ENTRIES];
+unsigned		_num_entries = 0;
+unsigned		_pending = 0;
+int			_spawn_slot = -1;
+
+px4_sem_t		_table_lock;
+px4_sem_t		_slot_sem;
+px4_sem_t		_done_sem;
+bool			_initialized = false;
+
+/* first call always comes from the (serial) startup script context,
+ * so lazy init of the semaphores is not racy */
+void
+ensure_initialized()
+{
+	if (!_initialized) {
+		px4_sem_init(&_table_lock, 0, 1);
+		px4_sem_init(&_slot_sem, 0, 0);
+		px4_sem_init(&_done_sem, 0, 0);
+		_initialized = true;
+	}
+}
+
+init_entry *
+alloc_entry(const char *name)
+{
+	if (_num_entries >= MAX_INIT_ENTRIES) {
+		return nullptr;
+	}
+
+	init_entry *e = &_entries[_num_entries++];
+	snprintf(e->name, sizeof(e->name), "init: %s", name);
+	e->counter = perf_alloc(PC_ELAPSED, e->name);
+	return e;
+}
+
+int
+init_trampoline(int argc, char *argv[])
+{
+	init_entry *e = &_entries[_spawn_slot];
+
+	/* let the spawner reuse the slot index */
+	px4_sem_post(&_slot_sem);
+
+	e->result = e->init_fn();
+	perf_set_elapsed(e->counter, hrt_absolute_time() - e->start_time);
+	e->done = true;
+	px4_sem_post(&_done_sem);
+
+	return 0;
+}
+
+} // namespace
+
+void
+init_record(const char *name, uint64_t start_time)
+{
+	ensure_initialized();
+
+	px4_sem_wait(&_table_lock);
+	init_entry *e = alloc_entry(name);
+	px4_sem_post(&_table_lock);
+
+	if (e == nullptr) {
+		return;
+	}
+
+	e->init_fn = nullptr;
+	e->start_time = start_time;
+	e->result = 0;
+	e->done = true;
+	perf_set_elapsed(e->counter, hrt_absolute_time() - start_time);
+}
+
+int
+init_spawn(const char *name, int (*init_fn)(void))
+{
+	ensure_initialized();
+
+	px4_sem_wait(&_table_lock);
+	init_entry *e = alloc_entry(name);
+	px4_sem_post(&_table_lock);
+
+	if (e == nullptr) {
+		return -ENOSPC;
+	}
+
+	e->init_fn = init_fn;
+	e->start_time = hrt_absolute_time();
+	e->result = 0;
+	e->done = false;
+
+	_spawn_slot = e - _entries;
+	_pending++;
+
+	int pid = px4_task_spawn_cmd(name,
+				     SCHED_DEFAULT,
+				     SCHED_PRIORITY_DEFAULT,
+				     1600,
+				     (px4_main_t)&init_trampoline,
+				     nullptr);
+
+	if (pid < 0) {
+		_pending--;
+		px4_sem_wait(&_table_lock);
+		perf_free(e->counter);
+		_num_entries--;
+		px4_sem_post(&_table_lock);
+		return -errno;
+	}
+
+	/* wait until the trampoline has picked up its slot */
+	px4_sem_wait(&_slot_sem);
+
+	return PX4_OK;
+}
+
+int
+init_wait(void)
+{
+	ensure_initialized();
+
+	while (_pending > 0) {
+		px4_sem_wait(&_done_sem);
+		_pending--;
+	}
+
+	int failures = 0;
+
+	for (unsigned i = 0; i < _num_entries; i++) {
+		if (_entries[i].done && _entries[i].result != 0) {
+			failures++;
+		}
+	}
+
+	return failures;
+}
+
+} // namespace device
@@ -0,0 +1,92 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file device_init.h
+ *
+ * Driver bring-up helpers: per-driver init timing and optional parallel
+ * initialisation.
+ *
+ * Sensor drivers spend most of their start time blocked in reset and
+ * probe delays. init_record() makes that time visible as a PC_ELAPSED
+ * perf counter named "init: <driver>", so the boot-time breakdown shows
+ * up in the output of the 'perf' command. init_spawn()/init_wait() let
+ * board bring-up code run several driver inits on their own tasks so
+ * those delays overlap instead of adding up.
+ */
+
+#ifndef _DEVICE_DEVICE_INIT_H
+#define _DEVICE_DEVICE_INIT_H
+
+#include <stdint.h>
+
+namespace device
+{
+
+/**
+ * Record a completed driver init for the boot-time breakdown.
+ *
+ * Creates (or reuses) a perf counter "init: <name>" holding the elapsed
+ * time since start_time. Call at the end of the driver's start path,
+ * on both the success and the failure exits - failed probes cost boot
+ * time too.
+ *
+ * @param name		Short driver name, e.g. "mpu6000".
+ * @param start_time	hrt_absolute_time() taken at the start of init.
+ */
+void	init_record(const char *name, uint64_t start_time);
+
+/**
+ * Run a driver init function on its own task so its probe/reset delays
+ * overlap with other drivers' init.
+ *
+ * The elapsed time is recorded as with init_record(). The caller must
+ * collect the results with init_wait() before relying on the driver
+ * being up.
+ *
+ * @param name		Short driver name, also used as the task name.
+ * @param init_fn	Init function; returns 0 on success.
+ * @return		OK if the task was spawned, -errno otherwise.
+ */
+int	init_spawn(const char *name, int (*init_fn)(void));
+
+/**
+ * Wait for all inits started with init_spawn() to complete.
+ *
+ * @return		The number of init functions that returned non-zero.
+ */
+int	init_wait(void);
+
+} // namespace device
+
+#endif /* _DEVICE_DEVICE_INIT_H */
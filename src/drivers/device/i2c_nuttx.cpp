@@ -42,6 +42,8 @@
 
 #include "i2c.h"
 
+#include <drivers/drv_hrt.h>
+
 namespace device
 {
 /*
@@ -66,7 +68,9 @@ I2C::I2C(const char *name,
 	_bus(bus),
 	_address(address),
 	_frequency(frequency),
-	_dev(nullptr)
+	_dev(nullptr),
+	_retry_tokens(_retry_budget),
+	_last_retry_refill(0)
 {
 	// fill in _device_id fields for a I2C device
 	_device_id.devid_s.bus_type = DeviceBusType_I2C;
@@ -232,7 +236,7 @@ I2C::transfer(const uint8_t *send, unsigned send_len, uint8_t *recv, unsigned re
 			I2C_RESET(_dev);
 		}
 
-	} while (retry_count++ < _retries);
+	} while (retry_count++ < _retries && consume_retry_token());
 
 	return ret;
 
@@ -264,9 +268,28 @@ I2C::transfer(i2c_msg_s *msgv, unsigned msgs)
 			I2C_RESET(_dev);
 		}
 
-	} while (retry_count++ < _retries);
+	} while (retry_count++ < _retries && consume_retry_token());
 
 	return ret;
 }
 
+bool
+I2C::consume_retry_token()
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	if (now - _last_retry_refill >= _retry_refill_interval) {
+		_retry_tokens = _retry_budget;
+		_last_retry_refill = now;
+	}
+
+	if (_retry_tokens == 0) {
+		/* budget exhausted: defer further retries to later calls */
+		return false;
+	}
+
+	_retry_tokens--;
+	return true;
+}
+
 } // namespace device
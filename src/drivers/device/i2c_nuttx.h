@@ -145,6 +145,26 @@ private:
 	uint32_t		_frequency;
 	px4_i2c_dev_t		*_dev;
 
+	/**
+	 * Inline retries consume tokens from a budget that refills over time, so
+	 * a persistently failing device (e.g. a wedged battery gauge) degrades to
+	 * one transfer attempt per call instead of blocking the shared work queue
+	 * with a full retry/bus-reset loop every cycle. The remaining retries are
+	 * effectively deferred to later calls, once the budget has refilled.
+	 *
+	 * @return true if an inline retry is permitted now
+	 */
+	bool		consume_retry_token();
+
+	/** inline retries permitted per refill window */
+	static const uint8_t	_retry_budget = 5;
+
+	/** retry budget refill window in microseconds */
+	static const uint64_t	_retry_refill_interval = 300 * 1000;
+
+	uint8_t			_retry_tokens;
+	uint64_t		_last_retry_refill;
+
 	I2C(const device::I2C &);
 	I2C operator=(const device::I2C &);
 };
@@ -0,0 +1,140 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file imu_decode.h
+ *
+ * Shared, compile-time specialized decode of raw IMU burst records.
+ *
+ * The accel/gyro drivers all read a burst of byte-pair registers and
+ * turn it into a signed 16 bit sample in the board frame. The byte
+ * order and the axis rotation differ per chip, but the code shape is
+ * identical, so it used to be duplicated in every driver hot path.
+ * IMUDecoder captures the chip-specific parts as template parameters
+ * and lets the compiler specialize one decode routine per chip.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace device
+{
+
+/**
+ * One decoded IMU sample: little endian, axes in board frame.
+ *
+ * Field order matches the register order of the supported parts so a
+ * decoded sample can be checked word-wise against bus error patterns.
+ */
+struct IMUSample {
+	int16_t		accel_x;
+	int16_t		accel_y;
+	int16_t		accel_z;
+	int16_t		temp;
+	int16_t		gyro_x;
+	int16_t		gyro_y;
+	int16_t		gyro_z;
+};
+
+/**
+ * Decode raw burst records into IMUSample.
+ *
+ * Template parameters describe the chip:
+ *
+ *  BIG_ENDIAN_DATA	register pairs are transferred MSB first
+ *			(InvenSense parts; Bosch/ST parts are LSB first)
+ *  SWAP_XY_NEGATE_Y	the sense axes are rotated into the board frame
+ *			by swapping x/y and negating the new y
+ *
+ * The raw record type only needs accel_x/y/z, temp and gyro_x/y/z
+ * byte pair members, so full register reads and FIFO records decode
+ * through the same specialization.
+ */
+template <bool BIG_ENDIAN_DATA, bool SWAP_XY_NEGATE_Y>
+struct IMUDecoder {
+
+	template <typename RawSample>
+	static inline void decode(const RawSample &raw, IMUSample &out)
+	{
+		out.accel_x = assemble(raw.accel_x);
+		out.accel_y = assemble(raw.accel_y);
+		out.accel_z = assemble(raw.accel_z);
+		out.temp    = assemble(raw.temp);
+		out.gyro_x  = assemble(raw.gyro_x);
+		out.gyro_y  = assemble(raw.gyro_y);
+		out.gyro_z  = assemble(raw.gyro_z);
+
+		if (SWAP_XY_NEGATE_Y) {
+			const int16_t accel_xt = out.accel_y;
+			const int16_t accel_yt = ((out.accel_x == -32768) ? 32767 : -out.accel_x);
+
+			const int16_t gyro_xt = out.gyro_y;
+			const int16_t gyro_yt = ((out.gyro_x == -32768) ? 32767 : -out.gyro_x);
+
+			out.accel_x = accel_xt;
+			out.accel_y = accel_yt;
+			out.gyro_x = gyro_xt;
+			out.gyro_y = gyro_yt;
+		}
+	}
+
+	/**
+	 * All-zero samples indicate a bus error on SPI parts; the swap
+	 * above maps zero to zero, so this can run on decoded samples.
+	 */
+	static inline bool all_zero(const IMUSample &s)
+	{
+		return s.accel_x == 0 &&
+		       s.accel_y == 0 &&
+		       s.accel_z == 0 &&
+		       s.temp == 0 &&
+		       s.gyro_x == 0 &&
+		       s.gyro_y == 0 &&
+		       s.gyro_z == 0;
+	}
+
+private:
+
+	static inline int16_t assemble(const uint8_t b[2])
+	{
+		if (BIG_ENDIAN_DATA) {
+			return (int16_t)(((uint16_t)b[0] << 8) | b[1]);
+
+		} else {
+			return (int16_t)(((uint16_t)b[1] << 8) | b[0]);
+		}
+	}
+};
+
+} // namespace device
@@ -125,6 +125,70 @@ Integrator::put(uint64_t timestamp, math::Vector<3> &val, math::Vector<3> &integ
 	}
 }
 
+bool
+Integrator::put_batch(uint64_t timestamp, const math::Vector<3> samples[], unsigned num_samples,
+		      unsigned sample_interval_us, math::Vector<3> &integral, uint64_t &integral_dt)
+{
+	if (num_samples == 0) {
+		return false;
+	}
+
+	unsigned start = 0;
+
+	if (_last_integration_time == 0) {
+		/* the first sample in the batch seeds the integrator */
+		_last_integration_time = timestamp - (uint64_t)(num_samples - 1) * sample_interval_us;
+		_last_reset_time = _last_integration_time;
+		_last_val = samples[0];
+		start = 1;
+	}
+
+	// The samples are evenly spaced, so the per-sample dt of put() is a
+	// constant that can be hoisted out of the accumulation loop.
+	const float dt_half = (float)((double)sample_interval_us / 1000000.0 * 0.5);
+
+	for (unsigned i = start; i < num_samples; i++) {
+		// trapezoidal integration, as in put()
+		math::Vector<3> delta_alpha = (samples[i] + _last_val) * dt_half;
+		_last_val = samples[i];
+
+		if (_coning_comp_on) {
+			// see put() for the derivation of the coning correction
+			_beta += ((_last_alpha + _last_delta_alpha * (1.0f / 6.0f)) % delta_alpha) * 0.5f;
+			_last_delta_alpha = delta_alpha;
+			_last_alpha = _alpha;
+		}
+
+		// accumulate delta integrals
+		_alpha += delta_alpha;
+	}
+
+	if (timestamp > _last_integration_time) {
+		_last_integration_time = timestamp;
+	}
+
+	// The reset is only checked once per batch, so one burst triggers at most
+	// one publish and the whole batch stays in the same integration interval.
+	if (_auto_reset_interval > 0 && (_last_integration_time - _last_reset_time) >= _auto_reset_interval) {
+
+		// apply coning corrections if required
+		if (_coning_comp_on) {
+			integral = _alpha + _beta;
+
+		} else {
+			integral = _alpha;
+		}
+
+		// reset the integrals and coning corrections
+		_reset(integral_dt);
+
+		return true;
+
+	} else {
+		return false;
+	}
+}
+
 bool
 Integrator::put_with_interval(unsigned interval_us, math::Vector<3> &val, math::Vector<3> &integral,
 			      uint64_t &integral_dt)
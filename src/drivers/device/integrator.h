@@ -77,6 +77,27 @@ public:
 	bool put_with_interval(unsigned interval_us, math::Vector<3> &val, math::Vector<3> &integral,
 			       uint64_t &integral_dt);
 
+	/**
+	 * Put a batch of evenly spaced items into the integral in one pass.
+	 *
+	 * Meant for FIFO burst reads: the per-sample timestamp math is hoisted out
+	 * of the accumulation loop and the auto-reset is only checked once after
+	 * the whole batch, so one burst triggers at most one reset/publish
+	 * (feeding a burst through put() can reset several times, publishing
+	 * integrals with misleadingly short dt).
+	 *
+	 * @param timestamp		Timestamp of the last sample in the batch.
+	 * @param samples		The samples, oldest first.
+	 * @param num_samples		Number of samples in the batch.
+	 * @param sample_interval_us	Interval between consecutive samples in us.
+	 * @param integral	Current integral in case the integrator did reset, else the value will not be modified
+	 * @param integral_dt	Get the dt in us of the current integration (only if reset).
+	 * @return		true if putting the batch triggered an integral reset and the integral should be
+	 *			published.
+	 */
+	bool put_batch(uint64_t timestamp, const math::Vector<3> samples[], unsigned num_samples,
+		       unsigned sample_interval_us, math::Vector<3> &integral, uint64_t &integral_dt);
+
 	/**
 	 * Get the current integral and reset the integrator if needed.
 	 *
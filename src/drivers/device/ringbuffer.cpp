@@ -295,6 +295,48 @@ RingBuffer::get(void *val, size_t val_size)
 	}
 }
 
+unsigned
+RingBuffer::get_multiple(void *vals, unsigned num_items)
+{
+	unsigned transferred;
+	unsigned candidate;
+	unsigned next;
+
+	do {
+		/* decide which elements we think we're going to read */
+		candidate = _tail;
+		unsigned head = _head;
+
+		if (candidate == head) {
+			return 0;
+		}
+
+		/* number of items between tail and head (indices count down) */
+		unsigned available = (candidate >= head) ?
+				     (candidate - head) : (_num_items + 1 - head + candidate);
+
+		if (available > num_items) {
+			available = num_items;
+		}
+
+		/* go ahead and copy them out; the indices decrease, so the
+		 * items are not contiguous and are copied one by one, but
+		 * without the per-item synchronization of repeated get() */
+		next = candidate;
+		char *out = (char *)vals;
+
+		for (transferred = 0; transferred < available; transferred++) {
+			memcpy(out, &_buf[next * _item_size], _item_size);
+			out += _item_size;
+			next = _next(next);
+		}
+
+		/* if the tail pointer didn't change, we got our items */
+	} while (!__PX4_SBCAP(&_tail, candidate, next));
+
+	return transferred;
+}
+
 bool
 RingBuffer::get(int8_t &val)
 {
@@ -417,4 +459,177 @@ RingBuffer::print_info(const char *name)
 	       _buf);
 }
 
+SpscRingBuffer::SpscRingBuffer(unsigned num_items, size_t item_size) :
+	_item_size(item_size),
+	_size(_roundup_pow2(num_items)),
+	_mask(_size - 1),
+	_buf(new char[_size * item_size]),
+	_head(0),
+	_tail(0)
+{}
+
+SpscRingBuffer::~SpscRingBuffer()
+{
+	if (_buf != nullptr) {
+		delete[] _buf;
+	}
+}
+
+unsigned
+SpscRingBuffer::_roundup_pow2(unsigned val)
+{
+	unsigned size = 1;
+
+	while (size < val) {
+		size <<= 1;
+	}
+
+	return size;
+}
+
+bool
+SpscRingBuffer::empty()
+{
+	return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_relaxed);
+}
+
+bool
+SpscRingBuffer::full()
+{
+	return count() >= _size;
+}
+
+unsigned
+SpscRingBuffer::size()
+{
+	return (_buf != nullptr) ? _size : 0;
+}
+
+unsigned
+SpscRingBuffer::count()
+{
+	return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+}
+
+unsigned
+SpscRingBuffer::space()
+{
+	return _size - count();
+}
+
+void
+SpscRingBuffer::flush()
+{
+	_tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+bool
+SpscRingBuffer::put(const void *val, size_t val_size)
+{
+	unsigned head = _head.load(std::memory_order_relaxed);
+	unsigned tail = _tail.load(std::memory_order_acquire);
+
+	if (head - tail >= _size) {
+		return false;
+	}
+
+	if ((val_size == 0) || (val_size > _item_size)) {
+		val_size = _item_size;
+	}
+
+	memcpy(&_buf[(head & _mask) * _item_size], val, val_size);
+
+	/* publish the item only after its payload is written */
+	_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+bool
+SpscRingBuffer::get(void *val, size_t val_size)
+{
+	unsigned tail = _tail.load(std::memory_order_relaxed);
+	unsigned head = _head.load(std::memory_order_acquire);
+
+	if (head == tail) {
+		return false;
+	}
+
+	if ((val_size == 0) || (val_size > _item_size)) {
+		val_size = _item_size;
+	}
+
+	if (val != nullptr) {
+		memcpy(val, &_buf[(tail & _mask) * _item_size], val_size);
+	}
+
+	/* release the slot only after its payload is read */
+	_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+unsigned
+SpscRingBuffer::get_multiple(void *vals, unsigned num_items)
+{
+	unsigned tail = _tail.load(std::memory_order_relaxed);
+	unsigned head = _head.load(std::memory_order_acquire);
+	unsigned available = head - tail;
+
+	if (available == 0) {
+		return 0;
+	}
+
+	if (num_items > available) {
+		num_items = available;
+	}
+
+	/* copy in at most two contiguous spans, split at the buffer end */
+	unsigned index = tail & _mask;
+	unsigned first = _size - index;
+
+	if (first > num_items) {
+		first = num_items;
+	}
+
+	memcpy(vals, &_buf[index * _item_size], first * _item_size);
+
+	if (first < num_items) {
+		memcpy((char *)vals + (first * _item_size), &_buf[0], (num_items - first) * _item_size);
+	}
+
+	_tail.store(tail + num_items, std::memory_order_release);
+	return num_items;
+}
+
+bool
+SpscRingBuffer::resize(unsigned new_size)
+{
+	char *old_buffer;
+	char *new_buffer = new char [_roundup_pow2(new_size) * _item_size];
+
+	if (new_buffer == nullptr) {
+		return false;
+	}
+
+	old_buffer = _buf;
+	_buf = new_buffer;
+	_size = _roundup_pow2(new_size);
+	_mask = _size - 1;
+	_head.store(0, std::memory_order_relaxed);
+	_tail.store(0, std::memory_order_relaxed);
+	delete[] old_buffer;
+	return true;
+}
+
+void
+SpscRingBuffer::print_info(const char *name)
+{
+	printf("%s	%u/%lu (%u/%u @ %p)\n",
+	       name,
+	       _size,
+	       (unsigned long)_size * _item_size,
+	       _head.load(std::memory_order_relaxed),
+	       _tail.load(std::memory_order_relaxed),
+	       _buf);
+}
+
 } // namespace ringbuffer
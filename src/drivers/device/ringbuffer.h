@@ -39,6 +39,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -109,6 +111,16 @@ public:
 	bool			get(float &val);
 	bool			get(double &val);
 
+	/**
+	 * Get up to num_items items from the buffer with a single tail update,
+	 * instead of one compare-and-swap per item as with repeated get() calls.
+	 *
+	 * @param vals		Buffer for num_items items
+	 * @param num_items	Maximum number of items to get
+	 * @return		The number of items copied out
+	 */
+	unsigned		get_multiple(void *vals, unsigned num_items);
+
 	/*
 	 * Get the number of slots free in the buffer.
 	 *
@@ -176,4 +188,110 @@ private:
 	RingBuffer operator=(const RingBuffer &);
 };
 
+/**
+ * Single-producer single-consumer lock-free ring buffer.
+ *
+ * Head and tail are free-running C++11 atomic counters and the capacity
+ * is rounded up to a power of two so indexing reduces to a mask. With one
+ * producer (typically the sensor ISR or measurement callback) and one
+ * consumer (the driver read() path) neither side ever spins, retries or
+ * disables interrupts, unlike the CAS loop in RingBuffer. There is no
+ * force(): dropping the oldest item would consume from the producer side,
+ * which this class does not allow.
+ */
+class SpscRingBuffer
+{
+public:
+	SpscRingBuffer(unsigned num_items, size_t item_size);
+	~SpscRingBuffer();
+
+	/**
+	 * Put an item into the buffer. May only be called from the producer.
+	 *
+	 * @param val		Item to put
+	 * @return		true if the item was put, false if the buffer is full
+	 */
+	bool			put(const void *val, size_t val_size = 0);
+
+	/**
+	 * Get an item from the buffer. May only be called from the consumer.
+	 *
+	 * @param val		Item that was gotten
+	 * @return		true if an item was got, false if the buffer was empty
+	 */
+	bool			get(void *val, size_t val_size = 0);
+
+	/**
+	 * Get up to num_items items from the buffer in at most two memcpy()
+	 * spans. May only be called from the consumer.
+	 *
+	 * @param vals		Buffer for num_items items
+	 * @param num_items	Maximum number of items to get
+	 * @return		The number of items copied out
+	 */
+	unsigned		get_multiple(void *vals, unsigned num_items);
+
+	/*
+	 * Get the number of slots free in the buffer.
+	 */
+	unsigned		space(void);
+
+	/*
+	 * Get the number of items in the buffer.
+	 */
+	unsigned		count(void);
+
+	/*
+	 * Returns true if the buffer is empty.
+	 */
+	bool			empty();
+
+	/*
+	 * Returns true if the buffer is full.
+	 */
+	bool			full();
+
+	/*
+	 * Returns the capacity of the buffer, or zero if the buffer could
+	 * not be allocated. Note that this is the requested capacity
+	 * rounded up to a power of two.
+	 */
+	unsigned		size();
+
+	/*
+	 * Empties the buffer. May only be called from the consumer.
+	 */
+	void			flush();
+
+	/*
+	 * resize the buffer. This is unsafe to be called while
+	 * a producer or consumer is running. Caller is responsible
+	 * for any locking needed
+	 *
+	 * @param new_size	new size for buffer
+	 * @return		true if the resize succeeds, false if
+	 * 			not (allocation error)
+	 */
+	bool			resize(unsigned new_size);
+
+	/*
+	 * printf() some info on the buffer
+	 */
+	void			print_info(const char *name);
+
+private:
+	const size_t		_item_size;
+	unsigned		_size;	/**< capacity, always a power of two */
+	unsigned		_mask;	/**< _size - 1, for index reduction */
+	char			*_buf;
+	std::atomic<unsigned>	_head;	/**< free-running write counter */
+	std::atomic<unsigned>	_tail;	/**< free-running read counter */
+
+	static unsigned		_roundup_pow2(unsigned val);
+
+	/* we don't want this class to be copied */
+	SpscRingBuffer(const SpscRingBuffer &);
+	SpscRingBuffer operator=(const SpscRingBuffer &);
+};
+
 } // namespace ringbuffer
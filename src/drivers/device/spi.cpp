@@ -57,6 +57,47 @@
 namespace device
 {
 
+namespace
+{
+
+/**
+ * Per-bus queues of pending transfers, shared by all SPI instances on a bus.
+ * Slots are claimed lazily on first use; access is guarded by a critical
+ * section since transfers can be queued from interrupt context.
+ */
+const unsigned SPI_QUEUE_NUM_BUSES = 4;
+
+struct BusQueue {
+	int			bus;
+	unsigned		count;
+	SPI::QueuedTransfer	items[SPI::TRANSFER_QUEUE_DEPTH];
+};
+
+BusQueue _bus_queues[SPI_QUEUE_NUM_BUSES] = {
+	{-1, 0, {}}, {-1, 0, {}}, {-1, 0, {}}, {-1, 0, {}}
+};
+
+/* find (or claim) the queue for a bus; call with interrupts disabled */
+BusQueue *bus_queue_for(int bus)
+{
+	for (unsigned i = 0; i < SPI_QUEUE_NUM_BUSES; i++) {
+		if (_bus_queues[i].bus == bus) {
+			return &_bus_queues[i];
+		}
+	}
+
+	for (unsigned i = 0; i < SPI_QUEUE_NUM_BUSES; i++) {
+		if (_bus_queues[i].bus == -1) {
+			_bus_queues[i].bus = bus;
+			return &_bus_queues[i];
+		}
+	}
+
+	return nullptr;
+}
+
+} // namespace
+
 SPI::SPI(const char *name,
 	 const char *devname,
 	 int bus,
@@ -149,11 +190,16 @@ SPI::transfer(uint8_t *send, uint8_t *recv, unsigned len)
 
 	LockMode mode = up_interrupt_context() ? LOCK_NONE : locking_mode;
 
+	/* take any transfers queued on this bus along, so they share the lock/setup cost */
+	QueuedTransfer batch[TRANSFER_QUEUE_DEPTH];
+	unsigned batch_count = _queue_take(batch);
+
 	/* lock the bus as required */
 	switch (mode) {
 	default:
 	case LOCK_PREEMPTION: {
 			irqstate_t state = px4_enter_critical_section();
+			_run_batch(batch, batch_count);
 			result = _transfer(send, recv, len);
 			px4_leave_critical_section(state);
 		}
@@ -161,18 +207,127 @@ SPI::transfer(uint8_t *send, uint8_t *recv, unsigned len)
 
 	case LOCK_THREADS:
 		SPI_LOCK(_dev, true);
+		_run_batch(batch, batch_count);
 		result = _transfer(send, recv, len);
 		SPI_LOCK(_dev, false);
 		break;
 
 	case LOCK_NONE:
+		_run_batch(batch, batch_count);
 		result = _transfer(send, recv, len);
 		break;
 	}
 
+	_complete_batch(batch, batch_count);
+
 	return result;
 }
 
+int
+SPI::transfer_queued(uint8_t *send, uint8_t *recv, unsigned len, TransferCallback callback, void *arg)
+{
+	if (((send == nullptr) && (recv == nullptr)) || (len == 0)) {
+		return -EINVAL;
+	}
+
+	irqstate_t state = px4_enter_critical_section();
+	BusQueue *queue = bus_queue_for(_bus);
+
+	if ((queue == nullptr) || (queue->count >= TRANSFER_QUEUE_DEPTH)) {
+		px4_leave_critical_section(state);
+		return -ENOSPC;
+	}
+
+	QueuedTransfer &item = queue->items[queue->count++];
+	item.dev = this;
+	item.send = send;
+	item.recv = recv;
+	item.len = len;
+	item.callback = callback;
+	item.arg = arg;
+	item.result = OK;
+
+	px4_leave_critical_section(state);
+	return OK;
+}
+
+int
+SPI::transfer_flush()
+{
+	QueuedTransfer batch[TRANSFER_QUEUE_DEPTH];
+	unsigned batch_count = _queue_take(batch);
+
+	if (batch_count == 0) {
+		return OK;
+	}
+
+	LockMode mode = up_interrupt_context() ? LOCK_NONE : locking_mode;
+
+	switch (mode) {
+	default:
+	case LOCK_PREEMPTION: {
+			irqstate_t state = px4_enter_critical_section();
+			_run_batch(batch, batch_count);
+			px4_leave_critical_section(state);
+		}
+		break;
+
+	case LOCK_THREADS:
+		SPI_LOCK(_dev, true);
+		_run_batch(batch, batch_count);
+		SPI_LOCK(_dev, false);
+		break;
+
+	case LOCK_NONE:
+		_run_batch(batch, batch_count);
+		break;
+	}
+
+	_complete_batch(batch, batch_count);
+
+	return OK;
+}
+
+unsigned
+SPI::_queue_take(QueuedTransfer *batch)
+{
+	irqstate_t state = px4_enter_critical_section();
+	BusQueue *queue = bus_queue_for(_bus);
+	unsigned count = 0;
+
+	if (queue != nullptr) {
+		count = queue->count;
+
+		for (unsigned i = 0; i < count; i++) {
+			batch[i] = queue->items[i];
+		}
+
+		queue->count = 0;
+	}
+
+	px4_leave_critical_section(state);
+	return count;
+}
+
+void
+SPI::_run_batch(QueuedTransfer *batch, unsigned count)
+{
+	for (unsigned i = 0; i < count; i++) {
+		/* each device sequences its own chip select & bus setup */
+		batch[i].result = batch[i].dev->_transfer(batch[i].send, batch[i].recv, batch[i].len);
+	}
+}
+
+void
+SPI::_complete_batch(QueuedTransfer *batch, unsigned count)
+{
+	for (unsigned i = 0; i < count; i++) {
+		if (batch[i].callback != nullptr) {
+			batch[i].callback(batch[i].arg, batch[i].result);
+		}
+	}
+}
+
 void
 SPI::set_frequency(uint32_t frequency)
 {
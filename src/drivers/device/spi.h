@@ -110,6 +110,60 @@ protected:
 	 */
 	int		transfer(uint8_t *send, uint8_t *recv, unsigned len);
 
+	/**
+	 * Completion callback for queued transfers.
+	 *
+	 * Runs after the batch has been executed, outside the bus lock, in the
+	 * context of whoever drained the queue (possibly interrupt context).
+	 *
+	 * @param arg		Callback argument as passed to transfer_queued().
+	 * @param result	Result of the transfer, as from transfer().
+	 */
+	typedef void	(*TransferCallback)(void *arg, int result);
+
+	static const unsigned TRANSFER_QUEUE_DEPTH = 8;
+
+	/** A transfer waiting in a bus queue. */
+	struct QueuedTransfer {
+		SPI		*dev;		/**< device the transfer belongs to (chip select, mode, frequency) */
+		uint8_t		*send;
+		uint8_t		*recv;
+		unsigned	len;
+		TransferCallback callback;
+		void		*arg;
+		int		result;
+	};
+
+	/**
+	 * Queue a SPI transfer for coalesced execution.
+	 *
+	 * The transfer is executed together with all other transfers pending on
+	 * the same bus by the next transfer() of any device on the bus, or by
+	 * transfer_flush(), inside a single bus lock acquisition with per-device
+	 * chip-select sequencing. This amortizes the lock/setup overhead over
+	 * all drivers sharing the bus.
+	 *
+	 * The buffers must stay valid until the callback has run.
+	 *
+	 * @param send		Bytes to send to the device, or nullptr.
+	 * @param recv		Buffer for receiving bytes, or nullptr.
+	 * @param len		Number of bytes to transfer.
+	 * @param callback	Completion callback, or nullptr if not needed.
+	 * @param arg		Argument passed to the callback.
+	 * @return		OK if queued, -ENOSPC if the queue is full (the
+	 *			caller should fall back to transfer()).
+	 */
+	int		transfer_queued(uint8_t *send, uint8_t *recv, unsigned len,
+					TransferCallback callback = nullptr, void *arg = nullptr);
+
+	/**
+	 * Execute all transfers queued on this device's bus now, in a single
+	 * bus-locked batch.
+	 *
+	 * @return		OK (individual results are reported via the callbacks).
+	 */
+	int		transfer_flush();
+
 	/**
 	 * Set the SPI bus frequency
 	 * This is used to change frequency on the fly. Some sensors
@@ -139,6 +193,24 @@ private:
 	uint32_t		_frequency;
 	struct spi_dev_s	*_dev;
 
+	/**
+	 * Take all transfers pending on this device's bus out of the queue.
+	 *
+	 * @param batch		Destination array, at least TRANSFER_QUEUE_DEPTH entries.
+	 * @return		Number of transfers taken.
+	 */
+	unsigned	_queue_take(QueuedTransfer *batch);
+
+	/**
+	 * Execute a batch of queued transfers. The caller must hold the bus lock.
+	 */
+	void		_run_batch(QueuedTransfer *batch, unsigned count);
+
+	/**
+	 * Invoke the completion callbacks of an executed batch.
+	 */
+	static void	_complete_batch(QueuedTransfer *batch, unsigned count);
+
 	/* this class does not allow copying */
 	SPI(const SPI &);
 	SPI operator=(const SPI &);
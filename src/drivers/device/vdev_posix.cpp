@@ -254,6 +254,18 @@ extern "C" {
 		return ret;
 	}
 
+	static void poll_thread_name(char *name, unsigned len)
+	{
+		name[0] = 0;
+#ifndef __PX4_QURT
+
+		if (pthread_getname_np(pthread_self(), name, len) || name[0] == 0) {
+			PX4_WARN("failed getting thread name");
+		}
+
+#endif
+	}
+
 	int px4_poll(px4_pollfd_struct_t *fds, nfds_t nfds, int timeout)
 	{
 		if (nfds == 0) {
@@ -261,7 +273,6 @@ extern "C" {
 			return -1;
 		}
 
-		px4_sem_t sem;
 		int count = 0;
 		int ret = -1;
 		unsigned int i;
@@ -269,11 +280,28 @@ extern "C" {
 		const unsigned NAMELEN = 32;
 		char thread_name[NAMELEN] = {};
 
-#ifndef __PX4_QURT
-		int nret = pthread_getname_np(pthread_self(), thread_name, NAMELEN);
+#ifdef __PX4_QURT
+		px4_sem_t sem;
+		px4_sem_init(&sem, 0, 0);
 
-		if (nret || thread_name[0] == 0) {
-			PX4_WARN("failed getting thread name");
+		// sem use case is a signal
+		px4_sem_setprotocol(&sem, SEM_PRIO_NONE);
+#else
+		/* The wakeup semaphore is registered with each polled device and
+		 * signalled directly from poll_notify() on publication. Keep one per
+		 * thread instead of creating and destroying it on every call; any
+		 * leftover signals are drained after the devices are deregistered
+		 * below, so a reused semaphore always starts out empty. */
+		static __thread px4_sem_t sem;
+		static __thread bool sem_initialized = false;
+
+		if (!sem_initialized) {
+			px4_sem_init(&sem, 0, 0);
+
+			// sem use case is a signal
+			px4_sem_setprotocol(&sem, SEM_PRIO_NONE);
+
+			sem_initialized = true;
 		}
 
 #endif
@@ -284,10 +312,37 @@ extern "C" {
 
 		PX4_DEBUG("Called px4_poll timeout = %d", timeout);
 
-		px4_sem_init(&sem, 0, 0);
+		/* Resolve all fds in a single critical section instead of taking the
+		 * global file map lock twice per fd; the map entries cannot change
+		 * under us as long as the caller does not close the fds it is
+		 * polling, which would be invalid use anyway. */
+		const unsigned NDEVS_STACK = 8;
+		CDev *devs_stack[NDEVS_STACK];
+		file_t *files_stack[NDEVS_STACK];
+		CDev **devs = devs_stack;
+		file_t **files = files_stack;
+
+		if (nfds > NDEVS_STACK) {
+			devs = new CDev *[nfds];
+			files = new file_t *[nfds];
+		}
 
-		// sem use case is a signal
-		px4_sem_setprotocol(&sem, SEM_PRIO_NONE);
+		pthread_mutex_lock(&filemutex);
+
+		for (i = 0; i < nfds; ++i) {
+			const int fd = fds[i].fd;
+
+			if (fd >= 0 && fd < PX4_MAX_FD && filemap[fd] != nullptr) {
+				files[i] = filemap[fd];
+				devs[i] = (CDev *)files[i]->vdev;
+
+			} else {
+				files[i] = nullptr;
+				devs[i] = nullptr;
+			}
+		}
+
+		pthread_mutex_unlock(&filemutex);
 
 		// Go through all fds and check them for a pollable state
 		bool fd_pollable = false;
@@ -297,14 +352,13 @@ extern "C" {
 			fds[i].revents = 0;
 			fds[i].priv    = nullptr;
 
-			CDev *dev = get_vdev(fds[i].fd);
-
 			// If fd is valid
-			if (dev) {
-				PX4_DEBUG("%s: px4_poll: CDev->poll(setup) %d", thread_name, fds[i].fd);
-				ret = dev->poll(filemap[fds[i].fd], &fds[i], true);
+			if (devs[i]) {
+				PX4_DEBUG("px4_poll: CDev->poll(setup) %d", fds[i].fd);
+				ret = devs[i]->poll(files[i], &fds[i], true);
 
 				if (ret < 0) {
+					poll_thread_name(thread_name, NAMELEN);
 					PX4_WARN("%s: px4_poll() error: %s",
 						 thread_name, strerror(errno));
 					break;
@@ -347,6 +401,7 @@ extern "C" {
 				}
 
 				if (ret && ret != -ETIMEDOUT) {
+					poll_thread_name(thread_name, NAMELEN);
 					PX4_WARN("%s: px4_poll() sem error", thread_name);
 				}
 
@@ -358,14 +413,13 @@ extern "C" {
 			// go through all fds and count how many have data
 			for (i = 0; i < nfds; ++i) {
 
-				CDev *dev = get_vdev(fds[i].fd);
-
 				// If fd is valid
-				if (dev) {
-					PX4_DEBUG("%s: px4_poll: CDev->poll(teardown) %d", thread_name, fds[i].fd);
-					ret = dev->poll(filemap[fds[i].fd], &fds[i], false);
+				if (devs[i]) {
+					PX4_DEBUG("px4_poll: CDev->poll(teardown) %d", fds[i].fd);
+					ret = devs[i]->poll(files[i], &fds[i], false);
 
 					if (ret < 0) {
+						poll_thread_name(thread_name, NAMELEN);
 						PX4_WARN("%s: px4_poll() 2nd poll fail", thread_name);
 						break;
 					}
@@ -377,7 +431,21 @@ extern "C" {
 			}
 		}
 
+#ifdef __PX4_QURT
 		px4_sem_destroy(&sem);
+#else
+
+		/* all devices are deregistered now; drain signals that arrived after
+		 * the wakeup so the reused semaphore starts out empty next time */
+		while (px4_sem_trywait(&sem) == 0) {
+		}
+
+#endif
+
+		if (devs != devs_stack) {
+			delete[] devs;
+			delete[] files;
+		}
 
 		// Return the positive count if present,
 		// return the negative error number if failed
@@ -166,6 +166,19 @@ __EXPORT extern void	hrt_call_init(struct hrt_call *entry);
  */
 __EXPORT extern void	hrt_call_delay(struct hrt_call *entry, hrt_abstime delay);
 
+/* forward declaration, see systemlib/perf_counter.h */
+struct perf_ctr_header;
+
+/**
+ * Attach a PC_ELAPSED perf counter to a callout entry. The scheduler then
+ * records the deadline-to-dispatch latency of each invocation of the entry
+ * into the counter ('perf latency' prints it alongside the interrupt
+ * histogram), quantifying how much the callout is delayed by higher-priority
+ * work. Only a limited number of entries can be instrumented at a time; pass
+ * NULL to detach. The counter remains owned by the caller.
+ */
+__EXPORT extern void	hrt_call_set_latency_perf(struct hrt_call *entry, struct perf_ctr_header *perf);
+
 /*
  * Initialise the HRT.
  */
@@ -191,6 +204,21 @@ __EXPORT extern void	hrt_stop_delay(void);
  */
 __EXPORT extern void	hrt_stop_delay_delta(hrt_abstime delta);
 
+/**
+ * Switch the HRT into lockstep mode.
+ *
+ * In lockstep mode time stands still until hrt_lockstep_set_time() advances
+ * it, so the whole system runs deterministically at whatever pace the time
+ * source (typically the simulator) provides.
+ */
+__EXPORT extern void	hrt_lockstep_enable(void);
+
+/**
+ * Advance lockstep time. Steps backwards are ignored; due callouts run
+ * immediately after the new time is visible.
+ */
+__EXPORT extern void	hrt_lockstep_set_time(hrt_abstime time);
+
 #endif
 
 __END_DECLS
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file drv_imu_capture.h
+ *
+ * Raw IMU capture interface for vibration surveys.
+ *
+ * Drivers that drain the sensor FIFO in bursts can additionally copy the
+ * raw FIFO records into an in-driver ring buffer, bypassing uORB and the
+ * logger entirely. The 'imu_capture' command drains the ring from task
+ * context and writes the blocks to a file for offline analysis; the
+ * flight logging path is not touched.
+ *
+ * The capture file starts with one imu_capture_file_header_s recording
+ * the sample rate and scale factors needed for post-processing, followed
+ * by a sequence of blocks, each an imu_capture_block_header_s and
+ * n_samples raw sample records exactly as read from the sensor FIFO
+ * (little endian, no axis rotation applied).
+ */
+
+#ifndef _DRV_IMU_CAPTURE_H
+#define _DRV_IMU_CAPTURE_H
+
+#include <stdint.h>
+#include <sys/ioctl.h>
+
+#include "drv_sensor.h"
+#include "drv_orb_dev.h"
+
+#define IMU_CAPTURE_MAGIC	0x43554d49	/* "IMUC" */
+#define IMU_CAPTURE_VERSION	1
+
+#pragma pack(push, 1)
+/**
+ * File header, written once at the start of a capture.
+ */
+struct imu_capture_file_header_s {
+	uint32_t	magic;			/**< IMU_CAPTURE_MAGIC */
+	uint8_t		version;		/**< IMU_CAPTURE_VERSION */
+	uint8_t		sample_size;		/**< size of one raw sample record in bytes */
+	uint16_t	sample_rate;		/**< sensor output data rate in Hz */
+	uint32_t	device_id;		/**< device id of the captured sensor */
+	float		accel_range_scale;	/**< m/s^2 per LSB */
+	float		gyro_range_scale;	/**< rad/s per LSB */
+	uint64_t	start_time;		/**< hrt timestamp of the capture start */
+};
+
+/**
+ * Block header, one per drained FIFO burst. The timestamp belongs to the
+ * newest sample of the block; older samples are spaced backwards by the
+ * sample interval. Blocks dropped on ring overrun only cost their own
+ * samples - the stream stays parseable.
+ */
+struct imu_capture_block_header_s {
+	uint64_t	timestamp;		/**< hrt timestamp of the newest sample */
+	uint16_t	n_samples;		/**< number of raw sample records following */
+};
+#pragma pack(pop)
+
+/**
+ * Drain request passed to IMUCAPIOCFETCH.
+ */
+struct imu_capture_fetch_s {
+	void		*buffer;		/**< destination for the capture stream */
+	unsigned	length;			/**< destination size in bytes */
+};
+
+/*
+ * ioctl() definitions
+ */
+
+#define _IMUCAPIOCBASE		(0x2f00)
+#define _IMUCAPIOC(_n)		(_PX4_IOC(_IMUCAPIOCBASE, _n))
+
+/** start a capture, arg is the duration in seconds */
+#define IMUCAPIOCSTART		_IMUCAPIOC(0)
+
+/** stop the capture and release the ring buffer */
+#define IMUCAPIOCSTOP		_IMUCAPIOC(1)
+
+/**
+ * copy buffered capture data, arg is a pointer to imu_capture_fetch_s;
+ * returns the number of bytes copied (0 when the ring is empty)
+ */
+#define IMUCAPIOCFETCH		_IMUCAPIOC(2)
+
+#endif /* _DRV_IMU_CAPTURE_H */
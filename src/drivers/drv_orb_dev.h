@@ -93,4 +93,10 @@
 /** Get the minimum interval at which the topic can be seen to be updated for this subscription */
 #define ORBIOCGETINTERVAL	_ORBIOC(16)
 
+/** Only report updates for publications that changed the payload for this subscription */
+#define ORBIOCSETCHANGEFILTER	_ORBIOC(17)
+
+/** Sample a CRC of every Nth publication of this topic and verify it on copy */
+#define ORBIOCSETINTEGRITY	_ORBIOC(18)
+
 #endif /* _DRV_UORB_H */
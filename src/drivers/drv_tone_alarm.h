@@ -67,6 +67,10 @@
 #define _TONE_ALARM_BASE	0x7400
 #define TONE_SET_ALARM		_PX4_IOC(_TONE_ALARM_BASE, 1)
 
+/* depth of the tune_control topic queue; requests beyond this between two
+ * driver polls overwrite the oldest pending tune */
+#define TUNE_UORB_QUEUE_LENGTH	4
+
 /* structure describing one note in a tone pattern */
 struct tone_note {
 	uint8_t		pitch;
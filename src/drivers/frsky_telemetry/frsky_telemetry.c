@@ -56,6 +56,8 @@
 
 #include <px4_tasks.h>
 #include <px4_module.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/clock.h>
 #include <systemlib/err.h>
 #include <termios.h>
 #include <drivers/drv_hrt.h>
@@ -74,11 +76,24 @@ static int frsky_task;
 typedef enum { SCANNING, SPORT, DTYPE } frsky_state_t;
 static frsky_state_t frsky_state = SCANNING;
 
+/* lowpass filtered baro altitude, shared between the poll loop and the VSPD element */
+static float filtered_alt = NAN;
+static float last_baro_alt = 0.0f;
+
+/* D type telemetry is periodic and runs from the low priority work queue,
+ * so the detection task (and its stack) can be reclaimed once the protocol
+ * is known */
+static struct work_s frsky_d_work;
+static int frsky_d_uart = -1;
+static struct termios frsky_d_uart_config_original;
+static int frsky_d_iteration = 0;
+
 /* functions */
 static int sPort_open_uart(const char *uart_name, struct termios *uart_config, struct termios *uart_config_original);
 static int set_uart_speed(int uart, struct termios *uart_config, speed_t speed);
 static void usage(void);
 static int frsky_telemetry_thread_main(int argc, char *argv[]);
+static void frsky_d_cycle(void *arg);
 __EXPORT int frsky_telemetry_main(int argc, char *argv[]);
 
 
@@ -120,6 +135,124 @@ uint16_t get_telemetry_flight_mode(int px4_flight_mode)
 	return -1;
 }
 
+static void sPort_send_VSPD_element(int uart)
+{
+	/* estimate vertical speed using first difference and delta t */
+	static uint32_t last_vspd_ms = 0;
+	uint32_t now_ms = hrt_absolute_time() / 1000;
+	uint32_t dt = now_ms - last_vspd_ms;
+	float speed = (filtered_alt - last_baro_alt) / (1e-3f * (float)dt);
+
+	/* save current alt and timestamp */
+	last_baro_alt = filtered_alt;
+	last_vspd_ms = now_ms;
+
+	sPort_send_VSPD(uart, speed);
+}
+
+static void sPort_send_GPS_element(int uart)
+{
+	/* the GPS data elements are reported round robin */
+	static int elementCount = 0;
+
+	switch (elementCount) {
+
+	case 0:
+		sPort_send_GPS_LON(uart);
+		elementCount++;
+		break;
+
+	case 1:
+		sPort_send_GPS_LAT(uart);
+		elementCount++;
+		break;
+
+	case 2:
+		sPort_send_GPS_CRS(uart);
+		elementCount++;
+		break;
+
+	case 3:
+		sPort_send_GPS_ALT(uart);
+		elementCount++;
+		break;
+
+	case 4:
+		sPort_send_GPS_SPD(uart);
+		elementCount++;
+		break;
+
+	case 5:
+		sPort_send_GPS_TIME(uart);
+		elementCount = 0;
+		break;
+	}
+}
+
+static void sPort_send_SP2UR_element(int uart)
+{
+	/* alternate between flight mode and GPS info */
+	static int elementCount = 0;
+
+	switch (elementCount++ % 2) {
+	case 0:
+		sPort_send_flight_mode(uart);
+		break;
+
+	default:
+		sPort_send_GPS_info(uart);
+		break;
+	}
+}
+
+/* S.Port replies are driven from this table: each entry answers one or more
+ * receiver poll slots at a fixed minimum period. Within a slot the first due
+ * entry wins, so the order of entries doubles as the reply priority. */
+struct sport_element_t {
+	uint16_t slot_mask;	/* poll slots this value answers, bit n set for SMARTPORT_POLL_(n+1) */
+	uint16_t period_ms;	/* minimum interval between reports */
+	void (*send_fn)(int uart);
+	uint32_t last_ms;	/* time of the last report */
+};
+
+static struct sport_element_t sport_elements[] = {
+	{ 1 << 0,		1000,	sPort_send_BATV,		0 },	/* battery voltage at 1Hz */
+	{ 1 << 1,		200,	sPort_send_CUR,			0 },	/* battery current at 5Hz */
+	{ 1 << 2,		200,	sPort_send_ALT,			0 },	/* altitude at 5Hz */
+	{ 1 << 3,		200,	sPort_send_SPD,			0 },	/* speed at 5Hz */
+	{ 1 << 4,		1000,	sPort_send_FUEL,		0 },	/* fuel at 1Hz */
+	{ 1 << 5,		100,	sPort_send_VSPD_element,	0 },	/* vertical speed at 10Hz */
+	{ 1 << 6,		100,	sPort_send_GPS_element,		0 },	/* GPS data elements at 5*5Hz */
+	{ (1 << 6) | (1 << 7),	500,	sPort_send_NAV_STATE,		0 },	/* nav_state as DIY_NAVSTATE at 2Hz */
+	{ (1 << 6) | (1 << 7),	500,	sPort_send_GPS_FIX,		0 },	/* satcount and fix as DIY_GPSFIX at 2Hz */
+	{ 1 << 8,		0,	sPort_send_SP2UR_element,	0 },	/* flight mode / GPS info, alternating */
+};
+
+static int sport_poll_slot(uint8_t poll_id)
+{
+	switch (poll_id) {
+	case SMARTPORT_POLL_1: return 0;
+
+	case SMARTPORT_POLL_2: return 1;
+
+	case SMARTPORT_POLL_3: return 2;
+
+	case SMARTPORT_POLL_4: return 3;
+
+	case SMARTPORT_POLL_5: return 4;
+
+	case SMARTPORT_POLL_6: return 5;
+
+	case SMARTPORT_POLL_7: return 6;
+
+	case SMARTPORT_POLL_8: return 7;
+
+	case SMARTPORT_SENSOR_ID_SP2UR: return 8;
+	}
+
+	return -1;
+}
+
 /**
  * Opens the UART device and sets all required serial parameters.
  */
@@ -325,20 +458,10 @@ static int frsky_telemetry_thread_main(int argc, char *argv[])
 			err(1, "could not allocate memory");
 		}
 
-		float filtered_alt = NAN;
-		float last_baro_alt = 0.f;
+		filtered_alt = NAN;
+		last_baro_alt = 0.0f;
 		int sensor_sub = orb_subscribe(ORB_ID(sensor_baro));
 
-		uint32_t lastBATV_ms = 0;
-		uint32_t lastCUR_ms = 0;
-		uint32_t lastALT_ms = 0;
-		uint32_t lastSPD_ms = 0;
-		uint32_t lastFUEL_ms = 0;
-		uint32_t lastVSPD_ms = 0;
-		uint32_t lastGPS_ms = 0;
-		uint32_t lastNAV_STATE_ms = 0;
-		uint32_t lastGPS_FIX_ms = 0;
-
 		/* send S.port telemetry */
 		while (!thread_should_exit) {
 
@@ -387,160 +510,20 @@ static int frsky_telemetry_thread_main(int argc, char *argv[])
 
 			sPort_update_topics();
 
+			/* answer the poll with the first due element scheduled for this slot */
+			int slot = sport_poll_slot(sbuf[1]);
 
-			switch (sbuf[1]) {
-
-			case SMARTPORT_POLL_1:
-
-				/* report BATV at 1Hz */
-				if (now_ms - lastBATV_ms > 1000) {
-					lastBATV_ms = now_ms;
-					/* send battery voltage */
-					sPort_send_BATV(uart);
-				}
-
-				break;
-
-
-			case SMARTPORT_POLL_2:
-
-				/* report battery current at 5Hz */
-				if (now_ms - lastCUR_ms > 200) {
-					lastCUR_ms = now_ms;
-					/* send battery current */
-					sPort_send_CUR(uart);
-				}
-
-				break;
-
-
-			case SMARTPORT_POLL_3:
-
-				/* report altitude at 5Hz */
-				if (now_ms - lastALT_ms > 200) {
-					lastALT_ms = now_ms;
-					/* send altitude */
-					sPort_send_ALT(uart);
-				}
-
-				break;
-
-
-			case SMARTPORT_POLL_4:
-
-				/* report speed at 5Hz */
-				if (now_ms - lastSPD_ms > 200) {
-					lastSPD_ms = now_ms;
-					/* send speed */
-					sPort_send_SPD(uart);
-				}
-
-				break;
-
-			case SMARTPORT_POLL_5:
-
-				/* report fuel at 1Hz */
-				if (now_ms - lastFUEL_ms > 1000) {
-					lastFUEL_ms = now_ms;
-					/* send fuel */
-					sPort_send_FUEL(uart);
-				}
-
-				break;
-
-			case SMARTPORT_POLL_6:
-
-				/* report vertical speed at 10Hz */
-				if (now_ms - lastVSPD_ms > 100) {
-					/* estimate vertical speed using first difference and delta t */
-					uint32_t dt = now_ms - lastVSPD_ms;
-					float speed  = (filtered_alt - last_baro_alt) / (1e-3f * (float)dt);
-
-					/* save current alt and timestamp */
-					last_baro_alt = filtered_alt;
-					lastVSPD_ms = now_ms;
-
-					sPort_send_VSPD(uart, speed);
-				}
-
-				break;
-
-			case SMARTPORT_POLL_7:
-
-				/* report GPS data elements at 5*5Hz */
-				if (now_ms - lastGPS_ms > 100) {
-					static int elementCount = 0;
-
-					switch (elementCount) {
-
-					case 0:
-						sPort_send_GPS_LON(uart);
-						elementCount++;
-						break;
-
-					case 1:
-						sPort_send_GPS_LAT(uart);
-						elementCount++;
-						break;
-
-					case 2:
-						sPort_send_GPS_CRS(uart);
-						elementCount++;
-						break;
-
-					case 3:
-						sPort_send_GPS_ALT(uart);
-						elementCount++;
-						break;
-
-					case 4:
-						sPort_send_GPS_SPD(uart);
-						elementCount++;
-						break;
-
-					case 5:
-						sPort_send_GPS_TIME(uart);
-						elementCount = 0;
-						break;
-					}
-
-				}
-
-			/* FALLTHROUGH */
-
-			case SMARTPORT_POLL_8:
-
-				/* report nav_state as DIY_NAVSTATE 2Hz */
-				if (now_ms - lastNAV_STATE_ms > 500) {
-					lastNAV_STATE_ms = now_ms;
-					/* send T1 */
-					sPort_send_NAV_STATE(uart);
-				}
-
-				/* report satcount and fix as DIY_GPSFIX at 2Hz */
-				else if (now_ms - lastGPS_FIX_ms > 500) {
-					lastGPS_FIX_ms = now_ms;
-					/* send T2 */
-					sPort_send_GPS_FIX(uart);
-				}
-
-				break;
-
-			case SMARTPORT_SENSOR_ID_SP2UR: {
-					static int elementCount = 0;
-
-					switch (elementCount++ % 2) {
-					case 0:
-						sPort_send_flight_mode(uart);
-						break;
+			if (slot >= 0) {
+				for (unsigned i = 0; i < sizeof(sport_elements) / sizeof(sport_elements[0]); i++) {
+					struct sport_element_t *element = &sport_elements[i];
 
-					default:
-						sPort_send_GPS_info(uart);
+					if ((element->slot_mask & (1 << slot)) &&
+					    (now_ms - element->last_ms > element->period_ms)) {
+						element->last_ms = now_ms;
+						element->send_fn(uart);
 						break;
 					}
 				}
-
-				break;
 			}
 		}
 
@@ -565,66 +548,82 @@ static int frsky_telemetry_thread_main(int argc, char *argv[])
 			return 0;
 		}
 
-		int iteration = 0;
-
 		/* Subscribe to topics */
 		if (!frsky_init()) {
 			err(1, "could not allocate memory");
 		}
 
-		struct adc_linkquality host_frame;
+		/* hand the periodic sender over to the low priority work queue and let
+		 * this task exit, reclaiming its slot and stack. the work queue cycle
+		 * clears thread_running once it has been asked to stop. */
+		frsky_d_uart = uart;
+		memcpy(&frsky_d_uart_config_original, &uart_config_original, sizeof(frsky_d_uart_config_original));
+		frsky_d_iteration = 0;
+		work_queue(LPWORK, &frsky_d_work, frsky_d_cycle, NULL, USEC2TICK(100000));
 
-		/* send D8 mode telemetry */
-		while (!thread_should_exit) {
+		return 0;
+	}
 
-			/* Sleep 100 ms */
-			usleep(100000);
+	/* Reset the UART flags to original state */
+	tcsetattr(uart, TCSANOW, &uart_config_original);
+	close(uart);
 
-			/* parse incoming data */
-			int nbytes = read(uart, &sbuf[0], sizeof(sbuf));
-			bool new_input = frsky_parse_host((uint8_t *)&sbuf[0], nbytes, &host_frame);
+	thread_running = false;
+	return 0;
+}
 
-			/* the RSSI value could be useful */
-			if (new_input) {
-				PX4_DEBUG("host frame: ad1:%u, ad2: %u, rssi: %u",
-					  host_frame.ad1, host_frame.ad2, host_frame.linkq);
-			}
+/**
+ * One cycle of D8 mode telemetry, run from the low priority work queue every 100ms.
+ */
+static void frsky_d_cycle(void *arg)
+{
+	if (thread_should_exit) {
+		PX4_DEBUG("freeing frsky memory");
+		frsky_deinit();
 
-			frsky_update_topics();
+		/* Reset the UART flags to original state */
+		tcsetattr(frsky_d_uart, TCSANOW, &frsky_d_uart_config_original);
+		close(frsky_d_uart);
+		frsky_d_uart = -1;
 
-			/* Send frame 1 (every 200ms): acceleration values, altitude (vario), temperatures, current & voltages, RPM */
-			if (iteration % 2 == 0) {
-				frsky_send_frame1(uart);
-			}
+		thread_running = false;
+		return;
+	}
 
-			/* Send frame 2 (every 1000ms): course, latitude, longitude, speed, altitude (GPS), fuel level */
-			if (iteration % 10 == 0) {
-				frsky_send_frame2(uart);
-			}
+	/* parse incoming data */
+	char sbuf[20];
+	struct adc_linkquality host_frame;
+	int nbytes = read(frsky_d_uart, &sbuf[0], sizeof(sbuf));
+	bool new_input = frsky_parse_host((uint8_t *)&sbuf[0], nbytes, &host_frame);
+
+	/* the RSSI value could be useful */
+	if (new_input) {
+		PX4_DEBUG("host frame: ad1:%u, ad2: %u, rssi: %u",
+			  host_frame.ad1, host_frame.ad2, host_frame.linkq);
+	}
 
-			/* Send frame 3 (every 5000ms): date, time */
-			if (iteration % 50 == 0) {
-				frsky_send_frame3(uart);
+	frsky_update_topics();
 
-				iteration = 0;
-			}
+	/* Send frame 1 (every 200ms): acceleration values, altitude (vario), temperatures, current & voltages, RPM */
+	if (frsky_d_iteration % 2 == 0) {
+		frsky_send_frame1(frsky_d_uart);
+	}
 
-			iteration++;
-		}
+	/* Send frame 2 (every 1000ms): course, latitude, longitude, speed, altitude (GPS), fuel level */
+	if (frsky_d_iteration % 10 == 0) {
+		frsky_send_frame2(frsky_d_uart);
+	}
 
-//		/* TODO: flush the input buffer if in full duplex mode */
-//		read(uart, &sbuf[0], sizeof(sbuf));
-		PX4_DEBUG("freeing frsky memory");
-		frsky_deinit();
+	/* Send frame 3 (every 5000ms): date, time */
+	if (frsky_d_iteration % 50 == 0) {
+		frsky_send_frame3(frsky_d_uart);
 
+		frsky_d_iteration = 0;
 	}
 
-	/* Reset the UART flags to original state */
-	tcsetattr(uart, TCSANOW, &uart_config_original);
-	close(uart);
+	frsky_d_iteration++;
 
-	thread_running = false;
-	return 0;
+	work_queue(LPWORK, &frsky_d_work, frsky_d_cycle, NULL, USEC2TICK(100000));
 }
 
 /**
@@ -171,6 +171,13 @@ private:
 
 	int _orb_inject_data_fd;
 
+	/* Receive window: data is fetched from the UART in large reads and handed
+	 * out to the protocol parsers from here, so small parser reads do not
+	 * translate into small read() syscalls. */
+	uint8_t				_rx_buf[250];
+	unsigned			_rx_head;					///< next buffered byte to hand out
+	unsigned			_rx_tail;					///< end of valid buffered data
+
 	orb_advert_t _dump_communication_pub;			///< if non-null, dump communication
 	gps_dump_s *_dump_to_device;
 	gps_dump_s *_dump_from_device;
@@ -281,6 +288,9 @@ GPS::GPS(const char *path, gps_driver_mode_t mode, GPSHelper::Interface interfac
 	_fake_gps(fake_gps),
 	_instance(instance),
 	_orb_inject_data_fd(-1),
+	_rx_buf{},
+	_rx_head(0),
+	_rx_tail(0),
 	_dump_communication_pub(nullptr),
 	_dump_to_device(nullptr),
 	_dump_from_device(nullptr)
@@ -375,6 +385,14 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 {
 	handleInjectDataTopic();
 
+	/* serve leftover data from the last receive window before touching the UART */
+	if (_rx_head < _rx_tail) {
+		unsigned n = math::min(buf_length, (size_t)(_rx_tail - _rx_head));
+		memcpy(buf, &_rx_buf[_rx_head], n);
+		_rx_head += n;
+		return n;
+	}
+
 #if !defined(__PX4_QURT)
 
 	/* For non QURT, use the usual polling. */
@@ -416,7 +434,21 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 			usleep(GPS_WAIT_BEFORE_READ * 1000);
 #endif
 
-			ret = ::read(_serial_fd, buf, buf_length);
+			if (buf_length >= sizeof(_rx_buf)) {
+				/* large destination: read straight into it */
+				ret = ::read(_serial_fd, buf, buf_length);
+
+			} else {
+				/* small parser reads: fetch a full window and serve from it */
+				ret = ::read(_serial_fd, _rx_buf, sizeof(_rx_buf));
+
+				if (ret > 0) {
+					_rx_tail = ret;
+					_rx_head = math::min(buf_length, (size_t)ret);
+					memcpy(buf, _rx_buf, _rx_head);
+					ret = _rx_head;
+				}
+			}
 
 		} else {
 			ret = -1;
@@ -470,6 +502,9 @@ bool GPS::injectData(uint8_t *data, size_t len)
 
 int GPS::setBaudrate(unsigned baud)
 {
+	/* discard buffered data received at the old baudrate */
+	_rx_head = _rx_tail = 0;
+
 	/* process baud rate */
 	int speed;
 
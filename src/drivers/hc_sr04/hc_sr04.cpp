@@ -71,6 +71,7 @@
 #include <uORB/topics/subsystem_info.h>
 #include <uORB/topics/distance_sensor.h>
 
+#include <rangefinder/MedianFilter.hpp>
 
 #include <board_config.h>
 
@@ -118,6 +119,7 @@ private:
 	float				_max_distance;
 	work_s				_work;
 	ringbuffer::RingBuffer	*_reports;
+	rangefinder::MedianFilter _filter;
 	bool				_sensor_ok;
 	int					_measure_ticks;
 	bool				_collect_phase;
@@ -277,6 +279,9 @@ HC_SR04::init()
 
 	_class_instance = register_class_devname(RANGE_FINDER_BASE_DEVICE_PATH);
 
+	/* optional in-driver median prefilter and topic decimation */
+	_filter.configure_from_params();
+
 	/* get a publish handle on the range finder topic */
 	struct distance_sensor_s ds_report = {};
 
@@ -612,13 +617,24 @@ HC_SR04::collect()
 	report.maximum_distance = get_maximum_distance();
 	report.valid = si_units > get_minimum_distance() && si_units < get_maximum_distance() ? 1 : 0;
 
-	/* publish it, if we are the primary */
-	if (_distance_sensor_topic != nullptr) {
-		orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &report);
-	}
-
+	/* the device ring always receives the raw sample; the topic gets the
+	 * median-filtered, decimated stream when SENS_RNG_FILT is enabled */
 	_reports->force(&report);
 
+	float filtered;
+
+	if (_filter.update(si_units, filtered)) {
+		if (_sonars == 1) {
+			report.distance = filtered;
+			report.distance_vector[0] = filtered;
+		}
+
+		/* publish it, if we are the primary */
+		if (_distance_sensor_topic != nullptr) {
+			orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &report);
+		}
+	}
+
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
 
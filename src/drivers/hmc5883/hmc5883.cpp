@@ -67,6 +67,7 @@
 #include <drivers/drv_mag.h>
 #include <drivers/drv_hrt.h>
 #include <drivers/device/ringbuffer.h>
+#include <drivers/device/device_init.h>
 #include <drivers/drv_device.h>
 
 #include <uORB/uORB.h>
@@ -81,8 +82,9 @@
  * HMC5883 internal constants and data structures.
  */
 
-/* Max measurement rate is 160Hz, however with 160 it will be set to 166 Hz, therefore workaround using 150 */
-#define HMC5883_CONVERSION_INTERVAL	(1000000 / 150)	/* microseconds */
+/* Max continuous-measurement output rate is 75Hz; requested rates below that
+ * are produced by averaging device samples in the driver */
+#define HMC5883_CONVERSION_INTERVAL	(1000000 / 75)	/* microseconds */
 
 #define ADDR_CONF_A			0x00
 #define ADDR_CONF_B			0x01
@@ -109,8 +111,11 @@
 #define HMC5883L_AVERAGING_4		(2 << 5)
 #define HMC5883L_AVERAGING_8		(3 << 5)
 
+#define HMC5883L_RATE_75HZ		(6 << 2) /* conf a register, continuous output rate */
+
 #define MODE_REG_CONTINOUS_MODE		(0 << 0)
 #define MODE_REG_SINGLE_MODE		(1 << 0) /* default */
+#define MODE_REG_IDLE_MODE		(2 << 0)
 
 #define STATUS_REG_DATA_OUT_LOCK	(1 << 1) /* page 16: set if data is only partially read, read device to reset */
 #define STATUS_REG_DATA_READY		(1 << 0) /* page 16: set if all axes have valid measurements */
@@ -160,7 +165,6 @@ private:
 	struct mag_calibration_s	_scale;
 	float 			_range_scale;
 	float 			_range_ga;
-	bool			_collect_phase;
 	int			_class_instance;
 	int			_orb_class_instance;
 
@@ -184,6 +188,9 @@ private:
 	uint8_t			_temperature_counter;
 	uint8_t			_temperature_error_count;
 
+	int32_t			_sum[3];	/**< decimation accumulator, raw counts */
+	unsigned		_sum_count;
+
 	/**
 	 * Initialise the automatic measurement state machine and start it.
 	 *
@@ -250,20 +257,20 @@ private:
 	void 			check_conf(void);
 
 	/**
-	 * Perform a poll cycle; collect from the previous measurement
-	 * and start a new one.
-	 *
-	 * This is the heart of the measurement state machine.  This function
-	 * alternately starts a measurement, or collects the data from the
-	 * previous measurement.
+	 * Perform a poll cycle; collect the latest sample from the
+	 * continuously measuring sensor.
 	 *
-	 * When the interval between measurements is greater than the minimum
-	 * measurement interval, a gap is inserted between collection
-	 * and measurement to provide the most recent measurement possible
-	 * at the next interval.
+	 * The sensor is sampled at its output rate; when the requested
+	 * poll interval is longer than that, samples are averaged and
+	 * published at the requested rate instead (oversampled decimation).
 	 */
 	void			cycle();
 
+	/**
+	 * Number of device samples averaged into one published report.
+	 */
+	unsigned		oversample_ratio();
+
 	/**
 	 * Static trampoline from the workq context; because we don't have a
 	 * generic workq wrapper yet.
@@ -351,7 +358,6 @@ HMC5883::HMC5883(device::Device *interface, const char *path, enum Rotation rota
 	_scale{},
 	_range_scale(0), /* default range scale from counts to gauss */
 	_range_ga(1.9f),
-	_collect_phase(false),
 	_class_instance(-1),
 	_orb_class_instance(-1),
 	_mag_topic(nullptr),
@@ -366,7 +372,9 @@ HMC5883::HMC5883(device::Device *interface, const char *path, enum Rotation rota
 	_range_bits(0),
 	_conf_reg(0),
 	_temperature_counter(0),
-	_temperature_error_count(0)
+	_temperature_error_count(0),
+	_sum{},
+	_sum_count(0)
 {
 	// set the device type from the interface
 	_device_id.devid_s.bus_type = _interface->get_device_bus_type();
@@ -663,9 +671,9 @@ HMC5883::ioctl(struct file *filp, int cmd, unsigned long arg)
 					/* convert hz to tick interval via microseconds */
 					unsigned ticks = USEC2TICK(1000000 / arg);
 
-					/* check against maximum rate */
+					/* clamp to the device output rate */
 					if (ticks < USEC2TICK(HMC5883_CONVERSION_INTERVAL)) {
-						return -EINVAL;
+						ticks = USEC2TICK(HMC5883_CONVERSION_INTERVAL);
 					}
 
 					/* update interval for next measurement */
@@ -768,10 +776,20 @@ HMC5883::ioctl(struct file *filp, int cmd, unsigned long arg)
 void
 HMC5883::start()
 {
-	/* reset the report ring and state machine */
-	_collect_phase = false;
+	/* reset the report ring and the decimation accumulator */
+	_sum[0] = _sum[1] = _sum[2] = 0;
+	_sum_count = 0;
 	_reports->flush();
 
+	/* run the sensor in continuous mode with on-chip averaging; every
+	 * cycle is then a single data read instead of a command plus a read */
+	_conf_reg = (_conf_reg & HMC5983_TEMP_SENSOR_ENABLE) | HMC5883L_AVERAGING_8 | HMC5883L_RATE_75HZ;
+
+	if (OK != write_reg(ADDR_CONF_A, _conf_reg) ||
+	    OK != write_reg(ADDR_MODE, MODE_REG_CONTINOUS_MODE)) {
+		perf_count(_comms_errors);
+	}
+
 	/* schedule a cycle to start things */
 	work_queue(HPWORK, &_work, (worker_t)&HMC5883::cycle_trampoline, this, 1);
 }
@@ -783,6 +801,9 @@ HMC5883::stop()
 		/* ensure no new items are queued while we cancel this one */
 		_measure_ticks = 0;
 		work_cancel(HPWORK, &_work);
+
+		/* take the sensor out of continuous mode */
+		write_reg(ADDR_MODE, MODE_REG_IDLE_MODE);
 	}
 }
 
@@ -801,6 +822,18 @@ HMC5883::cycle_trampoline(void *arg)
 	dev->cycle();
 }
 
+unsigned
+HMC5883::oversample_ratio()
+{
+	unsigned interval = USEC2TICK(HMC5883_CONVERSION_INTERVAL);
+
+	if (interval == 0 || _measure_ticks <= interval) {
+		return 1;
+	}
+
+	return _measure_ticks / interval;
+}
+
 void
 HMC5883::cycle()
 {
@@ -808,52 +841,20 @@ HMC5883::cycle()
 		return;
 	}
 
-	/* collection phase? */
-	if (_collect_phase) {
-
-		/* perform collection */
-		if (OK != collect()) {
-			DEVICE_DEBUG("collection error");
-			/* restart the measurement state machine */
-			start();
-			return;
-		}
-
-		/* next phase is measurement */
-		_collect_phase = false;
-
-		/*
-		 * Is there a collect->measure gap?
-		 */
-		if (_measure_ticks > USEC2TICK(HMC5883_CONVERSION_INTERVAL)) {
-
-			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
-				   &_work,
-				   (worker_t)&HMC5883::cycle_trampoline,
-				   this,
-				   _measure_ticks - USEC2TICK(HMC5883_CONVERSION_INTERVAL));
-
-			return;
-		}
-	}
-
-	/* measurement phase */
-	if (OK != measure()) {
-		DEVICE_DEBUG("measure error");
+	/* the sensor measures continuously, every cycle is a single data read */
+	if (OK != collect()) {
+		DEVICE_DEBUG("collection error");
+		/* restart the measurement state machine */
+		start();
+		return;
 	}
 
-	/* next phase is collection */
-	_collect_phase = true;
-
-	if (_measure_ticks > 0) {
-		/* schedule a fresh cycle call when the measurement is done */
-		work_queue(HPWORK,
-			   &_work,
-			   (worker_t)&HMC5883::cycle_trampoline,
-			   this,
-			   USEC2TICK(HMC5883_CONVERSION_INTERVAL));
-	}
+	/* sample at the device output rate; publishing is decimated in collect() */
+	work_queue(HPWORK,
+		   &_work,
+		   (worker_t)&HMC5883::cycle_trampoline,
+		   this,
+		   USEC2TICK(HMC5883_CONVERSION_INTERVAL));
 }
 
 int
@@ -937,6 +938,24 @@ HMC5883::collect()
 		goto out;
 	}
 
+	/* accumulate for oversampled decimation; the device keeps sampling at
+	 * its full output rate, reports go out at the requested poll rate */
+	_sum[0] += report.x;
+	_sum[1] += report.y;
+	_sum[2] += report.z;
+	_sum_count++;
+
+	if (_sum_count < oversample_ratio()) {
+		ret = OK;
+		goto out;
+	}
+
+	report.x = _sum[0] / (int32_t)_sum_count;
+	report.y = _sum[1] / (int32_t)_sum_count;
+	report.z = _sum[2] / (int32_t)_sum_count;
+	_sum[0] = _sum[1] = _sum[2] = 0;
+	_sum_count = 0;
+
 	/* get measurements from the device */
 	new_report.temperature = 0;
 
@@ -1527,6 +1546,7 @@ start_bus(struct hmc5883_bus_option &bus, enum Rotation rotation)
 void
 start(enum HMC5883_BUS busid, enum Rotation rotation)
 {
+	uint64_t start_time = hrt_absolute_time();
 	bool started = false;
 
 	for (unsigned i = 0; i < NUM_BUS_OPTIONS; i++) {
@@ -1543,6 +1563,8 @@ start(enum HMC5883_BUS busid, enum Rotation rotation)
 		started |= start_bus(bus_options[i], rotation);
 	}
 
+	device::init_record("hmc5883", start_time);
+
 	if (!started) {
 		exit(1);
 	}
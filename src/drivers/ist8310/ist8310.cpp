@@ -236,6 +236,9 @@ private:
 	uint8_t 		_ctl3_reg;
 	uint8_t			_ctl4_reg;
 
+	int32_t			_sum[3];	/**< decimation accumulator, raw counts */
+	unsigned		_sum_count;
+
 	/**
 	 * Initialise the automatic measurement state machine and start it.
 	 *
@@ -282,13 +285,18 @@ private:
 	 * alternately starts a measurement, or collects the data from the
 	 * previous measurement.
 	 *
-	 * When the interval between measurements is greater than the minimum
-	 * measurement interval, a gap is inserted between collection
-	 * and measurement to provide the most recent measurement possible
-	 * at the next interval.
+	 * The part has no continuous-measurement mode, so measurements are
+	 * always triggered at the maximum rate; when the requested poll
+	 * interval is longer than that, samples are averaged and published
+	 * at the requested rate instead (oversampled decimation).
 	 */
 	void            cycle();
 
+	/**
+	 * Number of device samples averaged into one published report.
+	 */
+	unsigned        oversample_ratio();
+
 	/**
 	 * Static trampoline from the workq context; because we don't have a
 	 * generic workq wrapper yet.
@@ -415,7 +423,9 @@ IST8310::IST8310(int bus_number, int address, const char *path, enum Rotation ro
 	_rotation(rotation),
 	_last_report{0},
 	_ctl3_reg(0),
-	_ctl4_reg(0)
+	_ctl4_reg(0),
+	_sum{},
+	_sum_count(0)
 {
 	_device_id.devid_s.devtype = DRV_MAG_DEVTYPE_IST8310;
 
@@ -660,9 +670,9 @@ IST8310::ioctl(struct file *filp, int cmd, unsigned long arg)
 					/* convert hz to tick interval via microseconds */
 					unsigned ticks = USEC2TICK(1000000 / arg);
 
-					/* check against maximum rate */
+					/* clamp to the device measurement rate */
 					if (ticks < USEC2TICK(IST8310_CONVERSION_INTERVAL)) {
-						return -EINVAL;
+						ticks = USEC2TICK(IST8310_CONVERSION_INTERVAL);
 					}
 
 					/* update interval for next measurement */
@@ -763,8 +773,10 @@ IST8310::ioctl(struct file *filp, int cmd, unsigned long arg)
 void
 IST8310::start()
 {
-	/* reset the report ring and state machine */
+	/* reset the report ring, the decimation accumulator and the state machine */
 	_collect_phase = false;
+	_sum[0] = _sum[1] = _sum[2] = 0;
+	_sum_count = 0;
 	_reports->flush();
 
 	/* schedule a cycle to start things */
@@ -824,6 +836,18 @@ IST8310::probe()
 	return OK;
 }
 
+unsigned
+IST8310::oversample_ratio()
+{
+	unsigned interval = USEC2TICK(IST8310_CONVERSION_INTERVAL);
+
+	if (interval == 0 || _measure_ticks <= interval) {
+		return 1;
+	}
+
+	return _measure_ticks / interval;
+}
+
 void
 IST8310::cycle()
 {
@@ -838,23 +862,10 @@ IST8310::cycle()
 			return;
 		}
 
-		/* next phase is measurement */
+		/* next phase is measurement; there is no collect->measure gap,
+		 * the device is sampled at its full rate and publishing is
+		 * decimated in collect() */
 		_collect_phase = false;
-
-		/*
-		 * Is there a collect->measure gap?
-		 */
-		if (_measure_ticks > USEC2TICK(IST8310_CONVERSION_INTERVAL)) {
-
-			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
-				   &_work,
-				   (worker_t)&IST8310::cycle_trampoline,
-				   this,
-				   _measure_ticks - USEC2TICK(IST8310_CONVERSION_INTERVAL));
-
-			return;
-		}
 	}
 
 	/* measurement phase */
@@ -956,6 +967,24 @@ IST8310::collect()
 		goto out;
 	}
 
+	/* accumulate for oversampled decimation; the device keeps sampling at
+	 * its full measurement rate, reports go out at the requested poll rate */
+	_sum[0] += report.x;
+	_sum[1] += report.y;
+	_sum[2] += report.z;
+	_sum_count++;
+
+	if (_sum_count < oversample_ratio()) {
+		ret = OK;
+		goto out;
+	}
+
+	report.x = _sum[0] / (int32_t)_sum_count;
+	report.y = _sum[1] / (int32_t)_sum_count;
+	report.z = _sum[2] / (int32_t)_sum_count;
+	_sum[0] = _sum[1] = _sum[2] = 0;
+	_sum_count = 0;
+
 	/* temperature measurement is not available on IST8310 */
 	new_report.temperature = 0;
 
@@ -105,6 +105,7 @@
 
 #define MODE_REG_CONTINOUS_MODE		(0 << 0)
 #define MODE_REG_SINGLE_MODE		(1 << 0) /* default */
+#define MODE_REG_POWERDOWN_MODE		(3 << 0)
 
 enum LIS3MDL_BUS {
 	LIS3MDL_BUS_ALL = 0,
@@ -149,7 +150,6 @@ private:
 	struct mag_calibration_s	_scale;
 	float 			_range_scale;
 	float 			_range_ga;
-	bool			_collect_phase;
 	int			_class_instance;
 	int			_orb_class_instance;
 
@@ -176,6 +176,9 @@ private:
 	uint8_t			_temperature_error_count;
 	uint8_t			_check_state_cnt;
 
+	int32_t			_sum[3];	/**< decimation accumulator, raw counts */
+	unsigned		_sum_count;
+
 	/**
 	 * Initialise the automatic measurement state machine and start it.
 	 *
@@ -229,20 +232,20 @@ private:
 	void 			check_conf(void);
 
 	/**
-	 * Perform a poll cycle; collect from the previous measurement
-	 * and start a new one.
-	 *
-	 * This is the heart of the measurement state machine.  This function
-	 * alternately starts a measurement, or collects the data from the
-	 * previous measurement.
+	 * Perform a poll cycle; collect the latest sample from the
+	 * continuously measuring sensor.
 	 *
-	 * When the interval between measurements is greater than the minimum
-	 * measurement interval, a gap is inserted between collection
-	 * and measurement to provide the most recent measurement possible
-	 * at the next interval.
+	 * The sensor is sampled at its output rate; when the requested
+	 * poll interval is longer than that, samples are averaged and
+	 * published at the requested rate instead (oversampled decimation).
 	 */
 	void			cycle();
 
+	/**
+	 * Number of device samples averaged into one published report.
+	 */
+	unsigned		oversample_ratio();
+
 	/**
 	 * Static trampoline from the workq context; because we don't have a
 	 * generic workq wrapper yet.
@@ -330,7 +333,6 @@ LIS3MDL::LIS3MDL(device::Device *interface, const char *path, enum Rotation rota
 	_scale{},
 	_range_scale(0), /* default range scale from counts to gauss */
 	_range_ga(4.0f),
-	_collect_phase(false),
 	_class_instance(-1),
 	_orb_class_instance(-1),
 	_mag_topic(nullptr),
@@ -348,7 +350,9 @@ LIS3MDL::LIS3MDL(device::Device *interface, const char *path, enum Rotation rota
 	_cntl_reg5(0),
 	_temperature_counter(0),
 	_temperature_error_count(0),
-	_check_state_cnt(0)
+	_check_state_cnt(0),
+	_sum{},
+	_sum_count(0)
 {
 	// set the device type from the interface
 	_device_id.devid_s.bus_type = _interface->get_device_bus_type();
@@ -668,9 +672,9 @@ LIS3MDL::ioctl(struct file *filp, int cmd, unsigned long arg)
 					/* convert hz to tick interval via microseconds */
 					unsigned ticks = USEC2TICK(1000000 / arg);
 
-					/* check against maximum rate */
+					/* clamp to the device output rate */
 					if (ticks < USEC2TICK(LIS3MDL_CONVERSION_INTERVAL)) {
-// RobD: quick fix for Phil's testing						return -EINVAL;
+						ticks = USEC2TICK(LIS3MDL_CONVERSION_INTERVAL);
 					}
 
 					/* update interval for next measurement */
@@ -773,10 +777,19 @@ LIS3MDL::ioctl(struct file *filp, int cmd, unsigned long arg)
 void
 LIS3MDL::start()
 {
-	/* reset the report ring and state machine */
-	_collect_phase = false;
+	/* reset the report ring and the decimation accumulator */
+	_sum[0] = _sum[1] = _sum[2] = 0;
+	_sum_count = 0;
 	_reports->flush();
 
+	/* run the sensor in continuous-conversion mode at its configured output
+	 * rate; every cycle is then a single data read instead of a command
+	 * plus a read */
+	if (OK != write_reg(ADDR_CTRL_REG1, _cntl_reg1) ||
+	    OK != write_reg(ADDR_CTRL_REG3, MODE_REG_CONTINOUS_MODE)) {
+		perf_count(_comms_errors);
+	}
+
 	/* schedule a cycle to start things */
 	work_queue(HPWORK, &_work, (worker_t)&LIS3MDL::cycle_trampoline, this, 1);
 }
@@ -788,6 +801,9 @@ LIS3MDL::stop()
 		/* ensure no new items are queued while we cancel this one */
 		_measure_ticks = 0;
 		work_cancel(HPWORK, &_work);
+
+		/* take the sensor out of continuous-conversion mode */
+		write_reg(ADDR_CTRL_REG3, MODE_REG_POWERDOWN_MODE);
 	}
 }
 
@@ -806,6 +822,18 @@ LIS3MDL::cycle_trampoline(void *arg)
 	dev->cycle();
 }
 
+unsigned
+LIS3MDL::oversample_ratio()
+{
+	unsigned interval = USEC2TICK(LIS3MDL_CONVERSION_INTERVAL);
+
+	if (interval == 0 || _measure_ticks <= interval) {
+		return 1;
+	}
+
+	return _measure_ticks / interval;
+}
+
 void
 LIS3MDL::cycle()
 {
@@ -813,52 +841,20 @@ LIS3MDL::cycle()
 		return;
 	}
 
-	/* collection phase? */
-	if (_collect_phase) {
-
-		/* perform collection */
-		if (OK != collect()) {
-			DEVICE_DEBUG("collection error");
-			/* restart the measurement state machine */
-			start();
-			return;
-		}
-
-		/* next phase is measurement */
-		_collect_phase = false;
-
-		/*
-		 * Is there a collect->measure gap?
-		 */
-		if (_measure_ticks > USEC2TICK(LIS3MDL_CONVERSION_INTERVAL)) {
-
-			/* schedule a fresh cycle call when we are ready to measure again */
-			work_queue(HPWORK,
-				   &_work,
-				   (worker_t)&LIS3MDL::cycle_trampoline,
-				   this,
-				   _measure_ticks - USEC2TICK(LIS3MDL_CONVERSION_INTERVAL));
-
-			return;
-		}
-	}
-
-	/* measurement phase */
-	if (OK != measure()) {
-		DEVICE_DEBUG("measure error");
+	/* the sensor measures continuously, every cycle is a single data read */
+	if (OK != collect()) {
+		DEVICE_DEBUG("collection error");
+		/* restart the measurement state machine */
+		start();
+		return;
 	}
 
-	/* next phase is collection */
-	_collect_phase = true;
-
-	if (_measure_ticks > 0) {
-		/* schedule a fresh cycle call when the measurement is done */
-		work_queue(HPWORK,
-			   &_work,
-			   (worker_t)&LIS3MDL::cycle_trampoline,
-			   this,
-			   USEC2TICK(LIS3MDL_CONVERSION_INTERVAL));
-	}
+	/* sample at the device output rate; publishing is decimated in collect() */
+	work_queue(HPWORK,
+		   &_work,
+		   (worker_t)&LIS3MDL::cycle_trampoline,
+		   this,
+		   USEC2TICK(LIS3MDL_CONVERSION_INTERVAL));
 }
 
 int
@@ -937,6 +933,24 @@ LIS3MDL::collect()
 	report.z = (((int16_t)lis_report.z[1]) << 8) + lis_report.z[0];
 	report.t = (((int16_t)lis_report.t[1]) << 8) + lis_report.t[0];
 
+	/* accumulate for oversampled decimation; the device keeps sampling at
+	 * its full output rate, reports go out at the requested poll rate */
+	_sum[0] += report.x;
+	_sum[1] += report.y;
+	_sum[2] += report.z;
+	_sum_count++;
+
+	if (_sum_count < oversample_ratio()) {
+		ret = OK;
+		goto out;
+	}
+
+	report.x = _sum[0] / (int32_t)_sum_count;
+	report.y = _sum[1] / (int32_t)_sum_count;
+	report.z = _sum[2] / (int32_t)_sum_count;
+	_sum[0] = _sum[1] = _sum[2] = 0;
+	_sum_count = 0;
+
 	/* get measurements from the device */
 	new_report.temperature = report.t;
 	new_report.temperature = 25 + (report.t / (16 * 8.0f));
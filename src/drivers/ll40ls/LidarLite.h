@@ -42,6 +42,7 @@
 
 #include <drivers/device/device.h>
 #include <drivers/drv_range_finder.h>
+#include <rangefinder/MedianFilter.hpp>
 
 /* Device limits */
 #define LL40LS_MIN_DISTANCE (0.05f)
@@ -100,6 +101,10 @@ protected:
 
 	virtual int         reset_sensor() = 0;
 
+	/* optional median prefilter and topic decimation, shared by both
+	 * interface variants (SENS_RNG_FILT / SENS_RNG_DECIM) */
+	rangefinder::MedianFilter _filter;
+
 private:
 	float               _min_distance;
 	float               _max_distance;
@@ -119,6 +119,9 @@ int LidarLiteI2C::init()
 
 	_class_instance = register_class_devname(RANGE_FINDER_BASE_DEVICE_PATH);
 
+	/* optional in-driver median prefilter and topic decimation */
+	_filter.configure_from_params();
+
 	/* get a publish handle on the range finder topic */
 	struct distance_sensor_s ds_report = {};
 	measure();
@@ -458,13 +461,21 @@ int LidarLiteI2C::collect()
 	/* TODO: set proper ID */
 	report.id = 0;
 
-	/* publish it, if we are the primary */
-	if (_distance_sensor_topic != nullptr) {
-		orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &report);
-	}
-
+	/* the device ring always receives the raw sample; the topic gets the
+	 * median-filtered, decimated stream when SENS_RNG_FILT is enabled */
 	_reports->force(&report);
 
+	float filtered;
+
+	if (_filter.update(distance_m, filtered)) {
+		report.current_distance = filtered;
+
+		/* publish it, if we are the primary */
+		if (_distance_sensor_topic != nullptr) {
+			orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &report);
+		}
+	}
+
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
 
@@ -102,6 +102,9 @@ int LidarLitePWM::init()
 
 	_class_instance = register_class_devname(RANGE_FINDER_BASE_DEVICE_PATH);
 
+	/* optional in-driver median prefilter and topic decimation */
+	_filter.configure_from_params();
+
 	/* get a publish handle on the distance_sensor topic */
 	struct distance_sensor_s ds_report = {};
 	measure();
@@ -189,12 +192,21 @@ int LidarLitePWM::measure()
 		return reset_sensor();
 	}
 
-	if (_distance_sensor_topic != nullptr) {
-		orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &_range);
-	}
-
+	/* the device ring always receives the raw sample; the topic gets the
+	 * median-filtered, decimated stream when SENS_RNG_FILT is enabled */
 	_reports->force(&_range);
 
+	float filtered;
+
+	if (_filter.update(_range.current_distance, filtered)) {
+		struct distance_sensor_s report = _range;
+		report.current_distance = filtered;
+
+		if (_distance_sensor_topic != nullptr) {
+			orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &report);
+		}
+	}
+
 	poll_notify(POLLIN);
 	perf_end(_sample_perf);
 	return PX4_OK;
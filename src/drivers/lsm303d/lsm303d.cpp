@@ -67,6 +67,7 @@
 #include <drivers/drv_mag.h>
 #include <drivers/device/ringbuffer.h>
 #include <drivers/device/integrator.h>
+#include <drivers/device/device_init.h>
 
 #include <board_config.h>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
@@ -1910,6 +1911,7 @@ void	test_error();
 void
 start(bool external_bus, enum Rotation rotation, unsigned range)
 {
+	uint64_t start_time = hrt_absolute_time();
 	int fd, fd_mag;
 
 	if (g_dev != nullptr) {
@@ -1964,6 +1966,8 @@ start(bool external_bus, enum Rotation rotation, unsigned range)
 	close(fd);
 	close(fd_mag);
 
+	device::init_record("lsm303d", start_time);
+
 	exit(0);
 fail:
 
@@ -1972,6 +1976,8 @@ fail:
 		g_dev = nullptr;
 	}
 
+	device::init_record("lsm303d", start_time);
+
 	errx(1, "driver start failed");
 }
 
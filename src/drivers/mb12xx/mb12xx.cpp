@@ -72,6 +72,8 @@
 #include <uORB/topics/subsystem_info.h>
 #include <uORB/topics/distance_sensor.h>
 
+#include <rangefinder/MedianFilter.hpp>
+
 #include <board_config.h>
 
 /* Configuration Constants */
@@ -120,6 +122,7 @@ private:
 	float				_max_distance;
 	work_s				_work;
 	ringbuffer::RingBuffer	*_reports;
+	rangefinder::MedianFilter _filter;
 	bool				_sensor_ok;
 	int					_measure_ticks;
 	bool				_collect_phase;
@@ -260,6 +263,9 @@ MB12XX::init()
 
 	_class_instance = register_class_devname(RANGE_FINDER_BASE_DEVICE_PATH);
 
+	/* optional in-driver median prefilter and topic decimation */
+	_filter.configure_from_params();
+
 	/* get a publish handle on the range finder topic */
 	struct distance_sensor_s ds_report = {};
 
@@ -576,13 +582,21 @@ MB12XX::collect()
 	/* TODO: set proper ID */
 	report.id = 0;
 
-	/* publish it, if we are the primary */
-	if (_distance_sensor_topic != nullptr) {
-		orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &report);
-	}
-
+	/* the device ring always receives the raw sample; the topic gets the
+	 * median-filtered, decimated stream when SENS_RNG_FILT is enabled */
 	_reports->force(&report);
 
+	float filtered;
+
+	if (_filter.update(distance_m, filtered)) {
+		report.current_distance = filtered;
+
+		/* publish it, if we are the primary */
+		if (_distance_sensor_topic != nullptr) {
+			orb_publish(ORB_ID(distance_sensor), _distance_sensor_topic, &report);
+		}
+	}
+
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
 
@@ -74,6 +74,10 @@
 
 #include <systemlib/perf_counter.h>
 #include <systemlib/err.h>
+/* logging from this driver must not perturb the sample timing; only
+ * word-sized integer/pointer arguments and persistent strings allowed */
+#define PX4_LOG_DEFERRED
+#include <systemlib/log_defer.h>
 #include <systemlib/conversions.h>
 #include <systemlib/px4_macros.h>
 
@@ -88,8 +92,11 @@
 #include <drivers/device/i2c.h>
 #include <drivers/device/ringbuffer.h>
 #include <drivers/device/integrator.h>
+#include <drivers/device/imu_decode.h>
+#include <drivers/device/device_init.h>
 #include <drivers/drv_accel.h>
 #include <drivers/drv_gyro.h>
+#include <drivers/drv_imu_capture.h>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 #include <lib/conversion/rotation.h>
 
@@ -131,7 +138,7 @@ class MPU6000 : public device::CDev
 {
 public:
 	MPU6000(device::Device *interface, const char *path_accel, const char *path_gyro, enum Rotation rotation,
-		int device_type);
+		int device_type, bool use_fifo);
 	virtual ~MPU6000();
 
 	virtual int		init();
@@ -179,6 +186,7 @@ private:
 	work_s			_work;
 #endif
 	bool 			_use_hrt;
+	bool			_use_fifo;
 
 	struct hrt_call		_call;
 	unsigned		_call_interval;
@@ -207,6 +215,8 @@ private:
 	perf_counter_t		_good_transfers;
 	perf_counter_t		_reset_retries;
 	perf_counter_t		_duplicates;
+	perf_counter_t		_fifo_overflows;
+	perf_counter_t		_call_latency;
 	perf_counter_t		_controller_latency_perf;
 
 	uint8_t			_register_wait;
@@ -223,12 +233,13 @@ private:
 	Integrator		_gyro_int;
 
 	enum Rotation		_rotation;
+	FixedRotation		_fixed_rotation;
 
 	// this is used to support runtime checking of key
 	// configuration registers to detect SPI bus errors and sensor
 	// reset
 #define MPU6000_CHECKED_PRODUCT_ID_INDEX 0
-#define MPU6000_NUM_CHECKED_REGISTERS 10
+#define MPU6000_NUM_CHECKED_REGISTERS 11
 	static const uint8_t	_checked_registers[MPU6000_NUM_CHECKED_REGISTERS];
 	uint8_t			_checked_values[MPU6000_NUM_CHECKED_REGISTERS];
 	uint8_t			_checked_next;
@@ -244,6 +255,17 @@ private:
 	uint16_t		_last_accel[3];
 	bool			_got_duplicate;
 
+	// raw capture mode (see drv_imu_capture.h): FIFO bursts are copied
+	// verbatim into a byte ring drained by the 'imu_capture' command.
+	// Single producer (hrt callout) / single consumer (fetch ioctl),
+	// so the volatile indices need no locking.
+	uint8_t			*_capture_buf;
+	volatile unsigned	_capture_head;
+	volatile unsigned	_capture_tail;
+	volatile bool		_capture_active;
+	hrt_abstime		_capture_end_time;
+	unsigned		_capture_dropped;
+
 	/**
 	 * Start automatic measurement.
 	 */
@@ -319,6 +341,56 @@ private:
 	 */
 	int			measure();
 
+	/**
+	 * One sample decoded from the sensor registers or from a FIFO
+	 * record: little endian, axes swapped into board frame.
+	 */
+	typedef device::IMUSample SensorSample;
+
+	/**
+	 * Compile-time specialized record decode: the MPU6000 transfers
+	 * big endian data and its axes are rotated into the board frame.
+	 */
+	typedef device::IMUDecoder<true, true> SampleDecoder;
+
+	/**
+	 * Drain the on-chip FIFO and process all samples it contains.
+	 *
+	 * Used instead of measure() when FIFO burst mode is enabled.
+	 */
+	int			measure_fifo();
+
+	/**
+	 * Scale, filter, integrate and publish one decoded sample.
+	 */
+	void			process_sample(SensorSample &report, const hrt_abstime timestamp);
+
+	/**
+	 * Start a duration-limited raw capture (see drv_imu_capture.h).
+	 *
+	 * @param duration_s	Capture duration in seconds.
+	 * @return		OK, or -ENOTSUP when FIFO mode is off.
+	 */
+	int			capture_start(unsigned duration_s);
+
+	/**
+	 * Stop a running capture and release the ring buffer.
+	 */
+	void			capture_stop();
+
+	/**
+	 * Copy buffered capture data out of the ring (task context).
+	 *
+	 * @return		Number of bytes copied.
+	 */
+	int			capture_fetch(struct imu_capture_fetch_s *fetch);
+
+	/**
+	 * Append one raw FIFO burst to the capture ring (hrt context).
+	 * Drops the whole block when the ring is too full.
+	 */
+	void			capture_put_block(hrt_abstime timestamp, const void *samples, unsigned n_samples);
+
 	/**
 	 * Read a register from the MPU6000
 	 *
@@ -436,6 +508,7 @@ const uint8_t MPU6000::_checked_registers[MPU6000_NUM_CHECKED_REGISTERS] = { MPU
 									     MPUREG_ACCEL_CONFIG,
 									     MPUREG_INT_ENABLE,
 									     MPUREG_INT_PIN_CFG,
+									     MPUREG_FIFO_EN,
 									     MPUREG_ICM_UNDOC1
 									   };
 
@@ -475,7 +548,7 @@ private:
 extern "C" { __EXPORT int mpu6000_main(int argc, char *argv[]); }
 
 MPU6000::MPU6000(device::Device *interface, const char *path_accel, const char *path_gyro, enum Rotation rotation,
-		 int device_type) :
+		 int device_type, bool use_fifo) :
 	CDev("MPU6000", path_accel),
 	_interface(interface),
 	_device_type(device_type),
@@ -487,6 +560,7 @@ MPU6000::MPU6000(device::Device *interface, const char *path_accel, const char *
 #else
 	_use_hrt(true),
 #endif
+	_use_fifo(use_fifo),
 	_call {},
 	_call_interval(0),
 	_accel_reports(nullptr),
@@ -509,6 +583,8 @@ MPU6000::MPU6000(device::Device *interface, const char *path_accel, const char *
 	_good_transfers(perf_alloc(PC_COUNT, "mpu6k_good_trans")),
 	_reset_retries(perf_alloc(PC_COUNT, "mpu6k_reset")),
 	_duplicates(perf_alloc(PC_COUNT, "mpu6k_duplicates")),
+	_fifo_overflows(perf_alloc(PC_COUNT, "mpu6k_fifo_oflow")),
+	_call_latency(perf_alloc(PC_ELAPSED, "mpu6k_call_latency")),
 	_controller_latency_perf(perf_alloc_once(PC_ELAPSED, "ctrl_latency")),
 	_register_wait(0),
 	_reset_wait(0),
@@ -525,11 +601,20 @@ MPU6000::MPU6000(device::Device *interface, const char *path_accel, const char *
 	_in_factory_test(false),
 	_last_temperature(0),
 	_last_accel{},
-	_got_duplicate(false)
+	_got_duplicate(false),
+	_capture_buf(nullptr),
+	_capture_head(0),
+	_capture_tail(0),
+	_capture_active(false),
+	_capture_end_time(0),
+	_capture_dropped(0)
 {
 	// disable debug() calls
 	_debug_enabled = false;
 
+	// resolve the mounting rotation once instead of per sample
+	_fixed_rotation.set_rotation(rotation);
+
 	// set the device type from the interface
 	_device_id.devid_s.bus_type = _interface->get_device_bus_type();
 	_device_id.devid_s.bus = _interface->get_device_bus();
@@ -594,6 +679,13 @@ MPU6000::~MPU6000()
 	/* make sure we are truly inactive */
 	stop();
 
+	/* release a leftover capture ring; the callout is cancelled */
+	_capture_active = false;
+
+	if (_capture_buf != nullptr) {
+		free(_capture_buf);
+	}
+
 	/* delete the gyro subdriver */
 	delete _gyro;
 
@@ -619,6 +711,8 @@ MPU6000::~MPU6000()
 	perf_free(_good_transfers);
 	perf_free(_reset_retries);
 	perf_free(_duplicates);
+	perf_free(_fifo_overflows);
+	perf_free(_call_latency);
 }
 
 int
@@ -628,6 +722,12 @@ MPU6000::init()
 #if defined(USE_I2C)
 	unsigned dummy;
 	use_i2c(_interface->ioctl(MPUIOCGIS_I2C, dummy));
+
+	/* FIFO burst reads are only worthwhile on SPI */
+	if (is_i2c()) {
+		_use_fifo = false;
+	}
+
 #endif
 
 
@@ -817,6 +917,19 @@ int MPU6000::reset()
 	write_checked_reg(MPUREG_INT_PIN_CFG, BIT_INT_ANYRD_2CLEAR); // INT: Clear on any read
 	usleep(1000);
 
+	if (_use_fifo) {
+		// stream accel, temp and gyro into the on-chip FIFO so
+		// samples can be fetched in bursts
+		write_reg(MPUREG_USER_CTRL, (is_i2c() ? 0 : BIT_I2C_IF_DIS) | BIT_FIFO_RST);
+		write_checked_reg(MPUREG_USER_CTRL, (is_i2c() ? 0 : BIT_I2C_IF_DIS) | BIT_FIFO_ENABLE);
+		write_checked_reg(MPUREG_FIFO_EN, BITS_FIFO_EN_ACCEL | BITS_FIFO_EN_TEMP | BITS_FIFO_EN_GYRO);
+
+	} else {
+		write_checked_reg(MPUREG_FIFO_EN, 0);
+	}
+
+	usleep(1000);
+
 	if (is_icm_device()) {
 		write_checked_reg(MPUREG_ICM_UNDOC1, MPUREG_ICM_UNDOC1_VALUE);
 	}
@@ -1027,18 +1140,8 @@ MPU6000::read(struct file *filp, char *buffer, size_t buflen)
 
 	perf_count(_accel_reads);
 
-	/* copy reports out of our buffer to the caller */
-	accel_report *arp = reinterpret_cast<accel_report *>(buffer);
-	int transferred = 0;
-
-	while (count--) {
-		if (!_accel_reports->get(arp)) {
-			break;
-		}
-
-		transferred++;
-		arp++;
-	}
+	/* drain reports out of our buffer to the caller in one go */
+	unsigned transferred = _accel_reports->get_multiple(buffer, count);
 
 	/* return the number of bytes transferred */
 	return (transferred * sizeof(accel_report));
@@ -1312,18 +1415,8 @@ MPU6000::gyro_read(struct file *filp, char *buffer, size_t buflen)
 
 	perf_count(_gyro_reads);
 
-	/* copy reports out of our buffer to the caller */
-	gyro_report *grp = reinterpret_cast<gyro_report *>(buffer);
-	int transferred = 0;
-
-	while (count--) {
-		if (!_gyro_reports->get(grp)) {
-			break;
-		}
-
-		transferred++;
-		grp++;
-	}
+	/* drain reports out of our buffer to the caller in one go */
+	unsigned transferred = _gyro_reports->get_multiple(buffer, count);
 
 	/* return the number of bytes transferred */
 	return (transferred * sizeof(gyro_report));
@@ -1406,7 +1499,7 @@ MPU6000::ioctl(struct file *filp, int cmd, unsigned long arg)
 					  stm32 clock and the mpu6000 clock
 					 */
 
-					if (!is_i2c()) {
+					if (!is_i2c() && !_use_fifo) {
 						_call.period = _call_interval - MPU6000_TIMER_REDUCTION;
 					}
 
@@ -1503,6 +1596,16 @@ MPU6000::ioctl(struct file *filp, int cmd, unsigned long arg)
 	case ACCELIOCGEXTERNAL:
 		return _interface->ioctl(cmd, dummy);
 
+	case IMUCAPIOCSTART:
+		return capture_start(arg);
+
+	case IMUCAPIOCSTOP:
+		capture_stop();
+		return OK;
+
+	case IMUCAPIOCFETCH:
+		return capture_fetch((struct imu_capture_fetch_s *)arg);
+
 	default:
 		/* give it to the superclass */
 		return CDev::ioctl(filp, cmd, arg);
@@ -1705,12 +1808,23 @@ MPU6000::start()
 	_gyro_reports->flush();
 
 	if (!is_i2c()) {
+		unsigned call_interval = _call_interval;
+
+		if (_use_fifo) {
+			/* drain the FIFO in bursts; the integrator keeps the
+			 * published output rate unchanged */
+			call_interval = MPU6000_FIFO_BURST_SAMPLES * (1000000 / _sample_rate);
+		}
+
 		/* start polling at the specified rate */
 		hrt_call_every(&_call,
 			       1000,
-			       _call_interval - MPU6000_TIMER_REDUCTION,
+			       call_interval - MPU6000_TIMER_REDUCTION,
 			       (hrt_callout)&MPU6000::measure_trampoline, this);
 
+		/* track how much the sample callout is delayed by other work */
+		hrt_call_set_latency_perf(&_call, _call_latency);
+
 	} else {
 #ifdef USE_I2C
 		/* schedule a cycle to start things */
@@ -1724,6 +1838,7 @@ MPU6000::stop()
 {
 
 	if (!is_i2c()) {
+		hrt_call_set_latency_perf(&_call, NULL);
 		hrt_cancel(&_call);
 
 	} else {
@@ -1850,6 +1965,10 @@ MPU6000::check_registers(void)
 int
 MPU6000::measure()
 {
+	if (_use_fifo) {
+		return measure_fifo();
+	}
+
 	if (_in_factory_test) {
 		// don't publish any data while in factory test mode
 		return OK;
@@ -1861,16 +1980,7 @@ MPU6000::measure()
 	}
 
 	struct MPUReport mpu_report;
-
-	struct Report {
-		int16_t		accel_x;
-		int16_t		accel_y;
-		int16_t		accel_z;
-		int16_t		temp;
-		int16_t		gyro_x;
-		int16_t		gyro_y;
-		int16_t		gyro_z;
-	} report;
+	SensorSample report;
 
 	/* start measuring */
 	perf_begin(_sample_perf);
@@ -1909,26 +2019,11 @@ MPU6000::measure()
 	_got_duplicate = false;
 
 	/*
-	 * Convert from big to little endian
+	 * Convert from big to little endian and rotate into board frame
 	 */
+	SampleDecoder::decode(mpu_report, report);
 
-	report.accel_x = int16_t_from_bytes(mpu_report.accel_x);
-	report.accel_y = int16_t_from_bytes(mpu_report.accel_y);
-	report.accel_z = int16_t_from_bytes(mpu_report.accel_z);
-
-	report.temp = int16_t_from_bytes(mpu_report.temp);
-
-	report.gyro_x = int16_t_from_bytes(mpu_report.gyro_x);
-	report.gyro_y = int16_t_from_bytes(mpu_report.gyro_y);
-	report.gyro_z = int16_t_from_bytes(mpu_report.gyro_z);
-
-	if (report.accel_x == 0 &&
-	    report.accel_y == 0 &&
-	    report.accel_z == 0 &&
-	    report.temp == 0 &&
-	    report.gyro_x == 0 &&
-	    report.gyro_y == 0 &&
-	    report.gyro_z == 0) {
+	if (SampleDecoder::all_zero(report)) {
 		// all zero data - probably a SPI bus error
 		perf_count(_bad_transfers);
 		perf_end(_sample_perf);
@@ -1949,24 +2044,262 @@ MPU6000::measure()
 		return OK;
 	}
 
+	process_sample(report, hrt_absolute_time());
+
+	/* stop measuring */
+	perf_end(_sample_perf);
+	return OK;
+}
+
+int
+MPU6000::measure_fifo()
+{
+	if (_in_factory_test) {
+		// don't publish any data while in factory test mode
+		return OK;
+	}
+
+	if (hrt_absolute_time() < _reset_wait) {
+		// we're waiting for a reset to complete
+		return OK;
+	}
+
+	/* start measuring */
+	perf_begin(_sample_perf);
+
+	/* the FIFO fills with one record per sample at the output data rate */
+	unsigned count = read_reg16(MPUREG_FIFO_COUNTH);
+	unsigned n_samples = count / sizeof(MPUFifoSample);
+
+	if (count > MPU6000_FIFO_SIZE - 2 * sizeof(MPUFifoSample)) {
+		// the FIFO ran (nearly) full, so we have lost samples
+		// and the record boundaries may no longer line up:
+		// reset it and start over
+		perf_count(_fifo_overflows);
+		write_reg(MPUREG_USER_CTRL, (is_i2c() ? 0 : BIT_I2C_IF_DIS) | BIT_FIFO_ENABLE | BIT_FIFO_RST);
+		perf_end(_sample_perf);
+		return -EIO;
+	}
 
 	/*
-	 * Swap axes and negate y
+	 * Drain only when at least two records are available; the
+	 * interface treats shorter transfers as plain register reads.
+	 * A partial record stays in the FIFO for the next cycle.
 	 */
-	int16_t accel_xt = report.accel_y;
-	int16_t accel_yt = ((report.accel_x == -32768) ? 32767 : -report.accel_x);
+	if (n_samples < 2) {
+		perf_end(_sample_perf);
+		return OK;
+	}
 
-	int16_t gyro_xt = report.gyro_y;
-	int16_t gyro_yt = ((report.gyro_x == -32768) ? 32767 : -report.gyro_x);
+	if (n_samples > MPU6000_FIFO_MAX_SAMPLES) {
+		n_samples = MPU6000_FIFO_MAX_SAMPLES;
+	}
+
+#pragma pack(push, 1)
+	struct {
+		uint8_t			cmd;
+		MPUFifoSample	f[MPU6000_FIFO_MAX_SAMPLES];
+	} mpu_fifo;
+#pragma pack(pop)
+
+	const unsigned transfer_size = n_samples * sizeof(MPUFifoSample) + 1;
+
+	// fetch the whole burst in a single high speed transfer
+	if (_interface->read(MPU6000_SET_SPEED(MPUREG_FIFO_R_W, MPU6000_HIGH_BUS_SPEED),
+			     (uint8_t *)&mpu_fifo, transfer_size) != (int)transfer_size) {
+		perf_count(_bad_transfers);
+		perf_end(_sample_perf);
+		return -EIO;
+	}
+
+	check_registers();
+
+	if (_register_wait != 0) {
+		// we are waiting for some good transfers before using
+		// the sensor again, drop the drained samples
+		_register_wait--;
+		perf_end(_sample_perf);
+		return OK;
+	}
 
 	/*
-	 * Apply the swap
+	 * The newest record was produced "now"; back-date the older
+	 * ones by the sample interval of the output data rate so the
+	 * integrator sees accurate per-sample timestamps.
 	 */
-	report.accel_x = accel_xt;
-	report.accel_y = accel_yt;
-	report.gyro_x = gyro_xt;
-	report.gyro_y = gyro_yt;
+	const hrt_abstime now = hrt_absolute_time();
+	const hrt_abstime sample_interval = 1000000 / _sample_rate;
+
+	if (_capture_active) {
+		if (now >= _capture_end_time) {
+			/* duration elapsed; the consumer drains the rest and stops */
+			_capture_active = false;
+
+		} else {
+			capture_put_block(now, mpu_fifo.f, n_samples);
+		}
+	}
+
+	for (unsigned i = 0; i < n_samples; i++) {
+		SensorSample report;
+
+		SampleDecoder::decode(mpu_fifo.f[i], report);
+
+		if (SampleDecoder::all_zero(report)) {
+			// all zero data - probably a SPI bus error
+			perf_count(_bad_transfers);
+			continue;
+		}
+
+		process_sample(report, now - (n_samples - 1 - i) * sample_interval);
+	}
+
+	perf_count(_good_transfers);
+
+	/* stop measuring */
+	perf_end(_sample_perf);
+	return OK;
+}
+
+int
+MPU6000::capture_start(unsigned duration_s)
+{
+	if (!_use_fifo) {
+		/* the capture stream is built from raw FIFO bursts */
+		return -ENOTSUP;
+	}
+
+	if (duration_s == 0) {
+		return -EINVAL;
+	}
+
+	if (_capture_buf != nullptr) {
+		return -EBUSY;
+	}
+
+	_capture_buf = (uint8_t *)malloc(MPU6000_CAPTURE_BUF_SIZE);
+
+	if (_capture_buf == nullptr) {
+		return -ENOMEM;
+	}
+
+	/* seed the ring with the post-processing header */
+	struct imu_capture_file_header_s header;
+	memset(&header, 0, sizeof(header));
+	header.magic = IMU_CAPTURE_MAGIC;
+	header.version = IMU_CAPTURE_VERSION;
+	header.sample_size = sizeof(MPUFifoSample);
+	header.sample_rate = _sample_rate;
+	header.device_id = _device_id.devid;
+	header.accel_range_scale = _accel_range_scale;
+	header.gyro_range_scale = _gyro_range_scale;
+	header.start_time = hrt_absolute_time();
+
+	memcpy(_capture_buf, &header, sizeof(header));
+	_capture_head = sizeof(header);
+	_capture_tail = 0;
+	_capture_dropped = 0;
+	_capture_end_time = header.start_time + duration_s * 1000000ULL;
+
+	/* the producer only looks at the ring once this goes true */
+	_capture_active = true;
+
+	return OK;
+}
+
+void
+MPU6000::capture_stop()
+{
+	_capture_active = false;
 
+	if (_capture_buf == nullptr) {
+		return;
+	}
+
+	/* the callout samples _capture_active once per burst; wait out one
+	 * burst interval so no callout is still writing into the ring */
+	usleep(2 * MPU6000_FIFO_BURST_SAMPLES * (1000000 / _sample_rate));
+
+	if (_capture_dropped > 0) {
+		PX4_WARN("capture dropped %u FIFO bursts (ring overrun)", _capture_dropped);
+	}
+
+	free(_capture_buf);
+	_capture_buf = nullptr;
+}
+
+int
+MPU6000::capture_fetch(struct imu_capture_fetch_s *fetch)
+{
+	if (fetch == nullptr || fetch->buffer == nullptr) {
+		return -EINVAL;
+	}
+
+	if (_capture_buf == nullptr) {
+		return -ENODATA;
+	}
+
+	const unsigned head = _capture_head;
+	unsigned tail = _capture_tail;
+	uint8_t *out = (uint8_t *)fetch->buffer;
+	unsigned copied = 0;
+
+	while (tail != head && copied < fetch->length) {
+		/* copy the contiguous stretch up to the head or the wrap point */
+		unsigned end = (head > tail) ? head : MPU6000_CAPTURE_BUF_SIZE;
+		unsigned chunk = end - tail;
+
+		if (chunk > fetch->length - copied) {
+			chunk = fetch->length - copied;
+		}
+
+		memcpy(out + copied, _capture_buf + tail, chunk);
+		copied += chunk;
+		tail = (tail + chunk) % MPU6000_CAPTURE_BUF_SIZE;
+	}
+
+	_capture_tail = tail;
+
+	return copied;
+}
+
+void
+MPU6000::capture_put_block(hrt_abstime timestamp, const void *samples, unsigned n_samples)
+{
+	const unsigned payload = n_samples * sizeof(MPUFifoSample);
+	const unsigned needed = sizeof(struct imu_capture_block_header_s) + payload;
+
+	/* one slot always stays free so head == tail means empty */
+	const unsigned used = (_capture_head + MPU6000_CAPTURE_BUF_SIZE - _capture_tail) % MPU6000_CAPTURE_BUF_SIZE;
+
+	if (needed >= MPU6000_CAPTURE_BUF_SIZE - used) {
+		/* drop the whole block; the stream stays parseable */
+		_capture_dropped++;
+		return;
+	}
+
+	struct imu_capture_block_header_s block;
+	block.timestamp = timestamp;
+	block.n_samples = n_samples;
+
+	unsigned head = _capture_head;
+	const uint8_t *in[2] = {(const uint8_t *)&block, (const uint8_t *)samples};
+	unsigned len[2] = {sizeof(block), payload};
+
+	for (unsigned part = 0; part < 2; part++) {
+		for (unsigned i = 0; i < len[part]; i++) {
+			_capture_buf[head] = in[part][i];
+			head = (head + 1) % MPU6000_CAPTURE_BUF_SIZE;
+		}
+	}
+
+	/* publish the block to the consumer in one go */
+	_capture_head = head;
+}
+
+void
+MPU6000::process_sample(SensorSample &report, const hrt_abstime timestamp)
+{
 	/*
 	 * Report buffers.
 	 */
@@ -1976,7 +2309,7 @@ MPU6000::measure()
 	/*
 	 * Adjust and scale results to m/s^2.
 	 */
-	grb.timestamp = arb.timestamp = hrt_absolute_time();
+	grb.timestamp = arb.timestamp = timestamp;
 
 	// report the error count as the sum of the number of bad
 	// transfers and bad register reads. This allows the higher
@@ -2011,7 +2344,7 @@ MPU6000::measure()
 	float zraw_f = report.accel_z;
 
 	// apply user specified rotation
-	rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
+	_fixed_rotation.rotate(xraw_f, yraw_f, zraw_f);
 
 	float x_in_new = ((xraw_f * _accel_range_scale) - _accel_scale.x_offset) * _accel_scale.x_scale;
 	float y_in_new = ((yraw_f * _accel_range_scale) - _accel_scale.y_offset) * _accel_scale.y_scale;
@@ -2054,7 +2387,7 @@ MPU6000::measure()
 	zraw_f = report.gyro_z;
 
 	// apply user specified rotation
-	rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
+	_fixed_rotation.rotate(xraw_f, yraw_f, zraw_f);
 
 	float x_gyro_in_new = ((xraw_f * _gyro_range_scale) - _gyro_scale.x_offset) * _gyro_scale.x_scale;
 	float y_gyro_in_new = ((yraw_f * _gyro_range_scale) - _gyro_scale.y_offset) * _gyro_scale.y_scale;
@@ -2104,10 +2437,6 @@ MPU6000::measure()
 		/* publish it */
 		orb_publish(ORB_ID(sensor_gyro), _gyro->_gyro_topic, &grb);
 	}
-
-	/* stop measuring */
-	perf_end(_sample_perf);
-	return OK;
 }
 
 void
@@ -2270,8 +2599,8 @@ struct mpu6000_bus_option {
 #define NUM_BUS_OPTIONS (sizeof(bus_options)/sizeof(bus_options[0]))
 
 
-void	start(enum MPU6000_BUS busid, enum Rotation rotation, int range, int device_type);
-bool 	start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int range, int device_type);
+void	start(enum MPU6000_BUS busid, enum Rotation rotation, int range, int device_type, bool use_fifo);
+bool 	start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int range, int device_type, bool use_fifo);
 void	stop(enum MPU6000_BUS busid);
 void	test(enum MPU6000_BUS busid);
 static struct mpu6000_bus_option &find_bus(enum MPU6000_BUS busid);
@@ -2301,7 +2630,7 @@ struct mpu6000_bus_option &find_bus(enum MPU6000_BUS busid)
  * start driver for a specific bus option
  */
 bool
-start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int range, int device_type)
+start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int range, int device_type, bool use_fifo)
 {
 	int fd = -1;
 
@@ -2323,7 +2652,7 @@ start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int range, int
 		return false;
 	}
 
-	bus.dev = new MPU6000(interface, bus.accelpath, bus.gyropath, rotation, device_type);
+	bus.dev = new MPU6000(interface, bus.accelpath, bus.gyropath, rotation, device_type, use_fifo);
 
 	if (bus.dev == nullptr) {
 		delete interface;
@@ -2375,8 +2704,9 @@ fail:
  * or failed to detect the sensor.
  */
 void
-start(enum MPU6000_BUS busid, enum Rotation rotation, int range, int device_type)
+start(enum MPU6000_BUS busid, enum Rotation rotation, int range, int device_type, bool use_fifo)
 {
+	uint64_t start_time = hrt_absolute_time();
 
 	bool started = false;
 
@@ -2396,9 +2726,11 @@ start(enum MPU6000_BUS busid, enum Rotation rotation, int range, int device_type
 			continue;
 		}
 
-		started |= start_bus(bus_options[i], rotation, range, device_type);
+		started |= start_bus(bus_options[i], rotation, range, device_type, use_fifo);
 	}
 
+	device::init_record("mpu6000", start_time);
+
 	exit(started ? 0 : 1);
 
 }
@@ -2620,6 +2952,7 @@ usage()
 	warnx("    -T 6000|20608|20602 (default 6000)");
 	warnx("    -R rotation");
 	warnx("    -a accel range (in g)");
+	warnx("    -f use on-chip FIFO burst reads (SPI only)");
 }
 
 } // namespace
@@ -2632,9 +2965,10 @@ mpu6000_main(int argc, char *argv[])
 	int ch;
 	enum Rotation rotation = ROTATION_NONE;
 	int accel_range = MPU6000_ACCEL_DEFAULT_RANGE_G;
+	bool use_fifo = false;
 
 	/* jump over start/off/etc and look at options first */
-	while ((ch = getopt(argc, argv, "T:XISsZzR:a:")) != EOF) {
+	while ((ch = getopt(argc, argv, "T:XISsZzR:a:f")) != EOF) {
 		switch (ch) {
 		case 'X':
 			busid = MPU6000_BUS_I2C_EXTERNAL;
@@ -2672,6 +3006,10 @@ mpu6000_main(int argc, char *argv[])
 			accel_range = atoi(optarg);
 			break;
 
+		case 'f':
+			use_fifo = true;
+			break;
+
 		default:
 			mpu6000::usage();
 			exit(0);
@@ -2685,7 +3023,7 @@ mpu6000_main(int argc, char *argv[])
 
 	 */
 	if (!strcmp(verb, "start")) {
-		mpu6000::start(busid, rotation, accel_range, device_type);
+		mpu6000::start(busid, rotation, accel_range, device_type, use_fifo);
 	}
 
 	if (!strcmp(verb, "stop")) {
@@ -143,6 +143,12 @@
 #define BIT_RAW_RDY_EN			0x01
 #define BIT_I2C_IF_DIS			0x10
 #define BIT_INT_STATUS_DATA		0x01
+#define BIT_INT_STATUS_FIFO_OFLOW	0x10
+#define BIT_FIFO_ENABLE			0x40
+#define BIT_FIFO_RST			0x04
+#define BITS_FIFO_EN_TEMP		0x80
+#define BITS_FIFO_EN_GYRO		0x70
+#define BITS_FIFO_EN_ACCEL		0x08
 
 #define MPU_WHOAMI_6000			0x68
 #define ICM_WHOAMI_20602		0x12
@@ -237,8 +243,36 @@ struct MPUReport {
 	uint8_t		gyro_y[2];
 	uint8_t		gyro_z[2];
 };
+
+/**
+ * One sample record as streamed into the on-chip FIFO when accel,
+ * temperature and gyro are enabled in MPUREG_FIFO_EN.
+ */
+struct MPUFifoSample {
+	uint8_t		accel_x[2];
+	uint8_t		accel_y[2];
+	uint8_t		accel_z[2];
+	uint8_t		temp[2];
+	uint8_t		gyro_x[2];
+	uint8_t		gyro_y[2];
+	uint8_t		gyro_z[2];
+};
 #pragma pack(pop)
 
+/* size of the on-chip FIFO in bytes */
+#define MPU6000_FIFO_SIZE		1024
+
+/* nominal number of samples fetched in one FIFO drain */
+#define MPU6000_FIFO_BURST_SAMPLES	8
+
+/* maximum number of samples processed in one FIFO drain */
+#define MPU6000_FIFO_MAX_SAMPLES	16
+
+/* size of the raw capture ring buffer (see drv_imu_capture.h); at the
+ * 8 kHz output data rate this holds roughly 70 ms of samples, plenty for
+ * a consumer draining every 10 ms */
+#define MPU6000_CAPTURE_BUF_SIZE	8192
+
 #define MPU_MAX_READ_BUFFER_SIZE (sizeof(MPUReport) + 1)
 #define MPU_MAX_WRITE_BUFFER_SIZE (2)
 /*
@@ -130,8 +130,8 @@ struct mpu9250_bus_option {
 #define NUM_BUS_OPTIONS (sizeof(bus_options)/sizeof(bus_options[0]))
 
 
-void	start(enum MPU9250_BUS busid, enum Rotation rotation, bool external_bus);
-bool	start_bus(struct mpu9250_bus_option &bus, enum Rotation rotation, bool external_bus);
+void	start(enum MPU9250_BUS busid, enum Rotation rotation, bool external_bus, bool use_fifo);
+bool	start_bus(struct mpu9250_bus_option &bus, enum Rotation rotation, bool external_bus, bool use_fifo);
 struct mpu9250_bus_option &find_bus(enum MPU9250_BUS busid);
 void	stop(enum MPU9250_BUS busid);
 void	test(enum MPU9250_BUS busid);
@@ -160,7 +160,7 @@ struct mpu9250_bus_option &find_bus(enum MPU9250_BUS busid)
  * start driver for a specific bus option
  */
 bool
-start_bus(struct mpu9250_bus_option &bus, enum Rotation rotation, bool external)
+start_bus(struct mpu9250_bus_option &bus, enum Rotation rotation, bool external, bool use_fifo)
 {
 	int fd = -1;
 
@@ -194,7 +194,7 @@ start_bus(struct mpu9250_bus_option &bus, enum Rotation rotation, bool external)
 
 #endif
 
-	bus.dev = new MPU9250(interface, mag_interface, bus.accelpath, bus.gyropath, bus.magpath, rotation);
+	bus.dev = new MPU9250(interface, mag_interface, bus.accelpath, bus.gyropath, bus.magpath, rotation, use_fifo);
 
 	if (bus.dev == nullptr) {
 		delete interface;
@@ -242,7 +242,7 @@ fail:
  * or failed to detect the sensor.
  */
 void
-start(enum MPU9250_BUS busid, enum Rotation rotation, bool external)
+start(enum MPU9250_BUS busid, enum Rotation rotation, bool external, bool use_fifo)
 {
 
 	bool started = false;
@@ -258,7 +258,7 @@ start(enum MPU9250_BUS busid, enum Rotation rotation, bool external)
 			continue;
 		}
 
-		started |= start_bus(bus_options[i], rotation, external);
+		started |= start_bus(bus_options[i], rotation, external, use_fifo);
 	}
 
 	exit(started ? 0 : 1);
@@ -483,6 +483,7 @@ usage()
 	warnx("options:");
 	warnx("    -X    (external bus)");
 	warnx("    -R rotation");
+	warnx("    -f use on-chip FIFO burst reads (SPI only)");
 }
 
 } // namespace
@@ -493,10 +494,11 @@ mpu9250_main(int argc, char *argv[])
 	enum MPU9250_BUS busid = MPU9250_BUS_ALL;
 	int ch;
 	bool external = false;
+	bool use_fifo = false;
 	enum Rotation rotation = ROTATION_NONE;
 
 	/* jump over start/off/etc and look at options first */
-	while ((ch = getopt(argc, argv, "XISsR:")) != EOF) {
+	while ((ch = getopt(argc, argv, "XISsR:f")) != EOF) {
 		switch (ch) {
 		case 'X':
 			busid = MPU9250_BUS_I2C_EXTERNAL;
@@ -518,6 +520,10 @@ mpu9250_main(int argc, char *argv[])
 			rotation = (enum Rotation)atoi(optarg);
 			break;
 
+		case 'f':
+			use_fifo = true;
+			break;
+
 		default:
 			mpu9250::usage();
 			exit(0);
@@ -533,7 +539,7 @@ mpu9250_main(int argc, char *argv[])
 
 	 */
 	if (!strcmp(verb, "start")) {
-		mpu9250::start(busid, rotation, external);
+		mpu9250::start(busid, rotation, external, use_fifo);
 	}
 
 	if (!strcmp(verb, "stop")) {
@@ -106,13 +106,14 @@ const uint8_t MPU9250::_checked_registers[MPU9250_NUM_CHECKED_REGISTERS] = { MPU
 									     MPUREG_ACCEL_CONFIG,
 									     MPUREG_ACCEL_CONFIG2,
 									     MPUREG_INT_ENABLE,
-									     MPUREG_INT_PIN_CFG
+									     MPUREG_INT_PIN_CFG,
+									     MPUREG_FIFO_EN
 									   };
 
 
 MPU9250::MPU9250(device::Device *interface, device::Device *mag_interface, const char *path_accel,
 		 const char *path_gyro, const char *path_mag,
-		 enum Rotation rotation) :
+		 enum Rotation rotation, bool use_fifo) :
 	CDev("MPU9250", path_accel),
 	_interface(interface),
 	_gyro(new MPU9250_gyro(this, path_gyro)),
@@ -124,6 +125,7 @@ MPU9250::MPU9250(device::Device *interface, device::Device *mag_interface, const
 #else
 	_use_hrt(true),
 #endif
+	_use_fifo(use_fifo),
 	_call {},
 	_call_interval(0),
 	_accel_reports(nullptr),
@@ -147,6 +149,7 @@ MPU9250::MPU9250(device::Device *interface, device::Device *mag_interface, const
 	_good_transfers(perf_alloc(PC_COUNT, "mpu9250_good_trans")),
 	_reset_retries(perf_alloc(PC_COUNT, "mpu9250_reset")),
 	_duplicates(perf_alloc(PC_COUNT, "mpu9250_dupe")),
+	_fifo_overflows(perf_alloc(PC_COUNT, "mpu9250_fifo_oflow")),
 	_controller_latency_perf(perf_alloc_once(PC_ELAPSED, "ctrl_latency")),
 	_register_wait(0),
 	_reset_wait(0),
@@ -191,6 +194,9 @@ MPU9250::MPU9250(device::Device *interface, device::Device *mag_interface, const
 	/* For an independent mag, ensure that it is connected to the i2c bus */
 	_interface->set_device_type(_device_id.devid_s.devtype);
 
+	// resolve the mounting rotation once instead of per sample
+	_fixed_rotation.set_rotation(rotation);
+
 	// default accel scale factors
 	_accel_scale.x_offset = 0;
 	_accel_scale.x_scale  = 1.0f;
@@ -249,6 +255,7 @@ MPU9250::~MPU9250()
 	perf_free(_good_transfers);
 	perf_free(_reset_retries);
 	perf_free(_duplicates);
+	perf_free(_fifo_overflows);
 }
 
 int
@@ -258,6 +265,12 @@ MPU9250::init()
 #if defined(USE_I2C)
 	unsigned dummy;
 	use_i2c(_interface->ioctl(MPUIOCGIS_I2C, dummy));
+
+	/* FIFO burst reads are only worthwhile on SPI */
+	if (is_i2c()) {
+		_use_fifo = false;
+	}
+
 #endif
 
 	int ret = probe();
@@ -473,6 +486,17 @@ int MPU9250::reset_mpu()
 
 	write_checked_reg(MPUREG_ACCEL_CONFIG2, BITS_ACCEL_CONFIG2_41HZ);
 
+	if (_use_fifo) {
+		// stream accel, temp and gyro into the on-chip FIFO so
+		// samples can be fetched in bursts
+		modify_reg(MPUREG_USER_CTRL, 0, BIT_FIFO_RST);
+		modify_checked_reg(MPUREG_USER_CTRL, 0, BIT_I2C_FIFO_EN);
+		write_checked_reg(MPUREG_FIFO_EN, BITS_FIFO_EN_ACCEL | BITS_FIFO_EN_TEMP | BITS_FIFO_EN_GYRO);
+
+	} else {
+		write_checked_reg(MPUREG_FIFO_EN, 0);
+	}
+
 	uint8_t retries = 3;
 	bool all_ok = false;
 
@@ -823,7 +847,9 @@ MPU9250::ioctl(struct file *filp, int cmd, unsigned long arg)
 					  them. This prevents aliasing due to a beat between the
 					  stm32 clock and the mpu9250 clock
 					 */
-					_call.period = _call_interval - MPU9250_TIMER_REDUCTION;
+					if (!_use_fifo) {
+						_call.period = _call_interval - MPU9250_TIMER_REDUCTION;
+					}
 
 					/* if we need to start the poll state machine, do it */
 					if (want_start) {
@@ -1128,10 +1154,18 @@ MPU9250::start()
 	_mag->_mag_reports->flush();
 
 	if (_use_hrt) {
+		unsigned call_interval = _call_interval;
+
+		if (_use_fifo) {
+			/* drain the FIFO in bursts; the integrator keeps the
+			 * published output rate unchanged */
+			call_interval = MPU9250_FIFO_BURST_SAMPLES * (1000000 / _sample_rate);
+		}
+
 		/* start polling at the specified rate */
 		hrt_call_every(&_call,
 			       1000,
-			       _call_interval - MPU9250_TIMER_REDUCTION,
+			       call_interval - MPU9250_TIMER_REDUCTION,
 			       (hrt_callout)&MPU9250::measure_trampoline, this);;
 
 	} else {
@@ -1306,22 +1340,18 @@ bool MPU9250::check_duplicate(uint8_t *accel_data)
 void
 MPU9250::measure()
 {
+	if (_use_fifo) {
+		measure_fifo();
+		return;
+	}
+
 	if (hrt_absolute_time() < _reset_wait) {
 		// we're waiting for a reset to complete
 		return;
 	}
 
 	struct MPUReport mpu_report;
-
-	struct Report {
-		int16_t		accel_x;
-		int16_t		accel_y;
-		int16_t		accel_z;
-		int16_t		temp;
-		int16_t		gyro_x;
-		int16_t		gyro_y;
-		int16_t		gyro_z;
-	} report;
+	SensorSample report;
 
 	/* start measuring */
 	perf_begin(_sample_perf);
@@ -1356,15 +1386,9 @@ MPU9250::measure()
 #endif
 
 	/*
-	 * Convert from big to little endian
+	 * Convert from big to little endian and rotate into board frame
 	 */
-	report.accel_x = int16_t_from_bytes(mpu_report.accel_x);
-	report.accel_y = int16_t_from_bytes(mpu_report.accel_y);
-	report.accel_z = int16_t_from_bytes(mpu_report.accel_z);
-	report.temp    = int16_t_from_bytes(mpu_report.temp);
-	report.gyro_x  = int16_t_from_bytes(mpu_report.gyro_x);
-	report.gyro_y  = int16_t_from_bytes(mpu_report.gyro_y);
-	report.gyro_z  = int16_t_from_bytes(mpu_report.gyro_z);
+	SampleDecoder::decode(mpu_report, report);
 
 	if (check_null_data((uint32_t *)&report, sizeof(report) / 4)) {
 		return;
@@ -1377,23 +1401,131 @@ MPU9250::measure()
 		return;
 	}
 
+	process_sample(report, hrt_absolute_time());
+
+	/* stop measuring */
+	perf_end(_sample_perf);
+}
+
+void
+MPU9250::measure_fifo()
+{
+	if (hrt_absolute_time() < _reset_wait) {
+		// we're waiting for a reset to complete
+		return;
+	}
+
+	/* start measuring */
+	perf_begin(_sample_perf);
+
+	/* the FIFO fills with one record per sample at the output data rate */
+	unsigned count = read_reg16(MPUREG_FIFO_COUNTH);
+	unsigned n_samples = count / sizeof(MPUFifoSample);
+
+	if (count > MPU9250_FIFO_SIZE - 2 * sizeof(MPUFifoSample)) {
+		// the FIFO ran (nearly) full, so we have lost samples
+		// and the record boundaries may no longer line up:
+		// reset it and start over
+		perf_count(_fifo_overflows);
+		modify_reg(MPUREG_USER_CTRL, 0, BIT_FIFO_RST);
+		perf_end(_sample_perf);
+		return;
+	}
+
 	/*
-	 * Swap axes and negate y
+	 * Fetch one register snapshot per drain cycle; this services
+	 * the mag, which is not routed through the FIFO.
 	 */
-	int16_t accel_xt = report.accel_y;
-	int16_t accel_yt = ((report.accel_x == -32768) ? 32767 : -report.accel_x);
+	struct MPUReport mpu_report;
 
-	int16_t gyro_xt = report.gyro_y;
-	int16_t gyro_yt = ((report.gyro_x == -32768) ? 32767 : -report.gyro_x);
+	if (OK != _interface->read(MPU9250_SET_SPEED(MPUREG_INT_STATUS, MPU9250_HIGH_BUS_SPEED),
+				   (uint8_t *)&mpu_report,
+				   sizeof(mpu_report))) {
+		perf_end(_sample_perf);
+		return;
+	}
+
+	check_registers();
+
+#ifdef USE_I2C
+
+	if (_mag->is_passthrough()) {
+#endif
+		_mag->_measure(mpu_report.mag);
+#ifdef USE_I2C
+
+	} else {
+		_mag->measure();
+	}
+
+#endif
 
 	/*
-	 * Apply the swap
+	 * Drain only when at least two records are available; the
+	 * interface treats shorter transfers as plain register reads.
+	 * A partial record stays in the FIFO for the next cycle.
 	 */
-	report.accel_x = accel_xt;
-	report.accel_y = accel_yt;
-	report.gyro_x = gyro_xt;
-	report.gyro_y = gyro_yt;
+	if (n_samples < 2) {
+		perf_end(_sample_perf);
+		return;
+	}
 
+	if (n_samples > MPU9250_FIFO_MAX_SAMPLES) {
+		n_samples = MPU9250_FIFO_MAX_SAMPLES;
+	}
+
+#pragma pack(push, 1)
+	struct {
+		uint8_t			cmd;
+		MPUFifoSample	f[MPU9250_FIFO_MAX_SAMPLES];
+	} mpu_fifo;
+#pragma pack(pop)
+
+	// fetch the whole burst in a single high speed transfer
+	if (OK != _interface->read(MPU9250_SET_SPEED(MPUREG_FIFO_R_W, MPU9250_HIGH_BUS_SPEED),
+				   (uint8_t *)&mpu_fifo,
+				   n_samples * sizeof(MPUFifoSample) + 1)) {
+		perf_count(_bad_transfers);
+		perf_end(_sample_perf);
+		return;
+	}
+
+	if (_register_wait != 0) {
+		// we are waiting for some good transfers before using
+		// the sensor again, drop the drained samples
+		_register_wait--;
+		perf_end(_sample_perf);
+		return;
+	}
+
+	/*
+	 * The newest record was produced "now"; back-date the older
+	 * ones by the sample interval of the output data rate so the
+	 * integrator sees accurate per-sample timestamps.
+	 */
+	const hrt_abstime now = hrt_absolute_time();
+	const hrt_abstime sample_interval = 1000000 / _sample_rate;
+
+	for (unsigned i = 0; i < n_samples; i++) {
+		SensorSample report;
+
+		SampleDecoder::decode(mpu_fifo.f[i], report);
+
+		if (check_null_data((uint32_t *)&report, sizeof(report) / 4)) {
+			// probably a bus error: the rest of the burst is suspect
+			return;
+		}
+
+		process_sample(report, now - (n_samples - 1 - i) * sample_interval);
+	}
+
+	/* stop measuring */
+	perf_end(_sample_perf);
+}
+
+void
+MPU9250::process_sample(SensorSample &report, const hrt_abstime timestamp)
+{
 	/*
 	 * Report buffers.
 	 */
@@ -1403,7 +1535,7 @@ MPU9250::measure()
 	/*
 	 * Adjust and scale results to m/s^2.
 	 */
-	grb.timestamp = arb.timestamp = hrt_absolute_time();
+	grb.timestamp = arb.timestamp = timestamp;
 
 	// report the error count as the sum of the number of bad
 	// transfers and bad register reads. This allows the higher
@@ -1437,7 +1569,7 @@ MPU9250::measure()
 	float zraw_f = report.accel_z;
 
 	// apply user specified rotation
-	rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
+	_fixed_rotation.rotate(xraw_f, yraw_f, zraw_f);
 
 	float x_in_new = ((xraw_f * _accel_range_scale) - _accel_scale.x_offset) * _accel_scale.x_scale;
 	float y_in_new = ((yraw_f * _accel_range_scale) - _accel_scale.y_offset) * _accel_scale.y_scale;
@@ -1475,7 +1607,7 @@ MPU9250::measure()
 	zraw_f = report.gyro_z;
 
 	// apply user specified rotation
-	rotate_3f(_rotation, xraw_f, yraw_f, zraw_f);
+	_fixed_rotation.rotate(xraw_f, yraw_f, zraw_f);
 
 	float x_gyro_in_new = ((xraw_f * _gyro_range_scale) - _gyro_scale.x_offset) * _gyro_scale.x_scale;
 	float y_gyro_in_new = ((yraw_f * _gyro_range_scale) - _gyro_scale.y_offset) * _gyro_scale.y_scale;
@@ -1525,9 +1657,6 @@ MPU9250::measure()
 		/* publish it */
 		orb_publish(ORB_ID(sensor_gyro), _gyro->_gyro_topic, &grb);
 	}
-
-	/* stop measuring */
-	perf_end(_sample_perf);
 }
 
 void
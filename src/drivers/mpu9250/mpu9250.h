@@ -43,6 +43,7 @@
 
 #include <drivers/device/ringbuffer.h>
 #include <drivers/device/integrator.h>
+#include <drivers/device/imu_decode.h>
 #include <drivers/drv_accel.h>
 #include <drivers/drv_gyro.h>
 #include <drivers/drv_mag.h>
@@ -149,6 +150,11 @@
 #define BIT_RAW_RDY_EN			0x01
 #define BIT_INT_ANYRD_2CLEAR		0x10
 #define BIT_INT_BYPASS_EN		0x02
+#define BIT_INT_STATUS_FIFO_OFLOW	0x10
+
+#define BITS_FIFO_EN_TEMP		0x80
+#define BITS_FIFO_EN_GYRO		0x70
+#define BITS_FIFO_EN_ACCEL		0x08
 
 #define BIT_I2C_READ_FLAG           0x80
 
@@ -212,8 +218,31 @@ struct MPUReport {
 	uint8_t		gyro_z[2];
 	struct ak8963_regs mag;
 };
+
+/**
+ * One sample record as streamed into the on-chip FIFO when accel,
+ * temperature and gyro are enabled in MPUREG_FIFO_EN.
+ */
+struct MPUFifoSample {
+	uint8_t		accel_x[2];
+	uint8_t		accel_y[2];
+	uint8_t		accel_z[2];
+	uint8_t		temp[2];
+	uint8_t		gyro_x[2];
+	uint8_t		gyro_y[2];
+	uint8_t		gyro_z[2];
+};
 #pragma pack(pop)
 
+/* size of the on-chip FIFO in bytes */
+#define MPU9250_FIFO_SIZE		512
+
+/* nominal number of samples fetched in one FIFO drain */
+#define MPU9250_FIFO_BURST_SAMPLES	8
+
+/* maximum number of samples processed in one FIFO drain */
+#define MPU9250_FIFO_MAX_SAMPLES	16
+
 #define MPU_MAX_WRITE_BUFFER_SIZE (2)
 
 
@@ -250,7 +279,8 @@ class MPU9250 : public device::CDev
 public:
 	MPU9250(device::Device *interface, device::Device *mag_interface, const char *path_accel, const char *path_gyro,
 		const char *path_mag,
-		enum Rotation rotation);
+		enum Rotation rotation,
+		bool use_fifo);
 	virtual ~MPU9250();
 
 	virtual int		init();
@@ -292,6 +322,7 @@ private:
 	work_s			_work;
 #endif
 	bool 			_use_hrt;
+	bool			_use_fifo;
 
 	struct hrt_call		_call;
 	unsigned		_call_interval;
@@ -322,6 +353,7 @@ private:
 	perf_counter_t		_good_transfers;
 	perf_counter_t		_reset_retries;
 	perf_counter_t		_duplicates;
+	perf_counter_t		_fifo_overflows;
 	perf_counter_t		_controller_latency_perf;
 
 	uint8_t			_register_wait;
@@ -338,11 +370,12 @@ private:
 	Integrator		_gyro_int;
 
 	enum Rotation		_rotation;
+	FixedRotation		_fixed_rotation;
 
 	// this is used to support runtime checking of key
 	// configuration registers to detect SPI bus errors and sensor
 	// reset
-#define MPU9250_NUM_CHECKED_REGISTERS 11
+#define MPU9250_NUM_CHECKED_REGISTERS 12
 	static const uint8_t	_checked_registers[MPU9250_NUM_CHECKED_REGISTERS];
 	uint8_t			_checked_values[MPU9250_NUM_CHECKED_REGISTERS];
 	uint8_t			_checked_bad[MPU9250_NUM_CHECKED_REGISTERS];
@@ -431,6 +464,30 @@ private:
 	 */
 	void			measure();
 
+	/**
+	 * One sample decoded from the sensor registers or from a FIFO
+	 * record: little endian, axes swapped into board frame.
+	 */
+	typedef device::IMUSample SensorSample;
+
+	/**
+	 * Compile-time specialized record decode: the MPU9250 transfers
+	 * big endian data and its axes are rotated into the board frame.
+	 */
+	typedef device::IMUDecoder<true, true> SampleDecoder;
+
+	/**
+	 * Drain the on-chip FIFO and process all samples it contains.
+	 *
+	 * Used instead of measure() when FIFO burst mode is enabled.
+	 */
+	void			measure_fifo();
+
+	/**
+	 * Scale, filter, integrate and publish one decoded sample.
+	 */
+	void			process_sample(SensorSample &report, const hrt_abstime timestamp);
+
 	/**
 	 * Read a register from the mpu
 	 *
@@ -80,10 +80,13 @@
 /* Register address */
 #define ADDR_READ_MR			0x00	/* write to this address to start conversion */
 
-/* Measurement rate is 100Hz */
+/* Publication rate is 100Hz; internally the sensor is sampled at twice that
+ * rate and pairs of median-filtered conversions are averaged, halving the
+ * noise bandwidth at the original output rate */
 #define MEAS_RATE 100
+#define MEAS_OVERSAMPLING 2
 #define MEAS_DRIVER_FILTER_FREQ 1.2f
-#define CONVERSION_INTERVAL	(1000000 / MEAS_RATE)	/* microseconds */
+#define CONVERSION_INTERVAL	(1000000 / (MEAS_RATE * MEAS_OVERSAMPLING))	/* microseconds */
 
 class MEASAirspeed : public Airspeed
 {
@@ -109,6 +112,9 @@ protected:
 
 	int _t_system_power;
 	struct system_power_s system_power;
+
+	float _oversample_accum;
+	uint8_t _oversample_count;
 };
 
 /*
@@ -120,7 +126,9 @@ MEASAirspeed::MEASAirspeed(int bus, int address, const char *path) : Airspeed(bu
 			CONVERSION_INTERVAL, path),
 	_filter(MEAS_RATE, MEAS_DRIVER_FILTER_FREQ),
 	_t_system_power(-1),
-	system_power{}
+	system_power{},
+	_oversample_accum(0.0f),
+	_oversample_count(0)
 {
 	_device_id.devid_s.devtype = DRV_DIFF_PRESS_DEVTYPE_MS4525;
 }
@@ -218,6 +226,19 @@ MEASAirspeed::collect()
 	// correct for 5V rail voltage if possible
 	voltage_correction(diff_press_pa_raw, temperature);
 
+	// median-of-3 spike rejection, then accumulate the oversampled
+	// conversions; publication happens at MEAS_RATE
+	_oversample_accum += spike_filter(diff_press_pa_raw);
+
+	if (++_oversample_count < MEAS_OVERSAMPLING) {
+		perf_end(_sample_perf);
+		return OK;
+	}
+
+	const float diff_press_pa = _oversample_accum / MEAS_OVERSAMPLING;
+	_oversample_accum = 0.0f;
+	_oversample_count = 0;
+
 	/*
 	  With the above calculation the MS4525 sensor will produce a
 	  positive number when the top port is used as a dynamic port
@@ -229,8 +250,8 @@ MEASAirspeed::collect()
 	report.timestamp = hrt_absolute_time();
 	report.error_count = perf_event_count(_comms_errors);
 	report.temperature = temperature;
-	report.differential_pressure_filtered_pa =  _filter.apply(diff_press_pa_raw) - _diff_pres_offset;
-	report.differential_pressure_raw_pa = diff_press_pa_raw - _diff_pres_offset;
+	report.differential_pressure_filtered_pa =  _filter.apply(diff_press_pa) - _diff_pres_offset;
+	report.differential_pressure_raw_pa = diff_press_pa - _diff_pres_offset;
 	report.device_id = _device_id.devid;
 
 	if (_airspeed_pub != nullptr && !(_pub_blocked)) {
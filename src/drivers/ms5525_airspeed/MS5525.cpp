@@ -204,7 +204,9 @@ MS5525::collect()
 		D1 = adc;
 		_pressure_count++;
 
-		if (_pressure_count > 9) {
+		// temperature every 20 conversions keeps its original 10 Hz
+		// cadence at the doubled internal sampling rate
+		if (_pressure_count > 19) {
 			_pressure_count = 0;
 			_current_cmd = CMD_CONVERT_TEMP;
 		}
@@ -250,11 +252,24 @@ MS5525::collect()
 
 	const float temperature_c = TEMP * 0.01f;
 
+	// median-of-3 spike rejection, then accumulate the oversampled
+	// conversions; publication happens at MEAS_RATE
+	_oversample_accum += spike_filter(diff_press_pa_raw);
+
+	if (++_oversample_count < MEAS_OVERSAMPLING) {
+		perf_end(_sample_perf);
+		return PX4_OK;
+	}
+
+	const float diff_press_pa = _oversample_accum / MEAS_OVERSAMPLING;
+	_oversample_accum = 0.0f;
+	_oversample_count = 0;
+
 	differential_pressure_s diff_pressure = {
 		.timestamp = hrt_absolute_time(),
 		.error_count = perf_event_count(_comms_errors),
-		.differential_pressure_raw_pa = diff_press_pa_raw - _diff_pres_offset,
-		.differential_pressure_filtered_pa =  _filter.apply(diff_press_pa_raw) - _diff_pres_offset,
+		.differential_pressure_raw_pa = diff_press_pa - _diff_pres_offset,
+		.differential_pressure_filtered_pa =  _filter.apply(diff_press_pa) - _diff_pres_offset,
 		.temperature = temperature_c,
 		.device_id = _device_id.devid
 	};
@@ -52,10 +52,13 @@ static constexpr uint8_t I2C_ADDRESS_2_MS5525DSO = 0x77;
 
 static constexpr const char PATH_MS5525[] = "/dev/ms5525";
 
-/* Measurement rate is 100Hz */
+/* Publication rate is 100Hz; internally the sensor is sampled at twice that
+ * rate and pairs of median-filtered conversions are averaged, halving the
+ * noise bandwidth at the original output rate */
 static constexpr unsigned MEAS_RATE = 100;
+static constexpr unsigned MEAS_OVERSAMPLING = 2;
 static constexpr float MEAS_DRIVER_FILTER_FREQ = 1.2f;
-static constexpr uint64_t CONVERSION_INTERVAL = (1000000 / MEAS_RATE); /* microseconds */
+static constexpr uint64_t CONVERSION_INTERVAL = (1000000 / (MEAS_RATE * MEAS_OVERSAMPLING)); /* microseconds */
 
 class MS5525 : public Airspeed
 {
@@ -78,7 +81,8 @@ private:
 	int measure() override;
 	int collect() override;
 
-	// temperature is read once every 10 cycles
+	// temperature is read once every 20 conversions; the filter runs at the
+	// publication rate
 	math::LowPassFilter2p _filter{MEAS_RATE * 0.9, MEAS_DRIVER_FILTER_FREQ};
 
 	static constexpr uint8_t CMD_RESET = 0x1E; // ADC reset command
@@ -106,6 +110,9 @@ private:
 
 	unsigned _pressure_count{0};
 
+	float _oversample_accum{0.0f};
+	uint8_t _oversample_count{0};
+
 	// Qx Coefficients Matrix by Pressure Range
 	//  5525DSO-pp001DS (Pmin = -1, Pmax = 1)
 	static constexpr uint8_t Q1 = 15;
@@ -63,6 +63,7 @@
 #include <drivers/drv_baro.h>
 #include <drivers/drv_hrt.h>
 #include <drivers/device/ringbuffer.h>
+#include <drivers/device/device_init.h>
 
 #include <systemlib/perf_counter.h>
 #include <systemlib/err.h>
@@ -118,12 +119,20 @@ enum MS5611_BUS {
 #define ADDR_CMD_CONVERT_D2			ADDR_CMD_CONVERT_D2_OSR1024
 
 /*
- * Maximum internal conversion time for OSR 1024 is 2.28 ms. We set an update
- * rate of 100Hz which is be very safe not to read the ADC before the
- * conversion finished
+ * Maximum internal conversion time for OSR 1024 is 2.28 ms. The state machine
+ * is pipelined against that time: a conversion is issued, the bus is yielded
+ * for MS5611_CONVERSION_TIME, and the result is collected when it is ready,
+ * instead of padding every phase to the full measurement interval. The
+ * default update rate stays at 100 Hz, but the dead time per conversion is
+ * bounded by the ADC and not by the schedule.
  */
-#define MS5611_CONVERSION_INTERVAL	10000	/* microseconds */
-#define MS5611_MEASUREMENT_RATIO	3	/* pressure measurements per temperature measurement */
+#define MS5611_CONVERSION_TIME		2500	/* microseconds, OSR 1024 worst case plus margin */
+#define MS5611_CONVERSION_INTERVAL	10000	/* microseconds, default measurement spacing */
+/*
+ * Temperature drifts slowly compared to pressure, so it is decimated
+ * heavily: at the default rate it is still refreshed ~10 times a second.
+ */
+#define MS5611_MEASUREMENT_RATIO	9	/* pressure measurements per temperature measurement */
 #define MS5611_BARO_DEVICE_PATH_EXT	"/dev/ms5611_ext"
 #define MS5611_BARO_DEVICE_PATH_INT	"/dev/ms5611_int"
 
@@ -335,7 +344,7 @@ MS5611::init()
 			break;
 		}
 
-		usleep(MS5611_CONVERSION_INTERVAL);
+		usleep(MS5611_CONVERSION_TIME);
 
 		if (OK != collect()) {
 			ret = -EIO;
@@ -348,7 +357,7 @@ MS5611::init()
 			break;
 		}
 
-		usleep(MS5611_CONVERSION_INTERVAL);
+		usleep(MS5611_CONVERSION_TIME);
 
 		if (OK != collect()) {
 			ret = -EIO;
@@ -453,7 +462,7 @@ MS5611::read(struct file *filp, char *buffer, size_t buflen)
 			break;
 		}
 
-		usleep(MS5611_CONVERSION_INTERVAL);
+		usleep(MS5611_CONVERSION_TIME);
 
 		if (OK != collect()) {
 			ret = -EIO;
@@ -466,7 +475,7 @@ MS5611::read(struct file *filp, char *buffer, size_t buflen)
 			break;
 		}
 
-		usleep(MS5611_CONVERSION_INTERVAL);
+		usleep(MS5611_CONVERSION_TIME);
 
 		if (OK != collect()) {
 			ret = -EIO;
@@ -510,8 +519,9 @@ MS5611::ioctl(struct file *filp, int cmd, unsigned long arg)
 					/* do we need to start internal polling? */
 					bool want_start = (_measure_ticks == 0);
 
-					/* set interval for next measurement to minimum legal value */
-					_measure_ticks = USEC2TICK(MS5611_CONVERSION_INTERVAL);
+					/* max rate is bounded by the conversion time, the default by the measurement interval */
+					_measure_ticks = USEC2TICK((arg == SENSOR_POLLRATE_MAX) ?
+								   MS5611_CONVERSION_TIME : MS5611_CONVERSION_INTERVAL);
 
 					/* if we need to start the poll state machine, do it */
 					if (want_start) {
@@ -530,7 +540,7 @@ MS5611::ioctl(struct file *filp, int cmd, unsigned long arg)
 					unsigned ticks = USEC2TICK(1000000 / arg);
 
 					/* check against maximum rate */
-					if (ticks < USEC2TICK(MS5611_CONVERSION_INTERVAL)) {
+					if (ticks < USEC2TICK(MS5611_CONVERSION_TIME)) {
 						return -EINVAL;
 					}
 
@@ -672,14 +682,14 @@ MS5611::cycle()
 		 * doing pressure measurements at something close to the desired rate.
 		 */
 		if ((_measure_phase != 0) &&
-		    (_measure_ticks > USEC2TICK(MS5611_CONVERSION_INTERVAL))) {
+		    (_measure_ticks > USEC2TICK(MS5611_CONVERSION_TIME))) {
 
 			/* schedule a fresh cycle call when we are ready to measure again */
 			work_queue(HPWORK,
 				   &_work,
 				   (worker_t)&MS5611::cycle_trampoline,
 				   this,
-				   _measure_ticks - USEC2TICK(MS5611_CONVERSION_INTERVAL));
+				   _measure_ticks - USEC2TICK(MS5611_CONVERSION_TIME));
 
 			return;
 		}
@@ -699,12 +709,13 @@ MS5611::cycle()
 	/* next phase is collection */
 	_collect_phase = true;
 
-	/* schedule a fresh cycle call when the measurement is done */
+	/* schedule a fresh cycle call when the conversion is ready for pickup;
+	 * the bus is free for other devices in the meantime */
 	work_queue(HPWORK,
 		   &_work,
 		   (worker_t)&MS5611::cycle_trampoline,
 		   this,
-		   USEC2TICK(MS5611_CONVERSION_INTERVAL));
+		   USEC2TICK(MS5611_CONVERSION_TIME));
 }
 
 int
@@ -1059,6 +1070,7 @@ start_bus(struct ms5611_bus_option &bus, enum MS56XX_DEVICE_TYPES device_type)
 void
 start(enum MS5611_BUS busid, enum MS56XX_DEVICE_TYPES device_type)
 {
+	uint64_t start_time = hrt_absolute_time();
 	uint8_t i;
 	bool started = false;
 
@@ -1076,6 +1088,8 @@ start(enum MS5611_BUS busid, enum MS56XX_DEVICE_TYPES device_type)
 		started = started | start_bus(bus_options[i], device_type);
 	}
 
+	device::init_record("ms5611", start_time);
+
 	if (!started) {
 		exit(1);
 	}
@@ -67,6 +67,12 @@
 
 #include <board_config.h>
 
+#if defined(BOARD_DSHOT_DMAMAP)
+#  include <drivers/stm32/drv_dshot.h>
+#  include <drivers/stm32/drv_io_timer.h>
+#  include <termios.h>
+#endif
+
 #include <systemlib/px4_macros.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/mixer/mixer.h>
@@ -91,6 +97,9 @@
 #include <uORB/topics/safety.h>
 #include <uORB/topics/adc_report.h>
 #include <uORB/topics/multirotor_motor_limits.h>
+#include <uORB/topics/mixer_status.h>
+#include <uORB/topics/control_latency.h>
+#include <uORB/topics/esc_status.h>
 
 #ifdef HRT_PPM_CHANNEL
 # include <systemlib/ppm_decode.h>
@@ -260,6 +269,32 @@ private:
 	uint32_t	_pwm_mask;
 	bool		_pwm_initialized;
 
+#if defined(BOARD_DSHOT_DMAMAP)
+	/* DShot output: checksummed digital frames on the PWM pins, with an
+	 * optional serial telemetry back channel feeding esc_status */
+	unsigned	_dshot_frequency;	///< DShot bit rate in Hz, 0 = PWM/OneShot output
+	int		_dshot_telemetry_fd;	///< ESC telemetry serial port, -1 = none
+	unsigned	_dshot_request_motor;	///< output the telemetry request bit rotates over
+	hrt_abstime	_dshot_request_time;	///< start of the current telemetry window
+	uint8_t		_dshot_telemetry_buf[10];	///< partially received telemetry frame
+	unsigned	_dshot_telemetry_len;
+	int32_t		_dshot_motor_poles;	///< motor pole count for eRPM to RPM conversion
+	orb_advert_t	_esc_status_pub;
+	esc_status_s	_esc_status;
+#endif
+
+	/* hrt-deadline scheduled output: the mixer stages values into a double
+	 * buffer and deadline_output() sends them to the servos from interrupt
+	 * context at a fixed rate, so the control-to-ESC latency does not float
+	 * with the work queue load */
+	struct hrt_call	_deadline_call;
+	unsigned	_deadline_write;		///< buffer the mixer writes next
+	volatile unsigned	_deadline_latest;	///< buffer the deadline callout reads
+	volatile unsigned	_deadline_num_outputs;
+	uint16_t	_deadline_pwm[2][_max_actuators];
+	bool		_deadline_scheduled;
+	static unsigned	_deadline_rate;		///< deadline output rate in Hz (0 = output directly from cycle())
+
 	MixerGroup	*_mixers;
 
 	uint32_t	_groups_required;
@@ -287,11 +322,22 @@ private:
 	bool		_safety_disabled;
 	orb_advert_t		_to_safety;
 	orb_advert_t      _to_mixer_status; 	///< mixer status flags
+	orb_advert_t      _mixer_status_pub;	///< detailed mixer status for profiling
+	hrt_abstime       _last_mixer_status_pub;	///< last detailed mixer status publication
 
 	float _mot_t_max;	// maximum rise time for motor (slew rate limiting)
 	float _thr_mdl_fac;	// thrust to pwm modelling factor
 
 	perf_counter_t	_ctl_latency;
+	perf_counter_t	_kill_latency;	///< kill/failsafe request to PWM output write
+	hrt_abstime	_kill_pending;	///< timestamp of an uncompleted kill latency measurement
+	bool		_kill_asserted;	///< kill/lockdown was asserted at the last armed update
+
+	orb_advert_t	_control_latency_pub;	///< aggregated control path latency
+	control_latency_s _latency_report;	///< accumulator for the current reporting interval
+	hrt_abstime	_latency_report_start;	///< start of the current reporting interval
+	uint64_t	_ctl_latency_sum;	///< controls-to-output latency sum over the interval
+	uint64_t	_sample_latency_sum;	///< sample-to-output latency sum over the interval
 
 	static bool	arm_nothrottle()
 	{
@@ -312,8 +358,15 @@ private:
 	int			pwm_ioctl(file *filp, int cmd, unsigned long arg);
 	void		update_pwm_rev_mask();
 	void		publish_pwm_outputs(uint16_t *values, size_t numvalues);
+	void		update_control_latency(hrt_abstime now);
 	void		update_pwm_out_state(bool on);
 	void		pwm_output_set(unsigned i, unsigned value);
+#if defined(BOARD_DSHOT_DMAMAP)
+	void		dshot_output_set(unsigned i, unsigned value);
+	void		dshot_telemetry_update();
+#endif
+	static void	deadline_trampoline(void *arg);
+	void		deadline_output();
 	void		update_params();
 
 	struct GPIOConfig {
@@ -359,6 +412,7 @@ const unsigned		PX4FMU::_ngpio = arraySize(PX4FMU::_gpio_tab);
 pwm_limit_t		PX4FMU::_pwm_limit;
 actuator_armed_s	PX4FMU::_armed = {};
 work_s	PX4FMU::_work = {};
+unsigned	PX4FMU::_deadline_rate = 0;
 
 PX4FMU::PX4FMU(bool run_as_task) :
 	CDev("fmu", PX4FMU_DEVICE_PATH),
@@ -384,6 +438,23 @@ PX4FMU::PX4FMU(bool run_as_task) :
 	_pwm_on(false),
 	_pwm_mask(0),
 	_pwm_initialized(false),
+#if defined(BOARD_DSHOT_DMAMAP)
+	_dshot_frequency(0),
+	_dshot_telemetry_fd(-1),
+	_dshot_request_motor(0),
+	_dshot_request_time(0),
+	_dshot_telemetry_buf{},
+	_dshot_telemetry_len(0),
+	_dshot_motor_poles(14),
+	_esc_status_pub(nullptr),
+	_esc_status{},
+#endif
+	_deadline_call{},
+	_deadline_write(0),
+	_deadline_latest(0),
+	_deadline_num_outputs(0),
+	_deadline_pwm{},
+	_deadline_scheduled(false),
 	_mixers(nullptr),
 	_groups_required(0),
 	_groups_subscribed(0),
@@ -399,9 +470,19 @@ PX4FMU::PX4FMU(bool run_as_task) :
 	_safety_disabled(false),
 	_to_safety(nullptr),
 	_to_mixer_status(nullptr),
+	_mixer_status_pub(nullptr),
+	_last_mixer_status_pub(0),
 	_mot_t_max(0.0f),
 	_thr_mdl_fac(0.0f),
-	_ctl_latency(perf_alloc(PC_ELAPSED, "ctl_lat"))
+	_ctl_latency(perf_alloc(PC_ELAPSED, "ctl_lat")),
+	_kill_latency(perf_alloc(PC_ELAPSED, "kill_lat")),
+	_kill_pending(0),
+	_kill_asserted(false),
+	_control_latency_pub(nullptr),
+	_latency_report{},
+	_latency_report_start(0),
+	_ctl_latency_sum(0),
+	_sample_latency_sum(0)
 {
 	for (unsigned i = 0; i < _max_actuators; i++) {
 		_min_pwm[i] = PWM_DEFAULT_MIN;
@@ -465,8 +546,10 @@ PX4FMU::~PX4FMU()
 	orb_unadvertise(_outputs_pub);
 	orb_unadvertise(_to_safety);
 	orb_unadvertise(_to_mixer_status);
+	orb_unadvertise(_mixer_status_pub);
 
 	/* make sure servos are off */
+	hrt_cancel(&_deadline_call);
 	up_pwm_servo_deinit();
 
 #ifdef RC_SERIAL_PORT
@@ -479,6 +562,7 @@ PX4FMU::~PX4FMU()
 	unregister_class_devname(PWM_OUTPUT_BASE_DEVICE_PATH, _class_instance);
 
 	perf_free(_ctl_latency);
+	perf_free(_kill_latency);
 }
 
 int
@@ -977,6 +1061,65 @@ PX4FMU::publish_pwm_outputs(uint16_t *values, size_t numvalues)
 	}
 }
 
+void
+PX4FMU::update_control_latency(hrt_abstime now)
+{
+	/* aggregate the per-update latencies over one second and publish the result,
+	 * so the logger can record control path timing without a high-rate topic */
+	const uint32_t ctl_latency = now - _controls[0].timestamp;
+
+	/* the attitude controllers stamp the time of the sensor data they acted on;
+	 * fall back to the publication time for sources that do not */
+	const uint32_t sample_latency = (_controls[0].timestamp_sample != 0) ?
+					(uint32_t)(now - _controls[0].timestamp_sample) : ctl_latency;
+
+	control_latency_s &report = _latency_report;
+
+	if (report.sample_count == 0) {
+		report.control_latency_min = ctl_latency;
+		report.control_latency_max = ctl_latency;
+		report.sample_latency_min = sample_latency;
+		report.sample_latency_max = sample_latency;
+
+	} else {
+		if (ctl_latency < report.control_latency_min) { report.control_latency_min = ctl_latency; }
+
+		if (ctl_latency > report.control_latency_max) { report.control_latency_max = ctl_latency; }
+
+		if (sample_latency < report.sample_latency_min) { report.sample_latency_min = sample_latency; }
+
+		if (sample_latency > report.sample_latency_max) { report.sample_latency_max = sample_latency; }
+	}
+
+	_ctl_latency_sum += ctl_latency;
+	_sample_latency_sum += sample_latency;
+	report.sample_count++;
+
+	if (_latency_report_start == 0) {
+		_latency_report_start = now;
+	}
+
+	if (now - _latency_report_start < 1000000) {
+		return;
+	}
+
+	report.timestamp = now;
+	report.control_latency_avg = _ctl_latency_sum / report.sample_count;
+	report.sample_latency_avg = _sample_latency_sum / report.sample_count;
+
+	if (_control_latency_pub == nullptr) {
+		_control_latency_pub = orb_advertise(ORB_ID(control_latency), &report);
+
+	} else {
+		orb_publish(ORB_ID(control_latency), _control_latency_pub, &report);
+	}
+
+	memset(&report, 0, sizeof(report));
+	_ctl_latency_sum = 0;
+	_sample_latency_sum = 0;
+	_latency_report_start = now;
+}
+
 int
 PX4FMU::task_spawn(int argc, char *argv[])
 {
@@ -987,12 +1130,25 @@ PX4FMU::task_spawn(int argc, char *argv[])
 	int ch;
 	const char *myoptarg = nullptr;
 
-	while ((ch = px4_getopt(argc, argv, "t", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "ts:", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 't':
 			run_as_task = true;
 			break;
 
+		case 's': {
+				int rate = strtol(myoptarg, nullptr, 0);
+
+				if (rate < 50 || rate > 2000) {
+					PX4_ERR("invalid deadline rate: %s", myoptarg);
+					error_flag = true;
+
+				} else {
+					_deadline_rate = rate;
+				}
+			}
+			break;
+
 		case '?':
 			error_flag = true;
 			break;
@@ -1171,22 +1327,213 @@ void
 PX4FMU::pwm_output_set(unsigned i, unsigned value)
 {
 	if (_pwm_initialized) {
+#if defined(BOARD_DSHOT_DMAMAP)
+
+		if (_dshot_frequency > 0) {
+			dshot_output_set(i, value);
+			return;
+		}
+
+#endif
 		up_pwm_servo_set(i, value);
 	}
 }
 
+#if defined(BOARD_DSHOT_DMAMAP)
+void
+PX4FMU::dshot_output_set(unsigned i, unsigned value)
+{
+	/* map the PWM microsecond range onto the DShot throttle range; anything
+	 * at or below the lower band edge stops the motor */
+	uint16_t throttle = DSHOT_CMD_MOTOR_STOP;
+
+	if (value > 1000) {
+		if (value > 2000) {
+			value = 2000;
+		}
+
+		throttle = DSHOT_THROTTLE_MIN + (value - 1000) * (DSHOT_THROTTLE_MAX - DSHOT_THROTTLE_MIN) / 1000;
+	}
+
+	/* the telemetry request bit rotates over the motors; keep requesting
+	 * from the same motor until its frame arrived or timed out */
+	const bool request = (_dshot_telemetry_fd >= 0 && i == _dshot_request_motor);
+
+	up_dshot_motor_data_set(i, throttle, request);
+}
+
+void
+PX4FMU::dshot_telemetry_update()
+{
+	if (_dshot_telemetry_fd < 0 || _dshot_frequency == 0) {
+		return;
+	}
+
+	uint8_t buf[16];
+	int n = ::read(_dshot_telemetry_fd, buf, sizeof(buf));
+
+	for (int i = 0; i < n; i++) {
+		if (_dshot_telemetry_len < sizeof(_dshot_telemetry_buf)) {
+			_dshot_telemetry_buf[_dshot_telemetry_len++] = buf[i];
+		}
+	}
+
+	bool advance = false;
+
+	if (_dshot_telemetry_len == sizeof(_dshot_telemetry_buf)) {
+
+		/* KISS ESC telemetry: temperature, voltage, current, consumption
+		 * and eRPM, all big endian, followed by a CRC8 (poly 0x07) */
+
+		uint8_t crc = 0;
+
+		for (unsigned i = 0; i < sizeof(_dshot_telemetry_buf) - 1; i++) {
+			crc ^= _dshot_telemetry_buf[i];
+
+			for (unsigned bit = 0; bit < 8; bit++) {
+				crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+			}
+		}
+
+		if (crc == _dshot_telemetry_buf[9]) {
+			const unsigned motor = _dshot_request_motor;
+			esc_report_s &esc = _esc_status.esc[motor];
+
+			const int32_t erpm = ((_dshot_telemetry_buf[7] << 8) | _dshot_telemetry_buf[8]) * 100;
+
+			esc.esc_address = motor;
+			esc.esc_rpm = erpm / (_dshot_motor_poles / 2);
+			esc.esc_voltage = ((_dshot_telemetry_buf[1] << 8) | _dshot_telemetry_buf[2]) * 0.01f;
+			esc.esc_current = ((_dshot_telemetry_buf[3] << 8) | _dshot_telemetry_buf[4]) * 0.01f;
+			esc.esc_temperature = _dshot_telemetry_buf[0];
+
+			_esc_status.timestamp = hrt_absolute_time();
+			_esc_status.counter++;
+			_esc_status.esc_count = __builtin_popcount(_pwm_mask);
+			_esc_status.esc_connectiontype = esc_status_s::ESC_CONNECTION_TYPE_SERIAL;
+
+			if (_esc_status_pub == nullptr) {
+				_esc_status_pub = orb_advertise(ORB_ID(esc_status), &_esc_status);
+
+			} else {
+				orb_publish(ORB_ID(esc_status), _esc_status_pub, &_esc_status);
+			}
+		}
+
+		advance = true;
+
+	} else if (_dshot_request_time != 0 && hrt_elapsed_time(&_dshot_request_time) > 50000) {
+
+		/* no complete response in the window: skip to the next motor */
+
+		advance = true;
+	}
+
+	if (advance) {
+		_dshot_telemetry_len = 0;
+		_dshot_request_time = hrt_absolute_time();
+
+		unsigned next = _dshot_request_motor + 1;
+
+		if (next >= _max_actuators || (_pwm_mask & (1 << next)) == 0) {
+			next = 0;
+		}
+
+		_dshot_request_motor = next;
+	}
+}
+#endif /* defined(BOARD_DSHOT_DMAMAP) */
+
 void
 PX4FMU::update_pwm_out_state(bool on)
 {
 	if (on && !_pwm_initialized && _pwm_mask != 0) {
-		up_pwm_servo_init(_pwm_mask);
-		set_pwm_rate(_pwm_alt_rate_channels, _pwm_default_rate, _pwm_alt_rate);
+#if defined(BOARD_DSHOT_DMAMAP)
+
+		if (_dshot_frequency > 0 && up_dshot_init(_pwm_mask, _dshot_frequency) != OK) {
+			PX4_ERR("DShot init failed, reverting to PWM");
+
+			/* release any channels the failed init claimed */
+			for (unsigned i = 0; i < _max_actuators; i++) {
+				if (_pwm_mask & (1 << i)) {
+					io_timer_free_channel(i);
+				}
+			}
+
+			_dshot_frequency = 0;
+		}
+
+		if (_dshot_frequency == 0)
+#endif
+		{
+			up_pwm_servo_init(_pwm_mask);
+			set_pwm_rate(_pwm_alt_rate_channels, _pwm_default_rate, _pwm_alt_rate);
+		}
+
 		_pwm_initialized = true;
 	}
 
+	if (_deadline_rate > 0) {
+		if (on && _pwm_initialized && !_deadline_scheduled) {
+			/* send the outputs from a fixed hrt deadline instead of the
+			 * (load-dependent) work queue schedule */
+			hrt_abstime period = 1000000 / _deadline_rate;
+			hrt_call_every(&_deadline_call, period, period, (hrt_callout)&PX4FMU::deadline_trampoline, this);
+			_deadline_scheduled = true;
+
+		} else if (!on && _deadline_scheduled) {
+			hrt_cancel(&_deadline_call);
+			_deadline_scheduled = false;
+		}
+	}
+
+#if defined(BOARD_DSHOT_DMAMAP)
+
+	if (_dshot_frequency > 0) {
+		up_dshot_arm(on);
+		return;
+	}
+
+#endif
 	up_pwm_servo_arm(on);
 }
 
+void
+PX4FMU::deadline_trampoline(void *arg)
+{
+	PX4FMU *dev = reinterpret_cast<PX4FMU *>(arg);
+	dev->deadline_output();
+}
+
+void
+PX4FMU::deadline_output()
+{
+	/* runs in hrt interrupt context at the configured deadline rate */
+	if (!_pwm_initialized) {
+		return;
+	}
+
+	const unsigned latest = _deadline_latest;
+	const unsigned num = _deadline_num_outputs;
+
+	for (unsigned i = 0; i < num; i++) {
+		pwm_output_set(i, _deadline_pwm[latest][i]);
+	}
+
+	if (num > 0) {
+#if defined(BOARD_DSHOT_DMAMAP)
+
+		if (_dshot_frequency > 0) {
+			up_dshot_trigger();
+			return;
+		}
+
+#endif
+		/* trigger OneShot channels aligned to the deadline */
+		up_pwm_update();
+	}
+}
+
 void
 PX4FMU::run()
 {
@@ -1368,6 +1715,27 @@ PX4FMU::cycle()
 
 				}
 
+				/* publish the detailed mixer status for profiling, rate-limited */
+				hrt_abstime now = hrt_absolute_time();
+
+				if (now - _last_mixer_status_pub > 4000) {
+					_last_mixer_status_pub = now;
+
+					mixer_status_s mixer_status = {};
+					mixer_status.timestamp = now;
+					mixer_status.saturation_status = multirotor_motor_limits.saturation_status;
+					_mixers->get_mix_status(mixer_status.boost, mixer_status.roll_pitch_scale);
+
+					if (_mixer_status_pub == nullptr) {
+						int instance = _class_instance;
+						_mixer_status_pub = orb_advertise_multi(ORB_ID(mixer_status), &mixer_status, &instance,
+											ORB_PRIO_DEFAULT);
+
+					} else {
+						orb_publish(ORB_ID(mixer_status), _mixer_status_pub, &mixer_status);
+					}
+				}
+
 				/* disable unused ports by setting their output to NaN */
 				for (size_t i = 0; i < sizeof(outputs) / sizeof(outputs[0]); i++) {
 					if (i >= mixed_num_outputs) {
@@ -1396,17 +1764,49 @@ PX4FMU::cycle()
 					}
 				}
 
-				/* output to the servos */
-				for (size_t i = 0; i < mixed_num_outputs; i++) {
-					pwm_output_set(i, pwm_limited[i]);
+				if (_deadline_rate > 0) {
+					/* stage the outputs for the hrt deadline: write the
+					 * buffer the callout is not reading, then flip. The
+					 * servos are updated by deadline_output() at the next
+					 * ESC update window. */
+					memcpy(_deadline_pwm[_deadline_write], pwm_limited,
+					       mixed_num_outputs * sizeof(pwm_limited[0]));
+					_deadline_num_outputs = mixed_num_outputs;
+					_deadline_latest = _deadline_write;
+					_deadline_write ^= 1;
+
+				} else {
+					/* output to the servos */
+					for (size_t i = 0; i < mixed_num_outputs; i++) {
+						pwm_output_set(i, pwm_limited[i]);
+					}
+
+#if defined(BOARD_DSHOT_DMAMAP)
+
+					if (_dshot_frequency > 0) {
+						/* DShot ESCs need a continuous frame stream
+						 * to stay armed */
+						up_dshot_trigger();
+
+					} else
+#endif
+
+						/* Trigger all timer's channels in Oneshot mode to fire
+						 * the oneshots with updated values.
+						 */
+
+						if (n_updates > 0) {
+							up_pwm_update();
+						}
 				}
 
-				/* Trigger all timer's channels in Oneshot mode to fire
-				 * the oneshots with updated values.
-				 */
+				if (_kill_pending != 0 && _kill_asserted) {
+					perf_set_elapsed(_kill_latency, hrt_elapsed_time(&_kill_pending));
+					_kill_pending = 0;
+				}
 
 				if (n_updates > 0) {
-					up_pwm_update();
+					update_control_latency(hrt_absolute_time());
 				}
 
 				publish_pwm_outputs(pwm_limited, mixed_num_outputs);
@@ -1416,6 +1816,11 @@ PX4FMU::cycle()
 
 		_cycle_timestamp = hrt_absolute_time();
 
+#if defined(BOARD_DSHOT_DMAMAP)
+		/* drain the ESC telemetry back channel */
+		dshot_telemetry_update();
+#endif
+
 #ifdef GPIO_BTN_SAFETY
 
 		if (_cycle_timestamp - _last_safety_check >= (unsigned int)1e5) {
@@ -1466,6 +1871,16 @@ PX4FMU::cycle()
 		if (updated) {
 			orb_copy(ORB_ID(actuator_armed), _armed_sub, &_armed);
 
+			/* a newly asserted kill/lockdown request starts the kill-to-PWM-off
+			 * latency measurement, completed when the outputs are written */
+			const bool kill_asserted = _armed.force_failsafe || _armed.lockdown || _armed.manual_lockdown;
+
+			if (kill_asserted && !_kill_asserted) {
+				_kill_pending = _armed.timestamp;
+			}
+
+			_kill_asserted = kill_asserted;
+
 			/* Update the armed status and check that we're not locked down.
 			 * We also need to arm throttle for the ESC calibration. */
 			_throttle_armed = (_safety_off && _armed.armed && !_armed.lockdown) ||
@@ -1822,6 +2237,79 @@ void PX4FMU::update_params()
 	if (param_handle != PARAM_INVALID) {
 		param_get(param_handle, &_thr_mdl_fac);
 	}
+
+#if defined(BOARD_DSHOT_DMAMAP)
+	// DShot protocol selection, only effective before the outputs start
+	if (!_pwm_initialized) {
+		int32_t dshot_config = 0;
+		param_handle = param_find("DSHOT_CONFIG");
+
+		if (param_handle != PARAM_INVALID) {
+			param_get(param_handle, &dshot_config);
+		}
+
+		switch (dshot_config) {
+		case 150:
+			_dshot_frequency = DSHOT150;
+			break;
+
+		case 300:
+			_dshot_frequency = DSHOT300;
+			break;
+
+		case 600:
+			_dshot_frequency = DSHOT600;
+			break;
+
+		case 1200:
+			_dshot_frequency = DSHOT1200;
+			break;
+
+		default:
+			_dshot_frequency = 0;
+			break;
+		}
+	}
+
+	param_handle = param_find("DSHOT_POLES");
+
+	if (param_handle != PARAM_INVALID) {
+		param_get(param_handle, &_dshot_motor_poles);
+
+		if (_dshot_motor_poles < 2) {
+			_dshot_motor_poles = 2;
+		}
+	}
+
+	// ESC telemetry back channel
+	int32_t tel_cfg = 0;
+	param_handle = param_find("DSHOT_TEL_CFG");
+
+	if (param_handle != PARAM_INVALID) {
+		param_get(param_handle, &tel_cfg);
+	}
+
+	if (tel_cfg > 0 && _dshot_telemetry_fd < 0) {
+		char device[16];
+		snprintf(device, sizeof(device), "/dev/ttyS%d", (int)(tel_cfg - 1));
+		_dshot_telemetry_fd = ::open(device, O_RDONLY | O_NONBLOCK);
+
+		if (_dshot_telemetry_fd >= 0) {
+			struct termios t;
+			tcgetattr(_dshot_telemetry_fd, &t);
+			cfsetspeed(&t, 115200);
+			t.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+			t.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
+			t.c_iflag &= ~(IXON | IXOFF | ICRNL | INLCR | IGNCR);
+			t.c_oflag = 0;
+			tcsetattr(_dshot_telemetry_fd, TCSANOW, &t);
+
+		} else {
+			PX4_ERR("DShot telemetry: open %s failed", device);
+		}
+	}
+
+#endif /* defined(BOARD_DSHOT_DMAMAP) */
 }
 
 
@@ -3565,6 +4053,8 @@ mixer files.
 	PRINT_MODULE_USAGE_NAME("fmu", "driver");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Start the task (without any mode set, use any of the mode_* cmds)");
 	PRINT_MODULE_USAGE_PARAM_FLAG('t', "Run as separate task instead of the work queue", true);
+	PRINT_MODULE_USAGE_PARAM_INT('s', 0, 50, 2000,
+				     "Send PWM/OneShot outputs from a fixed hrt deadline at this rate in Hz (0=directly when controls update)", true);
 
 	PRINT_MODULE_USAGE_PARAM_COMMENT("All of the mode_* commands will start the fmu if not running already");
 
@@ -3614,6 +4104,10 @@ int PX4FMU::print_status()
 		PX4_INFO("Max update rate: %i Hz", _current_update_rate);
 	}
 
+	if (_deadline_rate > 0) {
+		PX4_INFO("Deadline-scheduled output at %u Hz", _deadline_rate);
+	}
+
 	PX4_INFO("RC scan state: %s", RC_SCAN_STRING[_rc_scan_state]);
 #ifdef RC_SERIAL_PORT
 	PX4_INFO("SBUS frame drops: %u", sbus_dropped_frames());
@@ -211,3 +211,46 @@ PARAM_DEFINE_FLOAT(MOT_SLEW_MAX, 0.0f);
  * @group System
  */
 PARAM_DEFINE_INT32(SYS_FMU_TASK, 0);
+
+/**
+ * DShot output protocol
+ *
+ * Drive the FMU outputs with checksummed DShot frames instead of PWM
+ * pulse widths. The value selects the bit rate in kbit/s. Only
+ * available on boards with a DMA stream mapped to the output timers.
+ *
+ * @value 0 Disabled (PWM/OneShot)
+ * @value 150 DShot150
+ * @value 300 DShot300
+ * @value 600 DShot600
+ * @value 1200 DShot1200
+ * @reboot_required true
+ * @group PWM Outputs
+ */
+PARAM_DEFINE_INT32(DSHOT_CONFIG, 0);
+
+/**
+ * Serial port for the DShot ESC telemetry back channel
+ *
+ * Index N selects /dev/ttyS(N-1). The ESCs' telemetry wires are
+ * connected to the RX pin of that port; replies are requested from one
+ * motor at a time and published as esc_status.
+ *
+ * @min 0
+ * @max 6
+ * @reboot_required true
+ * @group PWM Outputs
+ */
+PARAM_DEFINE_INT32(DSHOT_TEL_CFG, 0);
+
+/**
+ * Number of magnetic poles of the motors
+ *
+ * Used to convert the electrical RPM reported by the ESC telemetry to
+ * mechanical motor RPM.
+ *
+ * @min 2
+ * @max 40
+ * @group PWM Outputs
+ */
+PARAM_DEFINE_INT32(DSHOT_POLES, 14);
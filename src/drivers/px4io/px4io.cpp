@@ -263,6 +263,10 @@ private:
 	unsigned		_max_relays;		///< Maximum relays supported by PX4IO
 	unsigned		_max_transfer;		///< Maximum number of I2C transfers supported by PX4IO
 
+	bool			_mixed_io_supported;	///< If set, the interface supports combined write/read transfers
+	hrt_abstime		_servo_readback_time;	///< Time of the last combined servo output readback
+	uint16_t		_servo_readback[16];	///< Servo outputs from the last combined transfer
+
 	unsigned 		_update_interval;	///< Subscription interval limiting send rate
 	bool			_rc_handling_disabled;	///< If set, IO does not evaluate, but only forward the RC values
 	unsigned		_rc_chan_count;		///< Internal copy of the last seen number of RC channels
@@ -434,6 +438,23 @@ private:
 	uint32_t		io_reg_get(uint8_t page, uint8_t offset);
 	static const uint32_t	_io_reg_get_error = 0x80000000;
 
+	/**
+	 * write a set of registers and read back another block in one interface
+	 * transaction, falling back to separate transfers when the interface
+	 * has no combined mode
+	 *
+	 * @param wpage		register page to write
+	 * @param woffset	register offset to start writing at
+	 * @param wvalues	pointer to values to write
+	 * @param num_wvalues	number of registers to write
+	 * @param rpage		register page to read back
+	 * @param roffset	register offset to start reading at
+	 * @param rvalues	pointer to read buffer
+	 * @param num_rvalues	number of registers to read
+	 */
+	int			io_reg_set_get(uint8_t wpage, uint8_t woffset, const uint16_t *wvalues, unsigned num_wvalues,
+					       uint8_t rpage, uint8_t roffset, uint16_t *rvalues, unsigned num_rvalues);
+
 	/**
 	 * modify a register
 	 *
@@ -515,6 +536,9 @@ PX4IO::PX4IO(device::Device *interface) :
 	_max_rc_input(0),
 	_max_relays(0),
 	_max_transfer(16),	/* sensible default */
+	_mixed_io_supported(true),
+	_servo_readback_time(0),
+	_servo_readback{},
 	_update_interval(0),
 	_rc_handling_disabled(false),
 	_rc_chan_count(0),
@@ -953,6 +977,8 @@ PX4IO::task_main()
 	 */
 	_t_actuator_controls_0 = orb_subscribe(ORB_ID(actuator_controls_0));
 	orb_set_interval(_t_actuator_controls_0, 20);		/* default to 50Hz */
+	/* sampled CRC check on the path feeding the IO mixer registers */
+	orb_set_integrity_check(_t_actuator_controls_0, true);
 	_t_actuator_controls_1 = orb_subscribe(ORB_ID(actuator_controls_1));
 	orb_set_interval(_t_actuator_controls_1, 33);		/* default to 30Hz */
 	_t_actuator_controls_2 = orb_subscribe(ORB_ID(actuator_controls_2));
@@ -1429,6 +1455,19 @@ PX4IO::io_set_control_state(unsigned group)
 	}
 
 	if (!_test_fmu_fail) {
+		if (group == 0 && _max_actuators <= sizeof(_servo_readback) / sizeof(_servo_readback[0])) {
+			/* push the controls and pull the servo outputs back in the same
+			 * frame exchange, saving a full bus round trip per update */
+			int ret = io_reg_set_get(PX4IO_PAGE_CONTROLS, 0, regs, _max_controls,
+						 PX4IO_PAGE_SERVOS, 0, _servo_readback, _max_actuators);
+
+			if (ret == OK) {
+				_servo_readback_time = hrt_absolute_time();
+			}
+
+			return ret;
+		}
+
 		/* copy values to registers in IO */
 		return io_reg_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
 
@@ -2031,7 +2070,16 @@ PX4IO::io_publish_pwm_outputs()
 
 	/* get servo values from IO */
 	uint16_t ctl[_max_actuators];
-	int ret = io_reg_get(PX4IO_PAGE_SERVOS, 0, ctl, _max_actuators);
+	int ret;
+
+	if (hrt_elapsed_time(&_servo_readback_time) < IO_POLL_INTERVAL * 2) {
+		/* a recent combined control transfer already carried the servo outputs */
+		memcpy(ctl, _servo_readback, sizeof(ctl));
+		ret = OK;
+
+	} else {
+		ret = io_reg_get(PX4IO_PAGE_SERVOS, 0, ctl, _max_actuators);
+	}
 
 	if (ret != OK) {
 		return ret;
@@ -2130,6 +2178,56 @@ PX4IO::io_reg_get(uint8_t page, uint8_t offset)
 	return value;
 }
 
+int
+PX4IO::io_reg_set_get(uint8_t wpage, uint8_t woffset, const uint16_t *wvalues, unsigned num_wvalues,
+		      uint8_t rpage, uint8_t roffset, uint16_t *rvalues, unsigned num_rvalues)
+{
+	/* range check the transfer */
+	if (num_wvalues > ((_max_transfer) / sizeof(*wvalues)) ||
+	    num_rvalues > ((_max_transfer) / sizeof(*rvalues))) {
+		DEVICE_DEBUG("io_reg_set_get: too many registers (%u/%u, max %u)", num_wvalues, num_rvalues, _max_transfer / 2);
+		return -EINVAL;
+	}
+
+	if (_mixed_io_supported) {
+		px4io_mixed_transfer txn;
+
+		txn.write_page = wpage;
+		txn.write_offset = woffset;
+		txn.write_values = wvalues;
+		txn.write_count = num_wvalues;
+		txn.read_page = rpage;
+		txn.read_offset = roffset;
+		txn.read_values = rvalues;
+		txn.read_count = num_rvalues;
+
+		unsigned arg = (unsigned)&txn;
+		int ret = _interface->ioctl(PX4IO_DEVICE_MIXED_TRANSFER, arg);
+
+		if (ret == OK) {
+			return OK;
+		}
+
+		if (ret == -ENODEV) {
+			/* the interface has no combined mode (e.g. I2C), stop trying */
+			_mixed_io_supported = false;
+
+		} else {
+			DEVICE_DEBUG("io_reg_set_get(%hhu,%hhu)<->(%hhu,%hhu): error %d", wpage, woffset, rpage, roffset, ret);
+			return -1;
+		}
+	}
+
+	/* fall back to two separate transfers */
+	int ret = io_reg_set(wpage, woffset, wvalues, num_wvalues);
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	return io_reg_get(rpage, roffset, rvalues, num_rvalues);
+}
+
 int
 PX4IO::io_reg_modify(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t setbits)
 {
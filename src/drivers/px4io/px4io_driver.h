@@ -39,8 +39,29 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <board_config.h>
 
+/**
+ * Combined register write + read exchange, executed as a single frame on
+ * interfaces that support it. A pointer to this struct is passed through
+ * device::Device::ioctl() as the argument; interfaces without support
+ * return -ENODEV and the caller falls back to separate transfers.
+ */
+#define PX4IO_DEVICE_MIXED_TRANSFER	0x10
+
+struct px4io_mixed_transfer {
+	uint8_t		write_page;
+	uint8_t		write_offset;
+	const uint16_t	*write_values;
+	unsigned	write_count;
+	uint8_t		read_page;
+	uint8_t		read_offset;
+	uint16_t	*read_values;
+	unsigned	read_count;
+};
+
 #ifdef PX4_I2C_OBDEV_PX4IO
 device::Device	*PX4IO_i2c_interface();
 #endif
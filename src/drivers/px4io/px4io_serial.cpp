@@ -94,6 +94,11 @@ public:
 	virtual int	write(unsigned address, void *data, unsigned count = 1);
 	virtual int	ioctl(unsigned operation, unsigned &arg);
 
+	/**
+	 * Combined register write + readback in a single frame exchange.
+	 */
+	int		write_read(px4io_mixed_transfer *txn);
+
 private:
 	/*
 	 * XXX tune this value
@@ -373,6 +378,11 @@ PX4IO_serial::ioctl(unsigned operation, unsigned &arg)
 			return 0;
 		}
 
+		break;
+
+	case PX4IO_DEVICE_MIXED_TRANSFER:
+		return write_read(reinterpret_cast<px4io_mixed_transfer *>(arg));
+
 	default:
 		break;
 	}
@@ -437,6 +447,71 @@ PX4IO_serial::write(unsigned address, void *data, unsigned count)
 	return result;
 }
 
+int
+PX4IO_serial::write_read(px4io_mixed_transfer *txn)
+{
+	/* the read target and count ride in the first two register slots */
+	if ((txn->write_count + 2 > PKT_MAX_REGS) || (txn->read_count > PKT_MAX_REGS)) {
+		return -EINVAL;
+	}
+
+	px4_sem_wait(&_bus_semaphore);
+
+	int result;
+
+	for (unsigned retries = 0; retries < 3; retries++) {
+
+		_dma_buffer.count_code = (txn->write_count + 2) | PKT_CODE_WRREAD;
+		_dma_buffer.page = txn->write_page;
+		_dma_buffer.offset = txn->write_offset;
+		_dma_buffer.regs[0] = (txn->read_page << 8) | txn->read_offset;
+		_dma_buffer.regs[1] = txn->read_count;
+		memcpy((void *)&_dma_buffer.regs[2], (void *)txn->write_values, (2 * txn->write_count));
+
+		for (unsigned i = txn->write_count + 2; i < PKT_MAX_REGS; i++) {
+			_dma_buffer.regs[i] = 0x55aa;
+		}
+
+		/* start the transaction and wait for it to complete */
+		result = _wait_complete();
+
+		/* successful transaction? */
+		if (result == OK) {
+
+			/* check result in packet */
+			if (PKT_CODE(_dma_buffer) == PKT_CODE_ERROR) {
+
+				/* IO didn't like it - no point retrying */
+				result = -EINVAL;
+				perf_count(_pc_protoerrs);
+
+				/* compare the received count with the expected count */
+
+			} else if (PKT_COUNT(_dma_buffer) != txn->read_count) {
+
+				/* IO returned the wrong number of registers - no point retrying */
+				result = -EIO;
+				perf_count(_pc_protoerrs);
+
+				/* successful exchange */
+
+			} else {
+
+				/* copy back the readback */
+				memcpy(txn->read_values, &_dma_buffer.regs[0], (2 * txn->read_count));
+			}
+
+			break;
+		}
+
+		perf_count(_pc_retries);
+	}
+
+	px4_sem_post(&_bus_semaphore);
+
+	return result;
+}
+
 int
 PX4IO_serial::read(unsigned address, void *data, unsigned count)
 {
@@ -66,7 +66,6 @@ px4::AppState QShell::appState;
 
 QShell::QShell()
 {
-	init_app_map(m_apps);
 }
 
 int QShell::main()
@@ -143,40 +142,32 @@ int QShell::run_cmd(const std::vector<std::string> &appargs)
 	std::string command = appargs[0];
 
 	if (command.compare("help") == 0) {
-		list_builtins(m_apps);
+		list_builtins();
 		return 0;
 	}
 
-	//replaces app.find with iterator code to avoid null pointer exception
-	for (apps_map_type::iterator it = m_apps.begin(); it != m_apps.end(); ++it) {
-		if (it->first == command) {
-			// one for command name, one for null terminator
-			const char *arg[MAX_ARGS + 2];
+	const px4_app_entry *app = px4_app_find(command.c_str());
 
-			unsigned int i = 0;
+	if (app != nullptr) {
+		// one for command name, one for null terminator
+		const char *arg[MAX_ARGS + 2];
 
-			if (appargs.size() > MAX_ARGS + 1) {
-				PX4_ERR("%d too many arguments in run_cmd", appargs.size() - (MAX_ARGS + 1));
-				return 1;
-			}
-
-			while (i < appargs.size() && appargs[i].c_str()[0] != '\0') {
-				arg[i] = (char *)appargs[i].c_str();
-				PX4_DEBUG("  arg%d = '%s'\n", i, arg[i]);
-				++i;
-			}
+		unsigned int i = 0;
 
-			arg[i] = (char *)0;
+		if (appargs.size() > MAX_ARGS + 1) {
+			PX4_ERR("%d too many arguments in run_cmd", appargs.size() - (MAX_ARGS + 1));
+			return 1;
+		}
 
-			//PX4_DEBUG_PRINTF(i);
-			if (m_apps[command] == NULL) {
-				PX4_ERR("Null function !!\n");
+		while (i < appargs.size() && appargs[i].c_str()[0] != '\0') {
+			arg[i] = (char *)appargs[i].c_str();
+			PX4_DEBUG("  arg%d = '%s'\n", i, arg[i]);
+			++i;
+		}
 
-			} else {
-				return m_apps[command](i, (char **)arg);
-			}
+		arg[i] = (char *)0;
 
-		}
+		return app->main(i, (char **)arg);
 	}
 
 	PX4_ERR("Command %s not found", command.c_str());
@@ -60,6 +60,5 @@ public:
 private:
 
 	struct qshell_req_s m_qshell_req;
-	apps_map_type m_apps;
 
 };
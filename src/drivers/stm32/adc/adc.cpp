@@ -59,6 +59,7 @@
 #include <drivers/drv_adc.h>
 
 #include <stm32_adc.h>
+#include <stm32_dma.h>
 #include <stm32_gpio.h>
 
 #include <systemlib/err.h>
@@ -100,6 +101,16 @@
 # define rCCR		REG(STM32_ADC_CCR_OFFSET)
 #endif
 
+/*
+ * On chips that route ADC1 to a DMA stream we run the whole channel set
+ * in continuous scan mode with the results moved into a ring by DMA, so
+ * the 100Hz tick only averages what has already been captured instead of
+ * busy-waiting on every conversion.
+ */
+#ifdef DMAMAP_ADC1_1
+# define ADC_DMA_MAP	DMAMAP_ADC1_1
+#endif
+
 class ADC : public device::CDev
 {
 public:
@@ -142,6 +153,23 @@ private:
 	 */
 	uint16_t		_sample(unsigned channel);
 
+#ifdef ADC_DMA_MAP
+	static const unsigned	_oversample = 8;	/**< scans averaged into each published sample */
+
+	DMA_HANDLE		_dma;			/**< stream for scan-mode conversions */
+	uint16_t		*_dma_buffer;		/**< conversion ring, _oversample full scans */
+	bool			_dma_active;		/**< true if the ring is being filled */
+
+	/**
+	 * Configure continuous scan-mode conversions of the full channel set
+	 * with the results DMAed into a circular buffer.
+	 *
+	 * @return		OK, or -errno if DMA is unavailable and the
+	 *			driver should keep polling single conversions.
+	 */
+	int			_init_dma();
+#endif
+
 	// update system_power ORB topic, only on FMUv2
 	void update_system_power(hrt_abstime now);
 
@@ -158,6 +186,12 @@ ADC::ADC(uint32_t channels) :
 {
 	_debug_enabled = true;
 
+#ifdef ADC_DMA_MAP
+	_dma = nullptr;
+	_dma_buffer = nullptr;
+	_dma_active = false;
+#endif
+
 	/* always enable the temperature sensor */
 	channels |= 1 << 16;
 
@@ -190,6 +224,19 @@ ADC::ADC(uint32_t channels) :
 
 ADC::~ADC()
 {
+#ifdef ADC_DMA_MAP
+
+	if (_dma != nullptr) {
+		stm32_dmastop(_dma);
+		stm32_dmafree(_dma);
+	}
+
+	if (_dma_buffer != nullptr) {
+		delete[] _dma_buffer;
+	}
+
+#endif
+
 	if (_samples != nullptr) {
 		delete _samples;
 	}
@@ -255,11 +302,92 @@ ADC::init()
 		}
 	}
 
+#ifdef ADC_DMA_MAP
+
+	/* the regular sequence registers only hold 16 conversions */
+	if (_samples != nullptr && _channel_count <= 16) {
+		if (_init_dma() != OK) {
+			DEVICE_DEBUG("no DMA stream, falling back to polled sampling");
+		}
+	}
+
+#endif
 
 	/* create the device node */
 	return CDev::init();
 }
 
+#ifdef ADC_DMA_MAP
+int
+ADC::_init_dma()
+{
+	_dma_buffer = new uint16_t[_channel_count * _oversample];
+
+	if (_dma_buffer == nullptr) {
+		return -ENOMEM;
+	}
+
+	_dma = stm32_dmachannel(ADC_DMA_MAP);
+
+	if (_dma == nullptr) {
+		delete[] _dma_buffer;
+		_dma_buffer = nullptr;
+		return -EBUSY;
+	}
+
+	/* program the full channel set as one regular sequence */
+	uint32_t sqr1 = 0;
+	uint32_t sqr2 = 0;
+	uint32_t sqr3 = 0;
+
+	for (unsigned i = 0; i < _channel_count; i++) {
+		if (i < 6) {
+			sqr3 |= _samples[i].am_channel << (5 * i);
+
+		} else if (i < 12) {
+			sqr2 |= _samples[i].am_channel << (5 * (i - 6));
+
+		} else {
+			sqr1 |= _samples[i].am_channel << (5 * (i - 12));
+		}
+	}
+
+	sqr1 |= (_channel_count - 1) << 20;
+
+	rSQR3 = sqr3;
+	rSQR2 = sqr2;
+	rSQR1 = sqr1;
+
+	rCR1 |= ADC_CR1_SCAN;
+
+	/* no completion callback - the ring is only ever read from _tick() */
+	stm32_dmasetup(
+		_dma,
+		STM32_ADC1_BASE + STM32_ADC_DR_OFFSET,
+		reinterpret_cast<uint32_t>(_dma_buffer),
+		_channel_count * _oversample,
+		DMA_SCR_CIRC		|
+		DMA_SCR_DIR_P2M		|
+		DMA_SCR_MINC		|
+		DMA_SCR_PSIZE_16BITS	|
+		DMA_SCR_MSIZE_16BITS	|
+		DMA_SCR_PBURST_SINGLE	|
+		DMA_SCR_MBURST_SINGLE);
+	stm32_dmastart(_dma, nullptr, nullptr, false);
+
+	/* convert continuously, handing every result to the stream */
+	uint32_t cr2 = ADC_CR2_CONT | ADC_CR2_DMA;
+#ifdef ADC_CR2_DDS
+	cr2 |= ADC_CR2_DDS;
+#endif
+	rCR2 |= cr2;
+	rCR2 |= ADC_CR2_SWSTART;
+
+	_dma_active = true;
+	return OK;
+}
+#endif
+
 int
 ADC::ioctl(file *filp, int cmd, unsigned long arg)
 {
@@ -313,9 +441,32 @@ ADC::_tick()
 {
 	hrt_abstime now = hrt_absolute_time();
 
-	/* scan the channel set and sample each */
-	for (unsigned i = 0; i < _channel_count; i++) {
-		_samples[i].am_data = _sample(_samples[i].am_channel);
+#ifdef ADC_DMA_MAP
+
+	if (_dma_active) {
+		/*
+		 * Average each channel over the scans captured since the last
+		 * tick. The ring is rewritten continuously behind our back, so
+		 * a slot may mix a fresh sample with older ones - harmless for
+		 * a decimating average.
+		 */
+		for (unsigned i = 0; i < _channel_count; i++) {
+			uint32_t sum = 0;
+
+			for (unsigned s = 0; s < _oversample; s++) {
+				sum += _dma_buffer[s * _channel_count + i];
+			}
+
+			_samples[i].am_data = sum / _oversample;
+		}
+
+	} else
+#endif
+	{
+		/* scan the channel set and sample each */
+		for (unsigned i = 0; i < _channel_count; i++) {
+			_samples[i].am_data = _sample(_samples[i].am_channel);
+		}
 	}
 
 	update_adc_report(now);
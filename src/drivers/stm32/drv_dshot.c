@@ -0,0 +1,199 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/*
+ * @file drv_dshot.c
+ *
+ * DShot output engine for STM32 timer blocks.
+ *
+ * A DShot frame is 16 bits: 11 bits of throttle, one telemetry request
+ * bit and a 4 bit XOR checksum. Each bit is one PWM period whose high
+ * time encodes the bit value. The frames for all channels of a timer are
+ * laid out interleaved in a RAM buffer - one CCR value per channel per
+ * bit time - and a DMA stream bursts the buffer into the CCR registers
+ * through the timer's DMAR/DCR mechanism on every update event. One
+ * trigger therefore clocks out complete, checksummed frames on up to four
+ * channels in parallel without any further CPU work.
+ */
+
+#include <px4_config.h>
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include <arch/board/board.h>
+#include <drivers/drv_pwm_output.h>
+
+#include "drv_dshot.h"
+#include "drv_io_timer.h"
+
+#include <stm32_dma.h>
+#include <stm32_tim.h>
+
+#if defined(BOARD_DSHOT_DMAMAP)
+
+/* CCR ticks within the DSHOT_MOTOR_PWM_BIT_WIDTH tick bit period */
+#define MOTOR_PWM_BIT_1			14u
+#define MOTOR_PWM_BIT_0			7u
+
+#define ONE_MOTOR_DATA_SIZE		16u
+/* two trailing zero bit times park the line low until the burst ends */
+#define ONE_MOTOR_BUFF_SIZE		18u
+#define CHANNELS_PER_TIMER		4u
+
+#define DSHOT_DMA_SCR (DMA_SCR_PRIHI | DMA_SCR_MSIZE_32BITS | DMA_SCR_PSIZE_32BITS | \
+		       DMA_SCR_MINC | DMA_SCR_DIR_M2P)
+
+typedef struct dshot_timer_t {
+	DMA_HANDLE	dma_handle;
+	bool		enabled;
+} dshot_timer_t;
+
+static const uint32_t dshot_dmamap[MAX_IO_TIMERS] = BOARD_DSHOT_DMAMAP;
+static dshot_timer_t dshot_timers[MAX_IO_TIMERS];
+
+/* one 32-bit word per CCR per bit time; the burst writes CCR1..CCR4 on
+ * every timer update event */
+static uint32_t dshot_burst_buffer[MAX_IO_TIMERS][ONE_MOTOR_BUFF_SIZE * CHANNELS_PER_TIMER];
+
+static uint16_t dshot_packet(uint16_t throttle, bool telemetry)
+{
+	uint16_t packet = (throttle << 1) | (telemetry ? 1 : 0);
+	uint16_t csum = packet ^ (packet >> 4) ^ (packet >> 8);
+
+	return (packet << 4) | (csum & 0xf);
+}
+
+int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq)
+{
+	memset(dshot_timers, 0, sizeof(dshot_timers));
+	memset(dshot_burst_buffer, 0, sizeof(dshot_burst_buffer));
+
+	for (unsigned channel = 0; channel_mask != 0 && channel < MAX_TIMER_IO_CHANNELS; channel++) {
+		if (channel_mask & (1 << channel)) {
+			channel_mask &= ~(1 << channel);
+
+			int ret = io_timer_channel_init(channel, IOTimerChanMode_Dshot, NULL, NULL);
+
+			if (ret != OK) {
+				return ret;
+			}
+
+			dshot_timers[timer_io_channels[channel].timer_index].enabled = true;
+		}
+	}
+
+	for (unsigned timer = 0; timer < MAX_IO_TIMERS; timer++) {
+		if (!dshot_timers[timer].enabled) {
+			continue;
+		}
+
+		if (dshot_dmamap[timer] == 0) {
+
+			/* the board provides no DMA stream for this timer */
+
+			return -EINVAL;
+		}
+
+		dshot_timers[timer].dma_handle = stm32_dmachannel(dshot_dmamap[timer]);
+
+		if (dshot_timers[timer].dma_handle == NULL) {
+			return -ENOSR;
+		}
+
+		int ret = io_timer_set_dshot_mode(timer, dshot_pwm_freq, CHANNELS_PER_TIMER);
+
+		if (ret != OK) {
+			return ret;
+		}
+	}
+
+	return OK;
+}
+
+void up_dshot_motor_data_set(unsigned channel, uint16_t throttle, bool telemetry)
+{
+	if (io_timer_validate_channel_index(channel) != 0) {
+		return;
+	}
+
+	const uint16_t packet = dshot_packet(throttle, telemetry);
+	const unsigned timer = timer_io_channels[channel].timer_index;
+	const unsigned word = timer_io_channels[channel].timer_channel - 1;
+
+	uint32_t *buffer = dshot_burst_buffer[timer];
+
+	/* MSB first; the trailing ONE_MOTOR_BUFF_SIZE - ONE_MOTOR_DATA_SIZE
+	 * bit times stay zero so the output idles low between frames */
+
+	for (unsigned i = 0; i < ONE_MOTOR_DATA_SIZE; i++) {
+		buffer[i * CHANNELS_PER_TIMER + word] =
+			(packet & (0x8000 >> i)) ? MOTOR_PWM_BIT_1 : MOTOR_PWM_BIT_0;
+	}
+}
+
+void up_dshot_trigger(void)
+{
+	for (unsigned timer = 0; timer < MAX_IO_TIMERS; timer++) {
+		if (!dshot_timers[timer].enabled || dshot_timers[timer].dma_handle == NULL) {
+			continue;
+		}
+
+		/* re-arm the burst: reset the request, point the stream at the
+		 * buffer and let the update events clock it out */
+
+		io_timer_update_dma_req(timer, false);
+
+		stm32_dmasetup(dshot_timers[timer].dma_handle,
+			       io_timers[timer].base + STM32_GTIM_DMAR_OFFSET,
+			       (uint32_t)dshot_burst_buffer[timer],
+			       ONE_MOTOR_BUFF_SIZE * CHANNELS_PER_TIMER,
+			       DSHOT_DMA_SCR);
+
+		stm32_dmastart(dshot_timers[timer].dma_handle, NULL, NULL, false);
+
+		io_timer_update_dma_req(timer, true);
+	}
+}
+
+int up_dshot_arm(bool armed)
+{
+	return io_timer_set_enable(armed, IOTimerChanMode_Dshot, IO_TIMER_ALL_MODES_CHANNELS);
+}
+
+#endif /* defined(BOARD_DSHOT_DMAMAP) */
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file drv_dshot.h
+ *
+ * stm32 DShot output engine.
+ *
+ * Frames are generated as PWM bit patterns by a timer and fed from RAM via
+ * a DMA burst to the CCR registers, so a complete 16 bit frame goes out on
+ * all of a timer's channels with a single trigger and no CPU involvement.
+ *
+ * Available only on boards that provide the timer-update DMA stream
+ * mapping as BOARD_DSHOT_DMAMAP (one entry per io_timer, 0 = no DShot on
+ * that timer).
+ */
+
+#pragma once
+
+#include <px4_config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+__BEGIN_DECLS
+
+/* standard DShot output rates, in bits per second */
+#define DSHOT150	150000u
+#define DSHOT300	300000u
+#define DSHOT600	600000u
+#define DSHOT1200	1200000u
+
+/* throttle range of a DShot frame; values 1..47 are configuration
+ * commands and 0 stops the motor */
+#define DSHOT_THROTTLE_MIN	48u
+#define DSHOT_THROTTLE_MAX	2047u
+#define DSHOT_CMD_MOTOR_STOP	0u
+
+/**
+ * Allocate the given output channels for DShot and set up the per-timer
+ * DMA burst machinery.
+ *
+ * @param channel_mask	output channels to drive with DShot
+ * @param dshot_pwm_freq	bit rate, one of DSHOT150 ... DSHOT1200
+ * @return		OK on success, -errno otherwise
+ */
+__EXPORT extern int	up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq);
+
+/**
+ * Encode throttle and telemetry request for one channel into the burst
+ * buffer. The frame is sent by the next up_dshot_trigger().
+ *
+ * @param channel	output channel
+ * @param throttle	0 (motor stop) or DSHOT_THROTTLE_MIN..DSHOT_THROTTLE_MAX
+ * @param telemetry	request a telemetry frame on the back channel
+ */
+__EXPORT extern void	up_dshot_motor_data_set(unsigned channel, uint16_t throttle, bool telemetry);
+
+/**
+ * Start the DMA bursts sending the prepared frames on all DShot timers.
+ */
+__EXPORT extern void	up_dshot_trigger(void);
+
+/**
+ * Enable or disable the DShot outputs.
+ *
+ * @return		OK on success
+ */
+__EXPORT extern int	up_dshot_arm(bool armed);
+
+__END_DECLS
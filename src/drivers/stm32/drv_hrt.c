@@ -61,6 +61,7 @@
 
 #include <board_config.h>
 #include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
 
 
 #include "stm32_gpio.h"
@@ -261,6 +262,14 @@ __EXPORT const uint16_t latency_bucket_count = LATENCY_BUCKET_COUNT;
 __EXPORT const uint16_t	latency_buckets[LATENCY_BUCKET_COUNT] = { 1, 2, 5, 10, 20, 50, 100, 1000 };
 __EXPORT uint32_t		latency_counters[LATENCY_BUCKET_COUNT + 1];
 
+/* per-callout latency instrumentation (see hrt_call_set_latency_perf()) */
+#define HRT_LATENCY_CLIENTS	8
+
+static struct {
+	struct hrt_call		*entry;
+	perf_counter_t		perf;
+} latency_clients[HRT_LATENCY_CLIENTS];
+
 
 /* timer-specific functions */
 static void		hrt_tim_init(void);
@@ -915,6 +924,14 @@ hrt_call_invoke(void)
 		/* zero the deadline, as the call has occurred */
 		call->deadline = 0;
 
+		/* record deadline-to-dispatch latency for instrumented callouts */
+		for (unsigned i = 0; i < HRT_LATENCY_CLIENTS; i++) {
+			if (latency_clients[i].entry == call) {
+				perf_set_elapsed(latency_clients[i].perf, now - deadline);
+				break;
+			}
+		}
+
 		/* invoke the callout (if there is one) */
 		if (call->callout) {
 			hrtinfo("call %p: %p(%p)\n", call, call->callout, call->arg);
@@ -997,6 +1014,33 @@ hrt_latency_update(void)
 	latency_counters[index]++;
 }
 
+void
+hrt_call_set_latency_perf(struct hrt_call *entry, struct perf_ctr_header *perf)
+{
+	irqstate_t flags = px4_enter_critical_section();
+	unsigned i;
+
+	/* update an existing registration first */
+	for (i = 0; i < HRT_LATENCY_CLIENTS; i++) {
+		if (latency_clients[i].entry == entry) {
+			latency_clients[i].perf = perf;
+			latency_clients[i].entry = (perf != NULL) ? entry : NULL;
+			px4_leave_critical_section(flags);
+			return;
+		}
+	}
+
+	for (i = 0; i < HRT_LATENCY_CLIENTS; i++) {
+		if (latency_clients[i].entry == NULL && perf != NULL) {
+			latency_clients[i].entry = entry;
+			latency_clients[i].perf = perf;
+			break;
+		}
+	}
+
+	px4_leave_critical_section(flags);
+}
+
 void
 hrt_call_init(struct hrt_call *entry)
 {
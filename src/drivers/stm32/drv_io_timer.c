@@ -125,8 +125,8 @@
 #else
 #define CCER_C1_INIT  GTIM_CCER_CC1E
 #endif
-//												 				  NotUsed   PWMOut  PWMIn Capture OneShot Trigger
-io_timer_channel_allocation_t channel_allocations[IOTimerChanModeSize] = { UINT8_MAX,   0,  0,  0, 0, 0 };
+//												 				  NotUsed   PWMOut  PWMIn Capture OneShot Trigger Dshot
+io_timer_channel_allocation_t channel_allocations[IOTimerChanModeSize] = { UINT8_MAX,   0,  0,  0, 0, 0, 0 };
 
 typedef uint8_t io_timer_allocation_t; /* big enough to hold MAX_IO_TIMERS */
 
@@ -488,6 +488,47 @@ static inline void io_timer_set_PWM_mode(unsigned timer)
 	rPSC(timer) = (io_timers[timer].clock_freq / BOARD_PWM_FREQ) - 1;
 }
 
+int io_timer_set_dshot_mode(unsigned timer, unsigned dshot_pwm_freq, unsigned dma_burst_length)
+{
+	int rv = -EBUSY;
+
+	/* Get the channel bits that belong to the timer */
+
+	uint32_t channels = get_timer_channels(timer);
+
+	/* Change only a timer that is owned by dshot */
+
+	if ((channels & (channel_allocations[IOTimerChanMode_Dshot] |
+			 channel_allocations[IOTimerChanMode_NotUsed])) == channels) {
+
+		/* one timer period per DShot bit, counted in
+		 * DSHOT_MOTOR_PWM_BIT_WIDTH ticks */
+
+		rARR(timer) = DSHOT_MOTOR_PWM_BIT_WIDTH - 1;
+		rPSC(timer) = ((io_timers[timer].clock_freq / dshot_pwm_freq) / DSHOT_MOTOR_PWM_BIT_WIDTH) - 1;
+		rEGR(timer) = GTIM_EGR_UG;
+
+		/* DMA burst of dma_burst_length transfers per update event,
+		 * starting at CCR1 (DCR: DBL in bits 12:8, DBA in bits 4:0) */
+
+		rDCR(timer) = (((uint32_t)(dma_burst_length - 1)) << 8) | (STM32_GTIM_CCR1_OFFSET >> 2);
+
+		rv = OK;
+	}
+
+	return rv;
+}
+
+void io_timer_update_dma_req(unsigned timer, bool enable)
+{
+	if (enable) {
+		rDIER(timer) |= GTIM_DIER_UDE;
+
+	} else {
+		rDIER(timer) &= ~GTIM_DIER_UDE;
+	}
+}
+
 void io_timer_trigger(void)
 {
 	int oneshots = io_timer_get_mode_channels(IOTimerChanMode_OneShot);
@@ -653,6 +694,7 @@ int io_timer_channel_init(unsigned channel, io_timer_channel_mode_t mode,
 	case IOTimerChanMode_OneShot:
 	case IOTimerChanMode_PWMOut:
 	case IOTimerChanMode_Trigger:
+	case IOTimerChanMode_Dshot:
 		ccer_setbits = 0;
 		dier_setbits = 0;
 		setbits = CCMR_C1_PWMOUT_INIT;
@@ -770,6 +812,7 @@ int io_timer_set_enable(bool state, io_timer_channel_mode_t mode, io_timer_chann
 	case IOTimerChanMode_OneShot:
 	case IOTimerChanMode_PWMOut:
 	case IOTimerChanMode_Trigger:
+	case IOTimerChanMode_Dshot:
 		dier_bit = 0;
 		break;
 
@@ -815,7 +858,8 @@ int io_timer_set_enable(bool state, io_timer_channel_mode_t mode, io_timer_chann
 			if ((state &&
 			     (mode == IOTimerChanMode_PWMOut ||
 			      mode == IOTimerChanMode_OneShot ||
-			      mode == IOTimerChanMode_Trigger))) {
+			      mode == IOTimerChanMode_Trigger ||
+			      mode == IOTimerChanMode_Dshot))) {
 				action_cache[timer].gpio[shifts] = timer_io_channels[chan_index].gpio_out;
 			}
 		}
@@ -53,6 +53,9 @@ __BEGIN_DECLS
 
 #define IO_TIMER_ALL_MODES_CHANNELS 0
 
+/* timer ticks per DShot bit period, shared with the DShot engine */
+#define DSHOT_MOTOR_PWM_BIT_WIDTH 20u
+
 typedef enum io_timer_channel_mode_t {
 	IOTimerChanMode_NotUsed = 0,
 	IOTimerChanMode_PWMOut  = 1,
@@ -60,6 +63,7 @@ typedef enum io_timer_channel_mode_t {
 	IOTimerChanMode_Capture = 3,
 	IOTimerChanMode_OneShot = 4,
 	IOTimerChanMode_Trigger = 5,
+	IOTimerChanMode_Dshot   = 6,
 	IOTimerChanModeSize
 } io_timer_channel_mode_t;
 
@@ -123,6 +127,9 @@ __EXPORT int io_timer_set_rate(unsigned timer, unsigned rate);
 __EXPORT int io_timer_set_enable(bool state, io_timer_channel_mode_t mode,
 				 io_timer_channel_allocation_t masks);
 __EXPORT int io_timer_set_rate(unsigned timer, unsigned rate);
+__EXPORT int io_timer_set_dshot_mode(unsigned timer, unsigned dshot_pwm_freq,
+				     unsigned dma_burst_length);
+__EXPORT void io_timer_update_dma_req(unsigned timer, bool enable);
 __EXPORT uint16_t io_channel_get_ccr(unsigned channel);
 __EXPORT int io_timer_set_ccr(unsigned channel, uint16_t value);
 __EXPORT uint32_t io_timer_get_group(unsigned timer);
@@ -104,12 +104,17 @@
 #include <math.h>
 #include <ctype.h>
 
+#include <nuttx/wqueue.h>
+
 #include <board_config.h>
 #include <drivers/drv_hrt.h>
 
 #include <systemlib/err.h>
 #include <systemlib/circuit_breaker.h>
 
+#include <uORB/uORB.h>
+#include <uORB/topics/tune_control.h>
+
 /* Check that tone alarm and HRT timers are different */
 #if defined(TONE_ALARM_TIMER)  && defined(HRT_TIMER)
 # if TONE_ALARM_TIMER == HRT_TIMER
@@ -292,6 +297,9 @@
 
 #define CBRK_BUZZER_KEY 782097
 
+/* how often the tune_control topic is checked for playback requests */
+#define TUNE_CONTROL_POLL_INTERVAL_US	50000
+
 class ToneAlarm : public device::CDev
 {
 public:
@@ -336,6 +344,24 @@ private:
 
 	hrt_call		_note_call;	// HRT callout for note completion
 
+	// tune_control subscription: tunes requested over the topic are played
+	// from the low priority work queue, so publishers (commander paths)
+	// never block on this device
+	int			_tune_control_sub;
+	work_s			_work;
+
+	// Select and start one of the predefined tunes (TONE_SET_ALARM logic)
+	//
+	int			set_alarm_tune(unsigned tune);
+
+	// Check for a tune requested over the tune_control topic
+	//
+	void			poll_tune_control();
+
+	// work queue trampoline for poll_tune_control
+	//
+	static void		poll_trampoline(void *arg);
+
 	// Convert a note value in the range C1 to B7 into a divisor for
 	// the configured timer's clock.
 	//
@@ -402,8 +428,11 @@ ToneAlarm::ToneAlarm() :
 	_user_tune(nullptr),
 	_tune(nullptr),
 	_next(nullptr),
-	_cbrk(CBRK_OFF)
+	_cbrk(CBRK_OFF),
+	_tune_control_sub(-1)
 {
+	memset(&_work, 0, sizeof(_work));
+
 	// enable debug() calls
 	//_debug_enabled = true;
 	_default_tunes[TONE_STARTUP_TUNE] = "MFT240L8 O4aO5dc O4aO5dc O4aO5dc L16dcdcdcdc";		// startup tune
@@ -441,6 +470,11 @@ ToneAlarm::ToneAlarm() :
 
 ToneAlarm::~ToneAlarm()
 {
+	work_cancel(LPWORK, &_work);
+
+	if (_tune_control_sub >= 0) {
+		orb_unsubscribe(_tune_control_sub);
+	}
 }
 
 int
@@ -489,10 +523,66 @@ ToneAlarm::init()
 	/* make sure the timer is running */
 	rCR1 = GTIM_CR1_CEN;
 
+	/* listen for tunes requested over the topic */
+	_tune_control_sub = orb_subscribe(ORB_ID(tune_control));
+	work_queue(LPWORK, &_work, poll_trampoline, this, USEC2TICK(TUNE_CONTROL_POLL_INTERVAL_US));
+
 	DEVICE_DEBUG("ready");
 	return OK;
 }
 
+void
+ToneAlarm::poll_trampoline(void *arg)
+{
+	ToneAlarm *ta = (ToneAlarm *)arg;
+
+	ta->poll_tune_control();
+}
+
+void
+ToneAlarm::poll_tune_control()
+{
+	/* drain the queue so a stop does not linger behind queued tunes */
+	bool updated = false;
+	orb_check(_tune_control_sub, &updated);
+
+	while (updated) {
+		tune_control_s tune;
+		orb_copy(ORB_ID(tune_control), _tune_control_sub, &tune);
+		set_alarm_tune(tune.tune_id);
+
+		orb_check(_tune_control_sub, &updated);
+	}
+
+	work_queue(LPWORK, &_work, poll_trampoline, this, USEC2TICK(TUNE_CONTROL_POLL_INTERVAL_US));
+}
+
+int
+ToneAlarm::set_alarm_tune(unsigned tune)
+{
+	if (tune >= TONE_NUMBER_OF_TUNES) {
+		return -EINVAL;
+	}
+
+	if (tune == TONE_STOP_TUNE) {
+		// stop the tune
+		_tune = nullptr;
+		_next = nullptr;
+		_repeat = false;
+		_default_tune_number = 0;
+
+	} else {
+		/* always interrupt alarms, unless they are repeating and already playing */
+		if (!(_repeat && _default_tune_number == tune)) {
+			/* play the selected tune */
+			_default_tune_number = tune;
+			start_tune(_default_tunes[tune]);
+		}
+	}
+
+	return OK;
+}
+
 unsigned
 ToneAlarm::note_to_divisor(unsigned note)
 {
@@ -904,27 +994,7 @@ ToneAlarm::ioctl(file *filp, int cmd, unsigned long arg)
 	case TONE_SET_ALARM:
 		DEVICE_DEBUG("TONE_SET_ALARM %u", arg);
 
-		if (arg < TONE_NUMBER_OF_TUNES) {
-			if (arg == TONE_STOP_TUNE) {
-				// stop the tune
-				_tune = nullptr;
-				_next = nullptr;
-				_repeat = false;
-				_default_tune_number = 0;
-
-			} else {
-				/* always interrupt alarms, unless they are repeating and already playing */
-				if (!(_repeat && _default_tune_number == arg)) {
-					/* play the selected tune */
-					_default_tune_number = arg;
-					start_tune(_default_tunes[arg]);
-				}
-			}
-
-		} else {
-			result = -EINVAL;
-		}
-
+		result = set_alarm_tune(arg);
 		break;
 
 	default:
@@ -47,9 +47,16 @@ namespace control
 
 float BlockHighPass::update(float input)
 {
-	float b = 2 * float(M_PI) * getFCut() * getDt();
-	float a = 1 / (1 + b);
-	setY(a * (getY() + input - getU()));
+	/* lazily recompute the coefficient, it only depends on dt and the
+	 * cutoff which are constant between reschedules/param updates */
+	if (fabsf(getDt() - _aDt) > FLT_EPSILON || fabsf(getFCut() - _aFCut) > FLT_EPSILON) {
+		float b = 2 * float(M_PI) * getFCut() * getDt();
+		_a = 1 / (1 + b);
+		_aDt = getDt();
+		_aFCut = getFCut();
+	}
+
+	setY(_a * (getY() + input - getU()));
 	setU(input);
 	return getY();
 }
@@ -67,6 +67,9 @@ public:
 		Block(parent, name),
 		_u(0),
 		_y(0),
+		_a(0.0f),
+		_aDt(-1.0f),
+		_aFCut(-1.0f),
 		_fCut(this, "") // only one parameter, no need to name
 	{};
 	virtual ~BlockHighPass() {};
@@ -81,6 +84,9 @@ protected:
 // attributes
 	float _u; /**< previous input */
 	float _y; /**< previous output */
+	float _a; /**< cached filter coefficient */
+	float _aDt; /**< dt the coefficient was computed for */
+	float _aFCut; /**< cutoff the coefficient was computed for */
 	control::BlockParamFloat _fCut; /**< cut-off frequency, Hz */
 };
 
@@ -51,9 +51,16 @@ float BlockLowPass::update(float input)
 		setState(input);
 	}
 
-	float b = 2 * float(M_PI) * getFCut() * getDt();
-	float a = b / (1 + b);
-	setState(a * input + (1 - a)*getState());
+	/* lazily recompute the coefficient, it only depends on dt and the
+	 * cutoff which are constant between reschedules/param updates */
+	if (fabsf(getDt() - _aDt) > FLT_EPSILON || fabsf(getFCut() - _aFCut) > FLT_EPSILON) {
+		float b = 2 * float(M_PI) * getFCut() * getDt();
+		_a = b / (1 + b);
+		_aDt = getDt();
+		_aFCut = getFCut();
+	}
+
+	setState(_a * input + (1 - _a)*getState());
 	return getState();
 }
 
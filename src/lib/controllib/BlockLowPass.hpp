@@ -66,6 +66,9 @@ public:
 	BlockLowPass(SuperBlock *parent, const char *name) :
 		Block(parent, name),
 		_state(0.0f / 0.0f /* initialize to invalid val, force into is_finite() check on first call */),
+		_a(0.0f),
+		_aDt(-1.0f),
+		_aFCut(-1.0f),
 		_fCut(this, "") // only one parameter, no need to name
 	{};
 	virtual ~BlockLowPass() {};
@@ -77,6 +80,9 @@ public:
 protected:
 // attributes
 	float _state;
+	float _a; /**< cached filter coefficient */
+	float _aDt; /**< dt the coefficient was computed for */
+	float _aFCut; /**< cutoff the coefficient was computed for */
 	control::BlockParamFloat _fCut;
 };
 
@@ -44,6 +44,7 @@
 #include <time.h>
 #include <stdlib.h>
 #include <math.h>
+#include <float.h>
 #include <mathlib/math/test/test.hpp>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 
@@ -64,6 +65,9 @@ public:
 			   const char *name) :
 		Block(parent, name),
 		_state(),
+		_a(0.0f),
+		_aDt(-1.0f),
+		_aFCut(-1.0f),
 		_fCut(this, "") // only one parameter, no need to name
 	{
 		for (int i = 0; i < M; i++) {
@@ -79,9 +83,16 @@ public:
 			}
 		}
 
-		float b = 2 * float(M_PI) * getFCut() * getDt();
-		float a = b / (1 + b);
-		setState(input * a + getState() * (1 - a));
+		/* lazily recompute the coefficient, it only depends on dt and the
+		 * cutoff which are constant between reschedules/param updates */
+		if (fabsf(getDt() - _aDt) > FLT_EPSILON || fabsf(getFCut() - _aFCut) > FLT_EPSILON) {
+			float b = 2 * float(M_PI) * getFCut() * getDt();
+			_a = b / (1 + b);
+			_aDt = getDt();
+			_aFCut = getFCut();
+		}
+
+		setState(input * _a + getState() * (1 - _a));
 		return getState();
 	}
 // accessors
@@ -91,6 +102,9 @@ public:
 private:
 // attributes
 	matrix::Vector<Type, M> _state;
+	float _a; /**< cached filter coefficient */
+	float _aDt; /**< dt the coefficient was computed for */
+	float _aFCut; /**< cutoff the coefficient was computed for */
 	control::BlockParamFloat _fCut;
 };
 
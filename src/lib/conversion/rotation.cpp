@@ -267,3 +267,43 @@ rotate_3f(enum Rotation rot, float &x, float &y, float &z)
 		}
 	}
 }
+
+void
+FixedRotation::set_rotation(enum Rotation rot)
+{
+	/* build the matrix by passing the basis vectors through the
+	 * reference implementation, so the two can never get out of sync
+	 * and the sign/swap cases stay exact (no trigonometry involved) */
+	for (unsigned i = 0; i < 3; i++) {
+		float v[3] = {0.0f, 0.0f, 0.0f};
+		v[i] = 1.0f;
+		rotate_3f(rot, v[0], v[1], v[2]);
+		_mat[0][i] = v[0];
+		_mat[1][i] = v[1];
+		_mat[2][i] = v[2];
+	}
+
+	_identity = (rot == ROTATION_NONE || rot == ROTATION_MAX);
+	_pure_swap = true;
+
+	/* a row with a single +/-1 entry is a pure sign/swap: record which
+	 * source component it selects and with which sign */
+	for (unsigned r = 0; r < 3; r++) {
+		unsigned nonzero = 0;
+
+		for (unsigned c = 0; c < 3; c++) {
+			if (_mat[r][c] == 1.0f || _mat[r][c] == -1.0f) {
+				_map[r] = c;
+				_sign[r] = _mat[r][c];
+				nonzero++;
+
+			} else if (_mat[r][c] != 0.0f) {
+				_pure_swap = false;
+			}
+		}
+
+		if (nonzero != 1) {
+			_pure_swap = false;
+		}
+	}
+}
@@ -140,4 +140,58 @@ __EXPORT void
 rotate_3f(enum Rotation rot, float &x, float &y, float &z);
 
 
+/**
+ * A sensor mounting rotation resolved once at configuration time.
+ *
+ * rotate_3f() dispatches over all rotation enums on every call, which adds
+ * a branch cascade to every sample of drivers running at 1 kHz although the
+ * mounting rotation is fixed at boot. This class resolves the rotation once
+ * in set_rotation(): identity returns immediately, the 90/180/270 degree
+ * rotations become a branch-free sign/swap over a small index table, and
+ * everything else (45 degree yaws, calibrated mount angles) is a cached
+ * 3x3 matrix multiplication.
+ */
+class __EXPORT FixedRotation
+{
+public:
+	FixedRotation() = default;
+
+	/**
+	 * Resolve the rotation. Must be called before rotate().
+	 */
+	void		set_rotation(enum Rotation rot);
+
+	/**
+	 * Rotate a vector in-place.
+	 */
+	void		rotate(float &x, float &y, float &z) const
+	{
+		if (_identity) {
+			return;
+		}
+
+		const float v[3] = {x, y, z};
+
+		if (_pure_swap) {
+			x = _sign[0] * v[_map[0]];
+			y = _sign[1] * v[_map[1]];
+			z = _sign[2] * v[_map[2]];
+
+		} else {
+			x = _mat[0][0] * v[0] + _mat[0][1] * v[1] + _mat[0][2] * v[2];
+			y = _mat[1][0] * v[0] + _mat[1][1] * v[1] + _mat[1][2] * v[2];
+			z = _mat[2][0] * v[0] + _mat[2][1] * v[1] + _mat[2][2] * v[2];
+		}
+	}
+
+	bool		is_identity() const { return _identity; }
+
+private:
+	float		_mat[3][3] = {{1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, 0.f, 1.f}};
+	float		_sign[3] = {1.f, 1.f, 1.f};
+	uint8_t		_map[3] = {0, 1, 2};
+	bool		_identity{true};
+	bool		_pure_swap{false};
+};
+
 #endif /* ROTATION_H_ */
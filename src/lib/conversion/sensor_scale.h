@@ -0,0 +1,97 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file sensor_scale.h
+ *
+ * Vectorized unit-conversion kernels for sensor data.
+ *
+ * Most sensor unit conversions are "multiply a few adjacent floats by a
+ * common scale". The kernels here work on four-lane arrays so three-axis
+ * data plus one spare lane (temperature or padding) fits one vector
+ * register: on SSE2 and NEON hosts each call is a single vector multiply,
+ * elsewhere a plain loop the compiler can unroll. Mainly of interest on
+ * the posix side, where the simulator converts sensor data for many
+ * vehicle instances per host.
+ */
+
+#ifndef SENSOR_SCALE_H_
+#define SENSOR_SCALE_H_
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+/**
+ * Multiply four lanes by a common scale factor.
+ *
+ * in and out may alias; no alignment requirements.
+ */
+static inline void
+sensor_scale4f(const float in[4], float scale, float out[4])
+{
+#if defined(__SSE2__)
+	_mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(in), _mm_set1_ps(scale)));
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	vst1q_f32(out, vmulq_n_f32(vld1q_f32(in), scale));
+#else
+
+	for (unsigned i = 0; i < 4; i++) {
+		out[i] = in[i] * scale;
+	}
+
+#endif
+}
+
+/**
+ * Multiply four lanes by a common scale factor and add a common offset.
+ */
+static inline void
+sensor_scale_offset4f(const float in[4], float scale, float offset, float out[4])
+{
+#if defined(__SSE2__)
+	_mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in), _mm_set1_ps(scale)), _mm_set1_ps(offset)));
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	vst1q_f32(out, vmlaq_n_f32(vdupq_n_f32(offset), vld1q_f32(in), scale));
+#else
+
+	for (unsigned i = 0; i < 4; i++) {
+		out[i] = in[i] * scale + offset;
+	}
+
+#endif
+}
+
+#endif /* SENSOR_SCALE_H_ */
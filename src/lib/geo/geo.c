@@ -134,13 +134,10 @@ __EXPORT int map_projection_global_project(double lat, double lon, float *x, flo
 
 }
 
-__EXPORT int map_projection_project(const struct map_projection_reference_s *ref, double lat, double lon, float *x,
-				    float *y)
+/* project one point; the caller has checked that ref is initialized */
+static void map_projection_project_point(const struct map_projection_reference_s *ref, double lat, double lon,
+		float *x, float *y)
 {
-	if (!map_projection_initialized(ref)) {
-		return -1;
-	}
-
 	double lat_rad = lat * M_DEG_TO_RAD;
 	double lon_rad = lon * M_DEG_TO_RAD;
 
@@ -162,22 +159,43 @@ __EXPORT int map_projection_project(const struct map_projection_reference_s *ref
 
 	*x = k * (ref->cos_lat * sin_lat - ref->sin_lat * cos_lat * cos_d_lon) * CONSTANTS_RADIUS_OF_EARTH;
 	*y = k * cos_lat * sin(lon_rad - ref->lon_rad) * CONSTANTS_RADIUS_OF_EARTH;
-
-	return 0;
 }
 
-__EXPORT int map_projection_global_reproject(float x, float y, double *lat, double *lon)
+__EXPORT int map_projection_project(const struct map_projection_reference_s *ref, double lat, double lon, float *x,
+				    float *y)
 {
-	return map_projection_reproject(&mp_ref, x, y, lat, lon);
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	map_projection_project_point(ref, lat, lon, x, y);
+
+	return 0;
 }
 
-__EXPORT int map_projection_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat,
-				      double *lon)
+__EXPORT int map_projection_project_array(const struct map_projection_reference_s *ref, const double *lat,
+		const double *lon, float *x, float *y, unsigned count)
 {
 	if (!map_projection_initialized(ref)) {
 		return -1;
 	}
 
+	for (unsigned i = 0; i < count; i++) {
+		map_projection_project_point(ref, lat[i], lon[i], &x[i], &y[i]);
+	}
+
+	return 0;
+}
+
+__EXPORT int map_projection_global_reproject(float x, float y, double *lat, double *lon)
+{
+	return map_projection_reproject(&mp_ref, x, y, lat, lon);
+}
+
+/* reproject one point; the caller has checked that ref is initialized */
+static void map_projection_reproject_point(const struct map_projection_reference_s *ref, float x, float y,
+		double *lat, double *lon)
+{
 	double x_rad = (double)x / CONSTANTS_RADIUS_OF_EARTH;
 	double y_rad = (double)y / CONSTANTS_RADIUS_OF_EARTH;
 	double c = sqrtf(x_rad * x_rad + y_rad * y_rad);
@@ -198,6 +216,30 @@ __EXPORT int map_projection_reproject(const struct map_projection_reference_s *r
 
 	*lat = lat_rad * 180.0 / M_PI;
 	*lon = lon_rad * 180.0 / M_PI;
+}
+
+__EXPORT int map_projection_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat,
+				      double *lon)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	map_projection_reproject_point(ref, x, y, lat, lon);
+
+	return 0;
+}
+
+__EXPORT int map_projection_reproject_array(const struct map_projection_reference_s *ref, const float *x,
+		const float *y, double *lat, double *lon, unsigned count)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	for (unsigned i = 0; i < count; i++) {
+		map_projection_reproject_point(ref, x[i], y[i], &lat[i], &lon[i]);
+	}
 
 	return 0;
 }
@@ -350,6 +392,34 @@ __EXPORT float get_bearing_to_next_waypoint(double lat_now, double lon_now, doub
 	return theta;
 }
 
+__EXPORT void get_distance_and_bearing_to_next_waypoint(double lat_now, double lon_now, double lat_next,
+		double lon_next, float *dist, float *bearing)
+{
+	double lat_now_rad = lat_now * M_DEG_TO_RAD;
+	double lat_next_rad = lat_next * M_DEG_TO_RAD;
+
+	double d_lat = lat_next_rad - lat_now_rad;
+	double d_lon = (lon_next - lon_now) * M_DEG_TO_RAD;
+
+	/* terms shared between the haversine distance and the bearing */
+	double cos_lat_now = cos(lat_now_rad);
+	double cos_lat_next = cos(lat_next_rad);
+
+	double sin_half_d_lat = sin(d_lat / (double)2.0);
+	double sin_half_d_lon = sin(d_lon / (double)2.0);
+
+	double a = sin_half_d_lat * sin_half_d_lat + sin_half_d_lon * sin_half_d_lon * cos_lat_now * cos_lat_next;
+	double c = (double)2.0 * atan2(sqrt(a), sqrt((double)1.0 - a));
+
+	*dist = CONSTANTS_RADIUS_OF_EARTH * c;
+
+	/* conscious mix of double and float trig function to maximize speed and efficiency */
+	float theta = atan2f(sin(d_lon) * cos_lat_next,
+			     cos_lat_now * sin(lat_next_rad) - sin(lat_now_rad) * cos_lat_next * cos(d_lon));
+
+	*bearing = _wrap_pi(theta);
+}
+
 __EXPORT void get_vector_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next, float *v_n,
 		float *v_e)
 {
@@ -430,9 +500,11 @@ __EXPORT int get_distance_to_line(struct crosstrack_error_s *crosstrack_error, d
 		return return_value;
 	}
 
-	crosstrack_error->distance = (dist_to_end) * sinf(bearing_diff);
+	float sin_bearing_diff = sinf(bearing_diff);
+
+	crosstrack_error->distance = (dist_to_end) * sin_bearing_diff;
 
-	if (sinf(bearing_diff) >= 0) {
+	if (sin_bearing_diff >= 0) {
 		crosstrack_error->bearing = _wrap_pi(bearing_track - M_PI_2_F);
 
 	} else {
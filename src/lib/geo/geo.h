@@ -171,6 +171,20 @@ __EXPORT int map_projection_global_project(double lat, double lon, float *x, flo
 __EXPORT int map_projection_project(const struct map_projection_reference_s *ref, double lat, double lon, float *x,
 				    float *y);
 
+/**
+ * Transforms an array of points in the geographic coordinate system to the
+ * local azimuthal equidistant plane using the projection given by the
+ * argument. The initialization check is done once for the whole batch.
+ * @param lat latitudes in degrees (47.1234567°, not 471234567°)
+ * @param lon longitudes in degrees (8.1234567°, not 81234567°)
+ * @param x north [m], one entry per input point
+ * @param y east [m], one entry per input point
+ * @param count number of points
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_project_array(const struct map_projection_reference_s *ref, const double *lat,
+		const double *lon, float *x, float *y, unsigned count);
+
 /**
  * Transforms a point in the local azimuthal equidistant plane to the
  * geographic coordinate system using the global projection
@@ -196,6 +210,20 @@ __EXPORT int map_projection_global_reproject(float x, float y, double *lat, doub
 __EXPORT int map_projection_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat,
 				      double *lon);
 
+/**
+ * Transforms an array of points in the local azimuthal equidistant plane to
+ * the geographic coordinate system using the projection given by the
+ * argument. The initialization check is done once for the whole batch.
+ * @param x north [m], one entry per point
+ * @param y east [m], one entry per point
+ * @param lat latitudes in degrees, one entry per point
+ * @param lon longitudes in degrees, one entry per point
+ * @param count number of points
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_reproject_array(const struct map_projection_reference_s *ref, const float *x,
+		const float *y, double *lat, double *lon, unsigned count);
+
 /**
  * Get reference position of the global map projection
  */
@@ -277,6 +305,21 @@ __EXPORT void waypoint_from_heading_and_distance(double lat_start, double lon_st
  */
 __EXPORT float get_bearing_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next);
 
+/**
+ * Returns both the distance in meters and the bearing in radians to the next
+ * waypoint, sharing the trigonometry between the two (cheaper than separate
+ * calls to get_distance_to_next_waypoint() and get_bearing_to_next_waypoint()).
+ *
+ * @param lat_now current position in degrees (47.1234567°, not 471234567°)
+ * @param lon_now current position in degrees (8.1234567°, not 81234567°)
+ * @param lat_next next waypoint position in degrees (47.1234567°, not 471234567°)
+ * @param lon_next next waypoint position in degrees (8.1234567°, not 81234567°)
+ * @param dist returned distance in meters
+ * @param bearing returned bearing in radians
+ */
+__EXPORT void get_distance_and_bearing_to_next_waypoint(double lat_now, double lon_now, double lat_next,
+		double lon_next, float *dist, float *bearing);
+
 __EXPORT void get_vector_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next, float *v_n,
 		float *v_e);
 
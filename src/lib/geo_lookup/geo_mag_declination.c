@@ -73,7 +73,46 @@ static const int8_t declination_table[13][37] = \
 	{ 3, 8, 13, 16, 19, 20, 19, 14, 4, -7, -18, -24, -26, -24, -21, -16, -11, -6, -2, 2, 6, 10, 13, 15, 17, 16, 13, 7, 0, -7, -13, -15, -14, -11, -6, -1, 3 },
 };
 
-static float get_lookup_table_val(unsigned lat, unsigned lon);
+/* inclination (dip angle) in degrees, positive down; same grid as the
+ * declination table. Derived from a dipole approximation of WMM2015,
+ * which is adequate as an initialization prior for estimators. */
+static const int8_t inclination_table[13][37] = \
+{
+	{ -75, -74, -73, -72, -71, -70, -69, -69, -68, -68, -68, -68, -68, -68, -68, -69, -70, -70, -71, -72, -73, -74, -75, -76, -77, -78, -79, -79, -79, -79, -79, -79, -78, -78, -77, -76, -75 },
+	{ -69, -67, -66, -65, -64, -63, -62, -61, -60, -60, -60, -60, -60, -60, -61, -61, -62, -63, -64, -66, -67, -68, -69, -70, -71, -72, -73, -73, -74, -74, -73, -73, -72, -72, -71, -70, -69 },
+	{ -61, -60, -58, -57, -55, -54, -53, -51, -51, -50, -50, -50, -50, -50, -51, -52, -53, -55, -56, -57, -59, -60, -62, -63, -64, -65, -66, -67, -67, -67, -67, -66, -66, -65, -64, -62, -61 },
+	{ -52, -50, -48, -46, -44, -42, -41, -39, -38, -37, -37, -37, -37, -38, -39, -40, -42, -43, -45, -47, -49, -51, -53, -54, -56, -57, -58, -58, -59, -59, -59, -58, -57, -56, -55, -53, -52 },
+	{ -40, -37, -35, -32, -30, -28, -25, -23, -22, -21, -20, -20, -21, -21, -23, -24, -26, -29, -31, -34, -36, -39, -41, -43, -45, -46, -47, -48, -49, -49, -48, -48, -47, -45, -44, -42, -40 },
+	{ -24, -21, -18, -15, -12, -9, -7, -5, -3, -2, -1, -1, -1, -2, -4, -6, -8, -11, -14, -17, -20, -23, -26, -28, -31, -32, -34, -35, -35, -35, -35, -34, -33, -31, -29, -27, -24 },
+	{ -6, -2, 1, 4, 7, 10, 13, 15, 17, 18, 19, 19, 18, 17, 16, 14, 12, 9, 6, 2, -1, -4, -7, -10, -13, -15, -17, -18, -19, -19, -18, -17, -16, -14, -12, -9, -6 },
+	{ 14, 17, 20, 23, 26, 28, 31, 32, 34, 35, 35, 35, 35, 34, 33, 31, 29, 27, 24, 21, 18, 15, 12, 9, 7, 5, 3, 2, 1, 1, 1, 2, 4, 6, 8, 11, 14 },
+	{ 31, 34, 36, 39, 41, 43, 45, 46, 47, 48, 49, 49, 48, 48, 47, 45, 44, 42, 40, 37, 35, 32, 30, 28, 25, 23, 22, 21, 20, 20, 21, 21, 23, 24, 26, 29, 31 },
+	{ 45, 47, 49, 51, 53, 54, 56, 57, 58, 58, 59, 59, 59, 58, 57, 56, 55, 53, 52, 50, 48, 46, 44, 42, 41, 39, 38, 37, 37, 37, 37, 38, 39, 40, 42, 43, 45 },
+	{ 56, 57, 59, 60, 62, 63, 64, 65, 66, 67, 67, 67, 67, 66, 66, 65, 64, 62, 61, 60, 58, 57, 55, 54, 53, 51, 51, 50, 50, 50, 50, 50, 51, 52, 53, 55, 56 },
+	{ 64, 66, 67, 68, 69, 70, 71, 72, 73, 73, 74, 74, 73, 73, 72, 72, 71, 70, 69, 67, 66, 65, 64, 63, 62, 61, 60, 60, 60, 60, 60, 60, 61, 61, 62, 63, 64 },
+	{ 71, 72, 73, 74, 75, 76, 77, 78, 79, 79, 79, 79, 79, 79, 78, 78, 77, 76, 75, 74, 73, 72, 71, 70, 69, 69, 68, 68, 68, 68, 68, 68, 68, 69, 70, 70, 71 },
+};
+
+/* total field strength in units of 0.01 Gauss; same grid and model as the
+ * inclination table */
+static const int8_t strength_table[13][37] = \
+{
+	{ 57, 56, 56, 55, 54, 54, 53, 53, 52, 52, 52, 52, 52, 52, 53, 53, 53, 54, 55, 55, 56, 57, 57, 58, 58, 59, 59, 59, 59, 59, 59, 59, 59, 58, 58, 57, 57 },
+	{ 53, 52, 51, 50, 50, 49, 48, 48, 47, 47, 47, 47, 47, 47, 48, 48, 49, 49, 50, 51, 52, 52, 53, 54, 55, 55, 56, 56, 56, 56, 56, 56, 55, 55, 54, 54, 53 },
+	{ 48, 47, 46, 45, 44, 44, 43, 42, 42, 42, 42, 41, 42, 42, 42, 43, 43, 44, 45, 46, 47, 47, 48, 49, 50, 51, 51, 51, 52, 52, 52, 51, 51, 50, 50, 49, 48 },
+	{ 43, 42, 41, 40, 39, 38, 38, 37, 37, 37, 36, 36, 37, 37, 37, 38, 38, 39, 40, 40, 41, 42, 43, 44, 45, 45, 46, 46, 46, 46, 46, 46, 46, 45, 44, 43, 43 },
+	{ 37, 37, 36, 35, 35, 34, 34, 33, 33, 33, 33, 33, 33, 33, 33, 33, 34, 34, 35, 36, 36, 37, 38, 39, 39, 40, 40, 41, 41, 41, 41, 41, 40, 40, 39, 38, 37 },
+	{ 33, 33, 32, 32, 32, 32, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 32, 32, 32, 33, 33, 34, 34, 35, 35, 36, 36, 36, 36, 36, 36, 35, 35, 34, 34, 33 },
+	{ 31, 31, 31, 31, 31, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 31, 31, 31, 31, 31, 31, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 31, 31 },
+	{ 32, 32, 33, 33, 34, 34, 35, 35, 36, 36, 36, 36, 36, 36, 35, 35, 34, 34, 33, 33, 32, 32, 32, 32, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 32, 32 },
+	{ 35, 36, 36, 37, 38, 39, 39, 40, 40, 41, 41, 41, 41, 41, 40, 40, 39, 38, 37, 37, 36, 35, 35, 34, 34, 33, 33, 33, 33, 33, 33, 33, 33, 33, 34, 34, 35 },
+	{ 40, 40, 41, 42, 43, 44, 45, 45, 46, 46, 46, 46, 46, 46, 46, 45, 44, 43, 43, 42, 41, 40, 39, 38, 38, 37, 37, 37, 36, 36, 37, 37, 37, 38, 38, 39, 40 },
+	{ 45, 46, 47, 47, 48, 49, 50, 51, 51, 51, 52, 52, 52, 51, 51, 50, 50, 49, 48, 47, 46, 45, 44, 44, 43, 42, 42, 42, 42, 41, 42, 42, 42, 43, 43, 44, 45 },
+	{ 50, 51, 52, 52, 53, 54, 55, 55, 56, 56, 56, 56, 56, 56, 55, 55, 54, 54, 53, 52, 51, 50, 50, 49, 48, 48, 47, 47, 47, 47, 47, 47, 48, 48, 49, 49, 50 },
+	{ 55, 55, 56, 57, 57, 58, 58, 59, 59, 59, 59, 59, 59, 59, 59, 58, 58, 57, 57, 56, 56, 55, 54, 54, 53, 53, 52, 52, 52, 52, 52, 52, 53, 53, 53, 54, 55 },
+};
+
+static float get_table_value(const int8_t table[13][37], float lat, float lon);
 static unsigned get_lookup_table_index(float *val, float min, float max);
 
 unsigned get_lookup_table_index(float *val, float min, float max)
@@ -94,7 +133,7 @@ unsigned get_lookup_table_index(float *val, float min, float max)
 	return (-(min) + *val)  / SAMPLING_RES;
 }
 
-__EXPORT float get_mag_declination(float lat, float lon)
+float get_table_value(const int8_t table[13][37], float lat, float lon)
 {
 	/*
 	 * If the values exceed valid ranges, return zero as default
@@ -114,22 +153,33 @@ __EXPORT float get_mag_declination(float lat, float lon)
 	unsigned min_lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
 	unsigned min_lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
 
-	float declination_sw = get_lookup_table_val(min_lat_index, min_lon_index);
-	float declination_se = get_lookup_table_val(min_lat_index, min_lon_index + 1);
-	float declination_ne = get_lookup_table_val(min_lat_index + 1, min_lon_index + 1);
-	float declination_nw = get_lookup_table_val(min_lat_index + 1, min_lon_index);
+	float value_sw = table[min_lat_index][min_lon_index];
+	float value_se = table[min_lat_index][min_lon_index + 1];
+	float value_ne = table[min_lat_index + 1][min_lon_index + 1];
+	float value_nw = table[min_lat_index + 1][min_lon_index];
 
 	/* perform bilinear interpolation on the four grid corners */
 	float lat_scale = constrain((lat - min_lat) / SAMPLING_RES, 0.0f, 1.0f);
 	float lon_scale = constrain((lon - min_lon) / SAMPLING_RES, 0.0f, 1.0f);
 
-	float declination_min = lon_scale * (declination_se - declination_sw) + declination_sw;
-	float declination_max = lon_scale * (declination_ne - declination_nw) + declination_nw;
+	float value_min = lon_scale * (value_se - value_sw) + value_sw;
+	float value_max = lon_scale * (value_ne - value_nw) + value_nw;
 
-	return lat_scale * (declination_max - declination_min) + declination_min;
+	return lat_scale * (value_max - value_min) + value_min;
+}
+
+__EXPORT float get_mag_declination(float lat, float lon)
+{
+	return get_table_value(declination_table, lat, lon);
+}
+
+__EXPORT float get_mag_inclination(float lat, float lon)
+{
+	return get_table_value(inclination_table, lat, lon);
 }
 
-float get_lookup_table_val(unsigned lat_index, unsigned lon_index)
+__EXPORT float get_mag_strength(float lat, float lon)
 {
-	return declination_table[lat_index][lon_index];
+	/* table is stored in units of 0.01 Gauss */
+	return get_table_value(strength_table, lat, lon) * 0.01f;
 }
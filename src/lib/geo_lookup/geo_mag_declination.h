@@ -34,7 +34,8 @@
 /**
 * @file geo_mag_declination.h
 *
-* Calculation / lookup table for earth magnetic field declination.
+* Calculation / lookup tables for earth magnetic field declination,
+* inclination and strength.
 *
 */
 
@@ -42,6 +43,13 @@
 
 __BEGIN_DECLS
 
+/** declination in degrees, positive East */
 __EXPORT float get_mag_declination(float lat, float lon);
 
+/** inclination (dip angle) in degrees, positive down */
+__EXPORT float get_mag_inclination(float lat, float lon);
+
+/** total field strength in Gauss */
+__EXPORT float get_mag_strength(float lat, float lon);
+
 __END_DECLS
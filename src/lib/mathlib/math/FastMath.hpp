@@ -0,0 +1,198 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file FastMath.hpp
+ *
+ * Fast single-precision transcendental approximations for control math.
+ *
+ * libm sinf/cosf/atan2f go through full argument reduction and error
+ * handling; at the rates the controllers call them they show up in cycle
+ * profiles. The functions here trade bounded accuracy for a short,
+ * branch-light polynomial evaluation:
+ *
+ *     fast_sinf / fast_cosf / fast_sincosf   error < 1e-5 for |x| <= 50 rad
+ *     fast_atan2f                            error < 1e-5 rad
+ *     fast_asinf                             error < 1e-4 rad near |x| = 1
+ *
+ * The sin/cos bound degrades slowly beyond that range: the single-precision
+ * argument reduction loses about k*2pi*2^-24 per wrapped period k (~5.6e-5
+ * at |x| = 1000). Body angles and setpoint rotations stay well within
+ * +/-50 rad; wrap the argument first if yours may not.
+ *
+ * The bounds are verified against libm by the 'tests fast_math' sweep, which
+ * also reports the per-call latency of both implementations. Use these only
+ * where the error bound is acceptable (body angles, setpoint rotations) -
+ * never for geodetic projections, which need double precision.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+namespace math
+{
+
+static constexpr float FM_PI = 3.14159265359f;
+static constexpr float FM_HALF_PI = 1.57079632679f;
+
+namespace detail
+{
+
+/* sin core polynomial, |x| <= pi/2, max error ~3.6e-6 */
+inline float sin_core(float x)
+{
+	const float s = x * x;
+	return x * (1.0f + s * (-1.6666666667e-1f + s * (8.3333333333e-3f
+			   + s * (-1.9841269841e-4f + s * 2.7557319224e-6f))));
+}
+
+/* cos core polynomial, |x| <= pi/2, max error ~4.7e-7 */
+inline float cos_core(float x)
+{
+	const float s = x * x;
+	return 1.0f + s * (-0.5f + s * (4.1666666667e-2f + s * (-1.3888888889e-3f
+			   + s * (2.4801587302e-5f + s * -2.7557319224e-7f))));
+}
+
+/* atan minimax polynomial, |z| <= 1, max error ~1.7e-6 */
+inline float atan_core(float z)
+{
+	const float s = z * z;
+	return z * (0.99997726f + s * (-0.33262347f + s * (0.19354346f
+			   + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+}
+
+/* wrap an arbitrary angle into [-pi, pi] */
+inline float reduce_pi(float x)
+{
+	const float k = (float)(int32_t)(x * 0.15915494309f + (x >= 0.0f ? 0.5f : -0.5f));
+	return x - k * 6.28318530718f;
+}
+
+} /* namespace detail */
+
+/**
+ * sine approximation, within the documented bound for |x| <= 50 rad
+ */
+inline float fast_sinf(float x)
+{
+	float xr = detail::reduce_pi(x);
+
+	if (xr > FM_HALF_PI) {
+		xr = FM_PI - xr;
+
+	} else if (xr < -FM_HALF_PI) {
+		xr = -FM_PI - xr;
+	}
+
+	return detail::sin_core(xr);
+}
+
+/**
+ * cosine approximation, within the documented bound for |x| <= 50 rad
+ */
+inline float fast_cosf(float x)
+{
+	return fast_sinf(x + FM_HALF_PI);
+}
+
+/**
+ * sine and cosine of the same angle with a single argument reduction
+ */
+inline void fast_sincosf(float x, float &sin_out, float &cos_out)
+{
+	float xr = detail::reduce_pi(x);
+	float cos_sign = 1.0f;
+
+	if (xr > FM_HALF_PI) {
+		xr = FM_PI - xr;
+		cos_sign = -1.0f;
+
+	} else if (xr < -FM_HALF_PI) {
+		xr = -FM_PI - xr;
+		cos_sign = -1.0f;
+	}
+
+	sin_out = detail::sin_core(xr);
+	cos_out = cos_sign * detail::cos_core(xr);
+}
+
+/**
+ * four-quadrant arctangent; a single division brings the ratio into the
+ * polynomial's [-1, 1] domain
+ */
+inline float fast_atan2f(float y, float x)
+{
+	const float abs_y = fabsf(y);
+	const float abs_x = fabsf(x);
+
+	if (abs_x < 1e-30f && abs_y < 1e-30f) {
+		return 0.0f;
+	}
+
+	float angle;
+
+	if (abs_x >= abs_y) {
+		angle = detail::atan_core(y / x);
+
+		if (x < 0.0f) {
+			angle += (y >= 0.0f) ? FM_PI : -FM_PI;
+		}
+
+	} else {
+		angle = ((y >= 0.0f) ? FM_HALF_PI : -FM_HALF_PI) - detail::atan_core(x / y);
+	}
+
+	return angle;
+}
+
+/**
+ * arcsine approximation; the input is clamped to [-1, 1] so slightly
+ * denormalized unit vector components stay safe
+ */
+inline float fast_asinf(float x)
+{
+	if (x >= 1.0f) {
+		return FM_HALF_PI;
+	}
+
+	if (x <= -1.0f) {
+		return -FM_HALF_PI;
+	}
+
+	return fast_atan2f(x, sqrtf((1.0f - x) * (1.0f + x)));
+}
+
+} /* namespace math */
@@ -64,8 +64,9 @@ class __EXPORT MatrixBase
 public:
 	/**
 	 * matrix data[row][col]
+	 * 16-byte alignment lets the compiler use aligned vector loads/stores
 	 */
-	float data[M][N];
+	float data[M][N] __attribute__((aligned(16)));
 
 	/**
 	 * struct for using arm_math functions
@@ -490,6 +491,23 @@ public:
 		return res;
 	}
 
+	/**
+	 * multiplication by another 3x3 matrix, unrolled to keep the hot
+	 * estimator paths free of the generic helper's loops and copies
+	 */
+	Matrix<3, 3> operator *(const Matrix<3, 3> &m) const
+	{
+		Matrix<3, 3> res;
+
+		for (unsigned int i = 0; i < 3; i++) {
+			res.data[i][0] = data[i][0] * m.data[0][0] + data[i][1] * m.data[1][0] + data[i][2] * m.data[2][0];
+			res.data[i][1] = data[i][0] * m.data[0][1] + data[i][1] * m.data[1][1] + data[i][2] * m.data[2][1];
+			res.data[i][2] = data[i][0] * m.data[0][2] + data[i][1] * m.data[1][2] + data[i][2] * m.data[2][2];
+		}
+
+		return res;
+	}
+
 	/**
 	 * create a rotation matrix from given euler angles
 	 * based on http://gentlenav.googlecode.com/files/EulerAngles.pdf
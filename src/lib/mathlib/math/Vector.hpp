@@ -63,8 +63,9 @@ class __EXPORT VectorBase
 public:
 	/**
 	 * vector data
+	 * 16-byte alignment lets the compiler use aligned vector loads/stores
 	 */
-	float data[N];
+	float data[N] __attribute__((aligned(16)));
 
 	/**
 	 * struct for using arm_math functions, represents column vector
@@ -332,6 +333,26 @@ public:
 		return res;
 	}
 
+	/**
+	 * add a scaled vector: *this += v * num, without a temporary
+	 *
+	 * Written as one multiply-add per element over restrict-qualified
+	 * pointers, so the compiler can vectorize it and contract it to fused
+	 * multiply-add instructions where available. v must not alias this
+	 * vector.
+	 */
+	const Vector<N> &add_scaled(const Vector<N> &v, const float num)
+	{
+		const float *__restrict src = v.data;
+		float *__restrict dst = data;
+
+		for (unsigned int i = 0; i < N; i++) {
+			dst[i] += src[i] * num;
+		}
+
+		return *static_cast<const Vector<N>*>(this);
+	}
+
 	/**
 	 * gets the length of this vector squared
 	 */
@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file BiquadFilterBank3.cpp
+ *
+ * Coefficient computation for the three-axis biquad section.
+ */
+
+#include <px4_defines.h>
+#include "BiquadFilterBank3.hpp"
+#include <cmath>
+
+namespace math
+{
+
+void BiquadFilterBank3::set_lowpass(float sample_freq, float cutoff_freq)
+{
+	if (cutoff_freq <= 0.0f || sample_freq <= 0.0f) {
+		disable();
+		return;
+	}
+
+	/* same design as LowPassFilter2p */
+	float fr = sample_freq / cutoff_freq;
+	float ohm = tanf(M_PI_F / fr);
+	float c = 1.0f + 2.0f * cosf(M_PI_F / 4.0f) * ohm + ohm * ohm;
+
+	_b0 = ohm * ohm / c;
+	_b1 = 2.0f * _b0;
+	_b2 = _b0;
+	_a1 = 2.0f * (ohm * ohm - 1.0f) / c;
+	_a2 = (1.0f - 2.0f * cosf(M_PI_F / 4.0f) * ohm + ohm * ohm) / c;
+
+	_enabled = true;
+	reset();
+}
+
+void BiquadFilterBank3::set_notch(float sample_freq, float notch_freq, float bandwidth)
+{
+	if (notch_freq <= 0.0f || bandwidth <= 0.0f || sample_freq <= 0.0f
+	    || notch_freq >= sample_freq / 2.0f) {
+		disable();
+		return;
+	}
+
+	float omega = 2.0f * M_PI_F * notch_freq / sample_freq;
+	float alpha = sinf(omega) * sinhf(logf(2.0f) / 2.0f * (bandwidth / notch_freq) * omega / sinf(omega));
+	float c = 1.0f + alpha;
+
+	_b0 = 1.0f / c;
+	_b1 = -2.0f * cosf(omega) / c;
+	_b2 = _b0;
+	_a1 = _b1;
+	_a2 = (1.0f - alpha) / c;
+
+	_enabled = true;
+	reset();
+}
+
+void BiquadFilterBank3::reset(const float sample[3])
+{
+	for (unsigned i = 0; i < 3; i++) {
+		if (sample != nullptr && _enabled) {
+			/* settle to the steady state response for this input */
+			float dval = sample[i] / (_b0 + _b1 + _b2);
+			_delay_element_1[i] = dval;
+			_delay_element_2[i] = dval;
+
+		} else {
+			_delay_element_1[i] = 0.0f;
+			_delay_element_2[i] = 0.0f;
+		}
+	}
+}
+
+} // namespace math
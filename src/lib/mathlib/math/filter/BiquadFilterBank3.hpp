@@ -0,0 +1,122 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file BiquadFilterBank3.hpp
+ *
+ * One biquad section applied across three axes in a single pass. The
+ * coefficients are shared between the axes and only the delay elements
+ * are kept per axis, so one coefficient load serves all three
+ * evaluations and the per-axis loop is a candidate for vectorization
+ * on targets that support it.
+ *
+ * Supports second order low-pass (same response as LowPassFilter2p)
+ * and notch configurations.
+ */
+
+#pragma once
+
+namespace math
+{
+class __EXPORT BiquadFilterBank3
+{
+public:
+	BiquadFilterBank3()
+	{
+		disable();
+	}
+
+	/**
+	 * Configure as a second order Butterworth low-pass.
+	 *
+	 * @param sample_freq	Sample frequency in Hz.
+	 * @param cutoff_freq	Cutoff frequency in Hz, <= 0 disables.
+	 */
+	void set_lowpass(float sample_freq, float cutoff_freq);
+
+	/**
+	 * Configure as a notch.
+	 *
+	 * @param sample_freq	Sample frequency in Hz.
+	 * @param notch_freq	Center frequency in Hz, <= 0 disables.
+	 * @param bandwidth	-3 dB bandwidth in Hz.
+	 */
+	void set_notch(float sample_freq, float notch_freq, float bandwidth);
+
+	/**
+	 * Make the filter a pass-through.
+	 */
+	void disable()
+	{
+		_enabled = false;
+		reset();
+	}
+
+	bool enabled() const { return _enabled; }
+
+	/**
+	 * Filter one three-axis sample in place.
+	 */
+	void apply(float sample[3])
+	{
+		if (!_enabled) {
+			return;
+		}
+
+		for (unsigned i = 0; i < 3; i++) {
+			float delay_element_0 = sample[i] - _delay_element_1[i] * _a1 - _delay_element_2[i] * _a2;
+
+			sample[i] = delay_element_0 * _b0 + _delay_element_1[i] * _b1 + _delay_element_2[i] * _b2;
+
+			_delay_element_2[i] = _delay_element_1[i];
+			_delay_element_1[i] = delay_element_0;
+		}
+	}
+
+	/**
+	 * Reset the delay elements (to a steady state when given a sample).
+	 */
+	void reset(const float sample[3] = nullptr);
+
+private:
+	bool		_enabled;
+	float		_a1;
+	float		_a2;
+	float		_b0;
+	float		_b1;
+	float		_b2;
+	float		_delay_element_1[3];	// buffered samples -1, per axis
+	float		_delay_element_2[3];	// buffered samples -2, per axis
+};
+
+} // namespace math
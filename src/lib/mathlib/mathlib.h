@@ -46,6 +46,7 @@
 #include "math/Quaternion.hpp"
 #include "math/Limits.hpp"
 #include "math/Functions.hpp"
+#include "math/FastMath.hpp"
 #include "math/matrix_alg.h"
 
 #endif
@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file MedianFilter.hpp
+ *
+ * Median/spike prefilter with output decimation, shared by the range finder
+ * drivers so that spike rejection happens once in the driver instead of
+ * redundantly in every consumer (SENS_RNG_FILT / SENS_RNG_DECIM).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <systemlib/param/param.h>
+
+namespace rangefinder
+{
+
+class MedianFilter
+{
+public:
+	static constexpr uint8_t MAX_WINDOW = 7;
+
+	/**
+	 * Configure the filter.
+	 * @param window median window size in samples (0 or 1 disables filtering,
+	 *               even values are rounded up, clipped to MAX_WINDOW)
+	 * @param decimation output every n-th sample (0 or 1 outputs every sample)
+	 */
+	void configure(uint8_t window, uint8_t decimation)
+	{
+		if (window > MAX_WINDOW) {
+			window = MAX_WINDOW;
+		}
+
+		if (window > 1 && (window & 1) == 0) {
+			window++;
+		}
+
+		_window = window > 1 ? window : 1;
+		_decimation = decimation > 1 ? decimation : 1;
+		reset();
+	}
+
+	/** configure from the shared SENS_RNG_FILT / SENS_RNG_DECIM parameters */
+	void configure_from_params()
+	{
+		int32_t window = 0;
+		int32_t decimation = 1;
+
+		param_t handle = param_find("SENS_RNG_FILT");
+
+		if (handle != PARAM_INVALID) {
+			param_get(handle, &window);
+		}
+
+		handle = param_find("SENS_RNG_DECIM");
+
+		if (handle != PARAM_INVALID) {
+			param_get(handle, &decimation);
+		}
+
+		configure(window, decimation);
+	}
+
+	void reset()
+	{
+		_head = 0;
+		_count = 0;
+		_since_output = 0;
+	}
+
+	/**
+	 * Feed one sample.
+	 * @param sample new raw measurement
+	 * @param out set to the median of the current window when an output is due
+	 * @return true when out is valid (every sample in pass-through mode)
+	 */
+	bool update(float sample, float &out)
+	{
+		if (_window <= 1 && _decimation <= 1) {
+			out = sample;
+			return true;
+		}
+
+		_samples[_head] = sample;
+		_head = (_head + 1) % _window;
+
+		if (_count < _window) {
+			_count++;
+		}
+
+		if (++_since_output < _decimation) {
+			return false;
+		}
+
+		_since_output = 0;
+
+		/* insertion sort of the (small) window copy */
+		float sorted[MAX_WINDOW];
+
+		for (uint8_t i = 0; i < _count; i++) {
+			float v = _samples[i];
+			int8_t j = i - 1;
+
+			for (; j >= 0 && sorted[j] > v; j--) {
+				sorted[j + 1] = sorted[j];
+			}
+
+			sorted[j + 1] = v;
+		}
+
+		out = sorted[_count / 2];
+		return true;
+	}
+
+private:
+	float _samples[MAX_WINDOW];
+	uint8_t _window{1};
+	uint8_t _decimation{1};
+	uint8_t _head{0};
+	uint8_t _count{0};
+	uint8_t _since_output{0};
+};
+
+}
@@ -61,6 +61,9 @@
 
 // #define DSM_DEBUG
 
+/* one byte on the wire: 1 start + 8 data + 1 stop bit at 115200 baud */
+#define DSM_BYTE_TIME_US	87
+
 static enum DSM_DECODE_STATE {
 	DSM_DECODE_STATE_DESYNC = 0,
 	DSM_DECODE_STATE_SYNC
@@ -613,6 +616,10 @@ dsm_parse(const uint64_t now, const uint8_t *frame, const unsigned len, uint16_t
 	/* keep decoding until we have consumed the buffer */
 	for (unsigned d = 0; d < len; d++) {
 
+		/* reconstruct the arrival time of this byte from its offset in
+		 * the batch: with chunked reads 'now' only dates the last byte */
+		uint64_t byte_time = now - (len - 1 - d) * DSM_BYTE_TIME_US;
+
 		/* overflow check */
 		if (dsm_partial_frame_count == sizeof(dsm_frame) / sizeof(dsm_frame[0])) {
 			dsm_partial_frame_count = 0;
@@ -644,7 +651,7 @@ dsm_parse(const uint64_t now, const uint8_t *frame, const unsigned len, uint16_t
 		case DSM_DECODE_STATE_DESYNC:
 
 			/* we are de-synced and only interested in the frame marker */
-			if ((now - dsm_last_rx_time) > 5000) {
+			if ((byte_time - dsm_last_rx_time) > 5000) {
 				dsm_decode_state = DSM_DECODE_STATE_SYNC;
 				dsm_partial_frame_count = 0;
 				dsm_chan_count = 0;
@@ -665,7 +672,7 @@ dsm_parse(const uint64_t now, const uint8_t *frame, const unsigned len, uint16_t
 				 * Great, it looks like we might have a frame.  Go ahead and
 				 * decode it.
 				 */
-				decode_ret = dsm_decode(now, &dsm_chan_buf[0], &dsm_chan_count, dsm_11_bit, max_channels);
+				decode_ret = dsm_decode(byte_time, &dsm_chan_buf[0], &dsm_chan_count, dsm_11_bit, max_channels);
 
 				/* we consumed the partial frame, reset */
 				dsm_partial_frame_count = 0;
@@ -31,6 +31,7 @@ private:
 	bool dsmTest10Ch();
 	bool dsmTest12Ch();
 	bool sbus2Test();
+	bool sbusBenchmark();
 	bool st24Test();
 	bool sumdTest();
 };
@@ -40,6 +41,7 @@ bool RCTest::run_tests()
 	ut_run_test(dsmTest10Ch);
 	ut_run_test(dsmTest12Ch);
 	ut_run_test(sbus2Test);
+	ut_run_test(sbusBenchmark);
 	ut_run_test(st24Test);
 	ut_run_test(sumdTest);
 
@@ -212,6 +214,55 @@ bool RCTest::sbus2Test()
 	return true;
 }
 
+bool RCTest::sbusBenchmark()
+{
+	// four back-to-back SBUS1 frames with plausible channel content
+	uint8_t frame[SBUS_FRAME_SIZE * 4];
+
+	for (unsigned f = 0; f < 4; f++) {
+		uint8_t *b = &frame[f * SBUS_FRAME_SIZE];
+		b[0] = 0x0f; // start symbol
+
+		for (unsigned i = 1; i < SBUS_FRAME_SIZE - 2; i++) {
+			b[i] = (uint8_t)(0x55 + i);
+		}
+
+		b[SBUS_FRAME_SIZE - 2] = 0; // flags
+		b[SBUS_FRAME_SIZE - 1] = 0; // SBUS1 end byte
+	}
+
+	uint16_t rc_values[18];
+	uint16_t num_values;
+	bool sbus_failsafe;
+	bool sbus_frame_drop;
+	unsigned frame_drops = 0;
+	unsigned decoded = 0;
+
+	const unsigned iterations = 1000;
+
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		if (sbus_parse(hrt_absolute_time(), &frame[0], sizeof(frame), rc_values, &num_values,
+			       &sbus_failsafe, &sbus_frame_drop, &frame_drops,
+			       sizeof(rc_values) / sizeof(rc_values[0]))) {
+			decoded++;
+		}
+	}
+
+	hrt_abstime elapsed = hrt_absolute_time() - start;
+	unsigned bytes = iterations * sizeof(frame);
+
+	printf("sbus decode: %u bytes in %llu us, %.1f ns/byte, %.2f us/frame\n",
+	       bytes, (unsigned long long)elapsed,
+	       (double)(1000.0f * elapsed / bytes),
+	       (double)((float)elapsed / (iterations * 4)));
+
+	ut_assert_true(decoded > 0);
+
+	return true;
+}
+
 bool RCTest::st24Test()
 {
 	const char *filepath = TEST_DATA_PATH "st24_data.txt";
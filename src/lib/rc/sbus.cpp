@@ -76,7 +76,8 @@
 // this is the rate of the old code
 #define SBUS1_DEFAULT_RATE_HZ	72
 
-#define SBUS_SINGLE_CHAR_LEN_US		(1/((100000/10)) * 1000 * 1000)
+/* one byte on the wire: 1 start + 8 data + parity + 2 stop bits at 100000 baud */
+#define SBUS_BYTE_TIME_US	120
 
 #define SBUS_FRAME_INTERVAL_US	2500
 #define SBUS_MIN_CALL_INTERVAL_US	(SBUS_FRAME_GAP_US / 3)
@@ -307,26 +308,36 @@ sbus_input(int sbus_fd, uint16_t *values, uint16_t *num_values, bool *sbus_fails
 	now = hrt_absolute_time();
 
 	/*
-	 * Fetch bytes, but no more than we would need to complete
-	 * a complete frame.
+	 * Fetch all bytes that have accumulated in the UART receive buffer
+	 * (a DMA ring on the io board) since the last tick and run them
+	 * through the parser in bulk. Draining the buffer keeps us frame
+	 * synchronized when a tick was delayed and more than one frame is
+	 * pending.
 	 */
 	uint8_t buf[SBUS_FRAME_SIZE * 2];
 	bool sbus_decoded = false;
 
-	ret = read(sbus_fd, &buf[0], SBUS_FRAME_SIZE);
+	for (;;) {
+		ret = read(sbus_fd, &buf[0], sizeof(buf));
 
-	/* if the read failed for any reason, just give up here */
-	if (ret < 1) {
-		return false;
-	}
+		/* if the read failed for any reason, just give up here */
+		if (ret < 1) {
+			break;
+		}
 
-	/*
-	 * Try to decode something with what we got
-	 */
-	if (sbus_parse(now, &buf[0], ret, values, num_values, sbus_failsafe,
-		       sbus_frame_drop, &sbus_frame_drops, max_channels)) {
+		/*
+		 * Try to decode something with what we got
+		 */
+		if (sbus_parse(now, &buf[0], ret, values, num_values, sbus_failsafe,
+			       sbus_frame_drop, &sbus_frame_drops, max_channels)) {
 
-		sbus_decoded = true;
+			sbus_decoded = true;
+		}
+
+		/* all pending bytes fetched */
+		if (ret < (int)sizeof(buf)) {
+			break;
+		}
 	}
 
 	return sbus_decoded;
@@ -347,6 +358,12 @@ sbus_parse(uint64_t now, uint8_t *frame, unsigned len, uint16_t *values,
 	/* keep decoding until we have consumed the buffer */
 	for (unsigned d = 0; d < len; d++) {
 
+		/* reconstruct the arrival time of this byte from its offset in
+		 * the batch: with chunked reads 'now' only dates the last byte,
+		 * and a frame timestamp off by a batch worth of bytes skews any
+		 * RC latency measurement downstream */
+		uint64_t byte_time = now - (len - 1 - d) * SBUS_BYTE_TIME_US;
+
 		/* overflow check */
 		if (partial_frame_count == sizeof(sbus_frame) / sizeof(sbus_frame[0])) {
 			partial_frame_count = 0;
@@ -405,7 +422,7 @@ sbus_parse(uint64_t now, uint8_t *frame, unsigned len, uint16_t *values,
 				 * Great, it looks like we might have a frame.  Go ahead and
 				 * decode it.
 				 */
-				decode_ret = sbus_decode(now, sbus_frame, values, num_values, sbus_failsafe, sbus_frame_drop, max_channels);
+				decode_ret = sbus_decode(byte_time, sbus_frame, values, num_values, sbus_failsafe, sbus_frame_drop, max_channels);
 
 				/*
 				 * Offset recovery: If decoding failed, check if there is a second
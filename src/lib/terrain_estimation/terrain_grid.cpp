@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file terrain_grid.cpp
+ */
+
+#include "terrain_grid.h"
+
+#include <string.h>
+#include <math.h>
+
+TerrainGrid::TerrainGrid()
+{
+	memset(_tiles, 0, sizeof(_tiles));
+}
+
+bool TerrainGrid::is_distance_valid(const struct distance_sensor_s *distance) const
+{
+	return (distance->current_distance > distance->min_distance
+		&& distance->current_distance < distance->max_distance);
+}
+
+void TerrainGrid::update(uint64_t time_now, const struct vehicle_attitude_s *attitude,
+			 const struct vehicle_local_position_s *local_pos,
+			 const struct distance_sensor_s *distance)
+{
+	if (distance->timestamp <= _time_last_distance) {
+		return;
+	}
+
+	_time_last_distance = distance->timestamp;
+
+	if (!is_distance_valid(distance) || !local_pos->z_valid) {
+		return;
+	}
+
+	matrix::Quatf q(attitude->q);
+	matrix::Eulerf euler(q);
+
+	/* reject measurements at large tilt angles, the sensor no longer points at
+	 * the tile below the vehicle */
+	if (fabsf(euler.phi()) > 0.5f || fabsf(euler.theta()) > 0.5f) {
+		return;
+	}
+
+	/* distance to ground and resulting terrain level in local NED */
+	float dist_ground = distance->current_distance * cosf(euler.phi()) * cosf(euler.theta());
+	float meas_z = local_pos->z + dist_ground;
+
+	int32_t ix = (int32_t)floorf(local_pos->x / TILE_SIZE);
+	int32_t iy = (int32_t)floorf(local_pos->y / TILE_SIZE);
+
+	Tile &tile = _tiles[slot(ix, iy)];
+
+	if (!tile.used || tile.ix != ix || tile.iy != iy) {
+		/* unused slot, or recycle the tile of a region the vehicle left */
+		tile.ix = ix;
+		tile.iy = iy;
+		tile.z = meas_z;
+		tile.var = INITIAL_VAR;
+		tile.time_last = time_now;
+		tile.used = true;
+	}
+
+	/* inflate the variance with the elapsed time, terrain appears to drift
+	 * as position and attitude errors accumulate */
+	tile.var += PROCESS_VAR * (time_now - tile.time_last) / 1e6f;
+	tile.time_last = time_now;
+
+	/* single-state Kalman update */
+	float gain = tile.var / (tile.var + MEAS_VAR);
+	tile.z += gain * (meas_z - tile.z);
+	tile.var *= (1.0f - gain);
+}
+
+bool TerrainGrid::get_grid(const struct vehicle_local_position_s *local_pos, struct terrain_grid_s *grid) const
+{
+	int32_t ix0 = (int32_t)floorf(local_pos->x / TILE_SIZE) - GRID_DIM / 2;
+	int32_t iy0 = (int32_t)floorf(local_pos->y / TILE_SIZE) - GRID_DIM / 2;
+
+	grid->tile_size = TILE_SIZE;
+	grid->origin_x = ix0 * TILE_SIZE;
+	grid->origin_y = iy0 * TILE_SIZE;
+
+	bool any_valid = false;
+
+	for (int i = 0; i < GRID_DIM; i++) {
+		for (int j = 0; j < GRID_DIM; j++) {
+			const Tile &tile = _tiles[slot(ix0 + i, iy0 + j)];
+			unsigned idx = i * GRID_DIM + j;
+
+			if (tile.used && tile.ix == ix0 + i && tile.iy == iy0 + j) {
+				grid->terrain_z[idx] = tile.z;
+				grid->variance[idx] = tile.var;
+				any_valid = true;
+
+			} else {
+				grid->terrain_z[idx] = NAN;
+				grid->variance[idx] = 0.0f;
+			}
+		}
+	}
+
+	return any_valid;
+}
@@ -0,0 +1,108 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file terrain_grid.h
+ */
+
+#include <lib/mathlib/mathlib.h>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_local_position.h>
+#include <uORB/topics/distance_sensor.h>
+#include <uORB/topics/terrain_grid.h>
+
+/*
+* Rolling grid of terrain level estimates around the vehicle, built from
+* downward-facing distance sensor data.
+*
+* The local NE plane is divided into square tiles. Each distance measurement
+* updates a single-state Kalman filter in the tile below the vehicle, so the
+* per-measurement cost is O(1). The tiles live in a fixed, direct-mapped pool
+* the size of the published window: when the vehicle moves into a new region,
+* the tile that previously occupied a pool slot is recycled, keeping the
+* memory use constant. get_grid(...) fills a terrain_grid report with the
+* window centered on the vehicle; unknown tiles are reported as NaN.
+*/
+
+class __EXPORT TerrainGrid
+{
+public:
+	TerrainGrid();
+	~TerrainGrid() = default;
+
+	/**
+	 * Ingest one distance sensor measurement. Repeated calls with the same
+	 * measurement are ignored, so this can be called on every loop iteration.
+	 */
+	void update(uint64_t time_now, const struct vehicle_attitude_s *attitude,
+		    const struct vehicle_local_position_s *local_pos,
+		    const struct distance_sensor_s *distance);
+
+	/**
+	 * Fill a terrain_grid report with the tile window centered on the vehicle.
+	 * @return true if at least one tile in the window holds a valid estimate
+	 */
+	bool get_grid(const struct vehicle_local_position_s *local_pos, struct terrain_grid_s *grid) const;
+
+private:
+	static constexpr int GRID_DIM = terrain_grid_s::GRID_DIM;
+	static constexpr float TILE_SIZE = 5.0f;
+
+	/* noise configuration of the per-tile filters */
+	static constexpr float MEAS_VAR = 0.16f;	///< distance measurement variance [m^2]
+	static constexpr float PROCESS_VAR = 0.01f;	///< terrain level drift [m^2/s]
+	static constexpr float INITIAL_VAR = 100.0f;
+
+	struct Tile {
+		int32_t		ix;		///< tile index, floor(x / TILE_SIZE)
+		int32_t		iy;
+		float		z;		///< terrain level estimate, local NED z [m]
+		float		var;		///< estimate variance [m^2]
+		uint64_t	time_last;	///< time of the last update [us]
+		bool		used;
+	};
+
+	/**
+	 * Pool slot of a tile index pair (direct-mapped: each slot serves all
+	 * tiles that are GRID_DIM apart, which never appear in one window).
+	 */
+	static unsigned slot(int32_t ix, int32_t iy)
+	{
+		return (unsigned)(ix & (GRID_DIM - 1)) * GRID_DIM + (unsigned)(iy & (GRID_DIM - 1));
+	}
+
+	bool is_distance_valid(const struct distance_sensor_s *distance) const;
+
+	Tile		_tiles[GRID_DIM * GRID_DIM];
+	uint64_t	_time_last_distance{0};
+};
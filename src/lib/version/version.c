@@ -198,7 +198,17 @@ static uint32_t version_tag_to_number(const char *tag)
 
 uint32_t px4_firmware_version(void)
 {
-	return version_tag_to_number(PX4_GIT_TAG_STR);
+	/* the tag is fixed at build time: parse it once instead of on
+	 * every query (mavlink, logger and commander all ask during boot) */
+	static uint32_t version = 0;
+	static bool parsed = false;
+
+	if (!parsed) {
+		version = version_tag_to_number(PX4_GIT_TAG_STR);
+		parsed = true;
+	}
+
+	return version;
 }
 
 const char *px4_firmware_git_branch(void)
@@ -217,8 +227,18 @@ uint32_t px4_board_version(void)
 
 uint32_t px4_os_version(void)
 {
+	/* like the firmware version, this cannot change at runtime */
+	static uint32_t version = 0;
+	static bool parsed = false;
+
+	if (parsed) {
+		return version;
+	}
+
+	parsed = true;
+
 #if defined(__PX4_DARWIN)
-	return 0; //TODO: implement version for Darwin
+	version = 0; //TODO: implement version for Darwin
 #elif defined(__PX4_LINUX)
 	struct utsname name;
 
@@ -231,19 +251,21 @@ uint32_t px4_os_version(void)
 		}
 
 		*c = 0;
-		return version_tag_to_number(name.release);
+		version = version_tag_to_number(name.release);
 
 	} else {
-		return 0;
+		version = 0;
 	}
 
 #elif defined(__PX4_QURT)
-	return 0; //TODO: implement version for QuRT
+	version = 0; //TODO: implement version for QuRT
 #elif defined(__PX4_NUTTX)
-	return version_tag_to_number(NUTTX_GIT_TAG_STR);
+	version = version_tag_to_number(NUTTX_GIT_TAG_STR);
 #else
 # error "px4_os_version not implemented for current OS"
 #endif
+
+	return version;
 }
 
 const char *px4_os_version_string(void)
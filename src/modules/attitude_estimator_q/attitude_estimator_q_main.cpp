@@ -146,6 +146,9 @@ private:
 	float		_w_ext_hdg = 0.0f;
 	float		_w_gyro_bias = 0.0f;
 	float		_mag_decl = 0.0f;
+	float		_mag_decl_sin = 0.0f;		/**< cached declination rotation, updated on declination change only */
+	float		_mag_decl_cos = 1.0f;
+	float		_mag_decl_cached = 0.0f;	/**< declination the cached rotation was computed for */
 	bool		_mag_decl_auto = false;
 	bool		_acc_comp = false;
 	float		_bias_max = 0.0f;
@@ -168,6 +171,8 @@ private:
 	Vector<3>	_rates;
 	Vector<3>	_gyro_bias;
 
+	uint8_t		_q_norm_steps = 0;		/**< update steps since the last full normalization */
+
 	vehicle_global_position_s _gpos = {};
 	Vector<3>	_vel_prev;
 	Vector<3>	_pos_acc;
@@ -669,7 +674,10 @@ bool AttitudeEstimatorQ::update(float dt)
 		// Magnetometer correction
 		// Project mag field vector to global frame and extract XY component
 		Vector<3> mag_earth = _q.conjugate(_mag);
-		float mag_err = _wrap_pi(atan2f(mag_earth(1), mag_earth(0)) - _mag_decl);
+		// rotate the projected field by the cached declination rotation instead of
+		// wrapping the angle difference (the sin/cos only change with the declination)
+		float mag_err = atan2f(mag_earth(1) * _mag_decl_cos - mag_earth(0) * _mag_decl_sin,
+				       mag_earth(0) * _mag_decl_cos + mag_earth(1) * _mag_decl_sin);
 		float gainMult = 1.0f;
 		const float fifty_dps = 0.873f;
 
@@ -681,7 +689,14 @@ bool AttitudeEstimatorQ::update(float dt)
 		corr += _q.conjugate_inversed(Vector<3>(0.0f, 0.0f, -mag_err)) * _w_mag * gainMult;
 	}
 
-	_q.normalize();
+	// Deferred normalization: one first-order integration step changes the norm
+	// only by O((w*dt)^2) and the step below keeps the error second-order, so a
+	// full normalization (sqrt and division) is only needed once the accumulated
+	// error exceeds the bound or after a fixed number of steps
+	if (fabsf(_q.length_squared() - 1.0f) > 1e-4f || ++_q_norm_steps >= 25) {
+		_q.normalize();
+		_q_norm_steps = 0;
+	}
 
 
 	// Accelerometer correction
@@ -698,7 +713,7 @@ bool AttitudeEstimatorQ::update(float dt)
 
 	// Gyro bias estimation
 	if (spinRate < 0.175f) {
-		_gyro_bias += corr * (_w_gyro_bias * dt);
+		_gyro_bias.add_scaled(corr, _w_gyro_bias * dt);
 
 		for (int i = 0; i < 3; i++) {
 			_gyro_bias(i) = math::constrain(_gyro_bias(i), -_bias_max, _bias_max);
@@ -712,10 +727,11 @@ bool AttitudeEstimatorQ::update(float dt)
 	corr += _rates;
 
 	// Apply correction to state
-	_q += _q.derivative(corr) * dt;
+	_q.add_scaled(_q.derivative(corr), dt);
 
-	// Normalize quaternion
-	_q.normalize();
+	// First-order norm correction (no sqrt), keeps the error second-order
+	// until the bounded full normalization above triggers
+	_q *= (3.0f - _q.length_squared()) / 2.0f;
 
 	if (!(PX4_ISFINITE(_q(0)) && PX4_ISFINITE(_q(1)) &&
 	      PX4_ISFINITE(_q(2)) && PX4_ISFINITE(_q(3)))) {
@@ -742,6 +758,13 @@ void AttitudeEstimatorQ::update_mag_declination(float new_declination)
 		_q = decl_rotation * _q;
 		_mag_decl = new_declination;
 	}
+
+	if (fabsf(_mag_decl - _mag_decl_cached) > 0.0001f) {
+		// refresh the cached rotation used for the mag heading correction
+		_mag_decl_sin = sinf(_mag_decl);
+		_mag_decl_cos = cosf(_mag_decl);
+		_mag_decl_cached = _mag_decl;
+	}
 }
 
 int attitude_estimator_q_main(int argc, char *argv[])
@@ -78,6 +78,26 @@ using namespace DriverFramework;
 namespace Commander
 {
 
+/* Results of the static checks - sensor presence and calibration parameters -
+ * are cached between arming attempts: they only change on a parameter update
+ * or when the sensor topology changes, while re-running them costs param reads
+ * and sensor ioctls every time. Only passing results are cached, so failing
+ * checks keep re-running (and reporting). The dynamic checks (IMU consistency,
+ * airspeed, GNSS, EKF) always run. */
+struct static_check_cache_s {
+	bool mag_ok = false;
+	bool accel_ok = false;
+	bool gyro_ok = false;
+	bool baro_ok = false;
+	bool rc_ok = false;
+};
+static static_check_cache_s _static_check_cache;
+
+void preflightCheckInvalidateCache()
+{
+	_static_check_cache = static_check_cache_s();
+}
+
 static int check_calibration(DevHandle &h, const char* param_template, int &devid)
 {
 	bool calibration_found;
@@ -599,7 +619,8 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 	bool failed = false;
 
 	/* ---- MAG ---- */
-	if (checkMag) {
+	if (checkMag && !_static_check_cache.mag_ok) {
+		bool check_failed = false;
 		bool prime_found = false;
 		int32_t prime_id = 0;
 		param_get(param_find("CAL_MAG_PRIME"), &prime_id);
@@ -610,7 +631,7 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 			int device_id = -1;
 
 			if (!magnometerCheck(mavlink_log_pub, i, !required, device_id, reportFailures) && required) {
-				failed = true;
+				check_failed = true;
 			}
 
 			if (device_id == prime_id) {
@@ -623,12 +644,21 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 			if (reportFailures) {
 				mavlink_log_critical(mavlink_log_pub, "Warning: Primary compass not found");
 			}
+			check_failed = true;
+		}
+
+		if (check_failed) {
 			failed = true;
+
+		} else {
+			/* static result, skip until parameters or topology change */
+			_static_check_cache.mag_ok = true;
 		}
 	}
 
 	/* ---- ACCEL ---- */
-	if (checkAcc) {
+	if (checkAcc && !_static_check_cache.accel_ok) {
+		bool check_failed = false;
 		bool prime_found = false;
 		int32_t prime_id = 0;
 		param_get(param_find("CAL_ACC_PRIME"), &prime_id);
@@ -639,7 +669,7 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 			int device_id = -1;
 
 			if (!accelerometerCheck(mavlink_log_pub, i, !required, checkDynamic, device_id, reportFailures) && required) {
-				failed = true;
+				check_failed = true;
 			}
 
 			if (device_id == prime_id) {
@@ -652,12 +682,22 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 			if (reportFailures) {
 				mavlink_log_critical(mavlink_log_pub, "Warning: Primary accelerometer not found");
 			}
+			check_failed = true;
+		}
+
+		if (check_failed) {
 			failed = true;
+
+		} else if (!checkDynamic) {
+			/* with checkDynamic the accel check includes a current
+			 * measurement, only the pure static result is cacheable */
+			_static_check_cache.accel_ok = true;
 		}
 	}
 
 	/* ---- GYRO ---- */
-	if (checkGyro) {
+	if (checkGyro && !_static_check_cache.gyro_ok) {
+		bool check_failed = false;
 		bool prime_found = false;
 		int32_t prime_id = 0;
 		param_get(param_find("CAL_GYRO_PRIME"), &prime_id);
@@ -668,7 +708,7 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 			int device_id = -1;
 
 			if (!gyroCheck(mavlink_log_pub, i, !required, device_id, reportFailures) && required) {
-				failed = true;
+				check_failed = true;
 			}
 
 			if (device_id == prime_id) {
@@ -681,12 +721,21 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 			if (reportFailures) {
 				mavlink_log_critical(mavlink_log_pub, "Warning: Primary gyro not found");
 			}
+			check_failed = true;
+		}
+
+		if (check_failed) {
 			failed = true;
+
+		} else {
+			/* static result, skip until parameters or topology change */
+			_static_check_cache.gyro_ok = true;
 		}
 	}
 
 	/* ---- BARO ---- */
-	if (checkBaro) {
+	if (checkBaro && !_static_check_cache.baro_ok) {
+		bool check_failed = false;
 		bool prime_found = false;
 		int32_t prime_id = 0;
 		param_get(param_find("CAL_BARO_PRIME"), &prime_id);
@@ -697,7 +746,7 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 			int device_id = -1;
 
 			if (!baroCheck(mavlink_log_pub, i, !required, device_id, reportFailures) && required) {
-				failed = true;
+				check_failed = true;
 			}
 
 			if (device_id == prime_id) {
@@ -711,7 +760,15 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 			if (reportFailures) {
 				mavlink_log_critical(mavlink_log_pub, "warning: primary barometer not operational");
 			}
+			check_failed = true;
+		}
+
+		if (check_failed) {
 			failed = true;
+
+		} else {
+			/* static result, skip until parameters or topology change */
+			_static_check_cache.baro_ok = true;
 		}
 	}
 
@@ -726,12 +783,16 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
 	}
 
 	/* ---- RC CALIBRATION ---- */
-	if (checkRC) {
+	if (checkRC && !_static_check_cache.rc_ok) {
 		if (rc_calibration_check(mavlink_log_pub, reportFailures, isVTOL) != OK) {
 			if (reportFailures) {
 				mavlink_log_critical(mavlink_log_pub, "RC calibration check failed");
 			}
 			failed = true;
+
+		} else {
+			/* pure parameter check, skip until parameters change */
+			_static_check_cache.rc_ok = true;
 		}
 	}
 
@@ -72,6 +72,16 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, bool checkMag, bool checkAcc,
     bool checkGyro, bool checkBaro, bool checkAirspeed, bool checkRC, bool checkGNSS,
     bool checkDynamic, bool isVTOL, bool reportFailures, bool prearm, hrt_abstime time_since_boot);
 
+/**
+* Invalidates the cached results of the static checks (sensor presence and
+* calibration, RC calibration).
+*
+* Must be called whenever parameters change or the sensor topology may have
+* changed (e.g. the hotplug timeout expired), so the next preflightCheck()
+* re-runs the full set.
+**/
+void preflightCheckInvalidateCache();
+
 static constexpr unsigned max_mandatory_gyro_count = 1;
 static constexpr unsigned max_optional_gyro_count = 3;
 
@@ -122,6 +122,7 @@
 #include <uORB/topics/vehicle_local_position.h>
 #include <uORB/topics/vehicle_status_flags.h>
 #include <uORB/topics/vtol_vehicle_status.h>
+#include <uORB/topics/work_queue_status.h>
 
 typedef enum VEHICLE_MODE_FLAG
 {
@@ -138,9 +139,7 @@ typedef enum VEHICLE_MODE_FLAG
 
 static constexpr uint8_t COMMANDER_MAX_GPS_NOISE = 60;		/**< Maximum percentage signal to noise ratio allowed for GPS reception */
 
-/* Decouple update interval and hysteresis counters, all depends on intervals */
 #define COMMANDER_MONITORING_INTERVAL 10000
-#define COMMANDER_MONITORING_LOOPSPERMSEC (1/(COMMANDER_MONITORING_INTERVAL/1000.0f))
 
 #define MAVLINK_OPEN_INTERVAL 50000
 
@@ -153,6 +152,9 @@ static constexpr uint8_t COMMANDER_MAX_GPS_NOISE = 60;		/**< Maximum percentage
 
 #define HOTPLUG_SENS_TIMEOUT		(8 * 1000 * 1000)	/**< wait for hotplug sensors to come online for upto 8 seconds */
 
+#define WQ_HP_LATENCY_MAX		50000	/**< high-priority work queue dispatch latency treated as starvation (usec) */
+#define WQ_LP_LATENCY_MAX		500000	/**< low-priority work queue dispatch latency treated as starvation (usec) */
+
 #define PRINT_INTERVAL	5000000
 #define PRINT_MODE_REJECT_INTERVAL	500000
 
@@ -200,6 +202,14 @@ static uint64_t last_print_mode_reject_time = 0;
 
 static systemlib::Hysteresis auto_disarm_hysteresis(false);
 
+/* Channels of the stick gesture debounce bank */
+enum {
+	STICK_GESTURE_DISARM = 0,
+	STICK_GESTURE_ARM,
+	STICK_GESTURE_COUNT
+};
+static systemlib::HysteresisBank<STICK_GESTURE_COUNT> stick_gesture_hysteresis({false, false});
+
 static float eph_threshold = 5.0f;	// Horizontal position error threshold (m)
 static float epv_threshold = 10.0f;	// Vertivcal position error threshold (m)
 static float evh_threshold = 1.0f;	// Horizontal velocity error threshold (m)
@@ -245,6 +255,7 @@ static uint8_t _last_sp_man_arm_switch = 0;
 
 static struct vtol_vehicle_status_s vtol_status = {};
 static struct cpuload_s cpuload = {};
+static struct work_queue_status_s wq_status = {};
 
 
 static uint8_t main_state_prev = 0;
@@ -1568,8 +1579,6 @@ int commander_thread_main(int argc, char *argv[])
 
 	/* Start monitoring loop */
 	unsigned counter = 0;
-	unsigned stick_off_counter = 0;
-	unsigned stick_on_counter = 0;
 
 	bool low_battery_voltage_actions_done = false;
 	bool critical_battery_voltage_actions_done = false;
@@ -1699,6 +1708,27 @@ int commander_thread_main(int argc, char *argv[])
 	int cpuload_sub = orb_subscribe(ORB_ID(cpuload));
 	memset(&cpuload, 0, sizeof(cpuload));
 
+	int wq_status_sub = orb_subscribe(ORB_ID(work_queue_status));
+	memset(&wq_status, 0, sizeof(wq_status));
+	bool wq_starvation_warned = false;
+
+	/* Latency-critical topics wake the main loop via poll, so commands, battery
+	 * warnings and RC input are handled right after they are published instead of
+	 * up to one monitoring interval later. All other topics are still checked each
+	 * cycle and the poll timeout provides the periodic tick. The polled topics are
+	 * rate-limited so that events cannot drive the loop faster than the fixed
+	 * monitoring rate did. */
+	orb_set_interval(sp_man_sub, COMMANDER_MONITORING_INTERVAL / 1000);
+	orb_set_interval(battery_sub, COMMANDER_MONITORING_INTERVAL / 1000);
+
+	px4_pollfd_struct_t fds[3] = {};
+	fds[0].fd = sp_man_sub;
+	fds[0].events = POLLIN;
+	fds[1].fd = battery_sub;
+	fds[1].events = POLLIN;
+	fds[2].fd = cmd_sub;
+	fds[2].events = POLLIN;
+
 	control_status_leds(&status, &armed, true, &battery, &cpuload);
 
 	/* Get parameter values controlloing activation of position failure failsafe and convert to required units*/
@@ -1761,10 +1791,11 @@ int commander_thread_main(int argc, char *argv[])
 			set_tune_override(TONE_STARTUP_TUNE); //normal boot tune
 	}
 
-	// user adjustable duration required to assert arm/disarm via throttle/rudder stick
-	int32_t rc_arm_hyst = 100;
+	// user adjustable duration required to assert arm/disarm via throttle/rudder stick [ms]
+	int32_t rc_arm_hyst = 1000;
 	param_get(_param_rc_arm_hyst, &rc_arm_hyst);
-	rc_arm_hyst *= COMMANDER_MONITORING_LOOPSPERMSEC;
+	stick_gesture_hysteresis.set_hysteresis_time_from(STICK_GESTURE_DISARM, false, (hrt_abstime)rc_arm_hyst * 1000);
+	stick_gesture_hysteresis.set_hysteresis_time_from(STICK_GESTURE_ARM, false, (hrt_abstime)rc_arm_hyst * 1000);
 
 	transition_result_t arming_ret;
 
@@ -1834,6 +1865,9 @@ int commander_thread_main(int argc, char *argv[])
 			struct parameter_update_s param_changed;
 			orb_copy(ORB_ID(parameter_update), param_changed_sub, &param_changed);
 
+			/* the static preflight checks depend on parameters, re-run them */
+			Commander::preflightCheckInvalidateCache();
+
 			/* update parameters */
 			if (!armed.armed) {
 				if (param_get(_param_sys_type, &(status.system_type)) != OK) {
@@ -1872,7 +1906,8 @@ int commander_thread_main(int argc, char *argv[])
 			param_get(_param_rc_override, &rc_override);
 			// percentage (* 0.01) needs to be doubled because RC total interval is 2, not 1
 			min_stick_change *= 0.02f;
-			rc_arm_hyst *= COMMANDER_MONITORING_LOOPSPERMSEC;
+			stick_gesture_hysteresis.set_hysteresis_time_from(STICK_GESTURE_DISARM, false, (hrt_abstime)rc_arm_hyst * 1000);
+			stick_gesture_hysteresis.set_hysteresis_time_from(STICK_GESTURE_ARM, false, (hrt_abstime)rc_arm_hyst * 1000);
 			param_get(_param_datalink_regain_timeout, &datalink_regain_timeout);
 			param_get(_param_ef_throttle_thres, &ef_throttle_thres);
 			param_get(_param_ef_current2throttle_thres, &ef_current2throttle_thres);
@@ -2305,6 +2340,26 @@ int commander_thread_main(int argc, char *argv[])
 			orb_copy(ORB_ID(cpuload), cpuload_sub, &cpuload);
 		}
 
+		/* work queue dispatch health: starved queues mean drivers sample late,
+		 * which surfaces as estimator divergence long before anything times out */
+		orb_check(wq_status_sub, &updated);
+
+		if (updated) {
+			orb_copy(ORB_ID(work_queue_status), wq_status_sub, &wq_status);
+
+			const bool wq_starved = (wq_status.hp_latency_window_us > WQ_HP_LATENCY_MAX) ||
+						(wq_status.lp_latency_window_us > WQ_LP_LATENCY_MAX);
+
+			if (wq_starved && !wq_starvation_warned) {
+				mavlink_log_critical(&mavlink_log_pub, "work queue starved: hp %u ms, lp %u ms",
+						     wq_status.hp_latency_window_us / 1000, wq_status.lp_latency_window_us / 1000);
+				wq_starvation_warned = true;
+
+			} else if (!wq_starved) {
+				wq_starvation_warned = false;
+			}
+		}
+
 		/* update battery status */
 		orb_check(battery_sub, &updated);
 
@@ -2722,10 +2777,43 @@ int commander_thread_main(int argc, char *argv[])
 					_last_sp_man_arm_switch == manual_control_setpoint_s::SWITCH_POS_ON &&
 					sp_man.arm_switch == manual_control_setpoint_s::SWITCH_POS_OFF;
 
-			if (in_armed_state &&
+			const bool disarm_gesture = in_armed_state &&
 				status.rc_input_mode != vehicle_status_s::RC_IN_MODE_OFF &&
 				(status.is_rotary_wing || (!status.is_rotary_wing && land_detector.landed)) &&
-				(stick_in_lower_left || arm_button_pressed || arm_switch_to_disarm_transition) ) {
+				(stick_in_lower_left || arm_button_pressed || arm_switch_to_disarm_transition);
+
+			/* ARM
+			 * check if left stick is in lower right position or arm button is pushed or arm switch has transition from disarm to arm
+			 * and we're in MANUAL mode */
+			const bool stick_in_lower_right = (sp_man.r > STICK_ON_OFF_LIMIT && sp_man.z < 0.1f);
+			const bool arm_switch_to_arm_transition = arm_switch_is_button == 0 &&
+					_last_sp_man_arm_switch == manual_control_setpoint_s::SWITCH_POS_OFF &&
+					sp_man.arm_switch == manual_control_setpoint_s::SWITCH_POS_ON;
+
+			const bool arm_gesture = !in_armed_state &&
+				status.rc_input_mode != vehicle_status_s::RC_IN_MODE_OFF &&
+				(stick_in_lower_right || arm_button_pressed || arm_switch_to_arm_transition);
+
+			/* debounce both gestures in one pass; holding the arm button longer
+			 * than needed must not restart a completed gesture */
+			const bool prev_disarm_gesture_held = stick_gesture_hysteresis.get_state(STICK_GESTURE_DISARM);
+			const bool prev_arm_gesture_held = stick_gesture_hysteresis.get_state(STICK_GESTURE_ARM);
+
+			const bool gesture_inputs[STICK_GESTURE_COUNT] = {
+				disarm_gesture || (arm_button_pressed && prev_disarm_gesture_held),
+				arm_gesture || (arm_button_pressed && prev_arm_gesture_held)
+			};
+
+			stick_gesture_hysteresis.set_states_and_update(gesture_inputs);
+
+			/* a gesture triggers once, on the cycle its debounce time completes,
+			 * and not while the opposite gesture is still asserted */
+			const bool stick_disarm_completed = stick_gesture_hysteresis.get_state(STICK_GESTURE_DISARM) &&
+					!prev_disarm_gesture_held && !stick_gesture_hysteresis.get_state(STICK_GESTURE_ARM);
+			const bool stick_arm_completed = stick_gesture_hysteresis.get_state(STICK_GESTURE_ARM) &&
+					!prev_arm_gesture_held && !stick_gesture_hysteresis.get_state(STICK_GESTURE_DISARM);
+
+			if (disarm_gesture) {
 
 				if (internal_state.main_state != commander_state_s::MAIN_STATE_MANUAL &&
 						internal_state.main_state != commander_state_s::MAIN_STATE_ACRO &&
@@ -2734,7 +2822,7 @@ int commander_thread_main(int argc, char *argv[])
 						!land_detector.landed) {
 					print_reject_arm("NOT DISARMING: Not in manual mode or landed yet.");
 
-				} else if ((stick_off_counter == rc_arm_hyst && stick_on_counter < rc_arm_hyst) || arm_switch_to_disarm_transition) {
+				} else if (stick_disarm_completed || arm_switch_to_disarm_transition) {
 					/* disarm to STANDBY if ARMED or to STANDBY_ERROR if ARMED_ERROR */
 					arming_state_t new_arming_state = (status.arming_state == vehicle_status_s::ARMING_STATE_ARMED ? vehicle_status_s::ARMING_STATE_STANDBY :
 									   vehicle_status_s::ARMING_STATE_STANDBY_ERROR);
@@ -2754,24 +2842,10 @@ int commander_thread_main(int argc, char *argv[])
 						arming_state_changed = true;
 					}
 				}
-				stick_off_counter++;
-			/* do not reset the counter when holding the arm button longer than needed */
-			} else if (!(arm_switch_is_button == 1 && sp_man.arm_switch == manual_control_setpoint_s::SWITCH_POS_ON)) {
-				stick_off_counter = 0;
 			}
 
-			/* ARM
-			 * check if left stick is in lower right position or arm button is pushed or arm switch has transition from disarm to arm
-			 * and we're in MANUAL mode */
-			const bool stick_in_lower_right = (sp_man.r > STICK_ON_OFF_LIMIT && sp_man.z < 0.1f);
-			const bool arm_switch_to_arm_transition = arm_switch_is_button == 0 &&
-					_last_sp_man_arm_switch == manual_control_setpoint_s::SWITCH_POS_OFF &&
-					sp_man.arm_switch == manual_control_setpoint_s::SWITCH_POS_ON;
-
-			if (!in_armed_state &&
-				status.rc_input_mode != vehicle_status_s::RC_IN_MODE_OFF &&
-				(stick_in_lower_right || arm_button_pressed || arm_switch_to_arm_transition) ) {
-				if ((stick_on_counter == rc_arm_hyst && stick_off_counter < rc_arm_hyst) || arm_switch_to_arm_transition) {
+			if (arm_gesture) {
+				if (stick_arm_completed || arm_switch_to_arm_transition) {
 
 					/* we check outside of the transition function here because the requirement
 					 * for being in manual mode only applies to manual arming actions.
@@ -2812,10 +2886,6 @@ int commander_thread_main(int argc, char *argv[])
 						}
 					}
 				}
-				stick_on_counter++;
-			/* do not reset the counter when holding the arm button longer than needed */
-			} else if (!(arm_switch_is_button == 1 && sp_man.arm_switch == manual_control_setpoint_s::SWITCH_POS_ON)) {
-				stick_on_counter = 0;
 			}
 
 			_last_sp_man_arm_switch = sp_man.arm_switch;
@@ -3198,6 +3268,8 @@ int commander_thread_main(int argc, char *argv[])
 		/* update timeout flag */
 		if(!(hotplug_timeout == status_flags.condition_system_hotplug_timeout)) {
 			status_flags.condition_system_hotplug_timeout = hotplug_timeout;
+			/* sensor topology just settled, cached check results may be stale */
+			Commander::preflightCheckInvalidateCache();
 			status_changed = true;
 		}
 
@@ -3237,7 +3309,9 @@ int commander_thread_main(int argc, char *argv[])
 
 		arm_auth_update(now);
 
-		usleep(COMMANDER_MONITORING_INTERVAL);
+		/* sleep until one of the latency-critical topics updates or the
+		 * monitoring interval elapses (the periodic tick) */
+		px4_poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), COMMANDER_MONITORING_INTERVAL / 1000);
 	}
 
 	/* wait for threads to complete */
@@ -3301,7 +3375,11 @@ control_status_leds(vehicle_status_s *status_local, const actuator_armed_s *actu
 {
 	static hrt_abstime overload_start = 0;
 
-	bool overload = (cpuload_local->load > 0.80f) || (cpuload_local->ram_usage > 0.98f);
+	/* work queue starvation counts as overload: items on the queues are
+	 * dispatched so late that drivers running there sample stale data */
+	bool overload = (cpuload_local->load > 0.80f) || (cpuload_local->ram_usage > 0.98f)
+			|| (wq_status.hp_latency_window_us > WQ_HP_LATENCY_MAX)
+			|| (wq_status.lp_latency_window_us > WQ_LP_LATENCY_MAX);
 
 	if (overload_start == 0 && overload) {
 		overload_start = hrt_absolute_time();
@@ -56,6 +56,7 @@
 #include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/vehicle_control_mode.h>
 #include <uORB/topics/led_control.h>
+#include <uORB/topics/tune_control.h>
 #include <systemlib/err.h>
 #include <systemlib/param/param.h>
 #include <drivers/drv_hrt.h>
@@ -112,9 +113,10 @@ static int tune_current = TONE_STOP_TUNE;		// currently playing tune, can be int
 static unsigned int tune_durations[TONE_NUMBER_OF_TUNES];
 
 static DevHandle h_leds;
-static DevHandle h_buzzer;
 static led_control_s led_control = {};
 static orb_advert_t led_control_pub = nullptr;
+static tune_control_s tune_control = {};
+static orb_advert_t tune_control_pub = nullptr;
 
 int buzzer_init()
 {
@@ -126,10 +128,15 @@ int buzzer_init()
 	tune_durations[TONE_NOTIFY_NEUTRAL_TUNE] = 500000;
 	tune_durations[TONE_ARMING_WARNING_TUNE] = 3000000;
 
-	DevMgr::getHandle(TONEALARM0_DEVICE_PATH, h_buzzer);
+	/* tunes are published as intents and played by the tone_alarm driver
+	 * from its own context, so a stuck indicator device cannot add latency
+	 * to commander paths */
+	tune_control.tune_id = TONE_STOP_TUNE;
+	tune_control.timestamp = hrt_absolute_time();
+	tune_control_pub = orb_advertise_queue(ORB_ID(tune_control), &tune_control, TUNE_UORB_QUEUE_LENGTH);
 
-	if (!h_buzzer.isValid()) {
-		PX4_WARN("Buzzer: px4_open fail\n");
+	if (tune_control_pub == nullptr) {
+		PX4_WARN("Buzzer: advertise fail\n");
 		return PX4_ERROR;
 	}
 
@@ -138,12 +145,19 @@ int buzzer_init()
 
 void buzzer_deinit()
 {
-	DevMgr::releaseHandle(h_buzzer);
+	orb_unadvertise(tune_control_pub);
+}
+
+static void publish_tune(int tune)
+{
+	tune_control.tune_id = tune;
+	tune_control.timestamp = hrt_absolute_time();
+	orb_publish(ORB_ID(tune_control), tune_control_pub, &tune_control);
 }
 
 void set_tune_override(int tune)
 {
-	h_buzzer.ioctl(TONE_SET_ALARM, tune);
+	publish_tune(tune);
 }
 
 void set_tune(int tune)
@@ -154,7 +168,7 @@ void set_tune(int tune)
 	if (tune_end == 0 || new_tune_duration != 0 || hrt_absolute_time() > tune_end) {
 		/* allow interrupting current non-repeating tune by the same tune */
 		if (tune != tune_current || new_tune_duration != 0) {
-			h_buzzer.ioctl(TONE_SET_ALARM, tune);
+			publish_tune(tune);
 		}
 
 		tune_current = tune;
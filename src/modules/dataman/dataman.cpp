@@ -90,6 +90,18 @@ static int  _ram_restart(dm_reset_reason reason);
 static int _ram_initialize(unsigned max_offset);
 static void _ram_shutdown();
 
+/* Private File cache based Operations */
+#define FILE_CACHE_FLUSH_TIMEOUT_USEC 1000000	/* write-back delay after the last modification */
+
+static ssize_t _file_cache_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf,
+				 size_t count);
+static ssize_t _file_cache_read(dm_item_t item, unsigned index, void *buf, size_t count);
+static int  _file_cache_clear(dm_item_t item);
+static int  _file_cache_restart(dm_reset_reason reason);
+static int _file_cache_initialize(unsigned max_offset);
+static void _file_cache_shutdown();
+static int _file_cache_wait(px4_sem_t *sem);
+
 #if defined(FLASH_BASED_DATAMAN)
 /* Private Ram_Flash based Operations */
 #define RAM_FLASH_FLUSH_TIMEOUT_USEC USEC_PER_SEC
@@ -104,6 +116,15 @@ static void _ram_flash_shutdown();
 static int _ram_flash_wait(px4_sem_t *sem);
 #endif
 
+/* Private critical tier Operations, layered over any backend */
+static ssize_t _critical_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf,
+			       size_t count);
+static ssize_t _critical_read(dm_item_t item, unsigned index, void *buf, size_t count);
+static int  _critical_clear(dm_item_t item);
+static int  _critical_restart(dm_reset_reason reason);
+static int _critical_initialize();
+static void _critical_shutdown();
+
 typedef struct dm_operations_t {
 	ssize_t (*write)(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count);
 	ssize_t (*read)(dm_item_t item, unsigned index, void *buf, size_t count);
@@ -134,6 +155,16 @@ static dm_operations_t dm_ram_operations = {
 	.wait = px4_sem_wait,
 };
 
+static dm_operations_t dm_file_cache_operations = {
+	.write   = _file_cache_write,
+	.read    = _file_cache_read,
+	.clear   = _file_cache_clear,
+	.restart = _file_cache_restart,
+	.initialize = _file_cache_initialize,
+	.shutdown = _file_cache_shutdown,
+	.wait = _file_cache_wait,
+};
+
 #if defined(FLASH_BASED_DATAMAN)
 static dm_operations_t dm_ram_flash_operations = {
 	.write   = _ram_flash_write,
@@ -157,6 +188,15 @@ static struct {
 			uint8_t *data;
 			uint8_t *data_end;
 		} ram;
+		struct {
+			uint8_t *data;
+			uint8_t *data_end;
+			/* sync above with RAM backend */
+			int fd;
+			uint8_t *dirty;			/* one bit per item slot */
+			unsigned dirty_size;		/* size of the dirty map in bytes */
+			hrt_abstime flush_timeout_usec;
+		} file_cache;
 #if defined(FLASH_BASED_DATAMAN)
 		struct {
 			uint8_t *data;
@@ -173,6 +213,8 @@ static struct {
 typedef enum {
 	dm_write_func = 0,
 	dm_read_func,
+	dm_read_multiple_func,
+	dm_write_multiple_func,
 	dm_clear_func,
 	dm_restart_func,
 	dm_number_of_funcs
@@ -185,10 +227,13 @@ typedef struct {
 	unsigned char first;
 	unsigned char func;
 	ssize_t result;
+	dm_callback_t callback;	/**< if set, run on completion instead of waking a waiter */
+	void *callback_arg;
 	union {
 		struct {
 			dm_item_t item;
 			unsigned index;
+			unsigned num_items;
 			dm_persitence_t persistence;
 			const void *buf;
 			size_t count;
@@ -196,6 +241,7 @@ typedef struct {
 		struct {
 			dm_item_t item;
 			unsigned index;
+			unsigned num_items;
 			void *buf;
 			size_t count;
 		} read_params;
@@ -226,6 +272,8 @@ static const unsigned g_per_item_max_index[DM_KEY_NUM_KEYS] = {
 
 #define DM_SECTOR_HDR_SIZE 4	/* data manager per item header overhead */
 
+#define DM_JOURNAL_SEQ_SIZE sizeof(uint16_t)	/* journal record sequence number prefix */
+
 /* Table of the len of each item type */
 static const unsigned g_per_item_size[DM_KEY_NUM_KEYS] = {
 	sizeof(struct mission_save_point_s) + DM_SECTOR_HDR_SIZE,
@@ -233,13 +281,32 @@ static const unsigned g_per_item_size[DM_KEY_NUM_KEYS] = {
 	sizeof(struct mission_item_s) + DM_SECTOR_HDR_SIZE,
 	sizeof(struct mission_item_s) + DM_SECTOR_HDR_SIZE,
 	sizeof(struct mission_item_s) + DM_SECTOR_HDR_SIZE,
-	sizeof(struct mission_s) + DM_SECTOR_HDR_SIZE,
+	sizeof(struct mission_s) + DM_JOURNAL_SEQ_SIZE + DM_SECTOR_HDR_SIZE,
 	sizeof(struct dataman_compat_s) + DM_SECTOR_HDR_SIZE
 };
 
+/* Keys holding small critical state; with a critical tier device configured
+ * these live there instead of the bulk backend, so mission-resume updates are
+ * not exposed to SD stalls */
+static const bool g_key_critical[DM_KEY_NUM_KEYS] = {
+	false,	/* DM_KEY_SAFE_POINTS */
+	false,	/* DM_KEY_FENCE_POINTS */
+	false,	/* DM_KEY_WAYPOINTS_OFFBOARD_0 */
+	false,	/* DM_KEY_WAYPOINTS_OFFBOARD_1 */
+	false,	/* DM_KEY_WAYPOINTS_ONBOARD */
+	true,	/* DM_KEY_MISSION_STATE */
+	false	/* DM_KEY_COMPAT */
+};
+
 /* Table of offset for index 0 of each item type */
 static unsigned int g_key_offsets[DM_KEY_NUM_KEYS];
 
+/* Offsets of the critical keys within the critical tier device */
+static unsigned int g_critical_key_offsets[DM_KEY_NUM_KEYS];
+
+/* Table of the first item slot number of each item type, for the dirty map */
+static unsigned int g_key_slot_base[DM_KEY_NUM_KEYS];
+
 /* Item type lock mutexes */
 static px4_sem_t *g_item_locks[DM_KEY_NUM_KEYS];
 static px4_sem_t g_sys_state_mutex_mission;
@@ -253,6 +320,10 @@ static const char *default_device_path = PX4_ROOTFSDIR"/fs/microsd/dataman";
 #endif
 static char *k_data_manager_device_path = nullptr;
 
+/* The critical tier device (FRAM/MTD) handle and name, -1/nullptr if not configured */
+static int g_critical_fd = -1;
+static char *k_critical_device_path = nullptr;
+
 #if defined(FLASH_BASED_DATAMAN)
 static const dm_sector_descriptor_t *k_dataman_flash_sector = nullptr;
 #endif
@@ -260,6 +331,7 @@ static const dm_sector_descriptor_t *k_dataman_flash_sector = nullptr;
 static enum {
 	BACKEND_NONE = 0,
 	BACKEND_FILE,
+	BACKEND_FILE_CACHE,
 	BACKEND_RAM,
 #if defined(FLASH_BASED_DATAMAN)
 	BACKEND_RAM_FLASH,
@@ -349,6 +421,9 @@ create_work_item()
 
 	/* If we got one then lock the item*/
 	if (item) {
+		item->callback = nullptr;
+		item->callback_arg = nullptr;
+
 		px4_sem_init(&item->wait_sem, 1, 0);        /* Caller will wait on this... initially locked */
 
 		/* item->wait_sem use case is a signal */
@@ -394,8 +469,8 @@ dequeue_work_item()
 	return work;
 }
 
-static int
-enqueue_work_item_and_wait_for_result(work_q_item_t *item)
+static void
+enqueue_work_item(work_q_item_t *item)
 {
 	/* put the work item at the end of the work queue */
 	lock_queue(&g_work_q);
@@ -410,6 +485,12 @@ enqueue_work_item_and_wait_for_result(work_q_item_t *item)
 
 	/* tell the work thread that work is available */
 	px4_sem_post(&g_work_queued_sema);
+}
+
+static int
+enqueue_work_item_and_wait_for_result(work_q_item_t *item)
+{
+	enqueue_work_item(item);
 
 	/* wait for the result */
 	px4_sem_wait(&item->wait_sem);
@@ -1079,241 +1160,1088 @@ _ram_flash_wait(px4_sem_t *sem)
 }
 #endif
 
-/** Write to the data manager file */
-__EXPORT ssize_t
-dm_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
+/* Mark one item slot as modified and (re)arm the write-back timer */
+static void
+_file_cache_mark_dirty(dm_item_t item, unsigned index)
 {
-	work_q_item_t *work;
-
-	/* Make sure data manager has been started and is not shutting down */
-	if (!is_running() || g_task_should_exit) {
-		return -1;
-	}
-
-	/* get a work item and queue up a write request */
-	if ((work = create_work_item()) == nullptr) {
-		return -1;
-	}
+	unsigned slot = g_key_slot_base[item] + index;
 
-	work->func = dm_write_func;
-	work->write_params.item = item;
-	work->write_params.index = index;
-	work->write_params.persistence = persistence;
-	work->write_params.buf = buf;
-	work->write_params.count = count;
-
-	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
-	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+	dm_operations_data.file_cache.dirty[slot / 8] |= (1 << (slot % 8));
+	dm_operations_data.file_cache.flush_timeout_usec = hrt_absolute_time() + FILE_CACHE_FLUSH_TIMEOUT_USEC;
 }
 
-/** Retrieve from the data manager file */
-__EXPORT ssize_t
-dm_read(dm_item_t item, unsigned index, void *buf, size_t count)
+/* Write back all dirty item slots and sync the file once */
+static void
+_file_cache_flush()
 {
-	work_q_item_t *work;
+	unsigned slot = 0;
+	bool wrote = false;
 
-	/* Make sure data manager has been started and is not shutting down */
-	if (!is_running() || g_task_should_exit) {
-		return -1;
-	}
+	for (int item = (int)DM_KEY_SAFE_POINTS; item < (int)DM_KEY_NUM_KEYS; item++) {
+		for (unsigned i = 0; i < g_per_item_max_index[item]; i++, slot++) {
+			if (!(dm_operations_data.file_cache.dirty[slot / 8] & (1 << (slot % 8)))) {
+				continue;
+			}
 
-	/* get a work item and queue up a read request */
-	if ((work = create_work_item()) == nullptr) {
-		return -1;
+			int offset = calculate_offset((dm_item_t)item, i);
+			const uint8_t *buffer = &dm_operations_data.file_cache.data[offset];
+
+			if (lseek(dm_operations_data.file_cache.fd, offset, SEEK_SET) != offset ||
+			    write(dm_operations_data.file_cache.fd, buffer, g_per_item_size[item]) != (ssize_t)g_per_item_size[item]) {
+				/* keep the remaining dirty bits and retry on the next flush */
+				PX4_WARN("file cache flush failed at offset %d", offset);
+				dm_operations_data.file_cache.flush_timeout_usec = hrt_absolute_time() + FILE_CACHE_FLUSH_TIMEOUT_USEC;
+				return;
+			}
+
+			dm_operations_data.file_cache.dirty[slot / 8] &= ~(1 << (slot % 8));
+			wrote = true;
+		}
 	}
 
-	work->func = dm_read_func;
-	work->read_params.item = item;
-	work->read_params.index = index;
-	work->read_params.buf = buf;
-	work->read_params.count = count;
+	dm_operations_data.file_cache.flush_timeout_usec = 0;
 
-	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
-	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+	if (wrote) {
+		fsync(dm_operations_data.file_cache.fd);
+	}
 }
 
-/** Clear a data Item */
-__EXPORT int
-dm_clear(dm_item_t item)
+static ssize_t
+_file_cache_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
 {
-	work_q_item_t *work;
+	ssize_t ret = dm_ram_operations.write(item, index, persistence, buf, count);
 
-	/* Make sure data manager has been started and is not shutting down */
-	if (!is_running() || g_task_should_exit) {
-		return -1;
+	if (ret < 0) {
+		return ret;
 	}
 
-	/* get a work item and queue up a clear request */
-	if ((work = create_work_item()) == nullptr) {
-		return -1;
-	}
+	_file_cache_mark_dirty(item, index);
 
-	work->func = dm_clear_func;
-	work->clear_params.item = item;
+	return ret;
+}
 
-	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
-	return enqueue_work_item_and_wait_for_result(work);
+static ssize_t
+_file_cache_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	return dm_ram_operations.read(item, index, buf, count);
 }
 
-__EXPORT int
-dm_lock(dm_item_t item)
+static int
+_file_cache_clear(dm_item_t item)
 {
-	/* Make sure data manager has been started and is not shutting down */
-	if (!is_running() || g_task_should_exit) {
-		errno = EINVAL;
-		return -1;
-	}
+	int ret = dm_ram_operations.clear(item);
 
-	if (item >= DM_KEY_NUM_KEYS) {
-		errno = EINVAL;
-		return -1;
+	if (ret < 0) {
+		return ret;
 	}
 
-	if (g_item_locks[item]) {
-		return px4_sem_wait(g_item_locks[item]);
+	for (unsigned i = 0; i < g_per_item_max_index[item]; i++) {
+		_file_cache_mark_dirty(item, i);
 	}
 
-	errno = EINVAL;
-	return -1;
+	return ret;
 }
 
-__EXPORT int
-dm_trylock(dm_item_t item)
+static int
+_file_cache_restart(dm_reset_reason reason)
 {
-	/* Make sure data manager has been started and is not shutting down */
-	if (!is_running() || g_task_should_exit) {
-		errno = EINVAL;
-		return -1;
-	}
+	int ret = dm_ram_operations.restart(reason);
 
-	if (item >= DM_KEY_NUM_KEYS) {
-		errno = EINVAL;
-		return -1;
+	if (ret < 0) {
+		return ret;
 	}
 
-	if (g_item_locks[item]) {
-		return px4_sem_trywait(g_item_locks[item]);
-	}
+	/* the restart may have invalidated any slot, write them all back */
+	memset(dm_operations_data.file_cache.dirty, 0xff, dm_operations_data.file_cache.dirty_size);
+	dm_operations_data.file_cache.flush_timeout_usec = hrt_absolute_time() + FILE_CACHE_FLUSH_TIMEOUT_USEC;
 
-	errno = EINVAL;
-	return -1;
+	return ret;
 }
 
-/** Unlock a data Item */
-__EXPORT void
-dm_unlock(dm_item_t item)
+static int
+_file_cache_initialize(unsigned max_offset)
 {
-	/* Make sure data manager has been started and is not shutting down */
-	if (!is_running() || g_task_should_exit) {
-		return;
-	}
+	int ret = dm_ram_operations.initialize(max_offset);
 
-	if (item >= DM_KEY_NUM_KEYS) {
-		return;
+	if (ret != 0) {
+		return ret;
 	}
 
-	if (g_item_locks[item]) {
-		px4_sem_post(g_item_locks[item]);
+	unsigned total_slots = 0;
+
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		total_slots += g_per_item_max_index[i];
 	}
-}
 
-/** Tell the data manager about the type of the last reset */
-__EXPORT int
-dm_restart(dm_reset_reason reason)
-{
-	work_q_item_t *work;
+	dm_operations_data.file_cache.dirty_size = (total_slots + 7) / 8;
+	dm_operations_data.file_cache.dirty = (uint8_t *)calloc(1, dm_operations_data.file_cache.dirty_size);
 
-	/* Make sure data manager has been started and is not shutting down */
-	if (!is_running() || g_task_should_exit) {
+	if (dm_operations_data.file_cache.dirty == nullptr) {
+		PX4_WARN("Could not allocate %d bytes of memory", dm_operations_data.file_cache.dirty_size);
+		free(dm_operations_data.file_cache.data);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
 		return -1;
 	}
 
-	/* get a work item and queue up a restart request */
-	if ((work = create_work_item()) == nullptr) {
+	dm_operations_data.file_cache.flush_timeout_usec = 0;
+
+	/* Open or create the data manager file */
+	dm_operations_data.file_cache.fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (dm_operations_data.file_cache.fd < 0) {
+		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		free(dm_operations_data.file_cache.dirty);
+		free(dm_operations_data.file_cache.data);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
 		return -1;
 	}
 
-	work->func = dm_restart_func;
-	work->restart_params.reason = reason;
+	/* Load the whole store into the cache; anything beyond the end of
+	 * the file stays zeroed (empty) */
+	uint8_t *p = dm_operations_data.file_cache.data;
+	size_t remaining = max_offset;
 
-	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
-	return enqueue_work_item_and_wait_for_result(work);
-}
+	while (remaining > 0) {
+		ssize_t len = read(dm_operations_data.file_cache.fd, p, remaining);
 
-#if defined(FLASH_BASED_DATAMAN)
-__EXPORT int
-dm_flash_sector_description_set(const dm_sector_descriptor_t *description)
-{
-	k_dataman_flash_sector = description;
-	return 0;
-}
-#endif
+		if (len <= 0) {
+			break;
+		}
 
-static int
-task_main(int argc, char *argv[])
-{
-	/* Dataman can use disk or RAM */
-	switch (backend) {
-	case BACKEND_FILE:
-		g_dm_ops = &dm_file_operations;
-		break;
+		p += len;
+		remaining -= len;
+	}
 
-	case BACKEND_RAM:
-		g_dm_ops = &dm_ram_operations;
-		break;
+	/* Check the hash on the cached copy */
+	struct dataman_compat_s compat_state;
+	ret = dm_ram_operations.read(DM_KEY_COMPAT, 0, &compat_state, sizeof(compat_state));
 
-#if defined(FLASH_BASED_DATAMAN)
+	if (ret != sizeof(compat_state) || compat_state.key != DM_COMPAT_KEY) {
+		/* Not compatible: start from an empty store and rewrite everything */
+		memset(dm_operations_data.file_cache.data, 0, max_offset);
+		memset(dm_operations_data.file_cache.dirty, 0xff, dm_operations_data.file_cache.dirty_size);
+	}
 
-	case BACKEND_RAM_FLASH:
-		g_dm_ops = &dm_ram_flash_operations;
-		break;
-#endif
+	/* Write current compat info */
+	compat_state.key = DM_COMPAT_KEY;
+	ret = _file_cache_write(DM_KEY_COMPAT, 0, DM_PERSIST_POWER_ON_RESET, &compat_state, sizeof(compat_state));
 
-	default:
-		PX4_WARN("No valid backend set.");
-		return -1;
+	if (ret != sizeof(compat_state)) {
+		PX4_ERR("Failed writing compat: %d", ret);
 	}
 
-	work_q_item_t *work;
+	dm_operations_data.running = true;
 
-	/* Initialize global variables */
-	g_key_offsets[0] = 0;
+	return 0;
+}
 
-	for (int i = 0; i < ((int)DM_KEY_NUM_KEYS - 1); i++) {
-		g_key_offsets[i + 1] = g_key_offsets[i] + (g_per_item_max_index[i] * g_per_item_size[i]);
+static void
+_file_cache_shutdown()
+{
+	if (dm_operations_data.file_cache.flush_timeout_usec) {
+		_file_cache_flush();
 	}
 
-	unsigned max_offset = g_key_offsets[DM_KEY_NUM_KEYS - 1] + (g_per_item_max_index[DM_KEY_NUM_KEYS - 1] *
-			      g_per_item_size[DM_KEY_NUM_KEYS - 1]);
+	close(dm_operations_data.file_cache.fd);
+	free(dm_operations_data.file_cache.dirty);
+	free(dm_operations_data.file_cache.data);
+	dm_operations_data.running = false;
+}
 
-	for (unsigned i = 0; i < dm_number_of_funcs; i++) {
-		g_func_counts[i] = 0;
+static int
+_file_cache_wait(px4_sem_t *sem)
+{
+	if (!dm_operations_data.file_cache.flush_timeout_usec) {
+		px4_sem_wait(sem);
+		return 0;
 	}
 
-	/* Initialize the item type locks, for now only DM_KEY_MISSION_STATE & DM_KEY_FENCE_POINTS supports locking */
-	px4_sem_init(&g_sys_state_mutex_mission, 1, 1); /* Initially unlocked */
-	px4_sem_init(&g_sys_state_mutex_fence, 1, 1); /* Initially unlocked */
+	const uint64_t now = hrt_absolute_time();
 
-	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
-		g_item_locks[i] = nullptr;
+	if (now >= dm_operations_data.file_cache.flush_timeout_usec) {
+		_file_cache_flush();
+		return 0;
 	}
 
-	g_item_locks[DM_KEY_MISSION_STATE] = &g_sys_state_mutex_mission;
-	g_item_locks[DM_KEY_FENCE_POINTS] = &g_sys_state_mutex_fence;
-
-	g_task_should_exit = false;
+	const uint64_t diff = dm_operations_data.file_cache.flush_timeout_usec - now;
+	struct timespec abstime;
+	abstime.tv_sec = diff / 1000000;
+	abstime.tv_nsec = (diff % 1000000) * 1000;
 
-	init_q(&g_work_q);
-	init_q(&g_free_q);
+	px4_sem_timedwait(sem, &abstime);
 
-	px4_sem_init(&g_work_queued_sema, 1, 0);
+	if (hrt_absolute_time() < dm_operations_data.file_cache.flush_timeout_usec) {
+		/* a work was queued before timeout */
+		return 0;
+	}
 
-	/* g_work_queued_sema use case is a signal */
+	_file_cache_flush();
+	return 0;
+}
 
-	px4_sem_setprotocol(&g_work_queued_sema, SEM_PRIO_NONE);
+/* The critical tier is not a backend of its own but layered over whatever
+ * backend is running: keys marked in g_key_critical are stored on a small
+ * dedicated FRAM/MTD device (the same parts the hardfault log uses) with
+ * synchronous writes, so updating e.g. the mission state never waits on the
+ * SD card. The device layout is a dataman_compat_s header followed by the
+ * critical items in their usual on-media format.
+ */
 
-	/* see if we need to erase any items based on restart type */
-	int sys_restart_val;
+/* Calculate the offset of a critical item within the critical tier device */
+static int
+calculate_critical_offset(dm_item_t item, unsigned index)
+{
+	/* Make sure the item type is valid and designated critical */
+	if (item >= DM_KEY_NUM_KEYS || !g_key_critical[item]) {
+		return -1;
+	}
+
+	/* Make sure the index for this item type is valid */
+	if (index >= g_per_item_max_index[item]) {
+		return -1;
+	}
+
+	return g_critical_key_offsets[item] + (index * g_per_item_size[item]);
+}
+
+/* Is this item routed to the critical tier? */
+static inline bool
+dm_key_is_critical(dm_item_t item)
+{
+	return g_critical_fd >= 0 && item < DM_KEY_NUM_KEYS && g_key_critical[item];
+}
+
+/* Write to the critical tier device */
+static ssize_t
+_critical_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
+{
+	unsigned char buffer[g_per_item_size[item]];
+	size_t len;
+
+	int offset = calculate_critical_offset(item, index);
+
+	if (offset < 0) {
+		return -1;
+	}
+
+	/* Make sure caller has not given us more data than we can handle */
+	if (count > g_per_item_size[item]) {
+		return -E2BIG;
+	}
+
+	/* Write out the data, prefixed with length and persistence level */
+	buffer[0] = count;
+	buffer[1] = persistence;
+	buffer[2] = 0;
+	buffer[3] = 0;
+
+	if (count > 0) {
+		memcpy(buffer + DM_SECTOR_HDR_SIZE, buf, count);
+	}
+
+	count += DM_SECTOR_HDR_SIZE;
+
+	len = -1;
+
+	/* FRAM writes complete in-place; the fsync covers file-backed stand-ins */
+	if (lseek(g_critical_fd, offset, SEEK_SET) == offset) {
+		if ((len = write(g_critical_fd, buffer, count)) == count) {
+			fsync(g_critical_fd);
+		}
+	}
+
+	if (len != count) {
+		return -1;
+	}
+
+	/* All is well... return the number of user data written */
+	return count - DM_SECTOR_HDR_SIZE;
+}
+
+/* Retrieve from the critical tier device */
+static ssize_t
+_critical_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	unsigned char buffer[g_per_item_size[item]];
+	int len;
+
+	int offset = calculate_critical_offset(item, index);
+
+	if (offset < 0) {
+		return -1;
+	}
+
+	/* Make sure the caller hasn't asked for more data than we can handle */
+	if (count > g_per_item_size[item]) {
+		return -E2BIG;
+	}
+
+	/* Read the prefix and data */
+	len = -1;
+
+	if (lseek(g_critical_fd, offset, SEEK_SET) == offset) {
+		len = read(g_critical_fd, buffer, count + DM_SECTOR_HDR_SIZE);
+	}
+
+	/* Check for read error */
+	if (len < 0) {
+		return -errno;
+	}
+
+	/* A zero length entry is a empty entry */
+	if (len == 0) {
+		buffer[0] = 0;
+	}
+
+	/* See if we got data */
+	if (buffer[0] > 0) {
+		/* We got more than requested!!! */
+		if (buffer[0] > count) {
+			return -1;
+		}
+
+		/* Looks good, copy it to the caller's buffer */
+		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
+	}
+
+	/* Return the number of bytes of caller data read */
+	return buffer[0];
+}
+
+static int
+_critical_clear(dm_item_t item)
+{
+	int result = 0;
+
+	int offset = calculate_critical_offset(item, 0);
+
+	if (offset < 0) {
+		return -1;
+	}
+
+	for (unsigned i = 0; i < g_per_item_max_index[item]; i++) {
+		char buf[1];
+
+		if (lseek(g_critical_fd, offset, SEEK_SET) != offset) {
+			result = -1;
+			break;
+		}
+
+		/* Only write where necessary */
+		if (read(g_critical_fd, buf, 1) < 1) {
+			break;
+		}
+
+		if (buf[0]) {
+			if (lseek(g_critical_fd, offset, SEEK_SET) != offset) {
+				result = -1;
+				break;
+			}
+
+			buf[0] = 0;
+
+			if (write(g_critical_fd, buf, 1) != 1) {
+				result = -1;
+				break;
+			}
+		}
+
+		offset += g_per_item_size[item];
+	}
+
+	fsync(g_critical_fd);
+	return result;
+}
+
+static int
+_critical_restart(dm_reset_reason reason)
+{
+	int result = 0;
+
+	/* Invalidate any critical data that should not persist after the last reset */
+	for (int item = (int)DM_KEY_SAFE_POINTS; item < (int)DM_KEY_NUM_KEYS; item++) {
+		if (!g_key_critical[item]) {
+			continue;
+		}
+
+		for (unsigned i = 0; i < g_per_item_max_index[item]; i++) {
+			int offset = calculate_critical_offset((dm_item_t)item, i);
+
+			if (lseek(g_critical_fd, offset, SEEK_SET) != offset) {
+				return -1;
+			}
+
+			uint8_t buffer[2];
+
+			if (read(g_critical_fd, buffer, sizeof(buffer)) != sizeof(buffer)) {
+				return -1;
+			}
+
+			/* check if segment contains data */
+			if (buffer[0]) {
+				bool clear_entry = false;
+
+				if (reason == DM_INIT_REASON_POWER_ON) {
+					if (buffer[1] > DM_PERSIST_POWER_ON_RESET) {
+						clear_entry = true;
+					}
+
+				} else {
+					if (buffer[1] > DM_PERSIST_IN_FLIGHT_RESET) {
+						clear_entry = true;
+					}
+				}
+
+				if (clear_entry) {
+					if (lseek(g_critical_fd, offset, SEEK_SET) != offset) {
+						return -1;
+					}
+
+					buffer[0] = 0;
+
+					if (write(g_critical_fd, buffer, 1) != 1) {
+						return -1;
+					}
+				}
+			}
+		}
+	}
+
+	fsync(g_critical_fd);
+	return result;
+}
+
+static int
+_critical_initialize()
+{
+	/* Lay out the critical keys behind the compat header */
+	unsigned offset = sizeof(struct dataman_compat_s);
+
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		if (g_key_critical[i]) {
+			g_critical_key_offsets[i] = offset;
+			offset += g_per_item_max_index[i] * g_per_item_size[i];
+		}
+	}
+
+	/* O_CREAT covers file-backed stand-ins in SITL; device nodes ignore it */
+	g_critical_fd = open(k_critical_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (g_critical_fd < 0) {
+		PX4_WARN("Could not open critical storage %s", k_critical_device_path);
+		return -1;
+	}
+
+	/* Check the layout hash, an incompatible store is zeroed */
+	struct dataman_compat_s compat_state;
+	ssize_t len = -1;
+
+	if (lseek(g_critical_fd, 0, SEEK_SET) == 0) {
+		len = read(g_critical_fd, &compat_state, sizeof(compat_state));
+	}
+
+	if (len != sizeof(compat_state) || compat_state.key != DM_COMPAT_KEY) {
+		uint8_t z[32] = {};
+		unsigned remaining = offset;
+
+		if (lseek(g_critical_fd, 0, SEEK_SET) != 0) {
+			close(g_critical_fd);
+			g_critical_fd = -1;
+			return -1;
+		}
+
+		while (remaining > 0) {
+			size_t chunk = (remaining < sizeof(z)) ? remaining : sizeof(z);
+
+			if (write(g_critical_fd, z, chunk) != (ssize_t)chunk) {
+				close(g_critical_fd);
+				g_critical_fd = -1;
+				return -1;
+			}
+
+			remaining -= chunk;
+		}
+	}
+
+	/* Write current compat info */
+	compat_state.key = DM_COMPAT_KEY;
+	len = -1;
+
+	if (lseek(g_critical_fd, 0, SEEK_SET) == 0) {
+		len = write(g_critical_fd, &compat_state, sizeof(compat_state));
+	}
+
+	if (len != sizeof(compat_state)) {
+		PX4_WARN("Could not write critical storage compat");
+		close(g_critical_fd);
+		g_critical_fd = -1;
+		return -1;
+	}
+
+	fsync(g_critical_fd);
+	return 0;
+}
+
+static void
+_critical_shutdown()
+{
+	if (g_critical_fd >= 0) {
+		close(g_critical_fd);
+		g_critical_fd = -1;
+	}
+}
+
+/* Route an operation to the critical tier or the bulk backend */
+static inline ssize_t
+backend_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
+{
+	return dm_key_is_critical(item) ? _critical_write(item, index, persistence, buf, count) :
+	       g_dm_ops->write(item, index, persistence, buf, count);
+}
+
+static inline ssize_t
+backend_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	return dm_key_is_critical(item) ? _critical_read(item, index, buf, count) :
+	       g_dm_ops->read(item, index, buf, count);
+}
+
+/* Mission state journal
+ *
+ * DM_KEY_MISSION_STATE is rewritten on every waypoint transition, which made
+ * one slot the hottest spot of the whole store. Writes now rotate through the
+ * item's DM_KEY_MISSION_STATE_MAX slots, each record carrying a sequence
+ * number prefix, and reads return the record with the newest sequence. Every
+ * save is still exactly one slot write, a write torn by power loss leaves the
+ * previous record intact, and the wear is spread across the slots. The public
+ * API is unchanged: callers keep reading and writing index 0.
+ *
+ * All of this runs on the single worker task, so no locking is needed.
+ */
+static uint16_t g_journal_seq;		/* sequence of the newest record, 0 = store empty */
+static int g_journal_slot = -1;		/* slot holding the newest record */
+static bool g_journal_scanned;		/* slot/sequence state reflects the store */
+
+/* Find the newest mission state record; the checkpoint after a backend
+ * (re)initialization, and cheap since the ring has only a few slots */
+static void
+_journal_scan()
+{
+	uint8_t buffer[g_per_item_size[DM_KEY_MISSION_STATE]];
+
+	g_journal_seq = 0;
+	g_journal_slot = -1;
+
+	for (unsigned i = 0; i < g_per_item_max_index[DM_KEY_MISSION_STATE]; i++) {
+		ssize_t len = backend_read(DM_KEY_MISSION_STATE, i, buffer, sizeof(buffer) - DM_SECTOR_HDR_SIZE);
+
+		if (len < (ssize_t)DM_JOURNAL_SEQ_SIZE) {
+			continue;
+		}
+
+		uint16_t seq;
+		memcpy(&seq, buffer, DM_JOURNAL_SEQ_SIZE);
+
+		/* sequence 0 marks an empty record; the comparison is wrap aware */
+		if (seq != 0 && (g_journal_slot < 0 || (int16_t)(seq - g_journal_seq) > 0)) {
+			g_journal_seq = seq;
+			g_journal_slot = i;
+		}
+	}
+
+	g_journal_scanned = true;
+}
+
+static ssize_t
+_journal_write(dm_persitence_t persistence, const void *buf, size_t count)
+{
+	if (count + DM_JOURNAL_SEQ_SIZE + DM_SECTOR_HDR_SIZE > g_per_item_size[DM_KEY_MISSION_STATE]) {
+		return -E2BIG;
+	}
+
+	if (!g_journal_scanned) {
+		_journal_scan();
+	}
+
+	uint8_t buffer[g_per_item_size[DM_KEY_MISSION_STATE]];
+	uint16_t seq = g_journal_seq + 1;
+
+	if (seq == 0) {
+		seq = 1;
+	}
+
+	memcpy(buffer, &seq, DM_JOURNAL_SEQ_SIZE);
+	memcpy(buffer + DM_JOURNAL_SEQ_SIZE, buf, count);
+
+	const unsigned slot = (unsigned)(g_journal_slot + 1) % g_per_item_max_index[DM_KEY_MISSION_STATE];
+
+	ssize_t ret = backend_write(DM_KEY_MISSION_STATE, slot, persistence, buffer, count + DM_JOURNAL_SEQ_SIZE);
+
+	if (ret < (ssize_t)(count + DM_JOURNAL_SEQ_SIZE)) {
+		/* the previous record is still intact, keep pointing at it */
+		return -1;
+	}
+
+	g_journal_seq = seq;
+	g_journal_slot = slot;
+
+	return (ssize_t)count;
+}
+
+static ssize_t
+_journal_read(void *buf, size_t count)
+{
+	if (!g_journal_scanned) {
+		_journal_scan();
+	}
+
+	if (g_journal_slot < 0) {
+		/* never written; same result as reading an empty slot */
+		return 0;
+	}
+
+	uint8_t buffer[g_per_item_size[DM_KEY_MISSION_STATE]];
+
+	if (count + DM_JOURNAL_SEQ_SIZE + DM_SECTOR_HDR_SIZE > sizeof(buffer)) {
+		return -E2BIG;
+	}
+
+	ssize_t len = backend_read(DM_KEY_MISSION_STATE, g_journal_slot, buffer, count + DM_JOURNAL_SEQ_SIZE);
+
+	if (len < (ssize_t)DM_JOURNAL_SEQ_SIZE) {
+		return (len < 0) ? len : 0;
+	}
+
+	len -= DM_JOURNAL_SEQ_SIZE;
+	memcpy(buf, buffer + DM_JOURNAL_SEQ_SIZE, len);
+
+	return len;
+}
+
+static inline ssize_t
+dispatch_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
+{
+	if (item == DM_KEY_MISSION_STATE) {
+		return _journal_write(persistence, buf, count);
+	}
+
+	return backend_write(item, index, persistence, buf, count);
+}
+
+static inline ssize_t
+dispatch_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	if (item == DM_KEY_MISSION_STATE) {
+		return _journal_read(buf, count);
+	}
+
+	return backend_read(item, index, buf, count);
+}
+
+static inline int
+dispatch_clear(dm_item_t item)
+{
+	int ret = dm_key_is_critical(item) ? _critical_clear(item) : g_dm_ops->clear(item);
+
+	if (item == DM_KEY_MISSION_STATE) {
+		g_journal_seq = 0;
+		g_journal_slot = -1;
+		g_journal_scanned = true;
+	}
+
+	return ret;
+}
+
+static inline int
+dispatch_restart(dm_reset_reason reason)
+{
+	int ret = g_dm_ops->restart(reason);
+
+	if (g_critical_fd >= 0) {
+		int critical_ret = _critical_restart(reason);
+
+		if (ret == 0) {
+			ret = critical_ret;
+		}
+	}
+
+	/* a restart may have invalidated mission state records */
+	g_journal_scanned = false;
+
+	return ret;
+}
+
+/** Write to the data manager file */
+__EXPORT ssize_t
+dm_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a write request */
+	if ((work = create_work_item()) == nullptr) {
+		return -1;
+	}
+
+	work->func = dm_write_func;
+	work->write_params.item = item;
+	work->write_params.index = index;
+	work->write_params.persistence = persistence;
+	work->write_params.buf = buf;
+	work->write_params.count = count;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+}
+
+/** Retrieve from the data manager file */
+__EXPORT ssize_t
+dm_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a read request */
+	if ((work = create_work_item()) == nullptr) {
+		return -1;
+	}
+
+	work->func = dm_read_func;
+	work->read_params.item = item;
+	work->read_params.index = index;
+	work->read_params.buf = buf;
+	work->read_params.count = count;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+}
+
+/** Retrieve a contiguous range of items in a single transaction */
+__EXPORT ssize_t
+dm_read_multiple(dm_item_t item, unsigned index, unsigned num_items, void *buf, size_t item_len)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a bulk read request */
+	if ((work = create_work_item()) == nullptr) {
+		return -1;
+	}
+
+	work->func = dm_read_multiple_func;
+	work->read_params.item = item;
+	work->read_params.index = index;
+	work->read_params.num_items = num_items;
+	work->read_params.buf = buf;
+	work->read_params.count = item_len;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+}
+
+/** Store a contiguous range of items in a single transaction */
+__EXPORT ssize_t
+dm_write_multiple(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, unsigned num_items,
+		  size_t item_len)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a bulk write request */
+	if ((work = create_work_item()) == nullptr) {
+		return -1;
+	}
+
+	work->func = dm_write_multiple_func;
+	work->write_params.item = item;
+	work->write_params.index = index;
+	work->write_params.num_items = num_items;
+	work->write_params.persistence = persistence;
+	work->write_params.buf = buf;
+	work->write_params.count = item_len;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+}
+
+/** Retrieve from the data manager store without blocking the caller */
+__EXPORT int
+dm_read_async(dm_item_t item, unsigned index, void *buf, size_t count, dm_callback_t callback, void *arg)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	if (callback == nullptr) {
+		return -1;
+	}
+
+	/* get a work item and queue up a read request */
+	if ((work = create_work_item()) == nullptr) {
+		return -1;
+	}
+
+	work->func = dm_read_func;
+	work->callback = callback;
+	work->callback_arg = arg;
+	work->read_params.item = item;
+	work->read_params.index = index;
+	work->read_params.buf = buf;
+	work->read_params.count = count;
+
+	/* Enqueue the item on the work queue, the worker thread runs the callback when done */
+	enqueue_work_item(work);
+
+	return 0;
+}
+
+/** Write to the data manager store without blocking the caller */
+__EXPORT int
+dm_write_async(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count,
+	       dm_callback_t callback, void *arg)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	if (callback == nullptr) {
+		return -1;
+	}
+
+	/* get a work item and queue up a write request */
+	if ((work = create_work_item()) == nullptr) {
+		return -1;
+	}
+
+	work->func = dm_write_func;
+	work->callback = callback;
+	work->callback_arg = arg;
+	work->write_params.item = item;
+	work->write_params.index = index;
+	work->write_params.persistence = persistence;
+	work->write_params.buf = buf;
+	work->write_params.count = count;
+
+	/* Enqueue the item on the work queue, the worker thread runs the callback when done */
+	enqueue_work_item(work);
+
+	return 0;
+}
+
+/** Clear a data Item */
+__EXPORT int
+dm_clear(dm_item_t item)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a clear request */
+	if ((work = create_work_item()) == nullptr) {
+		return -1;
+	}
+
+	work->func = dm_clear_func;
+	work->clear_params.item = item;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return enqueue_work_item_and_wait_for_result(work);
+}
+
+__EXPORT int
+dm_lock(dm_item_t item)
+{
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (item >= DM_KEY_NUM_KEYS) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (g_item_locks[item]) {
+		return px4_sem_wait(g_item_locks[item]);
+	}
+
+	errno = EINVAL;
+	return -1;
+}
+
+__EXPORT int
+dm_trylock(dm_item_t item)
+{
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (item >= DM_KEY_NUM_KEYS) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (g_item_locks[item]) {
+		return px4_sem_trywait(g_item_locks[item]);
+	}
+
+	errno = EINVAL;
+	return -1;
+}
+
+/** Unlock a data Item */
+__EXPORT void
+dm_unlock(dm_item_t item)
+{
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return;
+	}
+
+	if (item >= DM_KEY_NUM_KEYS) {
+		return;
+	}
+
+	if (g_item_locks[item]) {
+		px4_sem_post(g_item_locks[item]);
+	}
+}
+
+/** Tell the data manager about the type of the last reset */
+__EXPORT int
+dm_restart(dm_reset_reason reason)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	/* get a work item and queue up a restart request */
+	if ((work = create_work_item()) == nullptr) {
+		return -1;
+	}
+
+	work->func = dm_restart_func;
+	work->restart_params.reason = reason;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return enqueue_work_item_and_wait_for_result(work);
+}
+
+#if defined(FLASH_BASED_DATAMAN)
+__EXPORT int
+dm_flash_sector_description_set(const dm_sector_descriptor_t *description)
+{
+	k_dataman_flash_sector = description;
+	return 0;
+}
+#endif
+
+static int
+task_main(int argc, char *argv[])
+{
+	/* Dataman can use disk or RAM */
+	switch (backend) {
+	case BACKEND_FILE:
+		g_dm_ops = &dm_file_operations;
+		break;
+
+	case BACKEND_FILE_CACHE:
+		g_dm_ops = &dm_file_cache_operations;
+		break;
+
+	case BACKEND_RAM:
+		g_dm_ops = &dm_ram_operations;
+		break;
+
+#if defined(FLASH_BASED_DATAMAN)
+
+	case BACKEND_RAM_FLASH:
+		g_dm_ops = &dm_ram_flash_operations;
+		break;
+#endif
+
+	default:
+		PX4_WARN("No valid backend set.");
+		return -1;
+	}
+
+	work_q_item_t *work;
+
+	/* Initialize global variables */
+	g_key_offsets[0] = 0;
+
+	for (int i = 0; i < ((int)DM_KEY_NUM_KEYS - 1); i++) {
+		g_key_offsets[i + 1] = g_key_offsets[i] + (g_per_item_max_index[i] * g_per_item_size[i]);
+	}
+
+	g_key_slot_base[0] = 0;
+
+	for (int i = 0; i < ((int)DM_KEY_NUM_KEYS - 1); i++) {
+		g_key_slot_base[i + 1] = g_key_slot_base[i] + g_per_item_max_index[i];
+	}
+
+	unsigned max_offset = g_key_offsets[DM_KEY_NUM_KEYS - 1] + (g_per_item_max_index[DM_KEY_NUM_KEYS - 1] *
+			      g_per_item_size[DM_KEY_NUM_KEYS - 1]);
+
+	for (unsigned i = 0; i < dm_number_of_funcs; i++) {
+		g_func_counts[i] = 0;
+	}
+
+	/* Initialize the item type locks, for now only DM_KEY_MISSION_STATE & DM_KEY_FENCE_POINTS supports locking */
+	px4_sem_init(&g_sys_state_mutex_mission, 1, 1); /* Initially unlocked */
+	px4_sem_init(&g_sys_state_mutex_fence, 1, 1); /* Initially unlocked */
+
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		g_item_locks[i] = nullptr;
+	}
+
+	g_item_locks[DM_KEY_MISSION_STATE] = &g_sys_state_mutex_mission;
+	g_item_locks[DM_KEY_FENCE_POINTS] = &g_sys_state_mutex_fence;
+
+	g_task_should_exit = false;
+
+	init_q(&g_work_q);
+	init_q(&g_free_q);
+
+	px4_sem_init(&g_work_queued_sema, 1, 0);
+
+	/* g_work_queued_sema use case is a signal */
+
+	px4_sem_setprotocol(&g_work_queued_sema, SEM_PRIO_NONE);
+
+	/* see if we need to erase any items based on restart type */
+	int sys_restart_val;
 
 	const char *restart_type_str = "Unknown restart";
 
@@ -1324,14 +2252,19 @@ task_main(int argc, char *argv[])
 		goto end;
 	}
 
+	/* Bring up the critical tier; on failure critical keys just stay on the bulk backend */
+	if (k_critical_device_path != nullptr && _critical_initialize() != 0) {
+		PX4_WARN("critical storage tier disabled, using '%s' for all keys", k_data_manager_device_path);
+	}
+
 	if (param_get(param_find("SYS_RESTART_TYPE"), &sys_restart_val) == OK) {
 		if (sys_restart_val == DM_INIT_REASON_POWER_ON) {
 			restart_type_str = "Power on restart";
-			g_dm_ops->restart(DM_INIT_REASON_POWER_ON);
+			dispatch_restart(DM_INIT_REASON_POWER_ON);
 
 		} else if (sys_restart_val == DM_INIT_REASON_IN_FLIGHT) {
 			restart_type_str = "In flight restart";
-			g_dm_ops->restart(DM_INIT_REASON_IN_FLIGHT);
+			dispatch_restart(DM_INIT_REASON_IN_FLIGHT);
 		}
 	}
 
@@ -1344,6 +2277,11 @@ task_main(int argc, char *argv[])
 
 		break;
 
+	case BACKEND_FILE_CACHE:
+		PX4_INFO("%s, data manager cached file '%s' size is %d bytes",
+			 restart_type_str, k_data_manager_device_path, max_offset);
+		break;
+
 	case BACKEND_RAM:
 		PX4_INFO("%s, data manager RAM size is %d bytes",
 			 restart_type_str, max_offset);
@@ -1381,25 +2319,70 @@ task_main(int argc, char *argv[])
 			case dm_write_func:
 				g_func_counts[dm_write_func]++;
 				work->result =
-					g_dm_ops->write(work->write_params.item, work->write_params.index, work->write_params.persistence,
-							work->write_params.buf,
-							work->write_params.count);
+					dispatch_write(work->write_params.item, work->write_params.index, work->write_params.persistence,
+						       work->write_params.buf,
+						       work->write_params.count);
 				break;
 
 			case dm_read_func:
 				g_func_counts[dm_read_func]++;
 				work->result =
-					g_dm_ops->read(work->read_params.item, work->read_params.index, work->read_params.buf, work->read_params.count);
+					dispatch_read(work->read_params.item, work->read_params.index, work->read_params.buf, work->read_params.count);
 				break;
 
+			case dm_read_multiple_func: {
+					g_func_counts[dm_read_multiple_func]++;
+					ssize_t result = 0;
+
+					/* read all requested items in one trip through the worker */
+					for (unsigned i = 0; i < work->read_params.num_items; i++) {
+						ssize_t len = dispatch_read(work->read_params.item, work->read_params.index + i,
+									    (uint8_t *)work->read_params.buf + i * work->read_params.count,
+									    work->read_params.count);
+
+						if (len < 0) {
+							result = len;
+							break;
+						}
+
+						result++;
+					}
+
+					work->result = result;
+					break;
+				}
+
+			case dm_write_multiple_func: {
+					g_func_counts[dm_write_multiple_func]++;
+					ssize_t result = 0;
+
+					/* write all items in one trip through the worker */
+					for (unsigned i = 0; i < work->write_params.num_items; i++) {
+						ssize_t len = dispatch_write(work->write_params.item, work->write_params.index + i,
+									     work->write_params.persistence,
+									     (const uint8_t *)work->write_params.buf + i * work->write_params.count,
+									     work->write_params.count);
+
+						if (len != (ssize_t)work->write_params.count) {
+							result = (len < 0) ? len : -1;
+							break;
+						}
+
+						result++;
+					}
+
+					work->result = result;
+					break;
+				}
+
 			case dm_clear_func:
 				g_func_counts[dm_clear_func]++;
-				work->result = g_dm_ops->clear(work->clear_params.item);
+				work->result = dispatch_clear(work->clear_params.item);
 				break;
 
 			case dm_restart_func:
 				g_func_counts[dm_restart_func]++;
-				work->result = g_dm_ops->restart(work->restart_params.reason);
+				work->result = dispatch_restart(work->restart_params.reason);
 				break;
 
 			default: /* should never happen */
@@ -1407,8 +2390,16 @@ task_main(int argc, char *argv[])
 				break;
 			}
 
-			/* Inform the caller that work is done */
-			px4_sem_post(&work->wait_sem);
+			if (work->callback) {
+				/* asynchronous request: nobody is waiting on the item,
+				 * run the completion callback and recycle it here */
+				work->callback(work->result, work->callback_arg);
+				destroy_work_item(work);
+
+			} else {
+				/* Inform the caller that work is done */
+				px4_sem_post(&work->wait_sem);
+			}
 		}
 
 		/* time to go???? */
@@ -1418,6 +2409,7 @@ task_main(int argc, char *argv[])
 	}
 
 	g_dm_ops->shutdown();
+	_critical_shutdown();
 
 	/* The work queue is now empty, empty the free queue */
 	for (;;) {
@@ -1471,9 +2463,15 @@ status()
 	/* display usage statistics */
 	PX4_INFO("Writes   %d", g_func_counts[dm_write_func]);
 	PX4_INFO("Reads    %d", g_func_counts[dm_read_func]);
+	PX4_INFO("Bulk reads %d", g_func_counts[dm_read_multiple_func]);
+	PX4_INFO("Bulk writes %d", g_func_counts[dm_write_multiple_func]);
 	PX4_INFO("Clears   %d", g_func_counts[dm_clear_func]);
 	PX4_INFO("Restarts %d", g_func_counts[dm_restart_func]);
 	PX4_INFO("Max Q lengths work %d, free %d", g_work_q.max_size, g_free_q.max_size);
+
+	if (g_critical_fd >= 0) {
+		PX4_INFO("Critical keys on %s", k_critical_device_path);
+	}
 }
 
 static void
@@ -1504,6 +2502,9 @@ Each type has a specific type and a fixed maximum amount of storage items, so th
 Reading and writing a single item is always atomic. If multiple items need to be read/modified atomically, there is
 an additional lock per item type via `dm_lock`.
 
+With `-m` a storage tier is added on top of the chosen backend: small critical keys (currently the mission state)
+are kept on a dedicated FRAM/MTD device with synchronous writes, so their updates do not stall on SD card access.
+
 **DM_KEY_FENCE_POINTS** and **DM_KEY_SAFE_POINTS** items: the first data element is a `mission_stats_entry_s` struct,
 which stores the number of items for these types. These items are always updated atomically in one transaction (from
 the mavlink mission manager). During that time, navigator will try to acquire the geofence item lock, fail, and will not
@@ -1514,6 +2515,8 @@ check for geofence violations.
 	PRINT_MODULE_USAGE_NAME("dataman", "system");
 	PRINT_MODULE_USAGE_COMMAND("start");
 	PRINT_MODULE_USAGE_PARAM_STRING('f', nullptr, "<file>", "Storage file", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('c', "Keep a write-back RAM cache of the file backend (reads are memory-speed, writes are batched)", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('m', nullptr, "<device>", "Keep critical state (mission state) on this FRAM/MTD device", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('r', "Use RAM backend (NOT persistent)", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('i', "Use FLASH backend", true);
 	PRINT_MODULE_USAGE_PARAM_COMMENT("The options -f, -r and -i are mutually exclusive. If nothing is specified, a file 'dataman' is used");
@@ -1552,10 +2555,11 @@ dataman_main(int argc, char *argv[])
 		int ch;
 		int dmoptind = 1;
 		const char *dmoptarg = nullptr;
+		bool file_cache = false;
 
 		/* jump over start and look at options first */
 
-		while ((ch = px4_getopt(argc, argv, "f:ri", &dmoptind, &dmoptarg)) != EOF) {
+		while ((ch = px4_getopt(argc, argv, "f:cm:ri", &dmoptind, &dmoptarg)) != EOF) {
 			switch (ch) {
 			case 'f':
 				if (backend_check()) {
@@ -1567,6 +2571,15 @@ dataman_main(int argc, char *argv[])
 				PX4_INFO("dataman file set to: %s", k_data_manager_device_path);
 				break;
 
+			case 'c':
+				file_cache = true;
+				break;
+
+			case 'm':
+				k_critical_device_path = strdup(dmoptarg);
+				PX4_INFO("dataman critical storage set to: %s", k_critical_device_path);
+				break;
+
 			case 'r':
 				if (backend_check()) {
 					return -1;
@@ -1605,12 +2618,23 @@ dataman_main(int argc, char *argv[])
 			k_data_manager_device_path = strdup(default_device_path);
 		}
 
+		if (file_cache) {
+			if (backend != BACKEND_FILE) {
+				PX4_WARN("-c is only valid with the file backend");
+				return -1;
+			}
+
+			backend = BACKEND_FILE_CACHE;
+		}
+
 		start();
 
 		if (!is_running()) {
 			PX4_ERR("dataman start failed");
 			free(k_data_manager_device_path);
 			k_data_manager_device_path = nullptr;
+			free(k_critical_device_path);
+			k_critical_device_path = nullptr;
 			return -1;
 		}
 
@@ -1628,6 +2652,8 @@ dataman_main(int argc, char *argv[])
 		stop();
 		free(k_data_manager_device_path);
 		k_data_manager_device_path = nullptr;
+		free(k_critical_device_path);
+		k_critical_device_path = nullptr;
 
 	} else if (!strcmp(argv[1], "status")) {
 		status();
@@ -67,7 +67,7 @@ enum {
 	DM_KEY_WAYPOINTS_OFFBOARD_0_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_WAYPOINTS_OFFBOARD_1_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_WAYPOINTS_ONBOARD_MAX = (NUM_MISSIONS_SUPPORTED / 10),
-	DM_KEY_MISSION_STATE_MAX = 1,
+	DM_KEY_MISSION_STATE_MAX = 2,	/* journal ring, see dataman.cpp; callers use index 0 */
 	DM_KEY_COMPAT_MAX = 1
 };
 #else
@@ -78,7 +78,7 @@ enum {
 	DM_KEY_WAYPOINTS_OFFBOARD_0_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_WAYPOINTS_OFFBOARD_1_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_WAYPOINTS_ONBOARD_MAX = NUM_MISSIONS_SUPPORTED,
-	DM_KEY_MISSION_STATE_MAX = 1,
+	DM_KEY_MISSION_STATE_MAX = 4,	/* journal ring, see dataman.cpp; callers use index 0 */
 	DM_KEY_COMPAT_MAX = 1
 };
 #endif
@@ -101,13 +101,18 @@ struct dataman_compat_s {
 };
 
 /* increment this define whenever a binary incompatible change is performed */
-#define DM_COMPAT_VERSION	1ULL
+#define DM_COMPAT_VERSION	2ULL
 
 #define DM_COMPAT_KEY ((DM_COMPAT_VERSION << 32) + (sizeof(struct mission_item_s) << 24) + \
 		       (sizeof(struct mission_s) << 16) + (sizeof(struct mission_stats_entry_s) << 12) + \
 		       (sizeof(struct mission_fence_point_s) << 8) + (sizeof(struct mission_save_point_s) << 4) + \
 		       sizeof(struct dataman_compat_s))
 
+/** Completion callback for asynchronous operations. Runs on the data manager
+ * worker task, so keep it short and do not call blocking dataman functions
+ * other than the _async variants from it. */
+typedef void (*dm_callback_t)(ssize_t result, void *arg);
+
 /** Retrieve from the data manager store */
 __EXPORT ssize_t
 dm_read(
@@ -117,6 +122,17 @@ dm_read(
 	size_t buflen			/* Length in bytes of data to retrieve */
 );
 
+/** Retrieve a contiguous range of items from the data manager store in a single transaction.
+ * Returns the number of items read, or < 0 on error. */
+__EXPORT ssize_t
+dm_read_multiple(
+	dm_item_t item,			/* The item type to retrieve */
+	unsigned index,			/* The index of the first item */
+	unsigned num_items,		/* The number of consecutive items to retrieve */
+	void *buffer,			/* Pointer to caller data buffer, num_items * item_len bytes */
+	size_t item_len			/* Length in bytes of each item */
+);
+
 /** write to the data manager store */
 __EXPORT ssize_t
 dm_write(
@@ -127,6 +143,45 @@ dm_write(
 	size_t buflen			/* Length in bytes of data to retrieve */
 );
 
+/** Store a contiguous range of items in the data manager store in a single transaction.
+ * Returns the number of items written, or < 0 on error. */
+__EXPORT ssize_t
+dm_write_multiple(
+	dm_item_t item,			/* The item type to store */
+	unsigned index,			/* The index of the first item */
+	dm_persitence_t persistence,	/* The persistence level of the items */
+	const void *buffer,		/* Pointer to caller data buffer, num_items * item_len bytes */
+	unsigned num_items,		/* The number of consecutive items to store */
+	size_t item_len			/* Length in bytes of each item */
+);
+
+/** Retrieve from the data manager store without blocking the caller.
+ * The buffer must stay valid until the callback has run.
+ * Returns 0 if the request was queued, < 0 on error. */
+__EXPORT int
+dm_read_async(
+	dm_item_t item,			/* The item type to retrieve */
+	unsigned index,			/* The index of the item */
+	void *buffer,			/* Pointer to caller data buffer */
+	size_t buflen,			/* Length in bytes of data to retrieve */
+	dm_callback_t callback,		/* Called with the read result when done */
+	void *arg			/* Passed through to the callback */
+);
+
+/** Write to the data manager store without blocking the caller.
+ * The buffer must stay valid until the callback has run.
+ * Returns 0 if the request was queued, < 0 on error. */
+__EXPORT int
+dm_write_async(
+	dm_item_t  item,		/* The item type to store */
+	unsigned index,			/* The index of the item */
+	dm_persitence_t persistence,	/* The persistence level of this item */
+	const void *buffer,		/* Pointer to caller data buffer */
+	size_t buflen,			/* Length in bytes of data to store */
+	dm_callback_t callback,		/* Called with the write result when done */
+	void *arg			/* Passed through to the callback */
+);
+
 /**
  * Lock all items of a type. Can be used for atomic updates of multiple items (single items are always updated
  * atomically).
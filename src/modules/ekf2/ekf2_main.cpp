@@ -48,6 +48,8 @@
 #include <cfloat>
 
 #include <systemlib/systemlib.h>
+#include <systemlib/perf_counter.h>
+#include <systemlib/scope_trace.h>
 #include <mathlib/mathlib.h>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 #include <drivers/drv_hrt.h>
@@ -83,8 +85,8 @@ extern "C" __EXPORT int ekf2_main(int argc, char *argv[]);
 class Ekf2 : public control::SuperBlock, public ModuleBase<Ekf2>
 {
 public:
-	Ekf2();
-	~Ekf2() override = default;
+	Ekf2(int instance = 0);
+	~Ekf2() override;
 
 	/** @see ModuleBase */
 	static int task_spawn(int argc, char *argv[]);
@@ -108,6 +110,10 @@ public:
 	int print_status() override;
 
 private:
+	static constexpr int MAX_INSTANCES = 2;	///< primary plus one redundant estimator
+
+	const int _instance;			///< index of this estimator instance
+
 	bool 	_replay_mode = false;			///< true when we use replay data from a log
 
 	// time slip monitoring
@@ -329,10 +335,113 @@ private:
 	control::BlockParamFloat _K_pstatic_coef_y;	///< static pressure position error coefficient along the Y body axis
 	control::BlockParamFloat _K_pstatic_coef_z;	///< static pressure position error coefficient along the Z body axis
 
+	control::BlockParamInt
+	_fusion_slot_budget;	///< measurement pushes into the EKF buffers allowed per IMU cycle, 0 disables the scheduler
+
+	control::BlockParamInt
+	_att_pub_rate;	///< maximum vehicle_attitude publication rate (Hz), 0 = publish every fusion cycle
+
+	// vehicle_attitude output decimation: the current-time attitude is produced at IMU
+	// rate by the output predictor whether or not anyone consumes it. When EKF2_ATT_RATE
+	// is set, the copy-out and publication are decimated to that rate, and skipped
+	// entirely while the topic has no subscribers (re-checked at 1 Hz, so a late
+	// subscriber sees data within a second).
+	uint64_t _att_pub_last = 0;		///< timestamp of the last vehicle_attitude publication (uSec)
+	hrt_abstime _att_sub_check_time = 0;	///< when subscriber presence was last polled
+	bool _att_has_subscribers = true;	///< result of the last subscriber presence poll
+
+	// GPS blending: with two receivers fitted (e.g. an RTK unit paired with a standard
+	// one) the individual vehicle_gps_position instances are combined into a single
+	// stream weighted by the accuracy each receiver reports, instead of discarding the
+	// secondary. A receiver that loses its fix or stops publishing leaves the blend
+	// immediately; only the relative weighting is filtered.
+	static constexpr int GPS_MAX_RECEIVERS = 2;	///< receiver instances monitored for blending
+	static constexpr uint64_t GPS_BLEND_TIMEOUT_US = 1000 * 1000;	///< receiver is dead after this silence (uSec)
+
+	control::BlockParamInt _gps_blend_mask;		///< accuracy metrics used to weight the receivers
+	control::BlockParamFloat _gps_blend_tau;	///< blend weight filter time constant (sec)
+
+	vehicle_gps_position_s _gps_data[GPS_MAX_RECEIVERS] = {};	///< latest data from each receiver
+	float _gps_blend_weight[GPS_MAX_RECEIVERS] = {};	///< filtered contribution of each receiver
+	uint64_t _gps_blend_time_us = 0;	///< time of the last blend weight update (uSec)
+	bool _gps_blending = false;		///< true while more than one receiver contributes
+
+	/** combine the available receivers into gps_out.
+	 * @return true if gps_out holds usable data */
+	bool blend_gps_data(vehicle_gps_position_s &gps_out);
+
+	// budgeted measurement scheduler: when EKF2_FUSE_SLOTS > 0 the number of measurement
+	// pushes into the EKF buffers is limited per IMU cycle, staggering the matching fusion
+	// steps across cycles instead of letting them land on the same one. The covariance
+	// prediction always runs at IMU rate.
+	enum {
+		FUSE_SRC_MAG = 0,
+		FUSE_SRC_BARO,
+		FUSE_SRC_GPS,
+		FUSE_SRC_AIRSPEED,
+		FUSE_SRC_FLOW,
+		FUSE_SRC_RANGE,
+		FUSE_SRC_EV,
+		FUSE_SRC_COUNT
+	};
+
+	static constexpr uint8_t FUSE_MAX_DEFER_CYCLES =
+		3;	///< upper bound on the latency the scheduler may add to any measurement (IMU cycles)
+
+	int _fusion_slots_used = 0;				///< measurement pushes granted in the current cycle
+	uint8_t _fusion_defer_count[FUSE_SRC_COUNT] = {};	///< consecutive cycles each source has been deferred
+
+	/** request a measurement push slot for the current cycle.
+	 * @return true if the measurement may be pushed now, false if it has to wait for a later cycle */
+	bool take_fusion_slot(int source);
+
+	// output selector: when a redundant instance is running, only the instance with the
+	// better innovation consistency publishes the topics the controllers consume. The
+	// state below is shared between the instance tasks; each instance only writes its
+	// own slot and the non-selected instance is the only writer of _selected_instance.
+	static constexpr float SELECTOR_RATIO_GAIN = 0.7f;	///< candidate must beat the selected ratio by this factor
+	static constexpr uint64_t SELECTOR_TIMEOUT_US = 500 * 1000;	///< selected instance is dead after this silence
+	static constexpr uint64_t SELECTOR_HOLD_US = 1000 * 1000;	///< candidate must be better for this long
+
+	static volatile int _selected_instance;			///< instance whose output feeds the controllers
+	static float _test_ratio_filt[MAX_INSTANCES];		///< filtered innovation test ratio sum per instance
+	static hrt_abstime _last_status_time[MAX_INSTANCES];	///< last estimator status wallclock time per instance
+
+	hrt_abstime _better_since = 0;	///< time this instance started looking healthier than the selected one
+
+	/** feed this instance's innovation consistency into the output selector */
+	void update_selector(const estimator_status_s &status, hrt_abstime now);
+
+	/** trim the delay horizon to the aiding sources actually configured, before
+	 * the EKF sizes its delay ring buffers from it */
+	void trim_delay_horizon();
+
+	uint32_t _delay_horizon_ms = 0;		///< effective max sensor delay the buffers have to cover (mSec)
+	uint32_t _obs_buffer_slots = 0;		///< resulting observation buffer length per source
+
+	bool is_selected() const { return _selected_instance == _instance; }
+
+	// redundant instance task management
+	static Ekf2 *_secondary;		///< the redundant estimator instance, if running
+	static int _secondary_task_id;
+
+	static int secondary_trampoline(int argc, char *argv[]);
+
+	perf_counter_t _cycle_perf;		///< time from IMU sample reception to the end of the cycle
+	perf_counter_t _ekf_update_perf;	///< time spent in the EKF prediction and fusion steps
+	perf_counter_t _fusion_defer_perf;	///< number of measurement pushes deferred to a later cycle
+
 };
 
-Ekf2::Ekf2():
+Ekf2 *Ekf2::_secondary = nullptr;
+int Ekf2::_secondary_task_id = -1;
+volatile int Ekf2::_selected_instance = 0;
+float Ekf2::_test_ratio_filt[Ekf2::MAX_INSTANCES] = {};
+hrt_abstime Ekf2::_last_status_time[Ekf2::MAX_INSTANCES] = {};
+
+Ekf2::Ekf2(int instance):
 	SuperBlock(nullptr, "EKF"),
+	_instance(instance),
 	_replay_mode(false),
 	_att_pub(nullptr),
 	_control_state_pub(nullptr),
@@ -447,8 +556,312 @@ Ekf2::Ekf2():
 	_K_pstatic_coef_xp(this, "EKF2_PCOEF_XP", false),
 	_K_pstatic_coef_xn(this, "EKF2_PCOEF_XN", false),
 	_K_pstatic_coef_y(this, "EKF2_PCOEF_Y", false),
-	_K_pstatic_coef_z(this, "EKF2_PCOEF_Z", false)
+	_K_pstatic_coef_z(this, "EKF2_PCOEF_Z", false),
+	_fusion_slot_budget(this, "EKF2_FUSE_SLOTS", false),
+	_att_pub_rate(this, "EKF2_ATT_RATE", false),
+	_gps_blend_mask(this, "EKF2_GPS_MASK", false),
+	_gps_blend_tau(this, "EKF2_GPS_TAU", false),
+	_cycle_perf(perf_alloc(PC_ELAPSED, instance == 0 ? "ekf2 cycle" : "ekf2_1 cycle")),
+	_ekf_update_perf(perf_alloc(PC_ELAPSED, instance == 0 ? "ekf2 update" : "ekf2_1 update")),
+	_fusion_defer_perf(perf_alloc(PC_COUNT, instance == 0 ? "ekf2 fusion deferrals" : "ekf2_1 fusion deferrals"))
+{
+}
+
+Ekf2::~Ekf2()
+{
+	perf_free(_cycle_perf);
+	perf_free(_ekf_update_perf);
+	perf_free(_fusion_defer_perf);
+}
+
+bool Ekf2::take_fusion_slot(int source)
+{
+	if (_fusion_slot_budget.get() <= 0) {
+		// scheduler disabled: push measurements as they arrive
+		return true;
+	}
+
+	// a source that has waited its maximum number of cycles goes through even when
+	// over budget, bounding the latency the scheduler adds to the measurement delay
+	if (_fusion_slots_used < _fusion_slot_budget.get()
+	    || _fusion_defer_count[source] >= FUSE_MAX_DEFER_CYCLES) {
+		_fusion_slots_used++;
+		_fusion_defer_count[source] = 0;
+		return true;
+	}
+
+	_fusion_defer_count[source]++;
+	perf_count(_fusion_defer_perf);
+	return false;
+}
+
+void Ekf2::update_selector(const estimator_status_s &status, hrt_abstime now)
 {
+	// low pass the summed innovation test ratios so a single spike cannot trigger a switch
+	const float ratio = status.vel_test_ratio + status.pos_test_ratio + status.hgt_test_ratio;
+	_test_ratio_filt[_instance] = 0.9f * _test_ratio_filt[_instance] + 0.1f * ratio;
+	_last_status_time[_instance] = now;
+
+	const int selected = _selected_instance;
+
+	if (selected == _instance) {
+		_better_since = 0;
+		return;
+	}
+
+	// take over immediately when the selected instance has stopped producing output
+	if (now - _last_status_time[selected] > SELECTOR_TIMEOUT_US) {
+		PX4_WARN("estimator instance %d timed out, switching output to instance %d", selected, _instance);
+		_selected_instance = _instance;
+		_better_since = 0;
+		return;
+	}
+
+	// otherwise require a clearly and persistently better innovation consistency
+	if (_test_ratio_filt[_instance] < SELECTOR_RATIO_GAIN * _test_ratio_filt[selected]) {
+		if (_better_since == 0) {
+			_better_since = now;
+
+		} else if (now - _better_since > SELECTOR_HOLD_US) {
+			PX4_INFO("estimator output switched to the healthier instance %d", _instance);
+			_selected_instance = _instance;
+			_better_since = 0;
+		}
+
+	} else {
+		_better_since = 0;
+	}
+}
+
+bool Ekf2::blend_gps_data(vehicle_gps_position_s &gps_out)
+{
+	// the newest receiver timestamp is the time reference; wallclock would
+	// break replay
+	uint64_t now = 0;
+
+	for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+		if (_gps_data[i].timestamp > now) {
+			now = _gps_data[i].timestamp;
+		}
+	}
+
+	// a receiver takes part while it has a current 3D fix
+	bool used[GPS_MAX_RECEIVERS];
+	int n_used = 0;
+
+	for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+		used[i] = (_gps_data[i].timestamp != 0)
+			  && (now - _gps_data[i].timestamp < GPS_BLEND_TIMEOUT_US)
+			  && (_gps_data[i].fix_type >= 3);
+
+		if (used[i]) {
+			n_used++;
+
+		} else {
+			// degraded receivers leave the blend at once, not through the filter
+			_gps_blend_weight[i] = 0.0f;
+		}
+	}
+
+	if (n_used == 0) {
+		_gps_blending = false;
+		return false;
+	}
+
+	if (n_used == 1 || _gps_blend_mask.get() == 0) {
+		// single receiver (or blending disabled): lowest numbered healthy
+		// receiver wins, matching the previous single-subscription behaviour
+		for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+			if (used[i]) {
+				gps_out = _gps_data[i];
+				_gps_blend_weight[i] = 1.0f;
+				break;
+			}
+		}
+
+		_gps_blending = false;
+		_gps_blend_time_us = now;
+		return true;
+	}
+
+	// instantaneous weights: inverse variance of each accuracy metric the
+	// receivers report, averaged over the metrics enabled in EKF2_GPS_MASK
+	float weight_new[GPS_MAX_RECEIVERS] = {};
+	int n_metrics = 0;
+
+	for (int metric = 0; metric < 3; metric++) {
+		if (!(_gps_blend_mask.get() & (1 << metric))) {
+			continue;
+		}
+
+		float inv_var[GPS_MAX_RECEIVERS] = {};
+		float inv_var_sum = 0.0f;
+
+		for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+			if (!used[i]) {
+				continue;
+			}
+
+			float acc = 0.0f;
+
+			switch (metric) {
+			case 0:	acc = _gps_data[i].eph; break;
+			case 1:	acc = _gps_data[i].epv; break;
+			case 2:	acc = _gps_data[i].s_variance_m_s; break;
+			}
+
+			acc = fmaxf(acc, 0.01f);
+			inv_var[i] = 1.0f / (acc * acc);
+			inv_var_sum += inv_var[i];
+		}
+
+		for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+			weight_new[i] += inv_var[i] / inv_var_sum;
+		}
+
+		n_metrics++;
+	}
+
+	for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+		weight_new[i] /= n_metrics;
+	}
+
+	// filter the relative weighting so the blended reference does not jump
+	// with every accuracy report, then renormalise
+	float dt = math::constrain((now - _gps_blend_time_us) * 1e-6f, 0.0f, 1.0f);
+	_gps_blend_time_us = now;
+
+	const float tau = fmaxf(_gps_blend_tau.get(), 1.0f);
+	const float alpha = dt / (tau + dt);
+
+	float weight_sum = 0.0f;
+
+	for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+		if (used[i]) {
+			_gps_blend_weight[i] += alpha * (weight_new[i] - _gps_blend_weight[i]);
+			weight_sum += _gps_blend_weight[i];
+		}
+	}
+
+	if (weight_sum < 1e-6f) {
+		// freshly reset filter with a repeated timestamp; fall back to the
+		// instantaneous weights for this update
+		for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+			_gps_blend_weight[i] = used[i] ? weight_new[i] : 0.0f;
+		}
+
+	} else {
+		for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+			_gps_blend_weight[i] /= weight_sum;
+		}
+	}
+
+	// discrete fields (fix type, satellite count, UTC time) come from the
+	// dominant receiver, continuous fields are the weighted mean; the integer
+	// lat/lon/alt stay exact in double
+	int best = 0;
+
+	for (int i = 1; i < GPS_MAX_RECEIVERS; i++) {
+		if (_gps_blend_weight[i] > _gps_blend_weight[best]) {
+			best = i;
+		}
+	}
+
+	gps_out = _gps_data[best];
+
+	double lat = 0.0;
+	double lon = 0.0;
+	double alt = 0.0;
+	float vel_n = 0.0f;
+	float vel_e = 0.0f;
+	float vel_d = 0.0f;
+	float eph = 0.0f;
+	float epv = 0.0f;
+	float sacc = 0.0f;
+	bool vel_ned_valid = true;
+
+	for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+		if (!used[i]) {
+			continue;
+		}
+
+		const float w = _gps_blend_weight[i];
+
+		lat += (double)w * _gps_data[i].lat;
+		lon += (double)w * _gps_data[i].lon;
+		alt += (double)w * _gps_data[i].alt;
+		vel_n += w * _gps_data[i].vel_n_m_s;
+		vel_e += w * _gps_data[i].vel_e_m_s;
+		vel_d += w * _gps_data[i].vel_d_m_s;
+		eph += w * _gps_data[i].eph;
+		epv += w * _gps_data[i].epv;
+		sacc += w * _gps_data[i].s_variance_m_s;
+		vel_ned_valid = vel_ned_valid && _gps_data[i].vel_ned_valid;
+	}
+
+	gps_out.timestamp = now;
+	gps_out.lat = (int32_t)(lat >= 0.0 ? lat + 0.5 : lat - 0.5);
+	gps_out.lon = (int32_t)(lon >= 0.0 ? lon + 0.5 : lon - 0.5);
+	gps_out.alt = (int32_t)(alt >= 0.0 ? alt + 0.5 : alt - 0.5);
+	gps_out.vel_n_m_s = vel_n;
+	gps_out.vel_e_m_s = vel_e;
+	gps_out.vel_d_m_s = vel_d;
+	gps_out.vel_m_s = sqrtf(vel_n * vel_n + vel_e * vel_e + vel_d * vel_d);
+	gps_out.eph = eph;
+	gps_out.epv = epv;
+	gps_out.s_variance_m_s = sacc;
+	gps_out.vel_ned_valid = vel_ned_valid;
+
+	_gps_blending = true;
+	return true;
+}
+
+void Ekf2::trim_delay_horizon()
+{
+	// the ring buffers have to cover the largest configured delay of any
+	// aiding source. Delays of sources that are disabled by configuration
+	// only grow the buffers and add RAM cost, so zero them before the EKF
+	// sizes the buffers (bit assignments per the EKF2_AID_MASK docs).
+	const int32_t aid_mask = _fusion_mode.get();
+
+	if (!(aid_mask & (1 << 0)) && _gps_delay_ms.get() > 0.0f) {
+		PX4_INFO("GPS fusion disabled, ignoring EKF2_GPS_DELAY");
+		_params->gps_delay_ms = 0.0f;
+	}
+
+	if (!(aid_mask & (1 << 1)) && _flow_delay_ms.get() > 0.0f) {
+		PX4_INFO("flow fusion disabled, ignoring EKF2_OF_DELAY");
+		_params->flow_delay_ms = 0.0f;
+	}
+
+	if (!(aid_mask & ((1 << 3) | (1 << 4))) && _ev_delay_ms.get() > 0.0f) {
+		PX4_INFO("vision fusion disabled, ignoring EKF2_EV_DELAY");
+		_params->ev_delay_ms = 0.0f;
+	}
+
+	if (_arspFusionThreshold.get() < FLT_EPSILON && _airspeed_delay_ms.get() > 0.0f) {
+		PX4_INFO("airspeed fusion disabled, ignoring EKF2_ASP_DELAY");
+		_params->airspeed_delay_ms = 0.0f;
+	}
+
+	float max_delay_ms = math::max(_params->mag_delay_ms, _params->baro_delay_ms);
+	max_delay_ms = math::max(max_delay_ms, _params->gps_delay_ms);
+	max_delay_ms = math::max(max_delay_ms, _params->flow_delay_ms);
+	max_delay_ms = math::max(max_delay_ms, _params->range_delay_ms);
+	max_delay_ms = math::max(max_delay_ms, _params->airspeed_delay_ms);
+	max_delay_ms = math::max(max_delay_ms, _params->ev_delay_ms);
+
+	_delay_horizon_ms = (uint32_t)max_delay_ms;
+
+	const float min_interval_ms = math::max((float)_params->sensor_interval_min_ms, 1.0f);
+	_obs_buffer_slots = (uint32_t)(_delay_horizon_ms / min_interval_ms) + 1;
+
+	// a long horizon is not just RAM: everything fused at the delayed horizon
+	// adds that much latency before corrections reach the output predictor
+	if (_delay_horizon_ms > 250) {
+		PX4_WARN("delay horizon %u ms is unusually long, check the EKF2_*_DELAY settings",
+			 _delay_horizon_ms);
+	}
 }
 
 int Ekf2::print_status()
@@ -456,6 +869,28 @@ int Ekf2::print_status()
 	PX4_INFO("local position OK %s", (_ekf.local_position_is_valid()) ? "yes" : "no");
 	PX4_INFO("global position OK %s", (_ekf.global_position_is_valid()) ? "yes" : "no");
 	PX4_INFO("time slip: %" PRIu64 " us", _last_time_slip_us);
+	PX4_INFO("delay horizon: %u ms (%u observation buffer slots per source)",
+		 _delay_horizon_ms, _obs_buffer_slots);
+
+	if (_gps_blending) {
+		PX4_INFO("GPS blend weights: %.2f / %.2f",
+			 (double)_gps_blend_weight[0], (double)_gps_blend_weight[1]);
+	}
+
+	if (_instance == 0 && _secondary_task_id != -1) {
+		PX4_INFO("selected instance: %d (test ratios: %.3f / %.3f)", _selected_instance,
+			 (double)_test_ratio_filt[0], (double)_test_ratio_filt[1]);
+	}
+
+	perf_print_counter(_cycle_perf);
+	perf_print_counter(_ekf_update_perf);
+	perf_print_counter(_fusion_defer_perf);
+
+	if (_instance == 0 && _secondary != nullptr) {
+		PX4_INFO("redundant instance:");
+		_secondary->print_status();
+	}
+
 	return 0;
 }
 
@@ -463,7 +898,12 @@ void Ekf2::run()
 {
 	// subscribe to relevant topics
 	int sensors_sub = orb_subscribe(ORB_ID(sensor_combined));
-	int gps_sub = orb_subscribe(ORB_ID(vehicle_gps_position));
+	int gps_subs[GPS_MAX_RECEIVERS];
+
+	for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+		gps_subs[i] = orb_subscribe_multi(ORB_ID(vehicle_gps_position), i);
+	}
+
 	int airspeed_sub = orb_subscribe(ORB_ID(airspeed));
 	int params_sub = orb_subscribe(ORB_ID(parameter_update));
 	int optical_flow_sub = orb_subscribe(ORB_ID(optical_flow));
@@ -482,6 +922,10 @@ void Ekf2::run()
 	// initialise parameter cache
 	updateParams();
 
+	// the EKF sizes its delay ring buffers from the configured delays on its
+	// first update, so the horizon has to be trimmed before any data is pushed
+	trim_delay_horizon();
+
 	// initialize data structures outside of loop
 	// because they will else not always be
 	// properly populated
@@ -498,6 +942,15 @@ void Ekf2::run()
 	sensor_baro_s sensor_baro = {};
 	sensor_baro.pressure = 1013.5; // initialise pressure to sea level
 
+	// trace zones for the phases of the update cycle, armed via the
+	// 'scope_trace' command; disarmed they cost a flag test per phase
+	const int trace_mag = scope_trace_register("ekf2_mag");
+	const int trace_baro = scope_trace_register("ekf2_baro");
+	const int trace_gps = scope_trace_register("ekf2_gps");
+	const int trace_aux = scope_trace_register("ekf2_aux");
+	const int trace_update = scope_trace_register("ekf2_update");
+	const int trace_outputs = scope_trace_register("ekf2_outputs");
+
 	while (!should_exit()) {
 		int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), 1000);
 
@@ -538,6 +991,12 @@ void Ekf2::run()
 		bool vehicle_status_updated = false;
 
 		orb_copy(ORB_ID(sensor_combined), sensors_sub, &sensors);
+
+		perf_begin(_cycle_perf);
+
+		// a new cycle starts with a fresh measurement push budget
+		_fusion_slots_used = 0;
+
 		// update all other topics if they have new data
 
 		orb_check(status_sub, &vehicle_status_updated);
@@ -546,14 +1005,36 @@ void Ekf2::run()
 			orb_copy(ORB_ID(vehicle_status), status_sub, &vehicle_status);
 		}
 
-		orb_check(gps_sub, &gps_updated);
+		bool gps_instance_updated[GPS_MAX_RECEIVERS];
+
+		for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+			gps_instance_updated[i] = false;
+			orb_check(gps_subs[i], &gps_instance_updated[i]);
+			gps_updated |= gps_instance_updated[i];
+		}
+
+		if (gps_updated && !take_fusion_slot(FUSE_SRC_GPS)) {
+			// leave the data in the queue for the next cycle
+			gps_updated = false;
+		}
 
 		if (gps_updated) {
-			orb_copy(ORB_ID(vehicle_gps_position), gps_sub, &gps);
+			for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+				if (gps_instance_updated[i]) {
+					orb_copy(ORB_ID(vehicle_gps_position), gps_subs[i], &_gps_data[i]);
+				}
+			}
+
+			// combine the receivers into a single quality-weighted stream
+			gps_updated = blend_gps_data(gps);
 		}
 
 		orb_check(airspeed_sub, &airspeed_updated);
 
+		if (airspeed_updated && !take_fusion_slot(FUSE_SRC_AIRSPEED)) {
+			airspeed_updated = false;
+		}
+
 		if (airspeed_updated) {
 			orb_copy(ORB_ID(airspeed), airspeed_sub, &airspeed);
 		}
@@ -572,12 +1053,20 @@ void Ekf2::run()
 
 		orb_check(optical_flow_sub, &optical_flow_updated);
 
+		if (optical_flow_updated && !take_fusion_slot(FUSE_SRC_FLOW)) {
+			optical_flow_updated = false;
+		}
+
 		if (optical_flow_updated) {
 			orb_copy(ORB_ID(optical_flow), optical_flow_sub, &optical_flow);
 		}
 
 		orb_check(range_finder_sub, &range_finder_updated);
 
+		if (range_finder_updated && !take_fusion_slot(FUSE_SRC_RANGE)) {
+			range_finder_updated = false;
+		}
+
 		if (range_finder_updated) {
 			orb_copy(ORB_ID(distance_sensor), range_finder_sub, &range_finder);
 
@@ -588,13 +1077,18 @@ void Ekf2::run()
 		}
 
 		orb_check(ev_pos_sub, &vision_position_updated);
+		orb_check(ev_att_sub, &vision_attitude_updated);
+
+		// position and attitude are fused as one external vision observation
+		if ((vision_position_updated || vision_attitude_updated) && !take_fusion_slot(FUSE_SRC_EV)) {
+			vision_position_updated = false;
+			vision_attitude_updated = false;
+		}
 
 		if (vision_position_updated) {
 			orb_copy(ORB_ID(vehicle_vision_position), ev_pos_sub, &ev_pos);
 		}
 
-		orb_check(ev_att_sub, &vision_attitude_updated);
-
 		if (vision_attitude_updated) {
 			orb_copy(ORB_ID(vehicle_vision_attitude), ev_att_sub, &ev_att);
 		}
@@ -625,6 +1119,8 @@ void Ekf2::run()
 		_ekf.setIMUData(now, sensors.gyro_integral_dt, sensors.accelerometer_integral_dt, gyro_integral, accel_integral);
 
 		// read mag data
+		SCOPE_TRACE_ENTER(trace_mag);
+
 		if (sensors.magnetometer_timestamp_relative == sensor_combined_s::RELATIVE_TIMESTAMP_INVALID) {
 			// set a zero timestamp to let the ekf replay program know that this data is not valid
 			_timestamp_mag_us = 0;
@@ -673,7 +1169,8 @@ void Ekf2::run()
 				_mag_data_sum[2] += sensors.magnetometer_ga[2];
 				uint32_t mag_time_ms = _mag_time_sum_ms / _mag_sample_count;
 
-				if (mag_time_ms - _mag_time_ms_last_used > _params->sensor_interval_min_ms) {
+				if (mag_time_ms - _mag_time_ms_last_used > _params->sensor_interval_min_ms
+				    && take_fusion_slot(FUSE_SRC_MAG)) {
 					float mag_sample_count_inv = 1.0f / (float)_mag_sample_count;
 					// calculate mean of measurements and correct for learned bias offsets
 					float mag_data_avg_ga[3] = {_mag_data_sum[0] *mag_sample_count_inv - _mag_bias_x.get(),
@@ -692,7 +1189,11 @@ void Ekf2::run()
 			}
 		}
 
+		SCOPE_TRACE_LEAVE(trace_mag);
+
 		// read baro data
+		SCOPE_TRACE_ENTER(trace_baro);
+
 		if (sensors.baro_timestamp_relative == sensor_combined_s::RELATIVE_TIMESTAMP_INVALID) {
 			// set a zero timestamp to let the ekf replay program know that this data is not valid
 			_timestamp_balt_us = 0;
@@ -708,7 +1209,8 @@ void Ekf2::run()
 				_balt_data_sum += sensors.baro_alt_meter;
 				uint32_t balt_time_ms = _balt_time_sum_ms / _balt_sample_count;
 
-				if (balt_time_ms - _balt_time_ms_last_used > (uint32_t)_params->sensor_interval_min_ms) {
+				if (balt_time_ms - _balt_time_ms_last_used > (uint32_t)_params->sensor_interval_min_ms
+				    && take_fusion_slot(FUSE_SRC_BARO)) {
 					// take mean across sample period
 					float balt_data_avg = _balt_data_sum / (float)_balt_sample_count;
 
@@ -748,7 +1250,11 @@ void Ekf2::run()
 			}
 		}
 
+		SCOPE_TRACE_LEAVE(trace_baro);
+
 		// read gps data if available
+		SCOPE_TRACE_ENTER(trace_gps);
+
 		if (gps_updated) {
 			struct gps_message gps_msg;
 			gps_msg.time_usec = gps.timestamp;
@@ -772,6 +1278,11 @@ void Ekf2::run()
 
 		}
 
+		SCOPE_TRACE_LEAVE(trace_gps);
+
+		// push airspeed, flow, range, vision and land detector data
+		SCOPE_TRACE_ENTER(trace_aux);
+
 		// only set airspeed data if condition for airspeed fusion are met
 		bool fuse_airspeed = airspeed_updated && !vehicle_status.is_rotary_wing
 				     && (_arspFusionThreshold.get() > FLT_EPSILON)
@@ -836,8 +1347,18 @@ void Ekf2::run()
 			_ekf.set_in_air_status(!vehicle_land_detected.landed);
 		}
 
+		SCOPE_TRACE_LEAVE(trace_aux);
+
 		// run the EKF update and output
-		if (_ekf.update()) {
+		SCOPE_TRACE_ENTER(trace_update);
+		perf_begin(_ekf_update_perf);
+		const bool ekf_updated = _ekf.update();
+		perf_end(_ekf_update_perf);
+		SCOPE_TRACE_LEAVE(trace_update);
+
+		SCOPE_TRACE_ENTER(trace_outputs);
+
+		if (ekf_updated) {
 
 			// integrate time to monitor time slippage
 			if (_start_time_us == 0) {
@@ -955,33 +1476,59 @@ void Ekf2::run()
 					}
 				}
 
-				// publish control state data
-				if (_control_state_pub == nullptr) {
-					_control_state_pub = orb_advertise(ORB_ID(control_state), &ctrl_state);
+				// publish control state data, only the selected instance feeds the controllers
+				if (is_selected()) {
+					if (_control_state_pub == nullptr) {
+						_control_state_pub = orb_advertise(ORB_ID(control_state), &ctrl_state);
 
-				} else {
-					orb_publish(ORB_ID(control_state), _control_state_pub, &ctrl_state);
+					} else {
+						orb_publish(ORB_ID(control_state), _control_state_pub, &ctrl_state);
+					}
 				}
 			}
 
 
 			{
-				// generate vehicle attitude quaternion data
-				struct vehicle_attitude_s att = {};
-				att.timestamp = now;
+				// decide whether this cycle's attitude output is needed at all
+				// before doing the copy-out work (see _att_pub_rate)
+				bool publish_att = true;
+
+				if (_att_pub_rate.get() > 0 && _att_pub != nullptr) {
+					if (now - _att_sub_check_time > 1000 * 1000) {
+						_att_sub_check_time = now;
+						_att_has_subscribers = orb_subscriber_count(_att_pub) > 0;
+					}
+
+					if (!_att_has_subscribers) {
+						publish_att = false;
 
-				q.copyTo(att.q);
+					} else if (now < _att_pub_last + 1000 * 1000 / _att_pub_rate.get()) {
+						publish_att = false;
+					}
+				}
 
-				att.rollspeed = gyro_rad[0];
-				att.pitchspeed = gyro_rad[1];
-				att.yawspeed = gyro_rad[2];
+				if (publish_att) {
+					// generate vehicle attitude quaternion data
+					struct vehicle_attitude_s att = {};
+					att.timestamp = now;
 
-				// publish vehicle attitude data
-				if (_att_pub == nullptr) {
-					_att_pub = orb_advertise(ORB_ID(vehicle_attitude), &att);
+					q.copyTo(att.q);
 
-				} else {
-					orb_publish(ORB_ID(vehicle_attitude), _att_pub, &att);
+					att.rollspeed = gyro_rad[0];
+					att.pitchspeed = gyro_rad[1];
+					att.yawspeed = gyro_rad[2];
+
+					// publish vehicle attitude data, only the selected instance feeds the controllers
+					if (is_selected()) {
+						if (_att_pub == nullptr) {
+							_att_pub = orb_advertise(ORB_ID(vehicle_attitude), &att);
+
+						} else {
+							orb_publish(ORB_ID(vehicle_attitude), _att_pub, &att);
+						}
+
+						_att_pub_last = now;
+					}
 				}
 			}
 
@@ -1055,9 +1602,11 @@ void Ekf2::run()
 			_ekf.get_velNE_reset(&lpos.delta_vxy[0], &lpos.vxy_reset_counter);
 
 			// publish vehicle local position data
-			_vehicle_local_position_pub.update();
+			if (is_selected()) {
+				_vehicle_local_position_pub.update();
+			}
 
-			if (_ekf.global_position_is_valid() && !_vel_innov_preflt_fail) {
+			if (is_selected() && _ekf.global_position_is_valid() && !_vel_innov_preflt_fail) {
 				// generate and publish global position data
 				vehicle_global_position_s &global_pos = _vehicle_global_position_pub.get();
 
@@ -1130,13 +1679,22 @@ void Ekf2::run()
 					status.time_slip = 0.0f;
 				}
 
+				// the status of every instance is published so that logs and the ground
+				// station can compare the estimators, hence the instance-indexed topic
 				if (_estimator_status_pub == nullptr) {
-					_estimator_status_pub = orb_advertise(ORB_ID(estimator_status), &status);
+					int status_instance;
+					_estimator_status_pub = orb_advertise_multi(ORB_ID(estimator_status), &status, &status_instance,
+							_instance == 0 ? ORB_PRIO_HIGH : ORB_PRIO_DEFAULT);
 
 				} else {
 					orb_publish(ORB_ID(estimator_status), _estimator_status_pub, &status);
 				}
 
+				// feed this instance's innovation consistency into the output selector
+				if (_secondary_task_id != -1) {
+					update_selector(status, now);
+				}
+
 				/* Check and save learned magnetometer bias estimates */
 
 				// Check if conditions are OK to for learning of magnetometer bias values
@@ -1187,7 +1745,9 @@ void Ekf2::run()
 				}
 
 				// Check and save the last valid calibration when we are disarmed
-				if ((vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)
+				// (only the primary instance writes the shared bias parameters)
+				if ((_instance == 0)
+				    && (vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)
 				    && (status.filter_fault_flags == 0)
 				    && (sensor_selection.mag_device_id == _mag_bias_id.get())) {
 					control::BlockParamFloat *mag_biases[] = { &_mag_bias_x, &_mag_bias_y, &_mag_bias_z };
@@ -1219,11 +1779,13 @@ void Ekf2::run()
 				wind_estimate.covariance_north = status.covariances[22];
 				wind_estimate.covariance_east = status.covariances[23];
 
-				if (_wind_pub == nullptr) {
-					_wind_pub = orb_advertise(ORB_ID(wind_estimate), &wind_estimate);
+				if (is_selected()) {
+					if (_wind_pub == nullptr) {
+						_wind_pub = orb_advertise(ORB_ID(wind_estimate), &wind_estimate);
 
-				} else {
-					orb_publish(ORB_ID(wind_estimate), _wind_pub, &wind_estimate);
+					} else {
+						orb_publish(ORB_ID(wind_estimate), _wind_pub, &wind_estimate);
+					}
 				}
 			}
 
@@ -1273,7 +1835,9 @@ void Ekf2::run()
 				}
 
 				if (_estimator_innovations_pub == nullptr) {
-					_estimator_innovations_pub = orb_advertise(ORB_ID(ekf2_innovations), &innovations);
+					int innov_instance;
+					_estimator_innovations_pub = orb_advertise_multi(ORB_ID(ekf2_innovations), &innovations, &innov_instance,
+							_instance == 0 ? ORB_PRIO_HIGH : ORB_PRIO_DEFAULT);
 
 				} else {
 					orb_publish(ORB_ID(ekf2_innovations), _estimator_innovations_pub, &innovations);
@@ -1295,8 +1859,8 @@ void Ekf2::run()
 			}
 		}
 
-		// publish ekf2_timestamps (using 0.1 ms relative timestamps)
-		{
+		// publish ekf2_timestamps (using 0.1 ms relative timestamps), primary instance only
+		if (_instance == 0) {
 			ekf2_timestamps_s ekf2_timestamps;
 			ekf2_timestamps.timestamp = sensors.timestamp;
 
@@ -1356,8 +1920,8 @@ void Ekf2::run()
 			}
 		}
 
-		// publish replay message if in replay mode
-		if (_param_record_replay_msg.get() == 1) {
+		// publish replay message if in replay mode, primary instance only
+		if (_instance == 0 && _param_record_replay_msg.get() == 1) {
 			struct ekf2_replay_s replay = {};
 			replay.timestamp = now;
 			replay.gyro_integral_dt = sensors.gyro_integral_dt;
@@ -1445,10 +2009,18 @@ void Ekf2::run()
 				orb_publish(ORB_ID(ekf2_replay), _replay_pub, &replay);
 			}
 		}
+
+		SCOPE_TRACE_LEAVE(trace_outputs);
+
+		perf_end(_cycle_perf);
 	}
 
 	orb_unsubscribe(sensors_sub);
-	orb_unsubscribe(gps_sub);
+
+	for (int i = 0; i < GPS_MAX_RECEIVERS; i++) {
+		orb_unsubscribe(gps_subs[i]);
+	}
+
 	orb_unsubscribe(airspeed_sub);
 	orb_unsubscribe(params_sub);
 	orb_unsubscribe(optical_flow_sub);
@@ -1463,7 +2035,7 @@ void Ekf2::run()
 
 Ekf2 *Ekf2::instantiate(int argc, char *argv[])
 {
-	Ekf2 *instance = new Ekf2();
+	Ekf2 *instance = new Ekf2(0);
 
 	if (instance) {
 		if (argc >= 2 && !strcmp(argv[1], "-r")) {
@@ -1474,6 +2046,26 @@ Ekf2 *Ekf2::instantiate(int argc, char *argv[])
 	return instance;
 }
 
+int Ekf2::secondary_trampoline(int argc, char *argv[])
+{
+	Ekf2 *instance = new Ekf2(1);
+
+	if (instance == nullptr) {
+		PX4_ERR("redundant instance alloc failed");
+		_secondary_task_id = -1;
+		return -1;
+	}
+
+	_secondary = instance;
+	instance->run();
+	_secondary = nullptr;
+
+	delete instance;
+	_secondary_task_id = -1;
+
+	return 0;
+}
+
 int Ekf2::custom_command(int argc, char *argv[])
 {
 	return print_usage("unknown command");
@@ -1495,11 +2087,16 @@ The documentation can be found on the [tuning_the_ecl_ekf](https://dev.px4.io/en
 ekf2 can be started in replay mode (`-r`): in this mode it does not access the system time, but only uses the
 timestamps from the sensor topics.
 
+With `-m 2` a redundant second estimator instance is run on its own task. Both instances publish their
+estimator_status and ekf2_innovations to instance-indexed topics, and only the instance with the better
+innovation test ratios publishes the attitude and position topics consumed by the controllers.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("ekf2", "estimator");
 	PRINT_MODULE_USAGE_COMMAND("start");
 	PRINT_MODULE_USAGE_PARAM_FLAG('r', "Enable replay mode", true);
+	PRINT_MODULE_USAGE_PARAM_INT('m', 1, 1, 2, "Number of estimator instances (redundancy)", true);
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 
 	return 0;
@@ -1507,6 +2104,16 @@ timestamps from the sensor topics.
 
 int Ekf2::task_spawn(int argc, char *argv[])
 {
+	int instances = 1;
+
+	for (int i = 0; i < argc - 1; i++) {
+		if (!strcmp(argv[i], "-m")) {
+			instances = strtol(argv[i + 1], nullptr, 10);
+		}
+	}
+
+	instances = math::constrain(instances, 1, MAX_INSTANCES);
+
 	_task_id = px4_task_spawn_cmd("ekf2",
 				      SCHED_DEFAULT,
 				      SCHED_PRIORITY_ESTIMATOR,
@@ -1519,6 +2126,22 @@ int Ekf2::task_spawn(int argc, char *argv[])
 		return -errno;
 	}
 
+	if (instances > 1 && _secondary_task_id == -1) {
+		/* The redundant estimator gets its own task (a thread on posix), so running
+		 * it never extends the primary's worst-case cycle time. */
+		_secondary_task_id = px4_task_spawn_cmd("ekf2_1",
+							SCHED_DEFAULT,
+							SCHED_PRIORITY_ESTIMATOR,
+							5700,
+							(px4_main_t)&secondary_trampoline,
+							(char *const *)argv);
+
+		if (_secondary_task_id < 0) {
+			PX4_ERR("failed to start the redundant instance");
+			_secondary_task_id = -1;
+		}
+	}
+
 	return 0;
 }
 
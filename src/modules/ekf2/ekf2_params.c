@@ -1152,3 +1152,66 @@ PARAM_DEFINE_FLOAT(EKF2_PCOEF_Y, 0.0f);
  * @decimal 2
  */
 PARAM_DEFINE_FLOAT(EKF2_PCOEF_Z, 0.0f);
+
+/**
+ * Measurement pushes into the EKF buffers allowed per IMU update cycle.
+ * When greater than zero, measurement data is handed to the estimator through a budgeted
+ * slot scheduler so that the matching fusion steps are spread across cycles instead of
+ * all landing on the same one. This flattens the worst-case cycle time at the cost of up
+ * to 3 cycles of additional (time stamped, so fully compensated) measurement latency.
+ * A value of 0 disables the scheduler and pushes measurements as they arrive.
+ *
+ * @group EKF2
+ * @min 0
+ * @max 7
+ */
+PARAM_DEFINE_INT32(EKF2_FUSE_SLOTS, 0);
+
+/**
+ * Maximum vehicle_attitude publication rate.
+ *
+ * The current-time attitude is aligned from the delayed fusion horizon by the output
+ * predictor on every IMU update, independent of who consumes it. When greater than
+ * zero, the attitude copy-out and publication are decimated to this rate, and skipped
+ * entirely while the topic has no subscribers (re-checked once per second). Useful on
+ * data-collection flights without attitude consumers. A value of 0 publishes on every
+ * fusion cycle.
+ *
+ * @group EKF2
+ * @unit Hz
+ * @min 0
+ * @max 500
+ */
+PARAM_DEFINE_INT32(EKF2_ATT_RATE, 0);
+
+/**
+ * Multi GPS blending control mask.
+ *
+ * Bitmask of the receiver-reported accuracy metrics used to weight the individual
+ * receivers when more than one publishes a current 3D fix. With a value of 0 blending
+ * is disabled and the lowest numbered healthy receiver is used alone, matching the
+ * previous behaviour. Receivers that lose their fix or stop publishing are removed
+ * from the blend immediately regardless of this setting.
+ *
+ * @group EKF2
+ * @min 0
+ * @max 7
+ * @bit 0 use horizontal position accuracy
+ * @bit 1 use vertical position accuracy
+ * @bit 2 use speed accuracy
+ */
+PARAM_DEFINE_INT32(EKF2_GPS_MASK, 0);
+
+/**
+ * Multi GPS blend weight time constant.
+ *
+ * Controls how quickly the blend weights follow changes in the accuracies the
+ * receivers report. Shorter values track quality changes faster at the cost of the
+ * blended position moving around as the weighting shifts between the antennas.
+ *
+ * @group EKF2
+ * @unit s
+ * @min 1.0
+ * @max 100.0
+ */
+PARAM_DEFINE_FLOAT(EKF2_GPS_TAU, 10.0f);
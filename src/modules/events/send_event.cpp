@@ -36,134 +36,149 @@
 
 #include <px4_getopt.h>
 #include <px4_log.h>
+#include <px4_posix.h>
+#include <px4_tasks.h>
 #include <drivers/drv_hrt.h>
 
-struct work_s SendEvent::_work = {};
-
-// Run it at 30 Hz.
-const unsigned SEND_EVENT_INTERVAL_US = 33000;
+#include <string.h>
 
 
 int SendEvent::task_spawn(int argc, char *argv[])
 {
-	int ret = work_queue(LPWORK, &_work, (worker_t)&SendEvent::initialize_trampoline, nullptr, 0);
-
-	if (ret < 0) {
-		return ret;
-	}
-
-	ret = wait_until_running();
-
-	if (ret < 0) {
-		return ret;
+	/* The module blocks in poll() on its routed topics, so it needs its own
+	 * (small) stack instead of a slot on the low priority work queue. */
+	_task_id = px4_task_spawn_cmd("send_event",
+				      SCHED_DEFAULT,
+				      SCHED_PRIORITY_DEFAULT,
+				      1800,
+				      (px4_main_t)&run_trampoline,
+				      (char *const *)argv);
+
+	if (_task_id < 0) {
+		_task_id = -1;
+		return -errno;
 	}
 
-	_task_id = task_id_is_work_queue;
-
 	return 0;
 }
 
+SendEvent *SendEvent::instantiate(int argc, char *argv[])
+{
+	return new SendEvent();
+}
+
 SendEvent::SendEvent()
 {
 }
 
-int SendEvent::start()
+int SendEvent::register_handler(const struct orb_metadata *meta, match_fn match, handler_fn handler)
 {
-	if (is_running()) {
-		return 0;
+	if (_num_handlers >= MAX_HANDLERS || meta->o_size > MAX_MSG_SIZE) {
+		PX4_ERR("cannot route %s", meta->o_name);
+		return -ENOSPC;
 	}
 
-	_vehicle_command_sub = orb_subscribe(ORB_ID(vehicle_command));
+	EventHandler &h = _handlers[_num_handlers];
+	h.meta = meta;
+	h.match = match;
+	h.handler = handler;
+	h.fd = orb_subscribe(meta);
 
-	// Kick off the cycling. We can call it directly because we're already in the work queue context
-	cycle();
+	if (h.fd < 0) {
+		return -errno;
+	}
+
+	++_num_handlers;
 
 	return 0;
 }
 
-void SendEvent::initialize_trampoline(void *arg)
+bool SendEvent::match_preflight_calibration(const void *msg)
 {
-	SendEvent *send_event = new SendEvent();
+	const vehicle_command_s &cmd = *(const vehicle_command_s *)msg;
 
-	if (!send_event) {
-		PX4_ERR("alloc failed");
-		return;
-	}
-
-	send_event->start();
-	_object = send_event;
+	return cmd.command == vehicle_command_s::VEHICLE_CMD_PREFLIGHT_CALIBRATION;
 }
 
-void
-SendEvent::cycle_trampoline(void *arg)
+void SendEvent::run()
 {
-	SendEvent *obj = reinterpret_cast<SendEvent *>(arg);
+	/* Resolve the event-action table once: each route carries its
+	 * subscription, field predicate and handler, so dispatching a
+	 * publication is a table walk with no per-cycle re-evaluation. */
+	register_handler(ORB_ID(vehicle_command), &SendEvent::match_preflight_calibration,
+			 &SendEvent::handle_preflight_calibration);
 
-	obj->cycle();
-}
+	px4_pollfd_struct_t fds[MAX_HANDLERS] {};
 
-void SendEvent::cycle()
-{
-	if (should_exit()) {
-		if (_vehicle_command_sub >= 0) {
-			orb_unsubscribe(_vehicle_command_sub);
-			_vehicle_command_sub = -1;
+	for (int i = 0; i < _num_handlers; i++) {
+		fds[i].fd = _handlers[i].fd;
+		fds[i].events = POLLIN;
+	}
+
+	while (!should_exit()) {
+		/* block until a routed topic publishes; the timeout only bounds
+		 * how long a stop request can go unnoticed */
+		int ret = px4_poll(fds, _num_handlers, 500);
+
+		if (ret < 0) {
+			PX4_ERR("poll failed (%i)", ret);
+			usleep(100000);
+			continue;
 		}
 
-		exit_and_cleanup();
-		return;
-	}
+		if (ret == 0) {
+			continue;
+		}
 
-	process_commands();
+		uint8_t buffer[MAX_MSG_SIZE];
 
-	work_queue(LPWORK, &_work, (worker_t)&SendEvent::cycle_trampoline, this,
-		   USEC2TICK(SEND_EVENT_INTERVAL_US));
-}
+		for (int i = 0; i < _num_handlers; i++) {
+			if (fds[i].revents & POLLIN) {
+				orb_copy(_handlers[i].meta, _handlers[i].fd, buffer);
 
-void SendEvent::process_commands()
-{
-	bool updated;
-	orb_check(_vehicle_command_sub, &updated);
+				if (_handlers[i].match == nullptr || _handlers[i].match(buffer)) {
+					(this->*_handlers[i].handler)(buffer);
+				}
+			}
+		}
+	}
 
-	if (!updated) {
-		return;
+	for (int i = 0; i < _num_handlers; i++) {
+		orb_unsubscribe(_handlers[i].fd);
 	}
 
-	struct vehicle_command_s cmd;
+	_num_handlers = 0;
+}
 
-	orb_copy(ORB_ID(vehicle_command), _vehicle_command_sub, &cmd);
+void SendEvent::handle_preflight_calibration(const void *msg)
+{
+	const vehicle_command_s &cmd = *(const vehicle_command_s *)msg;
 
 	bool got_temperature_calibration_command = false, accel = false, baro = false, gyro = false;
 
-	switch (cmd.command) {
-	case vehicle_command_s::VEHICLE_CMD_PREFLIGHT_CALIBRATION:
-		if ((int)(cmd.param1) == vehicle_command_s::PREFLIGHT_CALIBRATION_TEMPERATURE_CALIBRATION) {
-			gyro = true;
-			got_temperature_calibration_command = true;
-		}
+	if ((int)(cmd.param1) == vehicle_command_s::PREFLIGHT_CALIBRATION_TEMPERATURE_CALIBRATION) {
+		gyro = true;
+		got_temperature_calibration_command = true;
+	}
 
-		if ((int)(cmd.param5) == vehicle_command_s::PREFLIGHT_CALIBRATION_TEMPERATURE_CALIBRATION) {
-			accel = true;
-			got_temperature_calibration_command = true;
-		}
+	if ((int)(cmd.param5) == vehicle_command_s::PREFLIGHT_CALIBRATION_TEMPERATURE_CALIBRATION) {
+		accel = true;
+		got_temperature_calibration_command = true;
+	}
 
-		if ((int)(cmd.param7) == vehicle_command_s::PREFLIGHT_CALIBRATION_TEMPERATURE_CALIBRATION) {
-			baro = true;
-			got_temperature_calibration_command = true;
-		}
+	if ((int)(cmd.param7) == vehicle_command_s::PREFLIGHT_CALIBRATION_TEMPERATURE_CALIBRATION) {
+		baro = true;
+		got_temperature_calibration_command = true;
+	}
 
-		if (got_temperature_calibration_command) {
-			if (run_temperature_calibration(accel, baro, gyro) == 0) {
-				answer_command(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
+	if (got_temperature_calibration_command) {
+		if (run_temperature_calibration(accel, baro, gyro) == 0) {
+			answer_command(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
 
-			} else {
-				answer_command(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_FAILED);
-			}
+		} else {
+			answer_command(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_FAILED);
 		}
-
-		break;
 	}
-
 }
 
 void SendEvent::answer_command(const vehicle_command_s &cmd, unsigned result)
@@ -200,8 +215,11 @@ int SendEvent::print_usage(const char *reason)
 	PRINT_MODULE_DESCRIPTION(
 		R"DESCR_STR(
 ### Description
-Background process running periodically on the LP work queue to perform housekeeping tasks.
-It is currently only responsible for temperature calibration.
+Background task dispatching uORB messages to actions through a table of routes resolved at
+startup (topic + field predicate + handler). It blocks on its routed topics and wakes only
+when one of them publishes, so a matching command is handled with single-cycle latency and
+the task is free when nothing fires. It is currently only responsible for temperature
+calibration.
 
 The tasks can be started via CLI or uORB topics (vehicle_command from MAVLink, etc.).
 )DESCR_STR");
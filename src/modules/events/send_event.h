@@ -33,8 +33,8 @@
 
 #pragma once
 
-#include <px4_workqueue.h>
 #include <px4_module.h>
+#include <uORB/uORB.h>
 #include <uORB/topics/vehicle_command.h>
 #include <uORB/topics/vehicle_command_ack.h>
 
@@ -45,40 +45,61 @@ class SendEvent : public ModuleBase<SendEvent>
 public:
 	SendEvent();
 
-	/**
-	 * Initialize class in the same context as the work queue. And start the background listener.
-	 * @return 0 if successful, <0 on error */
+	/** @see ModuleBase */
 	static int task_spawn(int argc, char *argv[]);
 
+	/** @see ModuleBase */
+	static SendEvent *instantiate(int argc, char *argv[]);
+
 	/** @see ModuleBase */
 	static int custom_command(int argc, char *argv[]);
 
 	/** @see ModuleBase */
 	static int print_usage(const char *reason = nullptr);
 
+	/** @see ModuleBase::run() */
+	void run() override;
+
 private:
 
-	/** Start background listening for commands
-	 *
-	 * @return 0 if successful, <0 on error. */
-	int start();
+	/** Field predicate applied to a copied-out message. */
+	typedef bool (*match_fn)(const void *msg);
 
+	/** Action invoked for a matching message. */
+	typedef void (SendEvent::*handler_fn)(const void *msg);
 
-	/** Trampoline for initialisation. */
-	static void initialize_trampoline(void *arg);
-	/** Trampoline for the work queue. */
-	static void cycle_trampoline(void *arg);
+	/**
+	 * An event route resolved at module init: a subscription plus the
+	 * predicate and handler to run when a matching message arrives.
+	 */
+	struct EventHandler {
+		const struct orb_metadata *meta;	/**< topic the route listens on */
+		match_fn match;				/**< field predicate, nullptr matches all */
+		handler_fn handler;			/**< action for matching messages */
+		int fd;					/**< subscription file descriptor */
+	};
+
+	/** Subscribe to a topic and append a route to the dispatch table.
+	 *
+	 * @return 0 if successful, <0 on error. */
+	int register_handler(const struct orb_metadata *meta, match_fn match, handler_fn handler);
 
-	/** call process_commands() and schedule the next cycle. */
-	void cycle();
+	/** @return true if the message is a temperature calibration command */
+	static bool match_preflight_calibration(const void *msg);
 
-	/** check for new commands and process them. */
-	void process_commands();
+	/** run the requested temperature calibrations and ACK the command */
+	void handle_preflight_calibration(const void *msg);
 
 	/** return an ACK to a vehicle_command */
 	void answer_command(const vehicle_command_s &cmd, unsigned result);
 
-	static struct work_s _work;
-	int _vehicle_command_sub = -1;
+	/** upper bound for routed topics; the run loop copies into a stack
+	 * buffer of this size */
+	static const size_t MAX_MSG_SIZE = sizeof(vehicle_command_s);
+
+	static const int MAX_HANDLERS = 4;
+
+	EventHandler _handlers[MAX_HANDLERS] {};
+	int _num_handlers = 0;
 	orb_advert_t _command_ack_pub = nullptr;
 };
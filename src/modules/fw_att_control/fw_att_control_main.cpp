@@ -291,8 +291,11 @@ private:
 
 	/**
 	 * Update our local parameter cache.
+	 *
+	 * @param changed_param	handle of the parameter that triggered the refresh,
+	 *			UINT32_MAX to refresh unconditionally
 	 */
-	int		parameters_update();
+	int		parameters_update(uint32_t changed_param = UINT32_MAX);
 
 	/**
 	 * Update control outputs
@@ -505,8 +508,13 @@ FixedwingAttitudeControl::~FixedwingAttitudeControl()
 }
 
 int
-FixedwingAttitudeControl::parameters_update()
+FixedwingAttitudeControl::parameters_update(uint32_t changed_param)
 {
+	/* skip the refresh entirely when the notification names a parameter we don't use */
+	if (!param_in_set(changed_param, (const param_t *)&_parameter_handles,
+			  sizeof(_parameter_handles) / sizeof(param_t))) {
+		return PX4_OK;
+	}
 
 	param_get(_parameter_handles.p_tc, &(_parameters.p_tc));
 	param_get(_parameter_handles.p_p, &(_parameters.p_p));
@@ -787,7 +795,7 @@ FixedwingAttitudeControl::task_main()
 			orb_copy(ORB_ID(parameter_update), _params_sub, &update);
 
 			/* update parameters from storage */
-			parameters_update();
+			parameters_update(update.changed_param);
 		}
 
 		/* only run controller if attitude changed */
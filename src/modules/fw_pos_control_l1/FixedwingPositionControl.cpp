@@ -39,8 +39,13 @@ FixedwingPositionControl *l1_control::g_control;
 static int _control_task = -1;			///< task handle for sensor task */
 
 FixedwingPositionControl::FixedwingPositionControl() :
-	_loop_perf(perf_alloc(PC_ELAPSED, "fw l1 control"))
+	_loop_perf(perf_alloc(PC_ELAPSED, "fw l1 control")),
+	_l1_perf(perf_alloc(PC_ELAPSED, "fw l1 nav")),
+	_tecs_perf(perf_alloc(PC_ELAPSED, "fw tecs"))
 {
+	/* the hover to fixed-wing frame rotation for tailsitters is constant */
+	_R_ts_offset.from_euler(0.0f, M_PI_2_F, 0.0f);
+
 	_parameter_handles.l1_period = param_find("FW_L1_PERIOD");
 	_parameter_handles.l1_damping = param_find("FW_L1_DAMPING");
 
@@ -139,6 +144,8 @@ FixedwingPositionControl::parameters_update()
 	param_get(_parameter_handles.pitch_limit_min, &(_parameters.pitch_limit_min));
 	param_get(_parameter_handles.pitch_limit_max, &(_parameters.pitch_limit_max));
 	param_get(_parameter_handles.roll_limit, &(_parameters.roll_limit));
+	_parameters.pitch_limit_min_rad = radians(_parameters.pitch_limit_min);
+	_parameters.pitch_limit_max_rad = radians(_parameters.pitch_limit_max);
 	param_get(_parameter_handles.throttle_min, &(_parameters.throttle_min));
 	param_get(_parameter_handles.throttle_max, &(_parameters.throttle_max));
 	param_get(_parameter_handles.throttle_idle, &(_parameters.throttle_idle));
@@ -190,6 +197,8 @@ FixedwingPositionControl::parameters_update()
 		  &(_parameters.land_heading_hold_horizontal_distance));
 	param_get(_parameter_handles.land_flare_pitch_min_deg, &(_parameters.land_flare_pitch_min_deg));
 	param_get(_parameter_handles.land_flare_pitch_max_deg, &(_parameters.land_flare_pitch_max_deg));
+	_parameters.land_flare_pitch_min_rad = radians(_parameters.land_flare_pitch_min_deg);
+	_parameters.land_flare_pitch_max_rad = radians(_parameters.land_flare_pitch_max_deg);
 	param_get(_parameter_handles.land_use_terrain_estimate, &(_parameters.land_use_terrain_estimate));
 	param_get(_parameter_handles.land_airspeed_scale, &(_parameters.land_airspeed_scale));
 	param_get(_parameter_handles.vtol_type, &(_parameters.vtol_type));
@@ -229,6 +238,16 @@ FixedwingPositionControl::parameters_update()
 		return PX4_ERROR;
 	}
 
+	/* the cached radian limits must reflect the degree parameters */
+	if ((fabsf(_parameters.pitch_limit_min) > 0.0f && fabsf(_parameters.pitch_limit_min_rad) <= 0.0f) ||
+	    (fabsf(_parameters.pitch_limit_max) > 0.0f && fabsf(_parameters.pitch_limit_max_rad) <= 0.0f) ||
+	    (fabsf(_parameters.land_flare_pitch_min_deg) > 0.0f && fabsf(_parameters.land_flare_pitch_min_rad) <= 0.0f) ||
+	    (fabsf(_parameters.land_flare_pitch_max_deg) > 0.0f && fabsf(_parameters.land_flare_pitch_max_rad) <= 0.0f)) {
+
+		PX4_WARN("error: cached pitch limit conversion invalid");
+		return PX4_ERROR;
+	}
+
 	/* Update the landing slope */
 	_landingslope.update(radians(_parameters.land_slope_angle), _parameters.land_flare_alt_relative,
 			     _parameters.land_thrust_lim_alt_relative, _parameters.land_H1_virt);
@@ -348,8 +367,10 @@ FixedwingPositionControl::control_state_poll()
 	_pitch   = euler_angles(1);
 	_yaw     = euler_angles(2);
 
-	/* update TECS state */
-	_tecs.enable_airspeed(_airspeed_valid);
+	/* update TECS state, only push the flag when the airspeed regime actually changed */
+	if (_tecs.airspeed_enabled() != _airspeed_valid) {
+		_tecs.enable_airspeed(_airspeed_valid);
+	}
 }
 
 void
@@ -646,8 +667,10 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 				    _control_mode.flag_control_altitude_enabled));
 
 	/* update TECS filters */
+	perf_begin(_tecs_perf);
 	_tecs.update_state(_global_pos.alt, _ctrl_state.airspeed, _R_nb,
 			   accel_body, accel_earth, (_global_pos.timestamp > 0), in_air_alt_control);
+	perf_end(_tecs_perf);
 
 	calculate_gndspeed_undershoot(curr_pos, ground_speed, pos_sp_prev, pos_sp_curr);
 
@@ -752,25 +775,29 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 
 		} else if (pos_sp_curr.type == position_setpoint_s::SETPOINT_TYPE_POSITION) {
 			/* waypoint is a plain navigation waypoint */
+			perf_begin(_l1_perf);
 			_l1_control.navigate_waypoints(prev_wp, curr_wp, curr_pos, nav_speed_2d);
+			perf_end(_l1_perf);
 			_att_sp.roll_body = _l1_control.nav_roll();
 			_att_sp.yaw_body = _l1_control.nav_bearing();
 
 			tecs_update_pitch_throttle(pos_sp_curr.alt,
 						   calculate_target_airspeed(mission_airspeed),
-						   radians(_parameters.pitch_limit_min) - _parameters.pitchsp_offset_rad,
-						   radians(_parameters.pitch_limit_max) - _parameters.pitchsp_offset_rad,
+						   _parameters.pitch_limit_min_rad - _parameters.pitchsp_offset_rad,
+						   _parameters.pitch_limit_max_rad - _parameters.pitchsp_offset_rad,
 						   _parameters.throttle_min,
 						   _parameters.throttle_max,
 						   mission_throttle,
 						   false,
-						   radians(_parameters.pitch_limit_min));
+						   _parameters.pitch_limit_min_rad);
 
 		} else if (pos_sp_curr.type == position_setpoint_s::SETPOINT_TYPE_LOITER) {
 
 			/* waypoint is a loiter waypoint */
+			perf_begin(_l1_perf);
 			_l1_control.navigate_loiter(curr_wp, curr_pos, pos_sp_curr.loiter_radius,
 						    pos_sp_curr.loiter_direction, nav_speed_2d);
+			perf_end(_l1_perf);
 			_att_sp.roll_body = _l1_control.nav_roll();
 			_att_sp.yaw_body = _l1_control.nav_bearing();
 
@@ -794,13 +821,13 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 
 			tecs_update_pitch_throttle(alt_sp,
 						   calculate_target_airspeed(mission_airspeed),
-						   radians(_parameters.pitch_limit_min) - _parameters.pitchsp_offset_rad,
-						   radians(_parameters.pitch_limit_max) - _parameters.pitchsp_offset_rad,
+						   _parameters.pitch_limit_min_rad - _parameters.pitchsp_offset_rad,
+						   _parameters.pitch_limit_max_rad - _parameters.pitchsp_offset_rad,
 						   _parameters.throttle_min,
 						   _parameters.throttle_max,
 						   _parameters.throttle_cruise,
 						   false,
-						   radians(_parameters.pitch_limit_min));
+						   _parameters.pitch_limit_min_rad);
 
 		} else if (pos_sp_curr.type == position_setpoint_s::SETPOINT_TYPE_LAND) {
 
@@ -847,6 +874,8 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 				mavlink_log_info(&_mavlink_log_pub, "Landing, heading hold");
 			}
 
+			perf_begin(_l1_perf);
+
 			if (_land_noreturn_horizontal) {
 				// heading hold
 				_l1_control.navigate_heading(_target_bearing, _yaw, nav_speed_2d);
@@ -856,6 +885,8 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 				_l1_control.navigate_waypoints(prev_wp, curr_wp, curr_pos, nav_speed_2d);
 			}
 
+			perf_end(_l1_perf);
+
 			_att_sp.roll_body = _l1_control.nav_roll();
 			_att_sp.yaw_body = _l1_control.nav_bearing();
 
@@ -959,13 +990,13 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 
 				tecs_update_pitch_throttle(terrain_alt + flare_curve_alt_rel,
 							   calculate_target_airspeed(airspeed_land),
-							   radians(_parameters.land_flare_pitch_min_deg),
-							   radians(_parameters.land_flare_pitch_max_deg),
+							   _parameters.land_flare_pitch_min_rad,
+							   _parameters.land_flare_pitch_max_rad,
 							   0.0f,
 							   throttle_max,
 							   throttle_land,
 							   false,
-							   _land_motor_lim ? radians(_parameters.land_flare_pitch_min_deg) : radians(_parameters.pitch_limit_min),
+							   _land_motor_lim ? _parameters.land_flare_pitch_min_rad : _parameters.pitch_limit_min_rad,
 							   _land_motor_lim ? tecs_status_s::TECS_MODE_LAND_THROTTLELIM : tecs_status_s::TECS_MODE_LAND);
 
 				if (!_land_noreturn_vertical) {
@@ -977,7 +1008,7 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 
 				} else {
 					if (_global_pos.vel_d > 0.1f) {
-						_att_sp.pitch_body = radians(_parameters.land_flare_pitch_min_deg) *
+						_att_sp.pitch_body = _parameters.land_flare_pitch_min_rad *
 								     constrain((_flare_height - (_global_pos.alt - terrain_alt)) / _flare_height, 0.0f, 1.0f);
 					}
 
@@ -1020,13 +1051,13 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 
 				tecs_update_pitch_throttle(terrain_alt + altitude_desired_rel,
 							   calculate_target_airspeed(airspeed_approach),
-							   radians(_parameters.pitch_limit_min),
-							   radians(_parameters.pitch_limit_max),
+							   _parameters.pitch_limit_min_rad,
+							   _parameters.pitch_limit_max_rad,
 							   _parameters.throttle_min,
 							   _parameters.throttle_max,
 							   _parameters.throttle_cruise,
 							   false,
-							   radians(_parameters.pitch_limit_min));
+							   _parameters.pitch_limit_min_rad);
 			}
 
 		} else if (pos_sp_curr.type == position_setpoint_s::SETPOINT_TYPE_TAKEOFF) {
@@ -1060,7 +1091,9 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 				 * Update navigation: _runway_takeoff returns the start WP according to mode and phase.
 				 * If we use the navigator heading or not is decided later.
 				 */
+					perf_begin(_l1_perf);
 				_l1_control.navigate_waypoints(_runway_takeoff.getStartWP(), curr_wp, curr_pos, nav_speed_2d);
+				perf_end(_l1_perf);
 
 				// update tecs
 				float takeoff_pitch_max_deg = _runway_takeoff.getMaxPitch(_parameters.pitch_limit_max);
@@ -1068,7 +1101,7 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 
 				tecs_update_pitch_throttle(pos_sp_curr.alt,
 							   calculate_target_airspeed(_runway_takeoff.getMinAirspeedScaling() * _parameters.airspeed_min),
-							   radians(_parameters.pitch_limit_min),
+							   _parameters.pitch_limit_min_rad,
 							   takeoff_pitch_max_rad,
 							   _parameters.throttle_min,
 							   _parameters.throttle_max, // XXX should we also set runway_takeoff_throttle here?
@@ -1117,7 +1150,9 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 				if (_launch_detection_state != LAUNCHDETECTION_RES_NONE) {
 					/* Launch has been detected, hence we have to control the plane. */
 
+					perf_begin(_l1_perf);
 					_l1_control.navigate_waypoints(prev_wp, curr_wp, curr_pos, nav_speed_2d);
+					perf_end(_l1_perf);
 					_att_sp.roll_body = _l1_control.nav_roll();
 					_att_sp.yaw_body = _l1_control.nav_bearing();
 
@@ -1141,7 +1176,7 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 						/* enforce a minimum of 10 degrees pitch up on takeoff, or take parameter */
 						tecs_update_pitch_throttle(pos_sp_curr.alt,
 									   _parameters.airspeed_trim,
-									   radians(_parameters.pitch_limit_min),
+									   _parameters.pitch_limit_min_rad,
 									   takeoff_pitch_max_rad,
 									   _parameters.throttle_min,
 									   takeoff_throttle,
@@ -1156,13 +1191,13 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 					} else {
 						tecs_update_pitch_throttle(pos_sp_curr.alt,
 									   calculate_target_airspeed(mission_airspeed),
-									   radians(_parameters.pitch_limit_min),
-									   radians(_parameters.pitch_limit_max),
+									   _parameters.pitch_limit_min_rad,
+									   _parameters.pitch_limit_max_rad,
 									   _parameters.throttle_min,
 									   takeoff_throttle,
 									   _parameters.throttle_cruise,
 									   false,
-									   radians(_parameters.pitch_limit_min));
+									   _parameters.pitch_limit_min_rad);
 					}
 
 				} else {
@@ -1234,8 +1269,8 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 
 		tecs_update_pitch_throttle(_hold_alt,
 					   altctrl_airspeed,
-					   radians(_parameters.pitch_limit_min),
-					   radians(_parameters.pitch_limit_max),
+					   _parameters.pitch_limit_min_rad,
+					   _parameters.pitch_limit_max_rad,
 					   _parameters.throttle_min,
 					   throttle_max,
 					   _parameters.throttle_cruise,
@@ -1284,7 +1319,9 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 				math::Vector<2> curr_wp{(float)_hdg_hold_curr_wp.lat, (float)_hdg_hold_curr_wp.lon};
 
 				/* populate l1 control setpoint */
+				perf_begin(_l1_perf);
 				_l1_control.navigate_waypoints(prev_wp, curr_wp, curr_pos, ground_speed);
+				perf_end(_l1_perf);
 
 				_att_sp.roll_body = _l1_control.nav_roll();
 				_att_sp.yaw_body = _l1_control.nav_bearing();
@@ -1336,8 +1373,8 @@ FixedwingPositionControl::control_position(const math::Vector<2> &curr_pos, cons
 
 		tecs_update_pitch_throttle(_hold_alt,
 					   altctrl_airspeed,
-					   radians(_parameters.pitch_limit_min),
-					   radians(_parameters.pitch_limit_max),
+					   _parameters.pitch_limit_min_rad,
+					   _parameters.pitch_limit_max_rad,
 					   _parameters.throttle_min,
 					   throttle_max,
 					   _parameters.throttle_cruise,
@@ -1771,21 +1808,21 @@ FixedwingPositionControl::tecs_update_pitch_throttle(float alt_sp, float airspee
 	// if the vehicle is a tailsitter we have to rotate the attitude by the pitch offset
 	// between multirotor and fixed wing flight
 	if (_parameters.vtol_type == vtol_type::TAILSITTER && _vehicle_status.is_vtol) {
-		math::Matrix<3, 3> R_offset;
-		R_offset.from_euler(0, M_PI_2_F, 0);
-		math::Matrix<3, 3> R_fixed_wing = _R_nb * R_offset;
+		math::Matrix<3, 3> R_fixed_wing = _R_nb * _R_ts_offset;
 		math::Vector<3> euler = R_fixed_wing.to_euler();
 		pitch_for_tecs = euler(1);
 	}
 
 	float eas2tas = 1.0f; // XXX calculate actual number based on current measurements
 
+	perf_begin(_tecs_perf);
 	_tecs.update_pitch_throttle(_R_nb, pitch_for_tecs,
 				    _global_pos.alt, alt_sp,
 				    airspeed_sp, _ctrl_state.airspeed, eas2tas,
 				    climbout_mode, climbout_pitch_min_rad,
 				    throttle_min, throttle_max, throttle_cruise,
 				    pitch_min_rad, pitch_max_rad);
+	perf_end(_tecs_perf);
 
 	TECS::tecs_state s {};
 	_tecs.get_tecs_state(s);
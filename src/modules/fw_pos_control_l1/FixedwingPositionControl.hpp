@@ -167,6 +167,8 @@ private:
 	vehicle_status_s		_vehicle_status {};		///< vehicle status */
 
 	perf_counter_t	_loop_perf;				///< loop performance counter */
+	perf_counter_t	_l1_perf;				///< L1 lateral guidance performance counter */
+	perf_counter_t	_tecs_perf;				///< TECS height/speed control performance counter */
 
 	float	_hold_alt{0.0f};				///< hold altitude for altitude mode */
 	float	_takeoff_ground_alt{0.0f};			///< ground altitude at which plane was launched */
@@ -218,6 +220,7 @@ private:
 	float _groundspeed_undershoot{0.0f};			///< ground speed error to min. speed in m/s
 
 	math::Matrix<3, 3> _R_nb;				///< current attitude
+	math::Matrix<3, 3> _R_ts_offset;			///< constant pitch rotation between hover and fixed-wing frame (tailsitters) */
 	float _roll{0.0f};
 	float _pitch{0.0f};
 	float _yaw{0.0f};
@@ -275,6 +278,13 @@ private:
 		float pitch_limit_max;
 		float roll_limit;
 
+		/* converted once in parameters_update() so the control path does not
+		 * redo the deg->rad conversions every cycle */
+		float pitch_limit_min_rad;
+		float pitch_limit_max_rad;
+		float land_flare_pitch_min_rad;
+		float land_flare_pitch_max_rad;
+
 		float throttle_min;
 		float throttle_max;
 		float throttle_idle;
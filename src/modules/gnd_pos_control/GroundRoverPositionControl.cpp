@@ -84,6 +84,9 @@ GroundRoverPositionControl::GroundRoverPositionControl() :
 	_parameter_handles.throttle_max = param_find("GND_THR_MAX");
 	_parameter_handles.throttle_cruise = param_find("GND_THR_CRUISE");
 
+	_parameter_handles.ctrl_rate = param_find("GND_CTRL_RATE");
+	_parameter_handles.vel_alpha = param_find("GND_VEL_ALPHA");
+
 	/* fetch initial parameter values */
 	parameters_update();
 }
@@ -135,6 +138,17 @@ GroundRoverPositionControl::parameters_update()
 	param_get(_parameter_handles.throttle_max, &(_parameters.throttle_max));
 	param_get(_parameter_handles.throttle_cruise, &(_parameters.throttle_cruise));
 
+	param_get(_parameter_handles.ctrl_rate, &(_parameters.ctrl_rate));
+	param_get(_parameter_handles.vel_alpha, &(_parameters.vel_alpha));
+
+	_parameters.ctrl_rate = math::constrain(_parameters.ctrl_rate, (int32_t)5, (int32_t)50);
+	_parameters.vel_alpha = math::constrain(_parameters.vel_alpha, 0.05f, 1.0f);
+
+	/* rate limit position updates to the control rate of the vehicle class */
+	if (_global_pos_sub >= 0) {
+		orb_set_interval(_global_pos_sub, 1000 / _parameters.ctrl_rate);
+	}
+
 	_gnd_control.set_l1_damping(_parameters.l1_damping);
 	_gnd_control.set_l1_period(_parameters.l1_period);
 	_gnd_control.set_l1_roll_limit(math::radians(0.0f));
@@ -178,17 +192,6 @@ GroundRoverPositionControl::manual_control_setpoint_poll()
 	}
 }
 
-void
-GroundRoverPositionControl::control_state_poll()
-{
-	bool ctrl_state_updated;
-	orb_check(_ctrl_state_sub, &ctrl_state_updated);
-
-	if (ctrl_state_updated) {
-		orb_copy(ORB_ID(control_state), _ctrl_state_sub, &_ctrl_state);
-	}
-}
-
 void
 GroundRoverPositionControl::position_setpoint_triplet_poll()
 {
@@ -212,6 +215,22 @@ void GroundRoverPositionControl::gnd_pos_ctrl_status_publish()
 	}
 }
 
+void
+GroundRoverPositionControl::update_groundspeed_filter(float speed_meas, float dt)
+{
+	/* fixed-gain alpha-beta filter: predict with the current acceleration estimate,
+	 * then correct both states with the measurement residual. Beta is derived
+	 * from alpha so only one gain needs tuning. */
+	const float alpha = _parameters.vel_alpha;
+	const float beta = alpha * alpha / (2.0f - alpha);
+
+	const float prediction = _groundspeed_filtered + _groundaccel_filtered * dt;
+	const float residual = speed_meas - prediction;
+
+	_groundspeed_filtered = prediction + alpha * residual;
+	_groundaccel_filtered += beta * residual / dt;
+}
+
 bool
 GroundRoverPositionControl::control_position(const math::Vector<2> &current_position,
 		const math::Vector<3> &ground_speed, const position_setpoint_triplet_s &pos_sp_triplet)
@@ -224,6 +243,10 @@ GroundRoverPositionControl::control_position(const math::Vector<2> &current_posi
 
 	_control_position_last_called = hrt_absolute_time();
 
+	/* run the ground speed smoother in every mode so it is settled when
+	 * the closed speed loop engages */
+	update_groundspeed_filter(sqrtf(ground_speed(0) * ground_speed(0) + ground_speed(1) * ground_speed(1)), dt);
+
 	bool setpoint = true;
 
 	if (_control_mode.flag_control_auto_enabled && pos_sp_triplet.current.valid) {
@@ -260,9 +283,9 @@ GroundRoverPositionControl::control_position(const math::Vector<2> &current_posi
 				mission_target_speed = _pos_sp_triplet.current.cruising_speed;
 			}
 
-			//Compute airspeed control out and just scale it as a constant
+			//Compute the speed control out and just scale it as a constant
 			mission_throttle = _parameters.throttle_speed_scaler
-					   * pid_calculate(&_speed_ctrl, mission_target_speed, _ctrl_state.x_vel, _ctrl_state.x_acc, dt);
+					   * pid_calculate(&_speed_ctrl, mission_target_speed, _groundspeed_filtered, _groundaccel_filtered, dt);
 
 			// Constrain throttle between min and max
 			mission_throttle = math::constrain(mission_throttle, _parameters.throttle_min, _parameters.throttle_max);
@@ -331,7 +354,6 @@ void
 GroundRoverPositionControl::task_main()
 {
 	_control_mode_sub = orb_subscribe(ORB_ID(vehicle_control_mode));
-	_ctrl_state_sub = orb_subscribe(ORB_ID(control_state));
 	_global_pos_sub = orb_subscribe(ORB_ID(vehicle_global_position));
 	_manual_control_sub = orb_subscribe(ORB_ID(manual_control_setpoint));
 	_params_sub = orb_subscribe(ORB_ID(parameter_update));
@@ -340,10 +362,8 @@ GroundRoverPositionControl::task_main()
 	/* rate limit control mode updates to 5Hz */
 	orb_set_interval(_control_mode_sub, 200);
 
-	/* rate limit position updates to 50 Hz */
-	orb_set_interval(_global_pos_sub, 20);
-
-	/* abort on a nonzero return value from the parameter init */
+	/* abort on a nonzero return value from the parameter init; this also
+	 * rate limits the position updates to the configured control rate */
 	if (parameters_update()) {
 		/* parameter setup went wrong, abort */
 		warnx("aborting startup due to errors.");
@@ -409,7 +429,6 @@ GroundRoverPositionControl::task_main()
 			// update the reset counters in any case
 			_pos_reset_counter = _global_pos.lat_lon_reset_counter;
 
-			control_state_poll();
 			manual_control_setpoint_poll();
 			position_setpoint_triplet_poll();
 
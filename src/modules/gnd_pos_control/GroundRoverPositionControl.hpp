@@ -54,7 +54,6 @@
 #include <mathlib/mathlib.h>
 #include <systemlib/perf_counter.h>
 #include <systemlib/pid/pid.h>
-#include <uORB/topics/control_state.h>
 #include <uORB/topics/fw_pos_ctrl_status.h>
 #include <uORB/topics/manual_control_setpoint.h>
 #include <uORB/topics/parameter_update.h>
@@ -96,13 +95,11 @@ private:
 	bool		_task_running{false};			/**< if true, task is running in its mainloop */
 
 	int		_control_mode_sub{-1};		/**< control mode subscription */
-	int		_ctrl_state_sub{-1};			/**< control state subscription */
 	int		_global_pos_sub{-1};
 	int		_manual_control_sub{-1};		/**< notification of manual control updates */
 	int		_params_sub{-1};			/**< notification of parameter updates */
 	int		_pos_sp_triplet_sub{-1};
 
-	control_state_s				_ctrl_state{};			/**< control state */
 	fw_pos_ctrl_status_s			_gnd_pos_ctrl_status{};		/**< navigation capabilities */
 	manual_control_setpoint_s		_manual{};			/**< r/c channel data */
 	position_setpoint_triplet_s		_pos_sp_triplet{};		/**< triplet of mission items */
@@ -118,6 +115,11 @@ private:
 	 the throttle. For now just assuming a proportional scaler between controlled airspeed and throttle output.*/
 	PID_t _speed_ctrl{};
 
+	/* Fixed-gain alpha-beta smoother for the measured ground speed. It replaces the estimator
+	 velocity and acceleration terms in the speed loop, which a rover does not need at full fidelity. */
+	float _groundspeed_filtered{0.0f};	/**< smoothed ground speed estimate in m/s */
+	float _groundaccel_filtered{0.0f};	/**< smoothed ground acceleration estimate in m/s^2 */
+
 	// estimator reset counters
 	uint8_t _pos_reset_counter{0};		// captures the number of times the estimator has reset the horizontal position
 
@@ -148,6 +150,9 @@ private:
 		float throttle_cruise;
 		float throttle_slew_max;
 
+		int32_t ctrl_rate;
+		float vel_alpha;
+
 	} _parameters{};			/**< local copies of interesting parameters */
 
 	struct {
@@ -171,6 +176,9 @@ private:
 		param_t throttle_cruise;
 		param_t throttle_slew_max;
 
+		param_t ctrl_rate;
+		param_t vel_alpha;
+
 	} _parameter_handles{};		/**< handles for interesting parameters */
 
 
@@ -180,7 +188,6 @@ private:
 	int		parameters_update();
 
 	void		manual_control_setpoint_poll();
-	void		control_state_poll();
 	void		position_setpoint_triplet_poll();
 	void		vehicle_control_mode_poll();
 
@@ -189,6 +196,11 @@ private:
 	 */
 	void		gnd_pos_ctrl_status_publish();
 
+	/**
+	 * Update the alpha-beta ground speed smoother with a new measurement.
+	 */
+	void		update_groundspeed_filter(float speed_meas, float dt);
+
 	/**
 	 * Control position.
 	 */
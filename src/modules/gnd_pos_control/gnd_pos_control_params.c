@@ -260,3 +260,32 @@ PARAM_DEFINE_FLOAT(GND_SPEED_TRIM, 3.0f);
  * @group FW TECS
  */
 PARAM_DEFINE_FLOAT(GND_SPEED_MAX, 10.0f);
+
+/**
+ * Control loop rate
+ *
+ * Update rate of the position and speed control loop. A ground vehicle does
+ * not need the 50 Hz loop of the airborne controllers; lower rates free CPU
+ * on small boards at the cost of a slightly slower guidance response.
+ *
+ * @unit Hz
+ * @min 5
+ * @max 50
+ * @group GND POS Control
+ */
+PARAM_DEFINE_INT32(GND_CTRL_RATE, 25);
+
+/**
+ * Ground speed filter gain
+ *
+ * Alpha gain of the fixed-gain alpha-beta filter smoothing the measured ground
+ * speed for the closed loop speed controller. The beta gain is derived from
+ * alpha. Lower values smooth more but add lag to the speed loop.
+ *
+ * @min 0.05
+ * @max 1.0
+ * @decimal 2
+ * @increment 0.05
+ * @group GND POS Control
+ */
+PARAM_DEFINE_FLOAT(GND_VEL_ALPHA, 0.2f);
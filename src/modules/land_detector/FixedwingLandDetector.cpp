@@ -57,7 +57,7 @@ FixedwingLandDetector::FixedwingLandDetector()
 	_paramHandle.maxIntVelocity = param_find("LNDFW_VELI_MAX");
 
 	// Use Trigger time when transitioning from in-air (false) to landed (true) / ground contact (true).
-	_landed_hysteresis.set_hysteresis_time_from(false, LAND_DETECTOR_TRIGGER_TIME_US);
+	_hysteresis.set_hysteresis_time_from(HYST_LANDED, false, LAND_DETECTOR_TRIGGER_TIME_US);
 }
 
 void FixedwingLandDetector::_initialize_topics()
@@ -67,11 +67,13 @@ void FixedwingLandDetector::_initialize_topics()
 	_airspeedSub = orb_subscribe(ORB_ID(airspeed));
 }
 
-void FixedwingLandDetector::_update_topics()
+bool FixedwingLandDetector::_update_topics()
 {
-	_orb_update(ORB_ID(control_state), _controlStateSub, &_controlState);
-	_orb_update(ORB_ID(actuator_armed), _armingSub, &_arming);
-	_orb_update(ORB_ID(airspeed), _airspeedSub, &_airspeed);
+	bool updated = _orb_update(ORB_ID(control_state), _controlStateSub, &_controlState);
+	updated |= _orb_update(ORB_ID(actuator_armed), _armingSub, &_arming);
+	updated |= _orb_update(ORB_ID(airspeed), _airspeedSub, &_airspeed);
+
+	return updated;
 }
 
 void FixedwingLandDetector::_update_params()
@@ -44,6 +44,7 @@
 
 #include <px4_config.h>
 #include <px4_defines.h>
+#include <px4_tick_align.h>
 #include <drivers/drv_hrt.h>
 #include "uORB/topics/parameter_update.h"
 
@@ -97,65 +98,75 @@ void LandDetector::_cycle()
 		_object = this;
 	}
 
-	_check_params(false);
-	_update_topics();
-	_update_state();
-
-	const bool landDetected = (_state == LandDetectionState::LANDED);
-	const bool freefallDetected = (_state == LandDetectionState::FREEFALL);
-	const bool maybe_landedDetected = (_state == LandDetectionState::MAYBE_LANDED);
-	const bool ground_contactDetected = (_state == LandDetectionState::GROUND_CONTACT);
-	const float alt_max = _get_max_altitude();
-
-	// Only publish very first time or when the result has changed.
-	if ((_landDetectedPub == nullptr) ||
-	    (_landDetected.landed != landDetected) ||
-	    (_landDetected.freefall != freefallDetected) ||
-	    (_landDetected.maybe_landed != maybe_landedDetected) ||
-	    (_landDetected.ground_contact != ground_contactDetected) ||
-	    (fabsf(_landDetected.alt_max - alt_max) > FLT_EPSILON)) {
-
-		hrt_abstime now = hrt_absolute_time();
-
-		if (!landDetected && _landDetected.landed) {
-			// We did take off
-			_takeoff_time = now;
-
-		} else if (_takeoff_time != 0 && landDetected && !_landDetected.landed) {
-			// We landed
-			_total_flight_time += now - _takeoff_time;
-			_takeoff_time = 0;
-			uint32_t flight_time = (_total_flight_time >> 32) & 0xffffffff;
-			param_set_no_notification(_p_total_flight_time_high, &flight_time);
-			flight_time = _total_flight_time & 0xffffffff;
-			param_set_no_notification(_p_total_flight_time_low, &flight_time);
+	const bool params_updated = _check_params(false);
+	const bool topics_updated = _update_topics();
+
+	/* Only re-evaluate the state machine when an input actually changed or a
+	 * hysteresis window is still running; otherwise the cycle reduces to the
+	 * orb_check() calls above. */
+	if (topics_updated || params_updated ||
+	    (_landDetectedPub == nullptr) ||
+	    _hysteresis.transition_pending()) {
+
+		_update_state();
+
+		const bool landDetected = (_state == LandDetectionState::LANDED);
+		const bool freefallDetected = (_state == LandDetectionState::FREEFALL);
+		const bool maybe_landedDetected = (_state == LandDetectionState::MAYBE_LANDED);
+		const bool ground_contactDetected = (_state == LandDetectionState::GROUND_CONTACT);
+		const float alt_max = _get_max_altitude();
+
+		// Only publish very first time or when the result has changed.
+		if ((_landDetectedPub == nullptr) ||
+		    (_landDetected.landed != landDetected) ||
+		    (_landDetected.freefall != freefallDetected) ||
+		    (_landDetected.maybe_landed != maybe_landedDetected) ||
+		    (_landDetected.ground_contact != ground_contactDetected) ||
+		    (fabsf(_landDetected.alt_max - alt_max) > FLT_EPSILON)) {
+
+			hrt_abstime now = hrt_absolute_time();
+
+			if (!landDetected && _landDetected.landed) {
+				// We did take off
+				_takeoff_time = now;
+
+			} else if (_takeoff_time != 0 && landDetected && !_landDetected.landed) {
+				// We landed
+				_total_flight_time += now - _takeoff_time;
+				_takeoff_time = 0;
+				uint32_t flight_time = (_total_flight_time >> 32) & 0xffffffff;
+				param_set_no_notification(_p_total_flight_time_high, &flight_time);
+				flight_time = _total_flight_time & 0xffffffff;
+				param_set_no_notification(_p_total_flight_time_low, &flight_time);
+			}
+
+			_landDetected.timestamp = hrt_absolute_time();
+			_landDetected.landed = landDetected;
+			_landDetected.freefall = freefallDetected;
+			_landDetected.maybe_landed = maybe_landedDetected;
+			_landDetected.ground_contact = ground_contactDetected;
+			_landDetected.alt_max = alt_max;
+
+			int instance;
+			orb_publish_auto(ORB_ID(vehicle_land_detected), &_landDetectedPub, &_landDetected,
+					 &instance, ORB_PRIO_DEFAULT);
 		}
-
-		_landDetected.timestamp = hrt_absolute_time();
-		_landDetected.landed = landDetected;
-		_landDetected.freefall = freefallDetected;
-		_landDetected.maybe_landed = maybe_landedDetected;
-		_landDetected.ground_contact = ground_contactDetected;
-		_landDetected.alt_max = alt_max;
-
-		int instance;
-		orb_publish_auto(ORB_ID(vehicle_land_detected), &_landDetectedPub, &_landDetected,
-				 &instance, ORB_PRIO_DEFAULT);
 	}
 
 	perf_end(_cycle_perf);
 
 	if (!should_exit()) {
 
-		// Schedule next cycle.
+		// Schedule next cycle, aligned to the shared tick grid so the
+		// wakeup coalesces with other periodic modules.
 		work_queue(HPWORK, &_work, (worker_t)&LandDetector::_cycle_trampoline, this,
-			   USEC2TICK(1000000 / LAND_DETECTOR_UPDATE_RATE_HZ));
+			   USEC2TICK(px4_tick_align_delay(1000000 / LAND_DETECTOR_UPDATE_RATE_HZ, 0)));
 
 	} else {
 		exit_and_cleanup();
 	}
 }
-void LandDetector::_check_params(const bool force)
+bool LandDetector::_check_params(const bool force)
 {
 	bool updated;
 	parameter_update_s paramUpdate;
@@ -174,27 +185,33 @@ void LandDetector::_check_params(const bool force)
 		param_get(_p_total_flight_time_low, &flight_time);
 		_total_flight_time |= flight_time;
 	}
+
+	return updated || force;
 }
 
 void LandDetector::_update_state()
 {
 	/* when we are landed we also have ground contact for sure but only one output state can be true at a particular time
 	 * with higher priority for landed */
-	_freefall_hysteresis.set_state_and_update(_get_freefall_state());
-	_landed_hysteresis.set_state_and_update(_get_landed_state());
-	_maybe_landed_hysteresis.set_state_and_update(_get_maybe_landed_state());
-	_ground_contact_hysteresis.set_state_and_update(_get_ground_contact_state());
+	const bool requested_states[HYST_COUNT] = {
+		_get_freefall_state(),
+		_get_landed_state(),
+		_get_maybe_landed_state(),
+		_get_ground_contact_state()
+	};
+
+	_hysteresis.set_states_and_update(requested_states);
 
-	if (_freefall_hysteresis.get_state()) {
+	if (_hysteresis.get_state(HYST_FREEFALL)) {
 		_state = LandDetectionState::FREEFALL;
 
-	} else if (_landed_hysteresis.get_state()) {
+	} else if (_hysteresis.get_state(HYST_LANDED)) {
 		_state = LandDetectionState::LANDED;
 
-	} else if (_maybe_landed_hysteresis.get_state()) {
+	} else if (_hysteresis.get_state(HYST_MAYBE_LANDED)) {
 		_state = LandDetectionState::MAYBE_LANDED;
 
-	} else if (_ground_contact_hysteresis.get_state()) {
+	} else if (_hysteresis.get_state(HYST_GROUND_CONTACT)) {
 		_state = LandDetectionState::GROUND_CONTACT;
 
 	} else {
@@ -103,8 +103,10 @@ protected:
 
 	/**
 	 * Update uORB topics.
+	 *
+	 * @return true if any input topic had new data.
 	 */
-	virtual void _update_topics() = 0;
+	virtual bool _update_topics() = 0;
 
 	/**
 	 * Update parameters.
@@ -153,17 +155,23 @@ protected:
 
 	LandDetectionState _state{LandDetectionState::LANDED};
 
-	systemlib::Hysteresis _freefall_hysteresis{false};
-	systemlib::Hysteresis _landed_hysteresis{true};
-	systemlib::Hysteresis _maybe_landed_hysteresis{true};
-	systemlib::Hysteresis _ground_contact_hysteresis{true};
+	/** Channels of the hysteresis bank, in state priority order. */
+	enum {
+		HYST_FREEFALL = 0,
+		HYST_LANDED,
+		HYST_MAYBE_LANDED,
+		HYST_GROUND_CONTACT,
+		HYST_COUNT
+	};
+
+	systemlib::HysteresisBank<HYST_COUNT> _hysteresis{{false, true, true, true}};
 
 private:
 	static void _cycle_trampoline(void *arg);
 
 	void _cycle();
 
-	void _check_params(const bool force);
+	bool _check_params(const bool force);
 
 	void _update_state();
 
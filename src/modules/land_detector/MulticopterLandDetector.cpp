@@ -110,9 +110,9 @@ MulticopterLandDetector::MulticopterLandDetector() :
 	_paramHandle.landSpeed = param_find("MPC_LAND_SPEED");
 
 	// Use Trigger time when transitioning from in-air (false) to landed (true) / ground contact (true).
-	_landed_hysteresis.set_hysteresis_time_from(false, LAND_DETECTOR_TRIGGER_TIME_US);
-	_maybe_landed_hysteresis.set_hysteresis_time_from(false, MAYBE_LAND_DETECTOR_TRIGGER_TIME_US);
-	_ground_contact_hysteresis.set_hysteresis_time_from(false, GROUND_CONTACT_TRIGGER_TIME_US);
+	_hysteresis.set_hysteresis_time_from(HYST_LANDED, false, LAND_DETECTOR_TRIGGER_TIME_US);
+	_hysteresis.set_hysteresis_time_from(HYST_MAYBE_LANDED, false, MAYBE_LAND_DETECTOR_TRIGGER_TIME_US);
+	_hysteresis.set_hysteresis_time_from(HYST_GROUND_CONTACT, false, GROUND_CONTACT_TRIGGER_TIME_US);
 }
 
 void MulticopterLandDetector::_initialize_topics()
@@ -130,17 +130,20 @@ void MulticopterLandDetector::_initialize_topics()
 	_battery_sub = orb_subscribe(ORB_ID(battery_status));
 }
 
-void MulticopterLandDetector::_update_topics()
+bool MulticopterLandDetector::_update_topics()
 {
-	_orb_update(ORB_ID(vehicle_local_position), _vehicleLocalPositionSub, &_vehicleLocalPosition);
-	_orb_update(ORB_ID(vehicle_local_position_setpoint), _vehicleLocalPositionSetpointSub, &_vehicleLocalPositionSetpoint);
-	_orb_update(ORB_ID(vehicle_attitude), _attitudeSub, &_vehicleAttitude);
-	_orb_update(ORB_ID(actuator_controls_0), _actuatorsSub, &_actuators);
-	_orb_update(ORB_ID(actuator_armed), _armingSub, &_arming);
-	_orb_update(ORB_ID(manual_control_setpoint), _manualSub, &_manual);
-	_orb_update(ORB_ID(control_state), _ctrl_state_sub, &_ctrl_state);
-	_orb_update(ORB_ID(vehicle_control_mode), _vehicle_control_mode_sub, &_control_mode);
-	_orb_update(ORB_ID(battery_status), _battery_sub, &_battery);
+	bool updated = _orb_update(ORB_ID(vehicle_local_position), _vehicleLocalPositionSub, &_vehicleLocalPosition);
+	updated |= _orb_update(ORB_ID(vehicle_local_position_setpoint), _vehicleLocalPositionSetpointSub,
+			       &_vehicleLocalPositionSetpoint);
+	updated |= _orb_update(ORB_ID(vehicle_attitude), _attitudeSub, &_vehicleAttitude);
+	updated |= _orb_update(ORB_ID(actuator_controls_0), _actuatorsSub, &_actuators);
+	updated |= _orb_update(ORB_ID(actuator_armed), _armingSub, &_arming);
+	updated |= _orb_update(ORB_ID(manual_control_setpoint), _manualSub, &_manual);
+	updated |= _orb_update(ORB_ID(control_state), _ctrl_state_sub, &_ctrl_state);
+	updated |= _orb_update(ORB_ID(vehicle_control_mode), _vehicle_control_mode_sub, &_control_mode);
+	updated |= _orb_update(ORB_ID(battery_status), _battery_sub, &_battery);
+
+	return updated;
 }
 
 void MulticopterLandDetector::_update_params()
@@ -155,7 +158,7 @@ void MulticopterLandDetector::_update_params()
 	param_get(_paramHandle.minManThrottle, &_params.minManThrottle);
 	param_get(_paramHandle.freefall_acc_threshold, &_params.freefall_acc_threshold);
 	param_get(_paramHandle.freefall_trigger_time, &_params.freefall_trigger_time);
-	_freefall_hysteresis.set_hysteresis_time_from(false, (hrt_abstime)(1e6f * _params.freefall_trigger_time));
+	_hysteresis.set_hysteresis_time_from(HYST_FREEFALL, false, (hrt_abstime)(1e6f * _params.freefall_trigger_time));
 	param_get(_paramHandle.manual_stick_down_threshold, &_params.manual_stick_down_threshold);
 	param_get(_paramHandle.altitude_max, &_params.altitude_max);
 	param_get(_paramHandle.manual_stick_up_position_takeoff_threshold, &_params.manual_stick_up_position_takeoff_threshold);
@@ -256,7 +259,7 @@ bool MulticopterLandDetector::_get_maybe_landed_state()
 
 		} else {
 			// Pilot wants to take off, assume no groundcontact anymore and therefore allow thrust
-			_ground_contact_hysteresis.set_state_and_update(false);
+			_hysteresis.set_state_and_update(HYST_GROUND_CONTACT, false);
 			return false;
 		}
 	}
@@ -294,7 +297,7 @@ bool MulticopterLandDetector::_get_maybe_landed_state()
 		return (_min_trust_start > 0) && (hrt_elapsed_time(&_min_trust_start) > 8000000);
 	}
 
-	if (_ground_contact_hysteresis.get_state() && _has_minimal_thrust() && !rotating) {
+	if (_hysteresis.get_state(HYST_GROUND_CONTACT) && _has_minimal_thrust() && !rotating) {
 		// Ground contact, no thrust and no movement -> landed
 		return true;
 	}
@@ -305,7 +308,7 @@ bool MulticopterLandDetector::_get_maybe_landed_state()
 bool MulticopterLandDetector::_get_landed_state()
 {
 	// reset the landed_time
-	if (!_maybe_landed_hysteresis.get_state()) {
+	if (!_hysteresis.get_state(HYST_MAYBE_LANDED)) {
 
 		_landed_time = 0;
 
@@ -317,7 +320,7 @@ bool MulticopterLandDetector::_get_landed_state()
 
 	// if we have maybe_landed, the mc_pos_control goes into idle (thrust_sp = 0.0)
 	// therefore check if all other condition of the landed state remain true
-	return _maybe_landed_hysteresis.get_state();
+	return _hysteresis.get_state(HYST_MAYBE_LANDED);
 
 }
 
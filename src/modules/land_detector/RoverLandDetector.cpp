@@ -50,8 +50,9 @@ void RoverLandDetector::_initialize_topics()
 {
 }
 
-void RoverLandDetector::_update_topics()
+bool RoverLandDetector::_update_topics()
 {
+	return false;
 }
 
 void RoverLandDetector::_update_params()
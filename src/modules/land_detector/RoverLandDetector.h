@@ -58,7 +58,7 @@ protected:
 
 	virtual void _update_params() override;
 
-	virtual void _update_topics() override;
+	virtual bool _update_topics() override;
 
 	virtual bool _get_landed_state() override;
 
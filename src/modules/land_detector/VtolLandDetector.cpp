@@ -59,12 +59,14 @@ void VtolLandDetector::_initialize_topics()
 	_vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
 }
 
-void VtolLandDetector::_update_topics()
+bool VtolLandDetector::_update_topics()
 {
-	MulticopterLandDetector::_update_topics();
+	bool updated = MulticopterLandDetector::_update_topics();
 
-	_orb_update(ORB_ID(airspeed), _airspeedSub, &_airspeed);
-	_orb_update(ORB_ID(vehicle_status), _vehicle_status_sub, &_vehicle_status);
+	updated |= _orb_update(ORB_ID(airspeed), _airspeedSub, &_airspeed);
+	updated |= _orb_update(ORB_ID(vehicle_status), _vehicle_status_sub, &_vehicle_status);
+
+	return updated;
 }
 
 bool VtolLandDetector::_get_maybe_landed_state()
@@ -57,7 +57,7 @@ public:
 protected:
 	void _initialize_topics() override;
 	void _update_params() override;
-	void _update_topics() override;
+	bool _update_topics() override;
 	bool _get_landed_state() override;
 	bool _get_maybe_landed_state() override;
 
@@ -39,6 +39,7 @@
  * @author Andreas Antener <andreas@uaventure.com>
  */
 
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -46,6 +47,8 @@
 
 #include <px4_config.h>
 #include <px4_module.h>
+#include <px4_tasks.h>
+#include <px4_tick_align.h>
 #include <px4_workqueue.h>
 #include <px4_defines.h>
 
@@ -57,7 +60,9 @@
 
 #include <uORB/uORB.h>
 #include <uORB/topics/cpuload.h>
+#include <uORB/topics/task_partition_status.h>
 #include <uORB/topics/task_stack_info.h>
+#include <uORB/topics/work_queue_status.h>
 
 extern struct system_load_s system_load;
 
@@ -82,6 +87,22 @@ public:
 	/** @see ModuleBase */
 	static int custom_command(int argc, char *argv[])
 	{
+#ifdef __PX4_NUTTX
+
+		if (argc >= 1 && strcmp(argv[0], "report") == 0) {
+			if (!is_running()) {
+				PX4_ERR("not running");
+				return 1;
+			}
+
+			return get_instance()->print_stack_report();
+		}
+
+		if (argc >= 1 && strcmp(argv[0], "partition") == 0) {
+			return partition_command(argc - 1, argv + 1);
+		}
+
+#endif
 		return print_usage("unknown command");
 	}
 
@@ -101,22 +122,61 @@ private:
 	/** Do a calculation of the CPU load and publish it. */
 	void _compute();
 
+#ifndef __PX4_NUTTX
+	/** Publish the work queue dispatch health (POSIX layer work queues only) */
+	void _wq_status();
+#endif
+
 	/** Calculate the memory usage */
 	float _ram_used();
 
 #ifdef __PX4_NUTTX
+	/** Configure the time-partition scheduler ('load_mon partition') */
+	static int partition_command(int argc, char *argv[]);
+
+	/** Publish the time-partition scheduler accounting when active */
+	void _partition_status();
+
 	/* Calculate stack usage */
 	void _stack_usage();
 
+	/** Print the per-task stack watermark table ('load_mon report') */
+	int print_stack_report();
+
+	/* per-task stack watermark records, kept across scans so that a shrinking
+	 * margin can be detected and reported before the task hardfaults */
+	struct stack_record_s {
+		int16_t pid;		///< -1 = unused slot
+		uint16_t stack_size;	///< total stack size in bytes
+		uint16_t stack_free;	///< lifetime minimum of free stack (watermark)
+		bool warned;		///< margin warning already given for this task
+		char name[task_stack_info_s::MAX_REPORT_TASK_NAME_LEN];
+	};
+
+	static constexpr int MAX_STACK_RECORDS = CONFIG_MAX_TASKS;
+
 	struct task_stack_info_s _task_stack_info;
 	int _stack_task_index;
 	orb_advert_t _task_stack_info_pub;
+	orb_advert_t _task_partition_status_pub;
+	stack_record_s _stack_records[MAX_STACK_RECORDS];
+#endif
+
+#ifdef __PX4_LINUX
+	/** Read the per-core utilization from /proc/stat */
+	void _per_core_load();
+
+	uint64_t _last_core_total[cpuload_s::MAX_CPUS];
+	uint64_t _last_core_busy[cpuload_s::MAX_CPUS];
 #endif
 
 	struct work_s _work;
 
 	struct cpuload_s _cpuload;
 	orb_advert_t _cpuload_pub;
+#ifndef __PX4_NUTTX
+	orb_advert_t _wq_status_pub;
+#endif
 	hrt_abstime _last_idle_time;
 	perf_counter_t _stack_perf;
 	bool _stack_check_enabled;
@@ -127,10 +187,19 @@ LoadMon::LoadMon() :
 	_task_stack_info {},
 	_stack_task_index(0),
 	_task_stack_info_pub(nullptr),
+	_task_partition_status_pub(nullptr),
+	_stack_records {},
+#endif
+#ifdef __PX4_LINUX
+	_last_core_total {},
+	_last_core_busy {},
 #endif
 	_work {},
 	_cpuload{},
 	_cpuload_pub(nullptr),
+#ifndef __PX4_NUTTX
+	_wq_status_pub(nullptr),
+#endif
 	_last_idle_time(0),
 	_stack_perf(perf_alloc(PC_ELAPSED, "stack_check")),
 	_stack_check_enabled(false)
@@ -190,8 +259,10 @@ void LoadMon::_cycle()
 	_compute();
 
 	if (!should_exit()) {
+		/* align to the shared tick grid: the 1 s boundary coincides with
+		 * the boundaries of the faster periodic modules */
 		work_queue(LPWORK, &_work, (worker_t)&LoadMon::cycle_trampoline, this,
-			   USEC2TICK(LOAD_MON_INTERVAL_US));
+			   USEC2TICK(px4_tick_align_delay(LOAD_MON_INTERVAL_US, 0)));
 
 	} else {
 		exit_and_cleanup();
@@ -214,12 +285,18 @@ void LoadMon::_compute()
 	_cpuload.load = 1.0f - (float)interval_idletime / (float)LOAD_MON_INTERVAL_US;
 	_cpuload.ram_usage = _ram_used();
 
+#ifdef __PX4_LINUX
+	_per_core_load();
+#endif
+
 #ifdef __PX4_NUTTX
 
 	if (_stack_check_enabled) {
 		_stack_usage();
 	}
 
+	_partition_status();
+
 #endif
 
 	if (_cpuload_pub == nullptr) {
@@ -228,8 +305,44 @@ void LoadMon::_compute()
 	} else {
 		orb_publish(ORB_ID(cpuload), _cpuload_pub, &_cpuload);
 	}
+
+#ifndef __PX4_NUTTX
+	_wq_status();
+#endif
 }
 
+#ifndef __PX4_NUTTX
+void LoadMon::_wq_status()
+{
+	/* the windowed worst-case is reset on each read, so the topic carries
+	 * per-interval peaks. Since this runs on the low-priority queue itself,
+	 * a stale topic is equally a sign of a starved queue. */
+	struct work_queue_stats_s hp_stats;
+	struct work_queue_stats_s lp_stats;
+
+	if (work_queue_get_stats(HPWORK, &hp_stats, true) != 0 ||
+	    work_queue_get_stats(LPWORK, &lp_stats, true) != 0) {
+		return;
+	}
+
+	work_queue_status_s wq_status = {};
+	wq_status.timestamp = hrt_absolute_time();
+	wq_status.hp_latency_worst_us = hp_stats.latency_worst;
+	wq_status.lp_latency_worst_us = lp_stats.latency_worst;
+	wq_status.hp_latency_window_us = hp_stats.latency_window_worst;
+	wq_status.lp_latency_window_us = lp_stats.latency_window_worst;
+	wq_status.hp_last_dispatch = hp_stats.last_dispatch;
+	wq_status.lp_last_dispatch = lp_stats.last_dispatch;
+
+	if (_wq_status_pub == nullptr) {
+		_wq_status_pub = orb_advertise(ORB_ID(work_queue_status), &wq_status);
+
+	} else {
+		orb_publish(ORB_ID(work_queue_status), _wq_status_pub, &wq_status);
+	}
+}
+#endif
+
 float LoadMon::_ram_used()
 {
 #ifdef __PX4_NUTTX
@@ -259,7 +372,116 @@ float LoadMon::_ram_used()
 #endif
 }
 
+#ifdef __PX4_LINUX
+void LoadMon::_per_core_load()
+{
+	/* parse the per-core lines of /proc/stat, e.g. "cpu0 4705 150 1120 16250 520 29 220 0 0 0" */
+	FILE *fp = fopen("/proc/stat", "r");
+
+	if (fp == nullptr) {
+		return;
+	}
+
+	char line[256];
+	int core = 0;
+
+	while (fgets(line, sizeof(line), fp) != nullptr && core < cpuload_s::MAX_CPUS) {
+		if (strncmp(line, "cpu", 3) != 0 || !isdigit(line[3])) {
+			if (core > 0) {
+				break; // the per-core lines are consecutive
+			}
+
+			continue;
+		}
+
+		unsigned long long user = 0, nice_time = 0, system_time = 0, idle = 0, iowait = 0, irq = 0, softirq = 0;
+
+		if (sscanf(line + 3, "%*d %llu %llu %llu %llu %llu %llu %llu",
+			   &user, &nice_time, &system_time, &idle, &iowait, &irq, &softirq) < 4) {
+			break;
+		}
+
+		const uint64_t total = user + nice_time + system_time + idle + iowait + irq + softirq;
+		const uint64_t busy = total - idle - iowait;
+
+		if (_last_core_total[core] != 0 && total > _last_core_total[core]) {
+			_cpuload.core_load[core] = (float)(busy - _last_core_busy[core]) /
+						   (float)(total - _last_core_total[core]);
+		}
+
+		_last_core_total[core] = total;
+		_last_core_busy[core] = busy;
+		++core;
+	}
+
+	fclose(fp);
+	_cpuload.core_count = core;
+}
+#endif
+
 #ifdef __PX4_NUTTX
+int LoadMon::partition_command(int argc, char *argv[])
+{
+	if (argc >= 1 && strcmp(argv[0], "stop") == 0) {
+		if (px4_task_partition_stop() != 0) {
+			PX4_ERR("partition not running");
+			return 1;
+		}
+
+		return 0;
+	}
+
+	if (argc < 3) {
+		return print_usage("partition needs <period_ms> <window_ms> <task>...");
+	}
+
+	const unsigned period_us = strtoul(argv[0], nullptr, 10) * 1000;
+	const unsigned window_us = strtoul(argv[1], nullptr, 10) * 1000;
+
+	for (int i = 2; i < argc; i++) {
+		int ret = px4_task_set_critical(argv[i]);
+
+		if (ret != 0) {
+			PX4_ERR("failed to add task %s (%d)", argv[i], ret);
+			return 1;
+		}
+	}
+
+	int ret = px4_task_partition_start(period_us, window_us);
+
+	if (ret != 0) {
+		PX4_ERR("partition start failed (%d)", ret);
+		return 1;
+	}
+
+	return 0;
+}
+
+void LoadMon::_partition_status()
+{
+	px4_task_partition_status_t status;
+
+	if (px4_task_partition_status(&status) != 0 || !status.active) {
+		return;
+	}
+
+	task_partition_status_s report = {};
+	report.timestamp = hrt_absolute_time();
+	report.period_us = status.period_us;
+	report.window_us = status.window_us;
+	report.cycles = status.cycles;
+	report.overruns = status.overruns;
+	report.last_overrun_us = status.last_overrun_us;
+	report.critical_tasks = status.critical_tasks;
+
+	if (_task_partition_status_pub == nullptr) {
+		_task_partition_status_pub = orb_advertise(ORB_ID(task_partition_status), &report);
+
+	} else {
+		orb_publish(ORB_ID(task_partition_status), _task_partition_status_pub, &report);
+	}
+}
+
 void LoadMon::_stack_usage()
 {
 	int task_index = 0;
@@ -270,6 +492,8 @@ void LoadMon::_stack_usage()
 	for (int i = _stack_task_index; i < _stack_task_index + num_tasks_per_cycle; i++) {
 		task_index = i % CONFIG_MAX_TASKS;
 		unsigned stack_free = 0;
+		unsigned stack_size = 0;
+		int task_pid = -1;
 		bool checked_task = false;
 
 		perf_begin(_stack_perf);
@@ -278,6 +502,8 @@ void LoadMon::_stack_usage()
 		if (system_load.tasks[task_index].valid && system_load.tasks[task_index].tcb->pid > 0) {
 
 			stack_free = up_check_tcbstack_remain(system_load.tasks[task_index].tcb);
+			stack_size = system_load.tasks[task_index].tcb->adj_stack_size;
+			task_pid = system_load.tasks[task_index].tcb->pid;
 
 			strncpy((char *)_task_stack_info.task_name, system_load.tasks[task_index].tcb->name,
 				task_stack_info_s::MAX_REPORT_TASK_NAME_LEN);
@@ -291,6 +517,7 @@ void LoadMon::_stack_usage()
 		if (checked_task) {
 
 			_task_stack_info.stack_free = stack_free;
+			_task_stack_info.stack_size = stack_size;
 			_task_stack_info.timestamp = hrt_absolute_time();
 
 			if (_task_stack_info_pub == nullptr) {
@@ -300,6 +527,49 @@ void LoadMon::_stack_usage()
 				orb_publish(ORB_ID(task_stack_info), _task_stack_info_pub, &_task_stack_info);
 			}
 
+			/* update the watermark record for trend detection and the
+			 * report command */
+			stack_record_s *rec = nullptr;
+
+			for (int j = 0; j < MAX_STACK_RECORDS; j++) {
+				if (_stack_records[j].pid == task_pid) {
+					rec = &_stack_records[j];
+					break;
+				}
+
+				if (rec == nullptr && _stack_records[j].pid <= 0) {
+					/* remember the first free slot, but keep looking for a pid match */
+					rec = &_stack_records[j];
+				}
+			}
+
+			if (rec != nullptr) {
+				if (rec->pid != task_pid) {
+					/* new task (or a recycled pid): start a fresh record */
+					rec->pid = task_pid;
+					rec->stack_free = stack_free;
+					rec->warned = false;
+					strncpy(rec->name, (char *)_task_stack_info.task_name, sizeof(rec->name));
+				}
+
+				rec->stack_size = stack_size;
+
+				/* the check returns the lifetime minimum, so any decrease is
+				 * a new high-water mark */
+				if (stack_free < rec->stack_free) {
+					rec->stack_free = stack_free;
+
+					/* early warning when the watermark climbs past 75% of the
+					 * stack, before the hard low-stack limit is reached */
+					if (!rec->warned && stack_size > 0 && stack_free < stack_size / 4
+					    && stack_free >= STACK_LOW_WARNING_THRESHOLD) {
+						PX4_WARN("%s stack margin shrinking: %u of %u bytes left",
+							 rec->name, stack_free, stack_size);
+						rec->warned = true;
+					}
+				}
+			}
+
 			/*
 			 * Found task low on stack, report and exit. Continue here in next cycle.
 			 */
@@ -317,11 +587,44 @@ void LoadMon::_stack_usage()
 	/* Continue after last checked task next cycle. */
 	_stack_task_index = task_index + 1;
 }
+
+int LoadMon::print_stack_report()
+{
+	if (!_stack_check_enabled) {
+		PX4_INFO("stack checking disabled (SYS_STCK_EN)");
+		return 0;
+	}
+
+	PX4_INFO("%-16s %6s %6s %6s %s", "task", "size", "peak", "free", "margin");
+
+	for (int i = 0; i < MAX_STACK_RECORDS; i++) {
+		const stack_record_s &rec = _stack_records[i];
+
+		if (rec.pid <= 0) {
+			continue;
+		}
+
+		PX4_INFO("%-16s %6u %6u %6u %4u%%", rec.name, rec.stack_size,
+			 rec.stack_size - rec.stack_free, rec.stack_free,
+			 rec.stack_size > 0 ? (rec.stack_free * 100) / rec.stack_size : 0);
+	}
+
+	return 0;
+}
 #endif
 
 int LoadMon::print_status()
 {
 	PX4_INFO("running");
+
+#ifdef __PX4_LINUX
+
+	for (int i = 0; i < _cpuload.core_count; i++) {
+		PX4_INFO("core %d load: %.1f %%", i, (double)(_cpuload.core_load[i] * 100.0f));
+	}
+
+#endif
+
 	perf_print_counter(_stack_perf);
 	return 0;
 }
@@ -338,12 +641,22 @@ int LoadMon::print_usage(const char *reason)
 Background process running periodically with 1 Hz on the LP work queue to calculate the CPU load and RAM
 usage and publish the `cpuload` topic.
 
-On NuttX it also checks the stack usage of each process and if it falls below 300 bytes, a warning is output,
-which will also appear in the log file.
+On NuttX it also checks the stack usage of each process: the high-water mark of each task is published
+and logged via the `task_stack_info` topic, a warning is output when the margin shrinks below 25% of the
+stack (and again, hard, below 300 bytes free), and `load_mon report` prints the per-task watermark table,
+so over-provisioned stacks can be identified and reclaimed.
+
+`load_mon partition` configures the time-partition scheduler of the platform layer: once per period the
+named critical tasks are raised to a priority ceiling for a guaranteed execution window, bounding the
+interference of auxiliary load on control timing. The accounting is published as the
+`task_partition_status` topic.
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("load_mon", "system");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Start the background task");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("report", "Print the per-task stack watermark table (NuttX only)");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("partition",
+					 "Start ('partition <period_ms> <window_ms> <task>...') or stop ('partition stop') the time partition (NuttX only)");
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 	return 0;
 }
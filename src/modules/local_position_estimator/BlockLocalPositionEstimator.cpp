@@ -146,6 +146,10 @@ BlockLocalPositionEstimator::BlockLocalPositionEstimator() :
 	_receivedGps(false),
 	_lastArmedState(false),
 
+	// covariance health scan scheduling
+	_covarianceDirty(true),
+	_covarianceScanCount(0),
+
 	// masks
 	_sensorTimeout(255),
 	_sensorFault(0),
@@ -410,9 +414,13 @@ void BlockLocalPositionEstimator::update()
 	}
 
 	// force P symmetry and reinitialize P if necessary
+	// The full element-wise scan is only needed after a measurement update
+	// has rewritten P; between measurements the prediction step keeps P
+	// symmetric, so a periodic scan suffices to catch slow drift.
 	bool reinit_P = false;
+	bool scan_P = _covarianceDirty || (++_covarianceScanCount >= P_SCAN_INTERVAL);
 
-	for (int i = 0; i < n_x; i++) {
+	for (int i = 0; scan_P && i < n_x; i++) {
 		for (int j = 0; j <= i; j++) {
 			if (!PX4_ISFINITE(_P(i, j))) {
 				mavlink_and_console_log_info(&mavlink_log_pub,
@@ -440,6 +448,11 @@ void BlockLocalPositionEstimator::update()
 		if (reinit_P) { break; }
 	}
 
+	if (scan_P) {
+		_covarianceDirty = false;
+		_covarianceScanCount = 0;
+	}
+
 	if (reinit_P) {
 		initP();
 	}
@@ -520,6 +533,12 @@ void BlockLocalPositionEstimator::update()
 		}
 	}
 
+	// any measurement update rewrites P, schedule a full health scan
+	if (gpsUpdated || baroUpdated || lidarUpdated || sonarUpdated ||
+	    flowUpdated || visionUpdated || mocapUpdated || landUpdated) {
+		_covarianceDirty = true;
+	}
+
 	if (_altOriginInitialized) {
 		// update all publications if possible
 		publishLocalPos();
@@ -37,6 +37,7 @@ static const float HIST_STEP = 0.05f; // 20 hz
 static const float BIAS_MAX = 1e-1f;
 static const size_t HIST_LEN = 10; // DELAY_MAX / HIST_STEP;
 static const size_t N_DIST_SUBS = 4;
+static const unsigned P_SCAN_INTERVAL = 50; // prediction steps between periodic covariance health scans
 
 // for fault detection
 // chi squared distribution, false alarm probability 0.0001
@@ -368,6 +369,10 @@ private:
 	bool _receivedGps;
 	bool _lastArmedState;
 
+	// covariance health scan scheduling
+	bool _covarianceDirty;
+	unsigned _covarianceScanCount;
+
 	// masks
 	uint8_t _sensorTimeout;
 	uint8_t _sensorFault;
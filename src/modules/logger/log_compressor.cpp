@@ -0,0 +1,207 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "log_compressor.h"
+
+#include <string.h>
+
+namespace px4
+{
+namespace logger
+{
+
+namespace
+{
+
+inline uint32_t read32(const uint8_t *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline void write16(uint8_t *p, uint16_t v)
+{
+	memcpy(p, &v, sizeof(v));
+}
+
+inline uint32_t hash_sequence(uint32_t sequence, int hash_log)
+{
+	return (sequence * 2654435761U) >> (32 - hash_log);
+}
+
+} // namespace
+
+size_t LogCompressor::compress_block(const uint8_t *src, size_t size, uint8_t *dst)
+{
+	size_t compressed = 0;
+
+	if (size >= 16) {
+		compressed = lz4_compress(src, size, dst + 4, size - 1);
+	}
+
+	if (compressed == 0) {
+		// incompressible: store the block as-is
+		write16(dst, (uint16_t)size);
+		write16(dst + 2, (uint16_t)size);
+		memcpy(dst + 4, src, size);
+		return size + 4;
+	}
+
+	write16(dst, (uint16_t)compressed);
+	write16(dst + 2, (uint16_t)size);
+	return compressed + 4;
+}
+
+size_t LogCompressor::lz4_compress(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_capacity)
+{
+	const uint8_t *ip = src;
+	const uint8_t *const iend = src + size;
+	const uint8_t *const mflimit = iend - 12; // last match must start 12 bytes before the end
+	const uint8_t *anchor = ip;
+	uint8_t *op = dst;
+	uint8_t *const oend = dst + dst_capacity;
+
+	memset(_hash_table, 0, sizeof(_hash_table));
+
+	if (size < 13) {
+		return 0;
+	}
+
+	ip++;
+
+	while (ip < mflimit) {
+		// find a match via the hash table
+		uint32_t h = hash_sequence(read32(ip), hash_log);
+		const uint8_t *match = src + _hash_table[h];
+		_hash_table[h] = (uint16_t)(ip - src);
+
+		if (match >= ip || (ip - match) > 65535 || read32(match) != read32(ip)) {
+			ip++;
+			continue;
+		}
+
+		// extend the match forward
+		const uint8_t *match_end = match + 4;
+		const uint8_t *ip_end = ip + 4;
+
+		while (ip_end < iend - 5 && *ip_end == *match_end) {
+			ip_end++;
+			match_end++;
+		}
+
+		size_t literal_len = ip - anchor;
+		size_t match_len = ip_end - ip - 4; // stored as length - 4 (minmatch)
+
+		// worst case output for this sequence
+		if (op + literal_len + literal_len / 255 + match_len / 255 + 12 > oend) {
+			return 0;
+		}
+
+		// token: 4 bits literal length, 4 bits match length
+		uint8_t *token = op++;
+		*token = 0;
+
+		if (literal_len >= 15) {
+			*token = 15 << 4;
+			size_t rest = literal_len - 15;
+
+			while (rest >= 255) {
+				*op++ = 255;
+				rest -= 255;
+			}
+
+			*op++ = (uint8_t)rest;
+
+		} else {
+			*token = (uint8_t)(literal_len << 4);
+		}
+
+		memcpy(op, anchor, literal_len);
+		op += literal_len;
+
+		// offset
+		write16(op, (uint16_t)(ip - match));
+		op += 2;
+
+		if (match_len >= 15) {
+			*token |= 15;
+			size_t rest = match_len - 15;
+
+			while (rest >= 255) {
+				*op++ = 255;
+				rest -= 255;
+			}
+
+			*op++ = (uint8_t)rest;
+
+		} else {
+			*token |= (uint8_t)match_len;
+		}
+
+		ip = ip_end;
+		anchor = ip;
+	}
+
+	// last literals
+	size_t last_len = iend - anchor;
+
+	if (op + last_len + last_len / 255 + 2 > oend) {
+		return 0;
+	}
+
+	uint8_t *token = op++;
+
+	if (last_len >= 15) {
+		*token = 15 << 4;
+		size_t rest = last_len - 15;
+
+		while (rest >= 255) {
+			*op++ = 255;
+			rest -= 255;
+		}
+
+		*op++ = (uint8_t)rest;
+
+	} else {
+		*token = (uint8_t)(last_len << 4);
+	}
+
+	memcpy(op, anchor, last_len);
+	op += last_len;
+
+	return op - dst;
+}
+
+}
+}
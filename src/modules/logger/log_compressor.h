@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogCompressor
+ * Self-contained LZ4-style block compressor used by the file writer to reduce
+ * SD card I/O bandwidth. Only compression is implemented; decompression is
+ * done offline by the log conversion tools.
+ *
+ * The output stream consists of independent blocks, each prefixed with a
+ * 4 byte header: uint16_t compressed size, uint16_t uncompressed size.
+ * A compressed size equal to the uncompressed size marks a stored
+ * (incompressible) block.
+ */
+class LogCompressor
+{
+public:
+	/** maximum uncompressed size of one block */
+	static constexpr size_t max_block_size = 4096;
+
+	/** worst-case compressed size of one block, including the block header */
+	static constexpr size_t max_output_size = max_block_size + max_block_size / 255 + 20;
+
+	LogCompressor() = default;
+
+	/**
+	 * Compress one block of data.
+	 * @param src input data
+	 * @param size input size, at most max_block_size
+	 * @param dst output buffer of at least max_output_size bytes
+	 * @return total number of bytes written to dst (header + payload)
+	 */
+	size_t compress_block(const uint8_t *src, size_t size, uint8_t *dst);
+
+private:
+	/**
+	 * LZ4 block compression (fast variant, compression only).
+	 * @return compressed size, or 0 if the data did not fit (incompressible)
+	 */
+	size_t lz4_compress(const uint8_t *src, size_t size, uint8_t *dst, size_t dst_capacity);
+
+	static constexpr int hash_log = 12;
+	uint16_t _hash_table[1 << hash_log];
+};
+
+}
+}
@@ -137,6 +137,16 @@ void LogWriter::stop_log_file()
 	}
 }
 
+bool LogWriter::can_rotate_file() const
+{
+	return _log_writer_file && _log_writer_file->can_rotate();
+}
+
+bool LogWriter::rotate_log_file(int fd, const char *filename)
+{
+	return _log_writer_file && _log_writer_file->rotate(fd, filename);
+}
+
 void LogWriter::start_log_mavlink()
 {
 	if (_log_writer_mavlink) {
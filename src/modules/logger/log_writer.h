@@ -69,6 +69,12 @@ public:
 
 	void stop_log_file();
 
+	/** @see LogWriterFile::can_rotate() */
+	bool can_rotate_file() const;
+
+	/** @see LogWriterFile::rotate() */
+	bool rotate_log_file(int fd, const char *filename);
+
 	void start_log_mavlink();
 
 	void stop_log_mavlink();
@@ -138,6 +144,30 @@ public:
 	}
 
 
+	/** @see LogWriterFile::set_compression() */
+	void set_file_compression(bool enable)
+	{
+		if (_log_writer_file) { _log_writer_file->set_compression(enable); }
+	}
+
+	/** @see LogWriterFile::set_mmap_output() */
+	void set_file_mmap_output(bool enable)
+	{
+		if (_log_writer_file) { _log_writer_file->set_mmap_output(enable); }
+	}
+
+	/** @see LogWriterFile::set_preallocation() */
+	void set_file_preallocation(size_t bytes)
+	{
+		if (_log_writer_file) { _log_writer_file->set_preallocation(bytes); }
+	}
+
+	/** @see LogWriterMavlink::set_delta_encoding() */
+	void set_mavlink_delta_encoding(bool enable)
+	{
+		if (_log_writer_mavlink) { _log_writer_mavlink->set_delta_encoding(enable); }
+	}
+
 	/**
 	 * Indicate to the underlying backend whether future write_message() calls need a reliable
 	 * transfer. Needed for header integrity.
@@ -35,12 +35,16 @@
 #include "messages.h"
 #include <fcntl.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <mathlib/mathlib.h>
 #include <px4_posix.h>
 #ifdef __PX4_NUTTX
 #include <systemlib/hardfault_log.h>
 #endif /* __PX4_NUTTX */
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+#include <sys/mman.h>
+#endif
 
 namespace px4
 {
@@ -74,12 +78,24 @@ LogWriterFile::~LogWriterFile()
 	perf_free(_perf_fsync);
 
 	if (_fd >= 0) {
-		::close(_fd);
+		close_file();
+	}
+
+	if (_rotate_fd >= 0) {
+		::close(_rotate_fd);
 	}
 
 	if (_buffer) {
 		delete[] _buffer;
 	}
+
+	if (_compress_buffer) {
+		delete[] _compress_buffer;
+	}
+
+	if (_compressor) {
+		delete _compressor;
+	}
 }
 
 void LogWriterFile::start_log(const char *filename)
@@ -94,7 +110,18 @@ void LogWriterFile::start_log(const char *filename)
 		PX4_ERR("Failed to register ULog file to the hardfault handler (%i)", ret);
 	}
 
+	if (_rotate_fd >= 0) {
+		// discard a rotation file left over from an aborted run
+		::close(_rotate_fd);
+		_rotate_fd = -1;
+	}
+
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+	/* the mapping needs a readable fd */
+	_fd = ::open(filename, O_CREAT | (_use_mmap ? O_RDWR : O_WRONLY), PX4_O_MODE_666);
+#else
 	_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
+#endif
 
 	if (_fd < 0) {
 		PX4_ERR("Can't open log file %s, errno: %d", filename, errno);
@@ -114,6 +141,42 @@ void LogWriterFile::start_log(const char *filename)
 		}
 	}
 
+	if (_compress && _compressor == nullptr) {
+		_compressor = new LogCompressor();
+		_compress_buffer = new uint8_t[LogCompressor::max_output_size];
+
+		if (_compressor == nullptr || _compress_buffer == nullptr) {
+			PX4_ERR("Can't create compression buffer, logging uncompressed");
+			_compress = false;
+		}
+	}
+
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+	_mmap_offset = 0;
+
+	if (_use_mmap && !mmap_extend(_min_write_chunk)) {
+		PX4_ERR("mmap of log file failed, using write()");
+		_use_mmap = false;
+	}
+
+	const bool prealloc = _prealloc_size > 0 && !_use_mmap;
+#else
+	const bool prealloc = _prealloc_size > 0;
+#endif
+	_file_offset = 0;
+	_preallocated = false;
+
+	if (prealloc) {
+		/* reserve the file space up front, so that no filesystem metadata
+		 * updates (which stall concurrent writes on FAT) happen while logging */
+		if (::ftruncate(_fd, _prealloc_size) == 0) {
+			_preallocated = true;
+
+		} else {
+			PX4_WARN("log file preallocation failed (%zu bytes)", _prealloc_size);
+		}
+	}
+
 	PX4_INFO("Opened log file: %s", filename);
 	_should_run = true;
 	_running = true;
@@ -163,6 +226,42 @@ void LogWriterFile::stop_log()
 	notify();
 }
 
+bool LogWriterFile::rotate(int fd, const char *filename)
+{
+	if (!can_rotate()) {
+		return false;
+	}
+
+	lock();
+	_rotate_fd = fd;
+	strncpy(_rotate_filename, filename, sizeof(_rotate_filename) - 1);
+	_rotate_filename[sizeof(_rotate_filename) - 1] = '\0';
+	unlock();
+	notify();
+	return true;
+}
+
+void LogWriterFile::adopt_rotation()
+{
+	/* flush and close the finished file, then continue into the preopened one */
+	perf_begin(_perf_fsync);
+	::fsync(_fd);
+	perf_end(_perf_fsync);
+	close_file();
+
+	_fd = _rotate_fd;
+	_rotate_fd = -1;
+
+	/* the definition section has already been written by the logger */
+	off_t offset = ::lseek(_fd, 0, SEEK_END);
+	_file_offset = (offset > 0) ? (size_t)offset : 0;
+	_total_written = _file_offset;
+	_preallocated = false;
+
+	hardfault_store_filename(_rotate_filename);
+	PX4_INFO("Continuing log in: %s", _rotate_filename);
+}
+
 int LogWriterFile::thread_start()
 {
 	pthread_attr_t thr_attr;
@@ -243,8 +342,9 @@ void LogWriterFile::run()
 			while (true) {
 				available = get_read_ptr(&read_ptr, &is_part);
 
-				/* if sufficient data available or partial read or terminating, exit this wait loop */
-				if ((available >= _min_write_chunk) || is_part || !_should_run) {
+				/* if sufficient data available or partial read or terminating or
+				 * a rotation is pending, exit this wait loop */
+				if ((available >= _min_write_chunk) || is_part || !_should_run || _rotate_fd >= 0) {
 					/* GOTO end of block */
 					break;
 				}
@@ -260,7 +360,7 @@ void LogWriterFile::run()
 
 			if (available > 0) {
 				perf_begin(_perf_write);
-				written = ::write(_fd, read_ptr, available);
+				written = write_to_file(read_ptr, available);
 				perf_end(_perf_write);
 
 				/* call fsync periodically to minimize potential loss of data */
@@ -286,22 +386,26 @@ void LogWriterFile::run()
 				_total_written += written;
 			}
 
+			if (_should_run && _rotate_fd >= 0 && written == static_cast<int>(available) && !is_part) {
+				// all buffered data has been drained into the current file up to
+				// a message boundary: switch over to the preopened next file
+				adopt_rotation();
+			}
+
 			if (!_should_run && written == static_cast<int>(available) && !is_part) {
 				// Stop only when all data written
 				_running = false;
 				_head = 0;
 				_count = 0;
 
-				if (_fd >= 0) {
-					int res = ::close(_fd);
-					_fd = -1;
-
-					if (res) {
-						PX4_WARN("error closing log file");
+				if (_rotate_fd >= 0) {
+					// an unadopted rotation file is discarded on stop
+					::close(_rotate_fd);
+					_rotate_fd = -1;
+				}
 
-					} else {
-						PX4_INFO("closed logfile, bytes written: %zu", _total_written);
-					}
+				if (_fd >= 0) {
+					close_file();
 				}
 
 				break;
@@ -310,6 +414,124 @@ void LogWriterFile::run()
 	}
 }
 
+ssize_t LogWriterFile::write_to_file(void *ptr, size_t size)
+{
+	if (!_compress) {
+		return write_fd(ptr, size);
+	}
+
+	/* compress the chunk block-wise; the return value is the number of ring
+	 * buffer bytes consumed, so accounting in the caller stays unchanged */
+	size_t consumed = 0;
+
+	while (consumed < size) {
+		size_t block = math::min(size - consumed, LogCompressor::max_block_size);
+		size_t out_size = _compressor->compress_block(reinterpret_cast<uint8_t *>(ptr) + consumed, block, _compress_buffer);
+
+		ssize_t ret = write_fd(_compress_buffer, out_size);
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		consumed += block;
+	}
+
+	return consumed;
+}
+
+ssize_t LogWriterFile::write_fd(const void *ptr, size_t size)
+{
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+
+	if (_use_mmap) {
+		if (_mmap_offset + size > _mmap_capacity && !mmap_extend(size)) {
+			return -1;
+		}
+
+		memcpy(_mmap_base + _mmap_offset, ptr, size);
+		_mmap_offset += size;
+		return size;
+	}
+
+#endif
+	ssize_t ret = ::write(_fd, ptr, size);
+
+	if (ret > 0) {
+		_file_offset += ret;
+	}
+
+	return ret;
+}
+
+void LogWriterFile::close_file()
+{
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+
+	if (_use_mmap && _mmap_base) {
+		::munmap(_mmap_base, _mmap_capacity);
+		/* trim the preallocated tail */
+		if (::ftruncate(_fd, _mmap_offset)) {
+			PX4_WARN("truncating log file failed");
+		}
+
+		_mmap_base = nullptr;
+		_mmap_capacity = 0;
+	}
+
+#endif
+
+	if (_preallocated) {
+		/* trim the unused preallocated tail */
+		if (::ftruncate(_fd, _file_offset)) {
+			PX4_WARN("truncating log file failed");
+		}
+
+		_preallocated = false;
+	}
+
+	int res = ::close(_fd);
+	_fd = -1;
+
+	if (res) {
+		PX4_WARN("error closing log file");
+
+	} else {
+		PX4_INFO("closed logfile, bytes written: %zu", _total_written);
+	}
+}
+
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+bool LogWriterFile::mmap_extend(size_t required)
+{
+	size_t new_capacity = _mmap_capacity;
+
+	while (new_capacity < _mmap_offset + required) {
+		new_capacity += _mmap_chunk;
+	}
+
+	if (::ftruncate(_fd, new_capacity)) {
+		return false;
+	}
+
+	if (_mmap_base) {
+		::munmap(_mmap_base, _mmap_capacity);
+		_mmap_base = nullptr;
+	}
+
+	void *base = ::mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+
+	if (base == MAP_FAILED) {
+		_mmap_capacity = 0;
+		return false;
+	}
+
+	_mmap_base = reinterpret_cast<uint8_t *>(base);
+	_mmap_capacity = new_capacity;
+	return true;
+}
+#endif
+
 int LogWriterFile::write_message(void *ptr, size_t size, uint64_t dropout_start)
 {
 	if (_need_reliable_transfer) {
@@ -39,6 +39,8 @@
 #include <drivers/drv_hrt.h>
 #include <systemlib/perf_counter.h>
 
+#include "log_compressor.h"
+
 namespace px4
 {
 namespace logger
@@ -68,6 +70,33 @@ public:
 
 	void stop_log();
 
+	/**
+	 * Whether a seamless file rotation is currently possible (the compressed
+	 * and memory-mapped output streams cannot be split mid-file).
+	 */
+	bool can_rotate() const
+	{
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+
+		if (_use_mmap) {
+			return false;
+		}
+
+#endif
+		return !_compress && is_started();
+	}
+
+	/**
+	 * Hand over a preopened log file to rotate into. The writer thread adopts
+	 * it as soon as the ring buffer is drained into the current file, so no
+	 * data is dropped and no message is split across files. The caller must
+	 * have written the new file's definition section already.
+	 * @param fd preopened file descriptor, owned by the writer on success
+	 * @param filename path of the new file (for the hardfault handler)
+	 * @return false if rotation is not possible (@see can_rotate())
+	 */
+	bool rotate(int fd, const char *filename);
+
 	bool is_started() const { return _should_run; }
 
 	/** @see LogWriter::write_message() */
@@ -113,6 +142,39 @@ public:
 		return _need_reliable_transfer;
 	}
 
+	/**
+	 * Enable LZ4-style compression of the output stream. Must be called
+	 * before start_log(). The log conversion tools decompress offline.
+	 */
+	void set_compression(bool enable)
+	{
+		_compress = enable;
+	}
+
+	/**
+	 * Use a memory-mapped output file instead of write() calls. Only
+	 * effective on POSIX builds; ignored elsewhere. Must be called before
+	 * start_log().
+	 */
+	void set_mmap_output(bool enable)
+	{
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+		_use_mmap = enable;
+#endif
+	}
+
+	/**
+	 * Reserve this much file space in start_log() and trim the unused tail
+	 * when closing, so that no filesystem metadata updates (which stall
+	 * concurrent writes on FAT) happen while logging. 0 disables the
+	 * preallocation. Must be called before start_log(). Not used in
+	 * memory-mapped mode, which grows the file in large chunks instead.
+	 */
+	void set_preallocation(size_t bytes)
+	{
+		_prealloc_size = bytes;
+	}
+
 private:
 	static void *run_helper(void *);
 
@@ -143,6 +205,30 @@ private:
 	 */
 	inline void write_no_check(void *ptr, size_t size);
 
+	/**
+	 * Drain one chunk from the ring buffer to the file, applying the optional
+	 * compression stage.
+	 * @return number of ring buffer bytes consumed, <0 on error
+	 */
+	ssize_t write_to_file(void *ptr, size_t size);
+
+	/**
+	 * Raw output to the log file: write() or the memory-mapped window.
+	 * @return bytes written, <0 on error
+	 */
+	ssize_t write_fd(const void *ptr, size_t size);
+
+	/**
+	 * Close the log file, finalizing the memory mapping if used.
+	 */
+	void close_file();
+
+	/**
+	 * Switch the writer over to the preopened rotation file. Called from the
+	 * writer thread at a drain boundary.
+	 */
+	void adopt_rotation();
+
 	/* 512 didn't seem to work properly, 4096 should match the FAT cluster size */
 	static constexpr size_t	_min_write_chunk = 4096;
 
@@ -161,6 +247,38 @@ private:
 	perf_counter_t _perf_write;
 	perf_counter_t _perf_fsync;
 	pthread_t _thread = 0;
+
+	/* preallocated output file: space is reserved at open, written
+	 * sequentially and trimmed at close */
+	size_t		_prealloc_size = 0;
+	size_t		_file_offset = 0;	///< current write position in the file
+	bool		_preallocated = false;
+
+	/* seamless rotation: the next file is preopened by the logger and adopted
+	 * by the writer thread once the ring buffer is drained */
+	int		_rotate_fd = -1;
+	char		_rotate_filename[64] = "";
+
+	/* optional compression stage between the ring buffer and the output */
+	bool		_compress = false;
+	LogCompressor	*_compressor = nullptr;
+	uint8_t		*_compress_buffer = nullptr;
+
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+	/* memory-mapped output: the file is extended in chunks and written
+	 * through the mapping, avoiding one copy into the page cache */
+	static constexpr size_t	_mmap_chunk = 1024 * 1024;
+
+	/**
+	 * Grow the file and mapping so that 'required' more bytes fit.
+	 */
+	bool mmap_extend(size_t required);
+
+	bool		_use_mmap = false;
+	uint8_t		*_mmap_base = nullptr;
+	size_t		_mmap_capacity = 0;
+	size_t		_mmap_offset = 0;
+#endif
 };
 
 }
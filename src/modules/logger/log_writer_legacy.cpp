@@ -0,0 +1,337 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "log_writer_legacy.h"
+#include "logger.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <px4_log.h>
+#include <px4_posix.h>
+
+#include <uORB/topics/battery_status.h>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_gps_position.h>
+#include <uORB/topics/vehicle_local_position.h>
+
+#include "../sdlog2/sdlog2_format.h"
+#include "../sdlog2/sdlog2_messages.h"
+
+namespace px4
+{
+namespace logger
+{
+
+namespace
+{
+
+/* the packed sdlog2 body structs come from sdlog2_messages.h; the converters
+ * below are the same field mappings sdlog2.c used, so existing consumers see
+ * byte-identical records */
+
+void convert_att(const void *data, void *body)
+{
+	const vehicle_attitude_s &att = *static_cast<const vehicle_attitude_s *>(data);
+	log_ATT_s &out = *static_cast<log_ATT_s *>(body);
+	const float q0 = att.q[0], q1 = att.q[1], q2 = att.q[2], q3 = att.q[3];
+	out.q_w = q0;
+	out.q_x = q1;
+	out.q_y = q2;
+	out.q_z = q3;
+	out.roll = atan2f(2 * (q0 * q1 + q2 * q3), 1 - 2 * (q1 * q1 + q2 * q2));
+	out.pitch = asinf(2 * (q0 * q2 - q3 * q1));
+	out.yaw = atan2f(2 * (q0 * q3 + q1 * q2), 1 - 2 * (q2 * q2 + q3 * q3));
+	out.roll_rate = att.rollspeed;
+	out.pitch_rate = att.pitchspeed;
+	out.yaw_rate = att.yawspeed;
+}
+
+void convert_lpos(const void *data, void *body)
+{
+	const vehicle_local_position_s &lpos = *static_cast<const vehicle_local_position_s *>(data);
+	log_LPOS_s &out = *static_cast<log_LPOS_s *>(body);
+	out.x = lpos.x;
+	out.y = lpos.y;
+	out.z = lpos.z;
+	out.ground_dist = lpos.dist_bottom;
+	out.ground_dist_rate = lpos.dist_bottom_rate;
+	out.vx = lpos.vx;
+	out.vy = lpos.vy;
+	out.vz = lpos.vz;
+	out.ref_lat = lpos.ref_lat * 1e7;
+	out.ref_lon = lpos.ref_lon * 1e7;
+	out.ref_alt = lpos.ref_alt;
+	out.pos_flags = (lpos.xy_valid ? 1 : 0) |
+			(lpos.z_valid ? 2 : 0) |
+			(lpos.v_xy_valid ? 4 : 0) |
+			(lpos.v_z_valid ? 8 : 0) |
+			(lpos.xy_global ? 16 : 0) |
+			(lpos.z_global ? 32 : 0);
+	out.ground_dist_flags = (lpos.dist_bottom_valid ? 1 : 0);
+	out.eph = lpos.eph;
+	out.epv = lpos.epv;
+}
+
+void convert_gps(const void *data, void *body)
+{
+	const vehicle_gps_position_s &gps = *static_cast<const vehicle_gps_position_s *>(data);
+	log_GPS_s &out = *static_cast<log_GPS_s *>(body);
+	out.gps_time = gps.time_utc_usec;
+	out.fix_type = gps.fix_type;
+	out.eph = gps.eph;
+	out.epv = gps.epv;
+	out.lat = gps.lat;
+	out.lon = gps.lon;
+	out.alt = gps.alt * 0.001f;
+	out.vel_n = gps.vel_n_m_s;
+	out.vel_e = gps.vel_e_m_s;
+	out.vel_d = gps.vel_d_m_s;
+	out.cog = gps.cog_rad;
+	out.sats = gps.satellites_used;
+	out.snr_mean = 0;
+	out.noise_per_ms = gps.noise_per_ms;
+	out.jamming_indicator = gps.jamming_indicator;
+}
+
+void convert_batt(const void *data, void *body)
+{
+	const battery_status_s &batt = *static_cast<const battery_status_s *>(data);
+	log_BATT_s &out = *static_cast<log_BATT_s *>(body);
+	out.voltage = batt.voltage_v;
+	out.voltage_filtered = batt.voltage_filtered_v;
+	out.current = batt.current_a;
+	out.current_filtered = batt.current_filtered_a;
+	out.discharged = batt.discharged_mah;
+	out.remaining = batt.remaining;
+	out.scale = batt.scale;
+	out.warning = batt.warning;
+}
+
+struct LegacyConversion {
+	const char *topic; ///< uORB topic name
+	uint8_t msg_type; ///< legacy message id
+	uint8_t body_size; ///< packed body size, without the 3 byte packet header
+	char name[5];
+	const char *format;
+	const char *labels;
+	void (*convert)(const void *data, void *body);
+};
+
+/* mapping uORB topics to their legacy messages. Formats and labels are kept
+ * in sync with the log_formats[] table in sdlog2_messages.h (which is not
+ * usable from C++). Extend here when a legacy consumer needs another topic. */
+const LegacyConversion legacy_conversions[] = {
+	{"vehicle_attitude", LOG_ATT_MSG, sizeof(log_ATT_s), "ATT",
+	 "ffffffffff", "qw,qx,qy,qz,Roll,Pitch,Yaw,RollRate,PitchRate,YawRate", convert_att},
+	{"vehicle_local_position", LOG_LPOS_MSG, sizeof(log_LPOS_s), "LPOS",
+	 "ffffffffLLfBBff", "X,Y,Z,Dist,DistR,VX,VY,VZ,RLat,RLon,RAlt,PFlg,GFlg,EPH,EPV", convert_lpos},
+	{"vehicle_gps_position", LOG_GPS_MSG, sizeof(log_GPS_s), "GPS",
+	 "QBffLLfffffBHHH", "GPSTime,Fix,EPH,EPV,Lat,Lon,Alt,VelN,VelE,VelD,Cog,nSat,SNR,N,J", convert_gps},
+	{"battery_status", LOG_BATT_MSG, sizeof(log_BATT_s), "BATT",
+	 "fffffffB", "V,VFilt,C,CFilt,Discharged,Remaining,Scale,Warning", convert_batt},
+};
+
+constexpr int num_legacy_conversions = sizeof(legacy_conversions) / sizeof(legacy_conversions[0]);
+
+/* largest mapped body, for the packet staging buffer */
+constexpr size_t max_legacy_body_size = sizeof(log_LPOS_s) > sizeof(log_GPS_s) ?
+					sizeof(log_LPOS_s) : sizeof(log_GPS_s);
+
+/** interval between TIME packets, so that a truncated log stays datable */
+constexpr hrt_abstime TIME_PACKET_INTERVAL = 1000000;
+
+}
+
+bool LogWriterLegacy::start_log(const char *ulog_filename)
+{
+	if (_fd >= 0) {
+		return true;
+	}
+
+	/* derive the legacy file name: replace the .ulg extension */
+	char file_name[80];
+	strncpy(file_name, ulog_filename, sizeof(file_name) - 1);
+	file_name[sizeof(file_name) - 1] = '\0';
+	char *ext = strrchr(file_name, '.');
+
+	if (!ext || (size_t)(ext - file_name) + 8 > sizeof(file_name)) {
+		return false;
+	}
+
+	strcpy(ext, ".px4log");
+
+	_fd = ::open(file_name, O_CREAT | O_WRONLY, PX4_O_MODE_666);
+
+	if (_fd < 0) {
+		PX4_ERR("can't open legacy log file %s", file_name);
+		return false;
+	}
+
+	_buffer_len = 0;
+	_total_written = 0;
+	_last_time_written = 0;
+
+	write_formats();
+	write_time();
+	flush();
+
+	return true;
+}
+
+void LogWriterLegacy::stop_log()
+{
+	if (_fd < 0) {
+		return;
+	}
+
+	flush();
+	::close(_fd);
+	_fd = -1;
+}
+
+void LogWriterLegacy::write_sample(LoggerSubscription &sub, const void *data)
+{
+	if (_fd < 0) {
+		return;
+	}
+
+	if (sub.legacy_index == -2) {
+		/* first sample of this topic: resolve the conversion table entry */
+		sub.legacy_index = -1;
+
+		for (int i = 0; i < num_legacy_conversions; i++) {
+			if (strcmp(legacy_conversions[i].topic, sub.metadata->o_name) == 0) {
+				sub.legacy_index = i;
+				break;
+			}
+		}
+	}
+
+	if (sub.legacy_index < 0) {
+		return;
+	}
+
+	if (hrt_elapsed_time(&_last_time_written) > TIME_PACKET_INTERVAL) {
+		write_time();
+	}
+
+	const LegacyConversion &conv = legacy_conversions[sub.legacy_index];
+
+	uint8_t packet[LOG_PACKET_HEADER_LEN + max_legacy_body_size];
+	packet[0] = HEAD_BYTE1;
+	packet[1] = HEAD_BYTE2;
+	packet[2] = conv.msg_type;
+	conv.convert(data, packet + LOG_PACKET_HEADER_LEN);
+
+	write_packet(packet, LOG_PACKET_HEADER_LEN + conv.body_size);
+}
+
+void LogWriterLegacy::write_formats()
+{
+	/* one FORMAT packet per mapped message, plus TIME itself */
+	uint8_t packet[LOG_PACKET_HEADER_LEN + sizeof(log_format_s)];
+	packet[0] = HEAD_BYTE1;
+	packet[1] = HEAD_BYTE2;
+	packet[2] = LOG_FORMAT_MSG;
+
+	log_format_s *fmt = reinterpret_cast<log_format_s *>(packet + LOG_PACKET_HEADER_LEN);
+
+	for (int i = -1; i < num_legacy_conversions; i++) {
+		memset(fmt, 0, sizeof(*fmt));
+
+		if (i < 0) {
+			fmt->type = LOG_TIME_MSG;
+			fmt->length = sizeof(log_TIME_s) + LOG_PACKET_HEADER_LEN;
+			strncpy(fmt->name, "TIME", sizeof(fmt->name));
+			strncpy(fmt->format, "Q", sizeof(fmt->format));
+			strncpy(fmt->labels, "StartTime", sizeof(fmt->labels));
+
+		} else {
+			const LegacyConversion &conv = legacy_conversions[i];
+			fmt->type = conv.msg_type;
+			fmt->length = conv.body_size + LOG_PACKET_HEADER_LEN;
+			strncpy(fmt->name, conv.name, sizeof(fmt->name));
+			strncpy(fmt->format, conv.format, sizeof(fmt->format));
+			strncpy(fmt->labels, conv.labels, sizeof(fmt->labels));
+		}
+
+		write_packet(packet, sizeof(packet));
+	}
+}
+
+void LogWriterLegacy::write_time()
+{
+	uint8_t packet[LOG_PACKET_HEADER_LEN + sizeof(log_TIME_s)];
+	packet[0] = HEAD_BYTE1;
+	packet[1] = HEAD_BYTE2;
+	packet[2] = LOG_TIME_MSG;
+
+	const uint64_t now = hrt_absolute_time();
+	memcpy(packet + LOG_PACKET_HEADER_LEN, &now, sizeof(now));
+	_last_time_written = now;
+
+	write_packet(packet, sizeof(packet));
+}
+
+void LogWriterLegacy::write_packet(const void *packet, size_t size)
+{
+	if (_buffer_len + size > sizeof(_buffer)) {
+		flush();
+	}
+
+	memcpy(_buffer + _buffer_len, packet, size);
+	_buffer_len += size;
+}
+
+void LogWriterLegacy::flush()
+{
+	if (_buffer_len == 0 || _fd < 0) {
+		return;
+	}
+
+	ssize_t written = ::write(_fd, _buffer, _buffer_len);
+
+	if (written > 0) {
+		_total_written += written;
+	}
+
+	/* a failed or short write drops the rest of the buffer: the legacy
+	 * stream is best-effort, the ULog file stays authoritative */
+	_buffer_len = 0;
+}
+
+}
+}
@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <drivers/drv_hrt.h>
+#include <uORB/uORB.h>
+
+namespace px4
+{
+namespace logger
+{
+
+struct LoggerSubscription;
+
+/**
+ * @class LogWriterLegacy
+ * Secondary writer backend emitting the sdlog2 binary format (.px4log) from
+ * the logger's subscription stream, so that consumers of the legacy format
+ * are fed directly instead of via a post-flight ULog conversion pass.
+ *
+ * The writer shares the samples the logger already copied for the ULog
+ * backends: it adds no uORB subscriptions of its own. Only topics with an
+ * entry in the static conversion table are emitted; everything else is
+ * silently skipped. The output file is placed next to the ULog file, with
+ * the extension replaced by .px4log.
+ *
+ * Writes are synchronous from the logger thread through a small coalescing
+ * buffer. The legacy stream is a fraction of the ULog stream's bandwidth,
+ * so this does not need the writer thread's ring buffer machinery.
+ */
+class LogWriterLegacy
+{
+public:
+	/**
+	 * Open the legacy log next to the given ULog file and write the
+	 * format prologue.
+	 * @param ulog_filename full path of the ULog file, used to derive the
+	 *                      .px4log path
+	 * @return true on success
+	 */
+	bool start_log(const char *ulog_filename);
+
+	void stop_log();
+
+	bool is_started() const { return _fd >= 0; }
+
+	/**
+	 * Convert one topic sample to its legacy message and write it.
+	 * The conversion table lookup is cached in the subscription, so
+	 * unmapped topics cost one pointer check per sample after the first.
+	 * @param sub subscription the sample belongs to
+	 * @param data raw uORB sample (instance 0)
+	 */
+	void write_sample(LoggerSubscription &sub, const void *data);
+
+	size_t get_total_written() const { return _total_written; }
+
+private:
+	/** write the FORMAT packets for all mapped messages */
+	void write_formats();
+
+	/** write a TIME packet carrying the current hrt timestamp */
+	void write_time();
+
+	/** append one complete packet (header included) to the coalescing buffer */
+	void write_packet(const void *packet, size_t size);
+
+	void flush();
+
+	int _fd = -1;
+	size_t _buffer_len = 0;
+	size_t _total_written = 0;
+	hrt_abstime _last_time_written = 0; ///< timestamp of the last TIME packet
+	uint8_t _buffer[512];
+};
+
+}
+}
@@ -65,6 +65,8 @@ LogWriterMavlink::~LogWriterMavlink()
 	if (_ulog_stream_pub) {
 		orb_unadvertise(_ulog_stream_pub);
 	}
+
+	delta_reset();
 }
 
 void LogWriterMavlink::start_log()
@@ -86,6 +88,9 @@ void LogWriterMavlink::start_log()
 	_ulog_stream_data.sequence = 0;
 	_ulog_stream_data.length = 0;
 	_ulog_stream_data.first_message_offset = 0;
+
+	// drop any delta coding state from a previous session (msg_ids can be reassigned)
+	delta_reset();
 	_is_started = true;
 }
 
@@ -104,6 +109,10 @@ int LogWriterMavlink::write_message(void *ptr, size_t size)
 	const uint8_t data_len = (uint8_t)sizeof(_ulog_stream_data.data);
 	uint8_t *ptr_data = (uint8_t *)ptr;
 
+	if (_delta_encoding) {
+		delta_encode(ptr_data, size);
+	}
+
 	if (_ulog_stream_data.first_message_offset == 255) {
 		_ulog_stream_data.first_message_offset = _ulog_stream_data.length;
 	}
@@ -125,6 +134,181 @@ int LogWriterMavlink::write_message(void *ptr, size_t size)
 	return 0;
 }
 
+void LogWriterMavlink::set_delta_encoding(bool enable)
+{
+	if (!enable) {
+		delta_reset();
+	}
+
+	_delta_encoding = enable;
+}
+
+void LogWriterMavlink::delta_encode(uint8_t *&ptr, size_t &size)
+{
+	if (size < ULOG_MSG_HEADER_LEN + 2) {
+		return;
+	}
+
+	const uint8_t msg_type = ptr[2];
+
+	if (msg_type == static_cast<uint8_t>(ULogMessageType::ADD_LOGGED_MSG)
+	    || msg_type == static_cast<uint8_t>(ULogMessageType::REMOVE_LOGGED_MSG)) {
+		// the msg_id gets (re)defined or removed: invalidate any previous sample
+		const int msg_id_offset = msg_type == static_cast<uint8_t>(ULogMessageType::ADD_LOGGED_MSG) ? 4 : 3;
+
+		if (size >= (size_t)msg_id_offset + 2) {
+			const uint16_t msg_id = ptr[msg_id_offset] | (ptr[msg_id_offset + 1] << 8);
+
+			if (msg_id < DELTA_NUM_MSG_IDS && _delta_states[msg_id].last_data) {
+				delete[](_delta_states[msg_id].last_data);
+				_delta_states[msg_id].last_data = nullptr;
+				_delta_states[msg_id].size = 0;
+			}
+		}
+
+		return;
+	}
+
+	if (msg_type != static_cast<uint8_t>(ULogMessageType::DATA)) {
+		return;
+	}
+
+	const uint16_t msg_id = ptr[3] | (ptr[4] << 8);
+	const size_t header_len = ULOG_MSG_HEADER_LEN + 2; // msg_size, msg_type & msg_id
+	const size_t payload_len = size - header_len;
+
+	if (msg_id >= DELTA_NUM_MSG_IDS || payload_len == 0) {
+		return;
+	}
+
+	DeltaState &state = _delta_states[msg_id];
+	const uint8_t *cur = ptr + header_len;
+
+	if (!state.last_data) {
+		state.last_data = new uint8_t[payload_len];
+
+		if (!state.last_data) {
+			return;
+		}
+
+		state.size = payload_len;
+		// the first sample is always sent uncoded
+		memcpy(state.last_data, cur, payload_len);
+		state.messages_until_keyframe = DELTA_KEYFRAME_INTERVAL;
+		return;
+	}
+
+	if (state.size != payload_len) {
+		// must not happen: the payload size is fixed per msg_id
+		return;
+	}
+
+	if (state.messages_until_keyframe == 0) {
+		// regularly send an uncoded sample so that a receiver recovers from a lost message
+		memcpy(state.last_data, cur, payload_len);
+		state.messages_until_keyframe = DELTA_KEYFRAME_INTERVAL;
+		return;
+	}
+
+	if (_delta_buffer_size < size) {
+		if (_delta_buffer) {
+			delete[](_delta_buffer);
+		}
+
+		_delta_buffer = new uint8_t[size];
+
+		if (!_delta_buffer) {
+			_delta_buffer_size = 0;
+			memcpy(state.last_data, cur, payload_len);
+			return;
+		}
+
+		_delta_buffer_size = size;
+	}
+
+	uint8_t *out = _delta_buffer + header_len;
+	const size_t out_max = payload_len - 1; // coding is only useful if strictly smaller
+	size_t encoded_len = 0;
+	size_t in = 0;
+	bool gain = true;
+
+	while (in < payload_len) {
+		// run of unchanged bytes
+		size_t unchanged = 0;
+
+		while (in < payload_len && unchanged < 255 && cur[in] == state.last_data[in]) {
+			++unchanged;
+			++in;
+		}
+
+		// run of changed bytes (a single unchanged byte in between is cheaper as a literal)
+		const size_t changed_start = in;
+		size_t changed = 0;
+
+		while (in < payload_len && changed < 255) {
+			if (cur[in] == state.last_data[in]
+			    && (in + 1 >= payload_len || cur[in + 1] == state.last_data[in + 1])) {
+				break;
+			}
+
+			++changed;
+			++in;
+		}
+
+		if (changed == 0 && in >= payload_len) {
+			// trailing unchanged bytes are implicit
+			break;
+		}
+
+		if (encoded_len + 2 + changed > out_max) {
+			gain = false;
+			break;
+		}
+
+		out[encoded_len++] = unchanged;
+		out[encoded_len++] = changed;
+
+		for (size_t k = 0; k < changed; ++k) {
+			out[encoded_len++] = cur[changed_start + k] ^ state.last_data[changed_start + k];
+		}
+	}
+
+	memcpy(state.last_data, cur, payload_len);
+	--state.messages_until_keyframe;
+
+	if (!gain) {
+		return;
+	}
+
+	const uint16_t msg_size = encoded_len + 2; // msg_id + coded payload
+	_delta_buffer[0] = (uint8_t)msg_size;
+	_delta_buffer[1] = (uint8_t)(msg_size >> 8);
+	_delta_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA_DELTA);
+	_delta_buffer[3] = ptr[3];
+	_delta_buffer[4] = ptr[4];
+
+	ptr = _delta_buffer;
+	size = header_len + encoded_len;
+}
+
+void LogWriterMavlink::delta_reset()
+{
+	for (int i = 0; i < DELTA_NUM_MSG_IDS; ++i) {
+		if (_delta_states[i].last_data) {
+			delete[](_delta_states[i].last_data);
+			_delta_states[i].last_data = nullptr;
+		}
+
+		_delta_states[i].size = 0;
+	}
+
+	if (_delta_buffer) {
+		delete[](_delta_buffer);
+		_delta_buffer = nullptr;
+		_delta_buffer_size = 0;
+	}
+}
+
 void LogWriterMavlink::set_need_reliable_transfer(bool need_reliable)
 {
 	if (!need_reliable && _need_reliable_transfer) {
@@ -70,16 +70,45 @@ public:
 		return _need_reliable_transfer;
 	}
 
+	/**
+	 * Enable delta coding of data messages (XOR against the previous sample of
+	 * the same msg_id + run-length coding, @see ulog_message_data_delta_header_s).
+	 * Negotiated via the requested format in MAV_CMD_LOGGING_START.
+	 */
+	void set_delta_encoding(bool enable);
+
 private:
 
 	/** publish message, wait for ack if needed & reset message */
 	int publish_message();
 
+	/**
+	 * try to delta-code a message: on success ptr & size are updated to point to
+	 * the coded message in _delta_buffer, otherwise they are left unchanged
+	 */
+	void delta_encode(uint8_t *&ptr, size_t &size);
+
+	/** free all delta coding state */
+	void delta_reset();
+
+	static constexpr int DELTA_NUM_MSG_IDS = 32; ///< only the first N msg_ids are delta-coded
+	static constexpr uint8_t DELTA_KEYFRAME_INTERVAL = 32; ///< send an uncoded sample every N-th message
+
+	struct DeltaState {
+		uint8_t *last_data = nullptr; ///< previous payload of this msg_id
+		uint16_t size = 0;
+		uint8_t messages_until_keyframe = 0;
+	};
+
 	ulog_stream_s _ulog_stream_data;
 	orb_advert_t _ulog_stream_pub = nullptr;
 	int _ulog_stream_ack_sub = -1;
 	bool _need_reliable_transfer = false;
 	bool _is_started = false;
+	bool _delta_encoding = false;
+	DeltaState _delta_states[DELTA_NUM_MSG_IDS];
+	uint8_t *_delta_buffer = nullptr; ///< coding scratch buffer
+	size_t _delta_buffer_size = 0;
 	const unsigned int _queue_size;
 };
 
@@ -36,6 +36,7 @@
 #include "messages.h"
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <errno.h>
 #include <string.h>
@@ -46,9 +47,11 @@
 #include <uORB/uORBTopics.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/log_message.h>
+#include <uORB/topics/logger_status.h>
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/vehicle_status.h>
 #include <uORB/topics/vehicle_gps_position.h>
+#include <uORB/topics/vehicle_land_detected.h>
 #include <uORB/topics/vehicle_command_ack.h>
 
 #include <drivers/drv_hrt.h>
@@ -217,6 +220,10 @@ int Logger::print_status()
 		PX4_INFO("Mavlink Logging Running");
 	}
 
+	if (_prearm_ring != nullptr) {
+		PX4_INFO("Pre-arm ring: %zu / %zu B used", _prearm_ring_count, _prearm_ring_size);
+	}
+
 	return 0;
 }
 
@@ -235,6 +242,11 @@ void Logger::print_statistics()
 	PX4_INFO("Wrote %4.2f MiB (avg %5.2f KiB/s)", (double)mebibytes, (double)(kibibytes / seconds));
 	PX4_INFO("Since last status: dropouts: %zu (max len: %.3f s), max used buffer: %zu / %zu B",
 		 _write_dropouts, (double)_max_dropout_duration, _high_water, _writer.get_buffer_size_file());
+
+	if (_shed_level > 0 || _shed_drops[LOG_PRIO_LOW] > 0 || _shed_drops[LOG_PRIO_DEFAULT] > 0) {
+		PX4_INFO("Backpressure: shed level %u, shed updates: %u low / %u default",
+			 _shed_level, _shed_drops[LOG_PRIO_LOW], _shed_drops[LOG_PRIO_DEFAULT]);
+	}
 	_high_water = 0;
 	_write_dropouts = 0;
 	_max_dropout_duration = 0.f;
@@ -380,9 +392,76 @@ Logger::Logger(LogWriter::Backend backend, size_t buffer_size, uint32_t log_inte
 	_log_utc_offset = param_find("SDLOG_UTC_OFFSET");
 	_log_dirs_max = param_find("SDLOG_DIRS_MAX");
 	_sdlog_profile_handle = param_find("SDLOG_PROFILE");
+	_sdlog_phase_en_handle = param_find("SDLOG_PH_EN");
+	_sdlog_phase_div_handle = param_find("SDLOG_PH_DIV");
+	_sdlog_perf_int_handle = param_find("SDLOG_PERF_INT");
+
+	param_t output_mode_handle = param_find("SDLOG_OUTPUT");
+
+	if (output_mode_handle != PARAM_INVALID) {
+		int32_t output_mode = 0;
+		param_get(output_mode_handle, &output_mode);
+		_writer.set_file_compression(output_mode & 1);
+		_writer.set_file_mmap_output(output_mode & 2);
+	}
+
+	param_t prealloc_handle = param_find("SDLOG_PREALLOC");
+
+	if (prealloc_handle != PARAM_INVALID) {
+		int32_t prealloc_mb = 0;
+		param_get(prealloc_handle, &prealloc_mb);
+
+		if (prealloc_mb > 0) {
+			_writer.set_file_preallocation((size_t)prealloc_mb * 1024 * 1024);
+		}
+	}
+
+	param_t rotate_handle = param_find("SDLOG_ROT_MIN");
+
+	if (rotate_handle != PARAM_INVALID) {
+		int32_t rotate_min = 0;
+		param_get(rotate_handle, &rotate_min);
+
+		if (rotate_min > 0) {
+			_rotate_interval = (uint64_t)rotate_min * 60 * 1000000;
+		}
+	}
+
+	param_t prearm_handle = param_find("SDLOG_PREARM");
+
+	if (prearm_handle != PARAM_INVALID) {
+		int32_t prearm_kb = 0;
+		param_get(prearm_handle, &prearm_kb);
+
+		if (prearm_kb > 0) {
+			_prearm_ring_size = (size_t)prearm_kb * 1024;
+			_prearm_ring = new uint8_t[_prearm_ring_size];
+
+			if (!_prearm_ring) {
+				PX4_ERR("failed to alloc pre-arm ring (%d kB)", (int)prearm_kb);
+				_prearm_ring_size = 0;
+			}
+		}
+	}
+
+	param_t legacy_handle = param_find("SDLOG_LEGACY");
+
+	if (legacy_handle != PARAM_INVALID) {
+		int32_t legacy = 0;
+		param_get(legacy_handle, &legacy);
+		_legacy_log_enabled = legacy != 0;
+	}
+
+	param_t drop_counts_handle = param_find("SDLOG_DROP_CNT");
+
+	if (drop_counts_handle != PARAM_INVALID) {
+		int32_t drop_counts = 0;
+		param_get(drop_counts_handle, &drop_counts);
+		_dropout_counts_enabled = drop_counts != 0;
+	}
 
 	if (poll_topic_name) {
-		const orb_metadata **topics = orb_get_topics();
+		const orb_metadata *const *topics = orb_get_topics();
 
 		for (size_t i = 0; i < orb_topics_count(); i++) {
 			if (strcmp(poll_topic_name, topics[i]->o_name) == 0) {
@@ -406,6 +485,14 @@ Logger::~Logger()
 	if (_msg_buffer) {
 		delete[](_msg_buffer);
 	}
+
+	if (_prearm_ring) {
+		delete[](_prearm_ring);
+	}
+
+	if (_perf_snapshot_state) {
+		delete[](_perf_snapshot_state);
+	}
 }
 
 bool Logger::request_stop_static()
@@ -421,7 +508,8 @@ bool Logger::request_stop_static()
 int Logger::add_topic(const orb_metadata *topic)
 {
 	int fd = -1;
-	size_t fields_len = strlen(topic->o_fields) + strlen(topic->o_name) + 1; //1 for ':'
+	size_t fields_len = topic->o_format ? strlen(topic->o_format)
+			    : strlen(topic->o_fields) + strlen(topic->o_name) + 1; //1 for ':'
 
 	if (fields_len > sizeof(ulog_message_format_s::format)) {
 		PX4_WARN("skip topic %s, format string is too large: %zu (max is %zu)", topic->o_name, fields_len,
@@ -437,7 +525,10 @@ int Logger::add_topic(const orb_metadata *topic)
 		return -1;
 	}
 
-	if (!_subscriptions.push_back(LoggerSubscription(fd, topic))) {
+	LoggerSubscription subscription(fd, topic);
+	subscription.priority = topic_priority(topic->o_name);
+
+	if (!_subscriptions.push_back(subscription)) {
 		PX4_WARN("logger: failed to add topic. Too many subscriptions");
 		orb_unsubscribe(fd);
 		fd = -1;
@@ -448,7 +539,7 @@ int Logger::add_topic(const orb_metadata *topic)
 
 int Logger::add_topic(const char *name, unsigned interval = 0)
 {
-	const orb_metadata **topics = orb_get_topics();
+	const orb_metadata *const *topics = orb_get_topics();
 	int fd = -1;
 
 	for (size_t i = 0; i < orb_topics_count(); i++) {
@@ -476,12 +567,51 @@ int Logger::add_topic(const char *name, unsigned interval = 0)
 
 	// if we poll on a topic, we don't set the interval and let the polled topic define the maximum interval
 	if (!_polling_topic_meta && fd >= 0) {
-		orb_set_interval(fd, interval);
+		/* the rate limit is applied in the logger itself (cheaper than an
+		 * update interval on the uORB subscription, and shared by all
+		 * instances of the topic) */
+		for (size_t j = 0; j < _subscriptions.size(); ++j) {
+			if (_subscriptions[j].fd[0] == fd) {
+				_subscriptions[j].log_interval = interval * 1000;
+				_subscriptions[j].base_interval = interval * 1000;
+				break;
+			}
+		}
 	}
 
 	return fd;
 }
 
+int Logger::add_mavlink_topic(const char *name, unsigned interval_ms)
+{
+	for (size_t j = 0; j < _subscriptions.size(); ++j) {
+		if (strcmp(name, _subscriptions[j].metadata->o_name) == 0) {
+			_subscriptions[j].mavlink_enabled = true;
+			_subscriptions[j].mavlink_interval = interval_ms * 1000;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+void Logger::add_mavlink_mirror_topics()
+{
+	/* the critical subset for a live (cloud) telemetry mirror: enough for
+	 * remote flight monitoring, at rates a telemetry link can sustain. The
+	 * file backend is unaffected and logs the full set at full rate. */
+	add_mavlink_topic("vehicle_status", 1000);
+	add_mavlink_topic("vehicle_attitude", 200);
+	add_mavlink_topic("vehicle_local_position", 200);
+	add_mavlink_topic("vehicle_global_position", 500);
+	add_mavlink_topic("vehicle_gps_position", 1000);
+	add_mavlink_topic("battery_status", 1000);
+	add_mavlink_topic("estimator_status", 1000);
+	add_mavlink_topic("manual_control_setpoint", 500);
+	add_mavlink_topic("actuator_outputs", 500);
+	add_mavlink_topic("cpuload", 2000);
+}
+
 bool Logger::copy_if_updated_multi(LoggerSubscription &sub, int multi_instance, void *buffer, bool try_to_subscribe)
 {
 	bool updated = false;
@@ -498,12 +628,7 @@ bool Logger::copy_if_updated_multi(LoggerSubscription &sub, int multi_instance,
 			if (handle >= 0) {
 				write_add_logged_msg(sub, multi_instance);
 
-				/* set to the same interval as the first instance */
-				unsigned int interval;
-
-				if (orb_get_interval(sub.fd[0], &interval) == 0 && interval > 0) {
-					orb_set_interval(handle, interval);
-				}
+				/* the rate limit (sub.log_interval) applies to all instances */
 
 				/* It can happen that orb_exists returns true, even if there is no publisher (but another subscriber).
 				 * We catch this here, because orb_copy will fail in this case. */
@@ -542,6 +667,7 @@ void Logger::add_common_topics()
 	add_topic("camera_capture");
 	add_topic("camera_trigger");
 	add_topic("commander_state", 200);
+	add_topic("control_latency");
 	add_topic("cpuload");
 	add_topic("distance_sensor", 100);
 	add_topic("ekf2_innovations", 200);
@@ -549,6 +675,7 @@ void Logger::add_common_topics()
 	add_topic("estimator_status", 200);
 	add_topic("input_rc", 200);
 	add_topic("manual_control_setpoint", 200);
+	add_topic("mixer_status", 50);
 	add_topic("optical_flow", 50);
 	add_topic("position_setpoint_triplet", 200);
 	add_topic("rc_channels", 200);
@@ -638,9 +765,10 @@ int Logger::add_topics_from_file(const char *fname)
 			continue;
 		}
 
-		// read line with format: <topic_name>[, <interval>]
+		// read line with format: <topic_name>[, <interval>[, <batch samples>]]
 		interval = 0;
-		int nfields = sscanf(line, "%s %u", topic_name, &interval);
+		unsigned batch = 0;
+		int nfields = sscanf(line, "%s %u %u", topic_name, &interval, &batch);
 
 		if (nfields > 0) {
 			int name_len = strlen(topic_name);
@@ -653,6 +781,10 @@ int Logger::add_topics_from_file(const char *fname)
 			if (add_topic(topic_name, interval) >= 0) {
 				ntopics++;
 
+				if (batch > 1) {
+					configure_topic_batch(topic_name, batch);
+				}
+
 			} else {
 				PX4_ERR("Failed to add topic %s", topic_name);
 			}
@@ -663,6 +795,36 @@ int Logger::add_topics_from_file(const char *fname)
 	return ntopics;
 }
 
+void Logger::configure_topic_batch(const char *name, unsigned batch_samples)
+{
+	for (LoggerSubscription &sub : _subscriptions) {
+		if (strcmp(sub.metadata->o_name, name) != 0) {
+			continue;
+		}
+
+		const size_t sample_size = sub.metadata->o_size_no_padding;
+
+		/* keep one record well below the writer buffer size */
+		while (batch_samples > 2 &&
+		       sizeof(ulog_message_data_batch_header_s) + batch_samples * sample_size > 1024) {
+			--batch_samples;
+		}
+
+		if (batch_samples > UINT8_MAX) {
+			batch_samples = UINT8_MAX;
+		}
+
+		sub.batch_buffer = new uint8_t[sizeof(ulog_message_data_batch_header_s) + batch_samples * sample_size];
+
+		if (sub.batch_buffer != nullptr) {
+			sub.batch_samples = batch_samples;
+			PX4_DEBUG("batching topic %s, %u samples per record", name, batch_samples);
+		}
+
+		return;
+	}
+}
+
 const char *Logger::configured_backend_mode() const
 {
 	switch (_writer.backend()) {
@@ -704,6 +866,34 @@ void Logger::run()
 	}
 
 	int vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
+
+	/* flight-phase driven rate scaling */
+	int32_t phase_scaling = 0;
+
+	if (_sdlog_phase_en_handle != PARAM_INVALID) {
+		param_get(_sdlog_phase_en_handle, &phase_scaling);
+	}
+
+	int land_detected_sub = -1;
+	vehicle_land_detected_s land_detected = {};
+	land_detected.landed = true;
+	/* tracked separately from _was_armed, which is not updated in the
+	 * log-until-shutdown mode */
+	bool phase_armed = false;
+
+	if (phase_scaling != 0) {
+		land_detected_sub = orb_subscribe(ORB_ID(vehicle_land_detected));
+	}
+
+	/* periodic perf counter snapshots */
+	if (_sdlog_perf_int_handle != PARAM_INVALID) {
+		int32_t perf_interval_s = 0;
+		param_get(_sdlog_perf_int_handle, &perf_interval_s);
+
+		if (perf_interval_s > 0) {
+			_perf_snapshot_interval = (uint32_t)perf_interval_s * 1000 * 1000;
+		}
+	}
 	uORB::Subscription<parameter_update_s> parameter_update_sub(ORB_ID(parameter_update));
 	int log_message_sub = orb_subscribe(ORB_ID(log_message));
 	orb_set_interval(log_message_sub, 20);
@@ -740,6 +930,9 @@ void Logger::run()
 		}
 	}
 
+	/* mark the subset mirrored to mavlink while file logging is active */
+	add_mavlink_mirror_topics();
+
 	int vehicle_command_sub = -1;
 	orb_advert_t vehicle_command_ack_pub = nullptr;
 
@@ -837,6 +1030,7 @@ void Logger::run()
 			bool armed = (vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_ARMED) ||
 				     (vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_ARMED_ERROR) ||
 				     _arm_override;
+			phase_armed = armed;
 
 			if (_was_armed != armed && !_log_until_shutdown) {
 				_was_armed = armed;
@@ -873,13 +1067,17 @@ void Logger::run()
 				orb_copy(ORB_ID(vehicle_command), vehicle_command_sub, &command);
 
 				if (command.command == vehicle_command_s::VEHICLE_CMD_LOGGING_START) {
-					if ((int)(command.param1 + 0.5f) != 0) {
+					// format 0: ULog, 1: ULog with delta-coded data messages
+					const int format = (int)(command.param1 + 0.5f);
+
+					if (format != 0 && format != 1) {
 						ack_vehicle_command(vehicle_command_ack_pub, &command,
 								    vehicle_command_s::VEHICLE_CMD_RESULT_UNSUPPORTED);
 
 					} else if (can_start_mavlink_log()) {
 						ack_vehicle_command(vehicle_command_ack_pub, &command,
 								    vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
+						_writer.set_mavlink_delta_encoding(format == 1);
 						start_log_mavlink();
 
 					} else {
@@ -896,9 +1094,24 @@ void Logger::run()
 		}
 
 
-		if (_writer.is_started()) {
+		const hrt_abstime loop_time = hrt_absolute_time();
+
+		if (land_detected_sub >= 0) {
+			bool land_detected_updated = false;
+
+			if (orb_check(land_detected_sub, &land_detected_updated) == 0 && land_detected_updated) {
+				orb_copy(ORB_ID(vehicle_land_detected), land_detected_sub, &land_detected);
+			}
 
-			hrt_abstime loop_time = hrt_absolute_time();
+			/* ground contact catches the final phase of a landing before
+			 * the land detector fully latches */
+			const bool airborne = !land_detected.landed && !land_detected.maybe_landed
+					      && !land_detected.ground_contact;
+
+			update_log_phase(phase_armed, airborne, loop_time);
+		}
+
+		if (_writer.is_started()) {
 
 			/* check if we need to output the process load */
 			if (_next_load_print != 0 && loop_time >= _next_load_print) {
@@ -915,6 +1128,12 @@ void Logger::run()
 				}
 			}
 
+			/* time-based log file rotation (endurance flights) */
+			if (_rotate_interval > 0 && _writer.is_started(LogWriter::BackendFile)
+			    && loop_time - _start_time_file > _rotate_interval) {
+				rotate_log_file();
+			}
+
 			bool data_written = false;
 
 			/* Check if parameters have changed */
@@ -926,6 +1145,31 @@ void Logger::run()
 			/* wait for lock on log buffer */
 			_writer.lock();
 
+			update_shed_level();
+
+			/* first drain the messages stashed while the writer buffer was full,
+			 * oldest data first, so that low-rate topics survive bursts of
+			 * high-rate ones. Stashed samples are full-tier retries: with both
+			 * backends active they belong to the file backend, the mavlink
+			 * mirror must not get stale data. */
+			LogWriter::Backend staging_backends = LogWriter::BackendAll;
+
+			if (_writer.is_started(LogWriter::BackendFile)
+			    && _writer.is_started(LogWriter::BackendMavlink)) {
+				staging_backends = LogWriter::BackendFile;
+			}
+
+			_writer.select_write_backend(staging_backends);
+
+			for (LoggerSubscription &sub : _subscriptions) {
+				if (sub.staging_size > 0 && write_message(sub.staging, sub.staging_size)) {
+					sub.staging_size = 0;
+					data_written = true;
+				}
+			}
+
+			_writer.unselect_write_backend();
+
 			int sub_idx = 0;
 
 			for (LoggerSubscription &sub : _subscriptions) {
@@ -937,8 +1181,41 @@ void Logger::run()
 				 * and write a message to the log
 				 */
 				for (uint8_t instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+					/* per-subscription rate decimation: leave the update pending
+					 * until the configured interval has passed */
+					if (sub.log_interval > 0 && loop_time < sub.last_logged[instance] + sub.log_interval) {
+						continue;
+					}
+
+					/* tiered backpressure: as the write buffer fills, lower
+					 * tiers are first decimated, then shed entirely, keeping
+					 * estimator and actuator logging intact */
+					if (_shed_level > 0 && sub.priority < LOG_PRIO_CRITICAL) {
+						const int severity = _shed_level - (sub.priority == LOG_PRIO_DEFAULT ? 1 : 0);
+
+						if (severity >= 2) {
+							/* shed: leave the update unconsumed, only account for it */
+							bool updated = false;
+
+							if (sub.fd[instance] >= 0 && orb_check(sub.fd[instance], &updated) == 0 && updated) {
+								++_shed_drops[sub.priority];
+							}
+
+							continue;
+
+						} else if (severity == 1) {
+							/* decimate to a quarter of the configured rate */
+							const unsigned shed_interval = 4 * (sub.log_interval > 0 ? sub.log_interval : 25 * 1000);
+
+							if (loop_time < sub.last_logged[instance] + shed_interval) {
+								continue;
+							}
+						}
+					}
+
 					if (copy_if_updated_multi(sub, instance, _msg_buffer + sizeof(ulog_message_data_header_s),
 								  sub_idx == next_subscribe_topic_index)) {
+						sub.last_logged[instance] = loop_time;
 
 						uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
 						//write one byte after another (necessary because of alignment)
@@ -949,9 +1226,62 @@ void Logger::run()
 						_msg_buffer[3] = (uint8_t)write_msg_id;
 						_msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
 
+						/* legacy mirror: feed the already-copied sample to the
+						 * sdlog2-format writer, no extra subscription work */
+						if (instance == 0 && _writer_legacy.is_started()) {
+							_writer_legacy.write_sample(sub, _msg_buffer + sizeof(ulog_message_data_header_s));
+						}
+
+						/* sample batching: pack instance-0 samples into a
+						 * DATA_BATCH record for the file backend */
+						if (instance == 0 && sub.batch_samples > 1
+						    && _writer.is_started(LogWriter::BackendFile)) {
+
+							/* the mavlink mirror still gets plain DATA records */
+							if (_writer.is_started(LogWriter::BackendMavlink) && sub.mavlink_enabled
+							    && loop_time >= sub.last_logged_mavlink[0] + sub.mavlink_interval) {
+								sub.last_logged_mavlink[0] = loop_time;
+								_writer.select_write_backend(LogWriter::BackendMavlink);
+								write_message(_msg_buffer, msg_size);
+								_writer.unselect_write_backend();
+							}
+
+							if (batch_sample(sub, _msg_buffer + sizeof(ulog_message_data_header_s))) {
+#ifdef DBGPRINT
+								total_bytes += sizeof(ulog_message_data_batch_header_s)
+									       + sub.batch_samples * sub.metadata->o_size_no_padding;
+#endif /* DBGPRINT */
+								data_written = true;
+							}
+
+							continue;
+						}
+
 						//PX4_INFO("topic: %s, size = %zu, out_size = %zu", sub.metadata->o_name, sub.metadata->o_size, msg_size);
 
-						if (write_message(_msg_buffer, msg_size)) {
+						/* writer tiering: while both backends run, the mavlink
+						 * one only mirrors the marked subset at its own rate.
+						 * The copied sample is shared, so the mirror adds no
+						 * subscription work. With a single active backend
+						 * everything goes there, as before. */
+						LogWriter::Backend backends = LogWriter::BackendAll;
+
+						if (_writer.is_started(LogWriter::BackendFile)
+						    && _writer.is_started(LogWriter::BackendMavlink)) {
+							if (sub.mavlink_enabled
+							    && loop_time >= sub.last_logged_mavlink[instance] + sub.mavlink_interval) {
+								sub.last_logged_mavlink[instance] = loop_time;
+
+							} else {
+								backends = LogWriter::BackendFile;
+							}
+						}
+
+						_writer.select_write_backend(backends);
+						bool message_written = write_message(_msg_buffer, msg_size);
+						_writer.unselect_write_backend();
+
+						if (message_written) {
 
 #ifdef DBGPRINT
 							total_bytes += msg_size;
@@ -960,7 +1290,28 @@ void Logger::run()
 							data_written = true;
 
 						} else {
-							break;	// Write buffer overflow, skip this record
+							// Write buffer overflow: keep the sample in the
+							// subscription's staging slot (most recent one
+							// wins) and retry on the next cycle
+							if (sub.staging == nullptr) {
+								sub.staging = new uint8_t[msg_size];
+							}
+
+							if (sub.staging != nullptr) {
+								if (sub.staging_size > 0) {
+									// a pending sample gets replaced: that one is lost
+									count_dropped_sample((uint16_t)sub.staging[3] |
+											     ((uint16_t)sub.staging[4] << 8));
+								}
+
+								memcpy(sub.staging, _msg_buffer, msg_size);
+								sub.staging_size = msg_size;
+
+							} else {
+								count_dropped_sample(write_msg_id);
+							}
+
+							break;
 						}
 					}
 				}
@@ -988,10 +1339,23 @@ void Logger::run()
 					memcpy(_msg_buffer + 4, &log_message.timestamp, sizeof(ulog_message_logging_s::timestamp));
 					strncpy((char *)(_msg_buffer + 12), message, sizeof(ulog_message_logging_s::message));
 
-					write_message(_msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN);
+					if (log_message.severity <= _MSG_PRIO_WARNING) {
+						/* urgent: flush anything pending first to keep the
+						 * message order, then write immediately */
+						flush_log_message_batch();
+						write_message(_msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN);
+
+					} else {
+						batch_log_message(_msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN, loop_time);
+					}
 				}
 			}
 
+			/* time-based flush of aggregated text messages */
+			if (_log_message_batch_len > 0 && loop_time - _log_message_batch_start > LOG_MESSAGE_BATCH_INTERVAL) {
+				flush_log_message_batch();
+			}
+
 			if (!_dropout_start && _writer.get_buffer_fill_count_file() > _high_water) {
 				_high_water = _writer.get_buffer_fill_count_file();
 			}
@@ -1004,15 +1368,13 @@ void Logger::run()
 				_writer.notify();
 			}
 
-			/* subscription update */
-			if (next_subscribe_topic_index != -1) {
-				if (++next_subscribe_topic_index >= _subscriptions.size()) {
-					next_subscribe_topic_index = -1;
-					next_subscribe_check = loop_time + TRY_SUBSCRIBE_INTERVAL;
-				}
+			/* backpressure state for onboard consumers */
+			publish_logger_status(loop_time);
 
-			} else if (loop_time > next_subscribe_check) {
-				next_subscribe_topic_index = 0;
+			/* periodic perf counter timeline */
+			if (_perf_snapshot_interval > 0 && loop_time >= _next_perf_snapshot) {
+				write_perf_snapshot();
+				_next_perf_snapshot = loop_time + _perf_snapshot_interval;
 			}
 
 #ifdef DBGPRINT
@@ -1033,6 +1395,54 @@ void Logger::run()
 
 #endif /* DBGPRINT */
 
+		} else if (_prearm_ring != nullptr) {
+
+			/* no open log file: keep the pre-arm ring filled, so that the next
+			 * log starts with the most recent history instead of with nothing.
+			 * This is the same collection loop as above, with the writer ring
+			 * buffer replaced by the in-RAM ring (and without dropouts: the
+			 * ring evicts the oldest data instead) */
+			int sub_idx = 0;
+
+			for (LoggerSubscription &sub : _subscriptions) {
+				size_t msg_size = sizeof(ulog_message_data_header_s) + sub.metadata->o_size_no_padding;
+
+				for (uint8_t instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+					if (sub.log_interval > 0 && loop_time < sub.last_logged[instance] + sub.log_interval) {
+						continue;
+					}
+
+					if (copy_if_updated_multi(sub, instance, _msg_buffer + sizeof(ulog_message_data_header_s),
+								  sub_idx == next_subscribe_topic_index)) {
+						sub.last_logged[instance] = loop_time;
+
+						uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
+						_msg_buffer[0] = (uint8_t)write_msg_size;
+						_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+						_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
+						uint16_t write_msg_id = sub.msg_ids[instance];
+						_msg_buffer[3] = (uint8_t)write_msg_id;
+						_msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
+
+						prearm_ring_push(_msg_buffer, msg_size);
+					}
+				}
+
+				++sub_idx;
+			}
+		}
+
+		/* subscription update (shared by the writer and the pre-arm ring path) */
+		if (_writer.is_started() || _prearm_ring != nullptr) {
+			if (next_subscribe_topic_index != -1) {
+				if (++next_subscribe_topic_index >= _subscriptions.size()) {
+					next_subscribe_topic_index = -1;
+					next_subscribe_check = loop_time + TRY_SUBSCRIBE_INTERVAL;
+				}
+
+			} else if (loop_time > next_subscribe_check) {
+				next_subscribe_topic_index = 0;
+			}
 		}
 
 		// wait for next loop iteration...
@@ -1086,11 +1496,20 @@ void Logger::run()
 		orb_unsubscribe(polling_topic_sub);
 	}
 
+	if (land_detected_sub >= 0) {
+		orb_unsubscribe(land_detected_sub);
+	}
+
 	if (_mavlink_log_pub) {
 		orb_unadvertise(_mavlink_log_pub);
 		_mavlink_log_pub = nullptr;
 	}
 
+	if (_logger_status_pub) {
+		orb_unadvertise(_logger_status_pub);
+		_logger_status_pub = nullptr;
+	}
+
 	if (vehicle_command_ack_pub) {
 		orb_unadvertise(vehicle_command_ack_pub);
 	}
@@ -1104,6 +1523,13 @@ void Logger::run()
 
 bool Logger::write_message(void *ptr, size_t size)
 {
+	if (_rotation_fd >= 0) {
+		/* during a rotation the definition section goes directly into the
+		 * preopened next file; the ring buffer keeps draining into the
+		 * current file in parallel */
+		return ::write(_rotation_fd, ptr, size) == (ssize_t)size;
+	}
+
 	if (_writer.write_message(ptr, size, _dropout_start) != -1) {
 
 		if (_dropout_start) {
@@ -1114,6 +1540,7 @@ bool Logger::write_message(void *ptr, size_t size)
 			}
 
 			_dropout_start = 0;
+			write_dropout_counts();
 		}
 
 		return true;
@@ -1128,6 +1555,309 @@ bool Logger::write_message(void *ptr, size_t size)
 	return false;
 }
 
+bool Logger::batch_sample(LoggerSubscription &sub, const uint8_t *sample)
+{
+	const size_t sample_size = sub.metadata->o_size_no_padding;
+
+	memcpy(sub.batch_buffer + sizeof(ulog_message_data_batch_header_s) + sub.batch_count * sample_size,
+	       sample, sample_size);
+
+	if (++sub.batch_count < sub.batch_samples) {
+		return false;
+	}
+
+	return write_sample_batch(sub);
+}
+
+bool Logger::write_sample_batch(LoggerSubscription &sub)
+{
+	if (sub.batch_count == 0) {
+		return false;
+	}
+
+	const size_t total_size = sizeof(ulog_message_data_batch_header_s) +
+				  sub.batch_count * sub.metadata->o_size_no_padding;
+	const uint16_t write_msg_size = (uint16_t)(total_size - ULOG_MSG_HEADER_LEN);
+	const uint16_t write_msg_id = sub.msg_ids[0];
+
+	uint8_t *buffer = sub.batch_buffer;
+	buffer[0] = (uint8_t)write_msg_size;
+	buffer[1] = (uint8_t)(write_msg_size >> 8);
+	buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA_BATCH);
+	buffer[3] = (uint8_t)write_msg_id;
+	buffer[4] = (uint8_t)(write_msg_id >> 8);
+	buffer[5] = sub.batch_count;
+
+	/* batched records only go to the file backend */
+	_writer.select_write_backend(LogWriter::BackendFile);
+	const bool written = write_message(buffer, total_size);
+	_writer.unselect_write_backend();
+
+	if (!written) {
+		/* overflow: the whole record is lost, account every sample */
+		for (unsigned i = 0; i < sub.batch_count; i++) {
+			count_dropped_sample(write_msg_id);
+		}
+	}
+
+	sub.batch_count = 0;
+	return written;
+}
+
+void Logger::batch_log_message(const void *ptr, size_t size, const hrt_abstime &now)
+{
+	if (size > sizeof(_log_message_batch)) {
+		/* cannot happen with LOGGING messages, but do not truncate if it does */
+		write_message(const_cast<void *>(ptr), size);
+		return;
+	}
+
+	if (_log_message_batch_len + size > sizeof(_log_message_batch)) {
+		flush_log_message_batch();
+	}
+
+	if (_log_message_batch_len == 0) {
+		_log_message_batch_start = now;
+	}
+
+	memcpy(_log_message_batch + _log_message_batch_len, ptr, size);
+	_log_message_batch_len += size;
+}
+
+void Logger::flush_log_message_batch()
+{
+	if (_log_message_batch_len == 0) {
+		return;
+	}
+
+	/* the batch holds complete LOGGING messages, so it goes out as one write */
+	write_message(_log_message_batch, _log_message_batch_len);
+	_log_message_batch_len = 0;
+}
+
+void Logger::count_dropped_sample(uint16_t msg_id)
+{
+	if (!_dropout_counts_enabled) {
+		return;
+	}
+
+	for (unsigned i = 0; i < _dropout_counts_num; i++) {
+		if (_dropout_counts[i].msg_id == msg_id) {
+			if (_dropout_counts[i].count < UINT16_MAX) {
+				++_dropout_counts[i].count;
+			}
+
+			return;
+		}
+	}
+
+	if (_dropout_counts_num < DROPOUT_COUNT_ENTRIES) {
+		_dropout_counts[_dropout_counts_num].msg_id = msg_id;
+		_dropout_counts[_dropout_counts_num].count = 1;
+		++_dropout_counts_num;
+
+	} else if (_dropout_counts_other < UINT16_MAX) {
+		++_dropout_counts_other;
+	}
+}
+
+void Logger::write_dropout_counts()
+{
+	if (_dropout_counts_num == 0 && _dropout_counts_other == 0) {
+		return;
+	}
+
+	ulog_message_dropout_counts_s msg;
+	unsigned num_entries = _dropout_counts_num;
+
+	memcpy(msg.entries, _dropout_counts, num_entries * sizeof(ulog_dropout_count_entry_s));
+
+	if (_dropout_counts_other > 0 && num_entries < DROPOUT_COUNT_ENTRIES) {
+		msg.entries[num_entries].msg_id = 0xffff;
+		msg.entries[num_entries].count = _dropout_counts_other;
+		++num_entries;
+	}
+
+	size_t msg_size = ULOG_MSG_HEADER_LEN + num_entries * sizeof(ulog_dropout_count_entry_s);
+	msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+
+	/* written directly so a full buffer does not restart the dropout we just
+	 * closed; if there is no room the counts are kept and merged into the
+	 * next window */
+	if (_writer.write_message(&msg, msg_size) != -1) {
+		_dropout_counts_num = 0;
+		_dropout_counts_other = 0;
+	}
+}
+
+uint8_t Logger::topic_priority(const char *name)
+{
+	/* estimator and actuator topics must survive I/O degradation */
+	static const char *const critical_topics[] = {
+		"actuator_controls_0",
+		"actuator_controls_1",
+		"actuator_outputs",
+		"ekf2_innovations",
+		"ekf2_timestamps",
+		"estimator_status",
+		"sensor_combined",
+		"sensor_selection",
+		"vehicle_attitude",
+		"vehicle_attitude_setpoint",
+		"vehicle_local_position",
+		"vehicle_rates_setpoint"
+	};
+	/* diagnostics, first to go when the write bandwidth collapses */
+	static const char *const low_topics[] = {
+		"control_latency",
+		"cpuload",
+		"system_power",
+		"telemetry_status",
+		"work_queue_status"
+	};
+
+	for (unsigned i = 0; i < sizeof(critical_topics) / sizeof(critical_topics[0]); i++) {
+		if (strcmp(name, critical_topics[i]) == 0) {
+			return LOG_PRIO_CRITICAL;
+		}
+	}
+
+	for (unsigned i = 0; i < sizeof(low_topics) / sizeof(low_topics[0]); i++) {
+		if (strcmp(name, low_topics[i]) == 0) {
+			return LOG_PRIO_LOW;
+		}
+	}
+
+	return LOG_PRIO_DEFAULT;
+}
+
+void Logger::update_shed_level()
+{
+	if (!_writer.is_started(LogWriter::BackendFile)) {
+		_shed_level = 0;
+		return;
+	}
+
+	const size_t buffer_size = _writer.get_buffer_size_file();
+
+	if (buffer_size == 0) {
+		_shed_level = 0;
+		return;
+	}
+
+	const float fill = (float)_writer.get_buffer_fill_count_file() / buffer_size;
+
+	/* entry thresholds per level; leaving a level requires dropping 10%
+	 * below its entry threshold, so a burst does not make the level flap */
+	static constexpr float thresholds[] = {0.5f, 0.7f, 0.9f};
+
+	uint8_t level = 0;
+
+	while (level < 3 && fill >= thresholds[level]) {
+		++level;
+	}
+
+	if (level > _shed_level) {
+		_shed_level = level;
+
+	} else if (level < _shed_level && fill < thresholds[_shed_level - 1] - 0.1f) {
+		--_shed_level;
+	}
+}
+
+void Logger::update_log_phase(bool armed, bool airborne, const hrt_abstime now)
+{
+	/* takeoffs and landings log at full rate for this long after the
+	 * airborne state changes */
+	static constexpr hrt_abstime TAKEOFF_WINDOW = 30 * 1000 * 1000;
+
+	LogPhase phase;
+
+	if (!armed) {
+		phase = LogPhase::GROUND;
+		_airborne_time = 0;
+
+	} else if (!airborne) {
+		phase = LogPhase::TRANSIENT;
+		_airborne_time = 0;
+
+	} else {
+		if (_airborne_time == 0) {
+			_airborne_time = now;
+		}
+
+		phase = (now > _airborne_time + TAKEOFF_WINDOW) ? LogPhase::CRUISE : LogPhase::TRANSIENT;
+	}
+
+	if (phase != _log_phase) {
+		_log_phase = phase;
+
+		int32_t divider = 1;
+
+		if (phase != LogPhase::TRANSIENT && _sdlog_phase_div_handle != PARAM_INVALID) {
+			param_get(_sdlog_phase_div_handle, &divider);
+		}
+
+		if (divider < 1) {
+			divider = 1;
+		}
+
+		apply_phase_intervals(divider);
+	}
+}
+
+void Logger::apply_phase_intervals(unsigned divider)
+{
+	for (LoggerSubscription &sub : _subscriptions) {
+		if (divider > 1) {
+			/* full-rate topics get a floor so that the divider has an
+			 * effect on them as well */
+			sub.log_interval = (sub.base_interval > 0 ? sub.base_interval : 10 * 1000) * divider;
+
+		} else {
+			sub.log_interval = sub.base_interval;
+		}
+	}
+}
+
+void Logger::publish_logger_status(const hrt_abstime &now)
+{
+	if (now < _logger_status_time + 1000 * 1000) {
+		return;
+	}
+
+	logger_status_s status = {};
+	status.timestamp = now;
+
+	const size_t buffer_size = _writer.get_buffer_size_file();
+
+	if (buffer_size > 0) {
+		status.buffer_fill = (float)_writer.get_buffer_fill_count_file() / buffer_size;
+	}
+
+	status.shed_level = _shed_level;
+	const float dt = (now - _logger_status_time) * 1e-6f;
+
+	for (unsigned i = 0; i < LOG_PRIO_COUNT; i++) {
+		status.drops[i] = _shed_drops[i];
+
+		/* the first publication has no meaningful window, dt is the uptime */
+		status.drop_rate[i] = (_shed_drops[i] - _shed_drops_last[i]) / dt;
+		_shed_drops_last[i] = _shed_drops[i];
+	}
+
+	status.buffer_overflows = _write_dropouts;
+
+	if (_logger_status_pub == nullptr) {
+		_logger_status_pub = orb_advertise(ORB_ID(logger_status), &status);
+
+	} else {
+		orb_publish(ORB_ID(logger_status), _logger_status_pub, &status);
+	}
+
+	_logger_status_time = now;
+}
+
 int Logger::create_log_dir(tm *tt)
 {
 	/* create dir on sdcard if needed */
@@ -1325,6 +2055,11 @@ void Logger::start_log_file()
 	mavlink_log_info(&_mavlink_log_pub, "[logger] file: %s", file_name);
 
 	_writer.start_log_file(file_name);
+
+	if (_legacy_log_enabled) {
+		_writer_legacy.start_log(file_name);
+	}
+
 	_writer.select_write_backend(LogWriter::BackendFile);
 	_writer.set_need_reliable_transfer(true);
 	write_header();
@@ -1333,10 +2068,16 @@ void Logger::start_log_file()
 	write_parameters();
 	write_perf_data(true);
 	write_all_add_logged_msg();
+	write_prearm_ring();
 	_writer.set_need_reliable_transfer(false);
 	_writer.unselect_write_backend();
 	_writer.notify();
 
+	/* discard samples batched before this log was started */
+	for (LoggerSubscription &sub : _subscriptions) {
+		sub.batch_count = 0;
+	}
+
 	/* reset performance counters to get in-flight min and max values in post flight log */
 	perf_reset_all();
 
@@ -1351,12 +2092,81 @@ void Logger::stop_log_file()
 		return;
 	}
 
+	/* push out any text messages and partially filled sample batches */
+	_writer.lock();
+	flush_log_message_batch();
+
+	for (LoggerSubscription &sub : _subscriptions) {
+		if (sub.batch_count > 0) {
+			write_sample_batch(sub);
+		}
+	}
+
+	_writer.unlock();
+
+	_writer_legacy.stop_log();
+
 	_writer.set_need_reliable_transfer(true);
 	write_perf_data(false);
 	_writer.set_need_reliable_transfer(false);
 	_writer.stop_log_file();
 }
 
+void Logger::rotate_log_file()
+{
+	if (!_writer.is_started(LogWriter::BackendFile)) {
+		return;
+	}
+
+	if (!_writer.can_rotate_file()) {
+		/* compressed/memory-mapped streams cannot be split: restart instead,
+		 * accepting the gap */
+		stop_log_file();
+		start_log_file();
+		return;
+	}
+
+	char file_name[LOG_DIR_LEN] = "";
+
+	if (get_log_file_name(file_name, sizeof(file_name))) {
+		PX4_ERR("logger: failed to get log file name");
+		return;
+	}
+
+	int fd = ::open(file_name, O_CREAT | O_WRONLY, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("can't open next log file %s, continuing current one", file_name);
+		return;
+	}
+
+	/* write the definition section of the next file; write_message() bypasses
+	 * the ring buffer while _rotation_fd is set, so the writer keeps draining
+	 * into the current file without interruption */
+	_rotation_fd = fd;
+	write_header();
+	write_version();
+	write_formats();
+	write_parameters();
+	write_all_add_logged_msg();
+	_rotation_fd = -1;
+
+	if (!_writer.rotate_log_file(fd, file_name)) {
+		::close(fd);
+		::unlink(file_name);
+		return;
+	}
+
+	/* the legacy stream follows the rotation, starting a fresh .px4log */
+	if (_writer_legacy.is_started()) {
+		_writer_legacy.stop_log();
+		_writer_legacy.start_log(file_name);
+	}
+
+	mavlink_log_info(&_mavlink_log_pub, "[logger] file: %s", file_name);
+	_start_time_file = hrt_absolute_time();
+}
+
 void Logger::start_log_mavlink()
 {
 	if (!can_start_mavlink_log()) {
@@ -1426,6 +2236,72 @@ void Logger::write_perf_data(bool preflight)
 	perf_iterate_all(perf_iterate_callback, &callback_data);
 }
 
+struct perf_snapshot_data_t {
+	Logger *logger;
+	int written;
+};
+
+void Logger::perf_snapshot_callback(perf_counter_t handle, void *user)
+{
+	perf_snapshot_data_t *data = (perf_snapshot_data_t *)user;
+	Logger *logger = data->logger;
+
+	const uint64_t count = perf_event_count(handle);
+
+	/* find (or add) the per-counter state, keyed by the handle */
+	int idx = -1;
+
+	for (int i = 0; i < logger->_perf_snapshot_used; i++) {
+		if (logger->_perf_snapshot_state[i].handle == handle) {
+			idx = i;
+			break;
+		}
+	}
+
+	if (idx < 0) {
+		if (logger->_perf_snapshot_used >= PERF_SNAPSHOT_MAX_COUNTERS) {
+			return;
+		}
+
+		idx = logger->_perf_snapshot_used++;
+		logger->_perf_snapshot_state[idx].handle = handle;
+		logger->_perf_snapshot_state[idx].event_count = 0;
+	}
+
+	if (count == logger->_perf_snapshot_state[idx].event_count) {
+		/* idle counters are left out of the snapshot */
+		return;
+	}
+
+	logger->_perf_snapshot_state[idx].event_count = count;
+
+	char buffer[256];
+	perf_print_counter_buffer(buffer, sizeof(buffer), handle);
+	logger->write_info_multiple("perf_counter_inflight", buffer, data->written != 0);
+	++data->written;
+}
+
+void Logger::write_perf_snapshot()
+{
+	if (_perf_snapshot_state == nullptr) {
+		_perf_snapshot_state = new PerfSnapshotEntry[PERF_SNAPSHOT_MAX_COUNTERS];
+
+		if (_perf_snapshot_state == nullptr) {
+			PX4_ERR("failed to alloc perf snapshot state");
+			_perf_snapshot_interval = 0;
+			return;
+		}
+
+		_perf_snapshot_used = 0;
+	}
+
+	perf_snapshot_data_t data;
+	data.logger = this;
+	data.written = 0;
+
+	perf_iterate_all(perf_snapshot_callback, &data);
+}
+
 
 void Logger::print_load_callback(void *user)
 {
@@ -1481,11 +2357,26 @@ void Logger::write_formats()
 {
 	_writer.lock();
 	ulog_message_format_s msg;
-	const orb_metadata **topics = orb_get_topics();
+	const orb_metadata *const *topics = orb_get_topics();
 
 	//write all known formats
 	for (size_t i = 0; i < orb_topics_count(); i++) {
-		int format_len = snprintf(msg.format, sizeof(msg.format), "%s:%s", topics[i]->o_name, topics[i]->o_fields);
+		size_t format_len;
+
+		if (topics[i]->o_format) {
+			// precomputed at topic generation time
+			format_len = strlen(topics[i]->o_format);
+
+			if (format_len > sizeof(msg.format)) {
+				continue; // already reported in add_topic()
+			}
+
+			memcpy(msg.format, topics[i]->o_format, format_len);
+
+		} else {
+			format_len = snprintf(msg.format, sizeof(msg.format), "%s:%s", topics[i]->o_name, topics[i]->o_fields);
+		}
+
 		size_t msg_size = sizeof(msg) - sizeof(msg.format) + format_len;
 		msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
 
@@ -1518,6 +2409,13 @@ void Logger::write_add_logged_msg(LoggerSubscription &subscription, int instance
 		subscription.msg_ids[instance] = _next_topic_id++;
 	}
 
+	if (!_writer.is_started()) {
+		/* pre-arm ring phase: only the id assignment is needed here, the
+		 * ADD_LOGGED_MSG itself is written by write_all_add_logged_msg() when
+		 * a log is actually started */
+		return;
+	}
+
 	msg.msg_id = subscription.msg_ids[instance];
 	msg.multi_id = instance;
 
@@ -1534,6 +2432,74 @@ void Logger::write_add_logged_msg(LoggerSubscription &subscription, int instance
 	_writer.set_need_reliable_transfer(prev_reliable);
 }
 
+void Logger::prearm_ring_push(const uint8_t *msg, size_t size)
+{
+	if (size > _prearm_ring_size) {
+		return; // message does not fit into the arena at all
+	}
+
+	/* evict whole messages, oldest first, until the new one fits. The size can
+	 * be read back from the message header, so no separate index is needed */
+	while (_prearm_ring_size - _prearm_ring_count < size) {
+		size_t tail = (_prearm_ring_head + _prearm_ring_size - _prearm_ring_count) % _prearm_ring_size;
+		size_t oldest_size = ((size_t)_prearm_ring[tail] |
+				      ((size_t)_prearm_ring[(tail + 1) % _prearm_ring_size] << 8)) + ULOG_MSG_HEADER_LEN;
+		_prearm_ring_count -= oldest_size;
+	}
+
+	/* copy in up to two pieces (wraparound) */
+	size_t first_part = _prearm_ring_size - _prearm_ring_head;
+
+	if (first_part > size) {
+		first_part = size;
+	}
+
+	memcpy(&_prearm_ring[_prearm_ring_head], msg, first_part);
+
+	if (first_part < size) {
+		memcpy(_prearm_ring, msg + first_part, size - first_part);
+	}
+
+	_prearm_ring_head = (_prearm_ring_head + size) % _prearm_ring_size;
+	_prearm_ring_count += size;
+}
+
+void Logger::write_prearm_ring()
+{
+	if (_prearm_ring == nullptr || _prearm_ring_count == 0) {
+		return;
+	}
+
+	_writer.lock();
+
+	/* replay the ring message by message, oldest first. Messages can wrap
+	 * around the end of the arena, so they are reassembled in the message
+	 * buffer. The caller still has reliable transfer set, so a full writer
+	 * buffer blocks instead of dropping */
+	while (_prearm_ring_count > 0) {
+		size_t tail = (_prearm_ring_head + _prearm_ring_size - _prearm_ring_count) % _prearm_ring_size;
+		size_t msg_size = ((size_t)_prearm_ring[tail] |
+				   ((size_t)_prearm_ring[(tail + 1) % _prearm_ring_size] << 8)) + ULOG_MSG_HEADER_LEN;
+
+		size_t first_part = _prearm_ring_size - tail;
+
+		if (first_part > msg_size) {
+			first_part = msg_size;
+		}
+
+		memcpy(_msg_buffer, &_prearm_ring[tail], first_part);
+
+		if (first_part < msg_size) {
+			memcpy(_msg_buffer + first_part, _prearm_ring, msg_size - first_part);
+		}
+
+		_prearm_ring_count -= msg_size;
+		write_message(_msg_buffer, msg_size);
+	}
+
+	_writer.unlock();
+}
+
 /* write info message */
 void Logger::write_info(const char *name, const char *value)
 {
@@ -1642,6 +2608,10 @@ void Logger::write_header()
 	flag_bits.msg_size = sizeof(flag_bits) - ULOG_MSG_HEADER_LEN;
 	flag_bits.msg_type = static_cast<uint8_t>(ULogMessageType::FLAG_BITS);
 
+	if (_dropout_counts_enabled) {
+		flag_bits.compat_flags[0] |= ULOG_COMPAT_FLAG0_DROPOUT_COUNTS_MASK;
+	}
+
 	write_message(&flag_bits, sizeof(flag_bits));
 
 	_writer.unlock();
@@ -1775,6 +2745,12 @@ void Logger::write_changed_parameters()
 	int param_idx = 0;
 	param_t param = 0;
 
+	/* aggregate the small PARAMETER records, so a burst of changed parameters
+	 * (e.g. after a calibration) costs one writer transaction instead of one
+	 * write per parameter */
+	uint8_t batch[256];
+	size_t batch_len = 0;
+
 	do {
 		// get next parameter which is invalid OR used
 		do {
@@ -1816,10 +2792,20 @@ void Logger::write_changed_parameters()
 			/* msg_size is now 1 (msg_type) + 2 (msg_size) + 1 (key_len) + key_len + value_size */
 			msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
 
-			write_message(buffer, msg_size);
+			if (batch_len + msg_size > sizeof(batch)) {
+				write_message(batch, batch_len);
+				batch_len = 0;
+			}
+
+			memcpy(batch + batch_len, buffer, msg_size);
+			batch_len += msg_size;
 		}
 	} while ((param != PARAM_INVALID) && (param_idx < (int) param_count()));
 
+	if (batch_len > 0) {
+		write_message(batch, batch_len);
+	}
+
 	_writer.unlock();
 	_writer.notify();
 }
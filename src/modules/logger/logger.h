@@ -34,7 +34,9 @@
 #pragma once
 
 #include "log_writer.h"
+#include "log_writer_legacy.h"
 #include "array.h"
+#include "messages.h"
 #include <px4_defines.h>
 #include <drivers/drv_hrt.h>
 #include <uORB/Subscription.hpp>
@@ -68,10 +70,48 @@ enum class SDLogProfile : int32_t {
 	N_PROFILES
 };
 
+/* backpressure tiers: when the write buffer fills up, subscriptions are
+ * shed lowest tier first (see Logger::update_shed_level()). The values
+ * match the LOG_PRIO_* constants in logger_status.msg */
+enum : uint8_t {
+	LOG_PRIO_LOW = 0,	///< diagnostics, first tier to be shed
+	LOG_PRIO_DEFAULT = 1,
+	LOG_PRIO_CRITICAL = 2,	///< estimator and actuator topics, never shed
+	LOG_PRIO_COUNT
+};
+
 struct LoggerSubscription {
 	int fd[ORB_MULTI_MAX_INSTANCES];
 	uint16_t msg_ids[ORB_MULTI_MAX_INSTANCES];
+	uint64_t last_logged[ORB_MULTI_MAX_INSTANCES]; ///< timestamp of the last logged sample per instance
 	const orb_metadata *metadata = nullptr;
+	unsigned log_interval = 0; ///< minimum interval between logged samples in us (0 = log every update)
+	unsigned base_interval = 0; ///< configured interval before flight-phase scaling (see SDLOG_PH_EN)
+	uint8_t priority = LOG_PRIO_DEFAULT; ///< backpressure tier (LOG_PRIO_*)
+
+	/* mavlink mirror tier: when both backends run, the mavlink one only gets
+	 * the topics marked here, decimated to mavlink_interval, while the file
+	 * backend logs everything at log_interval */
+	bool mavlink_enabled = false; ///< part of the mavlink mirror subset
+	unsigned mavlink_interval = 0; ///< minimum interval for the mavlink mirror in us
+	uint64_t last_logged_mavlink[ORB_MULTI_MAX_INSTANCES]; ///< timestamp of the last mirrored sample per instance
+
+	/* staging slot for one full DATA message, lazily allocated on the first
+	 * writer buffer overflow; keeps a sample of this topic alive across a
+	 * burst so that one bursty topic cannot starve the others.
+	 * Note: never freed, the logger subscriptions live until shutdown. */
+	uint8_t *staging = nullptr;
+	size_t staging_size = 0;
+
+	/* sample batching (third column in logger_topics.txt): instance-0
+	 * samples are packed into DATA_BATCH records of batch_samples each,
+	 * file backend only. Note: the buffer is never freed either. */
+	uint8_t batch_samples = 0; ///< samples per DATA_BATCH record, 0/1 = disabled
+	uint8_t batch_count = 0; ///< samples currently staged in batch_buffer
+	uint8_t *batch_buffer = nullptr; ///< record header followed by batch_samples sample slots
+
+	/* cached lookup into the sdlog2 conversion table, see LogWriterLegacy */
+	int8_t legacy_index = -2; ///< -2 = unresolved, -1 = topic has no legacy message
 
 	LoggerSubscription() {}
 
@@ -86,6 +126,8 @@ struct LoggerSubscription {
 
 		for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++) {
 			msg_ids[i] = (uint16_t) - 1;
+			last_logged[i] = 0;
+			last_logged_mavlink[i] = 0;
 		}
 	}
 };
@@ -137,6 +179,15 @@ public:
 	 */
 	int add_topic(const orb_metadata *topic);
 
+	/**
+	 * mark an already added topic as part of the decimated mavlink mirror
+	 * subset (no-op if the topic is not logged)
+	 * @param name topic name
+	 * @param interval_ms minimum interval between mirrored samples
+	 * @return 0 on success, -1 if the topic is not logged
+	 */
+	int add_mavlink_topic(const char *name, unsigned interval_ms);
+
 	/**
 	 * request the logger thread to stop (this method does not block).
 	 * @return true if the logger is stopped, false if (still) running
@@ -160,6 +211,20 @@ private:
 	 */
 	void write_add_logged_msg(LoggerSubscription &subscription, int instance);
 
+	/**
+	 * Append one complete ULog DATA message to the pre-arm ring buffer,
+	 * evicting the oldest messages until it fits.
+	 */
+	void prearm_ring_push(const uint8_t *msg, size_t size);
+
+	/**
+	 * Replay the content of the pre-arm ring buffer into the log and empty it.
+	 * Must be called after write_all_add_logged_msg() (the ring holds DATA
+	 * messages whose ids are only defined by the preceding ADD_LOGGED_MSGs)
+	 * and with reliable transfer still set, so nothing is dropped.
+	 */
+	void write_prearm_ring();
+
 	/**
 	 * Create logging directory
 	 * @param tt if not null, use it for the directory name
@@ -191,6 +256,14 @@ private:
 
 	void stop_log_file();
 
+	/**
+	 * Seamlessly rotate into a new log file: the next file is preopened and
+	 * its definition section written while the writer keeps draining into the
+	 * current file, then the writer switches over at a drain boundary. Falls
+	 * back to stop/start when the output mode does not support rotation.
+	 */
+	void rotate_log_file();
+
 	void start_log_mavlink();
 
 	void stop_log_mavlink();
@@ -217,6 +290,14 @@ private:
 	 */
 	void write_perf_data(bool preflight);
 
+	/**
+	 * Write an in-flight perf counter snapshot (SDLOG_PERF_INT): only
+	 * counters whose event count changed since the last snapshot are
+	 * written, so the periodic timeline stays compact.
+	 */
+	void write_perf_snapshot();
+	static void perf_snapshot_callback(perf_counter_t handle, void *user);
+
 	/**
 	 * callback to write the performance counters
 	 */
@@ -251,6 +332,67 @@ private:
 	 */
 	bool write_message(void *ptr, size_t size);
 
+	/**
+	 * Enable DATA_BATCH packing for an already added topic: allocates the
+	 * record buffer and clamps the sample count to a sane record size.
+	 */
+	void configure_topic_batch(const char *name, unsigned batch_samples);
+
+	/**
+	 * Append one copied sample to the subscription's DATA_BATCH record and
+	 * write the record to the file backend once it is full.
+	 * Must be called with _writer.lock() held.
+	 * @return true if a full record was written
+	 */
+	bool batch_sample(LoggerSubscription &sub, const uint8_t *sample);
+
+	/**
+	 * Frame and write the (possibly partially filled) DATA_BATCH record of a
+	 * subscription to the file backend. Must be called with _writer.lock() held.
+	 */
+	bool write_sample_batch(LoggerSubscription &sub);
+
+	/**
+	 * Append one complete LOGGING message to the low-priority text batch,
+	 * flushing first if it does not fit anymore.
+	 * Must be called with _writer.lock() held.
+	 */
+	void batch_log_message(const void *ptr, size_t size, const hrt_abstime &now);
+
+	/**
+	 * Write the aggregated low-priority LOGGING messages as a single writer
+	 * transaction. Must be called with _writer.lock() held.
+	 */
+	void flush_log_message_batch();
+
+	/**
+	 * Account one dropped sample of the given msg_id for the current
+	 * dropout window (no-op unless SDLOG_DROP_CNT is set).
+	 */
+	void count_dropped_sample(uint16_t msg_id);
+
+	/**
+	 * Write the accumulated DROPOUT_COUNTS message after a dropout ended
+	 * and reset the accounting. Must be called with _writer.lock() held.
+	 */
+	void write_dropout_counts();
+
+	/**
+	 * Update the backpressure shed level from the file writer buffer fill
+	 * state (with hysteresis, so the level does not flap on a burst).
+	 */
+	void update_shed_level();
+
+	/**
+	 * Publish the logger_status topic with the backpressure state (1 Hz).
+	 */
+	void publish_logger_status(const hrt_abstime &now);
+
+	/**
+	 * Backpressure tier of a topic, from the built-in priority table.
+	 */
+	static uint8_t topic_priority(const char *name);
+
 	/**
 	 * Get the time for log file name
 	 * @param tt returned time
@@ -271,6 +413,12 @@ private:
 	void add_thermal_calibration_topics();
 	void add_system_identification_topics();
 
+	/**
+	 * Mark the critical subset mirrored to the mavlink backend while the file
+	 * backend is also active, together with the mirror rates.
+	 */
+	void add_mavlink_mirror_topics();
+
 	void ack_vehicle_command(orb_advert_t &vehicle_command_ack_pub, vehicle_command_s *cmd, uint32_t result);
 
 	/**
@@ -294,6 +442,16 @@ private:
 
 	uint8_t						*_msg_buffer = nullptr;
 	int						_msg_buffer_len = 0;
+
+	/* pre-arm ring buffer (SDLOG_PREARM): while no file log is open, the most
+	 * recent DATA messages are kept in this arena and replayed at the head of
+	 * the next log file, so a log started on arming (or after a fault) begins
+	 * with the seconds leading up to it instead of with nothing */
+	uint8_t						*_prearm_ring = nullptr;
+	size_t						_prearm_ring_size = 0;
+	size_t						_prearm_ring_head = 0; ///< next write position
+	size_t						_prearm_ring_count = 0; ///< used bytes, ending at _prearm_ring_head
+
 	char 						_log_dir[LOG_DIR_LEN];
 	int						_sess_dir_index = 1; ///< search starting index for 'sess<i>' directory name
 	char 						_log_file_name[32];
@@ -304,16 +462,48 @@ private:
 
 	// statistics
 	hrt_abstime					_start_time_file; ///< Time when logging started, file backend (not the logger thread)
+	uint64_t					_rotate_interval = 0; ///< start a new log file after this time [us], 0 = never
+	int						_rotation_fd = -1; ///< while >= 0, write_message() bypasses the ring buffer
+								   ///< and writes the next file's definition section directly
 	hrt_abstime					_dropout_start = 0; ///< start of current dropout (0 = no dropout)
 	float						_max_dropout_duration = 0.f; ///< max duration of dropout [s]
 	size_t						_write_dropouts = 0; ///< failed buffer writes due to buffer overflow
 	size_t						_high_water = 0; ///< maximum used write buffer
 
+	/* tiered backpressure: as the file writer buffer fills, lower-tier
+	 * subscriptions are first decimated, then shed entirely, so a collapsing
+	 * SD card drops diagnostics instead of estimator and actuator data */
+	uint8_t						_shed_level = 0; ///< 0 = no shedding .. 3 = only critical topics logged
+	uint32_t					_shed_drops[LOG_PRIO_COUNT] {}; ///< shed topic updates per tier
+	uint32_t					_shed_drops_last[LOG_PRIO_COUNT] {}; ///< counts at the last status publication
+	orb_advert_t					_logger_status_pub = nullptr;
+	hrt_abstime					_logger_status_time = 0; ///< time of the last logger_status publication
+
+	/* low-priority text messages (below warning severity) are aggregated here
+	 * and flushed as one write on size or time thresholds, so that bulk events
+	 * (e.g. a calibration run) cost one writer transaction instead of hundreds.
+	 * Warnings and errors bypass the batch and are written immediately. */
+	static constexpr size_t				LOG_MESSAGE_BATCH_SIZE = 512;
+	static constexpr hrt_abstime			LOG_MESSAGE_BATCH_INTERVAL = 300 * 1000; ///< max batch holding time [us]
+	uint8_t						_log_message_batch[LOG_MESSAGE_BATCH_SIZE];
+	size_t						_log_message_batch_len = 0; ///< used bytes
+	hrt_abstime					_log_message_batch_start = 0; ///< staging time of the oldest batched message
+
+	// per-dropout drop accounting (only maintained if SDLOG_DROP_CNT is set)
+	static constexpr unsigned			DROPOUT_COUNT_ENTRIES = sizeof(ulog_message_dropout_counts_s::entries) /
+			sizeof(ulog_dropout_count_entry_s);
+	ulog_dropout_count_entry_s			_dropout_counts[DROPOUT_COUNT_ENTRIES];
+	unsigned					_dropout_counts_num = 0; ///< used entries in _dropout_counts
+	uint16_t					_dropout_counts_other = 0; ///< drops that did not fit into the table
+	bool						_dropout_counts_enabled = false;
+
 	const bool 					_log_on_start;
 	const bool 					_log_until_shutdown;
 	const bool					_log_name_timestamp;
 	Array<LoggerSubscription, MAX_TOPICS_NUM>	_subscriptions;
 	LogWriter					_writer;
+	LogWriterLegacy					_writer_legacy; ///< secondary sdlog2-format backend (SDLOG_LEGACY)
+	bool						_legacy_log_enabled = false;
 	uint32_t					_log_interval;
 	const orb_metadata				*_polling_topic_meta = nullptr; ///< if non-null, poll on this topic instead of sleeping
 	param_t						_log_utc_offset;
@@ -326,8 +516,48 @@ private:
 	print_load_s					_load; ///< process load data
 	hrt_abstime					_next_load_print = 0; ///< timestamp when to print the process load
 
+	/* flight-phase driven rate scaling (SDLOG_PH_EN): in cruise and on the
+	 * ground the per-topic intervals are multiplied by SDLOG_PH_DIV, while
+	 * takeoff and landing log at the configured maximum rates */
+	enum class LogPhase : uint8_t {
+		GROUND = 0,	///< disarmed
+		TRANSIENT,	///< armed and close to the ground: takeoff or landing
+		CRUISE		///< airborne beyond the takeoff window
+	};
+
+	/**
+	 * Derive the flight phase from the arming and landed state and swap
+	 * the interval set when it changes.
+	 */
+	void update_log_phase(bool armed, bool airborne, const hrt_abstime now);
+
+	/**
+	 * Swap the effective per-topic intervals between two loop iterations;
+	 * the subscriptions and the open log file stay untouched.
+	 */
+	void apply_phase_intervals(unsigned divider);
+
+	LogPhase					_log_phase = LogPhase::GROUND;
+	hrt_abstime					_airborne_time = 0; ///< when the vehicle last became airborne
+
+	/* in-flight perf counter snapshots (SDLOG_PERF_INT) */
+	static constexpr int PERF_SNAPSHOT_MAX_COUNTERS = 160;
+
+	struct PerfSnapshotEntry {
+		perf_counter_t handle;
+		uint64_t event_count; ///< count at the last snapshot
+	};
+
+	PerfSnapshotEntry				*_perf_snapshot_state = nullptr; ///< lazily allocated on the first snapshot
+	int						_perf_snapshot_used = 0;
+	hrt_abstime					_next_perf_snapshot = 0;
+	uint32_t					_perf_snapshot_interval = 0; ///< us, 0 = disabled
+
 	// control
 	param_t _sdlog_profile_handle;
+	param_t _sdlog_phase_en_handle;
+	param_t _sdlog_phase_div_handle;
+	param_t _sdlog_perf_int_handle;
 };
 
 } //namespace logger
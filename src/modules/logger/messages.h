@@ -43,8 +43,11 @@ enum class ULogMessageType : uint8_t {
 	REMOVE_LOGGED_MSG = 'R',
 	SYNC = 'S',
 	DROPOUT = 'O',
+	DROPOUT_COUNTS = 'o',
 	LOGGING = 'L',
 	FLAG_BITS = 'B',
+	DATA_DELTA = 'X',
+	DATA_BATCH = 'd',
 };
 
 
@@ -100,6 +103,25 @@ struct ulog_message_dropout_s {
 	uint16_t duration; //in ms
 };
 
+struct ulog_dropout_count_entry_s {
+	uint16_t msg_id; ///< 0xffff: drops that did not fit into the table, summed up
+	uint16_t count;
+};
+
+/**
+ * Drop accounting for one dropout window, written right after the DROPOUT
+ * message once the write buffer has room again: one (msg_id, count) entry per
+ * logged message that lost samples during the dropout. Only written if
+ * ULOG_COMPAT_FLAG0_DROPOUT_COUNTS_MASK is set in the header, so that tools
+ * and replay can reconstruct exactly which samples are missing.
+ */
+struct ulog_message_dropout_counts_s {
+	uint16_t msg_size; //size of message - ULOG_MSG_HEADER_LEN
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::DROPOUT_COUNTS);
+
+	ulog_dropout_count_entry_s entries[16];
+};
+
 struct ulog_message_data_header_s {
 	uint16_t msg_size; //size of message - ULOG_MSG_HEADER_LEN
 	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::DATA);
@@ -107,6 +129,42 @@ struct ulog_message_data_header_s {
 	uint16_t msg_id;
 };
 
+/**
+ * Delta-coded data message, only used for mavlink streaming (negotiated via the
+ * requested format in MAV_CMD_LOGGING_START, it never appears in log files).
+ * The header is the same as for a DATA message, but the payload is run-length
+ * coded against the previous sample of the same msg_id: a sequence of blocks
+ * (uint8_t unchanged_count, uint8_t changed_count, changed bytes...), where
+ * the changed bytes are XOR'ed with the previous sample. Bytes after the last
+ * block are unchanged. A receiver reconstructs the sample from the previous
+ * one, which is re-sent as a regular DATA message at fixed intervals so that a
+ * lost message does not corrupt the stream permanently.
+ */
+struct ulog_message_data_delta_header_s {
+	uint16_t msg_size; //size of message - ULOG_MSG_HEADER_LEN
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::DATA_DELTA);
+
+	uint16_t msg_id;
+};
+
+/**
+ * Batched data message (third column in logger_topics.txt): several
+ * consecutive samples of one subscription packed into a single record. The
+ * payload is num_samples samples in regular DATA payload layout (including
+ * their timestamp fields) back to back, so the sample size follows from
+ * (msg_size + ULOG_MSG_HEADER_LEN - sizeof(header)) / num_samples. This cuts
+ * the per-sample framing bytes and writer transactions for fixed-rate topics
+ * and keeps same-topic samples contiguous for columnar post-processing.
+ * Readers that do not know the type skip the record via msg_size.
+ */
+struct ulog_message_data_batch_header_s {
+	uint16_t msg_size; //size of message - ULOG_MSG_HEADER_LEN
+	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::DATA_BATCH);
+
+	uint16_t msg_id;
+	uint8_t num_samples;
+};
+
 struct ulog_message_info_header_s {
 	uint16_t msg_size; //size of message - ULOG_MSG_HEADER_LEN
 	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::INFO);
@@ -144,6 +202,8 @@ struct ulog_message_parameter_header_s {
 
 #define ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK (1<<0)
 
+#define ULOG_COMPAT_FLAG0_DROPOUT_COUNTS_MASK (1<<0)
+
 struct ulog_message_flag_bits_s {
 	uint16_t msg_size;
 	uint8_t msg_type = static_cast<uint8_t>(ULogMessageType::FLAG_BITS);
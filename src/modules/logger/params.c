@@ -86,6 +86,53 @@ PARAM_DEFINE_INT32(SDLOG_MODE, 0);
  */
 PARAM_DEFINE_INT32(SDLOG_PROFILE, 0);
 
+/**
+ * Enable flight-phase driven logging rates
+ *
+ * When enabled, the per-topic logging intervals are scaled by the flight
+ * phase: takeoff and landing log at the configured maximum rates, while
+ * in cruise and on the ground the intervals are multiplied by
+ * SDLOG_PH_DIV. The topic set and the log file are not affected.
+ *
+ * This parameter is only for the new logger (SYS_LOGGER=1).
+ *
+ * @boolean
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_PH_EN, 0);
+
+/**
+ * Logging rate divider in cruise and on the ground
+ *
+ * Only used with SDLOG_PH_EN enabled: per-topic logging intervals are
+ * multiplied by this value outside of takeoff and landing.
+ *
+ * @min 1
+ * @max 32
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_PH_DIV, 4);
+
+/**
+ * In-flight perf counter snapshot interval
+ *
+ * When set, the logger writes a snapshot of all performance counters
+ * into the log at this interval while logging is active. Counters that
+ * did not change since the previous snapshot are skipped, so the
+ * timeline stays compact. Set to 0 to only log counters at log start
+ * and stop.
+ *
+ * This parameter is only for the new logger (SYS_LOGGER=1).
+ *
+ * @unit s
+ * @min 0
+ * @max 60
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_PERF_INT, 0);
+
 /**
  * Maximum number of log directories to keep
  *
@@ -105,6 +152,110 @@ PARAM_DEFINE_INT32(SDLOG_PROFILE, 0);
  */
 PARAM_DEFINE_INT32(SDLOG_DIRS_MAX, 0);
 
+/**
+ * Log Output Mode
+ *
+ * Selects how the logging data is written to the file.
+ *
+ * Compression reduces the I/O bandwidth to the SD card at the cost of some
+ * CPU time; the resulting file needs to be decompressed by the log conversion
+ * tools before use. The memory-mapped mode is only available on POSIX builds
+ * and falls back to regular writes elsewhere.
+ *
+ * @value 0 uncompressed write()
+ * @value 1 LZ4-compressed write()
+ * @value 2 uncompressed memory-mapped
+ * @value 3 LZ4-compressed memory-mapped
+ * @min 0
+ * @max 3
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_OUTPUT, 0);
+
+/**
+ * Preallocated log file size
+ *
+ * If greater than 0, the logger reserves this much file space when opening a
+ * log file, writes into it sequentially and trims the unused part when
+ * closing. This avoids filesystem metadata updates while logging, which on
+ * FAT cause periodic write stalls (visible as dropout bursts on slow SD
+ * cards). Logs exceeding the reservation grow the file as before.
+ *
+ * @unit MB
+ * @min 0
+ * @max 1024
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_PREALLOC, 0);
+
+/**
+ * Log file rotation interval
+ *
+ * If greater than 0, start a new log file after this many minutes of
+ * continuous logging. The next file is preopened and its definition section
+ * written while the current file is still being drained, so no data is lost
+ * during the switch (except in the compressed and memory-mapped output
+ * modes, which fall back to a regular stop/start).
+ *
+ * @unit min
+ * @min 0
+ * @max 1440
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_ROT_MIN, 0);
+
+/**
+ * Pre-arm logging ring buffer size
+ *
+ * If greater than 0, the logger keeps the most recent data messages in a RAM
+ * ring buffer of this size while no log file is open, and writes them to the
+ * head of the next log file. A log started on arming then begins with the
+ * moments leading up to it (pre-arm sensor data, parameter changes, setup
+ * steps) without paying continuous SD bandwidth on the ground. Sized in kB;
+ * boards with little RAM should use a few tens of kB, on POSIX a few hundred
+ * are fine.
+ *
+ * @unit kB
+ * @min 0
+ * @max 512
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_PREARM, 0);
+
+/**
+ * Log dropout accounting
+ *
+ * If set to 1, the logger counts the samples lost per message during each
+ * write buffer dropout and writes a summary message when the dropout ends.
+ * This is advertised in the log header, so tools and replay can reconstruct
+ * exactly which samples are missing instead of only knowing the dropout
+ * duration.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_DROP_CNT, 0);
+
+/**
+ * Write a legacy sdlog2 log alongside the ULog file
+ *
+ * If set to 1, the file backend additionally writes a .px4log file in the
+ * legacy sdlog2 binary format next to the ULog file, fed from the same
+ * subscription stream. Only the topics with a legacy mapping are included.
+ * This avoids a post-flight conversion pass for tools that still consume
+ * the old format.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_LEGACY, 0);
+
 /**
  * Log UUID
  *
@@ -45,11 +45,16 @@
 #include "mavlink_main.h"
 #include "mavlink_tests/mavlink_ftp_test.h"
 
+#include <systemlib/param/param.h>
+#include <logger/log_compressor.h>
+
 // Uncomment the line below to get better debug output. Never commit with this left on.
 //#define MAVLINK_FTP_DEBUG
 
 
 constexpr const char MavlinkFTP::_root_dir[];
+const char MavlinkFTP::kParamPackPath[] = "@PARAM/param.pck";
+const char MavlinkFTP::kParamPackTempPath[] = PX4_ROOTFSDIR"/fs/microsd/.param.pck";
 
 MavlinkFTP::MavlinkFTP(Mavlink *mavlink) :
 	_session_info{},
@@ -74,6 +79,10 @@ MavlinkFTP::~MavlinkFTP()
 		delete[] _work_buffer2;
 	}
 
+	if (_session_info.read_ahead) {
+		delete[] _session_info.read_ahead;
+	}
+
 }
 
 unsigned
@@ -483,8 +492,20 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 		return kErrNoSessionsAvailable;
 	}
 
-	strncpy(_work_buffer1, _root_dir, _work_buffer1_len);
-	strncpy(_work_buffer1 + _root_dir_len, _data_as_cstring(payload), _work_buffer1_len - _root_dir_len);
+	if (oflag == O_RDONLY && strcmp(_data_as_cstring(payload), kParamPackPath) == 0) {
+		// virtual file: pack the current parameter set and serve the result
+		ErrorCode errorCode = _generate_param_pack(kParamPackTempPath);
+
+		if (errorCode != kErrNone) {
+			return errorCode;
+		}
+
+		strncpy(_work_buffer1, kParamPackTempPath, _work_buffer1_len);
+
+	} else {
+		strncpy(_work_buffer1, _root_dir, _work_buffer1_len);
+		strncpy(_work_buffer1 + _root_dir_len, _data_as_cstring(payload), _work_buffer1_len - _root_dir_len);
+	}
 
 #ifdef MAVLINK_FTP_DEBUG
 	warnx("FTP: open '%s'", _work_buffer1);
@@ -515,6 +536,7 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 	_session_info.fd = fd;
 	_session_info.file_size = fileSize;
 	_session_info.stream_download = false;
+	_session_info.read_ahead_length = 0;
 
 	payload->session = 0;
 	payload->size = sizeof(uint32_t);
@@ -541,12 +563,7 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 		return kErrEOF;
 	}
 
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-		PX4_ERR("seek fail");
-		return kErrFailErrno;
-	}
-
-	int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+	int bytes_read = _cached_read(&payload->data[0], payload->offset, kMaxDataLength);
 
 	if (bytes_read < 0) {
 		// Negative return indicates error other than eof
@@ -559,6 +576,50 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 	return kErrNone;
 }
 
+/// @brief Serves session file reads from the read-ahead cache
+int
+MavlinkFTP::_cached_read(uint8_t *buf, uint32_t offset, unsigned length)
+{
+	// the cache is allocated lazily: plain command traffic never pays for it
+	if (_session_info.read_ahead == nullptr) {
+		_session_info.read_ahead = new uint8_t[kReadAheadSize];
+		_session_info.read_ahead_length = 0;
+
+		if (_session_info.read_ahead == nullptr) {
+			// not enough memory for the cache, fall back to a direct read
+			if (lseek(_session_info.fd, offset, SEEK_SET) < 0) {
+				return -1;
+			}
+
+			return ::read(_session_info.fd, buf, length);
+		}
+	}
+
+	if (offset < _session_info.read_ahead_offset
+	    || offset >= _session_info.read_ahead_offset + _session_info.read_ahead_length) {
+		// cache miss: refill with one large sequential read
+		if (lseek(_session_info.fd, offset, SEEK_SET) < 0) {
+			return -1;
+		}
+
+		int result = ::read(_session_info.fd, _session_info.read_ahead, kReadAheadSize);
+
+		if (result < 0) {
+			_session_info.read_ahead_length = 0;
+			return -1;
+		}
+
+		_session_info.read_ahead_offset = offset;
+		_session_info.read_ahead_length = result;
+	}
+
+	unsigned cached = _session_info.read_ahead_offset + _session_info.read_ahead_length - offset;
+	unsigned count = (length < cached) ? length : cached;
+	memcpy(buf, _session_info.read_ahead + (offset - _session_info.read_ahead_offset), count);
+
+	return count;
+}
+
 /// @brief Responds to a Stream command
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id)
@@ -594,6 +655,9 @@ MavlinkFTP::_workWrite(PayloadHeader *payload)
 		return kErrFailErrno;
 	}
 
+	// the write may overlap cached data
+	_session_info.read_ahead_length = 0;
+
 	int bytes_written = ::write(_session_info.fd, &payload->data[0], payload->size);
 
 	if (bytes_written < 0) {
@@ -732,6 +796,12 @@ MavlinkFTP::_workTerminate(PayloadHeader *payload)
 	_session_info.fd = -1;
 	_session_info.stream_download = false;
 
+	if (_session_info.read_ahead) {
+		delete[] _session_info.read_ahead;
+		_session_info.read_ahead = nullptr;
+		_session_info.read_ahead_length = 0;
+	}
+
 	payload->size = 0;
 
 	return kErrNone;
@@ -747,6 +817,12 @@ MavlinkFTP::_workReset(PayloadHeader *payload)
 		_session_info.stream_download = false;
 	}
 
+	if (_session_info.read_ahead) {
+		delete[] _session_info.read_ahead;
+		_session_info.read_ahead = nullptr;
+		_session_info.read_ahead_length = 0;
+	}
+
 	payload->size = 0;
 
 	return kErrNone;
@@ -872,6 +948,103 @@ MavlinkFTP::_data_as_cstring(PayloadHeader *payload)
 	return (char *) & (payload->data[0]);
 }
 
+/// @brief Pack all parameters into a file, see kParamPackPath for the format
+MavlinkFTP::ErrorCode
+MavlinkFTP::_generate_param_pack(const char *dst_path)
+{
+	int fd = ::open(dst_path, O_CREAT | O_TRUNC | O_WRONLY
+#ifdef __PX4_POSIX
+			, 0666
+#endif
+		       );
+
+	if (fd < 0) {
+		return kErrFailErrno;
+	}
+
+	/* one uncompressed block plus the worst-case compressed output */
+	uint8_t *buffer = new uint8_t[px4::logger::LogCompressor::max_block_size +
+						    px4::logger::LogCompressor::max_output_size];
+
+	if (buffer == nullptr) {
+		::close(fd);
+		::unlink(dst_path);
+		return kErrFailErrno;
+	}
+
+	uint8_t *block = buffer;
+	uint8_t *out = buffer + px4::logger::LogCompressor::max_block_size;
+
+	struct {
+		uint8_t magic[4];
+		uint32_t hash;
+		uint16_t num_params;
+		uint16_t flags;
+	} header;
+
+	memcpy(header.magic, "PCK1", 4);
+	header.hash = param_hash_check();
+	header.num_params = 0;
+	header.flags = 1; /* LZ4 block stream payload */
+
+	bool failed = (::write(fd, &header, sizeof(header)) != sizeof(header));
+
+	px4::logger::LogCompressor compressor;
+	size_t fill = 0;
+
+	for (unsigned i = 0; i < param_count() && !failed; i++) {
+		param_t param = param_for_index(i);
+		param_type_t type = param_type(param);
+
+		if (type != PARAM_TYPE_INT32 && type != PARAM_TYPE_FLOAT) {
+			/* struct parameters are not part of the sync */
+			continue;
+		}
+
+		const char *name = param_name(param);
+		size_t name_len = strlen(name);
+
+		if (fill + name_len + 6 > px4::logger::LogCompressor::max_block_size) {
+			size_t out_size = compressor.compress_block(block, fill, out);
+			failed = (::write(fd, out, out_size) != (ssize_t)out_size);
+			fill = 0;
+		}
+
+		block[fill++] = (uint8_t)name_len;
+		memcpy(&block[fill], name, name_len);
+		fill += name_len;
+		block[fill++] = (uint8_t)type;
+
+		if (param_get(param, &block[fill]) != 0) {
+			memset(&block[fill], 0, 4);
+		}
+
+		fill += 4;
+		++header.num_params;
+	}
+
+	if (!failed && fill > 0) {
+		size_t out_size = compressor.compress_block(block, fill, out);
+		failed = (::write(fd, out, out_size) != (ssize_t)out_size);
+	}
+
+	/* the parameter count is only known now, patch the header */
+	if (!failed) {
+		failed = (::lseek(fd, 0, SEEK_SET) < 0) ||
+			 (::write(fd, &header, sizeof(header)) != sizeof(header));
+	}
+
+	delete[] buffer;
+	::close(fd);
+
+	if (failed) {
+		::unlink(dst_path);
+		return kErrFailErrno;
+	}
+
+	return kErrNone;
+}
+
 /// @brief Copy file (with limited space)
 int
 MavlinkFTP::_copy_file(const char *src_path, const char *dst_path, size_t length)
@@ -1001,16 +1174,7 @@ void MavlinkFTP::send(const hrt_abstime t)
 		}
 
 		if (error_code == kErrNone) {
-			if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-				error_code = kErrFailErrno;
-#ifdef MAVLINK_FTP_DEBUG
-				warnx("stream download: seek fail");
-#endif
-			}
-		}
-
-		if (error_code == kErrNone) {
-			int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+			int bytes_read = _cached_read(&payload->data[0], payload->offset, kMaxDataLength);
 
 			if (bytes_read < 0) {
 				// Negative return indicates error other than eof
@@ -129,6 +129,13 @@ private:
 	void		_reply(mavlink_file_transfer_protocol_t *ftp_req);
 	int		_copy_file(const char *src_path, const char *dst_path, size_t length);
 
+	/**
+	 * Pack the current parameter set into dst_path (see kParamPackPath for
+	 * the file format), so that a ground station can bulk-fetch all
+	 * parameters in one FTP download instead of one PARAM_VALUE at a time.
+	 */
+	ErrorCode	_generate_param_pack(const char *dst_path);
+
 	ErrorCode	_workList(PayloadHeader *payload, bool list_hidden = false);
 	ErrorCode	_workOpen(PayloadHeader *payload, int oflag);
 	ErrorCode	_workRead(PayloadHeader *payload);
@@ -153,6 +160,25 @@ private:
 	 */
 	bool _ensure_buffers_exist();
 
+	/**
+	 * read session file data through the read-ahead cache, refilling it with
+	 * one large sequential read on a miss
+	 * @return number of bytes copied to buf, or -1 on read error (errno set)
+	 */
+	int _cached_read(uint8_t *buf, uint32_t offset, unsigned length);
+
+	/// @brief Virtual file for the bulk parameter sync: opening it for reading
+	/// generates a packed dump of all parameters. The file starts with a
+	/// 12 byte header (magic "PCK1", uint32_t hash as in param_hash_check(),
+	/// uint16_t parameter count, uint16_t flags, bit 0: LZ4 block stream),
+	/// followed by the compressed entries (uint8_t name length, name,
+	/// uint8_t type, 4 byte value). Clients check the hash against their
+	/// cache first and only download the payload on a mismatch.
+	static const char	kParamPackPath[];
+
+	/// @brief Where the generated parameter dump is staged
+	static const char	kParamPackTempPath[];
+
 	static const char	kDirentFile = 'F';	///< Identifies File returned from List command
 	static const char	kDirentDir = 'D';	///< Identifies Directory returned from List command
 	static const char	kDirentSkip = 'S';	///< Identifies Skipped entry from List command
@@ -160,6 +186,11 @@ private:
 	/// @brief Maximum data size in RequestHeader::data
 	static const uint8_t	kMaxDataLength = MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN - sizeof(PayloadHeader);
 
+	/// @brief Size of the session read-ahead cache. One SD read fills it, then
+	/// many read/burst chunks are served from memory, so downloads are no longer
+	/// bound by one small media read per packet.
+	static const unsigned	kReadAheadSize = 4096;
+
 	struct SessionInfo {
 		int		fd;
 		uint32_t	file_size;
@@ -168,6 +199,9 @@ private:
 		uint16_t	stream_seq_number;
 		uint8_t		stream_target_system_id;
 		unsigned	stream_chunk_transmitted;
+		uint8_t		*read_ahead;		///< read-ahead cache, allocated on first read
+		uint32_t	read_ahead_offset;	///< file offset of the first cached byte
+		unsigned	read_ahead_length;	///< number of valid bytes in the cache
 	};
 	struct SessionInfo _session_info;	///< Session info, fd=-1 for no active session
 
@@ -189,6 +189,7 @@ mavlink_message_t *mavlink_get_channel_buffer(uint8_t channel)
 static void usage();
 
 bool Mavlink::_boot_complete = false;
+mavlink_signing_streams_t Mavlink::_signing_streams = {};
 bool Mavlink::_config_link_on = false;
 
 Mavlink::Mavlink() :
@@ -210,9 +211,21 @@ Mavlink::Mavlink() :
 	_main_loop_delay(1000),
 	_subscriptions(nullptr),
 	_streams(nullptr),
+	_stream_heap(nullptr),
+	_stream_heap_key(nullptr),
+	_stream_heap_capacity(0),
+	_stream_heap_count(0),
+	_streams_changed(true),
+	_stream_heap_rate_mult(1.0f),
+	_arena(nullptr),
+	_arena_used(0),
+	_arena_full_warned(false),
 	_mavlink_shell(nullptr),
 	_mavlink_ulog(nullptr),
 	_mavlink_ulog_stop_requested(false),
+	_fast_ack_sent_command(0),
+	_fast_ack_sent_time(0),
+	_receiver(nullptr),
 	_mode(MAVLINK_MODE_NORMAL),
 	_channel(MAVLINK_COMM_0),
 	_radio_id(0),
@@ -222,6 +235,8 @@ Mavlink::Mavlink() :
 	_verbose(false),
 	_forwarding_on(false),
 	_ftp_on(false),
+	_signing_on(false),
+	_signing{},
 	_uart_fd(-1),
 	_baudrate(57600),
 	_datarate(1000),
@@ -256,6 +271,11 @@ Mavlink::Mavlink() :
 	_broadcast_failed_warned(false),
 	_network_buf{},
 	_network_buf_len(0),
+	_udp_pending_buf{},
+	_udp_pending_len{},
+	_udp_pending_count(0),
+	_udp_first_pending_time(0),
+	_udp_aggregation_window(0),
 #endif
 	_socket_fd(-1),
 	_protocol(SERIAL),
@@ -351,6 +371,39 @@ Mavlink::~Mavlink()
 			}
 		} while (_task_running);
 	}
+
+	free(_arena);
+}
+
+void
+Mavlink::setup_signing(const uint8_t secret_key[32], uint64_t initial_timestamp)
+{
+	if (!_signing_on) {
+		return;
+	}
+
+	memcpy(_signing.secret_key, secret_key, sizeof(_signing.secret_key));
+	_signing.link_id = (uint8_t)_instance_id;
+	_signing.timestamp = initial_timestamp;
+	_signing.flags = MAVLINK_SIGNING_FLAG_SIGN_OUTGOING;
+	_signing.accept_unsigned_callback = &Mavlink::accept_unsigned_callback;
+
+	/* signatures only exist in MAVLink 2 framing */
+	set_proto_version(2);
+
+	_mavlink_status.signing = &_signing;
+	_mavlink_status.signing_streams = &_signing_streams;
+
+	PX4_INFO("instance #%u: message signing enabled", _instance_id);
+}
+
+bool
+Mavlink::accept_unsigned_callback(const mavlink_status_t *status, uint32_t message_id)
+{
+	/* signing authenticates our outgoing telemetry; incoming traffic stays
+	 * accepted unsigned so a lost or mismatched key cannot lock the
+	 * operator out of the vehicle */
+	return true;
 }
 
 void
@@ -979,36 +1032,22 @@ Mavlink::send_packet()
 
 	if (get_protocol() == UDP) {
 
+		/* queue the finished datagram; it goes out with the next flush */
+		memcpy(_udp_pending_buf[_udp_pending_count], _network_buf, _network_buf_len);
+		_udp_pending_len[_udp_pending_count] = _network_buf_len;
 
-		ret = sendto(_socket_fd, _network_buf, _network_buf_len, 0,
-			     (struct sockaddr *)&_src_addr, sizeof(_src_addr));
-
-		struct telemetry_status_s &tstatus = get_rx_status();
-
-		/* resend message via broadcast if no valid connection exists */
-		if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
-		    (!get_client_source_initialized()
-		     || (hrt_elapsed_time(&tstatus.heartbeat_time) > 3 * 1000 * 1000))) {
-
-			if (!_broadcast_address_found) {
-				find_broadcast_address();
-			}
-
-			if (_broadcast_address_found && _network_buf_len > 0) {
-
-				int bret = sendto(_socket_fd, _network_buf, _network_buf_len, 0,
-						  (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
+		if (_udp_pending_count == 0) {
+			_udp_first_pending_time = hrt_absolute_time();
+		}
 
-				if (bret <= 0) {
-					if (!_broadcast_failed_warned) {
-						PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
-						_broadcast_failed_warned = true;
-					}
+		_udp_pending_count++;
+		ret = _network_buf_len;
 
-				} else {
-					_broadcast_failed_warned = false;
-				}
-			}
+		/* flush right away unless an aggregation window is configured, and
+		 * always before the queue would overflow */
+		if (_udp_aggregation_window == 0 || _udp_pending_count == UDP_SEND_BATCH_MAX
+		    || hrt_elapsed_time(&_udp_first_pending_time) >= _udp_aggregation_window) {
+			udp_send_pending();
 		}
 
 	} else if (get_protocol() == TCP) {
@@ -1023,6 +1062,91 @@ Mavlink::send_packet()
 	return ret;
 }
 
+#ifdef __PX4_POSIX
+void
+Mavlink::udp_send_pending()
+{
+	if (_udp_pending_count == 0) {
+		return;
+	}
+
+	struct telemetry_status_s &tstatus = get_rx_status();
+
+	/* resend messages via broadcast if no valid connection exists (same
+	 * policy as the previous per-packet path) */
+	bool send_bcast = (_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
+			  (!get_client_source_initialized()
+			   || (hrt_elapsed_time(&tstatus.heartbeat_time) > 3 * 1000 * 1000));
+
+	if (send_bcast && !_broadcast_address_found) {
+		find_broadcast_address();
+	}
+
+#if defined(__PX4_LINUX)
+	/* one syscall for the whole burst */
+	struct mmsghdr msgvec[UDP_SEND_BATCH_MAX] {};
+	struct iovec iovecs[UDP_SEND_BATCH_MAX];
+
+	for (unsigned i = 0; i < _udp_pending_count; i++) {
+		iovecs[i].iov_base = _udp_pending_buf[i];
+		iovecs[i].iov_len = _udp_pending_len[i];
+		msgvec[i].msg_hdr.msg_iov = &iovecs[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+		msgvec[i].msg_hdr.msg_name = &_src_addr;
+		msgvec[i].msg_hdr.msg_namelen = sizeof(_src_addr);
+	}
+
+	sendmmsg(_socket_fd, msgvec, _udp_pending_count, 0);
+
+	if (send_bcast && _broadcast_address_found) {
+		for (unsigned i = 0; i < _udp_pending_count; i++) {
+			msgvec[i].msg_hdr.msg_name = &_bcast_addr;
+			msgvec[i].msg_hdr.msg_namelen = sizeof(_bcast_addr);
+		}
+
+		int bret = sendmmsg(_socket_fd, msgvec, _udp_pending_count, 0);
+
+		if (bret <= 0) {
+			if (!_broadcast_failed_warned) {
+				PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
+				_broadcast_failed_warned = true;
+			}
+
+		} else {
+			_broadcast_failed_warned = false;
+		}
+	}
+
+#else
+
+	for (unsigned i = 0; i < _udp_pending_count; i++) {
+		sendto(_socket_fd, _udp_pending_buf[i], _udp_pending_len[i], 0,
+		       (struct sockaddr *)&_src_addr, sizeof(_src_addr));
+	}
+
+	if (send_bcast && _broadcast_address_found) {
+		for (unsigned i = 0; i < _udp_pending_count; i++) {
+			int bret = sendto(_socket_fd, _udp_pending_buf[i], _udp_pending_len[i], 0,
+					  (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
+
+			if (bret <= 0) {
+				if (!_broadcast_failed_warned) {
+					PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
+					_broadcast_failed_warned = true;
+				}
+
+			} else {
+				_broadcast_failed_warned = false;
+			}
+		}
+	}
+
+#endif /* __PX4_LINUX */
+
+	_udp_pending_count = 0;
+}
+#endif /* __PX4_POSIX */
+
 void
 Mavlink::send_bytes(const uint8_t *buf, unsigned packet_len)
 {
@@ -1363,6 +1487,56 @@ void Mavlink::send_protocol_version()
 	set_proto_version(curr_proto_ver);
 }
 
+void *
+Mavlink::instance_alloc(size_t size)
+{
+	if (_arena == nullptr) {
+		_arena = (uint8_t *)malloc(ARENA_SIZE);
+		_arena_used = 0;
+	}
+
+	/* one header word tags the block so instance_free() can tell arena blocks
+	 * from heap fallback blocks; its size also keeps the payload aligned */
+	const size_t block_size = (sizeof(uint64_t) + size + 7) & ~(size_t)7;
+
+	if (_arena != nullptr && _arena_used + block_size <= ARENA_SIZE) {
+		uint32_t *header = (uint32_t *)(_arena + _arena_used);
+		_arena_used += block_size;
+		*header = ARENA_BLOCK_MAGIC;
+		return header + 2;
+	}
+
+	if (!_arena_full_warned) {
+		PX4_WARN("instance arena full, falling back to heap");
+		_arena_full_warned = true;
+	}
+
+	uint32_t *header = (uint32_t *)malloc(sizeof(uint64_t) + size);
+
+	if (header == nullptr) {
+		return nullptr;
+	}
+
+	*header = HEAP_BLOCK_MAGIC;
+	return header + 2;
+}
+
+void
+Mavlink::instance_free(void *ptr)
+{
+	if (ptr == nullptr) {
+		return;
+	}
+
+	uint32_t *header = (uint32_t *)ptr - 2;
+
+	if (*header == HEAP_BLOCK_MAGIC) {
+		free(header);
+	}
+
+	/* arena blocks are reclaimed wholesale when the instance shuts down */
+}
+
 MavlinkOrbSubscription *Mavlink::add_orb_subscription(const orb_id_t topic, int instance)
 {
 	/* check if already subscribed to this topic */
@@ -1376,7 +1550,7 @@ MavlinkOrbSubscription *Mavlink::add_orb_subscription(const orb_id_t topic, int
 	}
 
 	/* add new subscription */
-	MavlinkOrbSubscription *sub_new = new MavlinkOrbSubscription(topic, instance);
+	MavlinkOrbSubscription *sub_new = new (this) MavlinkOrbSubscription(topic, instance);
 
 	LL_APPEND(_subscriptions, sub_new);
 
@@ -1417,6 +1591,8 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 				delete stream;
 			}
 
+			_streams_changed = true;
+
 			return OK;
 		}
 	}
@@ -1435,6 +1611,8 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 			stream->set_interval(interval);
 			LL_APPEND(_streams, stream);
 
+			_streams_changed = true;
+
 			return OK;
 		}
 	}
@@ -1445,6 +1623,115 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 	return PX4_ERROR;
 }
 
+void
+Mavlink::rebuild_stream_heap()
+{
+	/* count the streams */
+	unsigned count = 0;
+	MavlinkStream *stream;
+	LL_FOREACH(_streams, stream) {
+		++count;
+	}
+
+	if (count > _stream_heap_capacity) {
+		delete[] _stream_heap;
+		delete[] _stream_heap_key;
+		_stream_heap = new MavlinkStream *[count];
+		_stream_heap_key = new hrt_abstime[count];
+
+		if (_stream_heap == nullptr || _stream_heap_key == nullptr) {
+			delete[] _stream_heap;
+			delete[] _stream_heap_key;
+			_stream_heap = nullptr;
+			_stream_heap_key = nullptr;
+			_stream_heap_capacity = 0;
+			_stream_heap_count = 0;
+			return;
+		}
+
+		_stream_heap_capacity = count;
+	}
+
+	_stream_heap_count = 0;
+	LL_FOREACH(_streams, stream) {
+		_stream_heap[_stream_heap_count] = stream;
+		_stream_heap_key[_stream_heap_count] = stream->get_next_due();
+		++_stream_heap_count;
+	}
+
+	/* heapify (Floyd) */
+	for (int i = (int)_stream_heap_count / 2 - 1; i >= 0; --i) {
+		stream_heap_sift_down(i);
+	}
+
+	_stream_heap_rate_mult = get_rate_mult();
+	_streams_changed = false;
+}
+
+void
+Mavlink::stream_heap_sift_down(unsigned index)
+{
+	while (true) {
+		unsigned smallest = index;
+		unsigned left = 2 * index + 1;
+		unsigned right = 2 * index + 2;
+
+		if (left < _stream_heap_count && _stream_heap_key[left] < _stream_heap_key[smallest]) {
+			smallest = left;
+		}
+
+		if (right < _stream_heap_count && _stream_heap_key[right] < _stream_heap_key[smallest]) {
+			smallest = right;
+		}
+
+		if (smallest == index) {
+			break;
+		}
+
+		MavlinkStream *tmp_stream = _stream_heap[index];
+		_stream_heap[index] = _stream_heap[smallest];
+		_stream_heap[smallest] = tmp_stream;
+
+		hrt_abstime tmp_key = _stream_heap_key[index];
+		_stream_heap_key[index] = _stream_heap_key[smallest];
+		_stream_heap_key[smallest] = tmp_key;
+
+		index = smallest;
+	}
+}
+
+void
+Mavlink::update_streams(const hrt_abstime t)
+{
+	const float rate_mult = get_rate_mult();
+
+	/* the deadlines scale with the rate multiplier, so re-key the heap when
+	 * it moved notably (or when streams were added/removed/re-configured) */
+	if (_streams_changed
+	    || fabsf(rate_mult - _stream_heap_rate_mult) > 0.1f * _stream_heap_rate_mult) {
+		rebuild_stream_heap();
+	}
+
+	/* pop-less earliest-deadline-first: keep serving the root while it is
+	 * due, re-sinking it with its new deadline after each attempt */
+	while (_stream_heap_count > 0 && _stream_heap_key[0] <= t) {
+		MavlinkStream *stream = _stream_heap[0];
+
+		stream->update(t);
+		hrt_abstime new_key = stream->get_next_due();
+
+		/* serve each stream at most once per iteration (matches the previous
+		 * list walk for unlimited-rate streams, and avoids spinning when a
+		 * send failed, e.g. on a full tx buffer) */
+		if (new_key <= t) {
+			new_key = t + 1;
+		}
+
+		_stream_heap_key[0] = new_key;
+		stream_heap_sift_down(0);
+	}
+}
+
 void
 Mavlink::adjust_stream_rates(const float multiplier)
 {
@@ -1475,6 +1762,8 @@ Mavlink::adjust_stream_rates(const float multiplier)
 			stream->set_interval(interval);
 		}
 	}
+
+	_streams_changed = true;
 }
 
 void
@@ -1538,25 +1827,6 @@ Mavlink::message_buffer_destroy()
 	free(_message_buffer.data);
 }
 
-int
-Mavlink::message_buffer_count()
-{
-	int n = _message_buffer.write_ptr - _message_buffer.read_ptr;
-
-	if (n < 0) {
-		n += _message_buffer.size;
-	}
-
-	return n;
-}
-
-int
-Mavlink::message_buffer_is_empty()
-{
-	return _message_buffer.read_ptr == _message_buffer.write_ptr;
-}
-
-
 bool
 Mavlink::message_buffer_write(const void *ptr, int size)
 {
@@ -1567,12 +1837,24 @@ Mavlink::message_buffer_write(const void *ptr, int size)
 		available += _message_buffer.size;
 	}
 
-	if (size > available) {
+	// each record carries a length prefix, so the reader can walk exact
+	// message boundaries without re-parsing the mavlink framing
+	uint16_t record_len = size;
+
+	if ((int)(size + sizeof(record_len)) > available) {
 		// buffer overflow
 		return false;
 	}
 
-	char *c = (char *) ptr;
+	message_buffer_copy_in(&record_len, sizeof(record_len));
+	message_buffer_copy_in(ptr, size);
+	return true;
+}
+
+void
+Mavlink::message_buffer_copy_in(const void *ptr, int size)
+{
+	const char *c = (const char *) ptr;
 	int n = _message_buffer.size - _message_buffer.write_ptr;	// bytes to end of the buffer
 
 	if (n < size) {
@@ -1588,6 +1870,40 @@ Mavlink::message_buffer_write(const void *ptr, int size)
 	int p = size - n;	// number of bytes to write
 	memcpy(&(_message_buffer.data[_message_buffer.write_ptr]), &(c[n]), p);
 	_message_buffer.write_ptr = (_message_buffer.write_ptr + p) % _message_buffer.size;
+}
+
+void
+Mavlink::message_buffer_copy_out(void *ptr, int size)
+{
+	char *c = (char *) ptr;
+	int n = _message_buffer.size - _message_buffer.read_ptr;	// bytes to end of the buffer
+
+	if (n < size) {
+		// record goes over end of the buffer
+		memcpy(c, &(_message_buffer.data[_message_buffer.read_ptr]), n);
+		_message_buffer.read_ptr = 0;
+
+	} else {
+		n = 0;
+	}
+
+	// now: n = bytes already read
+	int p = size - n;	// number of bytes to read
+	memcpy(&(c[n]), &(_message_buffer.data[_message_buffer.read_ptr]), p);
+	_message_buffer.read_ptr = (_message_buffer.read_ptr + p) % _message_buffer.size;
+}
+
+bool
+Mavlink::message_buffer_read_record(mavlink_message_t *msg)
+{
+	if (_message_buffer.read_ptr == _message_buffer.write_ptr) {
+		// buffer is empty
+		return false;
+	}
+
+	uint16_t record_len;
+	message_buffer_copy_out(&record_len, sizeof(record_len));
+	message_buffer_copy_out(msg, record_len);
 	return true;
 }
 
@@ -1787,7 +2103,7 @@ Mavlink::task_main(int argc, char *argv[])
 	int temp_int_arg;
 #endif
 
-	while ((ch = px4_getopt(argc, argv, "b:r:d:u:o:m:t:fvwx", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "b:r:d:u:o:m:t:z:fvwxS", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'b':
 			_baudrate = strtoul(myoptarg, nullptr, 10);
@@ -1855,12 +2171,26 @@ Mavlink::task_main(int argc, char *argv[])
 				err_flag = true;
 			}
 
+			break;
+
+		case 'z':
+			temp_int_arg = strtoul(myoptarg, &eptr, 10);
+
+			if (*eptr == '\0' && temp_int_arg <= 100000) {
+				_udp_aggregation_window = temp_int_arg;
+
+			} else {
+				PX4_ERR("invalid aggregation window '%s'", myoptarg);
+				err_flag = true;
+			}
+
 			break;
 #else
 
 		case 'u':
 		case 'o':
 		case 't':
+		case 'z':
 			PX4_ERR("UDP options not supported on this platform");
 			err_flag = true;
 			break;
@@ -1913,6 +2243,10 @@ Mavlink::task_main(int argc, char *argv[])
 			_ftp_on = true;
 			break;
 
+		case 'S':
+			_signing_on = true;
+			break;
+
 		default:
 			err_flag = true;
 			break;
@@ -2219,7 +2553,13 @@ Mavlink::task_main(int argc, char *argv[])
 				msg.target_component = command_ack.target_component;
 				current_command_ack = command_ack.command;
 
-				mavlink_msg_command_ack_send_struct(get_channel(), &msg);
+				/* skip acks the receiver already sent via the fast path */
+				bool fast_acked = (command_ack.command == _fast_ack_sent_command
+						   && hrt_absolute_time() - _fast_ack_sent_time < 2 * 1000 * 1000);
+
+				if (!fast_acked) {
+					mavlink_msg_command_ack_send_struct(get_channel(), &msg);
+				}
 			}
 		}
 
@@ -2230,15 +2570,35 @@ Mavlink::task_main(int argc, char *argv[])
 		}
 
 		/* check for shell output */
-		if (_mavlink_shell && _mavlink_shell->available() > 0) {
-			if (get_free_tx_buf() >= MAVLINK_MSG_ID_SERIAL_CONTROL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES) {
+		if (_mavlink_shell) {
+			/* push input the receiver could not write into the pipe */
+			_mavlink_shell->flush_write_buffer();
+
+			/* drain output in full chunks up to a per-iteration byte credit
+			 * (a quarter of the configured rate), so an output burst is sent
+			 * quickly without starving the telemetry streams */
+			unsigned credit = _datarate / (1000000 / MAIN_LOOP_DELAY) / 4;
+
+			if (credit < MAVLINK_MSG_SERIAL_CONTROL_FIELD_DATA_LEN) {
+				credit = MAVLINK_MSG_SERIAL_CONTROL_FIELD_DATA_LEN;
+			}
+
+			while (_mavlink_shell->available() > 0 && credit > 0
+			       && get_free_tx_buf() >= MAVLINK_MSG_ID_SERIAL_CONTROL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES) {
 				mavlink_serial_control_t msg;
 				msg.baudrate = 0;
 				msg.flags = SERIAL_CONTROL_FLAG_REPLY;
 				msg.timeout = 0;
 				msg.device = SERIAL_CONTROL_DEV_SHELL;
 				msg.count = _mavlink_shell->read(msg.data, sizeof(msg.data));
+
+				if (msg.count == 0) {
+					break;
+				}
+
 				mavlink_msg_serial_control_send_struct(get_channel(), &msg);
+
+				credit -= (credit > msg.count) ? msg.count : credit;
 			}
 		}
 
@@ -2301,56 +2661,29 @@ Mavlink::task_main(int argc, char *argv[])
 			_subscribe_to_stream = nullptr;
 		}
 
-		/* update streams */
-		MavlinkStream *stream;
-		LL_FOREACH(_streams, stream) {
-			stream->update(t);
-		}
+		/* update streams, earliest deadline first */
+		update_streams(t);
 
 		/* pass messages from other UARTs */
 		if (_forwarding_on) {
 
-			bool is_part;
-			uint8_t *read_ptr;
-			uint8_t *write_ptr;
-
-			pthread_mutex_lock(&_message_buffer_mutex);
-			int available = message_buffer_get_ptr((void **)&read_ptr, &is_part);
-			pthread_mutex_unlock(&_message_buffer_mutex);
-
-			if (available > 0) {
-				// Reconstruct message from buffer
+			/* bulk drain: forward as many queued messages as the TX buffer
+			 * accepts instead of one per loop iteration, so a high-rate
+			 * forwarded stream does not back up in the ring. Frames are
+			 * resent as stored - _mavlink_resend_uart() reuses the original
+			 * checksum, unmodified messages are not re-CRCed. */
+			while (get_free_tx_buf() >= MAVLINK_MAX_PACKET_LEN) {
 
 				mavlink_message_t msg;
-				write_ptr = (uint8_t *)&msg;
-
-				// Pull a single message from the buffer
-				size_t read_count = available;
-
-				if (read_count > sizeof(mavlink_message_t)) {
-					read_count = sizeof(mavlink_message_t);
-				}
 
-				memcpy(write_ptr, read_ptr, read_count);
-
-				// We hold the mutex until after we complete the second part of the buffer. If we don't
-				// we may end up breaking the empty slot overflow detection semantics when we mark the
-				// possibly partial read below.
 				pthread_mutex_lock(&_message_buffer_mutex);
+				bool received = message_buffer_read_record(&msg);
+				pthread_mutex_unlock(&_message_buffer_mutex);
 
-				message_buffer_mark_read(read_count);
-
-				/* write second part of buffer if there is some */
-				if (is_part && read_count < sizeof(mavlink_message_t)) {
-					write_ptr += read_count;
-					available = message_buffer_get_ptr((void **)&read_ptr, &is_part);
-					read_count = sizeof(mavlink_message_t) - read_count;
-					memcpy(write_ptr, read_ptr, read_count);
-					message_buffer_mark_read(available);
+				if (!received) {
+					break;
 				}
 
-				pthread_mutex_unlock(&_message_buffer_mutex);
-
 				resend_message(&msg);
 			}
 		}
@@ -2370,6 +2703,18 @@ Mavlink::task_main(int argc, char *argv[])
 			_bytes_timestamp = t;
 		}
 
+#ifdef __PX4_POSIX
+
+		/* flush UDP datagrams still held back by the aggregation window */
+		if (get_protocol() == UDP && _udp_pending_count > 0
+		    && hrt_elapsed_time(&_udp_first_pending_time) >= _udp_aggregation_window) {
+			pthread_mutex_lock(&_send_mutex);
+			udp_send_pending();
+			pthread_mutex_unlock(&_send_mutex);
+		}
+
+#endif
+
 		perf_end(_loop_perf);
 
 		/* confirm task running only once fully initialized */
@@ -2394,6 +2739,15 @@ Mavlink::task_main(int argc, char *argv[])
 
 	_streams = nullptr;
 
+	/* delete the stream scheduling heap */
+	delete[] _stream_heap;
+	delete[] _stream_heap_key;
+	_stream_heap = nullptr;
+	_stream_heap_key = nullptr;
+	_stream_heap_capacity = 0;
+	_stream_heap_count = 0;
+	_streams_changed = true;
+
 	/* delete subscriptions */
 	MavlinkOrbSubscription *sub_to_del = nullptr;
 	MavlinkOrbSubscription *sub_next = _subscriptions;
@@ -2406,6 +2760,12 @@ Mavlink::task_main(int argc, char *argv[])
 
 	_subscriptions = nullptr;
 
+	/* all streams and subscriptions are destroyed, release their arena wholesale */
+	free(_arena);
+	_arena = nullptr;
+	_arena_used = 0;
+	_arena_full_warned = false;
+
 	if (_uart_fd >= 0 && !_is_usb_uart) {
 		/* close UART */
 		::close(_uart_fd);
@@ -2510,6 +2870,7 @@ Mavlink::start(int argc, char *argv[])
 {
 	MavlinkULog::initialize();
 	MavlinkCommandSender::initialize();
+	MavlinkOrbSubscription::initialize_cache();
 
 	// Wait for the instance count to go up one
 	// before returning to the shell
@@ -2610,7 +2971,14 @@ Mavlink::display_status()
 		       (double)_mavlink_ulog->maximum_data_rate() * 100.);
 	}
 
+	MavlinkReceiver *receiver = _receiver;
+
+	if (receiver != nullptr) {
+		receiver->print_status();
+	}
+
 	printf("\taccepting commands: %s, FTP enabled: %s\n", accepting_commands() ? "YES" : "NO", _ftp_on ? "YES" : "NO");
+	printf("\tmessage signing: %s\n", !_signing_on ? "OFF" : (_mavlink_status.signing != nullptr ? "ACTIVE" : "waiting for key"));
 	printf("\tMAVLink version: %i\n", _protocol_version);
 
 	printf("\ttransport protocol: ");
@@ -2798,6 +3166,8 @@ $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
 	PRINT_MODULE_USAGE_PARAM_INT('o', 14550, 0, 65536, "Select UDP Network Port (remote)", true);
 	PRINT_MODULE_USAGE_PARAM_STRING('t', "127.0.0.1", nullptr,
 					"Partner IP (broadcasting can be enabled via MAV_BROADCAST param)", true);
+	PRINT_MODULE_USAGE_PARAM_INT('z', 0, 0, 100000,
+				     "UDP packet aggregation window in us (0=send each packet immediately)", true);
 #endif
 	PRINT_MODULE_USAGE_PARAM_STRING('m', "normal", "custom|camera|onboard|osd|magic|config|iridium",
 					"Mode: sets default streams and rates", true);
@@ -2805,6 +3175,7 @@ $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
 	PRINT_MODULE_USAGE_PARAM_FLAG('v', "Verbose output", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('w', "Wait to send, until first message received", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('x', "Enable FTP", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('S', "Sign outgoing messages once a key arrives via SETUP_SIGNING (MAVLink 2)", true);
 
 	PRINT_MODULE_USAGE_COMMAND_DESCR("verbose", "Set verbose mode for all running instances");
 	PRINT_MODULE_USAGE_ARG("on|off", "Enable/disable", true);
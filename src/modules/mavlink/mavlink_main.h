@@ -77,6 +77,8 @@ enum Protocol {
 	TCP,
 };
 
+class MavlinkReceiver;
+
 class Mavlink
 {
 
@@ -119,6 +121,17 @@ public:
 
 	mavlink_status_t 	*get_status() { return &_mavlink_status; }
 
+	/**
+	 * Install or refresh the MAVLink 2 signing key on this link.
+	 *
+	 * Only takes effect on links started with signing enabled (-S), so the
+	 * key distribution can stay fleet-wide while e.g. the USB link keeps
+	 * sending unsigned.
+	 */
+	void			setup_signing(const uint8_t secret_key[32], uint64_t initial_timestamp);
+
+	bool			get_signing_enabled() { return _signing_on; }
+
 	/**
 	 * Set the MAVLink version
 	 *
@@ -310,6 +323,8 @@ public:
 	 */
 	void			resend_message(mavlink_message_t *msg) { _mavlink_resend_uart(_channel, msg); }
 
+	static bool		accept_unsigned_callback(const mavlink_status_t *status, uint32_t message_id);
+
 	void			handle_message(const mavlink_message_t *msg);
 
 	MavlinkOrbSubscription *add_orb_subscription(const orb_id_t topic, int instance = 0);
@@ -377,6 +392,23 @@ public:
 
 	MavlinkStream 		*get_streams() const { return _streams; }
 
+	/**
+	 * Allocate a block for a stream or subscription object.
+	 *
+	 * Streams and subscriptions are placement-allocated from a fixed
+	 * per-instance arena instead of individually from the heap, so that
+	 * restarting a link does not fragment the heap. Falls back to the heap
+	 * when the arena is full. The arena is released wholesale when the
+	 * instance shuts down.
+	 */
+	void			*instance_alloc(size_t size);
+
+	/**
+	 * Release a block obtained from instance_alloc(). Heap fallback blocks
+	 * are freed immediately, arena blocks only with the whole arena.
+	 */
+	static void		instance_free(void *ptr);
+
 	float			get_rate_mult();
 
 	float			get_baudrate() { return _baudrate; }
@@ -473,6 +505,22 @@ public:
 		if (_mavlink_ulog) { _mavlink_ulog_stop_requested = true; }
 	}
 
+	/**
+	 * Register/unregister the receiver instance of this link so the
+	 * status output can include the receiver side.
+	 */
+	void			set_receiver(MavlinkReceiver *receiver) { _receiver = receiver; }
+
+	/**
+	 * Note that the receiver already sent the ack for this command via
+	 * the fast path, so the main loop must not send it again.
+	 */
+	void			set_fast_ack_sent(uint16_t command)
+	{
+		_fast_ack_sent_command = command;
+		_fast_ack_sent_time = hrt_absolute_time();
+	}
+
 
 	void set_uorb_main_fd(int fd, unsigned int interval);
 
@@ -508,10 +556,35 @@ private:
 	MavlinkOrbSubscription	*_subscriptions;
 	MavlinkStream		*_streams;
 
+	/* deadline-ordered stream scheduler: min-heap over the streams in
+	 * _streams, keyed by MavlinkStream::get_next_due(), so that one loop
+	 * iteration only touches the streams that are actually due */
+	MavlinkStream		**_stream_heap;
+	hrt_abstime		*_stream_heap_key;
+	unsigned		_stream_heap_capacity;
+	unsigned		_stream_heap_count;
+	bool			_streams_changed;
+	float			_stream_heap_rate_mult;
+
+	/* fixed allocation arena for streams and subscriptions (@see instance_alloc()) */
+	static constexpr size_t ARENA_SIZE = 8192;
+	static constexpr uint32_t ARENA_BLOCK_MAGIC = 0x41524e41;
+	static constexpr uint32_t HEAP_BLOCK_MAGIC = 0x48454150;
+	uint8_t			*_arena;
+	size_t			_arena_used;
+	bool			_arena_full_warned;
+
 	MavlinkShell			*_mavlink_shell;
 	MavlinkULog			*_mavlink_ulog;
 	volatile bool			_mavlink_ulog_stop_requested;
 
+	/* last command ack sent by the receiver's fast path, written from
+	 * the receive thread */
+	volatile uint16_t		_fast_ack_sent_command;
+	volatile uint64_t		_fast_ack_sent_time;
+
+	MavlinkReceiver *volatile	_receiver;	///< receiver of this link, valid while its thread runs
+
 	MAVLINK_MODE 		_mode;
 
 	mavlink_channel_t	_channel;
@@ -525,6 +598,9 @@ private:
 	bool			_verbose;
 	bool			_forwarding_on;
 	bool			_ftp_on;
+	bool			_signing_on;		/**< sign outgoing messages once a key is installed */
+	mavlink_signing_t	_signing;		/**< per-link signing state (own link id and timestamp) */
+	static mavlink_signing_streams_t _signing_streams;	/**< incoming stream timestamps, shared by all links */
 #ifndef __PX4_QURT
 	int			_uart_fd;
 #endif
@@ -572,6 +648,21 @@ private:
 	bool _broadcast_failed_warned;
 	uint8_t _network_buf[MAVLINK_MAX_PACKET_LEN];
 	unsigned _network_buf_len;
+
+	/* UDP packet coalescing: finished datagrams are queued here and flushed
+	 * in one burst (a single sendmmsg() on Linux), cutting the per-packet
+	 * syscall overhead on high-rate links (SITL, WiFi telemetry) */
+	static const unsigned UDP_SEND_BATCH_MAX = 16;
+	uint8_t _udp_pending_buf[UDP_SEND_BATCH_MAX][MAVLINK_MAX_PACKET_LEN];
+	uint16_t _udp_pending_len[UDP_SEND_BATCH_MAX];
+	unsigned _udp_pending_count;
+	hrt_abstime _udp_first_pending_time;
+	unsigned _udp_aggregation_window;	///< [us] hold packets back this long for coalescing (0: send immediately)
+
+	/**
+	 * Send all queued UDP datagrams. Call with _send_mutex held.
+	 */
+	void			udp_send_pending();
 #endif
 	int _socket_fd;
 	Protocol	_protocol;
@@ -624,6 +715,24 @@ private:
 
 	int configure_stream(const char *stream_name, const float rate = -1.0f);
 
+	/**
+	 * Update all streams that are due at time t, in earliest-deadline order.
+	 * Cost scales with the number of messages sent, not with the number of
+	 * configured streams.
+	 */
+	void update_streams(const hrt_abstime t);
+
+	/**
+	 * Rebuild the stream scheduling heap after the stream set or the rate
+	 * multiplier changed.
+	 */
+	void rebuild_stream_heap();
+
+	/**
+	 * Restore the heap property after the key of the given element changed.
+	 */
+	void stream_heap_sift_down(unsigned index);
+
 	/**
 	 * Adjust the stream rates based on the current rate
 	 *
@@ -635,13 +744,11 @@ private:
 
 	void message_buffer_destroy();
 
-	int message_buffer_count();
-
-	int message_buffer_is_empty();
+	void message_buffer_copy_in(const void *ptr, int size);
 
-	int message_buffer_get_ptr(void **ptr, bool *is_part);
+	void message_buffer_copy_out(void *ptr, int size);
 
-	void message_buffer_mark_read(int n);
+	bool message_buffer_read_record(mavlink_message_t *msg);
 
 	void pass_message(const mavlink_message_t *msg);
 
@@ -296,7 +296,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamHeartbeat(mavlink);
+		return new (mavlink) MavlinkStreamHeartbeat(mavlink);
 	}
 
 	unsigned get_size()
@@ -368,7 +368,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamStatustext(mavlink);
+		return new (mavlink) MavlinkStreamStatustext(mavlink);
 	}
 
 	unsigned get_size()
@@ -436,7 +436,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamCommandLong(mavlink);
+		return new (mavlink) MavlinkStreamCommandLong(mavlink);
 	}
 
 	unsigned get_size()
@@ -511,7 +511,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamSysStatus(mavlink);
+		return new (mavlink) MavlinkStreamSysStatus(mavlink);
 	}
 
 	unsigned get_size()
@@ -519,6 +519,11 @@ public:
 		return MAVLINK_MSG_ID_SYS_STATUS_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 	}
 
+	enum Priority priority()
+	{
+		return PRIORITY_HIGH;
+	}
+
 private:
 	MavlinkOrbSubscription *_status_sub;
 	MavlinkOrbSubscription *_cpuload_sub;
@@ -620,7 +625,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamHighresIMU(mavlink);
+		return new (mavlink) MavlinkStreamHighresIMU(mavlink);
 	}
 
 	unsigned get_size()
@@ -628,6 +633,11 @@ public:
 		return MAVLINK_MSG_ID_HIGHRES_IMU_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 	}
 
+	enum Priority priority()
+	{
+		return PRIORITY_BULK;
+	}
+
 private:
 	MavlinkOrbSubscription *_sensor_sub;
 	uint64_t _sensor_time;
@@ -743,7 +753,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamAttitude(mavlink);
+		return new (mavlink) MavlinkStreamAttitude(mavlink);
 	}
 
 	unsigned get_size()
@@ -751,6 +761,11 @@ public:
 		return MAVLINK_MSG_ID_ATTITUDE_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 	}
 
+	enum Priority priority()
+	{
+		return PRIORITY_HIGH;
+	}
+
 private:
 	MavlinkOrbSubscription *_att_sub;
 	uint64_t _att_time;
@@ -816,7 +831,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamAttitudeQuaternion(mavlink);
+		return new (mavlink) MavlinkStreamAttitudeQuaternion(mavlink);
 	}
 
 	unsigned get_size()
@@ -890,7 +905,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamVFRHUD(mavlink);
+		return new (mavlink) MavlinkStreamVFRHUD(mavlink);
 	}
 
 	unsigned get_size()
@@ -1026,7 +1041,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamGPSRawInt(mavlink);
+		return new (mavlink) MavlinkStreamGPSRawInt(mavlink);
 	}
 
 	unsigned get_size()
@@ -1105,7 +1120,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamSystemTime(mavlink);
+		return new (mavlink) MavlinkStreamSystemTime(mavlink);
 	}
 
 	unsigned get_size()
@@ -1163,7 +1178,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamTimesync(mavlink);
+		return new (mavlink) MavlinkStreamTimesync(mavlink);
 	}
 
 	unsigned get_size()
@@ -1218,7 +1233,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamADSBVehicle(mavlink);
+		return new (mavlink) MavlinkStreamADSBVehicle(mavlink);
 	}
 
 	bool const_rate()
@@ -1300,7 +1315,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamCollision(mavlink);
+		return new (mavlink) MavlinkStreamCollision(mavlink);
 	}
 
 	unsigned get_size()
@@ -1371,7 +1386,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamCameraTrigger(mavlink);
+		return new (mavlink) MavlinkStreamCameraTrigger(mavlink);
 	}
 
 	bool const_rate()
@@ -1485,7 +1500,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamCameraImageCaptured(mavlink);
+		return new (mavlink) MavlinkStreamCameraImageCaptured(mavlink);
 	}
 
 	unsigned get_size()
@@ -1564,7 +1579,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamGlobalPositionInt(mavlink);
+		return new (mavlink) MavlinkStreamGlobalPositionInt(mavlink);
 	}
 
 	unsigned get_size()
@@ -1644,7 +1659,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamVisionPositionEstimate(mavlink);
+		return new (mavlink) MavlinkStreamVisionPositionEstimate(mavlink);
 	}
 
 	unsigned get_size()
@@ -1723,7 +1738,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamLocalPositionNED(mavlink);
+		return new (mavlink) MavlinkStreamLocalPositionNED(mavlink);
 	}
 
 	unsigned get_size()
@@ -1795,7 +1810,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamLocalPositionNEDCOV(mavlink);
+		return new (mavlink) MavlinkStreamLocalPositionNEDCOV(mavlink);
 	}
 
 	unsigned get_size()
@@ -1877,7 +1892,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamEstimatorStatus(mavlink);
+		return new (mavlink) MavlinkStreamEstimatorStatus(mavlink);
 	}
 
 	unsigned get_size()
@@ -1961,7 +1976,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamAttPosMocap(mavlink);
+		return new (mavlink) MavlinkStreamAttPosMocap(mavlink);
 	}
 
 	unsigned get_size()
@@ -2034,7 +2049,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamHomePosition(mavlink);
+		return new (mavlink) MavlinkStreamHomePosition(mavlink);
 	}
 
 	unsigned get_size()
@@ -2133,7 +2148,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamServoOutputRaw<N>(mavlink);
+		return new (mavlink) MavlinkStreamServoOutputRaw<N>(mavlink);
 	}
 
 	unsigned get_size()
@@ -2141,6 +2156,11 @@ public:
 		return MAVLINK_MSG_ID_SERVO_OUTPUT_RAW_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 	}
 
+	enum Priority priority()
+	{
+		return PRIORITY_BULK;
+	}
+
 private:
 	MavlinkOrbSubscription *_act_sub;
 	uint64_t _act_time;
@@ -2222,7 +2242,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamActuatorControlTarget<N>(mavlink);
+		return new (mavlink) MavlinkStreamActuatorControlTarget<N>(mavlink);
 	}
 
 	unsigned get_size()
@@ -2313,7 +2333,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamHILControls(mavlink);
+		return new (mavlink) MavlinkStreamHILControls(mavlink);
 	}
 
 	unsigned get_size()
@@ -2478,7 +2498,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamHILActuatorControls(mavlink);
+		return new (mavlink) MavlinkStreamHILActuatorControls(mavlink);
 	}
 
 	unsigned get_size()
@@ -2638,7 +2658,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamPositionTargetGlobalInt(mavlink);
+		return new (mavlink) MavlinkStreamPositionTargetGlobalInt(mavlink);
 	}
 
 	unsigned get_size()
@@ -2706,7 +2726,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamLocalPositionSetpoint(mavlink);
+		return new (mavlink) MavlinkStreamLocalPositionSetpoint(mavlink);
 	}
 
 	unsigned get_size()
@@ -2783,7 +2803,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamAttitudeTarget(mavlink);
+		return new (mavlink) MavlinkStreamAttitudeTarget(mavlink);
 	}
 
 	unsigned get_size()
@@ -2870,7 +2890,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamRCChannels(mavlink);
+		return new (mavlink) MavlinkStreamRCChannels(mavlink);
 	}
 
 	unsigned get_size()
@@ -2975,7 +2995,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamManualControl(mavlink);
+		return new (mavlink) MavlinkStreamManualControl(mavlink);
 	}
 
 	unsigned get_size()
@@ -3052,7 +3072,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamOpticalFlowRad(mavlink);
+		return new (mavlink) MavlinkStreamOpticalFlowRad(mavlink);
 	}
 
 	unsigned get_size()
@@ -3129,7 +3149,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamNamedValueFloat(mavlink);
+		return new (mavlink) MavlinkStreamNamedValueFloat(mavlink);
 	}
 
 	unsigned get_size()
@@ -3198,7 +3218,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamDebug(mavlink);
+		return new (mavlink) MavlinkStreamDebug(mavlink);
 	}
 
 	unsigned get_size()
@@ -3265,7 +3285,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamDebugVect(mavlink);
+		return new (mavlink) MavlinkStreamDebugVect(mavlink);
 	}
 
 	unsigned get_size()
@@ -3336,7 +3356,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamNavControllerOutput(mavlink);
+		return new (mavlink) MavlinkStreamNavControllerOutput(mavlink);
 	}
 
 	unsigned get_size()
@@ -3413,7 +3433,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamCameraCapture(mavlink);
+		return new (mavlink) MavlinkStreamCameraCapture(mavlink);
 	}
 
 	unsigned get_size()
@@ -3487,7 +3507,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamDistanceSensor(mavlink);
+		return new (mavlink) MavlinkStreamDistanceSensor(mavlink);
 	}
 
 	unsigned get_size()
@@ -3580,7 +3600,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamExtendedSysState(mavlink);
+		return new (mavlink) MavlinkStreamExtendedSysState(mavlink);
 	}
 
 	unsigned get_size()
@@ -3697,7 +3717,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamAltitude(mavlink);
+		return new (mavlink) MavlinkStreamAltitude(mavlink);
 	}
 
 	unsigned get_size()
@@ -3837,7 +3857,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamWind(mavlink);
+		return new (mavlink) MavlinkStreamWind(mavlink);
 	}
 
 	unsigned get_size()
@@ -3923,7 +3943,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamMountOrientation(mavlink);
+		return new (mavlink) MavlinkStreamMountOrientation(mavlink);
 	}
 
 	unsigned get_size()
@@ -3991,7 +4011,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamHighLatency(mavlink);
+		return new (mavlink) MavlinkStreamHighLatency(mavlink);
 	}
 
 	unsigned get_size()
@@ -4199,7 +4219,7 @@ public:
 
 	static MavlinkStream *new_instance(Mavlink *mavlink)
 	{
-		return new MavlinkStreamGroundTruth(mavlink);
+		return new (mavlink) MavlinkStreamGroundTruth(mavlink);
 	}
 
 	unsigned get_size()
@@ -85,6 +85,11 @@ MavlinkMissionManager::MavlinkMissionManager(Mavlink *mavlink) :
 	_transfer_current_seq(-1),
 	_transfer_partner_sysid(0),
 	_transfer_partner_compid(0),
+	_stage_buf{},
+	_stage_start(0),
+	_stage_count(0),
+	_stage_is_cache(false),
+	_stage_dm_item(-1),
 	_offboard_mission_sub(-1),
 	_mission_result_sub(-1),
 	_offboard_mission_pub(nullptr),
@@ -322,8 +327,7 @@ MavlinkMissionManager::send_mission_item(uint8_t sysid, uint8_t compid, uint16_t
 
 	case MAV_MISSION_TYPE_MISSION: {
 			dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_dataman_id);
-			read_success = dm_read(dm_item, seq, &mission_item, sizeof(struct mission_item_s)) ==
-				       sizeof(struct mission_item_s);
+			read_success = read_transfer_item(dm_item, seq, &mission_item);
 		}
 		break;
 
@@ -723,6 +727,10 @@ MavlinkMissionManager::handle_mission_request_list(const mavlink_message_t *msg)
 			_transfer_partner_sysid = msg->sysid;
 			_transfer_partner_compid = msg->compid;
 
+			/* the stored mission may have changed since the last transfer */
+			_stage_count = 0;
+			_stage_is_cache = false;
+
 			if (_transfer_count > 0) {
 				if (_verbose) {
 					PX4_INFO("WPM: MISSION_REQUEST_LIST OK, %u mission items to send, mission type=%i", _transfer_count,
@@ -910,6 +918,7 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			_transfer_count = wpc.count;
 			_transfer_dataman_id = _dataman_id == 0 ? 1 : 0;	// use inactive storage for transmission
 			_transfer_current_seq = -1;
+			_stage_count = 0;
 
 			if (_mission_type == MAV_MISSION_TYPE_FENCE) {
 				// We're about to write new geofence items, so take the lock. It will be released when
@@ -951,6 +960,63 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 	}
 }
 
+int
+MavlinkMissionManager::flush_staged_items()
+{
+	if (_stage_count == 0) {
+		return PX4_OK;
+	}
+
+	dm_item_t dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_transfer_dataman_id);
+
+	ssize_t ret = dm_write_multiple(dm_item, _stage_start, DM_PERSIST_POWER_ON_RESET, _stage_buf,
+					_stage_count, sizeof(struct mission_item_s));
+
+	bool success = ret == (ssize_t)_stage_count;
+	_stage_count = 0;
+
+	return success ? PX4_OK : PX4_ERROR;
+}
+
+bool
+MavlinkMissionManager::read_transfer_item(dm_item_t dm_item, uint16_t seq, struct mission_item_s *mission_item)
+{
+	if (_stage_count > 0 && !_stage_is_cache) {
+		/* the arena holds writes not yet committed by an upload: leave
+		 * them alone and fall back to a single read */
+		return dm_read(dm_item, seq, mission_item, sizeof(struct mission_item_s)) ==
+		       sizeof(struct mission_item_s);
+	}
+
+	if (!_stage_is_cache || _stage_dm_item != (int)dm_item
+	    || seq < _stage_start || seq >= _stage_start + _stage_count) {
+
+		/* refill the arena with one bulk read; the following sequential
+		 * requests of the download are served from memory */
+		unsigned num_items = STAGE_SIZE;
+
+		if (_transfer_count > seq && _transfer_count - seq < num_items) {
+			num_items = _transfer_count - seq;
+		}
+
+		ssize_t ret = dm_read_multiple(dm_item, seq, num_items, _stage_buf, sizeof(struct mission_item_s));
+
+		if (ret < 1) {
+			_stage_count = 0;
+			_stage_is_cache = false;
+			return false;
+		}
+
+		_stage_is_cache = true;
+		_stage_dm_item = dm_item;
+		_stage_start = seq;
+		_stage_count = ret;
+	}
+
+	*mission_item = _stage_buf[seq - _stage_start];
+	return true;
+}
+
 void
 MavlinkMissionManager::switch_to_idle_state()
 {
@@ -1060,16 +1126,19 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 					check_failed = true;
 
 				} else {
-					dm_item_t dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_transfer_dataman_id);
+					/* stage the item instead of writing it directly: the items are
+					 * committed to dataman in bulk, which is much faster than one
+					 * write transaction per item. The staged range is contiguous
+					 * because out-of-order sequence numbers are rejected above. */
+					if (_stage_count == 0) {
+						_stage_start = wp.seq;
+						_stage_is_cache = false;
+					}
 
-					write_failed = dm_write(dm_item, wp.seq, DM_PERSIST_POWER_ON_RESET, &mission_item,
-								sizeof(struct mission_item_s)) != sizeof(struct mission_item_s);
+					_stage_buf[_stage_count++] = mission_item;
 
-					if (!write_failed) {
-						/* waypoint marked as current */
-						if (wp.current) {
-							_transfer_current_seq = wp.seq;
-						}
+					if (_stage_count == STAGE_SIZE) {
+						write_failed = flush_staged_items() != PX4_OK;
 					}
 				}
 			}
@@ -1153,7 +1222,12 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 
 			switch (_mission_type) {
 			case MAV_MISSION_TYPE_MISSION:
-				ret = update_active_mission(_transfer_dataman_id, _transfer_count, _transfer_current_seq);
+				ret = flush_staged_items();
+
+				if (ret == PX4_OK) {
+					ret = update_active_mission(_transfer_dataman_id, _transfer_count, _transfer_current_seq);
+				}
+
 				break;
 
 			case MAV_MISSION_TYPE_FENCE:
@@ -123,6 +123,16 @@ private:
 	unsigned		_transfer_partner_compid;		///< Partner component ID for current transmission
 	static bool		_transfer_in_progress;			///< Global variable checking for current transmission
 
+	/* staging arena shared between uploads and downloads: received items
+	 * are committed to dataman in bulk instead of one dm_write per item,
+	 * and downloads are served from a bulk read-ahead of the same arena */
+	static constexpr unsigned STAGE_SIZE = 8;
+	struct mission_item_s	_stage_buf[STAGE_SIZE];
+	unsigned		_stage_start;				///< sequence number of the first staged item
+	unsigned		_stage_count;				///< number of staged items
+	bool			_stage_is_cache;			///< arena holds a download read-ahead instead of pending upload writes
+	int			_stage_dm_item;				///< dataman item id the cached range belongs to
+
 	int			_offboard_mission_sub;
 	int			_mission_result_sub;
 	orb_advert_t		_offboard_mission_pub;
@@ -239,6 +249,20 @@ private:
 	int format_mavlink_mission_item(const struct mission_item_s *mission_item,
 					mavlink_mission_item_t *mavlink_mission_item);
 
+	/**
+	 * Commit all staged mission items to dataman in one bulk transaction.
+	 * @return PX4_OK on success
+	 */
+	int flush_staged_items();
+
+	/**
+	 * Read one mission item for a download. Sequential requests are served
+	 * from a bulk read-ahead kept in the staging arena, so a transfer costs
+	 * one dataman transaction per STAGE_SIZE items instead of one per item.
+	 * @return true on success
+	 */
+	bool read_transfer_item(dm_item_t dm_item, uint16_t seq, struct mission_item_s *mission_item);
+
 	/**
 	 * set _state to idle (and do necessary cleanup)
 	 */
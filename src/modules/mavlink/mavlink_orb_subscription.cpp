@@ -49,22 +49,106 @@
 #include <px4_defines.h>
 #include <uORB/uORB.h>
 
+#include "mavlink_main.h"
+
+MavlinkOrbSubscription::CacheEntry *MavlinkOrbSubscription::_cache = nullptr;
+px4_sem_t MavlinkOrbSubscription::_cache_lock;
+
+void
+MavlinkOrbSubscription::initialize_cache()
+{
+	static bool initialized = false;
+
+	if (!initialized) {
+		px4_sem_init(&_cache_lock, 1, 1);
+		initialized = true;
+	}
+}
+
+MavlinkOrbSubscription::CacheEntry *
+MavlinkOrbSubscription::cache_get(const orb_id_t topic, int instance)
+{
+	lock_cache();
+
+	CacheEntry *entry;
+	LL_FOREACH(_cache, entry) {
+		if (entry->topic == topic && entry->instance == instance) {
+			++entry->refs;
+			unlock_cache();
+			return entry;
+		}
+	}
+
+	/* entries outlive any single link, so they come from the regular heap
+	 * and not from an instance arena */
+	entry = new CacheEntry();
+
+	if (entry != nullptr) {
+		entry->topic = topic;
+		entry->instance = instance;
+		entry->fd = -1;
+		entry->refs = 1;
+		LL_PREPEND(_cache, entry);
+	}
+
+	unlock_cache();
+	return entry;
+}
+
+void
+MavlinkOrbSubscription::cache_release(CacheEntry *entry)
+{
+	if (entry == nullptr) {
+		return;
+	}
+
+	lock_cache();
+
+	if (--entry->refs == 0) {
+		LL_DELETE(_cache, entry);
+
+		if (entry->fd >= 0) {
+			orb_unsubscribe(entry->fd);
+		}
+
+		delete[] entry->data;
+		delete entry;
+	}
+
+	unlock_cache();
+}
+
 MavlinkOrbSubscription::MavlinkOrbSubscription(const orb_id_t topic, int instance) :
 	next(nullptr),
 	_topic(topic),
-	_fd(-1),
 	_instance(instance),
-	_published(false),
-	_subscribe_from_beginning(false),
-	_last_pub_check(0)
+	_entry(cache_get(topic, instance)),
+	_last_generation(0),
+	_last_published(false)
 {
 }
 
 MavlinkOrbSubscription::~MavlinkOrbSubscription()
 {
-	if (_fd >= 0) {
-		orb_unsubscribe(_fd);
-	}
+	cache_release(_entry);
+}
+
+void *
+MavlinkOrbSubscription::operator new(size_t size, Mavlink *mavlink) noexcept
+{
+	return mavlink->instance_alloc(size);
+}
+
+void
+MavlinkOrbSubscription::operator delete(void *ptr) noexcept
+{
+	Mavlink::instance_free(ptr);
+}
+
+void
+MavlinkOrbSubscription::operator delete(void *ptr, Mavlink *mavlink) noexcept
+{
+	Mavlink::instance_free(ptr);
 }
 
 orb_id_t
@@ -79,130 +163,187 @@ MavlinkOrbSubscription::get_instance() const
 	return _instance;
 }
 
-bool
-MavlinkOrbSubscription::update(uint64_t *time, void *data)
+void
+MavlinkOrbSubscription::refresh()
 {
+	CacheEntry *e = _entry;
 
+	if (e == nullptr) {
+		return;
+	}
+
+	if (!e->published) {
+		// Telemetry can sustain an initial published check at 10 Hz,
+		// shared by all links
+		hrt_abstime now = hrt_absolute_time();
 
-	// TODO this is NOT atomic operation, we can get data newer than time
-	// if topic was published between orb_stat and orb_copy calls.
+		if (now - e->last_pub_check < 100000) {
+			return;
+		}
 
-	uint64_t time_topic;
+		// We are checking now
+		e->last_pub_check = now;
 
-	if (orb_stat(_fd, &time_topic)) {
-		/* error getting last topic publication time */
-		time_topic = 0;
+		// We don't want to subscribe to anything that does not exist
+		// in order to save memory and file descriptors.
+		// However, for some topics like vehicle_command_ack, we want to subscribe
+		// from the beginning in order not to miss the first publish respective advertise.
+		if (!e->subscribe_from_beginning && orb_exists(e->topic, e->instance)) {
+			return;
+		}
 	}
 
-	if (update(data)) {
-		/* data copied successfully */
+	if (e->fd < 0) {
+		e->fd = orb_subscribe_multi(e->topic, e->instance);
 
-		if (time_topic == 0 || (time_topic != *time)) {
-			*time = time_topic;
-			return true;
+		if (e->fd < 0) {
+			return;
+		}
+	}
 
-		} else {
-			return false;
+	if (e->data == nullptr) {
+		e->data = new uint8_t[e->topic->o_size];
+
+		if (e->data == nullptr) {
+			return;
 		}
 	}
 
-	return false;
-}
+	/* only publications that change the payload are of interest here, so let
+	 * the node filter out value repeats before they ever reach orb_check() */
+	if (e->change_filter_requested && !e->change_filter_set) {
+		orb_set_change_filter(e->fd, true);
+		e->change_filter_set = true;
+	}
 
-bool
-MavlinkOrbSubscription::update(void *data)
-{
-	if (!is_published()) {
-		return false;
+	bool updated = false;
+
+	if (orb_check(e->fd, &updated) != 0) {
+		return;
 	}
 
-	if (orb_copy(_topic, _fd, data)) {
-		if (data != nullptr) {
-			/* error copying topic data */
-			memset(data, 0, _topic->o_size);
-		}
+	if (!updated && !e->published) {
+		// topic may have been last published before we subscribed
+		uint64_t time_topic = 0;
 
-		return false;
+		if (orb_stat(e->fd, &time_topic) == PX4_OK && time_topic != 0) {
+			updated = true;
+		}
 	}
 
-	return true;
+	if (updated && orb_copy(e->topic, e->fd, e->data) == PX4_OK) {
+		e->published = true;
+		++e->generation;
+
+		if (orb_stat(e->fd, &e->time_topic) != 0) {
+			/* error getting last topic publication time */
+			e->time_topic = 0;
+		}
+	}
 }
 
 bool
-MavlinkOrbSubscription::update_if_changed(void *data)
+MavlinkOrbSubscription::update(uint64_t *time, void *data)
 {
-	bool prevpub = _published;
+	lock_cache();
+	refresh();
 
-	if (!is_published()) {
-		return false;
-	}
+	bool ret = false;
 
-	bool updated;
+	if (_entry != nullptr && _entry->published && _entry->data != nullptr) {
+		/* data is copied even when the sample is not new, as before; a
+		 * nullptr caller only polls the publication timestamp */
+		if (data != nullptr) {
+			memcpy(data, _entry->data, _topic->o_size);
+		}
 
-	if (orb_check(_fd, &updated)) {
-		return false;
-	}
+		_last_generation = _entry->generation;
 
-	// If we didn't update and this topic did not change
-	// its publication status then nothing really changed
-	if (!updated && prevpub == _published) {
-		return false;
+		if (_entry->time_topic == 0 || _entry->time_topic != *time) {
+			*time = _entry->time_topic;
+			ret = true;
+		}
 	}
 
-	return update(data);
+	unlock_cache();
+	return ret;
 }
 
 bool
-MavlinkOrbSubscription::is_published()
+MavlinkOrbSubscription::update(void *data)
 {
-	// If we marked it as published no need to check again
-	if (_published) {
-		return true;
-	}
+	lock_cache();
+	refresh();
 
-	// Telemetry can sustain an initial published check at 10 Hz
-	hrt_abstime now = hrt_absolute_time();
+	bool ret = false;
 
-	if (now - _last_pub_check < 100000) {
-		return false;
+	if (_entry != nullptr && _entry->published && _entry->data != nullptr) {
+		memcpy(data, _entry->data, _topic->o_size);
+		_last_generation = _entry->generation;
+		ret = true;
 	}
 
-	// We are checking now
-	_last_pub_check = now;
+	unlock_cache();
+	return ret;
+}
+
+bool
+MavlinkOrbSubscription::update_if_changed(void *data)
+{
+	lock_cache();
 
-	// We don't want to subscribe to anything that does not exist
-	// in order to save memory and file descriptors.
-	// However, for some topics like vehicle_command_ack, we want to subscribe
-	// from the beginning in order not to miss the first publish respective advertise.
-	if (!_subscribe_from_beginning && orb_exists(_topic, _instance)) {
+	if (_entry == nullptr) {
+		unlock_cache();
 		return false;
 	}
 
-	if (_fd < 0) {
-		_fd = orb_subscribe_multi(_topic, _instance);
-	}
+	_entry->change_filter_requested = true;
+	refresh();
 
-	bool updated;
-	orb_check(_fd, &updated);
+	bool ret = false;
 
-	if (updated) {
-		_published = true;
+	if (_entry->published && _entry->data != nullptr
+	    && (_entry->generation != _last_generation || _entry->published != _last_published)) {
+		memcpy(data, _entry->data, _topic->o_size);
+		_last_generation = _entry->generation;
+		ret = true;
 	}
 
-	// topic may have been last published before we subscribed
-	uint64_t time_topic = 0;
+	_last_published = _entry->published;
+	unlock_cache();
+	return ret;
+}
 
-	if (!_published && orb_stat(_fd, &time_topic) == PX4_OK) {
-		if (time_topic != 0) {
-			_published = true;
-		}
-	}
+bool
+MavlinkOrbSubscription::is_published()
+{
+	lock_cache();
+	refresh();
+	bool published = (_entry != nullptr) && _entry->published;
+	unlock_cache();
 
-	return _published;
+	return published;
 }
 
 void
 MavlinkOrbSubscription::subscribe_from_beginning(bool from_beginning)
 {
-	_subscribe_from_beginning = from_beginning;
+	lock_cache();
+
+	if (_entry != nullptr) {
+		/* sticky: another link may rely on it as well */
+		_entry->subscribe_from_beginning |= from_beginning;
+	}
+
+	unlock_cache();
+}
+
+int
+MavlinkOrbSubscription::get_fd()
+{
+	lock_cache();
+	int fd = (_entry != nullptr) ? _entry->fd : -1;
+	unlock_cache();
+
+	return fd;
 }
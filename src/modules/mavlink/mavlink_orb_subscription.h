@@ -35,24 +35,46 @@
  * @file mavlink_orb_subscription.h
  * uORB subscription definition.
  *
+ * The uORB side of the subscriptions is shared process-wide: all mavlink
+ * links referencing the same (topic, instance) pair use one subscription
+ * and one cached sample buffer, with per-link cursors. Each topic update
+ * is thus copied out of uORB once, no matter how many links are running.
+ *
  * @author Anton Babushkin <anton.babushkin@me.com>
  */
 
 #ifndef MAVLINK_ORB_SUBSCRIPTION_H_
 #define MAVLINK_ORB_SUBSCRIPTION_H_
 
+#include <stddef.h>
+
 #include <systemlib/uthash/utlist.h>
 #include <drivers/drv_hrt.h>
+#include <px4_sem.h>
 #include "uORB/uORB.h"	// orb_id_t
 
+class Mavlink;
+
 class MavlinkOrbSubscription
 {
 public:
 	MavlinkOrbSubscription *next;	///< pointer to next subscription in list
 
+	/**
+	 * initialize the process-wide topic cache: call this once on startup
+	 * (this function is not thread-safe!)
+	 */
+	static void initialize_cache();
+
 	MavlinkOrbSubscription(const orb_id_t topic, int instance);
 	~MavlinkOrbSubscription();
 
+	/* Subscriptions are placement-allocated from the owning instance's arena
+	 * (@see Mavlink::instance_alloc()) to avoid per-object heap traffic */
+	void *operator new(size_t size, Mavlink *mavlink) noexcept;
+	void operator delete(void *ptr) noexcept;
+	void operator delete(void *ptr, Mavlink *mavlink) noexcept;
+
 	/**
 	 * Check if subscription updated based on timestamp.
 	 *
@@ -93,15 +115,60 @@ public:
 	orb_id_t get_topic() const;
 	int get_instance() const;
 
-	int get_fd() { return _fd; }
+	int get_fd();
 
 private:
+	/* One process-wide cache entry per (topic, instance): a single uORB
+	 * subscription and sample buffer shared by all mavlink links. The first
+	 * link polling after an update refreshes the buffer, the others only
+	 * compare their generation cursor and copy from RAM, so each update
+	 * costs one orb_copy() instead of one per link. */
+	struct CacheEntry {
+		CacheEntry *next;		///< pointer to next entry in the cache list
+		const orb_metadata *topic;	///< topic metadata
+		uint8_t instance;		///< topic instance
+		int fd;				///< subscription handle (-1 until first needed)
+		bool published;			///< topic was ever published
+		bool subscribe_from_beginning;	///< we need to subscribe from the beginning, e.g. for vehicle_command_acks
+		bool change_filter_requested;	///< some link uses update_if_changed() on this topic
+		bool change_filter_set;		///< uORB change filter has been enabled on the subscription
+		hrt_abstime last_pub_check;	///< when we checked publication existence last
+		unsigned generation;		///< bumped on every refreshed sample
+		uint64_t time_topic;		///< publication timestamp of the cached sample
+		unsigned refs;			///< number of links referencing this entry
+		uint8_t *data;			///< cached sample (o_size, lazily allocated with the subscription)
+	};
+
+	static CacheEntry *_cache;	///< process-wide cache list
+	static px4_sem_t _cache_lock;
+
+	static void lock_cache()
+	{
+		do {} while (px4_sem_wait(&_cache_lock) != 0);
+	}
+
+	static void unlock_cache()
+	{
+		px4_sem_post(&_cache_lock);
+	}
+
+	/** find or create the cache entry for a (topic, instance) pair */
+	static CacheEntry *cache_get(const orb_id_t topic, int instance);
+
+	/** drop one reference, freeing the entry with the last one */
+	static void cache_release(CacheEntry *entry);
+
+	/**
+	 * Refresh the cache entry from uORB if there is a new publication.
+	 * Must be called with the cache locked.
+	 */
+	void refresh();
+
 	const orb_id_t _topic;		///< topic metadata
-	int _fd;			///< subscription handle
-	const uint8_t _instance;		///< get topic instance
-	bool _published;		///< topic was ever published
-	bool _subscribe_from_beginning; ///< we need to subscribe from the beginning, e.g. for vehicle_command_acks
-	hrt_abstime _last_pub_check;	///< when we checked last
+	const uint8_t _instance;	///< topic instance
+	CacheEntry *_entry;		///< shared cache entry
+	unsigned _last_generation;	///< this link's cursor into the entry's generation counter
+	bool _last_published;		///< publication state at the last update_if_changed()
 
 	/* do not allow copying this class */
 	MavlinkOrbSubscription(const MavlinkOrbSubscription &);
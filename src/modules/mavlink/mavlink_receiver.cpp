@@ -92,6 +92,99 @@
 
 static const float mg2ms2 = CONSTANTS_ONE_G / 1000.0f;
 
+/*
+ * msgid-indexed dispatch table, binary searched in handle_message().
+ * Keep the entries sorted by ascending msgid value.
+ */
+const MavlinkReceiver::MessageHandler MavlinkReceiver::_message_handlers[] = {
+	{ MAVLINK_MSG_ID_HEARTBEAT,			false,	&MavlinkReceiver::handle_message_heartbeat },
+	{ MAVLINK_MSG_ID_SYSTEM_TIME,			false,	&MavlinkReceiver::handle_message_system_time },
+	{ MAVLINK_MSG_ID_PING,				false,	&MavlinkReceiver::handle_message_ping },
+	{ MAVLINK_MSG_ID_SET_MODE,			true,	&MavlinkReceiver::handle_message_set_mode },
+	{ MAVLINK_MSG_ID_GPS_GLOBAL_ORIGIN,		false,	&MavlinkReceiver::handle_message_gps_global_origin },
+	{ MAVLINK_MSG_ID_ATTITUDE_QUATERNION_COV,	false,	&MavlinkReceiver::handle_message_attitude_quaternion_cov },
+	{ MAVLINK_MSG_ID_LOCAL_POSITION_NED_COV,	false,	&MavlinkReceiver::handle_message_local_position_ned_cov },
+	{ MAVLINK_MSG_ID_REQUEST_DATA_STREAM,		true,	&MavlinkReceiver::handle_message_request_data_stream },
+	{ MAVLINK_MSG_ID_MANUAL_CONTROL,		false,	&MavlinkReceiver::handle_message_manual_control },
+	{ MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE,		false,	&MavlinkReceiver::handle_message_rc_channels_override },
+	{ MAVLINK_MSG_ID_COMMAND_INT,			true,	&MavlinkReceiver::handle_message_command_int },
+	{ MAVLINK_MSG_ID_COMMAND_LONG,			true,	&MavlinkReceiver::handle_message_command_long },
+	{ MAVLINK_MSG_ID_COMMAND_ACK,			false,	&MavlinkReceiver::handle_message_command_ack },
+	{ MAVLINK_MSG_ID_SET_ATTITUDE_TARGET,		false,	&MavlinkReceiver::handle_message_set_attitude_target },
+	{ MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED,	false,	&MavlinkReceiver::handle_message_set_position_target_local_ned },
+	{ MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE,	false,	&MavlinkReceiver::handle_message_vision_position_estimate },
+	{ MAVLINK_MSG_ID_OPTICAL_FLOW_RAD,		false,	&MavlinkReceiver::handle_message_optical_flow_rad },
+	{ MAVLINK_MSG_ID_RADIO_STATUS,			false,	&MavlinkReceiver::handle_message_radio_status },
+	{ MAVLINK_MSG_ID_TIMESYNC,			false,	&MavlinkReceiver::handle_message_timesync },
+	{ MAVLINK_MSG_ID_SERIAL_CONTROL,		false,	&MavlinkReceiver::handle_message_serial_control },
+	{ MAVLINK_MSG_ID_DISTANCE_SENSOR,		false,	&MavlinkReceiver::handle_message_distance_sensor },
+	{ MAVLINK_MSG_ID_ATT_POS_MOCAP,			false,	&MavlinkReceiver::handle_message_att_pos_mocap },
+	{ MAVLINK_MSG_ID_SET_ACTUATOR_CONTROL_TARGET,	false,	&MavlinkReceiver::handle_message_set_actuator_control_target },
+	{ MAVLINK_MSG_ID_FOLLOW_TARGET,			false,	&MavlinkReceiver::handle_message_follow_target },
+	{ MAVLINK_MSG_ID_BATTERY_STATUS,		false,	&MavlinkReceiver::handle_message_battery_status },
+	{ MAVLINK_MSG_ID_GPS_RTCM_DATA,			false,	&MavlinkReceiver::handle_message_gps_rtcm_data },
+	{ MAVLINK_MSG_ID_ADSB_VEHICLE,			false,	&MavlinkReceiver::handle_message_adsb_vehicle },
+	{ MAVLINK_MSG_ID_COLLISION,			false,	&MavlinkReceiver::handle_message_collision },
+	{ MAVLINK_MSG_ID_DEBUG_VECT,			false,	&MavlinkReceiver::handle_message_debug_vect },
+	{ MAVLINK_MSG_ID_NAMED_VALUE_FLOAT,		false,	&MavlinkReceiver::handle_message_named_value_float },
+	{ MAVLINK_MSG_ID_DEBUG,				false,	&MavlinkReceiver::handle_message_debug },
+	{ MAVLINK_MSG_ID_SETUP_SIGNING,			false,	&MavlinkReceiver::handle_message_setup_signing },
+	{ MAVLINK_MSG_ID_PLAY_TUNE,			false,	&MavlinkReceiver::handle_message_play_tune },
+	{ MAVLINK_MSG_ID_LOGGING_ACK,			false,	&MavlinkReceiver::handle_message_logging_ack }
+};
+
+const unsigned MavlinkReceiver::_message_handler_count =
+	sizeof(MavlinkReceiver::_message_handlers) / sizeof(MavlinkReceiver::_message_handlers[0]);
+
+bool MavlinkReceiver::_message_handlers_checked = false;
+bool MavlinkReceiver::_message_handlers_sorted = true;
+
+/* how long the ack fast path waits for the handler before the
+ * regular main loop path takes over again */
+static constexpr uint64_t COMMAND_ACK_FAST_TIMEOUT = 1000 * 1000;
+
+/* timesync engine tuning: exchanges are initiated at 10 Hz once a
+ * TIMESYNC-speaking peer has been seen on the link. Offset samples taken
+ * at high RTT reflect queueing rather than clock offset and are
+ * discarded (but still counted in the RTT statistics). */
+static constexpr uint64_t TIMESYNC_SEND_INTERVAL = 100 * 1000;
+static constexpr uint32_t TIMESYNC_MAX_RTT_US = 15 * 1000;
+static constexpr unsigned TIMESYNC_CONVERGENCE_SAMPLES = 5;
+static constexpr int64_t TIMESYNC_MAX_SKEW_NS = 10 * 1000 * 1000;
+
+/* PI gains of the offset filter: P tracks the phase error, I absorbs
+ * the constant drift between the two clocks */
+static constexpr double TIMESYNC_GAIN_P = 0.02;
+static constexpr double TIMESYNC_GAIN_I = 0.0005;
+
+/* RTT histogram bucket upper bounds */
+const uint32_t MavlinkReceiver::_rtt_bucket_bounds_us[MavlinkReceiver::RTT_BUCKET_COUNT - 1] = {
+	500, 1000, 2000, 5000, 10000, 20000
+};
+
+/*
+ * Decode-in-place accessor for the hot messages. On targets that do not need
+ * byte swapping the payload bytes already have the host struct layout, so a
+ * full-length payload can be referenced directly and the decode copy is only
+ * needed when a MAVLink 2 sender truncated trailing zero bytes.
+ */
+template <typename T>
+static inline const T *decode_in_place(const mavlink_message_t *msg, unsigned wire_len, T *decode_buf)
+{
+#if MAVLINK_NEED_BYTE_SWAP
+	/* byte-swapped targets always take the decode copy below */
+#else
+
+	if (msg->len >= wire_len) {
+		return (const T *)_MAV_PAYLOAD(msg);
+	}
+
+#endif
+	memset(decode_buf, 0, sizeof(T));
+	memcpy(decode_buf, _MAV_PAYLOAD(msg), msg->len < sizeof(T) ? msg->len : sizeof(T));
+	return decode_buf;
+}
+
 MavlinkReceiver::MavlinkReceiver(Mavlink *parent) :
 	_mavlink(parent),
 	_mission_manager(parent),
@@ -124,6 +217,7 @@ MavlinkReceiver::MavlinkReceiver(Mavlink *parent) :
 	_global_vel_sp_pub(nullptr),
 	_att_sp_pub(nullptr),
 	_rates_sp_pub(nullptr),
+	_rates_sp_queue_pub(nullptr),
 	_force_sp_pub(nullptr),
 	_pos_sp_triplet_pub(nullptr),
 	_att_pos_mocap_pub(nullptr),
@@ -145,6 +239,9 @@ MavlinkReceiver::MavlinkReceiver(Mavlink *parent) :
 	_command_ack_pub(nullptr),
 	_control_mode_sub(orb_subscribe(ORB_ID(vehicle_control_mode))),
 	_actuator_armed_sub(orb_subscribe(ORB_ID(actuator_armed))),
+	_command_ack_sub(orb_subscribe(ORB_ID(vehicle_command_ack))),
+	_fast_ack_command(0),
+	_fast_ack_deadline(0),
 	_global_ref_timestamp(0),
 	_hil_frames(0),
 	_old_timestamp(0),
@@ -154,8 +251,20 @@ MavlinkReceiver::MavlinkReceiver(Mavlink *parent) :
 	_offboard_control_mode{},
 	_att_sp{},
 	_rates_sp{},
-	_time_offset_avg_alpha(0.8),
+	_rates_sp_queue{},
 	_time_offset(0),
+	_time_offset_drift(0.0),
+	_tsync_converged(false),
+	_tsync_sample_count(0),
+	_tsync_peer_seen(false),
+	_tsync_request_ts1(0),
+	_tsync_last_request_time(0),
+	_rtt_hist{},
+	_rtt_count(0),
+	_rtt_min_us(0),
+	_rtt_max_us(0),
+	_rtt_avg_us(0.0f),
+	_rtt_reject_count(0),
 	_orb_class_instance(-1),
 	_mom_switch_pos{},
 	_mom_switch_state(0),
@@ -163,11 +272,24 @@ MavlinkReceiver::MavlinkReceiver(Mavlink *parent) :
 	_p_bat_crit_thr(param_find("BAT_CRIT_THR")),
 	_p_bat_low_thr(param_find("BAT_LOW_THR"))
 {
+	/* verify the dispatch table ordering once; a misordered table falls back
+	 * to a linear scan instead of silently dropping messages */
+	if (!_message_handlers_checked) {
+		for (unsigned i = 1; i < _message_handler_count; i++) {
+			if (_message_handlers[i - 1].msgid >= _message_handlers[i].msgid) {
+				PX4_ERR("message dispatch table unsorted at index %u", i);
+				_message_handlers_sorted = false;
+			}
+		}
+
+		_message_handlers_checked = true;
+	}
 }
 
 MavlinkReceiver::~MavlinkReceiver()
 {
 	orb_unsubscribe(_control_mode_sub);
+	orb_unsubscribe(_command_ack_sub);
 }
 
 void
@@ -179,153 +301,39 @@ MavlinkReceiver::handle_message(mavlink_message_t *msg)
 		}
 	}
 
-	switch (msg->msgid) {
-	case MAVLINK_MSG_ID_COMMAND_LONG:
-		if (_mavlink->accepting_commands()) {
-			handle_message_command_long(msg);
-		}
+	/* binary search the dispatch table (lower bound on msgid) */
+	const MessageHandler *entry = nullptr;
 
-		break;
+	if (_message_handlers_sorted) {
+		unsigned low = 0;
+		unsigned high = _message_handler_count;
 
-	case MAVLINK_MSG_ID_COMMAND_INT:
-		if (_mavlink->accepting_commands()) {
-			handle_message_command_int(msg);
-		}
+		while (low < high) {
+			unsigned mid = (low + high) / 2;
 
-		break;
-
-	case MAVLINK_MSG_ID_COMMAND_ACK:
-		handle_message_command_ack(msg);
-		break;
+			if (_message_handlers[mid].msgid < msg->msgid) {
+				low = mid + 1;
 
-	case MAVLINK_MSG_ID_OPTICAL_FLOW_RAD:
-		handle_message_optical_flow_rad(msg);
-		break;
-
-	case MAVLINK_MSG_ID_PING:
-		handle_message_ping(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_MODE:
-		if (_mavlink->accepting_commands()) {
-			handle_message_set_mode(msg);
+			} else {
+				high = mid;
+			}
 		}
 
-		break;
-
-	case MAVLINK_MSG_ID_ATT_POS_MOCAP:
-		handle_message_att_pos_mocap(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED:
-		handle_message_set_position_target_local_ned(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_ATTITUDE_TARGET:
-		handle_message_set_attitude_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_ACTUATOR_CONTROL_TARGET:
-		handle_message_set_actuator_control_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE:
-		handle_message_vision_position_estimate(msg);
-		break;
-
-	case MAVLINK_MSG_ID_ATTITUDE_QUATERNION_COV:
-		handle_message_attitude_quaternion_cov(msg);
-		break;
-
-	case MAVLINK_MSG_ID_LOCAL_POSITION_NED_COV:
-		handle_message_local_position_ned_cov(msg);
-		break;
-
-	case MAVLINK_MSG_ID_GPS_GLOBAL_ORIGIN:
-		handle_message_gps_global_origin(msg);
-		break;
-
-	case MAVLINK_MSG_ID_RADIO_STATUS:
-		handle_message_radio_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_MANUAL_CONTROL:
-		handle_message_manual_control(msg);
-		break;
-
-	case MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE:
-		handle_message_rc_channels_override(msg);
-		break;
-
-	case MAVLINK_MSG_ID_HEARTBEAT:
-		handle_message_heartbeat(msg);
-		break;
-
-	case MAVLINK_MSG_ID_REQUEST_DATA_STREAM:
-		if (_mavlink->accepting_commands()) {
-			handle_message_request_data_stream(msg);
+		if (low < _message_handler_count && _message_handlers[low].msgid == msg->msgid) {
+			entry = &_message_handlers[low];
 		}
 
-		break;
-
-	case MAVLINK_MSG_ID_SYSTEM_TIME:
-		handle_message_system_time(msg);
-		break;
-
-	case MAVLINK_MSG_ID_TIMESYNC:
-		handle_message_timesync(msg);
-		break;
-
-	case MAVLINK_MSG_ID_DISTANCE_SENSOR:
-		handle_message_distance_sensor(msg);
-		break;
-
-	case MAVLINK_MSG_ID_FOLLOW_TARGET:
-		handle_message_follow_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_ADSB_VEHICLE:
-		handle_message_adsb_vehicle(msg);
-		break;
-
-	case MAVLINK_MSG_ID_COLLISION:
-		handle_message_collision(msg);
-		break;
-
-	case MAVLINK_MSG_ID_GPS_RTCM_DATA:
-		handle_message_gps_rtcm_data(msg);
-		break;
-
-	case MAVLINK_MSG_ID_BATTERY_STATUS:
-		handle_message_battery_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SERIAL_CONTROL:
-		handle_message_serial_control(msg);
-		break;
-
-	case MAVLINK_MSG_ID_LOGGING_ACK:
-		handle_message_logging_ack(msg);
-		break;
-
-	case MAVLINK_MSG_ID_PLAY_TUNE:
-		handle_message_play_tune(msg);
-		break;
-
-	case MAVLINK_MSG_ID_NAMED_VALUE_FLOAT:
-		handle_message_named_value_float(msg);
-		break;
-
-	case MAVLINK_MSG_ID_DEBUG:
-		handle_message_debug(msg);
-		break;
-
-	case MAVLINK_MSG_ID_DEBUG_VECT:
-		handle_message_debug_vect(msg);
-		break;
+	} else {
+		for (unsigned i = 0; i < _message_handler_count; i++) {
+			if (_message_handlers[i].msgid == msg->msgid) {
+				entry = &_message_handlers[i];
+				break;
+			}
+		}
+	}
 
-	default:
-		break;
+	if (entry != nullptr && (!entry->check_accepting_commands || _mavlink->accepting_commands())) {
+		(this->*(entry->handler))(msg);
 	}
 
 	/*
@@ -507,6 +515,14 @@ MavlinkReceiver::handle_message_command_long(mavlink_message_t *msg)
 		} else {
 			orb_publish(ORB_ID(vehicle_command), _cmd_pub, &vcmd);
 		}
+
+		if (command_is_time_critical(cmd_mavlink.command)) {
+			/* arm the ack fast path: the receive loop sends the ack as
+			 * soon as the handler publishes it, instead of waiting for
+			 * the next main loop tick */
+			_fast_ack_command = cmd_mavlink.command;
+			_fast_ack_deadline = hrt_absolute_time() + COMMAND_ACK_FAST_TIMEOUT;
+		}
 	}
 
 out:
@@ -604,6 +620,12 @@ MavlinkReceiver::handle_message_command_int(mavlink_message_t *msg)
 		} else {
 			orb_publish(ORB_ID(vehicle_command), _cmd_pub, &vcmd);
 		}
+
+		if (command_is_time_critical(cmd_mavlink.command)) {
+			/* arm the ack fast path (see handle_message_command_long) */
+			_fast_ack_command = cmd_mavlink.command;
+			_fast_ack_deadline = hrt_absolute_time() + COMMAND_ACK_FAST_TIMEOUT;
+		}
 	}
 
 out:
@@ -665,6 +687,64 @@ MavlinkReceiver::handle_message_command_ack(mavlink_message_t *msg)
 	}
 }
 
+bool
+MavlinkReceiver::command_is_time_critical(uint16_t command)
+{
+	switch (command) {
+	case vehicle_command_s::VEHICLE_CMD_COMPONENT_ARM_DISARM:
+	case vehicle_command_s::VEHICLE_CMD_DO_SET_MODE:
+	case vehicle_command_s::VEHICLE_CMD_NAV_TAKEOFF:
+	case vehicle_command_s::VEHICLE_CMD_NAV_LAND:
+	case vehicle_command_s::VEHICLE_CMD_DO_FLIGHTTERMINATION:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+void
+MavlinkReceiver::check_fast_command_ack()
+{
+	if (_fast_ack_command == 0) {
+		return;
+	}
+
+	if (hrt_absolute_time() > _fast_ack_deadline) {
+		/* the handler did not respond in time, fall back to the main loop path */
+		_fast_ack_command = 0;
+		return;
+	}
+
+	bool updated = false;
+	orb_check(_command_ack_sub, &updated);
+
+	while (updated) {
+		vehicle_command_ack_s ack;
+		orb_copy(ORB_ID(vehicle_command_ack), _command_ack_sub, &ack);
+
+		if (!ack.from_external && ack.command == _fast_ack_command) {
+			mavlink_command_ack_t msg;
+			msg.result = ack.result;
+			msg.command = ack.command;
+			msg.progress = ack.result_param1;
+			msg.result_param2 = ack.result_param2;
+			msg.target_system = ack.target_system;
+			msg.target_component = ack.target_component;
+
+			mavlink_msg_command_ack_send_struct(_mavlink->get_channel(), &msg);
+
+			/* tell the main loop to skip this ack; if it raced us and
+			 * sent it already, the duplicate ack is harmless */
+			_mavlink->set_fast_ack_sent(ack.command);
+			_fast_ack_command = 0;
+			break;
+		}
+
+		orb_check(_command_ack_sub, &updated);
+	}
+}
+
 void
 MavlinkReceiver::handle_message_optical_flow_rad(mavlink_message_t *msg)
 {
@@ -877,8 +957,9 @@ MavlinkReceiver::handle_message_att_pos_mocap(mavlink_message_t *msg)
 void
 MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t *msg)
 {
-	mavlink_set_position_target_local_ned_t set_position_target_local_ned;
-	mavlink_msg_set_position_target_local_ned_decode(msg, &set_position_target_local_ned);
+	mavlink_set_position_target_local_ned_t decode_buf;
+	const mavlink_set_position_target_local_ned_t &set_position_target_local_ned =
+		*decode_in_place(msg, MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED_LEN, &decode_buf);
 
 	struct offboard_control_mode_s offboard_control_mode = {};
 
@@ -1367,7 +1448,18 @@ MavlinkReceiver::handle_message_set_attitude_target(mavlink_message_t *msg)
 						_rates_sp.thrust = set_attitude_target.thrust;
 					}
 
-					if (_rates_sp_pub == nullptr) {
+					/* A sender time that maps into the future marks a planned
+					 * setpoint: queue it for on-time execution by the rate
+					 * controller instead of applying it immediately. Without
+					 * timesync, sync_stamp() returns the current time and the
+					 * message takes the immediate path as before. */
+					const uint64_t exec_time = (set_attitude_target.time_boot_ms > 0) ?
+								   sync_stamp(set_attitude_target.time_boot_ms * 1000ull) : 0;
+
+					if (!ignore_bodyrate_msg && exec_time > _rates_sp.timestamp) {
+						queue_rates_setpoint(exec_time);
+
+					} else if (_rates_sp_pub == nullptr) {
 						_rates_sp_pub = orb_advertise(ORB_ID(vehicle_rates_setpoint), &_rates_sp);
 
 					} else {
@@ -1380,6 +1472,56 @@ MavlinkReceiver::handle_message_set_attitude_target(mavlink_message_t *msg)
 	}
 }
 
+void
+MavlinkReceiver::queue_rates_setpoint(uint64_t exec_time)
+{
+	/* drop entries that are already in the past as well as queued entries at
+	 * or after the new execution time: a new burst supersedes the old plan
+	 * from its first setpoint on. This keeps the queue sorted as long as
+	 * each burst is sent in ascending time order. */
+	const uint64_t now = hrt_absolute_time();
+	uint8_t n = 0;
+
+	for (uint8_t i = 0; i < _rates_sp_queue.count && i < rates_setpoint_queue_s::QUEUE_LENGTH; i++) {
+		if (_rates_sp_queue.timestamps[i] >= now && _rates_sp_queue.timestamps[i] < exec_time) {
+			_rates_sp_queue.timestamps[n] = _rates_sp_queue.timestamps[i];
+			_rates_sp_queue.roll[n] = _rates_sp_queue.roll[i];
+			_rates_sp_queue.pitch[n] = _rates_sp_queue.pitch[i];
+			_rates_sp_queue.yaw[n] = _rates_sp_queue.yaw[i];
+			_rates_sp_queue.thrust[n] = _rates_sp_queue.thrust[i];
+			n++;
+		}
+	}
+
+	if (n >= rates_setpoint_queue_s::QUEUE_LENGTH) {
+		/* full of still-pending earlier entries: drop the oldest */
+		for (uint8_t i = 1; i < n; i++) {
+			_rates_sp_queue.timestamps[i - 1] = _rates_sp_queue.timestamps[i];
+			_rates_sp_queue.roll[i - 1] = _rates_sp_queue.roll[i];
+			_rates_sp_queue.pitch[i - 1] = _rates_sp_queue.pitch[i];
+			_rates_sp_queue.yaw[i - 1] = _rates_sp_queue.yaw[i];
+			_rates_sp_queue.thrust[i - 1] = _rates_sp_queue.thrust[i];
+		}
+
+		n--;
+	}
+
+	_rates_sp_queue.timestamps[n] = exec_time;
+	_rates_sp_queue.roll[n] = _rates_sp.roll;
+	_rates_sp_queue.pitch[n] = _rates_sp.pitch;
+	_rates_sp_queue.yaw[n] = _rates_sp.yaw;
+	_rates_sp_queue.thrust[n] = _rates_sp.thrust;
+	_rates_sp_queue.count = n + 1;
+	_rates_sp_queue.timestamp = now;
+
+	if (_rates_sp_queue_pub == nullptr) {
+		_rates_sp_queue_pub = orb_advertise(ORB_ID(rates_setpoint_queue), &_rates_sp_queue);
+
+	} else {
+		orb_publish(ORB_ID(rates_setpoint_queue), _rates_sp_queue_pub, &_rates_sp_queue);
+	}
+}
+
 void
 MavlinkReceiver::handle_message_radio_status(mavlink_message_t *msg)
 {
@@ -1637,8 +1779,8 @@ MavlinkReceiver::handle_message_rc_channels_override(mavlink_message_t *msg)
 void
 MavlinkReceiver::handle_message_manual_control(mavlink_message_t *msg)
 {
-	mavlink_manual_control_t man;
-	mavlink_msg_manual_control_decode(msg, &man);
+	mavlink_manual_control_t decode_buf;
+	const mavlink_manual_control_t &man = *decode_in_place(msg, MAVLINK_MSG_ID_MANUAL_CONTROL_LEN, &decode_buf);
 
 	// Check target
 	if (man.target != 0 && man.target != _mavlink->get_system_id()) {
@@ -1748,6 +1890,27 @@ MavlinkReceiver::handle_message_ping(mavlink_message_t *msg)
 	}
 }
 
+void
+MavlinkReceiver::handle_message_setup_signing(mavlink_message_t *msg)
+{
+	mavlink_setup_signing_t setup;
+	mavlink_msg_setup_signing_decode(msg, &setup);
+
+	if (setup.target_system != mavlink_system.sysid) {
+		return;
+	}
+
+	/* distribute the key to every link; each one applies it only if it was
+	 * started with signing enabled */
+	for (int i = 0; i < Mavlink::instance_count(); i++) {
+		Mavlink *inst = Mavlink::get_instance(i);
+
+		if (inst != nullptr) {
+			inst->setup_signing(setup.secret_key, setup.initial_timestamp);
+		}
+	}
+}
+
 void
 MavlinkReceiver::handle_message_request_data_stream(mavlink_message_t *msg)
 {
@@ -1847,8 +2010,6 @@ MavlinkReceiver::handle_message_timesync(mavlink_message_t *msg)
 	mavlink_timesync_t tsync = {};
 	mavlink_msg_timesync_decode(msg, &tsync);
 
-	struct time_offset_s tsync_offset = {};
-
 	uint64_t now_ns = hrt_absolute_time() * 1000LL ;
 
 	if (tsync.tc1 == 0) {
@@ -1860,27 +2021,38 @@ MavlinkReceiver::handle_message_timesync(mavlink_message_t *msg)
 
 		mavlink_msg_timesync_send_struct(_mavlink->get_channel(), &rsync);
 
-		return;
+		/* the peer speaks timesync, so start initiating our own
+		 * exchanges to measure RTT and drive the offset filter */
+		_tsync_peer_seen = true;
 
-	} else if (tsync.tc1 > 0) {
+		return;
+	}
 
-		int64_t offset_ns = (int64_t)(tsync.ts1 + now_ns - tsync.tc1 * 2) / 2 ;
-		int64_t dt = _time_offset - offset_ns;
+	/* a reply carrying both timestamps */
+	int64_t offset_ns = (int64_t)(tsync.ts1 + now_ns - tsync.tc1 * 2) / 2 ;
+	uint32_t rtt_us = 0;
 
-		if (dt > 10000000LL || dt < -10000000LL) { // 10 millisecond skew
-			_time_offset = offset_ns;
+	if (_tsync_request_ts1 != 0 && tsync.ts1 == _tsync_request_ts1) {
+		/* reply to our own request: ts1 is our transmit time, so the
+		 * round trip time is measurable */
+		rtt_us = (now_ns - tsync.ts1) / 1000;
+		_tsync_request_ts1 = 0;
 
-			// Provide a warning only if not syncing initially
-			if (_time_offset != 0) {
-				PX4_ERR("[timesync] Hard setting offset.");
-			}
+		record_rtt(rtt_us);
 
-		} else {
-			smooth_time_offset(offset_ns);
+		if (rtt_us > TIMESYNC_MAX_RTT_US) {
+			_rtt_reject_count++;
+			return;
 		}
 	}
 
-	tsync_offset.offset_ns = _time_offset ;
+	update_time_offset(offset_ns);
+
+	struct time_offset_s tsync_offset = {};
+	tsync_offset.offset_ns = _time_offset;
+	tsync_offset.observed_offset_ns = offset_ns;
+	tsync_offset.rtt_us = rtt_us;
+	tsync_offset.converged = _tsync_converged;
 
 	if (_time_offset_pub == nullptr) {
 		_time_offset_pub = orb_advertise(ORB_ID(time_offset), &tsync_offset);
@@ -1888,14 +2060,13 @@ MavlinkReceiver::handle_message_timesync(mavlink_message_t *msg)
 	} else {
 		orb_publish(ORB_ID(time_offset), _time_offset_pub, &tsync_offset);
 	}
-
 }
 
 void
 MavlinkReceiver::handle_message_hil_sensor(mavlink_message_t *msg)
 {
-	mavlink_hil_sensor_t imu;
-	mavlink_msg_hil_sensor_decode(msg, &imu);
+	mavlink_hil_sensor_t decode_buf;
+	const mavlink_hil_sensor_t &imu = *decode_in_place(msg, MAVLINK_MSG_ID_HIL_SENSOR_LEN, &decode_buf);
 
 	uint64_t timestamp = hrt_absolute_time();
 
@@ -2609,6 +2780,13 @@ MavlinkReceiver::receive_thread(void *arg)
 			}
 		}
 
+		/* time-critical command ack fast path; bounded by the poll
+		 * timeout above instead of the main loop rate */
+		check_fast_command_ack();
+
+		/* initiate timesync exchanges for RTT and clock offset tracking */
+		check_timesync();
+
 		hrt_abstime t = hrt_absolute_time();
 
 		if (t - last_send_update > timeout * 1000) {
@@ -2636,7 +2814,29 @@ MavlinkReceiver::receive_thread(void *arg)
 
 void MavlinkReceiver::print_status()
 {
+	if (!_tsync_peer_seen) {
+		printf("\ttimesync: no peer on this link\n");
+		return;
+	}
+
+	printf("\ttimesync offset: %lld ns (%s), drift %.3f ns/sample\n",
+	       (long long)_time_offset, _tsync_converged ? "converged" : "converging",
+	       _time_offset_drift);
+
+	if (_rtt_count > 0) {
+		printf("\tRTT: avg %.0f us, min %lu us, max %lu us (%lu samples, %lu rejected)\n",
+		       (double)_rtt_avg_us, (unsigned long)_rtt_min_us, (unsigned long)_rtt_max_us,
+		       (unsigned long)_rtt_count, (unsigned long)_rtt_reject_count);
+		printf("\tRTT histogram (us):\n");
+
+		for (unsigned i = 0; i < RTT_BUCKET_COUNT - 1; i++) {
+			printf("\t  < %6lu: %lu\n", (unsigned long)_rtt_bucket_bounds_us[i],
+			       (unsigned long)_rtt_hist[i]);
+		}
 
+		printf("\t >= %6lu: %lu\n", (unsigned long)_rtt_bucket_bounds_us[RTT_BUCKET_COUNT - 2],
+		       (unsigned long)_rtt_hist[RTT_BUCKET_COUNT - 1]);
+	}
 }
 
 uint64_t MavlinkReceiver::sync_stamp(uint64_t usec)
@@ -2651,13 +2851,87 @@ uint64_t MavlinkReceiver::sync_stamp(uint64_t usec)
 }
 
 
-void MavlinkReceiver::smooth_time_offset(int64_t offset_ns)
+void MavlinkReceiver::update_time_offset(int64_t offset_sample_ns)
 {
-	/* The closer alpha is to 1.0, the faster the moving
-	 * average updates in response to new offset samples.
-	 */
+	if (!_tsync_converged) {
+		/* running mean over the first samples to get a quick,
+		 * reasonable starting point for the PI filter */
+		_tsync_sample_count++;
+		_time_offset += (offset_sample_ns - _time_offset) / (int64_t)_tsync_sample_count;
+
+		if (_tsync_sample_count >= TIMESYNC_CONVERGENCE_SAMPLES) {
+			_tsync_converged = true;
+		}
+
+		return;
+	}
+
+	int64_t error = offset_sample_ns - _time_offset;
+
+	if (error > TIMESYNC_MAX_SKEW_NS || error < -TIMESYNC_MAX_SKEW_NS) {
+		/* the peer clock jumped (e.g. NTP step on the companion):
+		 * restart the convergence phase instead of slewing for minutes */
+		PX4_ERR("[timesync] Hard setting offset.");
+		_time_offset = offset_sample_ns;
+		_time_offset_drift = 0.0;
+		_tsync_converged = false;
+		_tsync_sample_count = 0;
+		return;
+	}
+
+	/* PI controller: the proportional term tracks the phase error, the
+	 * integral term absorbs the constant drift between the clocks so
+	 * the phase error stays centered on zero */
+	_time_offset_drift += TIMESYNC_GAIN_I * (double)error;
+	_time_offset += (int64_t)(TIMESYNC_GAIN_P * (double)error + _time_offset_drift);
+}
 
-	_time_offset = (_time_offset_avg_alpha * offset_ns) + (1.0 - _time_offset_avg_alpha) * _time_offset;
+void MavlinkReceiver::record_rtt(uint32_t rtt_us)
+{
+	unsigned bucket = RTT_BUCKET_COUNT - 1;
+
+	for (unsigned i = 0; i < RTT_BUCKET_COUNT - 1; i++) {
+		if (rtt_us < _rtt_bucket_bounds_us[i]) {
+			bucket = i;
+			break;
+		}
+	}
+
+	_rtt_hist[bucket]++;
+
+	if (_rtt_count == 0 || rtt_us < _rtt_min_us) {
+		_rtt_min_us = rtt_us;
+	}
+
+	if (rtt_us > _rtt_max_us) {
+		_rtt_max_us = rtt_us;
+	}
+
+	_rtt_count++;
+	_rtt_avg_us += ((float)rtt_us - _rtt_avg_us) * 0.05f;
+}
+
+void MavlinkReceiver::check_timesync()
+{
+	if (!_tsync_peer_seen) {
+		return;
+	}
+
+	const hrt_abstime now = hrt_absolute_time();
+
+	if (now - _tsync_last_request_time < TIMESYNC_SEND_INTERVAL) {
+		return;
+	}
+
+	mavlink_timesync_t tsync;
+	tsync.tc1 = 0;
+	tsync.ts1 = now * 1000ULL;
+
+	mavlink_msg_timesync_send_struct(_mavlink->get_channel(), &tsync);
+
+	/* an outstanding request that was never answered is simply replaced */
+	_tsync_request_ts1 = tsync.ts1;
+	_tsync_last_request_time = now;
 }
 
 
@@ -2671,8 +2945,14 @@ void *MavlinkReceiver::start_helper(void *context)
 		return nullptr;
 	}
 
+	/* register with the parent so 'mavlink status' can show the
+	 * receiver side (timesync offset, RTT statistics) */
+	((Mavlink *)context)->set_receiver(rcv);
+
 	void *ret = rcv->receive_thread(nullptr);
 
+	((Mavlink *)context)->set_receiver(nullptr);
+
 	delete rcv;
 
 	return ret;
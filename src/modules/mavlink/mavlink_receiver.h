@@ -58,6 +58,7 @@
 #include <uORB/topics/vehicle_local_position_setpoint.h>
 #include <uORB/topics/position_setpoint_triplet.h>
 #include <uORB/topics/att_pos_mocap.h>
+#include <uORB/topics/rates_setpoint_queue.h>
 #include <uORB/topics/vehicle_attitude_setpoint.h>
 #include <uORB/topics/vehicle_rates_setpoint.h>
 #include <uORB/topics/optical_flow.h>
@@ -138,6 +139,7 @@ private:
 	void handle_message_rc_channels_override(mavlink_message_t *msg);
 	void handle_message_heartbeat(mavlink_message_t *msg);
 	void handle_message_ping(mavlink_message_t *msg);
+	void handle_message_setup_signing(mavlink_message_t *msg);
 	void handle_message_request_data_stream(mavlink_message_t *msg);
 	void handle_message_system_time(mavlink_message_t *msg);
 	void handle_message_timesync(mavlink_message_t *msg);
@@ -157,6 +159,22 @@ private:
 	void handle_message_debug(mavlink_message_t *msg);
 	void handle_message_debug_vect(mavlink_message_t *msg);
 
+	/**
+	 * One entry of the msgid-indexed dispatch table. The table replaces the
+	 * switch in handle_message() and is binary searched, so it must be sorted
+	 * by ascending msgid.
+	 */
+	struct MessageHandler {
+		uint16_t msgid;
+		bool check_accepting_commands;	/**< only dispatch while the link accepts commands */
+		void (MavlinkReceiver::*handler)(mavlink_message_t *msg);
+	};
+
+	static const MessageHandler _message_handlers[];
+	static const unsigned _message_handler_count;
+	static bool _message_handlers_checked;	/**< table sort order verified once at construction */
+	static bool _message_handlers_sorted;
+
 	void *receive_thread(void *arg);
 
 	/**
@@ -179,9 +197,27 @@ private:
 	uint64_t sync_stamp(uint64_t usec);
 
 	/**
-	 * Exponential moving average filter to smooth time offset
+	 * Append the current rate setpoint to the future-dated setpoint queue
+	 * and publish it for on-time execution by the rate controller
+	 */
+	void queue_rates_setpoint(uint64_t exec_time);
+
+	/**
+	 * Feed one offset observation into the PI offset filter.
+	 */
+	void update_time_offset(int64_t offset_sample_ns);
+
+	/**
+	 * Record the round trip time of a locally initiated timesync
+	 * exchange in the per-link statistics.
 	 */
-	void smooth_time_offset(int64_t offset_ns);
+	void record_rtt(uint32_t rtt_us);
+
+	/**
+	 * Initiate a timesync exchange when the peer speaks TIMESYNC and
+	 * the send interval has elapsed.
+	 */
+	void check_timesync();
 
 	/**
 	 * Decode a switch position from a bitfield
@@ -197,6 +233,19 @@ private:
 
 	void send_flight_information();
 
+	/**
+	 * Check whether a command gets the low-latency ack fast path
+	 * (command-to-ack latency bounded by the receive loop poll timeout
+	 * instead of the main loop rate).
+	 */
+	static bool command_is_time_critical(uint16_t command);
+
+	/**
+	 * Send the ack for a pending time-critical command directly from the
+	 * receive thread as soon as the handler module publishes it.
+	 */
+	void check_fast_command_ack();
+
 	Mavlink	*_mavlink;
 
 	MavlinkMissionManager		_mission_manager;
@@ -230,6 +279,7 @@ private:
 	orb_advert_t _global_vel_sp_pub;
 	orb_advert_t _att_sp_pub;
 	orb_advert_t _rates_sp_pub;
+	orb_advert_t _rates_sp_queue_pub;
 	orb_advert_t _force_sp_pub;
 	orb_advert_t _pos_sp_triplet_pub;
 	orb_advert_t _att_pos_mocap_pub;
@@ -252,6 +302,9 @@ private:
 	orb_advert_t _command_ack_pub;
 	int _control_mode_sub;
 	int _actuator_armed_sub;
+	int _command_ack_sub;
+	uint16_t _fast_ack_command;	///< time-critical command awaiting its ack, 0 if none
+	uint64_t _fast_ack_deadline;
 	uint64_t _global_ref_timestamp;
 	int _hil_frames;
 	uint64_t _old_timestamp;
@@ -261,8 +314,24 @@ private:
 	struct offboard_control_mode_s _offboard_control_mode;
 	struct vehicle_attitude_setpoint_s _att_sp;
 	struct vehicle_rates_setpoint_s _rates_sp;
-	double _time_offset_avg_alpha;
+	struct rates_setpoint_queue_s _rates_sp_queue;
 	int64_t _time_offset;
+	double _time_offset_drift;	///< integral term of the offset PI filter, ns per sample
+	bool _tsync_converged;		///< the PI filter has locked on to the peer clock
+	unsigned _tsync_sample_count;
+	bool _tsync_peer_seen;		///< the peer on this link speaks TIMESYNC
+	uint64_t _tsync_request_ts1;	///< ts1 of the outstanding local request in ns, 0 if none
+	uint64_t _tsync_last_request_time;
+
+	/* per-link RTT statistics from locally initiated exchanges */
+	static constexpr unsigned RTT_BUCKET_COUNT = 7;
+	static const uint32_t _rtt_bucket_bounds_us[RTT_BUCKET_COUNT - 1];
+	uint32_t _rtt_hist[RTT_BUCKET_COUNT];
+	uint32_t _rtt_count;
+	uint32_t _rtt_min_us;
+	uint32_t _rtt_max_us;
+	float _rtt_avg_us;
+	uint32_t _rtt_reject_count;	///< offset samples discarded for excessive RTT
 	int	_orb_class_instance;
 
 	static constexpr unsigned MOM_SWITCH_COUNT = 8;
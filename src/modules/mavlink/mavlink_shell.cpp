@@ -43,6 +43,7 @@
 
 #include <unistd.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/ioctl.h>
 
 
@@ -106,6 +107,11 @@ int MavlinkShell::start()
 	_shell_fds[0]  = p2[0];
 	_shell_fds[1] = p1[1];
 
+	/* the mavlink side must never block on the shell: input that does not
+	 * fit into the pipe is buffered and flushed from the send loop */
+	fcntl(_from_shell_fd, F_SETFL, fcntl(_from_shell_fd, F_GETFL) | O_NONBLOCK);
+	fcntl(_to_shell_fd, F_SETFL, fcntl(_to_shell_fd, F_GETFL) | O_NONBLOCK);
+
 	int fd_backups[2]; //we don't touch stderr, we will redirect it to stdout in the startup of the shell task
 
 	for (int i = 0; i < 2; ++i) {
@@ -161,12 +167,67 @@ int MavlinkShell::shell_start_thread(int argc, char *argv[])
 
 size_t MavlinkShell::write(uint8_t *buffer, size_t len)
 {
-	return ::write(_to_shell_fd, buffer, len);
+	/* producer side of the ring: runs on the receiver thread */
+	size_t head = _write_head;
+	const size_t tail = __atomic_load_n(&_write_tail, __ATOMIC_ACQUIRE);
+
+	size_t written = 0;
+
+	if (head == tail) {
+		/* nothing buffered: try the pipe directly to keep the input in order */
+		ssize_t ret = ::write(_to_shell_fd, buffer, len);
+
+		if (ret > 0) {
+			written = ret;
+		}
+	}
+
+	/* buffer whatever the pipe did not take (one slot stays free to
+	 * distinguish a full ring from an empty one) */
+	while (written < len && (head + 1) % WRITE_BUFFER_LEN != tail) {
+		_write_buffer[head] = buffer[written];
+		head = (head + 1) % WRITE_BUFFER_LEN;
+		++written;
+	}
+
+	__atomic_store_n(&_write_head, head, __ATOMIC_RELEASE);
+
+	return written;
+}
+
+void MavlinkShell::flush_write_buffer()
+{
+	if (_write_tail != __atomic_load_n(&_write_head, __ATOMIC_ACQUIRE)) {
+		drain_write_buffer();
+	}
+}
+
+void MavlinkShell::drain_write_buffer()
+{
+	/* consumer side of the ring: runs on the mavlink send task */
+	size_t tail = _write_tail;
+	const size_t head = __atomic_load_n(&_write_head, __ATOMIC_ACQUIRE);
+
+	while (tail != head) {
+		const size_t contiguous = (head > tail) ? head - tail : WRITE_BUFFER_LEN - tail;
+
+		ssize_t ret = ::write(_to_shell_fd, _write_buffer + tail, contiguous);
+
+		if (ret <= 0) {
+			break;
+		}
+
+		tail = (tail + ret) % WRITE_BUFFER_LEN;
+	}
+
+	__atomic_store_n(&_write_tail, tail, __ATOMIC_RELEASE);
 }
 
 size_t MavlinkShell::read(uint8_t *buffer, size_t len)
 {
-	return ::read(_from_shell_fd, buffer, len);
+	ssize_t ret = ::read(_from_shell_fd, buffer, len);
+
+	return (ret > 0) ? ret : 0;
 }
 
 size_t MavlinkShell::available()
@@ -61,13 +61,18 @@ public:
 
 
 	/**
-	 * Write to the shell
-	 * @return number of written bytes
+	 * Write to the shell. The pipe is non-blocking: bytes that do not fit
+	 * are kept in an internal buffer and flushed from the mavlink send
+	 * loop via flush_write_buffer(), so a caller (the receiver thread)
+	 * is never blocked on shell input.
+	 * @return number of accepted bytes (can be less than len if the
+	 *         internal buffer overflows as well)
 	 */
 	size_t write(uint8_t *buffer, size_t len);
 
 	/**
-	 * Read from the shell. This is blocking, if 0 bytes are available, this will block.
+	 * Read from the shell. The pipe is non-blocking, 0 is returned if
+	 * no bytes are available.
 	 * @param len buffer length
 	 * @return number of bytes read.
 	 */
@@ -78,13 +83,32 @@ public:
 	 */
 	size_t available();
 
+	/**
+	 * Push buffered input into the shell. Called periodically from the
+	 * mavlink send loop.
+	 */
+	void flush_write_buffer();
+
 private:
 
+	/**
+	 * Write as much of the internal buffer to the pipe as fits.
+	 */
+	void drain_write_buffer();
+
 	int _to_shell_fd = -1; /** fd to write to the shell */
 	int _from_shell_fd = -1; /** fd to read from the shell */
 	int _shell_fds[2] = { -1, -1}; /** stdin & out used by the shell */
 	px4_task_t _task;
 
+	/* single-producer single-consumer ring for input the shell pipe could
+	 * not take: the receiver thread only advances the head, the send loop
+	 * only advances the tail, so no index is written from both threads */
+	static constexpr size_t WRITE_BUFFER_LEN = 256;
+	uint8_t _write_buffer[WRITE_BUFFER_LEN];
+	size_t _write_head = 0; ///< next byte goes here, written by write() only
+	size_t _write_tail = 0; ///< oldest buffered byte, written by drain_write_buffer() only
+
 	static int shell_start_thread(int argc, char *argv[]);
 
 	/* do not allow copying this class */
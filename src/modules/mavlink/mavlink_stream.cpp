@@ -56,6 +56,24 @@ MavlinkStream::~MavlinkStream()
 {
 }
 
+void *
+MavlinkStream::operator new(size_t size, Mavlink *mavlink) noexcept
+{
+	return mavlink->instance_alloc(size);
+}
+
+void
+MavlinkStream::operator delete(void *ptr) noexcept
+{
+	Mavlink::instance_free(ptr);
+}
+
+void
+MavlinkStream::operator delete(void *ptr, Mavlink *mavlink) noexcept
+{
+	Mavlink::instance_free(ptr);
+}
+
 /**
  * Set messages interval in ms
  */
@@ -65,6 +83,56 @@ MavlinkStream::set_interval(const int interval)
 	_interval = interval;
 }
 
+/**
+ * The global multiplier from the bandwidth governor shapes all
+ * adjustable streams; high priority streams are held at full rate
+ * until the link is down to half capacity, bulk streams absorb a
+ * correspondingly larger share of the cut.
+ */
+float
+MavlinkStream::applied_rate_mult()
+{
+	const float mult = _mavlink->get_rate_mult();
+
+	switch (priority()) {
+	case PRIORITY_HIGH:
+		/* keep full rate until the link is at half capacity */
+		return (mult < 0.5f) ? (2.0f * mult) : 1.0f;
+
+	case PRIORITY_BULK:
+		/* absorb the bandwidth handed to the high priority streams */
+		return mult * mult;
+
+	default:
+		return mult;
+	}
+}
+
+hrt_abstime
+MavlinkStream::get_next_due()
+{
+	// never sent before: due immediately
+	if (_last_sent == 0) {
+		return 0;
+	}
+
+	int interval = (_interval > 0) ? _interval : 0;
+
+	if (!const_rate()) {
+		interval /= applied_rate_mult();
+	}
+
+	// unlimited rate: due on every iteration
+	if (interval <= 0) {
+		return 0;
+	}
+
+	// mirror the early-send margin used in update()
+	const int margin = (_mavlink->get_main_loop_delay() / 10) * 3;
+
+	return _last_sent + ((interval > margin) ? (interval - margin) : 0) + 1;
+}
+
 /**
  * Update subscriptions and send message if necessary
  */
@@ -94,7 +162,7 @@ MavlinkStream::update(const hrt_abstime t)
 	int interval = (_interval > 0) ? _interval : 0;
 
 	if (!const_rate()) {
-		interval /= _mavlink->get_rate_mult();
+		interval /= applied_rate_mult();
 	}
 
 	// Send the message if it is due or
@@ -41,6 +41,8 @@
 #ifndef MAVLINK_STREAM_H_
 #define MAVLINK_STREAM_H_
 
+#include <stddef.h>
+
 #include <drivers/drv_hrt.h>
 
 class Mavlink;
@@ -54,6 +56,12 @@ public:
 	MavlinkStream(Mavlink *mavlink);
 	virtual ~MavlinkStream();
 
+	/* Streams are placement-allocated from the owning instance's arena
+	 * (@see Mavlink::instance_alloc()) to avoid per-object heap traffic */
+	void *operator new(size_t size, Mavlink *mavlink) noexcept;
+	void operator delete(void *ptr) noexcept;
+	void operator delete(void *ptr, Mavlink *mavlink) noexcept;
+
 	/**
 	 * Get the interval
 	 *
@@ -72,6 +80,13 @@ public:
 	 * @return 0 if updated / sent, -1 if unchanged
 	 */
 	int update(const hrt_abstime t);
+
+	/**
+	 * Time at which this stream is next due for sending, matching the
+	 * deadline logic in update(). Used by the deadline-ordered stream
+	 * scheduler in Mavlink. 0 means due immediately.
+	 */
+	hrt_abstime get_next_due();
 	virtual const char *get_name() const = 0;
 	virtual uint16_t get_id() = 0;
 
@@ -80,6 +95,24 @@ public:
 	 */
 	virtual bool const_rate() { return false; }
 
+	/**
+	 * Priority class used by the bandwidth governor.
+	 *
+	 * When the link saturates the rate multiplier is applied per
+	 * class: high priority streams keep their configured rate until
+	 * the link is severely congested, bulk streams degrade first.
+	 */
+	enum Priority {
+		PRIORITY_HIGH = 0,
+		PRIORITY_DEFAULT,
+		PRIORITY_BULK
+	};
+
+	/**
+	 * @return the priority class of this stream
+	 */
+	virtual enum Priority priority() { return PRIORITY_DEFAULT; }
+
 	/**
 	 * Get maximal total messages size on update
 	 */
@@ -99,6 +132,12 @@ protected:
 	Mavlink     *_mavlink;
 	int _interval;		///< if set to negative value = unlimited rate
 
+	/**
+	 * Rate multiplier applied to this stream, scaled by its
+	 * priority class.
+	 */
+	float applied_rate_mult();
+
 #ifndef __PX4_QURT
 	virtual bool send(const hrt_abstime t) = 0;
 #endif
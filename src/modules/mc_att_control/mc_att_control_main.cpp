@@ -79,6 +79,7 @@
 #include <uORB/topics/sensor_gyro.h>
 #include <uORB/topics/vehicle_attitude_setpoint.h>
 #include <uORB/topics/vehicle_control_mode.h>
+#include <uORB/topics/rates_setpoint_queue.h>
 #include <uORB/topics/vehicle_rates_setpoint.h>
 #include <uORB/topics/vehicle_status.h>
 #include <uORB/uORB.h>
@@ -103,6 +104,9 @@ extern "C" __EXPORT int mc_att_control_main(int argc, char *argv[]);
 
 #define MAX_GYRO_COUNT 3
 
+/* how long the last queued future-dated rate setpoint is held after the queue runs dry */
+#define RATES_SP_QUEUE_TIMEOUT 100000	/* usec */
+
 class MulticopterAttitudeControl
 {
 public:
@@ -131,6 +135,7 @@ private:
 	int		_ctrl_state_sub;		/**< control state subscription */
 	int		_v_att_sp_sub;			/**< vehicle attitude setpoint subscription */
 	int		_v_rates_sp_sub;		/**< vehicle rates setpoint subscription */
+	int		_rates_sp_queue_sub;	/**< future-dated rates setpoint queue subscription */
 	int		_v_control_mode_sub;	/**< vehicle control mode subscription */
 	int		_params_sub;			/**< parameter updates subscription */
 	int		_manual_control_sp_sub;	/**< manual control setpoint subscription */
@@ -156,6 +161,7 @@ private:
 	struct control_state_s				_ctrl_state;		/**< control state */
 	struct vehicle_attitude_setpoint_s	_v_att_sp;			/**< vehicle attitude setpoint */
 	struct vehicle_rates_setpoint_s		_v_rates_sp;		/**< vehicle rates setpoint */
+	struct rates_setpoint_queue_s		_rates_sp_queue;	/**< future-dated rates setpoints */
 	struct manual_control_setpoint_s	_manual_control_sp;	/**< manual control setpoint */
 	struct vehicle_control_mode_s		_v_control_mode;	/**< vehicle control mode */
 	struct actuator_controls_s			_actuators;			/**< actuator controls */
@@ -287,8 +293,11 @@ private:
 
 	/**
 	 * Update our local parameter cache.
+	 *
+	 * @param changed_param	handle of the parameter that triggered the refresh,
+	 *			UINT32_MAX to refresh unconditionally
 	 */
-	int			parameters_update();
+	int			parameters_update(uint32_t changed_param = UINT32_MAX);
 
 	/**
 	 * Check for parameter update and handle it.
@@ -315,6 +324,19 @@ private:
 	 */
 	void		vehicle_rates_setpoint_poll();
 
+	/**
+	 * Check for future-dated rates setpoint queue updates.
+	 */
+	void		rates_setpoint_queue_poll();
+
+	/**
+	 * Interpolate the queued future-dated rate setpoints at the current time.
+	 *
+	 * @return false if the queue is empty or expired and the regular rates
+	 *         setpoint should be used instead
+	 */
+	bool		interpolate_queued_rates_setpoint();
+
 	/**
 	 * Check for arming status updates.
 	 */
@@ -385,6 +407,7 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 	/* subscriptions */
 	_ctrl_state_sub(-1),
 	_v_att_sp_sub(-1),
+	_rates_sp_queue_sub(-1),
 	_v_control_mode_sub(-1),
 	_params_sub(-1),
 	_manual_control_sp_sub(-1),
@@ -410,6 +433,7 @@ MulticopterAttitudeControl::MulticopterAttitudeControl() :
 	_ctrl_state{},
 	_v_att_sp{},
 	_v_rates_sp{},
+	_rates_sp_queue{},
 	_manual_control_sp{},
 	_v_control_mode{},
 	_actuators{},
@@ -565,8 +589,14 @@ MulticopterAttitudeControl::~MulticopterAttitudeControl()
 }
 
 int
-MulticopterAttitudeControl::parameters_update()
+MulticopterAttitudeControl::parameters_update(uint32_t changed_param)
 {
+	/* skip the refresh entirely when the notification names a parameter we don't use */
+	if (!param_in_set(changed_param, (const param_t *)&_params_handles,
+			  sizeof(_params_handles) / sizeof(param_t))) {
+		return OK;
+	}
+
 	float v;
 
 	float roll_tc, pitch_tc;
@@ -686,7 +716,7 @@ MulticopterAttitudeControl::parameter_update_poll()
 	if (updated) {
 		struct parameter_update_s param_update;
 		orb_copy(ORB_ID(parameter_update), _params_sub, &param_update);
-		parameters_update();
+		parameters_update(param_update.changed_param);
 	}
 }
 
@@ -740,6 +770,67 @@ MulticopterAttitudeControl::vehicle_rates_setpoint_poll()
 	}
 }
 
+void
+MulticopterAttitudeControl::rates_setpoint_queue_poll()
+{
+	/* check if there is a new burst of future-dated setpoints */
+	bool updated;
+	orb_check(_rates_sp_queue_sub, &updated);
+
+	if (updated) {
+		orb_copy(ORB_ID(rates_setpoint_queue), _rates_sp_queue_sub, &_rates_sp_queue);
+	}
+}
+
+bool
+MulticopterAttitudeControl::interpolate_queued_rates_setpoint()
+{
+	uint8_t count = _rates_sp_queue.count;
+
+	if (count > rates_setpoint_queue_s::QUEUE_LENGTH) {
+		count = rates_setpoint_queue_s::QUEUE_LENGTH;
+	}
+
+	if (count == 0) {
+		return false;
+	}
+
+	const uint64_t now = hrt_absolute_time();
+
+	/* the queue has run dry: hold the last entry briefly, then fall back */
+	if (now > _rates_sp_queue.timestamps[count - 1] + RATES_SP_QUEUE_TIMEOUT) {
+		return false;
+	}
+
+	/* find the first entry at or after now */
+	uint8_t next = 0;
+
+	while (next < count - 1 && _rates_sp_queue.timestamps[next] < now) {
+		next++;
+	}
+
+	if (next == 0 || _rates_sp_queue.timestamps[next] <= now) {
+		/* before the first or past the last entry: clamp */
+		_rates_sp(0) = _rates_sp_queue.roll[next];
+		_rates_sp(1) = _rates_sp_queue.pitch[next];
+		_rates_sp(2) = _rates_sp_queue.yaw[next];
+		_thrust_sp = _rates_sp_queue.thrust[next];
+
+	} else {
+		/* linear interpolation between the bracketing entries */
+		const uint8_t prev = next - 1;
+		const float span = (float)(_rates_sp_queue.timestamps[next] - _rates_sp_queue.timestamps[prev]);
+		const float alpha = (float)(now - _rates_sp_queue.timestamps[prev]) / span;
+
+		_rates_sp(0) = _rates_sp_queue.roll[prev] + alpha * (_rates_sp_queue.roll[next] - _rates_sp_queue.roll[prev]);
+		_rates_sp(1) = _rates_sp_queue.pitch[prev] + alpha * (_rates_sp_queue.pitch[next] - _rates_sp_queue.pitch[prev]);
+		_rates_sp(2) = _rates_sp_queue.yaw[prev] + alpha * (_rates_sp_queue.yaw[next] - _rates_sp_queue.yaw[prev]);
+		_thrust_sp = _rates_sp_queue.thrust[prev] + alpha * (_rates_sp_queue.thrust[next] - _rates_sp_queue.thrust[prev]);
+	}
+
+	return true;
+}
+
 void
 MulticopterAttitudeControl::arming_status_poll()
 {
@@ -1088,6 +1179,7 @@ MulticopterAttitudeControl::task_main()
 	 */
 	_v_att_sp_sub = orb_subscribe(ORB_ID(vehicle_attitude_setpoint));
 	_v_rates_sp_sub = orb_subscribe(ORB_ID(vehicle_rates_setpoint));
+	_rates_sp_queue_sub = orb_subscribe(ORB_ID(rates_setpoint_queue));
 	_ctrl_state_sub = orb_subscribe(ORB_ID(control_state));
 	_v_control_mode_sub = orb_subscribe(ORB_ID(vehicle_control_mode));
 	_params_sub = orb_subscribe(ORB_ID(parameter_update));
@@ -1238,10 +1330,16 @@ MulticopterAttitudeControl::task_main()
 				} else {
 					/* attitude controller disabled, poll rates setpoint topic */
 					vehicle_rates_setpoint_poll();
-					_rates_sp(0) = _v_rates_sp.roll;
-					_rates_sp(1) = _v_rates_sp.pitch;
-					_rates_sp(2) = _v_rates_sp.yaw;
-					_thrust_sp = _v_rates_sp.thrust;
+					rates_setpoint_queue_poll();
+
+					/* future-dated setpoints take precedence: they execute
+					 * on-time locally regardless of link jitter */
+					if (!interpolate_queued_rates_setpoint()) {
+						_rates_sp(0) = _v_rates_sp.roll;
+						_rates_sp(1) = _v_rates_sp.pitch;
+						_rates_sp(2) = _v_rates_sp.yaw;
+						_thrust_sp = _v_rates_sp.thrust;
+					}
 				}
 			}
 
@@ -549,6 +549,12 @@ MulticopterPositionControl::parameters_update(bool force)
 		/* update C++ param system */
 		updateParams();
 
+		/* skip the legacy refresh when the notification names a parameter we don't use */
+		if (!force && !param_in_set(param_upd.changed_param, (const param_t *)&_params_handles,
+					    sizeof(_params_handles) / sizeof(param_t))) {
+			return OK;
+		}
+
 		/* update legacy C interface params */
 		param_get(_params_handles.thr_min, &_params.thr_min);
 		param_get(_params_handles.thr_max, &_params.thr_max);
@@ -1192,8 +1198,11 @@ MulticopterPositionControl::control_offboard(float dt)
 
 				} else if (_pos_sp_triplet.current.velocity_frame == position_setpoint_s::VELOCITY_FRAME_BODY_NED) {
 					// Transform velocity command from body frame to NED frame
-					_vel_sp(0) = cosf(_yaw) * _pos_sp_triplet.current.vx - sinf(_yaw) * _pos_sp_triplet.current.vy;
-					_vel_sp(1) = sinf(_yaw) * _pos_sp_triplet.current.vx + cosf(_yaw) * _pos_sp_triplet.current.vy;
+					float yaw_sin;
+					float yaw_cos;
+					math::fast_sincosf(_yaw, yaw_sin, yaw_cos);
+					_vel_sp(0) = yaw_cos * _pos_sp_triplet.current.vx - yaw_sin * _pos_sp_triplet.current.vy;
+					_vel_sp(1) = yaw_sin * _pos_sp_triplet.current.vx + yaw_cos * _pos_sp_triplet.current.vy;
 
 				} else {
 					PX4_WARN("Unknown velocity offboard coordinate frame");
@@ -1991,7 +2000,10 @@ MulticopterPositionControl::calculate_thrust_setpoint(float dt)
 		}
 
 		/* vector of desired yaw direction in XY plane, rotated by PI/2 */
-		math::Vector<3> y_C(-sinf(_att_sp.yaw_body), cosf(_att_sp.yaw_body), 0.0f);
+		float yaw_sp_sin;
+		float yaw_sp_cos;
+		math::fast_sincosf(_att_sp.yaw_body, yaw_sp_sin, yaw_sp_cos);
+		math::Vector<3> y_C(-yaw_sp_sin, yaw_sp_cos, 0.0f);
 
 		if (fabsf(body_z(2)) > FLT_EPSILON) {
 			/* desired body_x axis, orthogonal to body_z */
@@ -2132,8 +2144,8 @@ MulticopterPositionControl::generate_attitude_setpoint(float dt)
 			// use the formula z_roll_pitch_sp = R_tilt * [0;0;1]
 			// R_tilt is computed from_euler; only true if cos(roll) not equal zero
 			// -> valid if roll is not +-pi/2;
-			_att_sp.roll_body = -asinf(z_roll_pitch_sp(1));
-			_att_sp.pitch_body = atan2f(z_roll_pitch_sp(0), z_roll_pitch_sp(2));
+			_att_sp.roll_body = -math::fast_asinf(z_roll_pitch_sp(1));
+			_att_sp.pitch_body = math::fast_atan2f(z_roll_pitch_sp(0), z_roll_pitch_sp(2));
 		}
 
 		/* copy quaternion setpoint to attitude setpoint topic */
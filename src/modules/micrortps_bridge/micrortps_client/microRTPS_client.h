@@ -55,6 +55,8 @@
 #define POLL_MS 1
 #define DEFAULT_RECV_PORT 2019
 #define DEFAULT_SEND_PORT 2020
+#define DEFAULT_SHM_NAME "/micrortps"
+#define DEFAULT_SHM_RING_SIZE (64 * 1024)
 
 void *send(void *data);
 void micrortps_start_topics(struct timespec &begin, int &total_read, uint32_t &received, int &loop);
@@ -62,7 +64,8 @@ void micrortps_start_topics(struct timespec &begin, int &total_read, uint32_t &r
 struct options {
 	enum class eTransports {
 		UART,
-		UDP
+		UDP,
+		SHM
 	};
 	eTransports transport = options::eTransports::UART;
 	char device[64] = DEVICE;
@@ -73,6 +76,8 @@ struct options {
 	int poll_ms = POLL_MS;
 	uint16_t recv_port = DEFAULT_RECV_PORT;
 	uint16_t send_port = DEFAULT_SEND_PORT;
+	char shm_name[64] = DEFAULT_SHM_NAME;
+	uint32_t shm_ring_size = DEFAULT_SHM_RING_SIZE;
 };
 
 extern struct options _options;
@@ -57,7 +57,7 @@ static void usage(const char *name)
 	PRINT_MODULE_USAGE_NAME("micrortps_client", "communication");
 	PRINT_MODULE_USAGE_COMMAND("start");
 
-	PRINT_MODULE_USAGE_PARAM_STRING('t', "UART", "UART|UDP", "Transport protocol", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('t', "UART", "UART|UDP|SHM", "Transport protocol", true);
 	PRINT_MODULE_USAGE_PARAM_STRING('d', "/dev/ttyACM0", "<file:dev>", "Select Serial Device", true);
 	PRINT_MODULE_USAGE_PARAM_INT('b', 460800, 9600, 3000000, "Baudrate", true);
 	PRINT_MODULE_USAGE_PARAM_INT('p', 1, 1, 1000, "Poll timeout for UART in ms", true);
@@ -68,6 +68,8 @@ static void usage(const char *name)
 	PRINT_MODULE_USAGE_PARAM_INT('w', 1, 1, 1000, "Time in ms for which each iteration sleeps", true);
 	PRINT_MODULE_USAGE_PARAM_INT('r', 2019, 0, 65536, "Select UDP Network Port for receiving (local)", true);
 	PRINT_MODULE_USAGE_PARAM_INT('s', 2020, 0, 65536, "Select UDP Network Port for sending (remote)", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('n', "/micrortps", "<name>", "Name of the shared-memory region for SHM", true);
+	PRINT_MODULE_USAGE_PARAM_INT('m', 65536, 4096, 1048576, "Per-direction ring size in bytes for SHM", true);
 
 	PRINT_MODULE_USAGE_COMMAND("stop");
 	PRINT_MODULE_USAGE_COMMAND("status");
@@ -79,10 +81,12 @@ static int parse_options(int argc, char *argv[])
 	int myoptind = 1;
 	const char *myoptarg = nullptr;
 
-	while ((ch = px4_getopt(argc, argv, "t:d:u:l:w:b:p:r:s:", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "t:d:u:l:w:b:p:r:s:n:m:", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 't': _options.transport      = strcmp(myoptarg, "UDP") == 0 ?
 							    options::eTransports::UDP
+							    : strcmp(myoptarg, "SHM") == 0 ?
+							    options::eTransports::SHM
 							    : options::eTransports::UART;      break;
 
 		case 'd': if (nullptr != myoptarg) strcpy(_options.device, myoptarg); break;
@@ -101,6 +105,10 @@ static int parse_options(int argc, char *argv[])
 
 		case 's': _options.send_port      = strtoul(optarg, nullptr, 10);     break;
 
+		case 'n': if (nullptr != myoptarg) strcpy(_options.shm_name, myoptarg); break;
+
+		case 'm': _options.shm_ring_size  = strtoul(myoptarg, nullptr, 10);   break;
+
 		default:
 			usage(argv[1]);
 			return -1;
@@ -143,6 +151,14 @@ static int micrortps_start(int argc, char *argv[])
 		}
 		break;
 
+	case options::eTransports::SHM: {
+			// the flight stack creates the region, the agent attaches to it
+			transport_node = new SHM_node(_options.shm_name, _options.shm_ring_size, true);
+			printf("\nSHM transport: name: %s; ring size: %u bytes; sleep: %dms\n\n",
+			       _options.shm_name, _options.shm_ring_size, _options.sleep_ms);
+		}
+		break;
+
 	default:
 		_rtps_task = -1;
 		printf("EXITING...\n");
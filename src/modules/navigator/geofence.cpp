@@ -42,6 +42,7 @@
 #include "navigator.h"
 
 #include <ctype.h>
+#include <math.h>
 
 #include <dataman/dataman.h>
 #include <drivers/drv_hrt.h>
@@ -74,6 +75,10 @@ Geofence::~Geofence()
 	if (_polygons) {
 		delete[](_polygons);
 	}
+
+	if (_vertices) {
+		delete[](_vertices);
+	}
 }
 
 void Geofence::updateFence()
@@ -183,6 +188,101 @@ void Geofence::_updateFence()
 
 	}
 
+	_cacheFence();
+}
+
+void Geofence::_cacheFence()
+{
+	// count the required cache entries (circles cache their center point)
+	int num_vertices = 0;
+
+	for (int i = 0; i < _num_polygons; ++i) {
+		if (_polygons[i].fence_type == MAV_CMD_NAV_FENCE_CIRCLE_INCLUSION ||
+		    _polygons[i].fence_type == MAV_CMD_NAV_FENCE_CIRCLE_EXCLUSION) {
+			++num_vertices;
+
+		} else {
+			num_vertices += _polygons[i].vertex_count;
+		}
+	}
+
+	if (num_vertices != _num_vertices) {
+		delete[](_vertices);
+		_vertices = nullptr;
+		_num_vertices = 0;
+
+		if (num_vertices > 0) {
+			_vertices = new FenceVertex[num_vertices];
+
+			if (!_vertices) {
+				_num_polygons = 0;
+				PX4_ERR("alloc failed");
+				return;
+			}
+
+			_num_vertices = num_vertices;
+		}
+	}
+
+	int next_vertex = 0;
+
+	for (int i = 0; i < _num_polygons; ++i) {
+		PolygonInfo &polygon = _polygons[i];
+		const bool is_circle_area = polygon.fence_type == MAV_CMD_NAV_FENCE_CIRCLE_INCLUSION ||
+					    polygon.fence_type == MAV_CMD_NAV_FENCE_CIRCLE_EXCLUSION;
+		const unsigned count = is_circle_area ? 1 : polygon.vertex_count;
+
+		polygon.vertex_start = next_vertex;
+		polygon.lat_min = 90.0;
+		polygon.lat_max = -90.0;
+		polygon.lon_min = 180.0;
+		polygon.lon_max = -180.0;
+
+		for (unsigned v = 0; v < count; ++v) {
+			mission_fence_point_s fence_point;
+
+			if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + v, &fence_point,
+				    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
+				PX4_ERR("dm_read failed");
+				// drop this and the following polygons rather than checking against incomplete data
+				_num_polygons = i;
+				return;
+			}
+
+			if (fence_point.frame != MAV_FRAME_GLOBAL && fence_point.frame != MAV_FRAME_GLOBAL_INT
+			    && fence_point.frame != MAV_FRAME_GLOBAL_RELATIVE_ALT
+			    && fence_point.frame != MAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
+				// TODO: handle different frames
+				PX4_ERR("Frame type %i not supported", (int)fence_point.frame);
+				_num_polygons = i;
+				return;
+			}
+
+			FenceVertex &vertex = _vertices[next_vertex++];
+			vertex.lat = fence_point.lat;
+			vertex.lon = fence_point.lon;
+
+			if (vertex.lat < polygon.lat_min) { polygon.lat_min = vertex.lat; }
+
+			if (vertex.lat > polygon.lat_max) { polygon.lat_max = vertex.lat; }
+
+			if (vertex.lon < polygon.lon_min) { polygon.lon_min = vertex.lon; }
+
+			if (vertex.lon > polygon.lon_max) { polygon.lon_max = vertex.lon; }
+		}
+
+		if (is_circle_area) {
+			// expand the bounding box by the circle radius
+			const double radius_deg = (double)polygon.circle_radius / CONSTANTS_RADIUS_OF_EARTH * M_RAD_TO_DEG;
+			const double cos_lat = cos(polygon.lat_min * M_DEG_TO_RAD);
+			const double radius_deg_lon = (cos_lat > 0.01) ? radius_deg / cos_lat : 360.0;
+
+			polygon.lat_min -= radius_deg;
+			polygon.lat_max += radius_deg;
+			polygon.lon_min -= radius_deg_lon;
+			polygon.lon_max += radius_deg_lon;
+		}
+	}
 }
 
 bool Geofence::checkAll(const struct vehicle_global_position_s &global_position)
@@ -302,8 +402,10 @@ bool Geofence::checkPolygons(double lat, double lon, float altitude)
 		_updateFence();
 	}
 
+	// the checks below run on the cached fence data, no need to hold the lock any longer
+	dm_unlock(DM_KEY_FENCE_POINTS);
+
 	if (isEmpty()) {
-		dm_unlock(DM_KEY_FENCE_POINTS);
 		/* Empty fence -> accept all points */
 		return true;
 	}
@@ -311,7 +413,6 @@ bool Geofence::checkPolygons(double lat, double lon, float altitude)
 	/* Vertical check */
 	if (_altitude_max > _altitude_min) { // only enable vertical check if configured properly
 		if (altitude > _altitude_max || altitude < _altitude_min) {
-			dm_unlock(DM_KEY_FENCE_POINTS);
 			return false;
 		}
 	}
@@ -357,46 +458,30 @@ bool Geofence::checkPolygons(double lat, double lon, float altitude)
 		}
 	}
 
-	dm_unlock(DM_KEY_FENCE_POINTS);
-
 	return (!had_inclusion_areas || inside_inclusion) && outside_exclusion;
 }
 
 bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude)
 {
 
+	/* prune polygons whose bounding box does not contain the point */
+	if (lat < polygon.lat_min || lat > polygon.lat_max || lon < polygon.lon_min || lon > polygon.lon_max) {
+		return false;
+	}
+
 	/* Adaptation of algorithm originally presented as
 	 * PNPOLY - Point Inclusion in Polygon Test
 	 * W. Randolph Franklin (WRF)
 	 * Only supports non-complex polygons (not self intersecting)
 	 */
 
-	mission_fence_point_s temp_vertex_i;
-	mission_fence_point_s temp_vertex_j;
+	const FenceVertex *vertices = &_vertices[polygon.vertex_start];
 	bool c = false;
 
 	for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + i, &temp_vertex_i,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
-
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + j, &temp_vertex_j,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
-
-		if (temp_vertex_i.frame != MAV_FRAME_GLOBAL && temp_vertex_i.frame != MAV_FRAME_GLOBAL_INT
-		    && temp_vertex_i.frame != MAV_FRAME_GLOBAL_RELATIVE_ALT
-		    && temp_vertex_i.frame != MAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-			// TODO: handle different frames
-			PX4_ERR("Frame type %i not supported", (int)temp_vertex_i.frame);
-			break;
-		}
-
-		if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-		    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-		     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
+		if ((vertices[i].lon >= lon) != (vertices[j].lon >= lon) &&
+		    (lat <= (vertices[j].lat - vertices[i].lat) * (lon - vertices[i].lon) /
+		     (vertices[j].lon - vertices[i].lon) + vertices[i].lat)) {
 			c = !c;
 		}
 	}
@@ -407,21 +492,12 @@ bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon,
 bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
 {
 
-	mission_fence_point_s circle_point;
-
-	if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index, &circle_point,
-		    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-		PX4_ERR("dm_read failed");
+	/* prune circles whose (radius-expanded) bounding box does not contain the point */
+	if (lat < polygon.lat_min || lat > polygon.lat_max || lon < polygon.lon_min || lon > polygon.lon_max) {
 		return false;
 	}
 
-	if (circle_point.frame != MAV_FRAME_GLOBAL && circle_point.frame != MAV_FRAME_GLOBAL_INT
-	    && circle_point.frame != MAV_FRAME_GLOBAL_RELATIVE_ALT
-	    && circle_point.frame != MAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-		// TODO: handle different frames
-		PX4_ERR("Frame type %i not supported", (int)circle_point.frame);
-		return false;
-	}
+	const FenceVertex &center = _vertices[polygon.vertex_start];
 
 	if (!map_projection_initialized(&_projection_reference)) {
 		map_projection_init(&_projection_reference, lat, lon);
@@ -429,9 +505,9 @@ bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon,
 
 	float x1, y1, x2, y2;
 	map_projection_project(&_projection_reference, lat, lon, &x1, &y1);
-	map_projection_project(&_projection_reference, circle_point.lat, circle_point.lon, &x2, &y2);
+	map_projection_project(&_projection_reference, center.lat, center.lon, &x2, &y2);
 	float dx = x1 - x2, dy = y1 - y2;
-	return dx * dx + dy * dy < circle_point.circle_radius * circle_point.circle_radius;
+	return dx * dx + dy * dy < polygon.circle_radius * polygon.circle_radius;
 }
 
 bool
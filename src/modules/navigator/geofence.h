@@ -149,14 +149,27 @@ private:
 	struct PolygonInfo {
 		uint16_t fence_type; ///< one of MAV_CMD_NAV_FENCE_* (can also be a circular region)
 		uint16_t dataman_index;
+		uint16_t vertex_start; ///< index of the first cached vertex in _vertices (for circles: the center point)
 		union {
 			uint16_t vertex_count;
 			float circle_radius;
 		};
+		/* bounding box in [deg], used to prune containment tests (for circles it includes the radius) */
+		double lat_min;
+		double lat_max;
+		double lon_min;
+		double lon_max;
 	};
 	PolygonInfo *_polygons{nullptr};
 	int _num_polygons{0};
 
+	struct FenceVertex {
+		double lat;
+		double lon;
+	};
+	FenceVertex *_vertices{nullptr}; ///< cached fence vertices, so that checks do not need to access dataman
+	int _num_vertices{0};
+
 	map_projection_reference_s _projection_reference = {}; ///< reference to convert (lon, lat) to local [m]
 
 	/* Params */
@@ -175,6 +188,12 @@ private:
 	 */
 	void _updateFence();
 
+	/**
+	 * Read all fence vertices from dataman into _vertices and compute the per-polygon
+	 * bounding boxes. Must be called with the dataman lock held.
+	 */
+	void _cacheFence();
+
 	/**
 	 * Check if a point passes the Geofence test.
 	 * This takes all polygons and minimum & maximum altitude into account
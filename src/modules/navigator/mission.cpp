@@ -108,6 +108,9 @@ Mission::on_inactive()
 			_navigator->reset_cruising_speed();
 		}
 
+		/* advance a pending feasibility check */
+		check_mission_valid(false);
+
 	} else {
 
 		/* load missions from storage */
@@ -197,9 +200,13 @@ Mission::on_active()
 		offboard_updated = true;
 	}
 
-	/* reset mission items if needed */
-	if (onboard_updated || offboard_updated) {
-		set_mission_items();
+	/* reset mission items if needed, but not before a running feasibility
+	 * check has accepted or rejected the staged mission */
+	if (onboard_updated || offboard_updated || _mission_check_completed) {
+		if (!_mission_check_pending) {
+			_mission_check_completed = false;
+			set_mission_items();
+		}
 	}
 
 	/* lets check if we reached the current mission item */
@@ -303,6 +310,9 @@ Mission::find_offboard_land_start()
 void
 Mission::update_onboard_mission()
 {
+	/* the stored mission may have changed under us */
+	invalidate_prefetch();
+
 	if (orb_copy(ORB_ID(onboard_mission), _navigator->get_onboard_mission_sub(), &_onboard_mission) == OK) {
 		/* accept the current index set by the onboard mission if it is within bounds */
 		if (_onboard_mission.current_seq >= 0
@@ -348,7 +358,8 @@ Mission::update_onboard_mission()
 void
 Mission::update_offboard_mission()
 {
-	bool failed = true;
+	/* the stored mission may have changed under us */
+	invalidate_prefetch();
 
 	if (orb_copy(ORB_ID(offboard_mission), _navigator->get_offboard_mission_sub(), &_offboard_mission) == OK) {
 		// The following is not really a warning, but it can be useful to have this message in the log file
@@ -372,36 +383,21 @@ Mission::update_offboard_mission()
 			/* otherwise, just leave it */
 		}
 
+		/* kick off the feasibility check; the accept/reject bookkeeping runs
+		 * when it completes, which for small missions is before this call
+		 * returns. Large missions are walked incrementally over the next
+		 * cycles so active guidance is not stalled. */
 		check_mission_valid(true);
 
-		failed = !_navigator->get_mission_result()->valid;
-
-		if (!failed) {
-			/* reset mission failure if we have an updated valid mission */
-			_navigator->get_mission_result()->failure = false;
-
-			/* reset reached info as well */
-			_navigator->get_mission_result()->reached = false;
-			_navigator->get_mission_result()->seq_reached = 0;
-			_navigator->get_mission_result()->seq_total = _offboard_mission.count;
-
-			/* reset work item if new mission has been accepted */
-			_work_item_type = WORK_ITEM_TYPE_DEFAULT;
-		}
-
 	} else {
 		PX4_ERR("offboard mission update failed, handle: %d", _navigator->get_offboard_mission_sub());
-	}
 
-	if (failed) {
 		_offboard_mission.count = 0;
 		_offboard_mission.current_seq = 0;
 		_current_offboard_mission_index = 0;
 
-		PX4_ERR("mission check failed");
+		set_current_offboard_mission_item();
 	}
-
-	set_current_offboard_mission_item();
 }
 
 
@@ -848,6 +844,23 @@ Mission::set_mission_items()
 						     pos_sp_triplet->current.lon,
 						     pos_sp_triplet->previous.lat,
 						     pos_sp_triplet->previous.lon);
+
+		/* cache the first order hold altitude ramp of this leg: the waypoint
+		 * geometry is fixed until the next transition, only the distance flown
+		 * along the leg changes per cycle */
+		_foh_acceptance_radius = _navigator->get_acceptance_radius(_mission_item.acceptance_radius);
+
+		const float leg_length = _distance_current_previous - _foh_acceptance_radius;
+
+		if (leg_length > FLT_EPSILON && PX4_ISFINITE(pos_sp_triplet->previous.alt)) {
+			const float delta_alt = get_absolute_altitude_for_item(_mission_item) - pos_sp_triplet->previous.alt;
+			_foh_slope = -delta_alt / leg_length;
+			_foh_intercept = pos_sp_triplet->previous.alt - _foh_slope * _distance_current_previous;
+
+		} else {
+			_foh_slope = 0.0f;
+			_foh_intercept = pos_sp_triplet->previous.alt;
+		}
 	}
 
 	_navigator->set_position_setpoint_triplet_updated();
@@ -1030,17 +1043,16 @@ Mission::heading_sp_update()
 			point_to_latlon[1] = pos_sp_triplet->current.lon;
 		}
 
-		float d_current = get_distance_to_next_waypoint(
-					  point_from_latlon[0], point_from_latlon[1],
-					  point_to_latlon[0], point_to_latlon[1]);
+		/* distance and bearing share their trigonometry, get both in one go */
+		float d_current;
+		float yaw;
+		get_distance_and_bearing_to_next_waypoint(
+			point_from_latlon[0], point_from_latlon[1],
+			point_to_latlon[0], point_to_latlon[1],
+			&d_current, &yaw);
 
 		/* stop if positions are close together to prevent excessive yawing */
 		if (d_current > _navigator->get_acceptance_radius()) {
-			float yaw = get_bearing_to_next_waypoint(
-					    point_from_latlon[0],
-					    point_from_latlon[1],
-					    point_to_latlon[0],
-					    point_to_latlon[1]);
 
 			/* always keep the back of the rotary wing pointing towards home */
 			if (_param_yawmode.get() == MISSION_YAWMODE_BACK_TO_HOME) {
@@ -1074,7 +1086,7 @@ Mission::altitude_sp_foh_update()
 	}
 
 	/* Do not try to find a solution if the last waypoint is inside the acceptance radius of the current one */
-	if (_distance_current_previous - _navigator->get_acceptance_radius(_mission_item.acceptance_radius) < FLT_EPSILON) {
+	if (_distance_current_previous - _foh_acceptance_radius < FLT_EPSILON) {
 		return;
 	}
 
@@ -1103,20 +1115,17 @@ Mission::altitude_sp_foh_update()
 
 	/* if the minimal distance is smaller then the acceptance radius, we should be at waypoint alt
 	 * navigator will soon switch to the next waypoint item (if there is one) as soon as we reach this altitude */
-	if (_min_current_sp_distance_xy < _navigator->get_acceptance_radius(_mission_item.acceptance_radius)) {
+	if (_min_current_sp_distance_xy < _foh_acceptance_radius) {
 		pos_sp_triplet->current.alt = get_absolute_altitude_for_item(_mission_item);
 
 	} else {
 		/* update the altitude sp of the 'current' item in the sp triplet, but do not update the altitude sp
 		 * of the mission item as it is used to check if the mission item is reached
 		 * The setpoint is set linearly and such that the system reaches the current altitude at the acceptance
-		 * radius around the current waypoint
+		 * radius around the current waypoint. The slope and intercept are leg
+		 * constants, cached in set_mission_items()
 		 **/
-		float delta_alt = (get_absolute_altitude_for_item(_mission_item) - pos_sp_triplet->previous.alt);
-		float grad = -delta_alt / (_distance_current_previous - _navigator->get_acceptance_radius(
-						   _mission_item.acceptance_radius));
-		float a = pos_sp_triplet->previous.alt - grad * _distance_current_previous;
-		pos_sp_triplet->current.alt = a + grad * _min_current_sp_distance_xy;
+		pos_sp_triplet->current.alt = _foh_intercept + _foh_slope * _min_current_sp_distance_xy;
 	}
 
 	// we set altitude directly so we can run this in parallel to the heading update
@@ -1277,11 +1286,13 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 		/* read mission item to temp storage first to not overwrite current mission item if data damaged */
 		struct mission_item_s mission_item_tmp;
 
-		/* read mission item from datamanager */
-		if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Waypoint could not be read.");
-			return false;
+		/* read mission item from datamanager, through the prefetch cache when resident */
+		if (!get_prefetched_item(dm_item, *mission_index_ptr, &mission_item_tmp)) {
+			if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
+				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Waypoint could not be read.");
+				return false;
+			}
 		}
 
 		/* check for DO_JUMP item, and whether it hasn't not already been repeated enough times */
@@ -1304,6 +1315,9 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 						return false;
 					}
 
+					/* the stored copy changed, drop the cached one */
+					invalidate_prefetch();
+
 					report_do_jump_mission_changed(*mission_index_ptr, mission_item_tmp.do_jump_repeat_count);
 				}
 
@@ -1323,6 +1337,13 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 		} else {
 			/* if it's not a DO_JUMP, then we were successful */
 			memcpy(mission_item, &mission_item_tmp, sizeof(struct mission_item_s));
+
+			/* keep the upcoming items resident so the next reads do not block on storage */
+			if (offset == 0) {
+				prefetch_mission_items(dm_item, *mission_index_ptr + 1,
+						       (int)mission->count - (*mission_index_ptr + 1));
+			}
+
 			return true;
 		}
 	}
@@ -1332,6 +1353,95 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 	return false;
 }
 
+void
+Mission::prefetch_mission_items(dm_item_t dm_item, int start_index, int count_limit)
+{
+	/* only one read chain in flight at a time */
+	if (_prefetch_pending) {
+		return;
+	}
+
+	/* nothing to do if the window is already resident */
+	if (dm_item == _prefetch_dm_item && start_index == _prefetch_start_index && _prefetch_count > 0) {
+		return;
+	}
+
+	_prefetch_dm_item = dm_item;
+	_prefetch_start_index = start_index;
+	_prefetch_count = 0;
+	_prefetch_invalidated = false;
+	_prefetch_target_count = math::min(count_limit, MISSION_PREFETCH_DEPTH);
+
+	if (_prefetch_target_count <= 0) {
+		return;
+	}
+
+	_prefetch_pending = true;
+
+	if (dm_read_async(dm_item, start_index, &_prefetch_items[0], sizeof(struct mission_item_s),
+			  &Mission::prefetch_item_completion, this) != 0) {
+		_prefetch_pending = false;
+	}
+}
+
+void
+Mission::prefetch_item_completion(ssize_t result, void *arg)
+{
+	/* runs on the dataman worker task */
+	Mission *mission = (Mission *)arg;
+
+	if (mission->_prefetch_invalidated || result != sizeof(struct mission_item_s)) {
+		mission->_prefetch_invalidated = false;
+		mission->_prefetch_count = 0;
+		mission->_prefetch_pending = false;
+		return;
+	}
+
+	/* the slot is filled, publish it */
+	int fetched = mission->_prefetch_count + 1;
+	mission->_prefetch_count = fetched;
+
+	if (fetched >= mission->_prefetch_target_count) {
+		mission->_prefetch_pending = false;
+		return;
+	}
+
+	/* chain the read of the next item */
+	if (dm_read_async(mission->_prefetch_dm_item, mission->_prefetch_start_index + fetched,
+			  &mission->_prefetch_items[fetched], sizeof(struct mission_item_s),
+			  &Mission::prefetch_item_completion, mission) != 0) {
+		mission->_prefetch_pending = false;
+	}
+}
+
+bool
+Mission::get_prefetched_item(dm_item_t dm_item, int index, struct mission_item_s *mission_item)
+{
+	if (dm_item != _prefetch_dm_item) {
+		return false;
+	}
+
+	/* slots below _prefetch_count are complete even while the chain is still running */
+	if (index < _prefetch_start_index || index >= _prefetch_start_index + _prefetch_count) {
+		return false;
+	}
+
+	memcpy(mission_item, &_prefetch_items[index - _prefetch_start_index], sizeof(struct mission_item_s));
+	return true;
+}
+
+void
+Mission::invalidate_prefetch()
+{
+	_prefetch_count = 0;
+	_prefetch_start_index = -1;
+
+	if (_prefetch_pending) {
+		/* tell the in-flight chain to stop */
+		_prefetch_invalidated = true;
+	}
+}
+
 void
 Mission::save_offboard_mission_state()
 {
@@ -1424,13 +1534,57 @@ Mission::check_mission_valid(bool force)
 {
 	if ((!_home_inited && _navigator->home_position_valid()) || force) {
 
-		_navigator->get_mission_result()->valid =
-			_missionFeasibilityChecker.checkMissionFeasible(_offboard_mission, _param_dist_1wp.get(), false);
-
-		_navigator->get_mission_result()->seq_total = _offboard_mission.count;
-		_navigator->increment_mission_instance_count();
-		_navigator->set_mission_result_updated();
+		_missionFeasibilityChecker.startCheck(_offboard_mission, _param_dist_1wp.get(), false);
 		_home_inited = _navigator->home_position_valid();
+		_mission_check_pending = true;
+		_mission_check_from_update = force;
+	}
+
+	if (!_mission_check_pending) {
+		return;
+	}
+
+	/* spread the dataman walk over navigator cycles so a large upload does
+	 * not stall position setpoint updates; small missions complete in the
+	 * first call */
+	if (!_missionFeasibilityChecker.processItems(MISSION_CHECK_ITEMS_PER_CYCLE)) {
+		return;
+	}
+
+	_mission_check_pending = false;
+	_mission_check_completed = true;
+
+	const bool valid = _missionFeasibilityChecker.result();
+	_navigator->get_mission_result()->valid = valid;
+
+	if (_mission_check_from_update) {
+		if (valid) {
+			/* reset mission failure if we have an updated valid mission */
+			_navigator->get_mission_result()->failure = false;
+
+			/* reset reached info as well */
+			_navigator->get_mission_result()->reached = false;
+			_navigator->get_mission_result()->seq_reached = 0;
+
+			/* reset work item if new mission has been accepted */
+			_work_item_type = WORK_ITEM_TYPE_DEFAULT;
+
+		} else {
+			/* reject the staged mission */
+			_offboard_mission.count = 0;
+			_offboard_mission.current_seq = 0;
+			_current_offboard_mission_index = 0;
+
+			PX4_ERR("mission check failed");
+		}
+	}
+
+	_navigator->get_mission_result()->seq_total = _offboard_mission.count;
+	_navigator->increment_mission_instance_count();
+	_navigator->set_mission_result_updated();
+
+	if (_mission_check_from_update) {
+		set_current_offboard_mission_item();
 	}
 }
 
@@ -1481,6 +1635,9 @@ Mission::reset_offboard_mission(struct mission_s &mission)
 	}
 
 	dm_unlock(DM_KEY_MISSION_STATE);
+
+	/* the DO_JUMP counts were rewritten, drop any cached items */
+	invalidate_prefetch();
 }
 
 bool
@@ -190,6 +190,29 @@ private:
 	 */
 	bool read_mission_item(bool onboard, int offset, struct mission_item_s *mission_item);
 
+	/**
+	 * Start fetching the mission items following the current one through the
+	 * asynchronous dataman API so the upcoming reads are served from memory
+	 */
+	void prefetch_mission_items(dm_item_t dm_item, int start_index, int count_limit);
+
+	/**
+	 * Serve a mission item from the prefetch cache
+	 *
+	 * @return true if the cache held the requested item
+	 */
+	bool get_prefetched_item(dm_item_t dm_item, int index, struct mission_item_s *mission_item);
+
+	/**
+	 * Drop the prefetch cache, e.g. after the stored mission has changed
+	 */
+	void invalidate_prefetch();
+
+	/**
+	 * Completion handler for the prefetch reads, runs on the dataman worker task
+	 */
+	static void prefetch_item_completion(ssize_t result, void *arg);
+
 	/**
 	 * Save current offboard mission state to dataman
 	 */
@@ -249,6 +272,16 @@ private:
 
 	int _current_onboard_mission_index{-1};
 	int _current_offboard_mission_index{-1};
+
+	static const int MISSION_PREFETCH_DEPTH = 5;	/**< number of upcoming mission items kept resident */
+
+	struct mission_item_s _prefetch_items[MISSION_PREFETCH_DEPTH] {};
+	dm_item_t _prefetch_dm_item{DM_KEY_NUM_KEYS};
+	int _prefetch_start_index{-1};
+	volatile int _prefetch_count{0};		/**< number of valid items in the cache */
+	volatile int _prefetch_target_count{0};
+	volatile bool _prefetch_pending{false};		/**< an asynchronous read chain is in flight */
+	volatile bool _prefetch_invalidated{false};	/**< tells the in-flight chain to stop */
 	bool _need_takeoff{true};					/**< if true, then takeoff must be performed before going to the first waypoint (if needed) */
 
 	enum {
@@ -261,6 +294,12 @@ private:
 	bool _home_inited{false};
 	bool _need_mission_reset{false};
 
+	static const unsigned MISSION_CHECK_ITEMS_PER_CYCLE = 30;	/**< feasibility-check dataman reads per navigator cycle */
+
+	bool _mission_check_pending{false};	/**< an incremental feasibility check is running */
+	bool _mission_check_from_update{false};	/**< the running check was triggered by a mission update */
+	bool _mission_check_completed{false};	/**< tells on_active() to reload the mission items */
+
 	MissionFeasibilityChecker _missionFeasibilityChecker; /**< class that checks if a mission is feasible */
 
 	float _min_current_sp_distance_xy{FLT_MAX}; /**< minimum distance which was achieved to the current waypoint  */
@@ -268,6 +307,13 @@ private:
 	float _distance_current_previous{0.0f}; /**< distance from previous to current sp in pos_sp_triplet,
 					    only use if current and previous are valid */
 
+	/* first order hold altitude constants of the active leg, cached at the
+	 * waypoint transition so that per cycle only the vehicle-relative distance
+	 * needs to be evaluated */
+	float _foh_acceptance_radius{0.0f};	/**< acceptance radius of the current mission item */
+	float _foh_slope{0.0f};			/**< altitude change per meter of remaining distance to the current wp */
+	float _foh_intercept{0.0f};		/**< together with _foh_slope defines the altitude ramp of the leg */
+
 	enum work_item_type {
 		WORK_ITEM_TYPE_DEFAULT,		/**< default mission item */
 		WORK_ITEM_TYPE_TAKEOFF,		/**< takeoff before moving to waypoint */
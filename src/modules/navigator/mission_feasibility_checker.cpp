@@ -54,271 +54,243 @@ bool
 MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission, float max_waypoint_distance,
 		bool land_start_req)
 {
-	dm_item_t dm_current = DM_KEY_WAYPOINTS_OFFBOARD(mission.dataman_id);
-	const size_t nMissionItems = mission.count;
-
-	const bool isRotarywing = (_navigator->get_vstatus()->is_rotary_wing || _navigator->get_vstatus()->is_vtol);
-
-	Geofence &geofence = _navigator->get_geofence();
-	fw_pos_ctrl_status_s *fw_pos_ctrl_status = _navigator->get_fw_pos_ctrl_status();
-	const float home_alt = _navigator->get_home_position()->alt;
-	const bool home_valid = _navigator->home_position_valid();
-
+	startCheck(mission, max_waypoint_distance, land_start_req);
 
+	while (!processItems(100)) {
+	}
 
-	bool &warning_issued = _navigator->get_mission_result()->warning;
-	const float default_acceptance_rad  = _navigator->get_default_acceptance_radius();
-	const bool landed = _navigator->get_land_detected()->landed;
+	return result();
+}
 
-	bool failed = false;
-	bool warned = false;
+void
+MissionFeasibilityChecker::startCheck(const mission_s &mission, float max_waypoint_distance, bool land_start_req)
+{
+	_dm_current = DM_KEY_WAYPOINTS_OFFBOARD(mission.dataman_id);
+	_num_items = mission.count;
+	_max_dist_1wp = max_waypoint_distance;
+	_land_start_req = land_start_req;
+
+	_is_rotarywing = (_navigator->get_vstatus()->is_rotary_wing || _navigator->get_vstatus()->is_vtol);
+	_home_alt = _navigator->get_home_position()->alt;
+	_home_lat = _navigator->get_home_position()->lat;
+	_home_lon = _navigator->get_home_position()->lon;
+	_home_valid = _navigator->home_position_valid();
+	_default_acceptance_rad = _navigator->get_default_acceptance_radius();
+	_landed = _navigator->get_land_detected()->landed;
+
+	_next_index = 0;
+	_batch_start = 0;
+	_batch_count = 0;
+	_in_progress = true;
+	_failed = false;
+	_dist_1wp_checked = false;
+	_wp_below_home_warned = false;
+	_land_start_found = false;
+	_landing_valid = false;
+	_do_land_start_index = 0;
+	_landing_approach_index = 0;
+	_prev_item = {};
+	_progress_reported = 0;
 
 	// first check if we have a valid position
-	if (!home_valid) {
-		failed = true;
-		warned = true;
+	if (!_home_valid) {
+		_failed = true;
+		_in_progress = false;
+		_navigator->get_mission_result()->warning = true;
 		mavlink_log_info(_navigator->get_mavlink_log_pub(), "Not yet ready for mission, no position lock.");
-
-	} else {
-		const double lat = _navigator->get_home_position()->lat;
-		const double lon = _navigator->get_home_position()->lon;
-
-		failed = failed
-			 || !check_dist_1wp(dm_current, nMissionItems, lat, lon, max_waypoint_distance, warning_issued);
-	}
-
-	// check if all mission item commands are supported
-	failed = failed || !checkMissionItemValidity(dm_current, nMissionItems, landed);
-	failed = failed || !checkGeofence(dm_current, nMissionItems, geofence, home_alt, home_valid);
-	failed = failed || !checkHomePositionAltitude(dm_current, nMissionItems, home_alt, home_valid, warned);
-
-	if (isRotarywing) {
-		failed = failed
-			 || !checkRotarywing(dm_current, nMissionItems, home_alt, home_valid, default_acceptance_rad);
-
-	} else {
-		failed = failed
-			 || !checkFixedwing(dm_current, nMissionItems, fw_pos_ctrl_status, home_alt, home_valid,
-					    default_acceptance_rad, land_start_req);
+		return;
 	}
-
-	return !failed;
 }
 
 bool
-MissionFeasibilityChecker::checkRotarywing(dm_item_t dm_current, size_t nMissionItems,
-		float home_alt, bool home_valid, float default_acceptance_rad)
+MissionFeasibilityChecker::processItems(unsigned max_items)
 {
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(struct mission_item_s);
+	if (!_in_progress) {
+		return true;
+	}
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
+	while (!_failed && _next_index < _num_items && max_items-- > 0) {
+		if (_next_index < _batch_start || _next_index >= _batch_start + _batch_count) {
+			/* fetch the next batch of items in one dataman transaction */
+			size_t num_items = READ_BATCH_SIZE;
 
-		// look for a takeoff waypoint
-		if (missionitem.nav_cmd == NAV_CMD_TAKEOFF) {
-			// make sure that the altitude of the waypoint is at least one meter larger than the acceptance radius
-			// this makes sure that the takeoff waypoint is not reached before we are at least one meter in the air
-			float takeoff_alt = missionitem.altitude_is_relative ? missionitem.altitude : missionitem.altitude - home_alt;
+			if (_num_items - _next_index < num_items) {
+				num_items = _num_items - _next_index;
+			}
 
-			// check if we should use default acceptance radius
-			float acceptance_radius = default_acceptance_rad;
+			ssize_t ret = dm_read_multiple(_dm_current, _next_index, num_items, _batch_buf,
+						       sizeof(struct mission_item_s));
 
-			if (missionitem.acceptance_radius > NAV_EPSILON_POSITION) {
-				acceptance_radius = missionitem.acceptance_radius;
+			if (ret < 1) {
+				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Cannot access SD card");
+				_failed = true;
+				break;
 			}
 
-			if (takeoff_alt - 1.0f < acceptance_radius) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Takeoff altitude too low!");
-				return false;
-			}
+			_batch_start = _next_index;
+			_batch_count = ret;
 		}
-	}
-
-	// all checks have passed
-	return true;
-}
 
-bool
-MissionFeasibilityChecker::checkFixedwing(dm_item_t dm_current, size_t nMissionItems,
-		fw_pos_ctrl_status_s *fw_pos_ctrl_status, float home_alt, bool home_valid,
-		float default_acceptance_rad, bool land_start_req)
-{
-	/* Perform checks and issue feedback to the user for all checks */
-	bool resTakeoff = checkFixedWingTakeoff(dm_current, nMissionItems, home_alt, home_valid, land_start_req);
-	bool resLanding = checkFixedWingLanding(dm_current, nMissionItems, fw_pos_ctrl_status, land_start_req);
+		const struct mission_item_s &missionitem = _batch_buf[_next_index - _batch_start];
 
-	/* Mission is only marked as feasible if all checks return true */
-	return (resTakeoff && resLanding);
-}
+		const size_t i = _next_index++;
 
-bool
-MissionFeasibilityChecker::checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt,
-		bool home_valid)
-{
+		bool ok = checkDistanceFirstWaypoint(missionitem)
+			  && checkMissionItemValidity(missionitem, i)
+			  && checkGeofenceItem(missionitem, i)
+			  && checkHomePositionAltitude(missionitem, i)
+			  && checkTakeoff(missionitem);
 
-	if (geofence.isHomeRequired() && !home_valid) {
-		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position");
-		return false;
-	}
+		if (ok && !_is_rotarywing) {
+			ok = checkFixedWingLandingItem(missionitem, i);
+		}
 
-	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
-	if (geofence.valid()) {
-		for (size_t i = 0; i < nMissionItems; i++) {
-			struct mission_item_s missionitem = {};
-			const ssize_t len = sizeof(missionitem);
+		if (!ok) {
+			_failed = true;
+			break;
+		}
 
-			if (dm_read(dm_current, i, &missionitem, len) != len) {
-				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-				return false;
-			}
+		_prev_item = missionitem;
+	}
 
-			if (missionitem.altitude_is_relative && !home_valid) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position");
-				return false;
-			}
+	if (_failed || _next_index >= _num_items) {
+		if (!_failed) {
+			_failed = !finishCheck();
+		}
 
-			// Geofence function checks against home altitude amsl
-			missionitem.altitude = missionitem.altitude_is_relative ? missionitem.altitude + home_alt : missionitem.altitude;
+		_in_progress = false;
+		return true;
+	}
 
-			if (MissionBlock::item_contains_position(&missionitem) &&
-			    !geofence.check(missionitem)) {
+	/* keep the operator informed during long uploads */
+	const unsigned pct = (_next_index * 100) / _num_items;
 
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %d", i + 1);
-				return false;
-			}
-		}
+	if (_num_items >= 200 && pct >= _progress_reported + 25) {
+		mavlink_log_info(_navigator->get_mavlink_log_pub(), "Checking mission: %u%%", pct);
+		_progress_reported = pct;
 	}
 
-	return true;
+	return false;
 }
 
 bool
-MissionFeasibilityChecker::checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems,
-		float home_alt, bool home_valid, bool &warning_issued, bool throw_error)
+MissionFeasibilityChecker::checkDistanceFirstWaypoint(const mission_item_s &missionitem)
 {
-	/* Check if all waypoints are above the home altitude */
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(struct mission_item_s);
-
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			warning_issued = true;
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
-
-		/* reject relative alt without home set */
-		if (missionitem.altitude_is_relative && !home_valid && MissionBlock::item_contains_position(&missionitem)) {
+	/* check if the first waypoint (with lat/lon) is not too far from home */
+	if (_dist_1wp_checked || _max_dist_1wp <= 0.0f || !MissionBlock::item_contains_position(&missionitem)) {
+		return true;
+	}
 
-			warning_issued = true;
+	_dist_1wp_checked = true;
 
-			if (throw_error) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: No home pos, WP %d uses rel alt", i + 1);
-				return false;
+	/* check distance from current position to item */
+	float dist_to_1wp = get_distance_to_next_waypoint(missionitem.lat, missionitem.lon, _home_lat, _home_lon);
 
-			} else	{
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Warning: No home pos, WP %d uses rel alt", i + 1);
-				return true;
-			}
+	if (dist_to_1wp < _max_dist_1wp) {
+		if (dist_to_1wp > ((_max_dist_1wp * 3) / 2)) {
+			/* allow at 2/3 distance, but warn */
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission entry point very far: %d m.", (int)dist_to_1wp);
+			_navigator->get_mission_result()->warning = true;
 		}
 
-		/* calculate the global waypoint altitude */
-		float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + home_alt : missionitem.altitude;
+		return true;
+	}
 
-		if ((home_alt > wp_alt) && MissionBlock::item_contains_position(&missionitem)) {
+	/* item is too far from home */
+	mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission entry point too far: %dm, %dm max.",
+			     (int)dist_to_1wp, (int)_max_dist_1wp);
+	_navigator->get_mission_result()->warning = true;
+	return false;
+}
 
-			warning_issued = true;
+bool
+MissionFeasibilityChecker::checkMissionItemValidity(const mission_item_s &missionitem, size_t index)
+{
+	// check if we find unsupported items and reject mission if so
+	if (missionitem.nav_cmd != NAV_CMD_IDLE &&
+	    missionitem.nav_cmd != NAV_CMD_WAYPOINT &&
+	    missionitem.nav_cmd != NAV_CMD_LOITER_UNLIMITED &&
+	    missionitem.nav_cmd != NAV_CMD_LOITER_TIME_LIMIT &&
+	    missionitem.nav_cmd != NAV_CMD_RETURN_TO_LAUNCH &&
+	    missionitem.nav_cmd != NAV_CMD_LAND &&
+	    missionitem.nav_cmd != NAV_CMD_TAKEOFF &&
+	    missionitem.nav_cmd != NAV_CMD_LOITER_TO_ALT &&
+	    missionitem.nav_cmd != NAV_CMD_VTOL_TAKEOFF &&
+	    missionitem.nav_cmd != NAV_CMD_VTOL_LAND &&
+	    missionitem.nav_cmd != NAV_CMD_DELAY &&
+	    missionitem.nav_cmd != NAV_CMD_DO_JUMP &&
+	    missionitem.nav_cmd != NAV_CMD_DO_CHANGE_SPEED &&
+	    missionitem.nav_cmd != NAV_CMD_DO_SET_SERVO &&
+	    missionitem.nav_cmd != NAV_CMD_DO_LAND_START &&
+	    missionitem.nav_cmd != NAV_CMD_DO_TRIGGER_CONTROL &&
+	    missionitem.nav_cmd != NAV_CMD_DO_DIGICAM_CONTROL &&
+	    missionitem.nav_cmd != NAV_CMD_IMAGE_START_CAPTURE &&
+	    missionitem.nav_cmd != NAV_CMD_IMAGE_STOP_CAPTURE &&
+	    missionitem.nav_cmd != NAV_CMD_VIDEO_START_CAPTURE &&
+	    missionitem.nav_cmd != NAV_CMD_VIDEO_STOP_CAPTURE &&
+	    missionitem.nav_cmd != NAV_CMD_DO_MOUNT_CONFIGURE &&
+	    missionitem.nav_cmd != NAV_CMD_DO_MOUNT_CONTROL &&
+	    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI &&
+	    missionitem.nav_cmd != NAV_CMD_ROI &&
+	    missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_DIST &&
+	    missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_INTERVAL &&
+	    missionitem.nav_cmd != NAV_CMD_SET_CAMERA_MODE &&
+	    missionitem.nav_cmd != NAV_CMD_DO_VTOL_TRANSITION) {
+
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: item %i: unsupported cmd: %d",
+				     (int)(index + 1), (int)missionitem.nav_cmd);
+		return false;
+	}
 
-			if (throw_error) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Waypoint %d below home", i + 1);
-				return false;
+	/* Check non navigation item */
+	if (missionitem.nav_cmd == NAV_CMD_DO_SET_SERVO) {
 
-			} else	{
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Warning: Waypoint %d below home", i + 1);
-				return true;
-			}
+		/* check actuator number */
+		if (missionitem.params[0] < 0 || missionitem.params[0] > 5) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Actuator number %d is out of bounds 0..5",
+					     (int)missionitem.params[0]);
+			return false;
+		}
+
+		/* check actuator value */
+		if (missionitem.params[1] < -PWM_DEFAULT_MAX || missionitem.params[1] > PWM_DEFAULT_MAX) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(),
+					     "Actuator value %d is out of bounds -PWM_DEFAULT_MAX..PWM_DEFAULT_MAX", (int)missionitem.params[1]);
+			return false;
 		}
 	}
 
+	// check if the mission starts with a land command while the vehicle is landed
+	if (missionitem.nav_cmd == NAV_CMD_LAND && index == 0 && _landed) {
+
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: starts with landing");
+		return false;
+	}
+
 	return true;
 }
 
 bool
-MissionFeasibilityChecker::checkMissionItemValidity(dm_item_t dm_current, size_t nMissionItems, bool landed)
+MissionFeasibilityChecker::checkGeofenceItem(const mission_item_s &missionitem, size_t index)
 {
-	// do not allow mission if we find unsupported item
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
-
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			// not supposed to happen unless the datamanager can't access the SD card, etc.
-			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Cannot access SD card");
-			return false;
-		}
+	Geofence &geofence = _navigator->get_geofence();
 
-		// check if we find unsupported items and reject mission if so
-		if (missionitem.nav_cmd != NAV_CMD_IDLE &&
-		    missionitem.nav_cmd != NAV_CMD_WAYPOINT &&
-		    missionitem.nav_cmd != NAV_CMD_LOITER_UNLIMITED &&
-		    missionitem.nav_cmd != NAV_CMD_LOITER_TIME_LIMIT &&
-		    missionitem.nav_cmd != NAV_CMD_RETURN_TO_LAUNCH &&
-		    missionitem.nav_cmd != NAV_CMD_LAND &&
-		    missionitem.nav_cmd != NAV_CMD_TAKEOFF &&
-		    missionitem.nav_cmd != NAV_CMD_LOITER_TO_ALT &&
-		    missionitem.nav_cmd != NAV_CMD_VTOL_TAKEOFF &&
-		    missionitem.nav_cmd != NAV_CMD_VTOL_LAND &&
-		    missionitem.nav_cmd != NAV_CMD_DELAY &&
-		    missionitem.nav_cmd != NAV_CMD_DO_JUMP &&
-		    missionitem.nav_cmd != NAV_CMD_DO_CHANGE_SPEED &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_SERVO &&
-		    missionitem.nav_cmd != NAV_CMD_DO_LAND_START &&
-		    missionitem.nav_cmd != NAV_CMD_DO_TRIGGER_CONTROL &&
-		    missionitem.nav_cmd != NAV_CMD_DO_DIGICAM_CONTROL &&
-		    missionitem.nav_cmd != NAV_CMD_IMAGE_START_CAPTURE &&
-		    missionitem.nav_cmd != NAV_CMD_IMAGE_STOP_CAPTURE &&
-		    missionitem.nav_cmd != NAV_CMD_VIDEO_START_CAPTURE &&
-		    missionitem.nav_cmd != NAV_CMD_VIDEO_STOP_CAPTURE &&
-		    missionitem.nav_cmd != NAV_CMD_DO_MOUNT_CONFIGURE &&
-		    missionitem.nav_cmd != NAV_CMD_DO_MOUNT_CONTROL &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI &&
-		    missionitem.nav_cmd != NAV_CMD_ROI &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_DIST &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_INTERVAL &&
-		    missionitem.nav_cmd != NAV_CMD_SET_CAMERA_MODE &&
-		    missionitem.nav_cmd != NAV_CMD_DO_VTOL_TRANSITION) {
-
-			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: item %i: unsupported cmd: %d", (int)(i + 1),
-					     (int)missionitem.nav_cmd);
+	/* Check if the mission item is inside the geofence (if we have a valid geofence) */
+	if (geofence.valid()) {
+		if (missionitem.altitude_is_relative && !_home_valid) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position");
 			return false;
 		}
 
-		/* Check non navigation item */
-		if (missionitem.nav_cmd == NAV_CMD_DO_SET_SERVO) {
+		// Geofence function checks against home altitude amsl
+		struct mission_item_s checkitem = missionitem;
+		checkitem.altitude = missionitem.altitude_is_relative ? missionitem.altitude + _home_alt : missionitem.altitude;
 
-			/* check actuator number */
-			if (missionitem.params[0] < 0 || missionitem.params[0] > 5) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Actuator number %d is out of bounds 0..5",
-						     (int)missionitem.params[0]);
-				return false;
-			}
-
-			/* check actuator value */
-			if (missionitem.params[1] < -PWM_DEFAULT_MAX || missionitem.params[1] > PWM_DEFAULT_MAX) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(),
-						     "Actuator value %d is out of bounds -PWM_DEFAULT_MAX..PWM_DEFAULT_MAX", (int)missionitem.params[1]);
-				return false;
-			}
-		}
+		if (MissionBlock::item_contains_position(&checkitem) &&
+		    !geofence.check(checkitem)) {
 
-		// check if the mission starts with a land command while the vehicle is landed
-		if (missionitem.nav_cmd == NAV_CMD_LAND && i == 0 && landed) {
-
-			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: starts with landing");
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %d", index + 1);
 			return false;
 		}
 	}
@@ -327,149 +299,152 @@ MissionFeasibilityChecker::checkMissionItemValidity(dm_item_t dm_current, size_t
 }
 
 bool
-MissionFeasibilityChecker::checkFixedWingTakeoff(dm_item_t dm_current, size_t nMissionItems,
-		float home_alt, bool home_valid, float default_acceptance_rad)
+MissionFeasibilityChecker::checkHomePositionAltitude(const mission_item_s &missionitem, size_t index)
 {
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(struct mission_item_s);
+	if (!MissionBlock::item_contains_position(&missionitem)) {
+		return true;
+	}
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
+	/* warn if relative alt is used without home set */
+	if (missionitem.altitude_is_relative && !_home_valid) {
+		_navigator->get_mission_result()->warning = true;
 
-		// look for a takeoff waypoint
-		if (missionitem.nav_cmd == NAV_CMD_TAKEOFF) {
-			// make sure that the altitude of the waypoint is at least one meter larger than the acceptance radius
-			// this makes sure that the takeoff waypoint is not reached before we are at least one meter in the air
+		if (!_wp_below_home_warned) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Warning: No home pos, WP %d uses rel alt", index + 1);
+			_wp_below_home_warned = true;
+		}
 
-			float takeoff_alt = missionitem.altitude_is_relative
-					    ? missionitem.altitude
-					    : missionitem.altitude - home_alt;
+		return true;
+	}
 
-			// check if we should use default acceptance radius
-			float acceptance_radius = default_acceptance_rad;
+	/* calculate the global waypoint altitude */
+	float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + _home_alt : missionitem.altitude;
 
-			if (missionitem.acceptance_radius > NAV_EPSILON_POSITION) {
-				acceptance_radius = missionitem.acceptance_radius;
-			}
+	if (_home_alt > wp_alt) {
+		_navigator->get_mission_result()->warning = true;
 
-			if (takeoff_alt - 1.0f < acceptance_radius) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Takeoff altitude too low!");
-				return false;
-			}
+		if (!_wp_below_home_warned) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Warning: Waypoint %d below home", index + 1);
+			_wp_below_home_warned = true;
 		}
 	}
 
-	// all checks have passed
 	return true;
 }
 
 bool
-MissionFeasibilityChecker::checkFixedWingLanding(dm_item_t dm_current, size_t nMissionItems,
-		fw_pos_ctrl_status_s *fw_pos_ctrl_status, bool land_start_req)
+MissionFeasibilityChecker::checkTakeoff(const mission_item_s &missionitem)
 {
-	/* Go through all mission items and search for a landing waypoint
-	 * if landing waypoint is found: the previous waypoint is checked to be at a feasible distance and altitude given the landing slope */
+	// look for a takeoff waypoint
+	if (missionitem.nav_cmd == NAV_CMD_TAKEOFF) {
+		// make sure that the altitude of the waypoint is at least one meter larger than the acceptance radius
+		// this makes sure that the takeoff waypoint is not reached before we are at least one meter in the air
+		float takeoff_alt = missionitem.altitude_is_relative
+				    ? missionitem.altitude
+				    : missionitem.altitude - _home_alt;
+
+		// check if we should use default acceptance radius
+		float acceptance_radius = _default_acceptance_rad;
+
+		if (missionitem.acceptance_radius > NAV_EPSILON_POSITION) {
+			acceptance_radius = missionitem.acceptance_radius;
+		}
 
-	bool landing_valid = false;
+		if (takeoff_alt - 1.0f < acceptance_radius) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Takeoff altitude too low!");
+			return false;
+		}
+	}
 
-	bool land_start_found = false;
-	size_t do_land_start_index = 0;
-	size_t landing_approach_index = 0;
+	return true;
+}
 
-	for (size_t i = 0; i < nMissionItems; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(missionitem);
+bool
+MissionFeasibilityChecker::checkFixedWingLandingItem(const mission_item_s &missionitem, size_t index)
+{
+	/* Search for landing waypoints; when one is found, the previous waypoint is
+	 * checked to be at a feasible distance and altitude given the landing slope */
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+	// if DO_LAND_START found then require valid landing AFTER
+	if (missionitem.nav_cmd == NAV_CMD_DO_LAND_START) {
+		if (_land_start_found) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: more than one land start.");
 			return false;
-		}
-
-		// if DO_LAND_START found then require valid landing AFTER
-		if (missionitem.nav_cmd == NAV_CMD_DO_LAND_START) {
-			if (land_start_found) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: more than one land start.");
-				return false;
 
-			} else {
-				land_start_found = true;
-				do_land_start_index = i;
-			}
+		} else {
+			_land_start_found = true;
+			_do_land_start_index = index;
 		}
+	}
 
-		if (missionitem.nav_cmd == NAV_CMD_LAND) {
-			mission_item_s missionitem_previous {};
+	if (missionitem.nav_cmd == NAV_CMD_LAND) {
+		if (index == 0) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: starts with land waypoint.");
+			return false;
+		}
 
-			if (i > 0) {
-				landing_approach_index = i - 1;
+		_landing_approach_index = index - 1;
 
-				if (dm_read(dm_current, landing_approach_index, &missionitem_previous, len) != len) {
-					/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-					return false;
-				}
+		if (!MissionBlock::item_contains_position(&_prev_item)) {
+			// mission item before land doesn't have a position
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: need landing approach.");
+			return false;
+		}
 
-				if (MissionBlock::item_contains_position(&missionitem_previous)) {
-					float wp_distance = get_distance_to_next_waypoint(missionitem_previous.lat, missionitem_previous.lon, missionitem.lat,
-							    missionitem.lon);
+		fw_pos_ctrl_status_s *fw_pos_ctrl_status = _navigator->get_fw_pos_ctrl_status();
 
-					float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, missionitem.altitude,
-							      fw_pos_ctrl_status->landing_horizontal_slope_displacement, fw_pos_ctrl_status->landing_slope_angle_rad);
+		float wp_distance = get_distance_to_next_waypoint(_prev_item.lat, _prev_item.lon, missionitem.lat,
+				    missionitem.lon);
 
-					float wp_distance_req = Landingslope::getLandingSlopeWPDistance(missionitem_previous.altitude, missionitem.altitude,
-								fw_pos_ctrl_status->landing_horizontal_slope_displacement, fw_pos_ctrl_status->landing_slope_angle_rad);
+		float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, missionitem.altitude,
+				      fw_pos_ctrl_status->landing_horizontal_slope_displacement, fw_pos_ctrl_status->landing_slope_angle_rad);
 
-					if (wp_distance > fw_pos_ctrl_status->landing_flare_length) {
-						/* Last wp is before flare region */
+		float wp_distance_req = Landingslope::getLandingSlopeWPDistance(_prev_item.altitude, missionitem.altitude,
+					fw_pos_ctrl_status->landing_horizontal_slope_displacement, fw_pos_ctrl_status->landing_slope_angle_rad);
 
-						const float delta_altitude = missionitem.altitude - missionitem_previous.altitude;
+		if (wp_distance <= fw_pos_ctrl_status->landing_flare_length) {
+			/* Last wp is in flare region */
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: waypoint within landing flare.");
+			return false;
+		}
 
-						if (delta_altitude < 0) {
-							if (missionitem_previous.altitude > slope_alt_req) {
-								/* Landing waypoint is above altitude of slope at the given waypoint distance */
-								mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: adjust landing approach.");
-								mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Move down %.1fm or move further away by %.1fm.",
-										     (double)(slope_alt_req - missionitem_previous.altitude),
-										     (double)(wp_distance_req - wp_distance));
+		const float delta_altitude = missionitem.altitude - _prev_item.altitude;
 
-								return false;
-							}
+		if (delta_altitude >= 0) {
+			/* Landing waypoint is above last waypoint */
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: landing above last waypoint.");
+			return false;
+		}
 
-						} else {
-							/* Landing waypoint is above last waypoint */
-							mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: landing above last waypoint.");
-							return false;
-						}
+		if (_prev_item.altitude > slope_alt_req) {
+			/* Landing waypoint is above altitude of slope at the given waypoint distance */
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: adjust landing approach.");
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Move down %.1fm or move further away by %.1fm.",
+					     (double)(slope_alt_req - _prev_item.altitude),
+					     (double)(wp_distance_req - wp_distance));
 
-					} else {
-						/* Last wp is in flare region */
-						mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: waypoint within landing flare.");
-						return false;
-					}
+			return false;
+		}
 
-					landing_valid = true;
+		_landing_valid = true;
+	}
 
-				} else {
-					// mission item before land doesn't have a position
-					mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: need landing approach.");
-					return false;
-				}
+	return true;
+}
 
-			} else {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: starts with land waypoint.");
-				return false;
-			}
-		}
+bool
+MissionFeasibilityChecker::finishCheck()
+{
+	if (_is_rotarywing) {
+		return true;
 	}
 
-	if (land_start_req && !land_start_found) {
+	if (_land_start_req && !_land_start_found) {
 		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: land start required.");
 		return false;
 	}
 
-	if (land_start_found && (!landing_valid || (do_land_start_index > landing_approach_index))) {
+	if (_land_start_found && (!_landing_valid || (_do_land_start_index > _landing_approach_index))) {
 		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: invalid land start.");
 		return false;
 	}
@@ -477,53 +452,3 @@ MissionFeasibilityChecker::checkFixedWingLanding(dm_item_t dm_current, size_t nM
 	/* No landing waypoints or no waypoints */
 	return true;
 }
-
-bool
-MissionFeasibilityChecker::check_dist_1wp(dm_item_t dm_current, size_t nMissionItems, double curr_lat, double curr_lon,
-		float dist_first_wp, bool &warning_issued)
-{
-	/* check if first waypoint is not too far from home */
-	if (dist_first_wp > 0.0f) {
-		struct mission_item_s mission_item = {};
-
-		/* find first waypoint (with lat/lon) item in datamanager */
-		for (size_t i = 0; i < nMissionItems; i++) {
-			if (dm_read(dm_current, i, &mission_item, sizeof(mission_item_s)) == sizeof(mission_item_s)) {
-				if (MissionBlock::item_contains_position(&mission_item)) {
-					/* check only items with valid lat/lon */
-
-					/* check distance from current position to item */
-					float dist_to_1wp = get_distance_to_next_waypoint(mission_item.lat, mission_item.lon, curr_lat, curr_lon);
-
-					if (dist_to_1wp < dist_first_wp) {
-						if (dist_to_1wp > ((dist_first_wp * 3) / 2)) {
-							/* allow at 2/3 distance, but warn */
-							mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission entry point very far: %d m.", (int)dist_to_1wp);
-							warning_issued = true;
-						}
-
-						return true;
-
-					} else {
-						/* item is too far from home */
-						mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission entry point too far: %dm, %dm max.",
-								     (int)dist_to_1wp, (int)dist_first_wp);
-						warning_issued = true;
-						return false;
-					}
-				}
-
-			} else {
-				/* error reading, mission is invalid */
-				mavlink_log_info(_navigator->get_mavlink_log_pub(), "Error reading offboard mission.");
-				return false;
-			}
-		}
-
-		/* no waypoints found in mission, then we will not fly far away */
-		return true;
-
-	} else {
-		return true;
-	}
-}
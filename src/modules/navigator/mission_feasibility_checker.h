@@ -43,6 +43,7 @@
 #define MISSION_FEASIBILITY_CHECKER_H_
 
 #include <dataman/dataman.h>
+#include <navigator/navigation.h>
 #include <uORB/topics/mission.h>
 #include <uORB/topics/fw_pos_ctrl_status.h>
 
@@ -54,29 +55,51 @@ class MissionFeasibilityChecker
 private:
 	Navigator *_navigator{nullptr};
 
-	/* Checks for all airframes */
-	bool checkGeofence(dm_item_t dm_current, size_t nMissionItems, Geofence &geofence, float home_alt, bool home_valid);
-
-	bool checkHomePositionAltitude(dm_item_t dm_current, size_t nMissionItems, float home_alt, bool home_valid,
-				       bool &warning_issued, bool throw_error = false);
-
-	bool checkMissionItemValidity(dm_item_t dm_current, size_t nMissionItems, bool condition_landed);
-
-	bool check_dist_1wp(dm_item_t dm_current, size_t nMissionItems, double curr_lat, double curr_lon,
-			    float dist_first_wp, bool &warning_issued);
-
-	/* Checks specific to fixedwing airframes */
-	bool checkFixedwing(dm_item_t dm_current, size_t nMissionItems, fw_pos_ctrl_status_s *fw_pos_ctrl_status,
-			    float home_alt, bool home_valid, float default_acceptance_rad, bool land_start_req);
-
-	bool checkFixedWingTakeoff(dm_item_t dm_current, size_t nMissionItems, float home_alt, bool home_valid,
-				   float default_acceptance_rad);
-	bool checkFixedWingLanding(dm_item_t dm_current, size_t nMissionItems, fw_pos_ctrl_status_s *fw_pos_ctrl_status,
-				   bool land_start_req);
-
-	/* Checks specific to rotarywing airframes */
-	bool checkRotarywing(dm_item_t dm_current, size_t nMissionItems,
-			     float home_alt, bool home_valid, float default_acceptance_rad);
+	/* context of the running check, captured in startCheck() */
+	dm_item_t _dm_current{DM_KEY_WAYPOINTS_OFFBOARD_0};
+	size_t _num_items{0};
+	bool _is_rotarywing{false};
+	bool _home_valid{false};
+	bool _landed{false};
+	bool _land_start_req{false};
+	float _home_alt{0.0f};
+	float _default_acceptance_rad{0.0f};
+	float _max_dist_1wp{-1.0f};
+	double _home_lat{0.0};
+	double _home_lon{0.0};
+
+	/* progress of the running check */
+	size_t _next_index{0};
+	bool _in_progress{false};
+	bool _failed{false};
+	bool _dist_1wp_checked{false};
+	bool _wp_below_home_warned{false};
+	bool _land_start_found{false};
+	bool _landing_valid{false};
+	size_t _do_land_start_index{0};
+	size_t _landing_approach_index{0};
+	struct mission_item_s _prev_item {};
+	unsigned _progress_reported{0};		/**< percentage already reported to the GCS */
+
+	/* items are fetched in bulk: one dataman transaction per batch
+	 * instead of one dm_read per item */
+	static constexpr size_t READ_BATCH_SIZE = 8;
+	struct mission_item_s _batch_buf[READ_BATCH_SIZE];
+	size_t _batch_start{0};			/**< index of the first batched item */
+	size_t _batch_count{0};			/**< number of batched items */
+
+	/* per-item checks, applied to each staged item in a single pass */
+	bool checkDistanceFirstWaypoint(const mission_item_s &missionitem);
+	bool checkMissionItemValidity(const mission_item_s &missionitem, size_t index);
+	bool checkGeofenceItem(const mission_item_s &missionitem, size_t index);
+	bool checkHomePositionAltitude(const mission_item_s &missionitem, size_t index);
+	bool checkTakeoff(const mission_item_s &missionitem);
+
+	/* checks specific to fixedwing airframes */
+	bool checkFixedWingLandingItem(const mission_item_s &missionitem, size_t index);
+
+	/* cross-item constraints, evaluated once all items have been seen */
+	bool finishCheck();
 
 public:
 	MissionFeasibilityChecker(Navigator *navigator) : _navigator(navigator) {};
@@ -90,6 +113,32 @@ public:
 	 */
 	bool checkMissionFeasible(const mission_s &mission, float max_waypoint_distance, bool land_start_req);
 
+	/**
+	 * Start an incremental feasibility check of the staged mission items.
+	 *
+	 * The check context (home position, airframe type, geofence) is captured
+	 * here; call processItems() repeatedly to walk the items. A check that is
+	 * already in progress is abandoned and restarted.
+	 */
+	void startCheck(const mission_s &mission, float max_waypoint_distance, bool land_start_req);
+
+	/**
+	 * Process up to max_items staged items of the running check.
+	 *
+	 * Each item is read from dataman once and run through all applicable
+	 * checks, so the cost per call is bounded and the caller can spread a
+	 * large mission over several cycles. Progress on large missions is
+	 * reported via mavlink_log.
+	 *
+	 * @return true when the check has completed (see result())
+	 */
+	bool processItems(unsigned max_items);
+
+	/** @return true while an incremental check is running */
+	bool inProgress() const { return _in_progress; }
+
+	/** @return the outcome of the last completed check */
+	bool result() const { return !_failed; }
 };
 
 #endif /* MISSION_FEASIBILITY_CHECKER_H_ */
@@ -56,6 +56,7 @@
 
 #include <controllib/block/BlockParam.hpp>
 #include <controllib/blocks.hpp>
+#include <drivers/drv_hrt.h>
 #include <navigator/navigation.h>
 #include <systemlib/perf_counter.h>
 #include <uORB/topics/fw_pos_ctrl_status.h>
@@ -250,6 +251,8 @@ private:
 	home_position_s					_home_pos{};		/**< home position for RTL */
 	mission_result_s				_mission_result{};
 	position_setpoint_triplet_s			_pos_sp_triplet{};	/**< triplet of position setpoints */
+	position_setpoint_triplet_s			_pos_sp_triplet_published{};	/**< last published triplet, for change detection */
+	hrt_abstime					_pos_sp_triplet_published_time{0};	/**< time of the last triplet publication */
 	position_setpoint_triplet_s			_reposition_triplet{};	/**< triplet for non-mission direct position command */
 	position_setpoint_triplet_s			_takeoff_triplet{};	/**< triplet for non-mission direct takeoff command */
 	sensor_combined_s				_sensor_combined{};	/**< sensor values */
@@ -46,6 +46,7 @@
 #include "navigator.h"
 
 #include <cfloat>
+#include <cstring>
 
 #include <dataman/dataman.h>
 #include <drivers/drv_hrt.h>
@@ -75,6 +76,7 @@
 extern "C" __EXPORT int navigator_main(int argc, char *argv[]);
 
 #define GEOFENCE_CHECK_INTERVAL 200000
+#define TRIPLET_KEEPALIVE_US 500000
 
 namespace navigator
 {
@@ -743,6 +745,22 @@ Navigator::publish_position_setpoint_triplet()
 		return;
 	}
 
+	/* suppress republication of an unchanged triplet: several modes flag
+	 * the triplet for publication on every cycle and each publication
+	 * wakes the whole position control chain. Compare with the timestamp
+	 * masked out and keep a low-rate keepalive so late subscribers still
+	 * see the topic. */
+	if (_pos_sp_triplet_pub != nullptr
+	    && (_pos_sp_triplet.timestamp - _pos_sp_triplet_published_time) < TRIPLET_KEEPALIVE_US) {
+
+		position_setpoint_triplet_s candidate = _pos_sp_triplet;
+		candidate.timestamp = _pos_sp_triplet_published.timestamp;
+
+		if (memcmp(&candidate, &_pos_sp_triplet_published, sizeof(candidate)) == 0) {
+			return;
+		}
+	}
+
 	/* lazily publish the position setpoint triplet only once available */
 	if (_pos_sp_triplet_pub != nullptr) {
 		orb_publish(ORB_ID(position_setpoint_triplet), _pos_sp_triplet_pub, &_pos_sp_triplet);
@@ -750,6 +768,9 @@ Navigator::publish_position_setpoint_triplet()
 	} else {
 		_pos_sp_triplet_pub = orb_advertise(ORB_ID(position_setpoint_triplet), &_pos_sp_triplet);
 	}
+
+	_pos_sp_triplet_published = _pos_sp_triplet;
+	_pos_sp_triplet_published_time = _pos_sp_triplet.timestamp;
 }
 
 float
@@ -71,6 +71,7 @@
 #include <platforms/px4_defines.h>
 
 #include <terrain_estimation/terrain_estimator.h>
+#include <terrain_estimation/terrain_grid.h>
 #include "position_estimator_inav_params.h"
 #include "inertial_filter.h"
 
@@ -385,6 +386,7 @@ int position_estimator_inav_thread_main(int argc, char *argv[])
 	/* advertise */
 	orb_advert_t vehicle_local_position_pub = orb_advertise(ORB_ID(vehicle_local_position), &local_pos);
 	orb_advert_t vehicle_global_position_pub = nullptr;
+	orb_advert_t terrain_grid_pub = nullptr;
 
 	struct position_estimator_inav_params params;
 	memset(&params, 0, sizeof(params));
@@ -406,6 +408,8 @@ int position_estimator_inav_thread_main(int argc, char *argv[])
 	/* wait for initial baro value */
 	bool wait_baro = true;
 	TerrainEstimator terrain_estimator;
+	TerrainGrid terrain_grid;
+	hrt_abstime terrain_grid_pub_last = 0;
 
 	thread_running = true;
 	hrt_abstime baro_wait_for_sample_time = hrt_absolute_time();
@@ -1359,6 +1363,27 @@ int position_estimator_inav_thread_main(int argc, char *argv[])
 
 			orb_publish(ORB_ID(vehicle_local_position), vehicle_local_position_pub, &local_pos);
 
+			/* feed the local terrain grid (no-op unless a new lidar sample arrived)
+			 * and publish it at low rate */
+			terrain_grid.update(t, &att, &local_pos, &lidar);
+
+			if (t > terrain_grid_pub_last + 500000) {
+				terrain_grid_pub_last = t;
+
+				struct terrain_grid_s tgrid;
+
+				if (terrain_grid.get_grid(&local_pos, &tgrid)) {
+					tgrid.timestamp = t;
+
+					if (terrain_grid_pub == nullptr) {
+						terrain_grid_pub = orb_advertise(ORB_ID(terrain_grid), &tgrid);
+
+					} else {
+						orb_publish(ORB_ID(terrain_grid), terrain_grid_pub, &tgrid);
+					}
+				}
+			}
+
 			if (local_pos.xy_global && local_pos.z_global) {
 				/* publish global position */
 				global_pos.timestamp = t;
@@ -66,6 +66,9 @@ extern "C" {
  * Maximum interval in us before FMU signal is considered lost
  */
 #define FMU_INPUT_DROP_LIMIT_US		500000
+
+/* don't interpolate across control frame gaps longer than this */
+#define FMU_FRAME_INTERVAL_MAX_US	50000
 #define NAN_VALUE	(0.0f/0.0f)
 
 /* current servo arm/disarm state */
@@ -96,6 +99,8 @@ static int	mixer_callback(uintptr_t handle,
 			       uint8_t control_index,
 			       float &control);
 
+static float	fmu_control_sample(unsigned idx);
+
 static int mixer_mix_threadsafe(float *outputs, volatile uint16_t *limits);
 
 static MixerGroup mixer_group(mixer_callback, 0);
@@ -144,6 +149,11 @@ mixer_tick(void)
 		}
 	}
 
+	/* surface the control frame age at the output tick so the FMU side can
+	 * sample the transfer latency distribution */
+	uint64_t fmu_age = hrt_elapsed_time(&system_state.fmu_data_received_time);
+	r_page_status[PX4IO_P_STATUS_FMU_AGE] = (fmu_age > UINT16_MAX) ? UINT16_MAX : fmu_age;
+
 	/* default to failsafe mixing - it will be forced below if flag is set */
 	source = MIX_FAILSAFE;
 
@@ -383,6 +393,46 @@ mixer_tick(void)
 	}
 }
 
+/*
+ * Sample an FMU control value for the current output tick.
+ *
+ * Control frames arrive over serial at a rate decoupled from the output
+ * tick, so consuming just the newest frame quantizes the outputs to the
+ * transfer rate. Instead, project the last two frames forward to the
+ * current time, limited to one frame interval of extrapolation so a
+ * dropped frame cannot run away.
+ */
+static float
+fmu_control_sample(unsigned idx)
+{
+	float cur = REG_TO_FLOAT(r_page_controls[idx]);
+
+	const uint64_t t_cur = system_state.fmu_data_received_time;
+	const uint64_t t_prev = system_state.fmu_data_prev_received_time;
+
+	if ((t_prev == 0) || (t_cur <= t_prev) || (t_cur - t_prev > FMU_FRAME_INTERVAL_MAX_US)) {
+		return cur;
+	}
+
+	const float interval = (float)(t_cur - t_prev);
+	float age = (float)hrt_elapsed_time(&system_state.fmu_data_received_time);
+
+	if (age > interval) {
+		age = interval;
+	}
+
+	float control = cur + (cur - REG_TO_FLOAT(r_page_controls_prev[idx])) * (age / interval);
+
+	if (control > 1.0f) {
+		control = 1.0f;
+
+	} else if (control < -1.0f) {
+		control = -1.0f;
+	}
+
+	return control;
+}
+
 static int
 mixer_callback(uintptr_t handle,
 	       uint8_t control_group,
@@ -396,7 +446,7 @@ mixer_callback(uintptr_t handle,
 	switch (source) {
 	case MIX_FMU:
 		if (control_index < PX4IO_CONTROL_CHANNELS && control_group < PX4IO_CONTROL_GROUPS) {
-			control = REG_TO_FLOAT(r_page_controls[CONTROL_PAGE_INDEX(control_group, control_index)]);
+			control = fmu_control_sample(CONTROL_PAGE_INDEX(control_group, control_index));
 			break;
 		}
 
@@ -418,7 +468,7 @@ mixer_callback(uintptr_t handle,
 			break;
 
 		} else if (control_index < PX4IO_CONTROL_CHANNELS && control_group < PX4IO_CONTROL_GROUPS) {
-			control = REG_TO_FLOAT(r_page_controls[CONTROL_PAGE_INDEX(control_group, control_index)]);
+			control = fmu_control_sample(CONTROL_PAGE_INDEX(control_group, control_index));
 			break;
 		}
 
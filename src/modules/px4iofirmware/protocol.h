@@ -135,6 +135,9 @@
 
 #define PX4IO_P_STATUS_MIXER			9	 /* mixer actuator limit flags */
 
+#define PX4IO_P_STATUS_FMU_FRAMES		10	 /* counter of control frames received from the FMU, wraps */
+#define PX4IO_P_STATUS_FMU_AGE			11	 /* age of the newest FMU control frame at the last output tick, microseconds, saturates */
+
 /* array of post-mix actuator outputs, -10000..10000 */
 #define PX4IO_PAGE_ACTUATORS		2		/* 0..CONFIG_ACTUATOR_COUNT-1 */
 
@@ -345,6 +348,11 @@ struct IOPacket {
 
 #define PKT_CODE_READ		0x00	/* FMU->IO read transaction */
 #define PKT_CODE_WRITE		0x40	/* FMU->IO write transaction */
+#define PKT_CODE_WRREAD		0xc0	/* FMU->IO combined transaction: write registers to
+					 * page/offset, then reply with a read of another block.
+					 * regs[0] = (read page << 8) | read offset
+					 * regs[1] = read count
+					 * regs[2..] = values to write (count - 2 of them) */
 #define PKT_CODE_SUCCESS	0x00	/* IO->FMU success reply */
 #define PKT_CODE_CORRUPT	0x40	/* IO->FMU bad packet reply */
 #define PKT_CODE_ERROR		0x80	/* IO->FMU register op error reply */
@@ -88,6 +88,7 @@ extern uint16_t			r_page_adc[];		/* PX4IO_PAGE_RAW_ADC_INPUT */
 
 extern volatile uint16_t	r_page_setup[];		/* PX4IO_PAGE_SETUP */
 extern uint16_t			r_page_controls[];	/* PX4IO_PAGE_CONTROLS */
+extern uint16_t			r_page_controls_prev[]; /* previous control frame, for interpolation */
 extern uint16_t			r_page_rc_input_config[]; /* PX4IO_PAGE_RC_INPUT_CONFIG */
 extern uint16_t			r_page_servo_failsafe[]; /* PX4IO_PAGE_FAILSAFE_PWM */
 extern uint16_t			r_page_servo_control_min[]; /* PX4IO_PAGE_CONTROL_MIN_PWM */
@@ -147,6 +148,11 @@ struct sys_state_s {
 	 */
 	volatile uint64_t	fmu_data_received_time;
 
+	/**
+	 * Receive time of the control frame before the last one
+	 */
+	volatile uint64_t	fmu_data_prev_received_time;
+
 };
 
 extern struct sys_state_s system_state;
@@ -94,6 +94,8 @@ volatile uint16_t	r_page_status[] = {
 	[PX4IO_P_STATUS_VRSSI]			= 0,
 	[PX4IO_P_STATUS_PRSSI]			= 0,
 	[PX4IO_P_STATUS_MIXER]			= 0,
+	[PX4IO_P_STATUS_FMU_FRAMES]		= 0,
+	[PX4IO_P_STATUS_FMU_AGE]		= 0,
 };
 
 /**
@@ -223,6 +225,12 @@ volatile uint16_t	r_page_setup[] = {
  */
 uint16_t	r_page_controls[PX4IO_CONTROL_GROUPS * PX4IO_CONTROL_CHANNELS];
 
+/**
+ * Snapshot of the previous control frame, kept so the output tick can
+ * interpolate between the last two frames (see mixer.cpp).
+ */
+uint16_t	r_page_controls_prev[PX4IO_CONTROL_GROUPS * PX4IO_CONTROL_CHANNELS];
+
 /*
  * PAGE 102 does not have a buffer.
  */
@@ -291,6 +299,14 @@ registers_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num
 	/* handle bulk controls input */
 	case PX4IO_PAGE_CONTROLS:
 
+		/* a write starting at offset 0 begins a new control frame: keep the
+		 * previous frame and its arrival time for interpolation and count it */
+		if (offset == 0) {
+			memcpy(r_page_controls_prev, r_page_controls, sizeof(r_page_controls_prev));
+			system_state.fmu_data_prev_received_time = system_state.fmu_data_received_time;
+			r_page_status[PX4IO_P_STATUS_FMU_FRAMES]++;
+		}
+
 		/* copy channel data */
 		while ((offset < PX4IO_CONTROL_GROUPS * PX4IO_CONTROL_CHANNELS) && (num_values > 0)) {
 
@@ -184,6 +184,48 @@ rx_handle_packet(void)
 		return;
 	}
 
+	if (PKT_CODE(dma_packet) == PKT_CODE_WRREAD) {
+
+		/* combined transaction - write the supplied registers, then reply with a read */
+		uint8_t read_page = dma_packet.regs[0] >> 8;
+		uint8_t read_offset = dma_packet.regs[0] & 0xff;
+		unsigned read_count = dma_packet.regs[1];
+
+		if ((PKT_COUNT(dma_packet) < 2) ||
+		    registers_set(dma_packet.page, dma_packet.offset, &dma_packet.regs[2], PKT_COUNT(dma_packet) - 2)) {
+			perf_count(pc_regerr);
+			dma_packet.count_code = PKT_CODE_ERROR;
+			return;
+		}
+
+		/* get register pointer for the reply */
+		unsigned count;
+		uint16_t *registers;
+
+		if (registers_get(read_page, read_offset, &registers, &count) < 0) {
+			perf_count(pc_regerr);
+			dma_packet.count_code = PKT_CODE_ERROR;
+
+		} else {
+			/* constrain reply to requested size */
+			if (count > PKT_MAX_REGS) {
+				count = PKT_MAX_REGS;
+			}
+
+			if (count > read_count) {
+				count = read_count;
+			}
+
+			/* copy reply registers into DMA buffer */
+			memcpy((void *)&dma_packet.regs[0], registers, count * 2);
+			dma_packet.count_code = count | PKT_CODE_SUCCESS;
+			dma_packet.page = read_page;
+			dma_packet.offset = read_offset;
+		}
+
+		return;
+	}
+
 	if (PKT_CODE(dma_packet) == PKT_CODE_READ) {
 
 		/* it's a read - get register pointer for reply */
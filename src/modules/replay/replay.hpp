@@ -33,12 +33,15 @@
 
 #pragma once
 
+#include <deque>
 #include <fstream>
 #include <map>
 #include <vector>
 #include <set>
 #include <string>
 
+#include <pthread.h>
+
 #include "definitions.hpp"
 
 #include <px4_module.h>
@@ -250,6 +253,7 @@ private:
 	 */
 	bool readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position);
 	bool readDropout(std::ifstream &file, uint16_t msg_size);
+	bool readDropoutCounts(std::ifstream &file, uint16_t msg_size);
 	bool readAndApplyParameter(std::ifstream &file, uint16_t msg_size);
 
 	static const orb_metadata *findTopic(const std::string &name);
@@ -319,4 +323,63 @@ private:
 	int _topic_counter = 0;
 };
 
+/**
+ * @class ReplayBatch
+ * Batch replay: the module thread parses the log and hands fully parsed messages to a
+ * separate publisher thread through a bounded queue, so file I/O and parsing overlap
+ * with module execution and the replay runs as fast as the consuming modules allow.
+ */
+class ReplayBatch : public Replay
+{
+public:
+	ReplayBatch() = default;
+
+protected:
+
+	void onEnterMainLoop() override;
+	void onExitMainLoop() override;
+
+	uint64_t handleTopicDelay(uint64_t next_file_time, uint64_t timestamp_offset) override;
+
+	/**
+	 * enqueue a parsed message for the publisher thread, blocking while the queue is full
+	 * @return true (the message is always consumed)
+	 */
+	bool handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file) override;
+
+private:
+
+	/** one parsed, publish-ready message handed to the publisher thread */
+	struct BatchMessage {
+		const orb_metadata *orb_meta;
+		uint8_t multi_id;
+		std::vector<uint8_t> data;
+	};
+
+	/** publication handle owned by the publisher thread */
+	struct BatchAdvert {
+		const orb_metadata *orb_meta;
+		uint8_t multi_id;
+		orb_advert_t orb_advert;
+	};
+
+	static void *publisherThreadEntry(void *arg);
+	void publisherThread();
+
+	/**
+	 * publish a message from the queue, advertising the topic on first use
+	 * @return true if published, false otherwise
+	 */
+	bool publishBatchMessage(const BatchMessage &msg);
+
+	static const size_t BATCH_QUEUE_DEPTH = 128; ///< bound on the parse-ahead, limits memory use
+
+	std::deque<BatchMessage> _queue;
+	std::vector<BatchAdvert> _adverts;
+	pthread_t _publisher_thread = 0;
+	pthread_mutex_t _queue_mutex = PTHREAD_MUTEX_INITIALIZER;
+	pthread_cond_t _queue_cv = PTHREAD_COND_INITIALIZER;
+	bool _parsing_done = false;
+};
+
 } //namespace px4
@@ -486,6 +486,10 @@ bool Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos
 			readDropout(file, message_header.msg_size);
 			break;
 
+		case (int)ULogMessageType::DROPOUT_COUNTS:
+			readDropoutCounts(file, message_header.msg_size);
+			break;
+
 		default: //skip all others
 			file.seekg(message_header.msg_size, ios::cur);
 			break;
@@ -545,6 +549,26 @@ bool Replay::readDropout(std::ifstream &file, uint16_t msg_size)
 	return file.good();
 }
 
+bool Replay::readDropoutCounts(std::ifstream &file, uint16_t msg_size)
+{
+	unsigned num_entries = msg_size / sizeof(ulog_dropout_count_entry_s);
+	unsigned total = 0;
+
+	for (unsigned i = 0; i < num_entries; i++) {
+		ulog_dropout_count_entry_s entry;
+		file.read((char *)&entry, sizeof(entry));
+
+		if (!file) {
+			return false;
+		}
+
+		total += entry.count;
+	}
+
+	PX4_INFO("Dropout lost %u samples of %u messages", total, num_entries);
+	return file.good();
+}
+
 bool Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id)
 {
 	ulog_message_header_s message_header;
@@ -605,6 +629,7 @@ bool Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, in
 		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
 		case (int)ULogMessageType::PARAMETER:
 		case (int)ULogMessageType::DROPOUT:
+		case (int)ULogMessageType::DROPOUT_COUNTS:
 		case (int)ULogMessageType::INFO:
 		case (int)ULogMessageType::INFO_MULTIPLE:
 		case (int)ULogMessageType::SYNC:
@@ -631,7 +656,7 @@ bool Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, in
 
 const orb_metadata *Replay::findTopic(const std::string &name)
 {
-	const orb_metadata **topics = orb_get_topics();
+	const orb_metadata *const *topics = orb_get_topics();
 
 	for (size_t i = 0; i < orb_topics_count(); i++) {
 		if (name == topics[i]->o_name) {
@@ -1090,6 +1115,154 @@ uint64_t ReplayEkf2::handleTopicDelay(uint64_t next_file_time, uint64_t timestam
 	return next_file_time;
 }
 
+void ReplayBatch::onEnterMainLoop()
+{
+	_parsing_done = false;
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, PX4_STACK_ADJUSTED(4000));
+
+	if (pthread_create(&_publisher_thread, &attr, publisherThreadEntry, this) != 0) {
+		PX4_ERR("failed to start publisher thread");
+		_publisher_thread = 0;
+	}
+
+	pthread_attr_destroy(&attr);
+}
+
+void ReplayBatch::onExitMainLoop()
+{
+	pthread_mutex_lock(&_queue_mutex);
+	_parsing_done = true;
+	pthread_cond_broadcast(&_queue_cv);
+	pthread_mutex_unlock(&_queue_mutex);
+
+	if (_publisher_thread != 0) {
+		pthread_join(_publisher_thread, nullptr);
+		_publisher_thread = 0;
+	}
+
+	for (auto &advert : _adverts) {
+		orb_unadvertise(advert.orb_advert);
+	}
+
+	_adverts.clear();
+}
+
+uint64_t ReplayBatch::handleTopicDelay(uint64_t next_file_time, uint64_t timestamp_offset)
+{
+	// publish as fast as the consuming modules allow, but keep the adjusted timestamps
+	return next_file_time + timestamp_offset;
+}
+
+bool ReplayBatch::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file)
+{
+	if (_publisher_thread == 0) {
+		// publisher thread did not start, fall back to publishing inline
+		return publishTopic(sub, data);
+	}
+
+	// the publisher thread only gets a self-contained copy of the message, so it never
+	// touches the subscription state the parser keeps modifying
+	if (sub.compat) {
+		data = sub.compat->apply(data);
+	}
+
+	BatchMessage msg;
+	msg.orb_meta = sub.orb_meta;
+	msg.multi_id = sub.multi_id;
+	msg.data.assign((uint8_t *)data, (uint8_t *)data + sub.orb_meta->o_size);
+
+	pthread_mutex_lock(&_queue_mutex);
+
+	// bounded parse-ahead: wait for the publisher to drain part of the queue
+	while (_queue.size() >= BATCH_QUEUE_DEPTH) {
+		pthread_cond_wait(&_queue_cv, &_queue_mutex);
+	}
+
+	_queue.push_back(std::move(msg));
+	pthread_cond_broadcast(&_queue_cv);
+	pthread_mutex_unlock(&_queue_mutex);
+
+	++sub.publication_counter;
+	return true;
+}
+
+void *ReplayBatch::publisherThreadEntry(void *arg)
+{
+	((ReplayBatch *)arg)->publisherThread();
+	return nullptr;
+}
+
+void ReplayBatch::publisherThread()
+{
+	for (;;) {
+		pthread_mutex_lock(&_queue_mutex);
+
+		while (_queue.empty() && !_parsing_done) {
+			pthread_cond_wait(&_queue_cv, &_queue_mutex);
+		}
+
+		if (_queue.empty()) {
+			// parsing is done and everything is drained
+			pthread_mutex_unlock(&_queue_mutex);
+			break;
+		}
+
+		BatchMessage msg = std::move(_queue.front());
+		_queue.pop_front();
+		pthread_cond_broadcast(&_queue_cv);
+		pthread_mutex_unlock(&_queue_mutex);
+
+		publishBatchMessage(msg);
+	}
+}
+
+bool ReplayBatch::publishBatchMessage(const BatchMessage &msg)
+{
+	for (const auto &advert : _adverts) {
+		if (advert.orb_meta == msg.orb_meta && advert.multi_id == msg.multi_id) {
+			orb_publish(msg.orb_meta, advert.orb_advert, msg.data.data());
+			return true;
+		}
+	}
+
+	if (msg.multi_id > 0) {
+		// make sure the other instances are advertised already so that we get the correct instance
+		bool advertised = false;
+
+		for (const auto &advert : _adverts) {
+			if (advert.orb_meta == msg.orb_meta && advert.multi_id == msg.multi_id - 1) {
+				advertised = true;
+			}
+		}
+
+		if (!advertised) {
+			return false;
+		}
+	}
+
+	BatchAdvert advert;
+	advert.orb_meta = msg.orb_meta;
+	advert.multi_id = msg.multi_id;
+
+	if (msg.multi_id == 0) {
+		advert.orb_advert = orb_advertise(msg.orb_meta, msg.data.data());
+
+	} else {
+		int instance;
+		advert.orb_advert = orb_advertise_multi(msg.orb_meta, msg.data.data(), &instance, ORB_PRIO_DEFAULT);
+	}
+
+	if (advert.orb_advert == nullptr) {
+		return false;
+	}
+
+	_adverts.push_back(advert);
+	return true;
+}
+
 
 int Replay::custom_command(int argc, char *argv[])
 {
@@ -1119,6 +1292,8 @@ There are 2 environment variables used for configuration: `replay`, which must b
 the log file to be replayed. The second is the mode, specified via `replay_mode`:
 - `replay_mode=ekf2`: specific EKF2 replay mode. It can only be used with the ekf2 module, but allows the replay
   to run as fast as possible.
+- `replay_mode=batch`: like the generic mode, but the log is parsed on a separate thread and the messages are
+  published as fast as the consuming modules allow, without real-time pacing.
 - Generic otherwise: this can be used to replay any module(s), but the replay will be done with the same speed as the
   log was recorded.
 
@@ -1204,6 +1379,10 @@ Replay *Replay::instantiate(int argc, char *argv[])
 		PX4_INFO("Ekf2 replay mode");
 		instance = new ReplayEkf2();
 
+	} else if (replay_mode && strcmp(replay_mode, "batch") == 0) {
+		PX4_INFO("Batch replay mode");
+		instance = new ReplayBatch();
+
 	} else {
 		instance = new Replay();
 	}
@@ -43,10 +43,22 @@
 namespace sensors
 {
 
+/* Boards with a known sensor topology can cap the number of instances the
+ * module handles at compile time via add_definitions(-DBOARD_MAX_SENSOR_INSTANCES=n)
+ * in their cmake config. This shrinks the per-instance state arrays and lets
+ * the compiler eliminate the unused loop iterations on single-IMU targets.
+ */
+#ifdef BOARD_MAX_SENSOR_INSTANCES
+constexpr uint8_t MAG_COUNT_MAX = BOARD_MAX_SENSOR_INSTANCES;
+constexpr uint8_t GYRO_COUNT_MAX = BOARD_MAX_SENSOR_INSTANCES;
+constexpr uint8_t ACCEL_COUNT_MAX = BOARD_MAX_SENSOR_INSTANCES;
+constexpr uint8_t BARO_COUNT_MAX = BOARD_MAX_SENSOR_INSTANCES;
+#else
 constexpr uint8_t MAG_COUNT_MAX = 4;
 constexpr uint8_t GYRO_COUNT_MAX = 3;
 constexpr uint8_t ACCEL_COUNT_MAX = 3;
 constexpr uint8_t BARO_COUNT_MAX = 3;
+#endif
 
 constexpr uint8_t SENSOR_COUNT_MAX = math::max(MAG_COUNT_MAX,
 				     math::max(GYRO_COUNT_MAX,
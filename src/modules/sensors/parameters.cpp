@@ -144,6 +144,13 @@ int initialize_parameter_handles(ParameterHandles &parameter_handles)
 	parameter_handles.battery_a_per_v = param_find("BAT_A_PER_V");
 	parameter_handles.battery_source = param_find("BAT_SOURCE");
 
+	/* gyro filter bank */
+	parameter_handles.gyro_lpf_cutoff = param_find("SENS_GYRO_LPF");
+	parameter_handles.gyro_notch_freq[0] = param_find("SENS_GY_NF0_FRQ");
+	parameter_handles.gyro_notch_bw[0] = param_find("SENS_GY_NF0_BW");
+	parameter_handles.gyro_notch_freq[1] = param_find("SENS_GY_NF1_FRQ");
+	parameter_handles.gyro_notch_bw[1] = param_find("SENS_GY_NF1_BW");
+
 	/* rotations */
 	parameter_handles.board_rotation = param_find("SENS_BOARD_ROT");
 
@@ -478,6 +485,12 @@ int update_parameters(const ParameterHandles &parameter_handles, Parameters &par
 
 	param_get(parameter_handles.battery_source, &(parameters.battery_source));
 
+	param_get(parameter_handles.gyro_lpf_cutoff, &(parameters.gyro_lpf_cutoff));
+	param_get(parameter_handles.gyro_notch_freq[0], &(parameters.gyro_notch_freq[0]));
+	param_get(parameter_handles.gyro_notch_bw[0], &(parameters.gyro_notch_bw[0]));
+	param_get(parameter_handles.gyro_notch_freq[1], &(parameters.gyro_notch_freq[1]));
+	param_get(parameter_handles.gyro_notch_bw[1], &(parameters.gyro_notch_bw[1]));
+
 	param_get(parameter_handles.board_rotation, &(parameters.board_rotation));
 
 	param_get(parameter_handles.board_offset[0], &(parameters.board_offset[0]));
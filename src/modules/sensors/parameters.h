@@ -66,6 +66,10 @@ struct Parameters {
 	float diff_pres_offset_pa;
 	float diff_pres_analog_scale;
 
+	float gyro_lpf_cutoff;
+	float gyro_notch_freq[2];
+	float gyro_notch_bw[2];
+
 	int board_rotation;
 
 	float board_offset[3];
@@ -219,6 +223,10 @@ struct ParameterHandles {
 	param_t battery_a_per_v;
 	param_t battery_source;
 
+	param_t gyro_lpf_cutoff;
+	param_t gyro_notch_freq[2];
+	param_t gyro_notch_bw[2];
+
 	param_t board_rotation;
 
 	param_t board_offset[3];
@@ -847,6 +847,71 @@ PARAM_DEFINE_FLOAT(SENS_DPRES_ANSC, 0);
  */
 PARAM_DEFINE_FLOAT(SENS_BARO_QNH, 1013.25f);
 
+/**
+ * Gyro filter bank low-pass cutoff frequency
+ *
+ * Cutoff of the second order low-pass applied to the gyro data of all
+ * instances at the sensors hub, before the output is written to
+ * sensor_combined. The per-instance sensor_gyro topics stay unfiltered.
+ * Set to 0 to disable.
+ *
+ * @min 0
+ * @max 250
+ * @unit Hz
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(SENS_GYRO_LPF, 0.0f);
+
+/**
+ * Gyro filter bank first notch frequency
+ *
+ * Center frequency of the first notch of the gyro filter bank,
+ * typically placed on the propeller fundamental. Set to 0 to disable.
+ *
+ * @min 0
+ * @max 500
+ * @unit Hz
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(SENS_GY_NF0_FRQ, 0.0f);
+
+/**
+ * Gyro filter bank first notch bandwidth
+ *
+ * -3 dB bandwidth of the first notch of the gyro filter bank.
+ *
+ * @min 1
+ * @max 100
+ * @unit Hz
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(SENS_GY_NF0_BW, 20.0f);
+
+/**
+ * Gyro filter bank second notch frequency
+ *
+ * Center frequency of the second notch of the gyro filter bank,
+ * typically placed on the first propeller harmonic. Set to 0 to disable.
+ *
+ * @min 0
+ * @max 500
+ * @unit Hz
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(SENS_GY_NF1_FRQ, 0.0f);
+
+/**
+ * Gyro filter bank second notch bandwidth
+ *
+ * -3 dB bandwidth of the second notch of the gyro filter bank.
+ *
+ * @min 1
+ * @max 100
+ * @unit Hz
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(SENS_GY_NF1_BW, 20.0f);
+
 
 /**
  * Board rotation
@@ -1061,6 +1126,35 @@ PARAM_DEFINE_INT32(BAT_SOURCE, 0);
  */
 PARAM_DEFINE_INT32(SENS_EN_LL40LS, 0);
 
+/**
+ * Range finder in-driver median filter window
+ *
+ * Number of raw samples the range finder drivers take the median of before
+ * publishing distance_sensor, rejecting single-sample spikes in the driver
+ * instead of redundantly in every consumer. Even values are rounded up.
+ * 0 disables the filter and publishes every raw sample. The raw stream stays
+ * available through the range finder device.
+ *
+ * @reboot_required true
+ * @min 0
+ * @max 7
+ * @group Sensors
+ */
+PARAM_DEFINE_INT32(SENS_RNG_FILT, 0);
+
+/**
+ * Range finder publication decimation
+ *
+ * Publish distance_sensor only on every n-th sample, cutting topic traffic
+ * from fast-sampling range finders. 1 publishes every sample.
+ *
+ * @reboot_required true
+ * @min 1
+ * @max 10
+ * @group Sensors
+ */
+PARAM_DEFINE_INT32(SENS_RNG_DECIM, 1);
+
 /**
  * Lightware laser rangefinder (serial)
  *
@@ -83,6 +83,7 @@
 #include <uORB/topics/battery_status.h>
 #include <uORB/topics/differential_pressure.h>
 #include <uORB/topics/airspeed.h>
+#include <uORB/topics/input_rc.h>
 #include <uORB/topics/sensor_preflight.h>
 
 #include <DevMgr.hpp>
@@ -194,6 +195,13 @@ private:
 	RCUpdate		_rc_update;
 	VotedSensorsUpdate _voted_sensors_update;
 
+	/* RC processing runs on its own task, woken up by input_rc instead of
+	 * sharing the high-rate gyro-paced loop */
+	int		_rc_task = -1;
+	volatile bool	_rc_task_should_exit = false;
+	volatile bool	_rc_task_running = false;
+	volatile bool	_rc_params_updated = true;	/**< tells the RC task to re-read the RC mapping */
+
 
 	/**
 	 * Update our local parameter cache.
@@ -230,6 +238,18 @@ private:
 	 *				data should be returned.
 	 */
 	void		adc_poll(struct sensor_combined_s &raw);
+
+	/**
+	 * Entry point of the RC processing task.
+	 */
+	static int	rc_update_task_trampoline(int argc, char *argv[]);
+
+	void		rc_update_task_main();
+
+	/**
+	 * Run one RC processing cycle (mapping update, parameter map, input poll).
+	 */
+	void		rc_update_cycle();
 };
 
 Sensors::Sensors(bool hil_enabled) :
@@ -278,7 +298,8 @@ Sensors::parameters_update()
 		return ret;
 	}
 
-	_rc_update.update_rc_functions();
+	/* the RC mapping is owned by the RC task, let it pick up the change */
+	_rc_params_updated = true;
 	_voted_sensors_update.parameters_update();
 
 	/* update barometer qnh setting */
@@ -617,6 +638,19 @@ Sensors::run()
 
 	_sensor_preflight = orb_advertise(ORB_ID(sensor_preflight), &preflt);
 
+	/* start the RC processing task: it wakes up on input_rc at the RC frame
+	 * rate (~50 Hz) instead of running inside the 1 kHz sensor loop */
+	_rc_task = px4_task_spawn_cmd("rc_update",
+				      SCHED_DEFAULT,
+				      SCHED_PRIORITY_DEFAULT,
+				      1500,
+				      (px4_main_t)&Sensors::rc_update_task_trampoline,
+				      nullptr);
+
+	if (_rc_task < 0) {
+		PX4_ERR("RC task start failed, processing RC in the sensor loop");
+	}
+
 	/* wakeup source */
 	px4_pollfd_struct_t poll_fds = {};
 
@@ -695,13 +729,12 @@ Sensors::run()
 
 			/* check parameters for updates */
 			parameter_update_poll();
-
-			/* check rc parameter map for updates */
-			_rc_update.rc_parameter_map_poll(_parameter_handles);
 		}
 
-		/* Look for new r/c input data */
-		_rc_update.rc_poll(_parameter_handles);
+		/* fallback only: RC normally runs on its own task */
+		if (_rc_task < 0) {
+			rc_update_cycle();
+		}
 
 		perf_end(_loop_perf);
 	}
@@ -712,10 +745,86 @@ Sensors::run()
 	orb_unsubscribe(_actuator_ctrl_0_sub);
 	orb_unadvertise(_sensor_pub);
 
+	/* stop the RC task before tearing down the shared RCUpdate state */
+	if (_rc_task >= 0) {
+		_rc_task_should_exit = true;
+
+		while (_rc_task_running) {
+			usleep(10000);
+		}
+	}
+
 	_rc_update.deinit();
 	_voted_sensors_update.deinit();
 }
 
+int
+Sensors::rc_update_task_trampoline(int argc, char *argv[])
+{
+	Sensors *instance = get_instance();
+
+	if (instance) {
+		instance->rc_update_task_main();
+	}
+
+	return 0;
+}
+
+void
+Sensors::rc_update_task_main()
+{
+	_rc_task_running = true;
+
+	/* wake up on raw RC frames; this bounds the processing rate to the
+	 * receiver frame rate */
+	int rc_sub = orb_subscribe(ORB_ID(input_rc));
+
+	px4_pollfd_struct_t poll_fds = {};
+	poll_fds.fd = rc_sub;
+	poll_fds.events = POLLIN;
+
+	while (!_rc_task_should_exit) {
+
+		/* the timeout keeps RC signal-loss handling and the rc parameter
+		 * map running while no receiver frames come in */
+		int pret = px4_poll(&poll_fds, 1, 100);
+
+		if (pret < 0) {
+			usleep(1000);
+			continue;
+		}
+
+		if (pret > 0 && (poll_fds.revents & POLLIN)) {
+			/* consume the update on the wakeup subscription, otherwise poll
+			 * keeps returning immediately; the frame itself is processed by
+			 * RCUpdate through its own subscription in rc_poll() */
+			struct input_rc_s rc_input;
+			orb_copy(ORB_ID(input_rc), rc_sub, &rc_input);
+		}
+
+		rc_update_cycle();
+	}
+
+	orb_unsubscribe(rc_sub);
+
+	_rc_task_running = false;
+}
+
+void
+Sensors::rc_update_cycle()
+{
+	if (_rc_params_updated) {
+		_rc_params_updated = false;
+		_rc_update.update_rc_functions();
+	}
+
+	/* check rc parameter map for updates */
+	_rc_update.rc_parameter_map_poll(_parameter_handles);
+
+	/* Look for new r/c input data */
+	_rc_update.rc_poll(_parameter_handles);
+}
+
 int Sensors::task_spawn(int argc, char *argv[])
 {
 	/* start the task */
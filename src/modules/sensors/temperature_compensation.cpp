@@ -47,6 +47,14 @@
 namespace sensors
 {
 
+#if defined(TEMPERATURE_COMPENSATION_DISABLED)
+/* compile the whole stage out: every entry point sees "not enabled" and the
+ * compiler removes the dead remainder of each function */
+#define TC_ENABLED(flag) false
+#else
+#define TC_ENABLED(flag) ((flag) == 1)
+#endif
+
 int TemperatureCompensation::initialize_parameter_handles(ParameterHandles &parameter_handles)
 {
 	char nbuf[16];
@@ -140,6 +148,9 @@ int TemperatureCompensation::initialize_parameter_handles(ParameterHandles &para
 
 int TemperatureCompensation::parameters_update()
 {
+#if defined(TEMPERATURE_COMPENSATION_DISABLED)
+	return 0;
+#else
 	int ret = 0;
 
 	ParameterHandles parameter_handles;
@@ -247,6 +258,7 @@ int TemperatureCompensation::parameters_update()
 	_baro_data.reset_temperature();
 
 	return ret;
+#endif /* TEMPERATURE_COMPENSATION_DISABLED */
 }
 
 bool TemperatureCompensation::calc_thermal_offsets_1D(SensorCalData1D &coef, float measured_temp, float &offset)
@@ -269,17 +281,10 @@ bool TemperatureCompensation::calc_thermal_offsets_1D(SensorCalData1D &coef, flo
 
 	}
 
-	// calulate the offset
-	float temp_var = delta_temp;
-	offset = coef.x0 + coef.x1 * temp_var;
-	temp_var *= delta_temp;
-	offset += coef.x2 * temp_var;
-	temp_var *= delta_temp;
-	offset += coef.x3 * temp_var;
-	temp_var *= delta_temp;
-	offset += coef.x4 * temp_var;
-	temp_var *= delta_temp;
-	offset += coef.x5 * temp_var;
+	// calulate the offset with Horner's scheme (shortest dependency chain of
+	// fused multiply-adds the FPU can offer for a 5th order polynomial)
+	offset = ((((coef.x5 * delta_temp + coef.x4) * delta_temp + coef.x3) * delta_temp + coef.x2) * delta_temp +
+		  coef.x1) * delta_temp + coef.x0;
 
 	return ret;
 
@@ -305,12 +310,12 @@ bool TemperatureCompensation::calc_thermal_offsets_3D(const SensorCalData3D &coe
 
 	}
 
-	// calulate the offsets
-	float delta_temp_2 = delta_temp * delta_temp;
-	float delta_temp_3 = delta_temp_2 * delta_temp;
-
+	// calulate the offsets with Horner's scheme over the packed per-axis
+	// coefficient arrays; the three accumulation chains are independent, so the
+	// loop maps to fused multiply-adds on the M4/M7 FPU and vectorizes on
+	// targets with NEON/SSE
 	for (uint8_t i = 0; i < 3; i++) {
-		offset[i] = coef.x0[i] + coef.x1[i] * delta_temp + coef.x2[i] * delta_temp_2 + coef.x3[i] * delta_temp_3;
+		offset[i] = ((coef.x3[i] * delta_temp + coef.x2[i]) * delta_temp + coef.x1[i]) * delta_temp + coef.x0[i];
 	}
 
 	return ret;
@@ -319,7 +324,7 @@ bool TemperatureCompensation::calc_thermal_offsets_3D(const SensorCalData3D &coe
 
 int TemperatureCompensation::set_sensor_id_gyro(uint32_t device_id, int topic_instance)
 {
-	if (_parameters.gyro_tc_enable != 1) {
+	if (!TC_ENABLED(_parameters.gyro_tc_enable)) {
 		return 0;
 	}
 
@@ -328,7 +333,7 @@ int TemperatureCompensation::set_sensor_id_gyro(uint32_t device_id, int topic_in
 
 int TemperatureCompensation::set_sensor_id_accel(uint32_t device_id, int topic_instance)
 {
-	if (_parameters.accel_tc_enable != 1) {
+	if (!TC_ENABLED(_parameters.accel_tc_enable)) {
 		return 0;
 	}
 
@@ -337,7 +342,7 @@ int TemperatureCompensation::set_sensor_id_accel(uint32_t device_id, int topic_i
 
 int TemperatureCompensation::set_sensor_id_baro(uint32_t device_id, int topic_instance)
 {
-	if (_parameters.baro_tc_enable != 1) {
+	if (!TC_ENABLED(_parameters.baro_tc_enable)) {
 		return 0;
 	}
 
@@ -361,7 +366,7 @@ int TemperatureCompensation::set_sensor_id(uint32_t device_id, int topic_instanc
 int TemperatureCompensation::apply_corrections_gyro(int topic_instance, math::Vector<3> &sensor_data, float temperature,
 		float *offsets, float *scales)
 {
-	if (_parameters.gyro_tc_enable != 1) {
+	if (!TC_ENABLED(_parameters.gyro_tc_enable)) {
 		return 0;
 	}
 
@@ -390,7 +395,7 @@ int TemperatureCompensation::apply_corrections_gyro(int topic_instance, math::Ve
 int TemperatureCompensation::apply_corrections_accel(int topic_instance, math::Vector<3> &sensor_data,
 		float temperature, float *offsets, float *scales)
 {
-	if (_parameters.accel_tc_enable != 1) {
+	if (!TC_ENABLED(_parameters.accel_tc_enable)) {
 		return 0;
 	}
 
@@ -419,7 +424,7 @@ int TemperatureCompensation::apply_corrections_accel(int topic_instance, math::V
 int TemperatureCompensation::apply_corrections_baro(int topic_instance, float &sensor_data, float temperature,
 		float *offsets, float *scales)
 {
-	if (_parameters.baro_tc_enable != 1) {
+	if (!TC_ENABLED(_parameters.baro_tc_enable)) {
 		return 0;
 	}
 
@@ -56,6 +56,10 @@ static_assert(ACCEL_COUNT_MAX == 3,
 static_assert(BARO_COUNT_MAX == 3,
 	      "BARO_COUNT_MAX must be 3 (if changed, add/remove TC_* params to match the count)");
 
+/* Define TEMPERATURE_COMPENSATION_DISABLED in the board configuration to compile the
+ * whole compensation stage down to immediate returns, for boards that never fly with
+ * thermal calibration (removes the per-sample overhead in the 1 kHz sensor path) */
+
 /**
  ** class TemperatureCompensation
  * Applies temperature compensation to sensor data. Loads the parameters from PX4 param storage.
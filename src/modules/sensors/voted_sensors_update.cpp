@@ -46,6 +46,9 @@
 #define MAG_ROT_VAL_INTERNAL		-1
 #define CAL_ERROR_APPLY_CAL_MSG "FAILED APPLYING %s CAL #%u"
 
+/** revote interval with a single sensor, chosen well below the voter timeouts */
+#define SINGLE_SENSOR_VOTE_INTERVAL	100000
+
 
 using namespace sensors;
 using namespace DriverFramework;
@@ -54,7 +57,8 @@ using namespace DriverFramework;
 const double VotedSensorsUpdate::_msl_pressure = 101.325;
 
 VotedSensorsUpdate::VotedSensorsUpdate(const Parameters &parameters, bool hil_enabled)
-	: _parameters(parameters), _hil_enabled(hil_enabled)
+	: _failover_latency_perf(perf_alloc(PC_ELAPSED, "sensors_failover_latency")),
+	  _parameters(parameters), _hil_enabled(hil_enabled)
 {
 	memset(&_last_sensor_data, 0, sizeof(_last_sensor_data));
 	memset(&_last_accel_timestamp, 0, sizeof(_last_accel_timestamp));
@@ -129,10 +133,80 @@ void VotedSensorsUpdate::deinit()
 	for (unsigned i = 0; i < _baro.subscription_count; i++) {
 		orb_unsubscribe(_baro.subscription[i]);
 	}
+
+	perf_free(_failover_latency_perf);
+}
+
+void VotedSensorsUpdate::init_cal_handles()
+{
+	if (_cal_handles_resolved) {
+		return;
+	}
+
+	char str[30];
+
+	for (unsigned i = 0; i < GYRO_COUNT_MAX; i++) {
+		(void)sprintf(str, "CAL_GYRO%u_ID", i);
+		_gyro_cal_handles[i].id = param_find(str);
+		(void)sprintf(str, "CAL_GYRO%u_XOFF", i);
+		_gyro_cal_handles[i].x_off = param_find(str);
+		(void)sprintf(str, "CAL_GYRO%u_YOFF", i);
+		_gyro_cal_handles[i].y_off = param_find(str);
+		(void)sprintf(str, "CAL_GYRO%u_ZOFF", i);
+		_gyro_cal_handles[i].z_off = param_find(str);
+		(void)sprintf(str, "CAL_GYRO%u_XSCALE", i);
+		_gyro_cal_handles[i].x_scale = param_find(str);
+		(void)sprintf(str, "CAL_GYRO%u_YSCALE", i);
+		_gyro_cal_handles[i].y_scale = param_find(str);
+		(void)sprintf(str, "CAL_GYRO%u_ZSCALE", i);
+		_gyro_cal_handles[i].z_scale = param_find(str);
+		_gyro_cal_handles[i].rot = PARAM_INVALID;
+	}
+
+	for (unsigned i = 0; i < ACCEL_COUNT_MAX; i++) {
+		(void)sprintf(str, "CAL_ACC%u_ID", i);
+		_accel_cal_handles[i].id = param_find(str);
+		(void)sprintf(str, "CAL_ACC%u_XOFF", i);
+		_accel_cal_handles[i].x_off = param_find(str);
+		(void)sprintf(str, "CAL_ACC%u_YOFF", i);
+		_accel_cal_handles[i].y_off = param_find(str);
+		(void)sprintf(str, "CAL_ACC%u_ZOFF", i);
+		_accel_cal_handles[i].z_off = param_find(str);
+		(void)sprintf(str, "CAL_ACC%u_XSCALE", i);
+		_accel_cal_handles[i].x_scale = param_find(str);
+		(void)sprintf(str, "CAL_ACC%u_YSCALE", i);
+		_accel_cal_handles[i].y_scale = param_find(str);
+		(void)sprintf(str, "CAL_ACC%u_ZSCALE", i);
+		_accel_cal_handles[i].z_scale = param_find(str);
+		_accel_cal_handles[i].rot = PARAM_INVALID;
+	}
+
+	for (unsigned i = 0; i < MAG_COUNT_MAX; i++) {
+		(void)sprintf(str, "CAL_MAG%u_ID", i);
+		_mag_cal_handles[i].id = param_find(str);
+		(void)sprintf(str, "CAL_MAG%u_XOFF", i);
+		_mag_cal_handles[i].x_off = param_find(str);
+		(void)sprintf(str, "CAL_MAG%u_YOFF", i);
+		_mag_cal_handles[i].y_off = param_find(str);
+		(void)sprintf(str, "CAL_MAG%u_ZOFF", i);
+		_mag_cal_handles[i].z_off = param_find(str);
+		(void)sprintf(str, "CAL_MAG%u_XSCALE", i);
+		_mag_cal_handles[i].x_scale = param_find(str);
+		(void)sprintf(str, "CAL_MAG%u_YSCALE", i);
+		_mag_cal_handles[i].y_scale = param_find(str);
+		(void)sprintf(str, "CAL_MAG%u_ZSCALE", i);
+		_mag_cal_handles[i].z_scale = param_find(str);
+		(void)sprintf(str, "CAL_MAG%u_ROT", i);
+		_mag_cal_handles[i].rot = param_find(str);
+	}
+
+	_cal_handles_resolved = true;
 }
 
 void VotedSensorsUpdate::parameters_update()
 {
+	init_cal_handles();
+
 	get_rot_matrix((enum Rotation)_parameters.board_rotation, &_board_rotation);
 	/* fine tune board offset */
 	math::Matrix<3, 3> board_rotation_offset;
@@ -154,6 +228,10 @@ void VotedSensorsUpdate::parameters_update()
 	/* temperature compensation */
 	_temperature_compensation.parameters_update();
 
+	/* gyro filter bank; reconfigured here for new cutoffs, and from
+	 * gyro_poll() when the measured sample rate changes */
+	update_gyro_filters(_gyro_filter_sample_freq);
+
 	/* gyro */
 	for (unsigned topic_instance = 0; topic_instance < GYRO_COUNT_MAX; ++topic_instance) {
 
@@ -253,9 +331,8 @@ void VotedSensorsUpdate::parameters_update()
 			/* initially status is ok per config */
 			failed = false;
 
-			(void)sprintf(str, "CAL_GYRO%u_ID", i);
 			int32_t device_id;
-			failed = failed || (OK != param_get(param_find(str), &device_id));
+			failed = failed || (OK != param_get(_gyro_cal_handles[i].id, &device_id));
 
 			if (failed) {
 				continue;
@@ -268,18 +345,12 @@ void VotedSensorsUpdate::parameters_update()
 			/* if the calibration is for this device, apply it */
 			if (device_id == driver_device_id) {
 				struct gyro_calibration_s gscale = {};
-				(void)sprintf(str, "CAL_GYRO%u_XOFF", i);
-				failed = failed || (OK != param_get(param_find(str), &gscale.x_offset));
-				(void)sprintf(str, "CAL_GYRO%u_YOFF", i);
-				failed = failed || (OK != param_get(param_find(str), &gscale.y_offset));
-				(void)sprintf(str, "CAL_GYRO%u_ZOFF", i);
-				failed = failed || (OK != param_get(param_find(str), &gscale.z_offset));
-				(void)sprintf(str, "CAL_GYRO%u_XSCALE", i);
-				failed = failed || (OK != param_get(param_find(str), &gscale.x_scale));
-				(void)sprintf(str, "CAL_GYRO%u_YSCALE", i);
-				failed = failed || (OK != param_get(param_find(str), &gscale.y_scale));
-				(void)sprintf(str, "CAL_GYRO%u_ZSCALE", i);
-				failed = failed || (OK != param_get(param_find(str), &gscale.z_scale));
+				failed = failed || (OK != param_get(_gyro_cal_handles[i].x_off, &gscale.x_offset));
+				failed = failed || (OK != param_get(_gyro_cal_handles[i].y_off, &gscale.y_offset));
+				failed = failed || (OK != param_get(_gyro_cal_handles[i].z_off, &gscale.z_offset));
+				failed = failed || (OK != param_get(_gyro_cal_handles[i].x_scale, &gscale.x_scale));
+				failed = failed || (OK != param_get(_gyro_cal_handles[i].y_scale, &gscale.y_scale));
+				failed = failed || (OK != param_get(_gyro_cal_handles[i].z_scale, &gscale.z_scale));
 
 				if (failed) {
 					PX4_ERR(CAL_ERROR_APPLY_CAL_MSG, "gyro", i);
@@ -310,8 +381,7 @@ void VotedSensorsUpdate::parameters_update()
 		for (unsigned i = 0; i < GYRO_COUNT_MAX; i++) {
 
 			int32_t device_id = 0;
-			(void)sprintf(str, "CAL_GYRO%u_ID", i);
-			(void)param_set(param_find(str), &device_id);
+			(void)param_set(_gyro_cal_handles[i].id, &device_id);
 		}
 	}
 
@@ -335,9 +405,8 @@ void VotedSensorsUpdate::parameters_update()
 			/* initially status is ok per config */
 			failed = false;
 
-			(void)sprintf(str, "CAL_ACC%u_ID", i);
 			int32_t device_id;
-			failed = failed || (OK != param_get(param_find(str), &device_id));
+			failed = failed || (OK != param_get(_accel_cal_handles[i].id, &device_id));
 
 			if (failed) {
 				continue;
@@ -350,18 +419,12 @@ void VotedSensorsUpdate::parameters_update()
 			/* if the calibration is for this device, apply it */
 			if (device_id == driver_device_id) {
 				struct accel_calibration_s ascale = {};
-				(void)sprintf(str, "CAL_ACC%u_XOFF", i);
-				failed = failed || (OK != param_get(param_find(str), &ascale.x_offset));
-				(void)sprintf(str, "CAL_ACC%u_YOFF", i);
-				failed = failed || (OK != param_get(param_find(str), &ascale.y_offset));
-				(void)sprintf(str, "CAL_ACC%u_ZOFF", i);
-				failed = failed || (OK != param_get(param_find(str), &ascale.z_offset));
-				(void)sprintf(str, "CAL_ACC%u_XSCALE", i);
-				failed = failed || (OK != param_get(param_find(str), &ascale.x_scale));
-				(void)sprintf(str, "CAL_ACC%u_YSCALE", i);
-				failed = failed || (OK != param_get(param_find(str), &ascale.y_scale));
-				(void)sprintf(str, "CAL_ACC%u_ZSCALE", i);
-				failed = failed || (OK != param_get(param_find(str), &ascale.z_scale));
+				failed = failed || (OK != param_get(_accel_cal_handles[i].x_off, &ascale.x_offset));
+				failed = failed || (OK != param_get(_accel_cal_handles[i].y_off, &ascale.y_offset));
+				failed = failed || (OK != param_get(_accel_cal_handles[i].z_off, &ascale.z_offset));
+				failed = failed || (OK != param_get(_accel_cal_handles[i].x_scale, &ascale.x_scale));
+				failed = failed || (OK != param_get(_accel_cal_handles[i].y_scale, &ascale.y_scale));
+				failed = failed || (OK != param_get(_accel_cal_handles[i].z_scale, &ascale.z_scale));
 
 				if (failed) {
 					PX4_ERR(CAL_ERROR_APPLY_CAL_MSG, "accel", i);
@@ -392,8 +455,7 @@ void VotedSensorsUpdate::parameters_update()
 		for (unsigned i = 0; i < ACCEL_COUNT_MAX; i++) {
 
 			int32_t device_id = 0;
-			(void)sprintf(str, "CAL_ACC%u_ID", i);
-			(void)param_set(param_find(str), &device_id);
+			(void)param_set(_accel_cal_handles[i].id, &device_id);
 		}
 	}
 
@@ -445,9 +507,8 @@ void VotedSensorsUpdate::parameters_update()
 			/* initially status is ok per config */
 			failed = false;
 
-			(void)sprintf(str, "CAL_MAG%u_ID", i);
 			int32_t device_id;
-			failed = failed || (OK != param_get(param_find(str), &device_id));
+			failed = failed || (OK != param_get(_mag_cal_handles[i].id, &device_id));
 
 			if (failed) {
 				continue;
@@ -456,23 +517,15 @@ void VotedSensorsUpdate::parameters_update()
 			/* if the calibration is for this device, apply it */
 			if (device_id == _mag_device_id[topic_instance]) {
 				struct mag_calibration_s mscale = {};
-				(void)sprintf(str, "CAL_MAG%u_XOFF", i);
-				failed = failed || (OK != param_get(param_find(str), &mscale.x_offset));
-				(void)sprintf(str, "CAL_MAG%u_YOFF", i);
-				failed = failed || (OK != param_get(param_find(str), &mscale.y_offset));
-				(void)sprintf(str, "CAL_MAG%u_ZOFF", i);
-				failed = failed || (OK != param_get(param_find(str), &mscale.z_offset));
-				(void)sprintf(str, "CAL_MAG%u_XSCALE", i);
-				failed = failed || (OK != param_get(param_find(str), &mscale.x_scale));
-				(void)sprintf(str, "CAL_MAG%u_YSCALE", i);
-				failed = failed || (OK != param_get(param_find(str), &mscale.y_scale));
-				(void)sprintf(str, "CAL_MAG%u_ZSCALE", i);
-				failed = failed || (OK != param_get(param_find(str), &mscale.z_scale));
-
-				(void)sprintf(str, "CAL_MAG%u_ROT", i);
+				failed = failed || (OK != param_get(_mag_cal_handles[i].x_off, &mscale.x_offset));
+				failed = failed || (OK != param_get(_mag_cal_handles[i].y_off, &mscale.y_offset));
+				failed = failed || (OK != param_get(_mag_cal_handles[i].z_off, &mscale.z_offset));
+				failed = failed || (OK != param_get(_mag_cal_handles[i].x_scale, &mscale.x_scale));
+				failed = failed || (OK != param_get(_mag_cal_handles[i].y_scale, &mscale.y_scale));
+				failed = failed || (OK != param_get(_mag_cal_handles[i].z_scale, &mscale.z_scale));
 
 				int32_t mag_rot;
-				param_get(param_find(str), &mag_rot);
+				param_get(_mag_cal_handles[i].rot, &mag_rot);
 
 				if (is_external) {
 
@@ -480,14 +533,14 @@ void VotedSensorsUpdate::parameters_update()
 					if (mag_rot < 0) {
 						/* it was marked as internal, change to external with no rotation */
 						mag_rot = 0;
-						param_set_no_notification(param_find(str), &mag_rot);
+						param_set_no_notification(_mag_cal_handles[i].rot, &mag_rot);
 					}
 
 				} else {
 					/* mag is internal - reset param to -1 to indicate internal mag */
 					if (mag_rot != MAG_ROT_VAL_INTERNAL) {
 						mag_rot = MAG_ROT_VAL_INTERNAL;
-						param_set_no_notification(param_find(str), &mag_rot);
+						param_set_no_notification(_mag_cal_handles[i].rot, &mag_rot);
 					}
 				}
 
@@ -521,16 +574,48 @@ void VotedSensorsUpdate::parameters_update()
 
 }
 
+void VotedSensorsUpdate::update_gyro_filters(float sample_freq)
+{
+	_gyro_filter_sample_freq = sample_freq;
+
+	for (unsigned i = 0; i < GYRO_COUNT_MAX; i++) {
+		_gyro_filter_lpf[i].set_lowpass(sample_freq, _parameters.gyro_lpf_cutoff);
+		_gyro_filter_notch[0][i].set_notch(sample_freq, _parameters.gyro_notch_freq[0], _parameters.gyro_notch_bw[0]);
+		_gyro_filter_notch[1][i].set_notch(sample_freq, _parameters.gyro_notch_freq[1], _parameters.gyro_notch_bw[1]);
+	}
+}
+
+int VotedSensorsUpdate::get_best(SensorData &sensor_data)
+{
+	hrt_abstime now = hrt_absolute_time();
+
+	/* with a single sensor there is nothing to vote between, so skip the
+	 * full confidence computation on most samples. The vote is still re-run
+	 * at a low rate to retain the timeout and health checks. */
+	if (sensor_data.subscription_count <= 1 && sensor_data.cached_best >= 0
+	    && now - sensor_data.last_vote_time < SINGLE_SENSOR_VOTE_INTERVAL) {
+		return sensor_data.cached_best;
+	}
+
+	int best_index;
+	sensor_data.voter.get_best(now, &best_index);
+	sensor_data.last_vote_time = now;
+	sensor_data.cached_best = best_index;
+
+	return best_index;
+}
+
 void VotedSensorsUpdate::accel_poll(struct sensor_combined_s &raw)
 {
 	float *offsets[] = {_corrections.accel_offset_0, _corrections.accel_offset_1, _corrections.accel_offset_2 };
 	float *scales[] = {_corrections.accel_scale_0, _corrections.accel_scale_1, _corrections.accel_scale_2 };
 
-	for (unsigned uorb_index = 0; uorb_index < _accel.subscription_count; uorb_index++) {
-		bool accel_updated;
-		orb_check(_accel.subscription[uorb_index], &accel_updated);
+	/* resolve all instances in one middleware call */
+	uint32_t updated_mask = 0;
+	orb_check_multi(_accel.subscription, _accel.subscription_count, &updated_mask);
 
-		if (accel_updated) {
+	for (unsigned uorb_index = 0; uorb_index < _accel.subscription_count; uorb_index++) {
+		if (updated_mask & (1u << uorb_index)) {
 			struct accel_report accel_report;
 
 			orb_copy(ORB_ID(sensor_accel), _accel.subscription[uorb_index], &accel_report);
@@ -604,14 +689,20 @@ void VotedSensorsUpdate::accel_poll(struct sensor_combined_s &raw)
 	}
 
 	// find the best sensor
-	int best_index;
-	_accel.voter.get_best(hrt_absolute_time(), &best_index);
+	int best_index = get_best(_accel);
 
 	// write the best sensor data to the output variables
 	if (best_index >= 0) {
 		raw.accelerometer_integral_dt = _last_sensor_data[best_index].accelerometer_integral_dt;
 
 		if (best_index != _accel.last_best_vote) {
+			/* all instances are mirrored continuously, so this switch is an
+			 * index swap; record the output gap it causes */
+			if (_last_accel_timestamp[_accel.last_best_vote] != 0) {
+				perf_set_elapsed(_failover_latency_perf,
+						 hrt_absolute_time() - _last_accel_timestamp[_accel.last_best_vote]);
+			}
+
 			_accel.last_best_vote = (uint8_t)best_index;
 			_corrections.selected_accel_instance = (uint8_t)best_index;
 			_corrections_changed = true;
@@ -633,11 +724,12 @@ void VotedSensorsUpdate::gyro_poll(struct sensor_combined_s &raw)
 	float *offsets[] = {_corrections.gyro_offset_0, _corrections.gyro_offset_1, _corrections.gyro_offset_2 };
 	float *scales[] = {_corrections.gyro_scale_0, _corrections.gyro_scale_1, _corrections.gyro_scale_2 };
 
-	for (unsigned uorb_index = 0; uorb_index < _gyro.subscription_count; uorb_index++) {
-		bool gyro_updated;
-		orb_check(_gyro.subscription[uorb_index], &gyro_updated);
+	/* resolve all instances in one middleware call */
+	uint32_t updated_mask = 0;
+	orb_check_multi(_gyro.subscription, _gyro.subscription_count, &updated_mask);
 
-		if (gyro_updated) {
+	for (unsigned uorb_index = 0; uorb_index < _gyro.subscription_count; uorb_index++) {
+		if (updated_mask & (1u << uorb_index)) {
 			struct gyro_report gyro_report;
 
 			orb_copy(ORB_ID(sensor_gyro), _gyro.subscription[uorb_index], &gyro_report);
@@ -700,9 +792,27 @@ void VotedSensorsUpdate::gyro_poll(struct sensor_combined_s &raw)
 			// rotate corrected measurements from sensor to body frame
 			gyro_rate = _board_rotation * gyro_rate;
 
-			_last_sensor_data[uorb_index].gyro_rad[0] = gyro_rate(0);
-			_last_sensor_data[uorb_index].gyro_rad[1] = gyro_rate(1);
-			_last_sensor_data[uorb_index].gyro_rad[2] = gyro_rate(2);
+			// track the measured sample rate so the filter bank
+			// coefficients stay matched to it
+			if (_last_sensor_data[uorb_index].gyro_integral_dt > 0) {
+				const float sample_freq = 1.e6f / _last_sensor_data[uorb_index].gyro_integral_dt;
+
+				if (sample_freq < 0.9f * _gyro_filter_sample_freq
+				    || sample_freq > 1.1f * _gyro_filter_sample_freq) {
+					update_gyro_filters(sample_freq);
+				}
+			}
+
+			// run the filter bank (LPF + dual notch) across all axes;
+			// disabled filters are pass-throughs
+			float gyro_filtered[3] = {gyro_rate(0), gyro_rate(1), gyro_rate(2)};
+			_gyro_filter_lpf[uorb_index].apply(gyro_filtered);
+			_gyro_filter_notch[0][uorb_index].apply(gyro_filtered);
+			_gyro_filter_notch[1][uorb_index].apply(gyro_filtered);
+
+			_last_sensor_data[uorb_index].gyro_rad[0] = gyro_filtered[0];
+			_last_sensor_data[uorb_index].gyro_rad[1] = gyro_filtered[1];
+			_last_sensor_data[uorb_index].gyro_rad[2] = gyro_filtered[2];
 
 			_last_sensor_data[uorb_index].timestamp = gyro_report.timestamp;
 			_gyro.voter.put(uorb_index, gyro_report.timestamp, _last_sensor_data[uorb_index].gyro_rad,
@@ -711,8 +821,7 @@ void VotedSensorsUpdate::gyro_poll(struct sensor_combined_s &raw)
 	}
 
 	// find the best sensor
-	int best_index;
-	_gyro.voter.get_best(hrt_absolute_time(), &best_index);
+	int best_index = get_best(_gyro);
 
 	// write data for the best sensor to output variables
 	if (best_index >= 0) {
@@ -720,6 +829,13 @@ void VotedSensorsUpdate::gyro_poll(struct sensor_combined_s &raw)
 		raw.timestamp = _last_sensor_data[best_index].timestamp;
 
 		if (_gyro.last_best_vote != best_index) {
+			/* all instances are mirrored continuously, so this switch is an
+			 * index swap; record the output gap it causes */
+			if (_last_sensor_data[_gyro.last_best_vote].timestamp != 0) {
+				perf_set_elapsed(_failover_latency_perf,
+						 hrt_absolute_time() - _last_sensor_data[_gyro.last_best_vote].timestamp);
+			}
+
 			_gyro.last_best_vote = (uint8_t)best_index;
 			_corrections.selected_gyro_instance = (uint8_t)best_index;
 			_corrections_changed = true;
@@ -738,11 +854,12 @@ void VotedSensorsUpdate::gyro_poll(struct sensor_combined_s &raw)
 
 void VotedSensorsUpdate::mag_poll(struct sensor_combined_s &raw)
 {
-	for (unsigned uorb_index = 0; uorb_index < _mag.subscription_count; uorb_index++) {
-		bool mag_updated;
-		orb_check(_mag.subscription[uorb_index], &mag_updated);
+	/* resolve all instances in one middleware call */
+	uint32_t updated_mask = 0;
+	orb_check_multi(_mag.subscription, _mag.subscription_count, &updated_mask);
 
-		if (mag_updated) {
+	for (unsigned uorb_index = 0; uorb_index < _mag.subscription_count; uorb_index++) {
+		if (updated_mask & (1u << uorb_index)) {
 			struct mag_report mag_report;
 
 			orb_copy(ORB_ID(sensor_mag), _mag.subscription[uorb_index], &mag_report);
@@ -776,8 +893,7 @@ void VotedSensorsUpdate::mag_poll(struct sensor_combined_s &raw)
 		}
 	}
 
-	int best_index;
-	_mag.voter.get_best(hrt_absolute_time(), &best_index);
+	int best_index = get_best(_mag);
 
 	if (best_index >= 0) {
 		raw.magnetometer_ga[0] = _last_sensor_data[best_index].magnetometer_ga[0];
@@ -798,11 +914,12 @@ void VotedSensorsUpdate::baro_poll(struct sensor_combined_s &raw)
 	float *offsets[] = {&_corrections.baro_offset_0, &_corrections.baro_offset_1, &_corrections.baro_offset_2 };
 	float *scales[] = {&_corrections.baro_scale_0, &_corrections.baro_scale_1, &_corrections.baro_scale_2 };
 
-	for (unsigned uorb_index = 0; uorb_index < _baro.subscription_count; uorb_index++) {
-		bool baro_updated;
-		orb_check(_baro.subscription[uorb_index], &baro_updated);
+	/* resolve all instances in one middleware call */
+	uint32_t updated_mask = 0;
+	orb_check_multi(_baro.subscription, _baro.subscription_count, &updated_mask);
 
-		if (baro_updated) {
+	for (unsigned uorb_index = 0; uorb_index < _baro.subscription_count; uorb_index++) {
+		if (updated_mask & (1u << uorb_index)) {
 			struct baro_report baro_report;
 
 			orb_copy(ORB_ID(sensor_baro), _baro.subscription[uorb_index], &baro_report);
@@ -845,8 +962,7 @@ void VotedSensorsUpdate::baro_poll(struct sensor_combined_s &raw)
 	}
 
 	if (got_update) {
-		int best_index;
-		_baro.voter.get_best(hrt_absolute_time(), &best_index);
+		int best_index = get_best(_baro);
 
 		if (best_index >= 0) {
 			raw.baro_temp_celcius = _last_sensor_data[best_index].baro_temp_celcius;
@@ -941,9 +1057,15 @@ bool VotedSensorsUpdate::check_vibration()
 	bool ret = false;
 	hrt_abstime cur_time = hrt_absolute_time();
 
-	if (!_vibration_warning && (_gyro.voter.get_vibration_factor(cur_time) > _parameters.vibration_warning_threshold ||
-				    _accel.voter.get_vibration_factor(cur_time) > _parameters.vibration_warning_threshold ||
-				    _mag.voter.get_vibration_factor(cur_time) > _parameters.vibration_warning_threshold)) {
+	/* the vibration factors are recomputed over the full validator window,
+	 * so evaluate each of them only once per check */
+	float vibe_gyro = _gyro.voter.get_vibration_factor(cur_time);
+	float vibe_accel = _accel.voter.get_vibration_factor(cur_time);
+	float vibe_mag = _mag.voter.get_vibration_factor(cur_time);
+
+	if (!_vibration_warning && (vibe_gyro > _parameters.vibration_warning_threshold ||
+				    vibe_accel > _parameters.vibration_warning_threshold ||
+				    vibe_mag > _parameters.vibration_warning_threshold)) {
 
 		if (_vibration_warning_timestamp == 0) {
 			_vibration_warning_timestamp = cur_time;
@@ -951,9 +1073,9 @@ bool VotedSensorsUpdate::check_vibration()
 		} else if (hrt_elapsed_time(&_vibration_warning_timestamp) > 10000 * 1000) {
 			_vibration_warning = true;
 			mavlink_log_critical(&_mavlink_log_pub, "HIGH VIBRATION! g: %d a: %d m: %d",
-					     (int)(100 * _gyro.voter.get_vibration_factor(cur_time)),
-					     (int)(100 * _accel.voter.get_vibration_factor(cur_time)),
-					     (int)(100 * _mag.voter.get_vibration_factor(cur_time)));
+					     (int)(100 * vibe_gyro),
+					     (int)(100 * vibe_accel),
+					     (int)(100 * vibe_mag));
 			ret = true;
 		}
 
@@ -967,6 +1089,19 @@ bool VotedSensorsUpdate::check_vibration()
 void VotedSensorsUpdate::init_sensor_class(const struct orb_metadata *meta, SensorData &sensor_data,
 		uint8_t sensor_count_max)
 {
+	/* register the advertisement watch before the first scan, so an
+	 * advertisement arriving in between is not missed */
+	if (sensor_data.advert_watch < 0) {
+		sensor_data.advert_watch = orb_watch_advertisements(meta);
+	}
+
+	/* only rescan the instance slots when a new advertisement may have
+	 * appeared; checking the watch is a counter compare, while the scan
+	 * goes through to the filesystem for every slot */
+	if (sensor_data.advert_watch >= 0 && !orb_advertisements_changed(sensor_data.advert_watch)) {
+		return;
+	}
+
 	unsigned group_count = orb_group_count(meta);
 
 	if (group_count > sensor_count_max) {
@@ -1001,6 +1136,8 @@ void VotedSensorsUpdate::print_status()
 	PX4_INFO("baro status:");
 	_baro.voter.print();
 
+	perf_print_counter(_failover_latency_perf);
+
 	_temperature_compensation.print_status();
 }
 
@@ -48,6 +48,7 @@
 #include <drivers/drv_hrt.h>
 
 #include <mathlib/mathlib.h>
+#include <mathlib/math/filter/BiquadFilterBank3.hpp>
 
 #include <lib/ecl/validation/data_validator.h>
 #include <lib/ecl/validation/data_validator_group.h>
@@ -59,6 +60,8 @@
 
 #include <DevMgr.hpp>
 
+#include <systemlib/perf_counter.h>
+
 #include "temperature_compensation.h"
 #include "common.h"
 
@@ -151,7 +154,10 @@ private:
 			: last_best_vote(0),
 			  subscription_count(0),
 			  voter(1),
-			  last_failover_count(0)
+			  last_failover_count(0),
+			  last_vote_time(0),
+			  cached_best(-1),
+			  advert_watch(-1)
 		{
 			for (unsigned i = 0; i < SENSOR_COUNT_MAX; i++) {
 				subscription[i] = -1;
@@ -165,10 +171,21 @@ private:
 		int subscription_count;
 		DataValidatorGroup voter;
 		unsigned int last_failover_count;
+		hrt_abstime last_vote_time; /**< time of the last full vote */
+		int cached_best; /**< result of the last full vote, -1 if none */
+		int advert_watch; /**< uORB advertisement watch for this sensor class, -1 until registered */
 	};
 
 	void	init_sensor_class(const struct orb_metadata *meta, SensorData &sensor_data, uint8_t sensor_count_max);
 
+	/**
+	 * Run the voter for a sensor class, with an early-out for the common
+	 * single-sensor configuration where there is nothing to vote between.
+	 *
+	 * @return index of the best sensor, or -1 if none
+	 */
+	int	get_best(SensorData &sensor_data);
+
 	/**
 	 * Poll the accelerometer for updated data.
 	 *
@@ -238,6 +255,12 @@ private:
 	 */
 	bool apply_mag_calibration(DriverFramework::DevHandle &h, const struct mag_calibration_s *mcal, const int device_id);
 
+	/**
+	 * (Re)compute the gyro filter bank coefficients for the given gyro
+	 * sample frequency and reset the filter states.
+	 */
+	void update_gyro_filters(float sample_freq);
+
 	SensorData _gyro;
 	SensorData _accel;
 	SensorData _mag;
@@ -255,6 +278,12 @@ private:
 	hrt_abstime _vibration_warning_timestamp = 0;
 	bool _vibration_warning = false;
 
+	/* output gap across an IMU best-sensor switch: time from the last sample
+	 * of the previous best to the switchover. All instances are mirrored into
+	 * _last_sensor_data continuously, so this stays within one poll cycle;
+	 * the counter makes that bound visible ('perf' shows min/avg/max). */
+	perf_counter_t _failover_latency_perf;
+
 	math::Matrix<3, 3>	_board_rotation = {};	/**< rotation matrix for the orientation that the board is mounted */
 	math::Matrix<3, 3>	_mag_rotation[MAG_COUNT_MAX] = {};	/**< rotation matrix for the orientation that the external mag0 is mounted */
 
@@ -264,6 +293,12 @@ private:
 	float _accel_diff[3][2];	/**< filtered accel differences between IMU units (m/s/s) */
 	float _gyro_diff[3][2];		/**< filtered gyro differences between IMU uinits (rad/s) */
 
+	/* gyro filter bank (LPF + dual notch), applied once per instance here
+	 * instead of in each consumer; sensor_gyro stays unfiltered */
+	math::BiquadFilterBank3 _gyro_filter_lpf[GYRO_COUNT_MAX];
+	math::BiquadFilterBank3 _gyro_filter_notch[2][GYRO_COUNT_MAX];
+	float _gyro_filter_sample_freq = 0.0f;	/**< sample frequency the coefficients were computed for */
+
 	/* sensor thermal compensation */
 	TemperatureCompensation _temperature_compensation;
 	struct sensor_correction_s _corrections; /**< struct containing the sensor corrections to be published to the uORB*/
@@ -279,6 +314,33 @@ private:
 	uint32_t _gyro_device_id[SENSOR_COUNT_MAX] = {};
 	uint32_t _mag_device_id[SENSOR_COUNT_MAX] = {};
 
+	/**
+	 * Lazily resolved CAL_* parameter handles.
+	 *
+	 * Resolving a parameter by name walks the whole parameter table and
+	 * parameters_update() used to do that dozens of times per call - and
+	 * it runs on every parameter change event. The handles are stable for
+	 * the lifetime of the process, so they are resolved once and cached.
+	 */
+	struct CalParamHandles {
+		param_t id;
+		param_t x_off;
+		param_t y_off;
+		param_t z_off;
+		param_t x_scale;
+		param_t y_scale;
+		param_t z_scale;
+		param_t rot;		/**< mags only, PARAM_INVALID otherwise */
+	};
+
+	/** resolve the CAL_* handle cache on first use */
+	void init_cal_handles();
+
+	CalParamHandles _gyro_cal_handles[GYRO_COUNT_MAX] {};
+	CalParamHandles _accel_cal_handles[ACCEL_COUNT_MAX] {};
+	CalParamHandles _mag_cal_handles[MAG_COUNT_MAX] {};
+	bool _cal_handles_resolved = false;
+
 	static const double	_msl_pressure;	/** average sea-level pressure in kPa */
 };
 
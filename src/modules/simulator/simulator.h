@@ -251,8 +251,12 @@ private:
 		_dist_pub(nullptr),
 		_battery_pub(nullptr),
 		_param_sub(-1),
+		_last_mag{},
+		_last_baro{},
+		_sensor_topics_initialized(false),
 		_initialized(false),
 		_realtime_factor(1.0),
+		_lockstep(false),
 		_system_type(0)
 #ifndef __PX4_QURT
 		,
@@ -337,8 +341,15 @@ private:
 
 	int				_param_sub;
 
+	/* last published mag/baro values; the spare mag lane keeps the array
+	 * usable as a four-lane vector */
+	float _last_mag[4];
+	float _last_baro[2];
+	bool _sensor_topics_initialized;
+
 	bool _initialized;
 	double _realtime_factor;		///< How fast the simulation runs in comparison to real system time
+	bool _lockstep;				///< HRT advances in lockstep with the simulator timestamps
 	hrt_abstime _last_sim_timestamp;
 	hrt_abstime _last_sitl_timestamp;
 
@@ -44,6 +44,7 @@
 #include <netinet/in.h>
 #include <pthread.h>
 #include <conversion/rotation.h>
+#include <conversion/sensor_scale.h>
 #include <mathlib/mathlib.h>
 #include <uORB/topics/vehicle_local_position.h>
 
@@ -298,7 +299,14 @@ void Simulator::handle_message(mavlink_message_t *msg, bool publish)
 			hrt_abstime curr_sitl_time = hrt_absolute_time();
 			hrt_abstime curr_sim_time = imu.time_usec;
 
-			if (compensation_enabled && _initialized
+			if (_lockstep && compensation_enabled) {
+				// in lockstep mode the simulator timestamps are the time base:
+				// advancing the HRT here wakes everything scheduled against it,
+				// so the system runs exactly as fast as the simulator produces
+				// sensor data, no faster and no slower
+				hrt_lockstep_set_time(curr_sim_time);
+
+			} else if (compensation_enabled && _initialized
 			    && _last_sim_timestamp > 0 && _last_sitl_timestamp > 0
 			    && _last_sitl_timestamp < curr_sitl_time
 			    && _last_sim_timestamp < curr_sim_time) {
@@ -675,6 +683,12 @@ void Simulator::pollForMAVLinkMessages(bool publish, int udp_port)
 	pthread_setname_np(pthread_self(), "sim_rcv");
 #endif
 
+	if (getenv("PX4_SIM_LOCKSTEP")) {
+		hrt_lockstep_enable();
+		_lockstep = true;
+		PX4_INFO("running in lockstep with the simulator");
+	}
+
 	// udp socket data
 	struct sockaddr_in _myaddr;
 
@@ -682,6 +696,14 @@ void Simulator::pollForMAVLinkMessages(bool publish, int udp_port)
 		int prt;
 		param_get(param_find("SITL_UDP_PRT"), &prt);
 		udp_port = prt;
+
+		// in multi-vehicle SITL every instance listens on its own port so
+		// one simulator host can serve the whole group from a single config
+		const char *sim_instance = getenv("PX4_SIM_INSTANCE");
+
+		if (sim_instance != nullptr) {
+			udp_port += atoi(sim_instance) * 10;
+		}
 	}
 
 	// try to setup udp socket for communcation with simulator
@@ -1019,12 +1041,17 @@ int Simulator::publish_sensor_topics(mavlink_hil_sensor_t *imu)
 		struct gyro_report gyro = {};
 
 		gyro.timestamp = timestamp;
-		gyro.x_raw = imu->xgyro * 1000.0f;
-		gyro.y_raw = imu->ygyro * 1000.0f;
-		gyro.z_raw = imu->zgyro * 1000.0f;
-		gyro.x = imu->xgyro;
-		gyro.y = imu->ygyro;
-		gyro.z = imu->zgyro;
+
+		const float rad_s[4] = {imu->xgyro, imu->ygyro, imu->zgyro, 0.0f};
+		float raw[4];
+		sensor_scale4f(rad_s, 1000.0f, raw);
+
+		gyro.x_raw = raw[0];
+		gyro.y_raw = raw[1];
+		gyro.z_raw = raw[2];
+		gyro.x = rad_s[0];
+		gyro.y = rad_s[1];
+		gyro.z = rad_s[2];
 
 		gyro.temperature = imu->temperature;
 
@@ -1037,12 +1064,17 @@ int Simulator::publish_sensor_topics(mavlink_hil_sensor_t *imu)
 		struct accel_report accel = {};
 
 		accel.timestamp = timestamp;
-		accel.x_raw = imu->xacc / mg2ms2;
-		accel.y_raw = imu->yacc / mg2ms2;
-		accel.z_raw = imu->zacc / mg2ms2;
-		accel.x = imu->xacc;
-		accel.y = imu->yacc;
-		accel.z = imu->zacc;
+
+		const float ms2[4] = {imu->xacc, imu->yacc, imu->zacc, 0.0f};
+		float raw[4];
+		sensor_scale4f(ms2, 1.0f / mg2ms2, raw);
+
+		accel.x_raw = raw[0];
+		accel.y_raw = raw[1];
+		accel.z_raw = raw[2];
+		accel.x = ms2[0];
+		accel.y = ms2[1];
+		accel.z = ms2[2];
 
 		accel.temperature = imu->temperature;
 
@@ -1050,17 +1082,27 @@ int Simulator::publish_sensor_topics(mavlink_hil_sensor_t *imu)
 		orb_publish_auto(ORB_ID(sensor_accel), &_accel_pub, &accel, &accel_multi, ORB_PRIO_HIGH);
 	}
 
-	/* magnetometer */
-	{
+	/* magnetometer: the simulator repeats the last mag sample in every
+	 * HIL_SENSOR message between mag updates, so only publish a change */
+	if (imu->xmag != _last_mag[0] || imu->ymag != _last_mag[1] || imu->zmag != _last_mag[2] || !_sensor_topics_initialized) {
+
+		_last_mag[0] = imu->xmag;
+		_last_mag[1] = imu->ymag;
+		_last_mag[2] = imu->zmag;
+
 		struct mag_report mag = {};
 
 		mag.timestamp = timestamp;
-		mag.x_raw = imu->xmag * 1000.0f;
-		mag.y_raw = imu->ymag * 1000.0f;
-		mag.z_raw = imu->zmag * 1000.0f;
-		mag.x = imu->xmag;
-		mag.y = imu->ymag;
-		mag.z = imu->zmag;
+
+		float raw[4];
+		sensor_scale4f(_last_mag, 1000.0f, raw);
+
+		mag.x_raw = raw[0];
+		mag.y_raw = raw[1];
+		mag.z_raw = raw[2];
+		mag.x = _last_mag[0];
+		mag.y = _last_mag[1];
+		mag.z = _last_mag[2];
 
 		mag.temperature = imu->temperature;
 
@@ -1068,8 +1110,12 @@ int Simulator::publish_sensor_topics(mavlink_hil_sensor_t *imu)
 		orb_publish_auto(ORB_ID(sensor_mag), &_mag_pub, &mag, &mag_multi, ORB_PRIO_HIGH);
 	}
 
-	/* baro */
-	{
+	/* baro: same, only publish an actual update */
+	if (imu->abs_pressure != _last_baro[0] || imu->pressure_alt != _last_baro[1] || !_sensor_topics_initialized) {
+
+		_last_baro[0] = imu->abs_pressure;
+		_last_baro[1] = imu->pressure_alt;
+
 		struct baro_report baro = {};
 
 		baro.timestamp = timestamp;
@@ -1081,6 +1127,8 @@ int Simulator::publish_sensor_topics(mavlink_hil_sensor_t *imu)
 		orb_publish_auto(ORB_ID(sensor_baro), &_baro_pub, &baro, &baro_multi, ORB_PRIO_HIGH);
 	}
 
+	_sensor_topics_initialized = true;
+
 	return OK;
 }
 
@@ -1106,9 +1154,12 @@ int Simulator::publish_flow_topic(mavlink_hil_optical_flow_t *flow_mavlink)
 	flow.pixel_flow_y_integral = flow_mavlink->integrated_y;
 	flow.quality = flow_mavlink->quality;
 
-	/* rotate measurements according to parameter */
+	/* rotate measurements according to parameter; the handle lookup is a
+	 * string search, do it once */
+	static param_t flow_rot_param = param_find("SENS_FLOW_ROT");
+
 	enum Rotation flow_rot;
-	param_get(param_find("SENS_FLOW_ROT"), &flow_rot);
+	param_get(flow_rot_param, &flow_rot);
 
 	float zeroval = 0.0f;
 	rotate_3f(flow_rot, flow.pixel_flow_x_integral, flow.pixel_flow_y_integral, zeroval);
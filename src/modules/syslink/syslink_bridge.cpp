@@ -45,10 +45,11 @@
 SyslinkBridge::SyslinkBridge(Syslink *link) :
 	CDev("SyslinkBridge", "/dev/bridge0"),
 	_link(link),
-	_readbuffer(16, sizeof(crtp_message_t))
+	_readbuffer(16, sizeof(crtp_message_t)),
+	_msg_to_send_size(0)
 {
-
-
+	_msg_to_send.header = 0;
+	_msg_to_send.port = CRTP_PORT_MAVLINK;
 }
 
 SyslinkBridge::~SyslinkBridge()
@@ -110,23 +111,30 @@ SyslinkBridge::read(struct file *filp, char *buffer, size_t buflen)
 ssize_t
 SyslinkBridge::write(struct file *filp, const char *buffer, size_t buflen)
 {
-	crtp_message_t msg;
-
-	// Queue and send next time we get a RAW radio packet
+	// Append to the aggregation frame; only full frames move to the write
+	// queue, partial ones are flushed by the link when the radio goes idle.
+	// This packs several small mavlink messages into each 31-byte radio frame.
 	int remaining = buflen;
 
+	lock();
+
 	while (remaining > 0) {
-		int datasize = MIN(remaining, CRTP_MAX_DATA_SIZE);
-		msg.size = datasize + sizeof(msg.header);
-		msg.port = CRTP_PORT_MAVLINK;
-		memcpy(&msg.data, buffer, datasize);
+		int datasize = MIN(remaining, CRTP_MAX_DATA_SIZE - _msg_to_send_size);
+		memcpy(&_msg_to_send.data[_msg_to_send_size], buffer, datasize);
+		_msg_to_send_size += datasize;
 
-		_link->_writebuffer.force(&msg, sizeof(crtp_message_t));
+		if (_msg_to_send_size == CRTP_MAX_DATA_SIZE) {
+			_msg_to_send.size = _msg_to_send_size + sizeof(_msg_to_send.header);
+			_link->_writebuffer.force(&_msg_to_send, sizeof(crtp_message_t));
+			_msg_to_send_size = 0;
+		}
 
 		buffer += datasize;
 		remaining -= datasize;
 	}
 
+	unlock();
+
 	return buflen;
 }
 
@@ -155,3 +163,17 @@ SyslinkBridge::pipe_message(crtp_message_t *msg)
 	_readbuffer.force(msg, sizeof(msg->size) + msg->size);
 	poll_notify(POLLIN);
 }
+
+void
+SyslinkBridge::flush_pending()
+{
+	lock();
+
+	if (_msg_to_send_size > 0 && _link->_writebuffer.space() > 0) {
+		_msg_to_send.size = _msg_to_send_size + sizeof(_msg_to_send.header);
+		_link->_writebuffer.force(&_msg_to_send, sizeof(crtp_message_t));
+		_msg_to_send_size = 0;
+	}
+
+	unlock();
+}
@@ -90,6 +90,7 @@ Syslink::Syslink() :
 	_syslink_task(-1),
 	_task_running(false),
 	_bootloader_mode(false),
+	_tx_credits(TX_CREDITS_MAX),
 	_count(0),
 	_null_count(0),
 	_count_in(0),
@@ -162,6 +163,12 @@ Syslink::set_address(uint64_t addr)
 int
 Syslink::send_queued_raw_message()
 {
+	if (_writebuffer.empty()) {
+		// no full frame queued; send a partially filled aggregation frame
+		// rather than leaving the downlink slot unused
+		_bridge->flush_pending();
+	}
+
 	if (_writebuffer.empty()) {
 		return 0;
 	}
@@ -175,7 +182,9 @@ Syslink::send_queued_raw_message()
 
 	_writebuffer.get(&msg.length, sizeof(crtp_message_t));
 
-	return send_message(&msg);
+	send_message(&msg);
+
+	return 1;
 }
 
 
@@ -589,8 +598,17 @@ Syslink::handle_raw(syslink_message_t *sys)
 		return;
 	}
 
-	// Allow one raw message to be sent from the queue
-	send_queued_raw_message();
+	// Every received radio frame (data or null) means the radio completed a
+	// poll round, which is a downlink opportunity: grant a transmit credit
+	// and drain the queue while credits last, so bursts are not throttled to
+	// one frame per received packet
+	if (_tx_credits < TX_CREDITS_MAX) {
+		_tx_credits++;
+	}
+
+	while (_tx_credits > 0 && send_queued_raw_message()) {
+		_tx_credits--;
+	}
 }
 
 void
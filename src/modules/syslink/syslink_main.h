@@ -96,6 +96,8 @@ private:
 	// Checksums and transmits a syslink message
 	int send_message(syslink_message_t *msg);
 
+	// Sends the next queued raw message, if any. Returns 1 if a message was
+	// sent, 0 if the queue was empty.
 	int send_queued_raw_message();
 
 	void update_params(bool force_set);
@@ -104,6 +106,14 @@ private:
 	bool _task_running;
 	bool _bootloader_mode;
 
+	// Radio TX flow control: the nrf51 can only downlink a handful of frames
+	// per radio poll round, so sends are paced by credits granted for each
+	// received radio frame (data or null). The window lets bursts use
+	// back-to-back downlink slots instead of strictly alternating one-in
+	// one-out with the poll traffic.
+	static const int TX_CREDITS_MAX = 4;
+	int _tx_credits;
+
 	int _count;
 	int _null_count;
 	int _count_in;
@@ -168,6 +178,10 @@ public:
 	// Makes the message available for reading to processes reading from the bridge
 	void pipe_message(crtp_message_t *msg);
 
+	// Moves a partially filled aggregation frame to the write queue; called by
+	// the link when the radio runs out of full frames to send
+	void flush_pending();
+
 protected:
 
 	virtual pollevent_t poll_state(struct file *filp);
@@ -179,6 +193,11 @@ private:
 	// Stores data that was received from syslink but not yet read by another driver
 	ringbuffer::RingBuffer _readbuffer;
 
+	// Partially filled CRTP frame: writes append to it and full frames move to
+	// the link's write queue, so several small mavlink messages share one
+	// radio frame instead of wasting most of its 31 payload bytes
+	crtp_message_t _msg_to_send;
+	int _msg_to_send_size;
 
 };
 
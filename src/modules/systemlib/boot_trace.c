@@ -0,0 +1,90 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file boot_trace.c
+ *
+ * Boot-time event trace, see boot_trace.h.
+ */
+
+#include "boot_trace.h"
+
+#include <string.h>
+
+#include <px4_config.h>
+#include <drivers/drv_hrt.h>
+
+struct boot_trace_event_s boot_trace_events[BOOT_TRACE_MAX_EVENTS];
+
+static volatile unsigned _count = 0;
+static volatile bool _finished = false;
+
+void boot_trace_mark(const char *name)
+{
+	if (_finished || name == NULL) {
+		return;
+	}
+
+	/* claim a slot; concurrent spawns can race here, but a lost slot only
+	 * costs one trace entry and boot is essentially sequential anyway */
+	unsigned idx = _count;
+
+	if (idx >= BOOT_TRACE_MAX_EVENTS) {
+		return;
+	}
+
+	_count = idx + 1;
+
+	boot_trace_events[idx].time = hrt_absolute_time();
+	strncpy(boot_trace_events[idx].name, name, BOOT_TRACE_NAME_LEN - 1);
+	boot_trace_events[idx].name[BOOT_TRACE_NAME_LEN - 1] = '\0';
+}
+
+void boot_trace_finish(void)
+{
+	if (!_finished) {
+		boot_trace_mark("boot complete");
+		_finished = true;
+	}
+}
+
+unsigned boot_trace_count(void)
+{
+	unsigned count = _count;
+	return count < BOOT_TRACE_MAX_EVENTS ? count : BOOT_TRACE_MAX_EVENTS;
+}
+
+bool boot_trace_active(void)
+{
+	return !_finished;
+}
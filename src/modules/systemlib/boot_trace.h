@@ -0,0 +1,85 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file boot_trace.h
+ *
+ * Boot-time event trace.
+ *
+ * A small static table records timestamped events during boot: every
+ * px4_task_spawn_cmd() call, the ready point of ModuleBase modules, and
+ * explicit marks from the startup script (via the 'bootlog' command).
+ * Recording stops when the table is full or when boot_trace_finish() is
+ * called at the end of rcS, so steady-state operation pays nothing.
+ *
+ * The 'bootlog' command prints the trace, writes it as a report file and
+ * publishes the boot_report summary topic, so boot time regressions show
+ * up in logs and CI instead of being tuned blind.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+__BEGIN_DECLS
+
+#define BOOT_TRACE_MAX_EVENTS	64
+#define BOOT_TRACE_NAME_LEN	24
+
+struct boot_trace_event_s {
+	uint64_t	time;			/**< hrt timestamp of the event */
+	char		name[BOOT_TRACE_NAME_LEN]; /**< event name, truncated */
+};
+
+__EXPORT extern struct boot_trace_event_s boot_trace_events[BOOT_TRACE_MAX_EVENTS];
+
+/**
+ * Record one boot event. No-op once recording has finished or the table
+ * is full.
+ */
+__EXPORT void boot_trace_mark(const char *name);
+
+/**
+ * Stop recording. Call once at the end of the startup script; the first
+ * call freezes the trace, later calls are ignored.
+ */
+__EXPORT void boot_trace_finish(void);
+
+/** number of recorded events */
+__EXPORT unsigned boot_trace_count(void);
+
+/** whether recording is still active */
+__EXPORT bool boot_trace_active(void);
+
+__END_DECLS
@@ -272,6 +272,23 @@ bson_decoder_next(bson_decoder_t decoder)
 
 			break;
 
+		case BSON_VARINT: {
+				uint64_t zig = 0;
+				unsigned shift = 0;
+
+				do {
+					if (shift > 63 || read_int8(decoder, &tbyte)) {
+						CODER_KILL(decoder, "read error on BSON_VARINT");
+					}
+
+					zig |= (uint64_t)(tbyte & 0x7f) << shift;
+					shift += 7;
+				} while (tbyte & 0x80);
+
+				decoder->node.i = (int64_t)(zig >> 1) ^ -(int64_t)(zig & 1);
+			}
+			break;
+
 		case BSON_DOUBLE:
 			if (read_double(decoder, &decoder->node.d)) {
 				CODER_KILL(decoder, "read error on BSON_DOUBLE");
@@ -333,13 +350,47 @@ bson_decoder_data_pending(bson_decoder_t decoder)
 	return decoder->pending;
 }
 
+/* write out buffered data in buffered file mode */
+static int
+flush_buf(bson_encoder_t encoder)
+{
+	if (encoder->bufpos > 0) {
+		if (BSON_WRITE(encoder->fd, encoder->buf, encoder->bufpos) != (int)encoder->bufpos) {
+			return -1;
+		}
+
+		encoder->bufpos = 0;
+	}
+
+	return 0;
+}
+
 static int
 write_x(bson_encoder_t encoder, const void *p, size_t s)
 {
 	CODER_CHECK(encoder);
 
 	if (encoder->fd > -1) {
-		return (BSON_WRITE(encoder->fd, p, s) == (int)s) ? 0 : -1;
+		if (encoder->buf == NULL) {
+			return (BSON_WRITE(encoder->fd, p, s) == (int)s) ? 0 : -1;
+		}
+
+		/* buffered file mode: flush when the next span won't fit */
+		if ((encoder->bufpos + s) > encoder->bufsize) {
+			if (flush_buf(encoder)) {
+				CODER_KILL(encoder, "write error on buffer flush");
+			}
+		}
+
+		/* oversized spans bypass the buffer */
+		if (s > encoder->bufsize) {
+			return (BSON_WRITE(encoder->fd, p, s) == (int)s) ? 0 : -1;
+		}
+
+		memcpy(encoder->buf + encoder->bufpos, p, s);
+		encoder->bufpos += s;
+
+		return 0;
 	}
 
 	/* do we need to extend the buffer? */
@@ -440,6 +491,23 @@ bson_encoder_init_buf(bson_encoder_t encoder, void *buf, unsigned bufsize)
 	return 0;
 }
 
+int
+bson_encoder_init_buf_file(bson_encoder_t encoder, int fd, void *buf, unsigned bufsize)
+{
+	encoder->fd = fd;
+	encoder->buf = (uint8_t *)buf;
+	encoder->bufpos = 0;
+	encoder->bufsize = bufsize;
+	encoder->realloc_ok = false;
+	encoder->dead = false;
+
+	if (write_int32(encoder, 0)) {
+		CODER_KILL(encoder, "write error on document length");
+	}
+
+	return 0;
+}
+
 int
 bson_encoder_fini(bson_encoder_t encoder)
 {
@@ -450,13 +518,17 @@ bson_encoder_fini(bson_encoder_t encoder)
 	}
 
 	/* hack to fix up length for in-buffer documents */
-	if (encoder->buf != NULL) {
+	if (encoder->fd == -1 && encoder->buf != NULL) {
 		int32_t len = bson_encoder_buf_size(encoder);
 		memcpy(encoder->buf, &len, sizeof(len));
 	}
 
-	/* sync file */
+	/* write out any remaining buffered data and sync the file */
 	if (encoder->fd > -1) {
+		if (encoder->buf != NULL && flush_buf(encoder)) {
+			CODER_KILL(encoder, "write error on final buffer flush");
+		}
+
 		BSON_FSYNC(encoder->fd);
 	}
 
@@ -528,6 +600,38 @@ bson_encoder_append_int(bson_encoder_t encoder, const char *name, int64_t value)
 	return 0;
 }
 
+int
+bson_encoder_append_varint(bson_encoder_t encoder, const char *name, int64_t value)
+{
+	uint8_t varint[10];
+	unsigned len = 0;
+
+	CODER_CHECK(encoder);
+
+	/* zigzag-map the sign, then encode seven bits per byte, high bit set on
+	 * all but the last byte */
+	uint64_t zig = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+
+	do {
+		uint8_t b = zig & 0x7f;
+		zig >>= 7;
+
+		if (zig != 0) {
+			b |= 0x80;
+		}
+
+		varint[len++] = b;
+	} while (zig != 0);
+
+	if (write_int8(encoder, BSON_VARINT) ||
+	    write_name(encoder, name) ||
+	    write_x(encoder, varint, len)) {
+		CODER_KILL(encoder, "write error on BSON_VARINT");
+	}
+
+	return 0;
+}
+
 int
 bson_encoder_append_double(bson_encoder_t encoder, const char *name, double value)
 {
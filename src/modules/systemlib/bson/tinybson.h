@@ -60,7 +60,8 @@ typedef enum {
 	BSON_DATE = 9,
 	BSON_NULL = 10,
 	BSON_INT32 = 16,
-	BSON_INT64 = 18
+	BSON_INT64 = 18,
+	BSON_VARINT = 64	/**< not part of the BSON spec: zigzag LEB128 integer, for compact parameter storage */
 } bson_type_t;
 
 typedef enum bson_binary_subtype {
@@ -205,6 +206,21 @@ __EXPORT int bson_encoder_init_file(bson_encoder_t encoder, int fd);
  */
 __EXPORT int bson_encoder_init_buf(bson_encoder_t encoder, void *buf, unsigned bufsize);
 
+/**
+ * Initialize the encoder for writing to a file through a caller-provided buffer.
+ *
+ * The document is serialized into the buffer and written to the file in
+ * buffer-sized chunks (plus one final chunk on bson_encoder_fini), instead of
+ * one small write per field as in the plain file mode.
+ *
+ * @param encoder		Encoder state structure to be initialised.
+ * @param fd			File to write to.
+ * @param buf			Work buffer to serialize into.
+ * @param bufsize		Size of the work buffer.
+ * @return			Zero on success.
+ */
+__EXPORT int bson_encoder_init_buf_file(bson_encoder_t encoder, int fd, void *buf, unsigned bufsize);
+
 /**
  * Finalise the encoded stream.
  *
@@ -243,6 +259,15 @@ __EXPORT int bson_encoder_append_bool(bson_encoder_t encoder, const char *name,
  */
 __EXPORT int bson_encoder_append_int(bson_encoder_t encoder, const char *name, int64_t value);
 
+/**
+ * Append a zigzag LEB128 encoded integer to the encoded stream.
+ *
+ * Small magnitudes take one byte instead of the four or eight of the fixed
+ * BSON integer types. Not readable by standard BSON parsers; the decoder
+ * reports these nodes with type BSON_VARINT and the value in node->i.
+ */
+__EXPORT int bson_encoder_append_varint(bson_encoder_t encoder, const char *name, int64_t value);
+
 /**
  * Append a double to the encoded stream
  *
@@ -115,6 +115,15 @@ static bool working_buffer_static;
 static sector_descriptor_t *sector_map;
 static int last_erased;
 
+/* Cached location of the most recently located valid entry. All mutation
+ * of the flash goes through this module, so the cache only needs
+ * invalidating on erase and is refreshed on write. It turns the magic
+ * hunt across the sectors into a once-per-boot cost instead of a
+ * per-access one, so reads during early boot return immediately.
+ */
+static flash_entry_header_t *cached_entry;
+static flash_file_token_t cached_token;
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -439,6 +448,10 @@ static inline data_size_t entry_crc_length(flash_entry_header_t *fi)
 
 static flash_entry_header_t *find_entry(flash_file_token_t token)
 {
+	if (cached_entry != NULL && cached_token.t == token.t) {
+		return cached_entry;
+	}
+
 	for (int s = 0; sector_map[s].address; s++) {
 
 		h_magic_t *pmagic = (h_magic_t *) sector_map[s].address;
@@ -468,6 +481,8 @@ cont:
 
 			if (valid_entry(pf) && pf->file_token.t == token.t) {
 
+				cached_entry = pf;
+				cached_token = token;
 				return pf;
 
 			} else {
@@ -649,6 +664,7 @@ static int erase_sector(sector_descriptor_t *sm, flash_entry_header_t *pf)
 
 	if (page > 0 && page == sm->page) {
 		last_erased = sm->page;
+		cached_entry = NULL;
 		ssize_t size = up_progmem_erasepage(page);
 
 		if (size < 0 || size != sm->size) {
@@ -680,6 +696,11 @@ static int erase_entry(flash_entry_header_t *pf)
 	h_flag_t data = ErasedEntry;
 	size_t size = sizeof(h_flag_t);
 	int rv = up_progmem_write((size_t) &pf->flag, &data, size);
+
+	if (pf == cached_entry) {
+		cached_entry = NULL;
+	}
+
 	return rv;
 }
 
@@ -880,6 +901,12 @@ parameter_flashfs_write(flash_file_token_t token, uint8_t *buffer, size_t buf_si
 
 		pn->crc = crc32(entry_crc_start(pn), entry_crc_length(pn));
 		rv = up_progmem_write((size_t) pf, pn, pn->size);
+
+		if (rv >= 0) {
+			cached_entry = pf;
+			cached_token = token;
+		}
+
 		int system_bytes = (sizeof(flash_entry_header_t) + size_adjust);
 
 		if (rv >= system_bytes) {
@@ -1023,6 +1050,7 @@ int parameter_flashfs_init(sector_descriptor_t *fconfig, uint8_t *buffer, uint16
 	working_buffer = buffer;
 	working_buffer_size = size;
 	last_erased = -1;
+	cached_entry = NULL;
 
 	/* Sanity check */
 
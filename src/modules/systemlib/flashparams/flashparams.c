@@ -50,7 +50,6 @@
 #include <stdint.h>
 
 #include "systemlib/param/param.h"
-#include "systemlib/uthash/utarray.h"
 #include "systemlib/bson/tinybson.h"
 #include "flashparams.h"
 #include "flashfs.h"
@@ -62,19 +61,9 @@
 #endif
 
 
-/**
- * Storage for modified parameters.
- */
-struct param_wbuf_s {
-	union param_value_u     val;
-	param_t                 param;
-	bool                    unsaved;
-};
-
 static int
 param_export_internal(bool only_unsaved)
 {
-	struct param_wbuf_s *s = NULL;
 	struct bson_encoder_s encoder;
 	int     result = -1;
 
@@ -82,14 +71,9 @@ param_export_internal(bool only_unsaved)
 
 	bson_encoder_init_buf(&encoder, NULL, 0);
 
-	/* no modified parameters -> we are done */
-	if (param_values == NULL) {
-		result = 0;
-		goto out;
-	}
-
-	while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
+	for (unsigned idx = 0; idx < param_store.count; idx++) {
 
+		const param_t param = param_store.ids[idx];
 		int32_t i;
 		float   f;
 
@@ -97,31 +81,31 @@ param_export_internal(bool only_unsaved)
 		 * If we are only saving values changed since last save, and this
 		 * one hasn't, then skip it
 		 */
-		if (only_unsaved && !s->unsaved) {
+		if (only_unsaved && !(param_store.unsaved[idx / 8] & (1 << (idx % 8)))) {
 			continue;
 		}
 
-		s->unsaved = false;
+		param_store.unsaved[idx / 8] &= ~(1 << (idx % 8));
 
 		/* append the appropriate BSON type object */
 
-		switch (param_type(s->param)) {
+		switch (param_type(param)) {
 
 		case PARAM_TYPE_INT32:
-			i = s->val.i;
+			i = param_store.vals[idx].i;
 
-			if (bson_encoder_append_int(&encoder, param_name(s->param), i)) {
-				debug("BSON append failed for '%s'", param_name(s->param));
+			if (bson_encoder_append_int(&encoder, param_name(param), i)) {
+				debug("BSON append failed for '%s'", param_name(param));
 				goto out;
 			}
 
 			break;
 
 		case PARAM_TYPE_FLOAT:
-			f = s->val.f;
+			f = param_store.vals[idx].f;
 
-			if (bson_encoder_append_double(&encoder, param_name(s->param), f)) {
-				debug("BSON append failed for '%s'", param_name(s->param));
+			if (bson_encoder_append_double(&encoder, param_name(param), f)) {
+				debug("BSON append failed for '%s'", param_name(param));
 				goto out;
 			}
 
@@ -129,11 +113,11 @@ param_export_internal(bool only_unsaved)
 
 		case PARAM_TYPE_STRUCT ... PARAM_TYPE_STRUCT_MAX:
 			if (bson_encoder_append_binary(&encoder,
-						       param_name(s->param),
+						       param_name(param),
 						       BSON_BIN_BINARY,
-						       param_size(s->param),
-						       param_get_value_ptr_external(s->param))) {
-				debug("BSON append failed for '%s'", param_name(s->param));
+						       param_size(param),
+						       param_get_value_ptr_external(param))) {
+				debug("BSON append failed for '%s'", param_name(param));
 				goto out;
 			}
 
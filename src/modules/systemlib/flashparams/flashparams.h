@@ -49,18 +49,32 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <sys/types.h>
-#include "systemlib/uthash/utarray.h"
 
 __BEGIN_DECLS
 
 /*
  * When using the flash based parameter store we have to force
- * the param_values and 2 functions to be global
+ * the param_store and 2 functions to be global
  */
 
 #define FLASH_PARAMS_EXPOSE __EXPORT
 
-__EXPORT extern UT_array        *param_values;
+/**
+ * Storage for modified parameters, kept sorted by handle.
+ *
+ * Values, handles and unsaved markers live in three packed arrays instead
+ * of an array of padded structs, and the arrays grow in fixed steps
+ * instead of doubling, which bounds the allocation slack.
+ */
+struct param_store_s {
+	union param_value_u	*vals;		/**< packed modified values, sorted by handle */
+	param_t			*ids;		/**< modified handles, ascending */
+	uint8_t			*unsaved;	/**< not-yet-saved markers, one bit per entry */
+	unsigned		count;		/**< number of modified parameters */
+	unsigned		size;		/**< allocated entries */
+};
+
+__EXPORT extern struct param_store_s param_store;
 __EXPORT int param_set_external(param_t param, const void *val, bool mark_saved, bool notify_changes);
 __EXPORT const void *param_get_value_ptr_external(param_t param);
 
@@ -0,0 +1,238 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file heap_trace.c
+ *
+ * Per-task heap allocation accounting via linker-wrapped allocators.
+ */
+
+#include <px4_config.h>
+
+#ifdef HEAP_TRACE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#if defined(CONFIG_TASK_NAME_SIZE) && CONFIG_TASK_NAME_SIZE > 0
+#include <sys/prctl.h>
+#endif
+
+#include "heap_trace.h"
+
+/* the real allocators, provided by the linker via --wrap */
+extern void *__real_malloc(size_t size);
+extern void *__real_calloc(size_t nmemb, size_t size);
+extern void *__real_realloc(void *ptr, size_t size);
+extern void __real_free(void *ptr);
+
+__EXPORT void *__wrap_malloc(size_t size);
+__EXPORT void *__wrap_calloc(size_t nmemb, size_t size);
+__EXPORT void *__wrap_realloc(void *ptr, size_t size);
+__EXPORT void __wrap_free(void *ptr);
+
+/* Every traced allocation is prefixed with this header. It keeps the user
+ * pointer 8-byte aligned, and the magic lets free() hand allocations made
+ * before the wrappers were active straight to the real allocator.
+ */
+struct heap_trace_hdr_s {
+	uint32_t	size;		/* user requested size */
+	int16_t		slot;		/* index into heap_trace_tasks, -1 if table full */
+	uint16_t	magic;
+};
+
+#define HEAP_TRACE_MAGIC	0xb487
+
+struct heap_trace_task_s heap_trace_tasks[HEAP_TRACE_MAX_TASKS];
+static bool heap_trace_initialized;
+
+/* find or create the accounting slot of the calling task, returns -1 if the
+ * table is full; called with the scheduler locked */
+static int heap_trace_slot(void)
+{
+	if (!heap_trace_initialized) {
+		for (int i = 0; i < HEAP_TRACE_MAX_TASKS; i++) {
+			heap_trace_tasks[i].pid = -1;
+		}
+
+		heap_trace_initialized = true;
+	}
+
+	pid_t pid = getpid();
+	int free_slot = -1;
+
+	for (int i = 0; i < HEAP_TRACE_MAX_TASKS; i++) {
+		if (heap_trace_tasks[i].pid == pid) {
+			return i;
+		}
+
+		if (free_slot < 0 && heap_trace_tasks[i].pid == -1) {
+			free_slot = i;
+		}
+	}
+
+	if (free_slot >= 0) {
+		memset(&heap_trace_tasks[free_slot], 0, sizeof(heap_trace_tasks[free_slot]));
+		heap_trace_tasks[free_slot].pid = pid;
+#if defined(CONFIG_TASK_NAME_SIZE) && CONFIG_TASK_NAME_SIZE > 0
+		prctl(PR_GET_NAME, heap_trace_tasks[free_slot].name, pid);
+		heap_trace_tasks[free_slot].name[HEAP_TRACE_NAME_LEN - 1] = '\0';
+#endif
+	}
+
+	return free_slot;
+}
+
+static void heap_trace_account_alloc(struct heap_trace_hdr_s *hdr, size_t size)
+{
+	sched_lock();
+
+	int slot = heap_trace_slot();
+
+	hdr->size = size;
+	hdr->slot = slot;
+	hdr->magic = HEAP_TRACE_MAGIC;
+
+	if (slot >= 0) {
+		struct heap_trace_task_s *t = &heap_trace_tasks[slot];
+		t->live += size;
+		t->allocs++;
+		t->alloc_bytes += size;
+
+		if (t->live > t->peak) {
+			t->peak = t->live;
+		}
+	}
+
+	sched_unlock();
+}
+
+static void heap_trace_account_free(struct heap_trace_hdr_s *hdr)
+{
+	sched_lock();
+
+	if (hdr->slot >= 0 && hdr->slot < HEAP_TRACE_MAX_TASKS) {
+		heap_trace_tasks[hdr->slot].live -= hdr->size;
+	}
+
+	hdr->magic = 0;
+
+	sched_unlock();
+}
+
+void *__wrap_malloc(size_t size)
+{
+	struct heap_trace_hdr_s *hdr = __real_malloc(size + sizeof(struct heap_trace_hdr_s));
+
+	if (hdr == NULL) {
+		return NULL;
+	}
+
+	heap_trace_account_alloc(hdr, size);
+
+	return hdr + 1;
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size)
+{
+	void *mem = __wrap_malloc(nmemb * size);
+
+	if (mem != NULL) {
+		memset(mem, 0, nmemb * size);
+	}
+
+	return mem;
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+	if (ptr == NULL) {
+		return __wrap_malloc(size);
+	}
+
+	struct heap_trace_hdr_s *hdr = ((struct heap_trace_hdr_s *)ptr) - 1;
+
+	if (hdr->magic != HEAP_TRACE_MAGIC) {
+		/* not one of ours - pass through untraced */
+		return __real_realloc(ptr, size);
+	}
+
+	heap_trace_account_free(hdr);
+
+	hdr = __real_realloc(hdr, size + sizeof(struct heap_trace_hdr_s));
+
+	if (hdr == NULL) {
+		return NULL;
+	}
+
+	heap_trace_account_alloc(hdr, size);
+
+	return hdr + 1;
+}
+
+void __wrap_free(void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+	struct heap_trace_hdr_s *hdr = ((struct heap_trace_hdr_s *)ptr) - 1;
+
+	if (hdr->magic != HEAP_TRACE_MAGIC) {
+		/* allocated before the wrappers were active */
+		__real_free(ptr);
+		return;
+	}
+
+	heap_trace_account_free(hdr);
+	__real_free(hdr);
+}
+
+void heap_trace_reset(void)
+{
+	sched_lock();
+
+	for (int i = 0; i < HEAP_TRACE_MAX_TASKS; i++) {
+		if (heap_trace_tasks[i].pid != -1) {
+			heap_trace_tasks[i].peak = heap_trace_tasks[i].live;
+			heap_trace_tasks[i].allocs = 0;
+			heap_trace_tasks[i].alloc_bytes = 0;
+		}
+	}
+
+	sched_unlock();
+}
+
+#endif /* HEAP_TRACE */
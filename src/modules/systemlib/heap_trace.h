@@ -0,0 +1,76 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file heap_trace.h
+ *
+ * Per-task heap allocation accounting.
+ *
+ * When the build enables HEAP_TRACE (cmake -DHEAP_TRACE=ON, which also
+ * routes malloc/calloc/realloc/free through the __wrap_ functions with
+ * -Wl,--wrap), every allocation carries a small header that attributes
+ * it to the calling task. The 'heapinfo' system command reports live
+ * bytes, peak and allocation counts per task, so steady-state allocators
+ * can be found and the codebase held at allocation-free cruise.
+ *
+ * The table below is exported the same way cpuload exports system_load:
+ * readers take sched_lock() around iteration.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+__BEGIN_DECLS
+
+#define HEAP_TRACE_MAX_TASKS	32
+#define HEAP_TRACE_NAME_LEN	16
+
+struct heap_trace_task_s {
+	char		name[HEAP_TRACE_NAME_LEN];	/**< task name at first allocation */
+	pid_t		pid;			/**< owning task, -1 if slot unused */
+	uint32_t	live;			/**< currently allocated bytes */
+	uint32_t	peak;			/**< high water mark of live */
+	uint32_t	allocs;			/**< total number of allocations */
+	uint32_t	alloc_bytes;		/**< total bytes ever allocated */
+};
+
+__EXPORT extern struct heap_trace_task_s heap_trace_tasks[HEAP_TRACE_MAX_TASKS];
+
+/**
+ * Reset the peak and rate counters (live byte accounting is preserved).
+ */
+__EXPORT void heap_trace_reset(void);
+
+__END_DECLS
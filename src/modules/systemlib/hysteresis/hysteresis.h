@@ -34,7 +34,7 @@
 /**
  * @file hysteresis.h
  *
- * Hysteresis of a boolean value.
+ * Hysteresis of boolean values.
  *
  * @author Julian Oes <julian@oes.ch>
  */
@@ -75,6 +75,15 @@ public:
 		return _state;
 	}
 
+	/**
+	 * True while a requested state change is waiting out its hysteresis
+	 * time, i.e. update() still needs to be called periodically.
+	 */
+	bool transition_pending() const
+	{
+		return _requested_state != _state;
+	}
+
 	void set_state_and_update(const bool new_state);
 
 	void update();
@@ -88,4 +97,124 @@ private:
 	hrt_abstime _last_time_to_change_state;
 };
 
+/**
+ * A bank of N boolean hysteresis channels evaluated in one pass.
+ *
+ * Modules debouncing several conditions per cycle (land detector states,
+ * stick gestures) keep the per-channel state in contiguous arrays here, so
+ * one update walks a few cache lines and queries the clock once instead of
+ * once per condition.
+ */
+template <unsigned N>
+class HysteresisBank
+{
+public:
+	HysteresisBank(const bool (&init_states)[N])
+	{
+		for (unsigned i = 0; i < N; i++) {
+			_state[i] = init_states[i];
+			_requested_state[i] = init_states[i];
+			_hysteresis_time_from_true_us[i] = 0;
+			_hysteresis_time_from_false_us[i] = 0;
+			_last_time_to_change_state[i] = 0;
+		}
+	}
+
+	~HysteresisBank()
+	{}
+
+	void set_hysteresis_time_from(const unsigned channel, const bool from_state,
+				      const hrt_abstime new_hysteresis_time_us)
+	{
+		if (from_state == true) {
+			_hysteresis_time_from_true_us[channel] = new_hysteresis_time_us;
+
+		} else {
+			_hysteresis_time_from_false_us[channel] = new_hysteresis_time_us;
+		}
+	}
+
+	bool get_state(const unsigned channel) const
+	{
+		return _state[channel];
+	}
+
+	/**
+	 * True while any channel waits out its hysteresis time, i.e. update()
+	 * still needs to be called periodically.
+	 */
+	bool transition_pending() const
+	{
+		for (unsigned i = 0; i < N; i++) {
+			if (_requested_state[i] != _state[i]) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * Feed all channels and update them against one clock query.
+	 */
+	void set_states_and_update(const bool (&new_states)[N])
+	{
+		const hrt_abstime now = hrt_absolute_time();
+
+		for (unsigned i = 0; i < N; i++) {
+			if (new_states[i] != _state[i]) {
+				if (new_states[i] != _requested_state[i]) {
+					_requested_state[i] = new_states[i];
+					_last_time_to_change_state[i] = now;
+				}
+
+			} else {
+				_requested_state[i] = _state[i];
+			}
+
+			update(i, now);
+		}
+	}
+
+	/**
+	 * Feed a single channel, for out-of-cycle corrections.
+	 */
+	void set_state_and_update(const unsigned channel, const bool new_state)
+	{
+		const hrt_abstime now = hrt_absolute_time();
+
+		if (new_state != _state[channel]) {
+			if (new_state != _requested_state[channel]) {
+				_requested_state[channel] = new_state;
+				_last_time_to_change_state[channel] = now;
+			}
+
+		} else {
+			_requested_state[channel] = _state[channel];
+		}
+
+		update(channel, now);
+	}
+
+private:
+
+	void update(const unsigned channel, const hrt_abstime now)
+	{
+		if (_requested_state[channel] != _state[channel]) {
+
+			if (now - _last_time_to_change_state[channel] >= (_state[channel] ?
+					_hysteresis_time_from_true_us[channel] :
+					_hysteresis_time_from_false_us[channel])) {
+				_state[channel] = _requested_state[channel];
+			}
+		}
+	}
+
+	bool _state[N];
+	bool _requested_state[N];
+	hrt_abstime _hysteresis_time_from_true_us[N];
+	hrt_abstime _hysteresis_time_from_false_us[N];
+	hrt_abstime _last_time_to_change_state[N];
+};
+
 } // namespace systemlib
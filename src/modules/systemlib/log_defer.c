@@ -0,0 +1,161 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file log_defer.c
+ *
+ * Deferred console logging, see log_defer.h.
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+#include <px4_log.h>
+#include <px4_workqueue.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "log_defer.h"
+
+/* number of messages buffered between drains; each slot is a few words */
+#define LOG_DEFER_QUEUE_SIZE	32
+
+/* how long a partially filled slot may stall the drain before retrying */
+#define LOG_DEFER_RETRY_US	1000
+
+struct log_defer_record_s {
+	const char	*fmt;
+	const char	*module_name;
+	uintptr_t	args[LOG_DEFER_MAX_ARGS];
+	uint8_t		level;
+	volatile uint8_t ready;
+};
+
+static struct log_defer_record_s log_defer_ring[LOG_DEFER_QUEUE_SIZE];
+static volatile unsigned log_defer_head;		/* next slot to claim */
+static volatile unsigned log_defer_tail;		/* next slot to drain */
+static volatile unsigned log_defer_dropped;
+
+static struct work_s log_defer_work;
+static volatile bool log_defer_work_queued;
+
+static void
+log_defer_drain(void *arg)
+{
+	log_defer_work_queued = false;
+
+	while (log_defer_tail != log_defer_head) {
+		struct log_defer_record_s *rec = &log_defer_ring[log_defer_tail % LOG_DEFER_QUEUE_SIZE];
+
+		if (!rec->ready) {
+			/* the producer claimed this slot but has not finished
+			 * filling it; come back shortly rather than spinning */
+			break;
+		}
+
+		/* the regular backend does the formatting, console write and
+		 * log_message publication; extra arguments beyond what the
+		 * format consumes are evaluated and ignored by printf */
+		px4_log_modulename(rec->level, rec->module_name, rec->fmt,
+				   rec->args[0], rec->args[1], rec->args[2], rec->args[3]);
+
+		rec->ready = false;
+		__sync_synchronize();
+		log_defer_tail++;
+	}
+
+	unsigned dropped = log_defer_dropped;
+
+	if (dropped > 0) {
+		__sync_fetch_and_sub(&log_defer_dropped, dropped);
+		printf("WARN  [log_defer] %u messages dropped (ring overflow)\n", dropped);
+	}
+
+	if (log_defer_tail != log_defer_head && !log_defer_work_queued) {
+		log_defer_work_queued = true;
+		work_queue(LPWORK, &log_defer_work, log_defer_drain, NULL, USEC2TICK(LOG_DEFER_RETRY_US));
+	}
+}
+
+void
+log_defer_enqueue(int level, const char *module_name, const char *fmt, unsigned nargs, ...)
+{
+	unsigned head;
+
+	/* claim a slot, dropping the message when the ring is full; the
+	 * compare-and-swap keeps concurrent writers (including interrupt
+	 * handlers) from sharing one */
+	do {
+		head = log_defer_head;
+
+		if (head - log_defer_tail >= LOG_DEFER_QUEUE_SIZE) {
+			__sync_fetch_and_add(&log_defer_dropped, 1);
+			return;
+		}
+	} while (!__sync_bool_compare_and_swap(&log_defer_head, head, head + 1));
+
+	struct log_defer_record_s *rec = &log_defer_ring[head % LOG_DEFER_QUEUE_SIZE];
+
+	rec->fmt = fmt;
+	rec->module_name = module_name;
+	rec->level = level;
+
+	if (nargs > LOG_DEFER_MAX_ARGS) {
+		nargs = LOG_DEFER_MAX_ARGS;
+	}
+
+	va_list ap;
+	va_start(ap, nargs);
+
+	for (unsigned i = 0; i < nargs; i++) {
+		rec->args[i] = va_arg(ap, uintptr_t);
+	}
+
+	va_end(ap);
+
+	/* publish the slot only once it is fully written */
+	__sync_synchronize();
+	rec->ready = true;
+
+	if (!log_defer_work_queued) {
+		log_defer_work_queued = true;
+		work_queue(LPWORK, &log_defer_work, log_defer_drain, NULL, 0);
+	}
+}
+
+void
+log_defer_status(void)
+{
+	printf("log_defer: %u queued, %u dropped\n",
+	       log_defer_head - log_defer_tail, log_defer_dropped);
+}
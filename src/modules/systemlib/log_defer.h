@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file log_defer.h
+ *
+ * Deferred console logging for hot paths.
+ *
+ * PX4_INFO/PX4_WARN format their message and write it to the console at
+ * the call site, which costs hundreds of microseconds inside a driver
+ * cycle. This backend instead enqueues the format string pointer and up
+ * to LOG_DEFER_MAX_ARGS word-sized arguments into a small ring; a low
+ * priority work item formats and prints them later through the regular
+ * px4_log_modulename() path, so the console output (and the log_message
+ * publication for warnings and errors) looks the same as today.
+ *
+ * A translation unit opts in by defining PX4_LOG_DEFERRED before
+ * including this header, which remaps PX4_INFO/PX4_WARN/PX4_ERR onto the
+ * deferred enqueue. Because formatting happens after the fact, deferred
+ * call sites must only pass word-sized integer or pointer arguments, and
+ * any %s argument must outlive the drain (string literals and static
+ * strings are fine, stack buffers are not). Floating point and 64 bit
+ * arguments are not supported. The enqueue itself is a handful of word
+ * stores and is safe from interrupt context; when the ring is full the
+ * message is dropped and counted rather than blocking.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <px4_log.h>
+
+__BEGIN_DECLS
+
+#define LOG_DEFER_MAX_ARGS	4
+
+/**
+ * Enqueue a message for deferred formatting.
+ *
+ * Normally used through the PX4_LOG_DEFERRED macro remapping rather than
+ * called directly. fmt and module_name must stay valid until the drain
+ * runs; nargs arguments, each a word-sized integer or pointer, follow.
+ */
+__EXPORT void	log_defer_enqueue(int level, const char *module_name, const char *fmt, unsigned nargs, ...);
+
+/**
+ * Print how many messages were dropped on ring overflow (for debugging).
+ */
+__EXPORT void	log_defer_status(void);
+
+__END_DECLS
+
+/* count the variadic arguments of a deferred call (GNU ##__VA_ARGS__,
+ * which px4_log.h relies on as well) */
+#define __log_defer_nargs_(_0, _1, _2, _3, _4, N, ...)	N
+#define __log_defer_nargs(...)	__log_defer_nargs_(0, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+
+#define __px4_log_defer(level, FMT, ...) \
+	log_defer_enqueue(level, MODULE_NAME, FMT, __log_defer_nargs(__VA_ARGS__), ##__VA_ARGS__)
+
+#ifdef PX4_LOG_DEFERRED
+
+#undef PX4_INFO
+#undef PX4_WARN
+#undef PX4_ERR
+#define PX4_INFO(FMT, ...)	__px4_log_defer(_PX4_LOG_LEVEL_ALWAYS, FMT, ##__VA_ARGS__)
+#define PX4_WARN(FMT, ...)	__px4_log_defer(_PX4_LOG_LEVEL_WARN, FMT, ##__VA_ARGS__)
+#define PX4_ERR(FMT, ...)	__px4_log_defer(_PX4_LOG_LEVEL_ERROR, FMT, ##__VA_ARGS__)
+
+#endif /* PX4_LOG_DEFERRED */
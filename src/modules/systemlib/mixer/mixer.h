@@ -183,6 +183,20 @@ public:
 	 */
 	virtual uint16_t		get_saturation_status(void) = 0;
 
+	/**
+	 * Get the scaling the last mix() applied to fit the demand into the
+	 * output range. Only meaningful for multirotor mixers; other mixer
+	 * types report the neutral values.
+	 *
+	 * @param boost			Set to the collective thrust boost applied.
+	 * @param roll_pitch_scale	Set to the scale applied to the demanded roll and pitch.
+	 */
+	virtual void			get_mix_status(float &boost, float &roll_pitch_scale)
+	{
+		boost = 0.0f;
+		roll_pitch_scale = 1.0f;
+	}
+
 	/**
 	 * Analyses the mix configuration and updates a bitmask of groups
 	 * that are required.
@@ -286,6 +300,7 @@ public:
 
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
 	virtual uint16_t		get_saturation_status(void);
+	virtual void			get_mix_status(float &boost, float &roll_pitch_scale);
 	virtual void			groups_required(uint32_t &groups);
 
 	/**
@@ -605,7 +620,18 @@ public:
 			unsigned &buflen);
 
 	virtual unsigned		mix(float *outputs, unsigned space, uint16_t *status_reg);
+
+	/**
+	 * Q16.16 fixed-point variant of mix() for targets without an FPU.
+	 *
+	 * mix() dispatches to this implementation when MIXER_USE_FIXED_POINT
+	 * is defined (the px4io build); it is always compiled so the host-side
+	 * mixer test can cross-validate it against the float path.
+	 */
+	unsigned			mix_q16(float *outputs, unsigned space, uint16_t *status_reg);
+
 	virtual uint16_t		get_saturation_status(void);
+	virtual void			get_mix_status(float &boost, float &roll_pitch_scale);
 	virtual void			groups_required(uint32_t &groups);
 
 	/**
@@ -640,11 +666,13 @@ private:
 	float 				_delta_out_max;
 	float 				_thrust_factor;
 
+	float				_boost;			/**< thrust boost applied by the last mix() */
+	float				_roll_pitch_scale;	/**< roll/pitch scale applied by the last mix() */
 
 	orb_advert_t			_limits_pub;
 	multirotor_motor_limits_s 	_limits;
 
-	union {
+	union SaturationStatus {
 		struct {
 			uint16_t motor_pos	: 1; // 0 - true when any motor has saturated in the positive direction
 			uint16_t motor_neg	: 1; // 1 - true when any motor has saturated in the negative direction
@@ -658,14 +686,40 @@ private:
 			uint16_t thrust_neg	: 1; // 9 - true when a negative thrust demand change will increase saturation
 		} flags;
 		uint16_t value;
-	} _saturation_status;
+	};
+
+	SaturationStatus _saturation_status;
 
-	void update_saturation_status(unsigned index, bool clipping_high, bool clipping_low);
+	/**
+	 * Precompute the per-rotor saturation status masks from the rotor scale signs,
+	 * so the mixing loop can update the status with a single mask OR per rotor
+	 * instead of six float sign tests (which are soft-float calls on the IO
+	 * processor).
+	 */
+	void precompute_saturation_masks();
 
 	unsigned			_rotor_count;
 	const Rotor			*_rotors;
 
 	float 				*_outputs_prev = nullptr;
+	uint16_t			*_sat_clip_high_mask = nullptr;	/**< per-rotor status mask applied when clipping at the upper limit */
+	uint16_t			*_sat_clip_low_mask = nullptr;	/**< per-rotor status mask applied when clipping at the lower limit */
+
+	/**
+	 * Rotor mix scales converted to Q16.16, precomputed for mix_q16().
+	 */
+	struct RotorQ16 {
+		int32_t	roll_scale;
+		int32_t	pitch_scale;
+		int32_t	yaw_scale;
+		int32_t	out_scale;
+	};
+
+	RotorQ16			*_rotors_q16 = nullptr;
+	int32_t				_roll_scale_q16;
+	int32_t				_pitch_scale_q16;
+	int32_t				_yaw_scale_q16;
+	int32_t				_idle_speed_q16;
 
 	/* do not allow to copy due to ptr data members */
 	MultirotorMixer(const MultirotorMixer &);
@@ -171,6 +171,29 @@ MixerGroup::get_saturation_status()
 	return sat;
 }
 
+void
+MixerGroup::get_mix_status(float &boost, float &roll_pitch_scale)
+{
+	Mixer	*mixer = _first;
+
+	boost = 0.0f;
+	roll_pitch_scale = 1.0f;
+
+	/* report the values of the (typically single) mixer that applied any scaling */
+	while (mixer != nullptr) {
+		float b;
+		float s;
+		mixer->get_mix_status(b, s);
+
+		if (b != 0.0f || s != 1.0f) {
+			boost = b;
+			roll_pitch_scale = s;
+		}
+
+		mixer = mixer->_next;
+	}
+}
+
 unsigned
 MixerGroup::count()
 {
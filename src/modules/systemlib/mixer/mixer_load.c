@@ -41,75 +41,127 @@
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <systemlib/err.h>
 
 #include "mixer_load.h"
 
+#define MIXER_LINE_MAX		120
+#define MIXER_BLOCK_SIZE	512
+
+/**
+ * Filter a single line and append it to the output buffer.
+ *
+ * @return 0 on success (including skipped lines), -1 if the buffer is full
+ */
+static int
+mixer_append_line(char *line, char *buf, unsigned *buflen, unsigned maxlen)
+{
+	/* if the line doesn't look like a mixer definition line, skip it */
+	if ((strlen(line) < 2) || !isupper(line[0]) || (line[1] != ':')) {
+		return 0;
+	}
+
+	/* compact whitespace in the buffer */
+	char *t, *f;
+
+	for (f = line; *f != '\0'; f++) {
+		/* scan for space characters */
+		if (*f == ' ') {
+			/* look for additional spaces */
+			t = f + 1;
+
+			while (*t == ' ') {
+				t++;
+			}
+
+			if (*t == '\0') {
+				/* strip trailing whitespace */
+				*f = '\0';
+
+			} else if (t > (f + 1)) {
+				memmove(f + 1, t, strlen(t) + 1);
+			}
+		}
+	}
+
+	unsigned linelen = strlen(line);
+
+	/* if the line is too long to fit in the buffer, bail */
+	if ((linelen + *buflen + 1) >= maxlen) {
+		warnx("line too long");
+		return -1;
+	}
+
+	/* add the line to the buffer */
+	memcpy(buf + *buflen, line, linelen + 1);
+	*buflen += linelen;
+
+	return 0;
+}
+
 int load_mixer_file(const char *fname, char *buf, unsigned maxlen)
 {
-	FILE		*fp;
-	char		line[120];
+	char		block[MIXER_BLOCK_SIZE];
+	char		line[MIXER_LINE_MAX];
+	unsigned	linelen = 0;
+	unsigned	buflen = 0;
 
 	/* open the mixer definition file */
-	fp = fopen(fname, "r");
+	int fd = open(fname, O_RDONLY);
 
-	if (fp == NULL) {
+	if (fd < 0) {
 		warnx("file not found");
 		return -1;
 	}
 
-	/* read valid lines from the file into a buffer */
+	/*
+	 * Read the file in blocks and filter it line-wise into the output
+	 * buffer. This turns hundreds of per-line reads from the (slow) ROMFS
+	 * character device into a few block-sized ones, and appends in linear
+	 * time instead of rescanning the buffer with strcat().
+	 */
 	buf[0] = '\0';
 
 	for (;;) {
+		ssize_t nread = read(fd, block, sizeof(block));
 
-		/* get a line, bail on error/EOF */
-		line[0] = '\0';
-
-		if (fgets(line, sizeof(line), fp) == NULL) {
+		if (nread <= 0) {
 			break;
 		}
 
-		/* if the line doesn't look like a mixer definition line, skip it */
-		if ((strlen(line) < 2) || !isupper(line[0]) || (line[1] != ':')) {
-			continue;
-		}
-
-		/* compact whitespace in the buffer */
-		char *t, *f;
-
-		for (f = line; *f != '\0'; f++) {
-			/* scan for space characters */
-			if (*f == ' ') {
-				/* look for additional spaces */
-				t = f + 1;
+		for (ssize_t i = 0; i < nread; i++) {
+			/* accumulate a line, dropping characters that cannot fit */
+			if (linelen < sizeof(line) - 1) {
+				line[linelen++] = block[i];
+			}
 
-				while (*t == ' ') {
-					t++;
-				}
+			if (block[i] != '\n') {
+				continue;
+			}
 
-				if (*t == '\0') {
-					/* strip trailing whitespace */
-					*f = '\0';
+			line[linelen] = '\0';
+			linelen = 0;
 
-				} else if (t > (f + 1)) {
-					memmove(f + 1, t, strlen(t) + 1);
-				}
+			if (mixer_append_line(line, buf, &buflen, maxlen) < 0) {
+				close(fd);
+				return -1;
 			}
 		}
+	}
 
-		/* if the line is too long to fit in the buffer, bail */
-		if ((strlen(line) + strlen(buf) + 1) >= maxlen) {
-			warnx("line too long");
-			fclose(fp);
+	/* handle a last line lacking the terminating newline */
+	if (linelen > 0) {
+		line[linelen] = '\0';
+
+		if (mixer_append_line(line, buf, &buflen, maxlen) < 0) {
+			close(fd);
 			return -1;
 		}
-
-		/* add the line to the buffer */
-		strcat(buf, line);
 	}
 
-	fclose(fp);
+	close(fd);
 	return 0;
 }
 
@@ -55,6 +55,7 @@
 #include <drivers/drv_pwm_output.h>
 
 #include "mixer.h"
+#include "mixer_q16.h"
 
 // This file is generated by the multi_tables script which is invoked during the build process
 #include "mixer_multirotor.generated.h"
@@ -83,12 +84,33 @@ MultirotorMixer::MultirotorMixer(ControlCallback control_cb,
 	_idle_speed(-1.0f + idle_speed * 2.0f),	/* shift to output range here to avoid runtime calculation */
 	_delta_out_max(0.0f),
 	_thrust_factor(0.0f),
+	_boost(0.0f),
+	_roll_pitch_scale(1.0f),
 	_limits_pub(),
 	_rotor_count(_config_rotor_count[(MultirotorGeometryUnderlyingType)geometry]),
 	_rotors(_config_index[(MultirotorGeometryUnderlyingType)geometry]),
 	_outputs_prev(new float[_rotor_count])
 {
 	memset(_outputs_prev, _idle_speed, _rotor_count * sizeof(float));
+
+	_sat_clip_high_mask = new uint16_t[_rotor_count];
+	_sat_clip_low_mask = new uint16_t[_rotor_count];
+	precompute_saturation_masks();
+
+	/* precompute the Q16.16 mirror of the rotor scales for mix_q16() */
+	_rotors_q16 = new RotorQ16[_rotor_count];
+
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		_rotors_q16[i].roll_scale = q16_from_float(_rotors[i].roll_scale);
+		_rotors_q16[i].pitch_scale = q16_from_float(_rotors[i].pitch_scale);
+		_rotors_q16[i].yaw_scale = q16_from_float(_rotors[i].yaw_scale);
+		_rotors_q16[i].out_scale = q16_from_float(_rotors[i].out_scale);
+	}
+
+	_roll_scale_q16 = q16_from_float(_roll_scale);
+	_pitch_scale_q16 = q16_from_float(_pitch_scale);
+	_yaw_scale_q16 = q16_from_float(_yaw_scale);
+	_idle_speed_q16 = q16_from_float(_idle_speed);
 }
 
 MultirotorMixer::~MultirotorMixer()
@@ -96,6 +118,10 @@ MultirotorMixer::~MultirotorMixer()
 	if (_outputs_prev != nullptr) {
 		delete[] _outputs_prev;
 	}
+
+	delete[] _sat_clip_high_mask;
+	delete[] _sat_clip_low_mask;
+	delete[] _rotors_q16;
 }
 
 MultirotorMixer *
@@ -208,9 +234,13 @@ MultirotorMixer::from_text(Mixer::ControlCallback control_cb, uintptr_t cb_handl
 		       s[3] / 10000.0f);
 }
 
-unsigned
+PX4_HOT_RAMFUNC unsigned
 MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 {
+#ifdef MIXER_USE_FIXED_POINT
+	/* no FPU on this target: run the Q16.16 specialization */
+	return mix_q16(outputs, space, status_reg);
+#else
 	/* Summary of mixing strategy:
 	1) mix roll, pitch and thrust without yaw.
 	2) if some outputs violate range [0,1] then try to shift all outputs to minimize violation ->
@@ -245,13 +275,8 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 		out *= _rotors[i].out_scale;
 
 		/* calculate min and max output values */
-		if (out < min_out) {
-			min_out = out;
-		}
-
-		if (out > max_out) {
-			max_out = out;
-		}
+		min_out = fminf(min_out, out);
+		max_out = fmaxf(max_out, out);
 
 		outputs[i] = out;
 	}
@@ -297,6 +322,10 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 		roll_pitch_scale = (thrust + boost) / (thrust - min_out);
 	}
 
+	// capture the applied scaling for status reporting
+	_boost = boost;
+	_roll_pitch_scale = roll_pitch_scale;
+
 	// capture saturation
 	if (min_out < 0.0f) {
 		_saturation_status.flags.motor_neg = true;
@@ -402,9 +431,14 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 
 		_outputs_prev[i] = outputs[i];
 
-		// update the saturation status report
-		update_saturation_status(i, clipping_high, clipping_low);
+		// update the saturation status report using the precomputed per-rotor masks
+		if (clipping_high) {
+			_saturation_status.value |= _sat_clip_high_mask[i];
+		}
 
+		if (clipping_low) {
+			_saturation_status.value |= _sat_clip_low_mask[i];
+		}
 	}
 
 	// this will force the caller of the mixer to always supply new slew rate values, otherwise no slew rate limiting will happen
@@ -416,97 +450,289 @@ MultirotorMixer::mix(float *outputs, unsigned space, uint16_t *status_reg)
 	}
 
 	return _rotor_count;
+#endif /* MIXER_USE_FIXED_POINT */
 }
 
 /*
- * This function update the control saturation status report using hte following inputs:
- *
- * index: 0 based index identifying the motor that is saturating
- * clipping_high: true if the motor demand is being limited in the positive direction
- * clipping_low: true if the motor demand is being limited in the negative direction
-*/
-void
-MultirotorMixer::update_saturation_status(unsigned index, bool clipping_high, bool clipping_low)
+ * Q16.16 mirror of the float implementation above, stage by stage. Only the
+ * optional static thrust model keeps float math: it needs a square root and
+ * is not enabled on the IO processor. The host mixer test cross-validates
+ * this path against the float one.
+ */
+unsigned
+MultirotorMixer::mix_q16(float *outputs, unsigned space, uint16_t *status_reg)
 {
-	// The motor is saturated at the upper limit
-	// check which control axes and which directions are contributing
-	if (clipping_high) {
-		if (_rotors[index].roll_scale > 0.0f) {
-			// A positive change in roll will increase saturation
-			_saturation_status.flags.roll_pos = true;
+	const float roll_in   = get_control(0, 0);
+	const float pitch_in  = get_control(0, 1);
+	const float yaw_in    = get_control(0, 2);
+	const float thrust_in = get_control(0, 3);
+
+	// clean out class variable used to capture saturation
+	_saturation_status.value = 0;
+
+	/* q16 cannot represent NaN: hand faulted inputs straight through so the
+	 * output stage still sees non-finite values and engages the failsafe */
+	if (!isfinite(roll_in + pitch_in + yaw_in + thrust_in)) {
+		for (unsigned i = 0; i < _rotor_count; i++) {
+			outputs[i] = NAN;
+			_outputs_prev[i] = outputs[i];
+		}
+
+		_delta_out_max = 0.0f;
+
+		if (status_reg != nullptr) {
+			(*status_reg) = _saturation_status.value;
+		}
+
+		return _rotor_count;
+	}
+
+	q16_t		roll    = q16_constrain(q16_mul(q16_from_float(roll_in), _roll_scale_q16), -Q16_ONE, Q16_ONE);
+	q16_t		pitch   = q16_constrain(q16_mul(q16_from_float(pitch_in), _pitch_scale_q16), -Q16_ONE, Q16_ONE);
+	q16_t		yaw     = q16_constrain(q16_mul(q16_from_float(yaw_in), _yaw_scale_q16), -Q16_ONE, Q16_ONE);
+	q16_t		thrust  = q16_constrain(q16_from_float(thrust_in), 0, Q16_ONE);
+	q16_t		min_out = Q16_ONE;
+	q16_t		max_out = 0;
+
+	/* perform initial mix pass yielding unbounded outputs, ignore yaw */
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		q16_t out = q16_mul(roll, _rotors_q16[i].roll_scale) +
+			    q16_mul(pitch, _rotors_q16[i].pitch_scale) +
+			    thrust;
+
+		out = q16_mul(out, _rotors_q16[i].out_scale);
+
+		/* calculate min and max output values */
+		min_out = q16_min(min_out, out);
+		max_out = q16_max(max_out, out);
+	}
+
+	q16_t boost = 0;			// value added to demanded thrust (can also be negative)
+	q16_t roll_pitch_scale = Q16_ONE;	// scale for demanded roll and pitch
+
+	/* thrust boost margins, (1.5 - 1) * thrust and (1 - 0.6) * thrust */
+	const q16_t thrust_increase_diff = thrust / 2;
+	const q16_t thrust_decrease_diff = q16_mul(thrust, q16_from_float(0.4f));
+
+	if (min_out < 0 && max_out < Q16_ONE && -min_out <= Q16_ONE - max_out) {
+		if (thrust_increase_diff >= -min_out) {
+			boost = -min_out;
+
+		} else {
+			boost = thrust_increase_diff;
+			roll_pitch_scale = q16_div(thrust + boost, thrust - min_out);
+		}
 
-		} else if (_rotors[index].roll_scale < 0.0f) {
-			// A negative change in roll will increase saturation
-			_saturation_status.flags.roll_neg = true;
+	} else if (max_out > Q16_ONE && min_out > 0 && min_out >= max_out - Q16_ONE) {
+		if (thrust_decrease_diff >= max_out - Q16_ONE) {
+			boost = -(max_out - Q16_ONE);
 
+		} else {
+			boost = -thrust_decrease_diff;
+			roll_pitch_scale = q16_div(Q16_ONE - (thrust + boost), max_out - thrust);
 		}
 
-		// check if the pitch input is saturating
-		if (_rotors[index].pitch_scale > 0.0f) {
-			// A positive change in pitch will increase saturation
-			_saturation_status.flags.pitch_pos = true;
+	} else if (min_out < 0 && max_out < Q16_ONE && -min_out > Q16_ONE - max_out) {
+		boost = q16_constrain(-min_out - (Q16_ONE - max_out) / 2, 0, thrust_increase_diff);
+		roll_pitch_scale = q16_div(thrust + boost, thrust - min_out);
+
+	} else if (max_out > Q16_ONE && min_out > 0 && min_out < max_out - Q16_ONE) {
+		boost = q16_constrain(-(max_out - Q16_ONE - min_out) / 2, -thrust_decrease_diff, 0);
+		roll_pitch_scale = q16_div(Q16_ONE - (thrust + boost), max_out - thrust);
+
+	} else if (min_out < 0 && max_out > Q16_ONE) {
+		boost = q16_constrain(-(max_out - Q16_ONE + min_out) / 2, -thrust_decrease_diff, thrust_increase_diff);
+		roll_pitch_scale = q16_div(thrust + boost, thrust - min_out);
+	}
+
+	// capture the applied scaling for status reporting
+	_boost = q16_to_float(boost);
+	_roll_pitch_scale = q16_to_float(roll_pitch_scale);
+
+	// capture saturation
+	if (min_out < 0) {
+		_saturation_status.flags.motor_neg = true;
+	}
+
+	if (max_out > Q16_ONE) {
+		_saturation_status.flags.motor_pos = true;
+	}
+
+	// Thrust reduction is used to reduce the collective thrust if we hit
+	// the upper throttle limit
+	q16_t thrust_reduction = 0;
+
+	// mix again but now with thrust boost, scale roll/pitch and also add yaw
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		q16_t rp = q16_mul(q16_mul(roll, _rotors_q16[i].roll_scale) +
+				   q16_mul(pitch, _rotors_q16[i].pitch_scale), roll_pitch_scale);
+
+		q16_t out = q16_mul(rp + q16_mul(yaw, _rotors_q16[i].yaw_scale) +
+				    thrust + boost, _rotors_q16[i].out_scale);
+
+		// scale yaw if it violates limits. inform about yaw limit reached
+		if (out < 0) {
+			if (_rotors_q16[i].yaw_scale == 0) {
+				yaw = 0;
+
+			} else {
+				yaw = q16_div(-(rp + thrust + boost), _rotors_q16[i].yaw_scale);
+			}
 
-		} else if (_rotors[index].pitch_scale < 0.0f) {
-			// A negative change in pitch will increase saturation
-			_saturation_status.flags.pitch_neg = true;
+		} else if (out > Q16_ONE) {
+			// allow to reduce thrust to get some yaw response
+			q16_t prop_reduction = q16_min(q16_from_float(0.15f), out - Q16_ONE);
+			// keep the maximum requested reduction
+			thrust_reduction = q16_max(thrust_reduction, prop_reduction);
 
+			if (_rotors_q16[i].yaw_scale == 0) {
+				yaw = 0;
+
+			} else {
+				yaw = q16_div(Q16_ONE - (rp + (thrust - thrust_reduction) + boost),
+					      _rotors_q16[i].yaw_scale);
+			}
 		}
+	}
+
+	// Apply collective thrust reduction, the maximum for one prop
+	thrust -= thrust_reduction;
 
-		// check if the yaw input is saturating
-		if (_rotors[index].yaw_scale > 0.0f) {
-			// A positive change in yaw will increase saturation
-			_saturation_status.flags.yaw_pos = true;
+	const q16_t idle_speed = _idle_speed_q16;
 
-		} else if (_rotors[index].yaw_scale < 0.0f) {
-			// A negative change in yaw will increase saturation
-			_saturation_status.flags.yaw_neg = true;
+	// add yaw and scale outputs to range idle_speed...1
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		q16_t out = q16_mul(q16_mul(roll, _rotors_q16[i].roll_scale) +
+				    q16_mul(pitch, _rotors_q16[i].pitch_scale), roll_pitch_scale) +
+			    q16_mul(yaw, _rotors_q16[i].yaw_scale) +
+			    thrust + boost;
 
+		if (_thrust_factor > 0.0f) {
+			/* the static thrust model needs a square root, keep it in float */
+			float out_f = q16_to_float(out);
+			out_f = -(1.0f - _thrust_factor) / (2.0f * _thrust_factor) + sqrtf((1.0f - _thrust_factor) *
+					(1.0f - _thrust_factor) / (4.0f * _thrust_factor * _thrust_factor) + (out_f < 0.0f ? 0.0f : out_f /
+							_thrust_factor));
+			out = q16_from_float(out_f);
 		}
 
-		// A positive change in thrust will increase saturation
-		_saturation_status.flags.thrust_pos = true;
+		out = q16_constrain(idle_speed + q16_mul(out, Q16_ONE - idle_speed), idle_speed, Q16_ONE);
 
+		/* outputs are within [-1, 1] here, which a float represents exactly
+		 * at q16 resolution, so converting back and forth is lossless */
+		outputs[i] = q16_to_float(out);
 	}
 
-	// The motor is saturated at the lower limit
-	// check which control axes and which directions are contributing
-	if (clipping_low) {
-		// check if the roll input is saturating
-		if (_rotors[index].roll_scale > 0.0f) {
-			// A negative change in roll will increase saturation
-			_saturation_status.flags.roll_neg = true;
+	const q16_t delta_out_max = q16_from_float(_delta_out_max);
+
+	/* slew rate limiting and saturation checking */
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		bool clipping_high = false;
+		bool clipping_low = false;
+
+		q16_t out = q16_from_float(outputs[i]);
+
+		// check for saturation against static limits
+		if (out > q16_from_float(0.99f)) {
+			clipping_high = true;
+
+		} else if (out < idle_speed + q16_from_float(0.01f)) {
+			clipping_low = true;
+
+		}
+
+		// check for saturation against slew rate limits
+		if (delta_out_max > 0) {
+			q16_t prev = q16_from_float(_outputs_prev[i]);
+			q16_t delta_out = out - prev;
+
+			if (delta_out > delta_out_max) {
+				out = prev + delta_out_max;
+				clipping_high = true;
+
+			} else if (delta_out < -delta_out_max) {
+				out = prev - delta_out_max;
+				clipping_low = true;
+
+			}
+
+			outputs[i] = q16_to_float(out);
+		}
+
+		_outputs_prev[i] = outputs[i];
 
-		} else if (_rotors[index].roll_scale < 0.0f) {
-			// A positive change in roll will increase saturation
-			_saturation_status.flags.roll_pos = true;
+		// update the saturation status report using the precomputed per-rotor masks
+		if (clipping_high) {
+			_saturation_status.value |= _sat_clip_high_mask[i];
+		}
 
+		if (clipping_low) {
+			_saturation_status.value |= _sat_clip_low_mask[i];
 		}
+	}
+
+	// this will force the caller of the mixer to always supply new slew rate values, otherwise no slew rate limiting will happen
+	_delta_out_max = 0.0f;
 
-		// check if the pitch input is saturating
-		if (_rotors[index].pitch_scale > 0.0f) {
-			// A negative change in pitch will increase saturation
-			_saturation_status.flags.pitch_neg = true;
+	// Notify saturation status
+	if (status_reg != nullptr) {
+		(*status_reg) = _saturation_status.value;
+	}
 
-		} else if (_rotors[index].pitch_scale < 0.0f) {
-			// A positive change in pitch will increase saturation
-			_saturation_status.flags.pitch_pos = true;
+	return _rotor_count;
+}
 
+/*
+ * Precompute, for every rotor, which saturation status bits have to be set when
+ * that rotor clips at the upper or the lower limit. The rotor scales are fixed
+ * per geometry, so the per-axis sign checks only have to run once at
+ * construction instead of for every rotor on every mix() cycle.
+ */
+void
+MultirotorMixer::precompute_saturation_masks()
+{
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		SaturationStatus high;
+		SaturationStatus low;
+		high.value = 0;
+		low.value = 0;
+
+		// check which control axes and which directions contribute when clipping
+		if (_rotors[i].roll_scale > 0.0f) {
+			// A positive change in roll will increase upper limit saturation
+			high.flags.roll_pos = true;
+			low.flags.roll_neg = true;
+
+		} else if (_rotors[i].roll_scale < 0.0f) {
+			// A negative change in roll will increase upper limit saturation
+			high.flags.roll_neg = true;
+			low.flags.roll_pos = true;
 		}
 
-		// check if the yaw input is saturating
-		if (_rotors[index].yaw_scale > 0.0f) {
-			// A negative change in yaw will increase saturation
-			_saturation_status.flags.yaw_neg = true;
+		if (_rotors[i].pitch_scale > 0.0f) {
+			high.flags.pitch_pos = true;
+			low.flags.pitch_neg = true;
+
+		} else if (_rotors[i].pitch_scale < 0.0f) {
+			high.flags.pitch_neg = true;
+			low.flags.pitch_pos = true;
+		}
 
-		} else if (_rotors[index].yaw_scale < 0.0f) {
-			// A positive change in yaw will increase saturation
-			_saturation_status.flags.yaw_pos = true;
+		if (_rotors[i].yaw_scale > 0.0f) {
+			high.flags.yaw_pos = true;
+			low.flags.yaw_neg = true;
 
+		} else if (_rotors[i].yaw_scale < 0.0f) {
+			high.flags.yaw_neg = true;
+			low.flags.yaw_pos = true;
 		}
 
-		// A negative change in thrust will increase saturation
-		_saturation_status.flags.thrust_neg = true;
+		// a thrust change towards the violated limit always increases saturation
+		high.flags.thrust_pos = true;
+		low.flags.thrust_neg = true;
 
+		_sat_clip_high_mask[i] = high.value;
+		_sat_clip_low_mask[i] = low.value;
 	}
 }
 
@@ -521,3 +747,9 @@ uint16_t MultirotorMixer::get_saturation_status()
 {
 	return _saturation_status.value;
 }
+
+void MultirotorMixer::get_mix_status(float &boost, float &roll_pitch_scale)
+{
+	boost = _boost;
+	roll_pitch_scale = _roll_pitch_scale;
+}
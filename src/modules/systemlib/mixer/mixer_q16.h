@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mixer_q16.h
+ *
+ * Q16.16 fixed-point helpers for the output math fast path on targets
+ * without an FPU (px4io, selected via MIXER_USE_FIXED_POINT). The control
+ * range [-1, 1] maps to [-Q16_ONE, Q16_ONE], which leaves plenty of
+ * headroom in 32 bit for the unbounded intermediate mixer outputs.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef int32_t q16_t;
+
+#define Q16_ONE		(1 << 16)
+
+static inline q16_t q16_from_float(float f)
+{
+	return (q16_t)(f * (float)Q16_ONE);
+}
+
+static inline float q16_to_float(q16_t q)
+{
+	return (float)q / (float)Q16_ONE;
+}
+
+static inline q16_t q16_mul(q16_t a, q16_t b)
+{
+	return (q16_t)(((int64_t)a * b) >> 16);
+}
+
+static inline q16_t q16_div(q16_t a, q16_t b)
+{
+	return (q16_t)(((int64_t)a << 16) / b);
+}
+
+static inline q16_t q16_constrain(q16_t val, q16_t min_val, q16_t max_val)
+{
+	return (val < min_val) ? min_val : ((val > max_val) ? max_val : val);
+}
+
+static inline q16_t q16_min(q16_t a, q16_t b)
+{
+	return (a < b) ? a : b;
+}
+
+static inline q16_t q16_max(q16_t a, q16_t b)
+{
+	return (a > b) ? a : b;
+}
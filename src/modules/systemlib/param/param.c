@@ -62,7 +62,6 @@
 #include <drivers/drv_hrt.h>
 
 #include "systemlib/param/param.h"
-#include "systemlib/uthash/utarray.h"
 #include "systemlib/bson/tinybson.h"
 
 //#define PARAM_NO_ORB ///< if defined, avoid uorb dependency. This disables publication of parameter_update on param change
@@ -75,6 +74,21 @@
 
 #if !defined(FLASH_BASED_PARAMS)
 #  define FLASH_PARAMS_EXPOSE
+
+/**
+ * Storage for modified parameters, kept sorted by handle.
+ *
+ * Values, handles and unsaved markers live in three packed arrays instead
+ * of an array of padded structs, and the arrays grow in fixed steps
+ * instead of doubling, which bounds the allocation slack.
+ */
+struct param_store_s {
+	union param_value_u	*vals;		/**< packed modified values, sorted by handle */
+	param_t			*ids;		/**< modified handles, ascending */
+	uint8_t			*unsaved;	/**< not-yet-saved markers, one bit per entry */
+	unsigned		count;		/**< number of modified parameters */
+	unsigned		size;		/**< allocated entries */
+};
 #else
 #  include "systemlib/flashparams/flashparams.h"
 #endif
@@ -83,6 +97,9 @@
 #include <crc32.h>
 
 static const char *param_default_file = PX4_ROOTFSDIR"/eeprom/parameters";
+
+/** compact the parameter journal into the main file when it grows beyond this */
+#define PARAM_JOURNAL_MAX_SIZE 4096
 static char *param_user_file = NULL;
 
 #if 0
@@ -114,15 +131,6 @@ static bool autosave_disabled = false;
 static const struct param_info_s *param_info_base = (const struct param_info_s *) &px4_parameters;
 #define	param_info_count px4_parameters.param_count
 
-/**
- * Storage for modified parameters.
- */
-struct param_wbuf_s {
-	union param_value_u	val;
-	param_t			param;
-	bool			unsaved;
-};
-
 
 uint8_t  *param_changed_storage = NULL;
 int size_param_changed_storage_bytes = 0;
@@ -149,11 +157,11 @@ get_param_info_count(void)
 	return param_info_count;
 }
 
-/** flexible array holding modified parameter values */
-FLASH_PARAMS_EXPOSE UT_array        *param_values;
+/** packed storage holding the modified parameter values */
+FLASH_PARAMS_EXPOSE struct param_store_s param_store;
 
-/** array info for the modified parameters array */
-FLASH_PARAMS_EXPOSE const UT_icd    param_icd = {sizeof(struct param_wbuf_s), NULL, NULL, NULL};
+/** the store arrays grow in steps of this many entries */
+#define PARAM_STORE_STEP 16
 
 #if !defined(PARAM_NO_ORB)
 /** parameter update topic handle */
@@ -163,11 +171,12 @@ static orb_advert_t param_topic = NULL;
 static void param_set_used_internal(param_t param);
 
 static param_t param_find_internal(const char *name, bool notification);
+static int param_import_internal(int fd, bool mark_saved);
 
 // the following implements an RW-lock using 2 semaphores (used as mutexes). It gives
 // priority to readers, meaning a writer could suffer from starvation, but in our use-case
 // we only have short periods of reads and writes are rare.
-static px4_sem_t param_sem; ///< this protects against concurrent access to param_values and param save
+static px4_sem_t param_sem; ///< this protects against concurrent access to param_store and param save
 static int reader_lock_holders = 0;
 static px4_sem_t reader_lock_holders_lock; ///< this protects against concurrent access to reader_lock_holders
 
@@ -245,57 +254,173 @@ handle_in_range(param_t param)
 }
 
 /**
- * Compare two modifid parameter structures to determine ordering.
+ * Find the position of a parameter in the sorted handle array.
  *
- * This function is suitable for passing to qsort or bsearch.
+ * @param param			The parameter being searched.
+ * @return			The position of the first entry not below
+ *				param (the insert position if it is missing).
  */
-static int
-param_compare_values(const void *a, const void *b)
+static unsigned
+param_store_lower_bound(param_t param)
 {
-	struct param_wbuf_s *pa = (struct param_wbuf_s *)a;
-	struct param_wbuf_s *pb = (struct param_wbuf_s *)b;
+	unsigned low = 0;
+	unsigned high = param_store.count;
 
-	if (pa->param < pb->param) {
-		return -1;
-	}
+	while (low < high) {
+		unsigned mid = (low + high) / 2;
 
-	if (pa->param > pb->param) {
-		return 1;
+		if (param_store.ids[mid] < param) {
+			low = mid + 1;
+
+		} else {
+			high = mid;
+		}
 	}
 
-	return 0;
+	return low;
 }
 
 /**
- * Locate the modified parameter structure for a parameter, if it exists.
+ * Locate the modified value of a parameter, if it exists.
  *
  * @param param			The parameter being searched.
- * @return			The structure holding the modified value, or
- *				NULL if the parameter has not been modified.
+ * @return			The index into the store, or -1 if the
+ *				parameter has not been modified.
  */
-static struct param_wbuf_s *
+static int
 param_find_changed(param_t param)
 {
-	struct param_wbuf_s	*s = NULL;
+	param_assert_locked();
+
+	unsigned pos = param_store_lower_bound(param);
+
+	if (pos < param_store.count && param_store.ids[pos] == param) {
+		return (int)pos;
+	}
+
+	return -1;
+}
+
+/** read the unsaved marker of a store entry */
+static bool
+param_store_unsaved(unsigned index)
+{
+	return param_store.unsaved[index / 8] & (1 << (index % 8));
+}
+
+/** set or clear the unsaved marker of a store entry */
+static void
+param_store_set_unsaved(unsigned index, bool unsaved)
+{
+	if (unsaved) {
+		param_store.unsaved[index / 8] |= 1 << (index % 8);
+
+	} else {
+		param_store.unsaved[index / 8] &= ~(1 << (index % 8));
+	}
+}
 
+/**
+ * Insert a parameter into the store, keeping the handle array sorted.
+ *
+ * The new entry has a zeroed value and a cleared unsaved marker.
+ *
+ * @param param			The parameter to insert.
+ * @return			The index of the (possibly preexisting)
+ *				entry, or -1 on allocation failure.
+ */
+static int
+param_store_insert(param_t param)
+{
+	param_assert_locked();
+
+	unsigned pos = param_store_lower_bound(param);
+
+	if (pos < param_store.count && param_store.ids[pos] == param) {
+		return (int)pos;
+	}
+
+	if (param_store.count == param_store.size) {
+		unsigned new_size = param_store.size + PARAM_STORE_STEP;
+
+		union param_value_u *vals = realloc(param_store.vals, new_size * sizeof(*vals));
+		param_t *ids = realloc(param_store.ids, new_size * sizeof(*ids));
+		uint8_t *unsaved = realloc(param_store.unsaved, (new_size + 7) / 8);
+
+		/* on failure the successful reallocations are still usable */
+		if (vals != NULL) {
+			param_store.vals = vals;
+		}
+
+		if (ids != NULL) {
+			param_store.ids = ids;
+		}
+
+		if (unsaved != NULL) {
+			param_store.unsaved = unsaved;
+		}
+
+		if (vals == NULL || ids == NULL || unsaved == NULL) {
+			return -1;
+		}
+
+		param_store.size = new_size;
+	}
+
+	memmove(&param_store.vals[pos + 1], &param_store.vals[pos],
+		(param_store.count - pos) * sizeof(param_store.vals[0]));
+	memmove(&param_store.ids[pos + 1], &param_store.ids[pos],
+		(param_store.count - pos) * sizeof(param_store.ids[0]));
+
+	param_store.count++;
+
+	for (unsigned i = param_store.count - 1; i > pos; i--) {
+		param_store_set_unsaved(i, param_store_unsaved(i - 1));
+	}
+
+	param_store.ids[pos] = param;
+	param_store.vals[pos].p = NULL;
+	param_store_set_unsaved(pos, false);
+
+	return (int)pos;
+}
+
+/** remove an entry from the store */
+static void
+param_store_erase(unsigned index)
+{
 	param_assert_locked();
 
-	if (param_values != NULL) {
-		struct param_wbuf_s key;
-		key.param = param;
-		s = utarray_find(param_values, &key, param_compare_values);
+	memmove(&param_store.vals[index], &param_store.vals[index + 1],
+		(param_store.count - index - 1) * sizeof(param_store.vals[0]));
+	memmove(&param_store.ids[index], &param_store.ids[index + 1],
+		(param_store.count - index - 1) * sizeof(param_store.ids[0]));
+
+	for (unsigned i = index; i + 1 < param_store.count; i++) {
+		param_store_set_unsaved(i, param_store_unsaved(i + 1));
 	}
 
-	return s;
+	param_store.count--;
+}
+
+/** free all store memory */
+static void
+param_store_free(void)
+{
+	free(param_store.vals);
+	free(param_store.ids);
+	free(param_store.unsaved);
+	memset(&param_store, 0, sizeof(param_store));
 }
 
 static void
-_param_notify_changes(void)
+_param_notify_changes(param_t param)
 {
 #if !defined(PARAM_NO_ORB)
 	struct parameter_update_s pup = {
 		.timestamp = hrt_absolute_time(),
-		.dummy = 0
+		.dummy = 0,
+		.changed_param = (param == PARAM_INVALID) ? UINT32_MAX : (uint32_t)param
 	};
 
 	/*
@@ -315,38 +440,30 @@ _param_notify_changes(void)
 void
 param_notify_changes(void)
 {
-	_param_notify_changes();
+	_param_notify_changes(PARAM_INVALID);
 }
 
 param_t
 param_find_internal(const char *name, bool notification)
 {
-	param_t middle;
-	param_t front = 0;
-	param_t last = get_param_info_count();
+	/* constant-time probe of the hash index generated by px_generate_params.py */
+	uint32_t hash = 2166136261u;
 
-	/* perform a binary search of the known parameters */
+	for (const char *c = name; *c; c++) {
+		hash = (hash ^ (uint8_t)*c) * 16777619u;
+	}
 
-	while (front <= last) {
-		middle = front + (last - front) / 2;
-		int ret = strcmp(name, param_info_base[middle].name);
+	for (unsigned slot = hash & (PX4_PARAM_HASH_SIZE - 1);
+	     px4_parameter_hash_table[slot] != 0xffff;
+	     slot = (slot + 1) & (PX4_PARAM_HASH_SIZE - 1)) {
+		param_t param = px4_parameter_hash_table[slot];
 
-		if (ret == 0) {
+		if (strcmp(name, param_info_base[param].name) == 0) {
 			if (notification) {
-				param_set_used_internal(middle);
+				param_set_used_internal(param);
 			}
 
-			return middle;
-
-		} else if (middle == front) {
-			/* An end point has been hit, but there has been no match */
-			break;
-
-		} else if (ret < 0) {
-			last = middle;
-
-		} else {
-			front = middle;
+			return param;
 		}
 	}
 
@@ -479,20 +596,18 @@ param_name(param_t param)
 bool
 param_value_is_default(param_t param)
 {
-	struct param_wbuf_s *s;
 	param_lock_reader();
-	s = param_find_changed(param);
+	int idx = param_find_changed(param);
 	param_unlock_reader();
-	return s ? false : true;
+	return idx < 0;
 }
 
 bool
 param_value_unsaved(param_t param)
 {
-	struct param_wbuf_s *s;
 	param_lock_reader();
-	s = param_find_changed(param);
-	bool ret = s && s->unsaved;
+	int idx = param_find_changed(param);
+	bool ret = idx >= 0 && param_store_unsaved(idx);
 	param_unlock_reader();
 	return ret;
 }
@@ -545,10 +660,10 @@ param_get_value_ptr(param_t param)
 		const union param_value_u *v;
 
 		/* work out whether we're fetching the default or a written value */
-		struct param_wbuf_s *s = param_find_changed(param);
+		int idx = param_find_changed(param);
 
-		if (s != NULL) {
-			v = &s->val;
+		if (idx >= 0) {
+			v = &param_store.vals[idx];
 
 		} else {
 			v = &param_info_base[param].val;
@@ -586,6 +701,34 @@ param_get(param_t param, void *val)
 	return result;
 }
 
+int
+param_get_if_changed(param_t param, uint32_t changed_param, void *val)
+{
+	if (changed_param != UINT32_MAX && changed_param != (uint32_t)param) {
+		/* the notification names a different parameter, keep the cached value */
+		return 1;
+	}
+
+	return param_get(param, val);
+}
+
+bool
+param_in_set(uint32_t changed_param, const param_t *set, unsigned count)
+{
+	if (changed_param == UINT32_MAX) {
+		/* not attributable to a single parameter, assume the set is affected */
+		return true;
+	}
+
+	for (unsigned i = 0; i < count; i++) {
+		if ((uint32_t)set[i] == changed_param) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 
 #ifndef PARAM_NO_AUTOSAVE
 /**
@@ -674,68 +817,56 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 
 	param_lock_writer();
 
-	if (param_values == NULL) {
-		utarray_new(param_values, &param_icd);
-	}
-
-	if (param_values == NULL) {
-		debug("failed to allocate modified values array");
-		goto out;
-	}
-
 	if (handle_in_range(param)) {
 
-		struct param_wbuf_s *s = param_find_changed(param);
+		int idx = param_find_changed(param);
 
-		if (s == NULL) {
+		if (idx < 0) {
 
-			/* construct a new parameter */
-			struct param_wbuf_s buf = {
-				.param = param,
-				.val.p = NULL,
-				.unsaved = false
-			};
-			params_changed = true;
+			/* insert a new, zeroed entry in sorted position */
+			idx = param_store_insert(param);
 
-			/* add it to the array and sort */
-			utarray_push_back(param_values, &buf);
-			utarray_sort(param_values, param_compare_values);
+			if (idx < 0) {
+				debug("failed to allocate modified values array");
+				goto out;
+			}
 
-			/* find it after sorting */
-			s = param_find_changed(param);
+			params_changed = true;
 		}
 
+		union param_value_u *v = &param_store.vals[idx];
+
 		/* update the changed value */
 		switch (param_type(param)) {
 
 		case PARAM_TYPE_INT32:
-			params_changed = params_changed || s->val.i != *(int32_t *)val;
-			s->val.i = *(int32_t *)val;
+			params_changed = params_changed || v->i != *(int32_t *)val;
+			v->i = *(int32_t *)val;
 			break;
 
 		case PARAM_TYPE_FLOAT:
-			params_changed = params_changed || fabsf(s->val.f - * (float *)val) > FLT_EPSILON;
-			s->val.f = *(float *)val;
+			params_changed = params_changed || fabsf(v->f - * (float *)val) > FLT_EPSILON;
+			v->f = *(float *)val;
 			break;
 
 		case PARAM_TYPE_STRUCT ... PARAM_TYPE_STRUCT_MAX:
-			if (s->val.p == NULL) {
+			if (v->p == NULL) {
 				size_t psize = param_size(param);
 
 				if (psize > 0) {
-					s->val.p = malloc(psize);
+					v->p = malloc(psize);
 
 				} else {
-					s->val.p = NULL;
+					v->p = NULL;
 				}
 
-				if (s->val.p == NULL) {
+				if (v->p == NULL) {
 					debug("failed to allocate parameter storage");
 					goto out;
 				}
 			}
 
-			memcpy(s->val.p, val, param_size(param));
+			memcpy(v->p, val, param_size(param));
 			params_changed = true;
 			break;
 
@@ -743,7 +874,7 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 			goto out;
 		}
 
-		s->unsaved = !mark_saved;
+		param_store_set_unsaved(idx, !mark_saved);
 		result = 0;
 
 		if (!mark_saved) { // this is false when importing parameters
@@ -759,7 +890,7 @@ out:
 	 * a thing has been set.
 	 */
 	if (params_changed && notify_changes) {
-		_param_notify_changes();
+		_param_notify_changes(param);
 	}
 
 	return result;
@@ -818,7 +949,7 @@ void param_set_used_internal(param_t param)
 int
 param_reset(param_t param)
 {
-	struct param_wbuf_s *s = NULL;
+	int idx = -1;
 	bool param_found = false;
 
 	param_lock_writer();
@@ -826,12 +957,11 @@ param_reset(param_t param)
 	if (handle_in_range(param)) {
 
 		/* look for a saved value */
-		s = param_find_changed(param);
+		idx = param_find_changed(param);
 
 		/* if we found one, erase it */
-		if (s != NULL) {
-			int pos = utarray_eltidx(param_values, s);
-			utarray_erase(param_values, pos, 1);
+		if (idx >= 0) {
+			param_store_erase(idx);
 		}
 
 		param_found = true;
@@ -841,8 +971,8 @@ param_reset(param_t param)
 
 	param_unlock_writer();
 
-	if (s != NULL) {
-		_param_notify_changes();
+	if (idx >= 0) {
+		_param_notify_changes(param);
 	}
 
 	return (!param_found);
@@ -852,12 +982,8 @@ param_reset_all_internal(bool auto_save)
 {
 	param_lock_writer();
 
-	if (param_values != NULL) {
-		utarray_free(param_values);
-	}
-
 	/* mark as reset / deleted */
-	param_values = NULL;
+	param_store_free();
 
 	if (auto_save) {
 		param_autosave();
@@ -865,7 +991,7 @@ param_reset_all_internal(bool auto_save)
 
 	param_unlock_writer();
 
-	_param_notify_changes();
+	_param_notify_changes(PARAM_INVALID);
 }
 
 void
@@ -899,7 +1025,7 @@ param_reset_excludes(const char *excludes[], int num_excludes)
 		}
 	}
 
-	_param_notify_changes();
+	_param_notify_changes(PARAM_INVALID);
 }
 
 int
@@ -924,6 +1050,21 @@ param_get_default_file(void)
 	return (param_user_file != NULL) ? param_user_file : param_default_file;
 }
 
+/**
+ * Build the name of the parameter journal file (the default file plus a
+ * ".jrnl" suffix).
+ * @return 0 on success, -1 if the name does not fit
+ */
+static int
+param_journal_file(char *buf, size_t len)
+{
+	if ((size_t)snprintf(buf, len, "%s.jrnl", param_get_default_file()) >= len) {
+		return -1;
+	}
+
+	return 0;
+}
+
 int
 param_save_default(void)
 {
@@ -933,8 +1074,35 @@ param_save_default(void)
 
 	const char *filename = param_get_default_file();
 
+	/* Journal-style incremental save: append a BSON document with only the
+	 * dirty (unsaved) parameters to the journal file, which is replayed on
+	 * top of the main file at load time. A single changed parameter then
+	 * costs one small append instead of a full rewrite. The journal is
+	 * compacted into the main file once it grows too large. */
+	char journal[128];
+
+	if (param_journal_file(journal, sizeof(journal)) == 0) {
+		struct stat st;
+		bool compact = (stat(journal, &st) == 0 && st.st_size > PARAM_JOURNAL_MAX_SIZE);
+
+		if (!compact) {
+			fd = PARAM_OPEN(journal, O_WRONLY | O_CREAT | O_APPEND, PX4_O_MODE_666);
+
+			if (fd >= 0) {
+				res = param_export(fd, true);
+				PARAM_CLOSE(fd);
+
+				if (res == OK) {
+					return OK;
+				}
+
+				/* append failed: fall through to a full rewrite */
+			}
+		}
+	}
+
 	/* write parameters to temp file */
-	fd = PARAM_OPEN(filename, O_WRONLY | O_CREAT, PX4_O_MODE_666);
+	fd = PARAM_OPEN(filename, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
 
 	if (fd < 0) {
 		warn("failed to open param file: %s", filename);
@@ -958,6 +1126,13 @@ param_save_default(void)
 	}
 
 	PARAM_CLOSE(fd);
+
+	if (res == OK) {
+		/* the full file now supersedes the journal */
+		if (param_journal_file(journal, sizeof(journal)) == 0) {
+			unlink(journal);
+		}
+	}
 #else
 	param_lock_writer();
 	res = flash_param_save();
@@ -994,6 +1169,21 @@ param_load_default(void)
 		return -2;
 	}
 
+	/* replay the parameter journal on top of the main file, one BSON
+	 * document per incremental save (@see param_save_default()) */
+	char journal[128];
+
+	if (param_journal_file(journal, sizeof(journal)) == 0) {
+		int fd_journal = PARAM_OPEN(journal, O_RDONLY);
+
+		if (fd_journal >= 0) {
+			while (param_import_internal(fd_journal, true) == 0) {
+			}
+
+			PARAM_CLOSE(fd_journal);
+		}
+	}
+
 #else
 	// no need for locking
 	res = flash_param_load();
@@ -1004,7 +1194,6 @@ param_load_default(void)
 int
 param_export(int fd, bool only_unsaved)
 {
-	struct param_wbuf_s *s = NULL;
 	struct bson_encoder_s encoder;
 	int	result = -1;
 
@@ -1014,18 +1203,25 @@ param_export(int fd, bool only_unsaved)
 		PX4_ERR("px4_shutdown_lock() failed (%i)", shutdown_lock_ret);
 	}
 
+	/* work buffer for the encoder: the document is flushed to the file in
+	 * buffer-sized chunks instead of one small write per parameter, which is
+	 * much faster on flash and SD. Fall back to unbuffered writes if there is
+	 * no memory for it. */
+	const unsigned export_bufsize = 2048;
+	uint8_t *export_buf = malloc(export_bufsize);
+
 	param_lock_writer();
 
-	bson_encoder_init_file(&encoder, fd);
+	if (export_buf != NULL) {
+		bson_encoder_init_buf_file(&encoder, fd, export_buf, export_bufsize);
 
-	/* no modified parameters -> we are done */
-	if (param_values == NULL) {
-		result = 0;
-		goto out;
+	} else {
+		bson_encoder_init_file(&encoder, fd);
 	}
 
-	while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
+	for (unsigned idx = 0; idx < param_store.count; idx++) {
 
+		const param_t param = param_store.ids[idx];
 		int32_t	i;
 		float	f;
 
@@ -1033,24 +1229,24 @@ param_export(int fd, bool only_unsaved)
 		 * If we are only saving values changed since last save, and this
 		 * one hasn't, then skip it
 		 */
-		if (only_unsaved && !s->unsaved) {
+		if (only_unsaved && !param_store_unsaved(idx)) {
 			continue;
 		}
 
-		s->unsaved = false;
+		param_store_set_unsaved(idx, false);
 
 		/* append the appropriate BSON type object */
 
 
-		switch (param_type(s->param)) {
+		switch (param_type(param)) {
 
 		case PARAM_TYPE_INT32: {
-				i = s->val.i;
-				const char *name = param_name(s->param);
+				i = param_store.vals[idx].i;
+				const char *name = param_name(param);
 
 				/* lock as short as possible */
 
-				if (bson_encoder_append_int(&encoder, name, i)) {
+				if (bson_encoder_append_varint(&encoder, name, i)) {
 					debug("BSON append failed for '%s'", name);
 					goto out;
 				}
@@ -1059,8 +1255,8 @@ param_export(int fd, bool only_unsaved)
 
 		case PARAM_TYPE_FLOAT: {
 
-				f = s->val.f;
-				const char *name = param_name(s->param);
+				f = param_store.vals[idx].f;
+				const char *name = param_name(param);
 
 				if (bson_encoder_append_double(&encoder, name, f)) {
 					debug("BSON append failed for '%s'", name);
@@ -1071,9 +1267,9 @@ param_export(int fd, bool only_unsaved)
 
 		case PARAM_TYPE_STRUCT ... PARAM_TYPE_STRUCT_MAX: {
 
-				const char *name = param_name(s->param);
-				const size_t size = param_size(s->param);
-				const void *value_ptr = param_get_value_ptr(s->param);
+				const char *name = param_name(param);
+				const size_t size = param_size(param);
+				const void *value_ptr = param_get_value_ptr(param);
 
 				/* lock as short as possible */
 				if (bson_encoder_append_binary(&encoder,
@@ -1099,6 +1295,12 @@ param_export(int fd, bool only_unsaved)
 	result = 0;
 
 out:
+
+	if (result == 0) {
+		/* finalize the object, writing out any buffered data */
+		result = bson_encoder_fini(&encoder);
+	}
+
 	param_unlock_writer();
 
 	fsync(fd); // make sure the data is flushed before releasing the shutdown lock
@@ -1107,9 +1309,7 @@ out:
 		px4_shutdown_unlock();
 	}
 
-	if (result == 0) {
-		result = bson_encoder_fini(&encoder);
-	}
+	free(export_buf);
 
 	return result;
 }
@@ -1153,6 +1353,7 @@ param_import_callback(bson_decoder_t decoder, void *private, bson_node_t node)
 
 	switch (node->type) {
 	case BSON_INT32:
+	case BSON_VARINT:
 		if (param_type(param) != PARAM_TYPE_INT32) {
 			PX4_WARN("unexpected type for %s", node->name);
 			result = 1; // just skip this entry
@@ -1295,7 +1496,7 @@ param_foreach(void (*func)(void *arg, param_t param), void *arg, bool only_chang
 	for (param = 0; handle_in_range(param); param++) {
 
 		/* if requested, skip unchanged values */
-		if (only_changed && (param_find_changed(param) == NULL)) {
+		if (only_changed && (param_find_changed(param) < 0)) {
 			continue;
 		}
 
@@ -238,6 +238,35 @@ __EXPORT size_t		param_size(param_t param);
  */
 __EXPORT int		param_get(param_t param, void *val);
 
+/**
+ * Copy the value of a parameter, but only if it was affected by a change
+ * notification.
+ *
+ * @param param		A handle returned by param_find or passed by param_foreach.
+ * @param changed_param	The changed_param field of the parameter_update message
+ *			that triggered the refresh (UINT32_MAX when the change is
+ *			not attributable to a single parameter).
+ * @param val		Where to return the value; left untouched when the
+ *			parameter was unaffected.
+ * @return		Zero if the value was copied, 1 if the parameter was
+ *			unaffected, nonzero negative on error.
+ */
+__EXPORT int		param_get_if_changed(param_t param, uint32_t changed_param, void *val);
+
+/**
+ * Test whether a change notification affects any parameter of a handle set.
+ *
+ * Modules caching many parameters can pass their handle struct to skip a full
+ * refresh when the notification names an unrelated parameter.
+ *
+ * @param changed_param	The changed_param field of the parameter_update message.
+ * @param set		Array of the module's parameter handles.
+ * @param count		Number of handles in the set.
+ * @return		True if the set contains the changed parameter or the
+ *			change is not attributable to a single parameter.
+ */
+__EXPORT bool		param_in_set(uint32_t changed_param, const param_t *set, unsigned count);
+
 /**
  * Set the value of a parameter.
  *
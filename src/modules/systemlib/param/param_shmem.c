@@ -267,9 +267,13 @@ param_find_changed(param_t param)
 }
 
 static void
-_param_notify_changes(void)
+_param_notify_changes(param_t param)
 {
-	struct parameter_update_s pup = { .timestamp = hrt_absolute_time(), .dummy = 0 };
+	struct parameter_update_s pup = {
+		.timestamp = hrt_absolute_time(),
+		.dummy = 0,
+		.changed_param = (param == PARAM_INVALID) ? UINT32_MAX : (uint32_t)param
+	};
 
 	/*
 	 * If we don't have a handle to our topic, create one now; otherwise
@@ -286,18 +290,26 @@ _param_notify_changes(void)
 void
 param_notify_changes(void)
 {
-	_param_notify_changes();
+	_param_notify_changes(PARAM_INVALID);
 }
 
 
 param_t
 param_find_internal(const char *name, bool notification)
 {
-	param_t param;
+	/* constant-time probe of the hash index generated by px_generate_params.py */
+	uint32_t hash = 2166136261u;
 
-	/* perform a linear search of the known parameters */
-	for (param = 0; handle_in_range(param); param++) {
-		if (!strcmp(param_info_base[param].name, name)) {
+	for (const char *c = name; *c; c++) {
+		hash = (hash ^ (uint8_t)*c) * 16777619u;
+	}
+
+	for (unsigned slot = hash & (PX4_PARAM_HASH_SIZE - 1);
+	     px4_parameter_hash_table[slot] != 0xffff;
+	     slot = (slot + 1) & (PX4_PARAM_HASH_SIZE - 1)) {
+		param_t param = px4_parameter_hash_table[slot];
+
+		if (strcmp(name, param_info_base[param].name) == 0) {
 			if (notification) {
 				param_set_used_internal(param);
 			}
@@ -586,6 +598,34 @@ param_get(param_t param, void *val)
 	return result;
 }
 
+int
+param_get_if_changed(param_t param, uint32_t changed_param, void *val)
+{
+	if (changed_param != UINT32_MAX && changed_param != (uint32_t)param) {
+		/* the notification names a different parameter, keep the cached value */
+		return 1;
+	}
+
+	return param_get(param, val);
+}
+
+bool
+param_in_set(uint32_t changed_param, const param_t *set, unsigned count)
+{
+	if (changed_param == UINT32_MAX) {
+		/* not attributable to a single parameter, assume the set is affected */
+		return true;
+	}
+
+	for (unsigned i = 0; i < count; i++) {
+		if ((uint32_t)set[i] == changed_param) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 
 /**
  * worker callback method to save the parameters
@@ -749,7 +789,7 @@ out:
 	if (!param_import_done) { notify_changes = 0; }
 
 	if (params_changed && notify_changes) {
-		_param_notify_changes();
+		_param_notify_changes(param);
 	}
 
 	if (result == 0 && !set_called_from_get) {
@@ -842,7 +882,7 @@ param_reset(param_t param)
 	param_unlock();
 
 	if (s != NULL) {
-		_param_notify_changes();
+		_param_notify_changes(param);
 	}
 
 	return (!param_found);
@@ -865,7 +905,7 @@ param_reset_all_internal(bool auto_save)
 
 	param_unlock();
 
-	_param_notify_changes();
+	_param_notify_changes(PARAM_INVALID);
 }
 
 void
@@ -899,7 +939,7 @@ param_reset_excludes(const char *excludes[], int num_excludes)
 		}
 	}
 
-	_param_notify_changes();
+	_param_notify_changes(PARAM_INVALID);
 }
 
 int
@@ -1043,9 +1083,20 @@ param_export(int fd, bool only_unsaved)
 		PX4_ERR("px4_shutdown_lock() failed (%i)", shutdown_lock_ret);
 	}
 
+	/* work buffer for the encoder: the document is flushed to the file in
+	 * buffer-sized chunks instead of one small write per parameter. Fall back
+	 * to unbuffered writes if there is no memory for it. */
+	const unsigned export_bufsize = 2048;
+	uint8_t *export_buf = malloc(export_bufsize);
+
 	param_lock();
 
-	bson_encoder_init_file(&encoder, fd);
+	if (export_buf != NULL) {
+		bson_encoder_init_buf_file(&encoder, fd, export_buf, export_bufsize);
+
+	} else {
+		bson_encoder_init_file(&encoder, fd);
+	}
 
 	/* no modified parameters -> we are done */
 	if (param_values == NULL) {
@@ -1082,7 +1133,7 @@ param_export(int fd, bool only_unsaved)
 		case PARAM_TYPE_INT32:
 			i = s->val.i;
 
-			if (bson_encoder_append_int(&encoder, param_name(s->param), i)) {
+			if (bson_encoder_append_varint(&encoder, param_name(s->param), i)) {
 				PX4_DEBUG("BSON append failed for '%s'", param_name(s->param));
 				goto out;
 			}
@@ -1120,6 +1171,12 @@ param_export(int fd, bool only_unsaved)
 	result = 0;
 
 out:
+
+	if (result == 0) {
+		/* finalize the object, writing out any buffered data */
+		result = bson_encoder_fini(&encoder);
+	}
+
 	param_unlock();
 
 	fsync(fd); // make sure the data is flushed before releasing the shutdown lock
@@ -1128,9 +1185,7 @@ out:
 		px4_shutdown_unlock();
 	}
 
-	if (result == 0) {
-		result = bson_encoder_fini(&encoder);
-	}
+	free(export_buf);
 
 	return result;
 }
@@ -1174,6 +1229,7 @@ param_import_callback(bson_decoder_t decoder, void *private, bson_node_t node)
 
 	switch (node->type) {
 	case BSON_INT32:
+	case BSON_VARINT:
 		if (param_type(param) != PARAM_TYPE_INT32) {
 			PX4_WARN("unexpected type for %s", node->name);
 			result = 1; // just skip this entry
@@ -29,6 +29,25 @@ def generate(xml_file, dest='.'):
 
     params = sorted(params, key=lambda name: name.attrib["name"])
 
+    # build an open-addressed FNV-1a hash index over the parameter names so
+    # that param_find is a constant-time probe instead of a search
+    def fnv1a(name):
+        h = 2166136261
+        for c in name.encode():
+            h = ((h ^ c) * 16777619) & 0xFFFFFFFF
+        return h
+
+    hash_size = 1
+    while hash_size < 2 * len(params):
+        hash_size *= 2
+
+    hash_table = [0xFFFF] * hash_size
+    for idx, param in enumerate(params):
+        slot = fnv1a(param.attrib["name"]) & (hash_size - 1)
+        while hash_table[slot] != 0xFFFF:
+            slot = (slot + 1) & (hash_size - 1)
+        hash_table[slot] = idx
+
     script_path = os.path.dirname(os.path.realpath(__file__))
 
     # for jinja docs see: http://jinja.pocoo.org/docs/2.9/api/
@@ -46,7 +65,7 @@ def generate(xml_file, dest='.'):
         template = env.get_template(template_file)
         with open(os.path.join(
                 dest, template_file.replace('.jinja','')), 'w') as fid:
-            fid.write(template.render(params=params))
+            fid.write(template.render(params=params, hash_table=hash_table))
 
 if __name__ == "__main__":
     arg_parser = argparse.ArgumentParser()
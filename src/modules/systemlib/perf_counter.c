@@ -613,6 +613,21 @@ perf_print_latency(int fd)
 
 	// print the overflow bucket value
 	dprintf(fd, " >%4i : %i\n", latency_buckets[latency_bucket_count - 1], latency_counters[latency_bucket_count]);
+
+	/* append the per-client latency counters (instrumented hrt callouts and
+	 * work queues, by convention named "... latency") */
+	pthread_mutex_lock(&perf_counters_mutex);
+	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+
+	while (handle != NULL) {
+		if (strstr(handle->name, "latency") != NULL) {
+			perf_print_counter_fd(fd, handle);
+		}
+
+		handle = (perf_counter_t)sq_next(&handle->link);
+	}
+
+	pthread_mutex_unlock(&perf_counters_mutex);
 }
 
 void
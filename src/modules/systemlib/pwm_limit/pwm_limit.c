@@ -40,9 +40,15 @@
  * @author Lorenz Meier <lorenz@px4.io>
  */
 
+#include <px4_config.h>
+
 #include "pwm_limit.h"
+#ifdef MIXER_USE_FIXED_POINT
+#include <systemlib/mixer/mixer_q16.h>
+#endif
 #include <math.h>
 #include <stdbool.h>
+#include <string.h>
 #include <drivers/drv_hrt.h>
 #include <stdio.h>
 
@@ -50,10 +56,51 @@
 
 void pwm_limit_init(pwm_limit_t *limit)
 {
+	memset(limit, 0, sizeof(*limit));
 	limit->state = PWM_LIMIT_STATE_INIT;
-	limit->time_armed = 0;
 }
 
+/*
+ * regenerate the per-channel affine transform if min/max pwm or the reverse
+ * mask changed (parameter updates, mode switches); a no-op on every other
+ * cycle
+ */
+static void pwm_limit_update_cache(pwm_limit_t *limit, unsigned num_channels, uint16_t reverse_mask,
+				   const uint16_t *min_pwm, const uint16_t *max_pwm)
+{
+	if (num_channels > PWM_LIMIT_MAX_CHANNELS) {
+		num_channels = PWM_LIMIT_MAX_CHANNELS;
+	}
+
+	if (num_channels == limit->cached_channels && reverse_mask == limit->cached_reverse_mask &&
+	    memcmp(min_pwm, limit->cached_min, num_channels * sizeof(uint16_t)) == 0 &&
+	    memcmp(max_pwm, limit->cached_max, num_channels * sizeof(uint16_t)) == 0) {
+		return;
+	}
+
+	for (unsigned i = 0; i < num_channels; i++) {
+		float scale = (max_pwm[i] - min_pwm[i]) / 2.0f;
+
+		if (reverse_mask & (1 << i)) {
+			scale = -scale;
+		}
+
+		limit->scale[i] = scale;
+		limit->offset[i] = (max_pwm[i] + min_pwm[i]) / 2.0f;
+#ifdef MIXER_USE_FIXED_POINT
+		/* pwm values are well below 2^15, so the Q16.16 mirror cannot overflow */
+		limit->scale_q16[i] = q16_from_float(scale);
+		limit->offset_q16[i] = q16_from_float(limit->offset[i]);
+#endif
+		limit->cached_min[i] = min_pwm[i];
+		limit->cached_max[i] = max_pwm[i];
+	}
+
+	limit->cached_reverse_mask = reverse_mask;
+	limit->cached_channels = num_channels;
+}
+
+PX4_HOT_RAMFUNC
 void pwm_limit_calc(const bool armed, const bool pre_armed, const unsigned num_channels, const uint16_t reverse_mask,
 		    const uint16_t *disarmed_pwm, const uint16_t *min_pwm, const uint16_t *max_pwm,
 		    const float *output, uint16_t *effective_pwm, pwm_limit_t *limit)
@@ -192,6 +239,8 @@ void pwm_limit_calc(const bool armed, const bool pre_armed, const unsigned num_c
 
 	case PWM_LIMIT_STATE_ON:
 
+		pwm_limit_update_cache(limit, num_channels, reverse_mask, min_pwm, max_pwm);
+
 		for (unsigned i = 0; i < num_channels; i++) {
 
 			float control_value = output[i];
@@ -202,20 +251,47 @@ void pwm_limit_calc(const bool armed, const bool pre_armed, const unsigned num_c
 				continue;
 			}
 
-			if (reverse_mask & (1 << i)) {
-				control_value = -1.0f * control_value;
-			}
+			float pwm;
+
+			if (i < limit->cached_channels) {
+#ifdef MIXER_USE_FIXED_POINT
+				/* no FPU: one float-to-q16 conversion, then an integer multiply-add */
+				int32_t pwm_q16 = q16_mul(q16_from_float(control_value), limit->scale_q16[i]) +
+						  limit->offset_q16[i];
+				int32_t pwm_i = pwm_q16 >> 16;
+
+				/* last line of defense against invalid inputs */
+				if (pwm_i < min_pwm[i]) {
+					pwm_i = min_pwm[i];
+
+				} else if (pwm_i > max_pwm[i]) {
+					pwm_i = max_pwm[i];
+				}
 
-			effective_pwm[i] = control_value * (max_pwm[i] - min_pwm[i]) / 2 + (max_pwm[i] + min_pwm[i]) / 2;
+				effective_pwm[i] = (uint16_t)pwm_i;
+				continue;
+#else
+				pwm = control_value * limit->scale[i] + limit->offset[i];
+#endif
+
+			} else {
+				/* channel beyond the cache: compute the scaling inline */
+				if (reverse_mask & (1 << i)) {
+					control_value = -1.0f * control_value;
+				}
+
+				pwm = control_value * (max_pwm[i] - min_pwm[i]) / 2.0f + (max_pwm[i] + min_pwm[i]) / 2.0f;
+			}
 
 			/* last line of defense against invalid inputs */
-			if (effective_pwm[i] < min_pwm[i]) {
-				effective_pwm[i] = min_pwm[i];
+			if (pwm < min_pwm[i]) {
+				pwm = min_pwm[i];
 
-			} else if (effective_pwm[i] > max_pwm[i]) {
-				effective_pwm[i] = max_pwm[i];
+			} else if (pwm > max_pwm[i]) {
+				pwm = max_pwm[i];
 			}
 
+			effective_pwm[i] = (uint16_t)pwm;
 		}
 
 		break;
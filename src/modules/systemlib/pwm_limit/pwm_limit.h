@@ -64,9 +64,33 @@ enum pwm_limit_state {
 	PWM_LIMIT_STATE_ON
 };
 
+/*
+ * number of channels covered by the precomputed affine transform below;
+ * channels beyond this (no in-tree output driver has any) fall back to
+ * computing the scaling inline
+ */
+#define PWM_LIMIT_MAX_CHANNELS 16
+
 typedef struct {
 	enum pwm_limit_state state;
 	uint64_t time_armed;
+
+	/* per-channel affine transform pwm = control * scale + offset, derived
+	 * from the min/max pwm values with the reverse mask folded into the sign
+	 * of scale. Regenerated inside pwm_limit_calc() only when the inputs
+	 * change, so the steady-state output path is a multiply-add and a clamp
+	 * per channel. */
+	float scale[PWM_LIMIT_MAX_CHANNELS];
+	float offset[PWM_LIMIT_MAX_CHANNELS];
+#ifdef MIXER_USE_FIXED_POINT
+	/* Q16.16 mirror of scale/offset for the no-FPU build (px4io) */
+	int32_t scale_q16[PWM_LIMIT_MAX_CHANNELS];
+	int32_t offset_q16[PWM_LIMIT_MAX_CHANNELS];
+#endif
+	uint16_t cached_min[PWM_LIMIT_MAX_CHANNELS];
+	uint16_t cached_max[PWM_LIMIT_MAX_CHANNELS];
+	uint16_t cached_reverse_mask;
+	unsigned cached_channels;
 } pwm_limit_t;
 
 __EXPORT void pwm_limit_init(pwm_limit_t *limit);
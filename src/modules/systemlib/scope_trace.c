@@ -0,0 +1,234 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file scope_trace.c
+ *
+ * Scoped-zone tracing implementation.
+ */
+
+#include <px4_config.h>
+#include <px4_log.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+
+#include "scope_trace.h"
+
+/* number of events kept in the ring; older events are overwritten */
+#define SCOPE_TRACE_EVENTS	1024
+
+struct scope_trace_event_s {
+	hrt_abstime	timestamp;
+	uint16_t	pid;
+	uint8_t		zone;
+	uint8_t		enter;
+};
+
+static char scope_trace_names[SCOPE_TRACE_MAX_ZONES][SCOPE_TRACE_NAME_LEN];
+static int scope_trace_zone_count;
+
+static struct scope_trace_event_s *scope_trace_ring;
+static volatile unsigned scope_trace_head;
+
+volatile bool scope_trace_armed = false;
+
+int
+scope_trace_register(const char *name)
+{
+	/* re-registering a name returns the existing zone, so instrumented
+	 * code can register from its start path without bookkeeping */
+	for (int i = 0; i < scope_trace_zone_count; i++) {
+		if (strncmp(scope_trace_names[i], name, SCOPE_TRACE_NAME_LEN - 1) == 0) {
+			return i;
+		}
+	}
+
+	if (scope_trace_zone_count >= SCOPE_TRACE_MAX_ZONES) {
+		return -1;
+	}
+
+	strncpy(scope_trace_names[scope_trace_zone_count], name, SCOPE_TRACE_NAME_LEN - 1);
+	scope_trace_names[scope_trace_zone_count][SCOPE_TRACE_NAME_LEN - 1] = '\0';
+
+	return scope_trace_zone_count++;
+}
+
+int
+scope_trace_start(void)
+{
+	if (scope_trace_armed) {
+		return 0;
+	}
+
+	scope_trace_ring = calloc(SCOPE_TRACE_EVENTS, sizeof(struct scope_trace_event_s));
+
+	if (scope_trace_ring == NULL) {
+		PX4_ERR("could not allocate the trace ring");
+		return -1;
+	}
+
+	scope_trace_head = 0;
+	scope_trace_armed = true;
+
+	return 0;
+}
+
+void
+scope_trace_stop(void)
+{
+	if (!scope_trace_armed) {
+		return;
+	}
+
+	scope_trace_armed = false;
+
+	/* writers that passed the armed check have at most a few instructions
+	 * to go; don't free the ring underneath them */
+	usleep(1000);
+
+	free(scope_trace_ring);
+	scope_trace_ring = NULL;
+}
+
+static void
+scope_trace_record(int zone, bool enter)
+{
+	if (zone < 0 || zone >= scope_trace_zone_count || !scope_trace_armed) {
+		return;
+	}
+
+	/* claim a slot; __sync keeps concurrent writers from sharing one */
+	unsigned idx = __sync_fetch_and_add(&scope_trace_head, 1) % SCOPE_TRACE_EVENTS;
+
+	struct scope_trace_event_s *ev = &scope_trace_ring[idx];
+
+	ev->timestamp = hrt_absolute_time();
+	ev->pid = getpid();
+	ev->zone = zone;
+	ev->enter = enter;
+}
+
+void
+scope_trace_enter(int zone)
+{
+	scope_trace_record(zone, true);
+}
+
+void
+scope_trace_leave(int zone)
+{
+	scope_trace_record(zone, false);
+}
+
+void
+scope_trace_dump(void)
+{
+	if (!scope_trace_armed) {
+		PX4_INFO("tracing not armed, run 'scope_trace start' first");
+		return;
+	}
+
+	uint32_t counts[SCOPE_TRACE_MAX_ZONES] = {};
+	uint64_t totals[SCOPE_TRACE_MAX_ZONES] = {};
+	uint32_t maxima[SCOPE_TRACE_MAX_ZONES] = {};
+	hrt_abstime open_since[SCOPE_TRACE_MAX_ZONES] = {};
+
+	unsigned head = scope_trace_head;
+	unsigned count = (head < SCOPE_TRACE_EVENTS) ? head : SCOPE_TRACE_EVENTS;
+	unsigned first = (head < SCOPE_TRACE_EVENTS) ? 0 : head % SCOPE_TRACE_EVENTS;
+
+	/* pair each zone exit with the latest entry of the same zone; nesting
+	 * of distinct zones is fine, recursion of one zone is not expected */
+	for (unsigned i = 0; i < count; i++) {
+		const struct scope_trace_event_s *ev = &scope_trace_ring[(first + i) % SCOPE_TRACE_EVENTS];
+
+		if (ev->enter) {
+			open_since[ev->zone] = ev->timestamp;
+
+		} else if (open_since[ev->zone] != 0) {
+			uint32_t elapsed = ev->timestamp - open_since[ev->zone];
+
+			counts[ev->zone]++;
+			totals[ev->zone] += elapsed;
+
+			if (elapsed > maxima[ev->zone]) {
+				maxima[ev->zone] = elapsed;
+			}
+
+			open_since[ev->zone] = 0;
+		}
+	}
+
+	printf("%-16s %8s %10s %10s %10s\n", "ZONE", "COUNT", "TOTAL US", "AVG US", "MAX US");
+
+	for (int zone = 0; zone < scope_trace_zone_count; zone++) {
+		if (counts[zone] == 0) {
+			continue;
+		}
+
+		printf("%-16s %8u %10llu %10llu %10u\n",
+		       scope_trace_names[zone],
+		       counts[zone],
+		       (unsigned long long)totals[zone],
+		       (unsigned long long)(totals[zone] / counts[zone]),
+		       maxima[zone]);
+	}
+}
+
+void
+scope_trace_dump_events(void)
+{
+	if (!scope_trace_armed) {
+		PX4_INFO("tracing not armed, run 'scope_trace start' first");
+		return;
+	}
+
+	unsigned head = scope_trace_head;
+	unsigned count = (head < SCOPE_TRACE_EVENTS) ? head : SCOPE_TRACE_EVENTS;
+	unsigned first = (head < SCOPE_TRACE_EVENTS) ? 0 : head % SCOPE_TRACE_EVENTS;
+
+	for (unsigned i = 0; i < count; i++) {
+		const struct scope_trace_event_s *ev = &scope_trace_ring[(first + i) % SCOPE_TRACE_EVENTS];
+
+		printf("%llu %5u %s %s\n",
+		       (unsigned long long)ev->timestamp,
+		       ev->pid,
+		       ev->enter ? "enter" : "leave",
+		       scope_trace_names[ev->zone]);
+	}
+}
@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file scope_trace.h
+ *
+ * Scoped-zone tracing.
+ *
+ * Complements the perf counters: where a perf counter tells you how long
+ * a section takes on average, scope tracing records every enter/leave of
+ * the instrumented zones into an event ring, so an individual slow cycle
+ * can be attributed to the zone that caused it.
+ *
+ * Zones are registered once by name and instrumented with the
+ * SCOPE_TRACE_ENTER/LEAVE macros, which cost a flag test while tracing is
+ * disarmed. The ring is allocated when tracing is started from the
+ * 'scope_trace' system command and freed again when it is stopped.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+__BEGIN_DECLS
+
+#define SCOPE_TRACE_MAX_ZONES	16
+#define SCOPE_TRACE_NAME_LEN	16
+
+/** true while the event ring is armed; tested by the macros below */
+__EXPORT extern volatile bool scope_trace_armed;
+
+/**
+ * Register a trace zone.
+ *
+ * @param name		Zone name, truncated to SCOPE_TRACE_NAME_LEN - 1.
+ * @return		Zone handle, or -1 if the zone table is full.
+ */
+__EXPORT int	scope_trace_register(const char *name);
+
+/**
+ * Allocate the event ring and arm tracing.
+ *
+ * @return		0 on success, -1 if the ring could not be allocated.
+ */
+__EXPORT int	scope_trace_start(void);
+
+/**
+ * Disarm tracing and free the event ring.
+ */
+__EXPORT void	scope_trace_stop(void);
+
+/** Record a zone entry; prefer the SCOPE_TRACE_ENTER macro. */
+__EXPORT void	scope_trace_enter(int zone);
+
+/** Record a zone exit; prefer the SCOPE_TRACE_LEAVE macro. */
+__EXPORT void	scope_trace_leave(int zone);
+
+/**
+ * Print a per-zone summary (count, total, max) of the armed ring.
+ */
+__EXPORT void	scope_trace_dump(void);
+
+/**
+ * Print the raw event list of the armed ring, oldest first.
+ */
+__EXPORT void	scope_trace_dump_events(void);
+
+#define SCOPE_TRACE_ENTER(zone) \
+	do { \
+		if (scope_trace_armed) { \
+			scope_trace_enter(zone); \
+		} \
+	} while (0)
+
+#define SCOPE_TRACE_LEAVE(zone) \
+	do { \
+		if (scope_trace_armed) { \
+			scope_trace_leave(zone); \
+		} \
+	} while (0)
+
+__END_DECLS
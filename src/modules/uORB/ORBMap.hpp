@@ -36,6 +36,8 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "uORBPool.hpp"
+
 
 namespace uORB
 {
@@ -62,7 +64,7 @@ public:
 			unlinkNext(_top);
 
 			if (_top->next == nullptr) {
-				free(_top);
+				Pool::release(_top);
 				_top = nullptr;
 				_end = nullptr;
 			}
@@ -86,7 +88,7 @@ public:
 			p = &_end->next;
 		}
 
-		*p = (Node *)malloc(sizeof(Node));
+		*p = (Node *)Pool::allocate(sizeof(Node));
 
 		if (_end) {
 			_end = _end->next;
@@ -151,7 +153,7 @@ private:
 			}
 
 			a->next = b->next;
-			free(b);
+			Pool::release(b);
 		}
 	}
 
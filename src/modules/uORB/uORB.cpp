@@ -89,6 +89,26 @@ int  orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const voi
 	return uORB::Manager::get_instance()->orb_publish(meta, handle, data);
 }
 
+void *orb_publish_borrow(const struct orb_metadata *meta, orb_advert_t handle)
+{
+	return uORB::Manager::get_instance()->orb_publish_borrow(meta, handle);
+}
+
+int  orb_publish_commit(const struct orb_metadata *meta, orb_advert_t handle)
+{
+	return uORB::Manager::get_instance()->orb_publish_commit(meta, handle);
+}
+
+const void *orb_peek(int handle, unsigned *generation)
+{
+	return uORB::Manager::get_instance()->orb_peek(handle, generation);
+}
+
+bool orb_peek_valid(int handle, unsigned generation)
+{
+	return uORB::Manager::get_instance()->orb_peek_valid(handle, generation);
+}
+
 int  orb_subscribe(const struct orb_metadata *meta)
 {
 	return uORB::Manager::get_instance()->orb_subscribe(meta);
@@ -114,6 +134,22 @@ int  orb_check(int handle, bool *updated)
 	return uORB::Manager::get_instance()->orb_check(handle, updated);
 }
 
+int  orb_check_multi(const int *handles, unsigned count, uint32_t *updated)
+{
+	return uORB::Manager::get_instance()->orb_check_multi(handles, count, updated);
+}
+
+int  orb_copy_multi(const struct orb_metadata **metas, const int *handles, void **buffers, unsigned count,
+		    uint32_t *updated)
+{
+	return uORB::Manager::get_instance()->orb_copy_multi(metas, handles, buffers, count, updated);
+}
+
+int  orb_copy_batch(const struct orb_metadata *meta, int handle, void *buffer, unsigned max_count)
+{
+	return uORB::Manager::get_instance()->orb_copy_batch(meta, handle, buffer, max_count);
+}
+
 int  orb_stat(int handle, uint64_t *time)
 {
 	return uORB::Manager::get_instance()->orb_stat(handle, time);
@@ -135,11 +171,31 @@ int  orb_group_count(const struct orb_metadata *meta)
 	return instance;
 }
 
+int  orb_watch_advertisements(const struct orb_metadata *meta)
+{
+	return uORB::Manager::get_instance()->orb_watch_advertisements(meta);
+}
+
+int  orb_unwatch_advertisements(int watch)
+{
+	return uORB::Manager::get_instance()->orb_unwatch_advertisements(watch);
+}
+
+bool orb_advertisements_changed(int watch)
+{
+	return uORB::Manager::get_instance()->orb_advertisements_changed(watch);
+}
+
 int  orb_priority(int handle, int32_t *priority)
 {
 	return uORB::Manager::get_instance()->orb_priority(handle, priority);
 }
 
+int orb_subscriber_count(orb_advert_t handle)
+{
+	return uORB::Manager::get_instance()->orb_subscriber_count(handle);
+}
+
 int orb_set_interval(int handle, unsigned interval)
 {
 	return uORB::Manager::get_instance()->orb_set_interval(handle, interval);
@@ -149,3 +205,13 @@ int orb_get_interval(int handle, unsigned *interval)
 {
 	return uORB::Manager::get_instance()->orb_get_interval(handle, interval);
 }
+
+int orb_set_change_filter(int handle, bool enable)
+{
+	return uORB::Manager::get_instance()->orb_set_change_filter(handle, enable);
+}
+
+int orb_set_integrity_check(int handle, bool enable)
+{
+	return uORB::Manager::get_instance()->orb_set_integrity_check(handle, enable);
+}
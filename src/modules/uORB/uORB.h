@@ -52,10 +52,33 @@ struct orb_metadata {
 	const size_t o_size;		/**< object size */
 	const size_t o_size_no_padding;	/**< object size w/o padding at the end (for logger) */
 	const char *o_fields;		/**< semicolon separated list of fields (with type) */
+	const char *o_format;		/**< precomputed ULog format string ("name:fields"), NULL for hand-written topics */
+	const uint8_t o_flags;		/**< topic flags (ORB_FLAG_*) */
 };
 
 typedef const struct orb_metadata *orb_id_t;
 
+/**
+ * Topic flags, set per topic via ORB_DEFINE_FLAGS() (or an ORB_SPSC constant
+ * in the .msg file).
+ */
+#define ORB_FLAG_DEFAULT	0
+/**
+ * Single-publisher topic: publications use a lock-free path with an atomic
+ * generation counter instead of taking the device node lock, so a high-rate
+ * publisher never blocks on slow readers. Readers validate their copy against
+ * the generation counter and retry if the publisher lapped them.
+ */
+#define ORB_FLAG_SPSC		(1 << 0)
+/**
+ * Critical topic: every publication is delivered immediately, preempting the
+ * subscriber-side batching filters (update interval, change filter). On NuttX
+ * the publisher additionally boosts a lower-priority blocked subscriber to its
+ * own priority until the update has been collected, bounding the time a
+ * kill-switch class update can queue behind the subscriber's other work.
+ */
+#define ORB_FLAG_CRITICAL	(1 << 1)
+
 /**
  * Maximum number of multi topic instances
  */
@@ -116,7 +139,27 @@ enum ORB_PRIO {
 		#_name,					\
 		sizeof(_struct),		\
 		_size_no_padding,			\
-		_fields					\
+		_fields,				\
+		NULL,					\
+		ORB_FLAG_DEFAULT			\
+	}; struct hack
+
+/**
+ * Define (instantiate) the uORB metadata for a topic with non-default flags
+ * and a precomputed ULog format string (used by the topic generator).
+ *
+ * @see ORB_DEFINE()
+ * @param _format	Precomputed ULog format string "name:fields"
+ * @param _flags	Topic flags, a combination of ORB_FLAG_*
+ */
+#define ORB_DEFINE_FLAGS(_name, _struct, _size_no_padding, _fields, _format, _flags)	\
+	const struct orb_metadata __orb_##_name = {	\
+		#_name,					\
+		sizeof(_struct),		\
+		_size_no_padding,			\
+		_fields,				\
+		_format,				\
+		_flags					\
 	}; struct hack
 
 __BEGIN_DECLS
@@ -177,6 +220,26 @@ extern int orb_publish_auto(const struct orb_metadata *meta, orb_advert_t *handl
  */
 extern int	orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data) __EXPORT;
 
+/**
+ * @see uORB::Manager::orb_publish_borrow()
+ */
+extern void	*orb_publish_borrow(const struct orb_metadata *meta, orb_advert_t handle) __EXPORT;
+
+/**
+ * @see uORB::Manager::orb_publish_commit()
+ */
+extern int	orb_publish_commit(const struct orb_metadata *meta, orb_advert_t handle) __EXPORT;
+
+/**
+ * @see uORB::Manager::orb_peek()
+ */
+extern const void	*orb_peek(int handle, unsigned *generation) __EXPORT;
+
+/**
+ * @see uORB::Manager::orb_peek_valid()
+ */
+extern bool	orb_peek_valid(int handle, unsigned generation) __EXPORT;
+
 /**
  * @see uORB::Manager::orb_subscribe()
  */
@@ -202,6 +265,22 @@ extern int	orb_copy(const struct orb_metadata *meta, int handle, void *buffer) _
  */
 extern int	orb_check(int handle, bool *updated) __EXPORT;
 
+/**
+ * @see uORB::Manager::orb_check_multi()
+ */
+extern int	orb_check_multi(const int *handles, unsigned count, uint32_t *updated) __EXPORT;
+
+/**
+ * @see uORB::Manager::orb_copy_multi()
+ */
+extern int	orb_copy_multi(const struct orb_metadata **metas, const int *handles, void **buffers, unsigned count,
+			       uint32_t *updated) __EXPORT;
+
+/**
+ * @see uORB::Manager::orb_copy_batch()
+ */
+extern int	orb_copy_batch(const struct orb_metadata *meta, int handle, void *buffer, unsigned max_count) __EXPORT;
+
 /**
  * @see uORB::Manager::orb_stat()
  */
@@ -220,11 +299,31 @@ extern int	orb_exists(const struct orb_metadata *meta, int instance) __EXPORT;
  */
 extern int	orb_group_count(const struct orb_metadata *meta) __EXPORT;
 
+/**
+ * @see uORB::Manager::orb_watch_advertisements()
+ */
+extern int	orb_watch_advertisements(const struct orb_metadata *meta) __EXPORT;
+
+/**
+ * @see uORB::Manager::orb_unwatch_advertisements()
+ */
+extern int	orb_unwatch_advertisements(int watch) __EXPORT;
+
+/**
+ * @see uORB::Manager::orb_advertisements_changed()
+ */
+extern bool	orb_advertisements_changed(int watch) __EXPORT;
+
 /**
  * @see uORB::Manager::orb_priority()
  */
 extern int	orb_priority(int handle, int32_t *priority) __EXPORT;
 
+/**
+ * @see uORB::Manager::orb_subscriber_count()
+ */
+extern int	orb_subscriber_count(orb_advert_t handle) __EXPORT;
+
 /**
  * @see uORB::Manager::orb_set_interval()
  */
@@ -235,6 +334,16 @@ extern int	orb_set_interval(int handle, unsigned interval) __EXPORT;
  */
 extern int	orb_get_interval(int handle, unsigned *interval) __EXPORT;
 
+/**
+ * @see uORB::Manager::orb_set_change_filter()
+ */
+extern int	orb_set_change_filter(int handle, bool enable) __EXPORT;
+
+/**
+ * @see uORB::Manager::orb_set_integrity_check()
+ */
+extern int	orb_set_integrity_check(int handle, bool enable) __EXPORT;
+
 __END_DECLS
 
 /* Diverse uORB header defines */ //XXX: move to better location
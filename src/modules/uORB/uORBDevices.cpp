@@ -31,12 +31,15 @@
  *
  ****************************************************************************/
 
+#include <px4_config.h>
 #include <stdint.h>
 #include <string.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <poll.h>
+#include <sched.h>
 #include <systemlib/px4_macros.h>
+#include <systemlib/perf_counter.h>
 
 #ifdef __PX4_NUTTX
 #define FILE_FLAGS(filp) filp->f_oflags
@@ -69,6 +72,32 @@
 
 using namespace device;
 
+/* every Nth publication of a topic with the integrity check enabled is
+ * stamped with a CRC and verified on copy (see ORBIOCSETINTEGRITY) */
+#define ORB_INTEGRITY_SAMPLE_INTERVAL 16
+
+/* shared across all topics; allocated when the first topic enables the check */
+static perf_counter_t g_integrity_verify_perf = nullptr;
+static perf_counter_t g_integrity_error_perf = nullptr;
+
+/* self-contained CRC-32 (reflected 0xEDB88320), runs on both sides of the
+ * posix/NuttX split without platform CRC support */
+static uint32_t
+orb_crc32(const uint8_t *buf, size_t len)
+{
+	uint32_t crc = 0xffffffffu;
+
+	while (len--) {
+		crc ^= *buf++;
+
+		for (unsigned i = 0; i < 8; i++) {
+			crc = (crc >> 1) ^ (0xedb88320u & -(crc & 1));
+		}
+	}
+
+	return ~crc;
+}
+
 uORB::DeviceNode::SubscriberData *uORB::DeviceNode::filp_to_sd(device::file_t *filp)
 {
 #ifndef __PX4_NUTTX
@@ -88,11 +117,21 @@ uORB::DeviceNode::DeviceNode(const struct orb_metadata *meta, const char *name,
 	_data(nullptr),
 	_last_update(0),
 	_generation(0),
+	_sequence(0),
 	_priority((uint8_t)priority),
 	_published(false),
+	_data_borrowed(false),
 	_queue_size(queue_size),
 	_subscriber_count(0),
-	_publisher(0)
+	_change_filter_count(0),
+	_generation_last_changed(0),
+	_integrity_check(false),
+	_integrity_crc(0),
+	_integrity_generation(0),
+	_integrity_errors(0),
+	_publisher(0),
+	_advertiser(0),
+	_subscriber_list(nullptr)
 {
 	// enable debug() calls
 	//_debug_enabled = true;
@@ -119,6 +158,7 @@ uORB::DeviceNode::open(device::file_t *filp)
 
 		if (_publisher == 0) {
 			_publisher = px4_getpid();
+			_advertiser = _publisher;
 			ret = PX4_OK;
 
 		} else {
@@ -152,6 +192,11 @@ uORB::DeviceNode::open(device::file_t *filp)
 
 		memset(sd, 0, sizeof(*sd));
 
+#ifdef __PX4_NUTTX
+		/* remember the subscriber task for critical-delivery priority boosts */
+		sd->pid = px4_getpid();
+#endif
+
 		/* default to no pending update */
 		sd->generation = _generation;
 
@@ -167,6 +212,13 @@ uORB::DeviceNode::open(device::file_t *filp)
 		if (ret != PX4_OK) {
 			PX4_ERR("CDev::open failed");
 			delete sd;
+
+		} else {
+			/* enter the node's subscriber list ('uorb graph') */
+			lock();
+			sd->next = _subscriber_list;
+			_subscriber_list = sd;
+			unlock();
 		}
 
 		return ret;
@@ -191,6 +243,24 @@ uORB::DeviceNode::close(device::file_t *filp)
 				hrt_cancel(&sd->update_interval->update_call);
 			}
 
+			if (sd->change_filter()) {
+				ATOMIC_ENTER;
+				_change_filter_count--;
+				ATOMIC_LEAVE;
+			}
+
+			/* leave the node's subscriber list */
+			lock();
+
+			for (SubscriberData **entry = &_subscriber_list; *entry != nullptr; entry = &((*entry)->next)) {
+				if (*entry == sd) {
+					*entry = sd->next;
+					break;
+				}
+			}
+
+			unlock();
+
 			remove_internal_subscriber();
 			delete sd;
 			sd = nullptr;
@@ -210,35 +280,260 @@ uORB::DeviceNode::read(device::file_t *filp, char *buffer, size_t buflen)
 		return 0;
 	}
 
-	/* if the caller's buffer is the wrong size, that's an error */
+	/* if the caller's buffer is the wrong size, that's an error; a
+	 * multiple of the object size on a queued topic drains a batch */
 	if (buflen != _meta->o_size) {
+		if (_queue_size > 1 && !(_meta->o_flags & ORB_FLAG_SPSC)
+		    && buflen > _meta->o_size && (buflen % _meta->o_size) == 0) {
+			++sd->copy_count;
+			return read_batch(sd, buffer, buflen / _meta->o_size);
+		}
+
 		return -EIO;
 	}
 
+	/* copy accounting for the 'uorb graph' command */
+	++sd->copy_count;
+
+	if (_meta->o_flags & ORB_FLAG_SPSC) {
+		return read_lock_free(sd, buffer);
+	}
+
 	/*
-	 * Perform an atomic copy & state update
+	 * Seqlock copy-out: the reader never takes the node lock and thus never
+	 * blocks the publisher. The copy is validated against the sequence
+	 * counter that the writer holds odd while modifying the buffer; a torn
+	 * copy is simply retried. This has writer preference by construction,
+	 * so a low-priority subscriber cannot invert against a high-rate
+	 * publisher.
+	 *
+	 * An odd sequence can only be observed while a writer is making
+	 * progress on another CPU (or, on posix, from another thread); on
+	 * NuttX the writer runs in a critical section and cannot be preempted
+	 * mid-write.
 	 */
-	ATOMIC_ENTER;
+	unsigned gen;
+	unsigned sub_gen;
+	unsigned lost;
+	unsigned integrity_gen;
+	uint32_t integrity_crc;
+
+	for (;;) {
+		const unsigned seq = __atomic_load_n(&_sequence, __ATOMIC_ACQUIRE);
+
+		if (seq & 1) {
+			/* write in progress */
+			continue;
+		}
+
+		gen = __atomic_load_n(&_generation, __ATOMIC_ACQUIRE);
+		sub_gen = sd->generation;
+		lost = 0;
+		integrity_gen = _integrity_generation;
+		integrity_crc = _integrity_crc;
+
+		if (gen > sub_gen + _queue_size) {
+			/* Reader is too far behind: some messages are lost */
+			lost = gen - (sub_gen + _queue_size);
+			sub_gen = gen - _queue_size;
+		}
+
+		if (gen == sub_gen && sub_gen > 0) {
+			/* The subscriber already read the latest message, but nothing new was published yet.
+			 * Return the previous message
+			 */
+			--sub_gen;
+		}
+
+		/* if the caller doesn't want the data, don't give it to them */
+		if (nullptr != buffer) {
+			memcpy(buffer, _data + (_meta->o_size * (sub_gen % _queue_size)), _meta->o_size);
+		}
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if (__atomic_load_n(&_sequence, __ATOMIC_RELAXED) == seq) {
+			break;
+		}
+	}
+
+	/* the copy in hand is the write that ended with generation sub_gen + 1 */
+	if (_integrity_check && nullptr != buffer && integrity_gen != 0 && integrity_gen == sub_gen + 1) {
+		verify_integrity((const uint8_t *)buffer, integrity_crc);
+	}
+
+	_lost_messages += lost;
+
+	if (sub_gen < gen) {
+		++sub_gen;
+	}
+
+	sd->generation = sub_gen;
+
+	/* set priority */
+	sd->set_priority(_priority);
+
+	/*
+	 * Clear the flag that indicates that an update has been reported, as
+	 * we have just collected it.
+	 */
+	sd->set_update_reported(false);
+
+#ifdef __PX4_NUTTX
+	restore_priority(sd);
+#endif
+
+	return _meta->o_size;
+}
+
+ssize_t
+uORB::DeviceNode::read_batch(SubscriberData *sd, char *buffer, unsigned max_count)
+{
+	unsigned gen;
+	unsigned sub_gen;
+	unsigned lost;
+	unsigned count;
+
+	/* same seqlock scheme as the single-element copy in read(): a torn
+	 * batch is detected via the sequence counter and retried */
+	for (;;) {
+		const unsigned seq = __atomic_load_n(&_sequence, __ATOMIC_ACQUIRE);
+
+		if (seq & 1) {
+			/* write in progress */
+			continue;
+		}
+
+		gen = __atomic_load_n(&_generation, __ATOMIC_ACQUIRE);
+		sub_gen = sd->generation;
+		lost = 0;
+
+		if (gen > sub_gen + _queue_size) {
+			/* Reader is too far behind: some messages are lost */
+			lost = gen - (sub_gen + _queue_size);
+			sub_gen = gen - _queue_size;
+		}
+
+		count = gen - sub_gen;
+
+		if (count > max_count) {
+			count = max_count;
+		}
 
-	if (_generation > sd->generation + _queue_size) {
+		/* the queue entries are shared between all subscribers and only
+		 * written once at publication; each subscriber drains them
+		 * oldest first through its own generation */
+		for (unsigned i = 0; i < count; i++) {
+			memcpy(buffer + (size_t)i * _meta->o_size,
+			       _data + (_meta->o_size * ((sub_gen + i) % _queue_size)),
+			       _meta->o_size);
+		}
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if (__atomic_load_n(&_sequence, __ATOMIC_RELAXED) == seq) {
+			break;
+		}
+	}
+
+	_lost_messages += lost;
+	sd->generation = sub_gen + count;
+
+	/* set priority */
+	sd->set_priority(_priority);
+
+	if (sd->generation == gen) {
+		/* fully drained: no update is pending anymore */
+		sd->set_update_reported(false);
+	}
+
+#ifdef __PX4_NUTTX
+	restore_priority(sd);
+#endif
+
+	return (ssize_t)count * _meta->o_size;
+}
+
+#ifdef __PX4_NUTTX
+void
+uORB::DeviceNode::restore_priority(SubscriberData *sd)
+{
+	if (sd->boosted) {
+		struct sched_param param;
+		param.sched_priority = sd->saved_priority;
+		sd->boosted = false;
+		sched_setparam(0, &param);
+	}
+}
+#endif
+
+/*
+ * Verify a copied-out sampled publication against the CRC stamped at publish
+ * time. A mismatch means the payload was corrupted between the publisher's
+ * buffer and this copy.
+ */
+void
+uORB::DeviceNode::verify_integrity(const uint8_t *buffer, uint32_t expected_crc)
+{
+	perf_count(g_integrity_verify_perf);
+
+	if (orb_crc32(buffer, _meta->o_size) != expected_crc) {
+		perf_count(g_integrity_error_perf);
+
+		if (++_integrity_errors <= 3) {
+			PX4_ERR("%s: payload CRC mismatch (%u errors)", _meta->o_name, _integrity_errors);
+		}
+	}
+}
+
+ssize_t
+uORB::DeviceNode::read_lock_free(SubscriberData *sd, char *buffer)
+{
+	/*
+	 * Lock-free copy for single-publisher topics (ORB_FLAG_SPSC): instead of
+	 * entering a critical section we validate the copy against the atomic
+	 * generation counter and retry if the publisher lapped us while copying.
+	 */
+	unsigned gen = __atomic_load_n(&_generation, __ATOMIC_ACQUIRE);
+
+	if (gen > sd->generation + _queue_size) {
 		/* Reader is too far behind: some messages are lost */
-		_lost_messages += _generation - (sd->generation + _queue_size);
-		sd->generation = _generation - _queue_size;
+		_lost_messages += gen - (sd->generation + _queue_size);
+		sd->generation = gen - _queue_size;
 	}
 
-	if (_generation == sd->generation && sd->generation > 0) {
+	if (gen == sd->generation && sd->generation > 0) {
 		/* The subscriber already read the latest message, but nothing new was published yet.
 		 * Return the previous message
 		 */
 		--sd->generation;
 	}
 
-	/* if the caller doesn't want the data, don't give it to them */
 	if (nullptr != buffer) {
-		memcpy(buffer, _data + (_meta->o_size * (sd->generation % _queue_size)), _meta->o_size);
+		for (;;) {
+			memcpy(buffer, _data + (_meta->o_size * (sd->generation % _queue_size)), _meta->o_size);
+
+			/* re-check the generation after the copy: if the publisher
+			 * overwrote our slot in the meantime, the copy may be torn */
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			unsigned check = __atomic_load_n(&_generation, __ATOMIC_ACQUIRE);
+
+			if (check < sd->generation + _queue_size) {
+				break;
+			}
+
+			/* the publisher lapped us: retry with the newest complete message */
+			_lost_messages += check - 1 - sd->generation;
+			sd->generation = check - 1;
+		}
+
+		/* the copy in hand is the write that ended with generation + 1 */
+		if (_integrity_check && _integrity_generation == sd->generation + 1) {
+			verify_integrity((const uint8_t *)buffer, _integrity_crc);
+		}
 	}
 
-	if (sd->generation < _generation) {
+	if (sd->generation < gen) {
 		++sd->generation;
 	}
 
@@ -251,12 +546,14 @@ uORB::DeviceNode::read(device::file_t *filp, char *buffer, size_t buflen)
 	 */
 	sd->set_update_reported(false);
 
-	ATOMIC_LEAVE;
+#ifdef __PX4_NUTTX
+	restore_priority(sd);
+#endif
 
 	return _meta->o_size;
 }
 
-ssize_t
+PX4_HOT_RAMFUNC ssize_t
 uORB::DeviceNode::write(device::file_t *filp, const char *buffer, size_t buflen)
 {
 	/*
@@ -305,8 +602,73 @@ uORB::DeviceNode::write(device::file_t *filp, const char *buffer, size_t buflen)
 		return -EIO;
 	}
 
+	if (_meta->o_flags & ORB_FLAG_SPSC) {
+		/*
+		 * Single-publisher lock-free path: write the slot first, then make it
+		 * visible with a release store of the generation counter. The publisher
+		 * never takes the node lock and thus never blocks on readers.
+		 */
+		unsigned gen = _generation;
+
+		/* sampled integrity check: stamp every Nth publication before it
+		 * becomes visible */
+		if (_integrity_check && ((gen + 1) % ORB_INTEGRITY_SAMPLE_INTERVAL == 0)) {
+			_integrity_crc = orb_crc32((const uint8_t *)buffer, _meta->o_size);
+			_integrity_generation = gen + 1;
+		}
+
+		memcpy(_data + (_meta->o_size * (gen % _queue_size)), buffer, _meta->o_size);
+		_last_update = hrt_absolute_time();
+		_published = true;
+		/* the lock-free path skips change detection, every publication counts as changed */
+		_generation_last_changed = gen + 1;
+		__atomic_store_n(&_generation, gen + 1, __ATOMIC_RELEASE);
+
+		/* notify any poll waiters */
+		poll_notify(POLLIN);
+
+		return _meta->o_size;
+	}
+
+	/* The CRC pass runs outside the atomic section on the caller's buffer;
+	 * a stale generation read merely shifts the sampling phase. */
+	const bool integrity_sample = _integrity_check
+				      && ((_generation + 1) % ORB_INTEGRITY_SAMPLE_INTERVAL == 0);
+	uint32_t integrity_crc = 0;
+
+	if (integrity_sample) {
+		integrity_crc = orb_crc32((const uint8_t *)buffer, _meta->o_size);
+	}
+
 	/* Perform an atomic copy. */
 	ATOMIC_ENTER;
+
+	/*
+	 * If any subscriber has the change filter enabled, compare the new sample
+	 * against the one it replaces before overwriting it. The leading 8 bytes
+	 * are skipped: by convention the first field of a topic is its uint64
+	 * timestamp, which differs on every publication.
+	 */
+	bool changed = true;
+
+	if (_change_filter_count > 0 && _published && _queue_size == 1 && _meta->o_size > sizeof(uint64_t)) {
+		changed = memcmp(_data + sizeof(uint64_t), buffer + sizeof(uint64_t),
+				 _meta->o_size - sizeof(uint64_t)) != 0;
+	}
+
+	/* sampled integrity check: stamp every Nth publication. The CRC was
+	 * computed over the caller's buffer before entering the critical
+	 * section, so the irq-off window stays short. */
+	if (integrity_sample) {
+		_integrity_crc = integrity_crc;
+		_integrity_generation = _generation + 1;
+	}
+
+	/* seqlock writer section: hold the sequence odd while the buffer is
+	 * inconsistent so lock-free readers retry instead of copying torn data */
+	_sequence++;
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
 	memcpy(_data + (_meta->o_size * (_generation % _queue_size)), buffer, _meta->o_size);
 
 	/* update the timestamp and generation count */
@@ -314,8 +676,14 @@ uORB::DeviceNode::write(device::file_t *filp, const char *buffer, size_t buflen)
 	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
 	_generation++;
 
+	if (changed) {
+		_generation_last_changed = _generation;
+	}
+
 	_published = true;
 
+	__atomic_store_n(&_sequence, _sequence + 1, __ATOMIC_RELEASE);
+
 	ATOMIC_LEAVE;
 
 	/* notify any poll waiters */
@@ -384,6 +752,39 @@ uORB::DeviceNode::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 			return ret;
 		}
 
+	case ORBIOCSETCHANGEFILTER: {
+			bool enable = (arg != 0);
+
+			ATOMIC_ENTER;
+
+			if (enable != sd->change_filter()) {
+				if (enable) {
+					_change_filter_count++;
+
+				} else {
+					_change_filter_count--;
+				}
+
+				sd->set_change_filter(enable);
+			}
+
+			ATOMIC_LEAVE;
+			return PX4_OK;
+		}
+
+	case ORBIOCSETINTEGRITY: {
+			if (arg != 0 && g_integrity_verify_perf == nullptr) {
+				g_integrity_verify_perf = perf_alloc(PC_COUNT, "uorb_crc_check");
+				g_integrity_error_perf = perf_alloc(PC_COUNT, "uorb_crc_err");
+			}
+
+			ATOMIC_ENTER;
+			_integrity_check = (arg != 0);
+			_integrity_generation = 0;
+			ATOMIC_LEAVE;
+			return PX4_OK;
+		}
+
 	case ORBIOCGADVERTISER:
 		*(uintptr_t *)arg = (uintptr_t)this;
 		return PX4_OK;
@@ -413,7 +814,7 @@ uORB::DeviceNode::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 	}
 }
 
-ssize_t
+PX4_HOT_RAMFUNC ssize_t
 uORB::DeviceNode::publish(const orb_metadata *meta, orb_advert_t handle, const void *data)
 {
 	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
@@ -460,6 +861,99 @@ uORB::DeviceNode::publish(const orb_metadata *meta, orb_advert_t handle, const v
 	return PX4_OK;
 }
 
+void *
+uORB::DeviceNode::publish_borrow()
+{
+	/* queued topics need the copy path to preserve ordering for slow readers */
+	if (_queue_size > 1) {
+		return nullptr;
+	}
+
+	/* allocation is only possible from thread context, same as in write() */
+	if (nullptr == _data) {
+#ifdef __PX4_NUTTX
+
+		if (up_interrupt_context()) {
+			return nullptr;
+		}
+
+#endif
+		lock();
+
+		/* re-check size */
+		if (nullptr == _data) {
+			_data = new uint8_t[_meta->o_size * _queue_size];
+		}
+
+		unlock();
+
+		if (nullptr == _data) {
+			return nullptr;
+		}
+	}
+
+	ATOMIC_ENTER;
+	_data_borrowed = true;
+	ATOMIC_LEAVE;
+
+	return _data;
+}
+
+int
+uORB::DeviceNode::publish_commit()
+{
+	if (!_data_borrowed) {
+		return -EINVAL;
+	}
+
+	ATOMIC_ENTER;
+
+	/* update the timestamp and generation count */
+	_last_update = hrt_absolute_time();
+	_generation++;
+
+	/* the data was written in place, there is no previous sample to compare against */
+	_generation_last_changed = _generation;
+
+	_published = true;
+	_data_borrowed = false;
+
+	ATOMIC_LEAVE;
+
+	/* notify any poll waiters */
+	poll_notify(POLLIN);
+
+	/* forward over the Multi-ORB link, same as in publish() */
+	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
+
+	if (ch != nullptr) {
+		ch->send_message(_meta->o_name, _meta->o_size, _data);
+	}
+
+	return PX4_OK;
+}
+
+const void *
+uORB::DeviceNode::peek(unsigned *generation)
+{
+	if (_data == nullptr || !_published || _queue_size > 1) {
+		return nullptr;
+	}
+
+	if (generation) {
+		*generation = _generation;
+	}
+
+	return _data;
+}
+
+bool
+uORB::DeviceNode::peek_valid(unsigned generation) const
+{
+	/* a borrowed slot means a publisher may be writing in place right now */
+	return !_data_borrowed && (_generation == generation);
+}
+
 int uORB::DeviceNode::unadvertise(orb_advert_t handle)
 {
 	if (handle == nullptr) {
@@ -530,6 +1024,30 @@ uORB::DeviceNode::poll_notify_one(px4_pollfd_struct_t *fds, pollevent_t events)
 	 * If the topic looks updated to the subscriber, go ahead and notify them.
 	 */
 	if (appears_updated(sd)) {
+#ifdef __PX4_NUTTX
+
+		/*
+		 * Critical topics: boost a lower-priority subscriber to the
+		 * publisher's priority before waking it, so the update is acted
+		 * on immediately instead of queueing behind whatever else is
+		 * runnable. The boost is undone when the subscriber collects
+		 * the update in read().
+		 */
+		if ((_meta->o_flags & ORB_FLAG_CRITICAL) && !up_interrupt_context() && !sd->boosted) {
+			struct sched_param pub_param;
+			struct sched_param sub_param;
+
+			if (sched_getparam(0, &pub_param) == 0 &&
+			    sched_getparam(sd->pid, &sub_param) == 0 &&
+			    sub_param.sched_priority < pub_param.sched_priority) {
+				sd->saved_priority = sub_param.sched_priority;
+				sd->boosted = true;
+				sub_param.sched_priority = pub_param.sched_priority;
+				sched_setparam(sd->pid, &sub_param);
+			}
+		}
+
+#endif
 		CDev::poll_notify_one(fds, events);
 	}
 }
@@ -557,6 +1075,27 @@ uORB::DeviceNode::appears_updated(SubscriberData *sd)
 	 */
 	while (sd->generation != _generation) {
 
+		/*
+		 * Critical topics preempt the batching filters below: every
+		 * publication is visible immediately, regardless of the change
+		 * filter or a configured update interval.
+		 */
+		if (_meta->o_flags & ORB_FLAG_CRITICAL) {
+			ret = true;
+			break;
+		}
+
+		/*
+		 * With the change filter enabled, only publications that changed the
+		 * payload count as updates. If the last change is at least as old as
+		 * everything the subscriber has already seen, there is nothing new.
+		 * The subtractions keep the comparison wrap-safe.
+		 */
+		if (sd->change_filter() &&
+		    (unsigned)(_generation - _generation_last_changed) >= (unsigned)(_generation - sd->generation)) {
+			break;
+		}
+
 		/*
 		 * Handle non-rate-limited subscribers.
 		 */
@@ -640,6 +1179,27 @@ uORB::DeviceNode::appears_updated(SubscriberData *sd)
 	 */
 	while (sd->generation != _generation) {
 
+		/*
+		 * Critical topics preempt the batching filters below: every
+		 * publication is visible immediately, regardless of the change
+		 * filter or a configured update interval.
+		 */
+		if (_meta->o_flags & ORB_FLAG_CRITICAL) {
+			ret = true;
+			break;
+		}
+
+		/*
+		 * With the change filter enabled, only publications that changed the
+		 * payload count as updates. If the last change is at least as old as
+		 * everything the subscriber has already seen, there is nothing new.
+		 * The subtractions keep the comparison wrap-safe.
+		 */
+		if (sd->change_filter() &&
+		    (unsigned)(_generation - _generation_last_changed) >= (unsigned)(_generation - sd->generation)) {
+			break;
+		}
+
 		/*
 		 * Handle non-rate-limited subscribers.
 		 */
@@ -719,6 +1279,24 @@ uORB::DeviceNode::print_statistics(bool reset)
 	return true;
 }
 
+void
+uORB::DeviceNode::print_subscribers()
+{
+	lock();
+
+	for (SubscriberData *sd = _subscriber_list; sd != nullptr; sd = sd->next) {
+		unsigned interval = sd->update_interval ? sd->update_interval->interval : 0;
+#ifdef __PX4_NUTTX
+		int pid = (int)sd->pid;
+#else
+		int pid = -1; /* not tracked on posix */
+#endif
+		printf("sub: %s %i %u %u\n", _meta->o_name, pid, interval, sd->copy_count);
+	}
+
+	unlock();
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 void uORB::DeviceNode::add_internal_subscriber()
@@ -893,7 +1471,7 @@ uORB::DeviceMaster::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 				objname = meta->o_name; //no need for a copy, meta->o_name will never be freed or changed
 
 				/* driver wants a permanent copy of the path, so make one here */
-				devpath = strdup(nodepath);
+				devpath = Pool::strdup(nodepath);
 
 				if (devpath == nullptr) {
 					return -ENOMEM;
@@ -904,7 +1482,7 @@ uORB::DeviceMaster::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 
 				/* if we didn't get a device, that's bad */
 				if (node == nullptr) {
-					free((void *)devpath);
+					Pool::release((void *)devpath);
 					return -ENOMEM;
 				}
 
@@ -930,7 +1508,7 @@ uORB::DeviceMaster::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 					}
 
 					/* also discard the name now */
-					free((void *)devpath);
+					Pool::release((void *)devpath);
 
 				} else {
 					// add to the node map;.
@@ -1196,6 +1774,63 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 
 #undef CLEAR_LINE
 
+void uORB::DeviceMaster::showGraph(char **topic_filter, int num_filters)
+{
+	if (topic_filter && num_filters > 0 && !strcmp("-a", topic_filter[0])) {
+		num_filters = 0;
+	}
+
+	lock();
+
+	if (_node_map.empty()) {
+		unlock();
+		PX4_INFO("no active topics");
+		return;
+	}
+
+	DeviceNodeStatisticsData *first_node = nullptr;
+	size_t max_topic_name_length = 0;
+	int num_topics = 0;
+	addNewDeviceNodes(&first_node, num_topics, max_topic_name_length, topic_filter, num_filters);
+
+	/* a DeviceNode is never deleted, so it's save to unlock here and still access the DeviceNodes */
+	unlock();
+
+	/* sample the generation counters over one second to estimate rates */
+	hrt_abstime start_time = hrt_absolute_time();
+	usleep(1000 * 1000);
+	float dt = (hrt_absolute_time() - start_time) / 1.e6f;
+
+	printf("node: <name> <inst> <adv_pid> <subs> <qsize> <rate_hz> <pub_total> <lost_total>\n");
+	printf("sub: <name> <pid> <interval_us> <copies>\n");
+
+	DeviceNodeStatisticsData *cur_node = first_node;
+
+	while (cur_node) {
+		unsigned int num_msgs = cur_node->node->published_message_count();
+		int rate = (int)((num_msgs - cur_node->last_pub_msg_count) / dt + 0.5f);
+
+		printf("node: %s %i %i %i %i %i %u %u\n",
+		       cur_node->node->get_meta()->o_name, (int)cur_node->instance,
+		       cur_node->node->advertiser_pid(), (int)cur_node->node->subscriber_count(),
+		       cur_node->node->get_queue_size(), rate,
+		       num_msgs, (unsigned)cur_node->node->lost_message_count());
+
+		cur_node->node->print_subscribers();
+
+		cur_node = cur_node->next;
+	}
+
+	//cleanup
+	cur_node = first_node;
+
+	while (cur_node) {
+		DeviceNodeStatisticsData *next_node = cur_node->next;
+		delete cur_node;
+		cur_node = next_node;
+	}
+}
+
 uORB::DeviceNode *uORB::DeviceMaster::getDeviceNode(const char *nodepath)
 {
 	lock();
@@ -41,6 +41,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "ORBMap.hpp"
+#include "uORBPool.hpp"
 
 #else
 
@@ -66,6 +67,10 @@ public:
 		   int priority, unsigned int queue_size = 1);
 	~DeviceNode();
 
+	/* nodes come from the uORB pool instead of the heap */
+	void *operator new(size_t size) { return Pool::allocate(size); }
+	void operator delete(void *p) { Pool::release(p); }
+
 	/**
 	 * Method to create a subscriber instance and return the struct
 	 * pointing to the subscriber as a file pointer.
@@ -114,6 +119,41 @@ public:
 	 */
 	static ssize_t    publish(const orb_metadata *meta, orb_advert_t handle, const void *data);
 
+	/**
+	 * Borrow the next write slot from the node for in-place construction of a
+	 * message, avoiding the publisher-side memcpy for large topics.
+	 * Only supported for non-queued topics (queue size 1); for queued topics
+	 * nullptr is returned and the caller must fall back to orb_publish().
+	 * The slot stays owned by the publisher until publish_commit() is called.
+	 * @return pointer to a writable buffer of o_size bytes, or nullptr
+	 */
+	void *publish_borrow();
+
+	/**
+	 * Commit a message previously written into a slot obtained from
+	 * publish_borrow(). This updates the timestamp and generation count and
+	 * notifies any poll waiters, equivalent to a regular publication.
+	 * @return PX4_OK on success, -EINVAL if no slot was borrowed
+	 */
+	int publish_commit();
+
+	/**
+	 * Get a const view onto the latest published message without copying it out.
+	 * The returned pointer is only guaranteed to contain a consistent message
+	 * as long as peek_valid() returns true for the returned generation; a
+	 * publisher writing in place invalidates it.
+	 * @param generation set to the generation of the returned message
+	 * @return pointer to the message, or nullptr if nothing was published yet
+	 */
+	const void *peek(unsigned *generation);
+
+	/**
+	 * Check whether a message obtained via peek() is still valid, i.e. no
+	 * publication or in-place write happened since.
+	 * @param generation the generation returned by peek()
+	 */
+	bool peek_valid(unsigned generation) const;
+
 	static int        unadvertise(orb_advert_t handle);
 
 	static int16_t topic_advertised(const orb_metadata *meta, int priority);
@@ -184,6 +224,13 @@ public:
 	uint32_t lost_message_count() const { return _lost_messages; }
 	unsigned int published_message_count() const { return _generation; }
 	const struct orb_metadata *get_meta() const { return _meta; }
+	int advertiser_pid() const { return (int)_advertiser; }
+
+	/**
+	 * Print one 'sub:' line per subscriber (task id, configured interval and
+	 * copy count) for the 'uorb graph' command.
+	 */
+	void print_subscribers();
 
 protected:
 	virtual pollevent_t poll_state(device::file_t *filp);
@@ -191,6 +238,9 @@ protected:
 
 private:
 	struct UpdateIntervalData {
+		void *operator new(size_t size) { return Pool::allocate(size); }
+		void operator delete(void *p) { Pool::release(p); }
+
 		unsigned  interval; /**< if nonzero minimum interval between updates */
 		struct hrt_call update_call;  /**< deferred wakeup call if update_period is nonzero */
 #ifndef __PX4_NUTTX
@@ -200,40 +250,98 @@ private:
 	struct SubscriberData {
 		~SubscriberData() { if (update_interval) { delete (update_interval); } }
 
+		void *operator new(size_t size) { return Pool::allocate(size); }
+		void operator delete(void *p) { Pool::release(p); }
+
 		unsigned  generation; /**< last generation the subscriber has seen */
-		int   flags; /**< lowest 8 bits: priority of publisher, 9. bit: update_reported bit */
+		int   flags; /**< lowest 8 bits: priority of publisher, 9. bit: update_reported bit, 10. bit: change filter */
 		UpdateIntervalData *update_interval; /**< if null, no update interval */
 
+		/*
+		 * The flags word is modified from both the subscriber context
+		 * (read, ioctl) and the publisher context (poll_notify_one),
+		 * and the seqlock read path runs without the node lock, so all
+		 * modifications must be atomic read-modify-writes.
+		 */
 		int priority() const { return flags & 0xff; }
-		void set_priority(uint8_t prio) { flags = (flags & ~0xff) | prio; }
+		void set_priority(uint8_t prio)
+		{
+			__atomic_fetch_and(&flags, ~0xff, __ATOMIC_RELAXED);
+			__atomic_fetch_or(&flags, prio, __ATOMIC_RELAXED);
+		}
 
 		bool update_reported() const { return flags & (1 << 8); }
-		void set_update_reported(bool update_reported_flag) { flags = (flags & ~(1 << 8)) | (((int)update_reported_flag) << 8); }
+		void set_update_reported(bool update_reported_flag)
+		{
+			if (update_reported_flag) {
+				__atomic_fetch_or(&flags, 1 << 8, __ATOMIC_RELAXED);
+
+			} else {
+				__atomic_fetch_and(&flags, ~(1 << 8), __ATOMIC_RELAXED);
+			}
+		}
+
+		bool change_filter() const { return flags & (1 << 9); }
+		void set_change_filter(bool enable)
+		{
+			if (enable) {
+				__atomic_fetch_or(&flags, 1 << 9, __ATOMIC_RELAXED);
+
+			} else {
+				__atomic_fetch_and(&flags, ~(1 << 9), __ATOMIC_RELAXED);
+			}
+		}
+
+#ifdef __PX4_NUTTX
+		pid_t pid; /**< subscriber task, target of critical-delivery priority boosts */
+		uint8_t saved_priority; /**< priority to restore once a boosted update is collected */
+		bool boosted; /**< subscriber currently runs with a boosted priority */
+#endif
+
+		SubscriberData *next; /**< next entry in the node's subscriber list ('uorb graph') */
+		unsigned copy_count; /**< number of copy-outs done for this subscriber ('uorb graph') */
 	};
 
 	const struct orb_metadata *_meta; /**< object metadata information */
 	uint8_t     *_data;   /**< allocated object buffer */
 	hrt_abstime   _last_update; /**< time the object was last updated */
 	volatile unsigned   _generation;  /**< object generation count */
+	volatile unsigned   _sequence;  /**< seqlock: odd while a write is in progress, readers retry instead of blocking */
 	const uint8_t   _priority;  /**< priority of the topic */
 	bool _published;  /**< has ever data been published */
+	bool _data_borrowed; /**< true while a publisher owns a slot from publish_borrow() */
 	uint8_t _queue_size; /**< maximum number of elements in the queue */
 	int16_t _subscriber_count;
+	int16_t _change_filter_count; /**< number of subscribers with the change filter enabled */
+	unsigned _generation_last_changed; /**< generation of the most recent publication that changed the payload */
+	bool _integrity_check; /**< stamp and verify a CRC on sampled publications (ORBIOCSETINTEGRITY) */
+	uint32_t _integrity_crc; /**< CRC of the sampled publication */
+	unsigned _integrity_generation; /**< generation the sampled CRC belongs to, 0 = none yet */
+	uint32_t _integrity_errors; /**< CRC mismatches observed on copies of this topic */
 
 	inline static SubscriberData    *filp_to_sd(device::file_t *filp);
 
 #ifdef __PX4_NUTTX
 	pid_t     _publisher; /**< if nonzero, current publisher. Only used inside the advertise call.
 					We allow one publisher to have an open file descriptor at the same time. */
+	pid_t     _advertiser; /**< task that last advertised this node, kept for 'uorb graph' */
 #else
 	px4_task_t     _publisher; /**< if nonzero, current publisher. Only used inside the advertise call.
 					We allow one publisher to have an open file descriptor at the same time. */
+	px4_task_t     _advertiser; /**< task that last advertised this node, kept for 'uorb graph' */
 #endif
 
+	SubscriberData  *_subscriber_list; /**< all open subscribers of this node ('uorb graph') */
+
 	//statistics
 	uint32_t _lost_messages = 0; ///< nr of lost messages for all subscribers. If two subscribers lose the same
 	///message, it is counted as two.
 
+	/**
+	 * Verify a copied-out sampled publication against the stamped CRC.
+	 */
+	void      verify_integrity(const uint8_t *buffer, uint32_t expected_crc);
+
 	/**
 	 * Perform a deferred update for a rate-limited subscriber.
 	 */
@@ -246,6 +354,45 @@ private:
 	 */
 	static void   update_deferred_trampoline(void *arg);
 
+	/**
+	 * Copy the latest message to a subscriber without taking the node lock.
+	 *
+	 * Only used for single-publisher topics (ORB_FLAG_SPSC); the copy is
+	 * validated against the atomic generation counter and retried if the
+	 * publisher overwrote the slot while we were copying.
+	 *
+	 * @param sd      The subscriber to copy for.
+	 * @param buffer  Destination buffer, may be nullptr.
+	 * @return        The number of bytes copied.
+	 */
+	ssize_t read_lock_free(SubscriberData *sd, char *buffer);
+
+	/**
+	 * Drain up to max_count pending queue entries in one call.
+	 *
+	 * Only used for queued topics; the entries are copied oldest first
+	 * out of the shared ring in a single seqlock pass, so a deep queue
+	 * costs one validation instead of one call per element.
+	 *
+	 * @param sd        The subscriber to copy for.
+	 * @param buffer    Destination buffer for max_count entries.
+	 * @param max_count Capacity of the buffer in entries.
+	 * @return          The number of bytes copied.
+	 */
+	ssize_t read_batch(SubscriberData *sd, char *buffer, unsigned max_count);
+
+#ifdef __PX4_NUTTX
+	/**
+	 * Undo a critical-delivery priority boost.
+	 *
+	 * Called from the subscriber context once the update has been
+	 * collected; no-op if the subscriber is not currently boosted.
+	 *
+	 * @param sd    The subscriber that collected the update.
+	 */
+	void      restore_priority(SubscriberData *sd);
+#endif
+
 	/**
 	 * Check whether a topic appears updated to a subscriber.
 	 *
@@ -294,6 +441,16 @@ public:
 	 */
 	void showTop(char **topic_filter, int num_filters);
 
+	/**
+	 * Print the pub/sub graph in machine-readable form: one 'node:' line per
+	 * topic instance (advertiser, queue depth, publish rate, lost messages)
+	 * followed by one 'sub:' line per subscriber with its interval and copy
+	 * count. Rates are estimated over a one second sampling window.
+	 * @param topic_filter list of topic filters: if set, each string can be a substring for topics to match.
+	 * @param num_filters
+	 */
+	void showGraph(char **topic_filter, int num_filters);
+
 private:
 	// Private constructor, uORB::Manager takes care of its creation
 	DeviceMaster(Flavor f);
@@ -78,6 +78,8 @@ $ uorb top
 	PRINT_MODULE_USAGE_COMMAND_DESCR("top", "Monitor topic publication rates");
 	PRINT_MODULE_USAGE_PARAM_FLAG('a', "print all instead of only currently publishing topics", true);
 	PRINT_MODULE_USAGE_ARG("<filter1> [<filter2>]", "topic(s) to match (implies -a)", true);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("graph", "Print the pub/sub graph (advertisers, subscribers, rates) machine-readable");
+	PRINT_MODULE_USAGE_ARG("<filter1> [<filter2>]", "topic(s) to match", true);
 }
 
 int
@@ -146,6 +148,17 @@ uorb_main(int argc, char *argv[])
 		return OK;
 	}
 
+	if (!strcmp(argv[1], "graph")) {
+		if (g_dev != nullptr) {
+			g_dev->showGraph(argv + 2, argc - 2);
+
+		} else {
+			PX4_INFO("uorb is not running");
+		}
+
+		return OK;
+	}
+
 	usage();
 	return -EINVAL;
 }
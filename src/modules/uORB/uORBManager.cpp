@@ -204,6 +204,9 @@ orb_advert_t uORB::Manager::orb_advertise_multi(const struct orb_metadata *meta,
 	//For remote systems call over and inform them
 	uORB::DeviceNode::topic_advertised(meta, priority);
 
+	/* wake up any advertisement watches on this topic family */
+	notify_advertisement(meta);
+
 	/* the advertiser must perform an initial publish to initialise the object */
 	result = orb_publish(meta, advertiser, data);
 
@@ -215,6 +218,64 @@ orb_advert_t uORB::Manager::orb_advertise_multi(const struct orb_metadata *meta,
 	return advertiser;
 }
 
+int uORB::Manager::orb_watch_advertisements(const struct orb_metadata *meta)
+{
+	if (meta == nullptr) {
+		return ERROR;
+	}
+
+	for (int i = 0; i < MAX_ADVERT_WATCHES; i++) {
+		/* claim a free slot; the atomic exchange arbitrates between tasks
+		 * registering concurrently */
+		if (!__atomic_exchange_n(&_advert_watches[i].used, true, __ATOMIC_ACQUIRE)) {
+			_advert_watches[i].meta = meta;
+			_advert_watches[i].seen = 0;
+			/* start at 1 so the first changed-query reports true and
+			 * triggers the watcher's initial scan */
+			__atomic_store_n(&_advert_watches[i].advertisements, 1, __ATOMIC_RELEASE);
+			return i;
+		}
+	}
+
+	return ERROR;
+}
+
+int uORB::Manager::orb_unwatch_advertisements(int watch)
+{
+	if (watch < 0 || watch >= MAX_ADVERT_WATCHES || !_advert_watches[watch].used) {
+		return ERROR;
+	}
+
+	_advert_watches[watch].meta = nullptr;
+	__atomic_store_n(&_advert_watches[watch].used, false, __ATOMIC_RELEASE);
+	return OK;
+}
+
+bool uORB::Manager::orb_advertisements_changed(int watch)
+{
+	if (watch < 0 || watch >= MAX_ADVERT_WATCHES || !_advert_watches[watch].used) {
+		return false;
+	}
+
+	unsigned advertisements = __atomic_load_n(&_advert_watches[watch].advertisements, __ATOMIC_ACQUIRE);
+
+	if (advertisements == _advert_watches[watch].seen) {
+		return false;
+	}
+
+	_advert_watches[watch].seen = advertisements;
+	return true;
+}
+
+void uORB::Manager::notify_advertisement(const struct orb_metadata *meta)
+{
+	for (int i = 0; i < MAX_ADVERT_WATCHES; i++) {
+		if (_advert_watches[i].used && _advert_watches[i].meta == meta) {
+			__atomic_fetch_add(&_advert_watches[i].advertisements, 1, __ATOMIC_RELEASE);
+		}
+	}
+}
+
 int uORB::Manager::orb_unadvertise(orb_advert_t handle)
 {
 #ifdef ORB_USE_PUBLISHER_RULES
@@ -257,6 +318,81 @@ int uORB::Manager::orb_publish(const struct orb_metadata *meta, orb_advert_t han
 	return uORB::DeviceNode::publish(meta, handle, data);
 }
 
+void *uORB::Manager::orb_publish_borrow(const struct orb_metadata *meta, orb_advert_t handle)
+{
+#ifdef ORB_USE_PUBLISHER_RULES
+
+	if (handle == _Instance) {
+		errno = EPERM;
+		return nullptr;
+	}
+
+#endif /* ORB_USE_PUBLISHER_RULES */
+
+	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
+
+	if ((devnode == nullptr) || (meta == nullptr)) {
+		errno = EFAULT;
+		return nullptr;
+	}
+
+	if (devnode->get_meta() != meta) {
+		errno = EINVAL;
+		return nullptr;
+	}
+
+	return devnode->publish_borrow();
+}
+
+int uORB::Manager::orb_publish_commit(const struct orb_metadata *meta, orb_advert_t handle)
+{
+#ifdef ORB_USE_PUBLISHER_RULES
+
+	if (handle == _Instance) {
+		return PX4_OK; //pretend success
+	}
+
+#endif /* ORB_USE_PUBLISHER_RULES */
+
+	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
+
+	if ((devnode == nullptr) || (meta == nullptr) || (devnode->get_meta() != meta)) {
+		errno = EINVAL;
+		return ERROR;
+	}
+
+	int ret = devnode->publish_commit();
+
+	if (ret != PX4_OK) {
+		errno = -ret;
+		return ERROR;
+	}
+
+	return PX4_OK;
+}
+
+const void *uORB::Manager::orb_peek(int handle, unsigned *generation)
+{
+	uintptr_t node = 0;
+
+	if (px4_ioctl(handle, ORBIOCGADVERTISER, (unsigned long)&node) != PX4_OK) {
+		return nullptr;
+	}
+
+	return ((uORB::DeviceNode *)node)->peek(generation);
+}
+
+bool uORB::Manager::orb_peek_valid(int handle, unsigned generation)
+{
+	uintptr_t node = 0;
+
+	if (px4_ioctl(handle, ORBIOCGADVERTISER, (unsigned long)&node) != PX4_OK) {
+		return false;
+	}
+
+	return ((uORB::DeviceNode *)node)->peek_valid(generation);
+}
+
 int uORB::Manager::orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
 {
 	int ret;
@@ -282,6 +418,71 @@ int uORB::Manager::orb_check(int handle, bool *updated)
 	return px4_ioctl(handle, ORBIOCUPDATED, (unsigned long)(uintptr_t)updated);
 }
 
+int uORB::Manager::orb_check_multi(const int *handles, unsigned count, uint32_t *updated)
+{
+	*updated = 0;
+
+	if (count > 32) {
+		errno = EINVAL;
+		return ERROR;
+	}
+
+	int ret = PX4_OK;
+
+	for (unsigned i = 0; i < count; i++) {
+		bool one_updated = false;
+
+		if (px4_ioctl(handles[i], ORBIOCUPDATED, (unsigned long)(uintptr_t)&one_updated) != PX4_OK) {
+			ret = ERROR;
+
+		} else if (one_updated) {
+			*updated |= 1u << i;
+		}
+	}
+
+	return ret;
+}
+
+int uORB::Manager::orb_copy_multi(const struct orb_metadata **metas, const int *handles, void **buffers,
+				  unsigned count, uint32_t *updated)
+{
+	if (count > 32) {
+		errno = EINVAL;
+		return ERROR;
+	}
+
+	int ret = PX4_OK;
+
+	for (unsigned i = 0; i < count; i++) {
+		if (!(*updated & (1u << i))) {
+			continue;
+		}
+
+		if (orb_copy(metas[i], handles[i], buffers[i]) != PX4_OK) {
+			*updated &= ~(1u << i);
+			ret = ERROR;
+		}
+	}
+
+	return ret;
+}
+
+int uORB::Manager::orb_copy_batch(const struct orb_metadata *meta, int handle, void *buffer, unsigned max_count)
+{
+	if (max_count < 1) {
+		errno = EINVAL;
+		return ERROR;
+	}
+
+	int ret = px4_read(handle, buffer, max_count * meta->o_size);
+
+	if (ret < 0) {
+		return ERROR;
+	}
+
+	return ret / (int)meta->o_size;
+}
+
 int uORB::Manager::orb_stat(int handle, uint64_t *time)
 {
 	return px4_ioctl(handle, ORBIOCLASTUPDATE, (unsigned long)(uintptr_t)time);
@@ -292,6 +493,18 @@ int uORB::Manager::orb_priority(int handle, int32_t *priority)
 	return px4_ioctl(handle, ORBIOCGPRIORITY, (unsigned long)(uintptr_t)priority);
 }
 
+int uORB::Manager::orb_subscriber_count(orb_advert_t handle)
+{
+	uORB::DeviceNode *devnode = (uORB::DeviceNode *)handle;
+
+	if (devnode == nullptr) {
+		errno = EFAULT;
+		return ERROR;
+	}
+
+	return devnode->subscriber_count();
+}
+
 int uORB::Manager::orb_set_interval(int handle, unsigned interval)
 {
 	return px4_ioctl(handle, ORBIOCSETINTERVAL, interval * 1000);
@@ -305,6 +518,16 @@ int uORB::Manager::orb_get_interval(int handle, unsigned *interval)
 	return ret;
 }
 
+int uORB::Manager::orb_set_change_filter(int handle, bool enable)
+{
+	return px4_ioctl(handle, ORBIOCSETCHANGEFILTER, enable ? 1 : 0);
+}
+
+int uORB::Manager::orb_set_integrity_check(int handle, bool enable)
+{
+	return px4_ioctl(handle, ORBIOCSETINTEGRITY, enable ? 1 : 0);
+}
+
 
 int uORB::Manager::node_advertise
 (
@@ -178,6 +178,60 @@ public:
 	 */
 	int  orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data) ;
 
+	/**
+	 * Borrow a write slot from a topic for zero-copy publication.
+	 *
+	 * Instead of building the message in a local struct and letting orb_publish()
+	 * copy it into the node, the publisher constructs the message directly in the
+	 * node's buffer and then calls orb_publish_commit(). This avoids one full
+	 * copy of o_size bytes per publication, which matters for large topics.
+	 * Only supported for topics advertised with a queue size of 1; for queued
+	 * topics nullptr is returned and the caller must use orb_publish().
+	 *
+	 * @param meta    The uORB metadata (usually from the ORB_ID() macro)
+	 *      for the topic.
+	 * @param handle  The handle returned from orb_advertise.
+	 * @return    pointer to a writable buffer of o_size bytes, or nullptr
+	 *      with errno set accordingly.
+	 */
+	void *orb_publish_borrow(const struct orb_metadata *meta, orb_advert_t handle);
+
+	/**
+	 * Commit a message written into a slot obtained via orb_publish_borrow().
+	 *
+	 * Subscribers are notified exactly as for a regular orb_publish().
+	 *
+	 * @param meta    The uORB metadata for the topic.
+	 * @param handle  The handle returned from orb_advertise.
+	 * @return    OK on success, ERROR otherwise with errno set accordingly.
+	 */
+	int  orb_publish_commit(const struct orb_metadata *meta, orb_advert_t handle);
+
+	/**
+	 * Get a const pointer onto the latest message of a subscribed topic without
+	 * copying it out of the node.
+	 *
+	 * The message is only guaranteed to be consistent as long as
+	 * orb_peek_valid() returns true for the returned generation; callers must
+	 * re-peek (or fall back to orb_copy()) when it does not. This does not
+	 * reset the updated flag of the subscription.
+	 *
+	 * @param handle  A handle returned from orb_subscribe.
+	 * @param generation  Set to the generation of the returned message.
+	 * @return    pointer to the message, or nullptr if nothing was published
+	 *      yet or the topic uses a queue (use orb_copy() then).
+	 */
+	const void *orb_peek(int handle, unsigned *generation);
+
+	/**
+	 * Check whether a message obtained via orb_peek() is still consistent.
+	 *
+	 * @param handle  A handle returned from orb_subscribe.
+	 * @param generation  The generation returned by orb_peek().
+	 * @return    true if no publication happened since the peek.
+	 */
+	bool orb_peek_valid(int handle, unsigned generation);
+
 	/**
 	 * Subscribe to a topic.
 	 *
@@ -286,6 +340,58 @@ public:
 	 */
 	int  orb_check(int handle, bool *updated) ;
 
+	/**
+	 * Check a set of subscriptions for updates in a single manager call.
+	 *
+	 * Equivalent to calling orb_check() on each handle, but resolves the whole
+	 * array in one trip through the middleware, which keeps the number of
+	 * calls in high-rate loops (e.g. the sensor hub polling every sensor
+	 * instance) constant regardless of the number of subscriptions.
+	 *
+	 * @param handles An array of handles returned from orb_subscribe.
+	 * @param count   Number of handles, at most 32.
+	 * @param updated Returns a bitmask with bit i set if handles[i] has been
+	 *      updated since the last orb_copy on it.
+	 * @return    OK if all checks were successful, ERROR otherwise with
+	 *      errno set accordingly.
+	 */
+	int  orb_check_multi(const int *handles, unsigned count, uint32_t *updated);
+
+	/**
+	 * Fetch data from a set of subscriptions in a single manager call.
+	 *
+	 * Copies each topic whose bit is set in the updated mask (as returned by
+	 * orb_check_multi()) into the corresponding buffer.
+	 *
+	 * @param metas   Array of uORB metadata, one per handle.
+	 * @param handles An array of handles returned from orb_subscribe.
+	 * @param buffers Array of destination buffers, one per handle.
+	 * @param count   Number of handles, at most 32.
+	 * @param updated Bitmask of subscriptions to copy; bits of failed copies
+	 *      are cleared on return.
+	 * @return    OK if all requested copies succeeded, ERROR otherwise with
+	 *      errno set accordingly.
+	 */
+	int  orb_copy_multi(const struct orb_metadata **metas, const int *handles, void **buffers, unsigned count,
+			    uint32_t *updated);
+
+	/**
+	 * Drain up to max_count pending entries of a queued topic in one call.
+	 *
+	 * The entries are copied oldest first. On non-queued topics (or topics
+	 * advertised with a queue size of 1) this behaves like orb_copy() and
+	 * returns at most one entry.
+	 *
+	 * @param meta      The uORB metadata (usually from the ORB_ID() macro)
+	 *      for the topic.
+	 * @param handle    A handle returned from orb_subscribe.
+	 * @param buffer    Pointer to a buffer with room for max_count entries.
+	 * @param max_count Capacity of the buffer in entries, at least 1.
+	 * @return    The number of entries copied (0 if none were pending),
+	 *      ERROR otherwise with errno set accordingly.
+	 */
+	int  orb_copy_batch(const struct orb_metadata *meta, int handle, void *buffer, unsigned max_count);
+
 	/**
 	 * Return the last time that the topic was updated. If a queue is used, it returns
 	 * the timestamp of the latest element in the queue.
@@ -319,6 +425,19 @@ public:
 	 */
 	int  orb_priority(int handle, int32_t *priority) ;
 
+	/**
+	 * Return the number of subscribers on an advertised topic.
+	 *
+	 * This lets a publisher skip producing expensive data nobody consumes.
+	 * The count is a snapshot: a subscriber can attach right after the call,
+	 * so callers should re-check periodically rather than once.
+	 *
+	 * @param handle  The handle returned from orb_advertise.
+	 * @return    the number of subscribers (0 if none), ERROR on an invalid
+	 *      handle with errno set accordingly.
+	 */
+	int  orb_subscriber_count(orb_advert_t handle) ;
+
 	/**
 	 * Set the minimum interval between which updates are seen for a subscription.
 	 *
@@ -351,6 +470,70 @@ public:
 	 */
 	int	orb_get_interval(int handle, unsigned *interval);
 
+	/**
+	 * Enable or disable the change filter for a subscription.
+	 *
+	 * With the filter enabled, a publication only appears as an update to this
+	 * subscription if it changed the topic payload. The comparison skips the
+	 * leading uint64 timestamp field. Topics with a queue size greater than one
+	 * are published unfiltered.
+	 *
+	 * @param handle  A handle returned from orb_subscribe.
+	 * @param enable  True to enable the filter, false to see every publication.
+	 * @return    OK on success, ERROR otherwise with ERRNO set accordingly.
+	 */
+	int	orb_set_change_filter(int handle, bool enable);
+
+	/**
+	 * Enable or disable the sampled integrity check for a topic.
+	 *
+	 * With the check enabled, every Nth publication of the topic is stamped
+	 * with a CRC computed at publish time, and every copy of that sampled
+	 * publication is verified against it. A mismatch means the payload was
+	 * corrupted between publisher and consumer; mismatches are counted in
+	 * the uorb_crc_err perf counter and reported for the topic. The cost is
+	 * one CRC pass per sampled message on each side, so the steady-state
+	 * overhead is near zero.
+	 *
+	 * @param handle  A handle returned from orb_subscribe.
+	 * @param enable  True to enable the check for the topic, false to disable.
+	 * @return    OK on success, ERROR otherwise with ERRNO set accordingly.
+	 */
+	int	orb_set_integrity_check(int handle, bool enable);
+
+	/**
+	 * Register interest in advertisements of a topic family (all instances
+	 * of a topic).
+	 *
+	 * A watch replaces periodic orb_exists()/orb_group_count() scans: the
+	 * watcher checks orb_advertisements_changed(), which is a counter
+	 * compare, and only rescans the instance slots when it returns true.
+	 *
+	 * @param meta    ORB topic metadata of the family to watch.
+	 * @return    A watch handle, or ERROR if the watch table is full.
+	 */
+	int  orb_watch_advertisements(const struct orb_metadata *meta);
+
+	/**
+	 * Release an advertisement watch.
+	 *
+	 * @param watch   A handle returned from orb_watch_advertisements().
+	 * @return    OK on success, ERROR otherwise.
+	 */
+	int  orb_unwatch_advertisements(int watch);
+
+	/**
+	 * Check whether the watched topic family has been advertised since the
+	 * last call for this watch.
+	 *
+	 * Returns true on the first call after the watch was registered, so a
+	 * watcher's initial scan folds into the same code path.
+	 *
+	 * @param watch   A handle returned from orb_watch_advertisements().
+	 * @return    True if there may be new instances to discover.
+	 */
+	bool orb_advertisements_changed(int watch);
+
 	/**
 	 * Method to set the uORBCommunicator::IChannel instance.
 	 * @param comm_channel
@@ -414,6 +597,24 @@ private: // data members
 
 	DeviceMaster *_device_masters[Flavor_count]; ///< Allow at most one DeviceMaster per Flavor
 
+	static const int MAX_ADVERT_WATCHES = 8;
+
+	struct AdvertWatch {
+		const struct orb_metadata *meta; /**< watched topic family */
+		unsigned advertisements;         /**< bumped on every advertisement of the family */
+		unsigned seen;                   /**< counter value at the last changed-query */
+		bool used;
+	};
+
+	AdvertWatch _advert_watches[MAX_ADVERT_WATCHES] = {};
+
+	/**
+	 * Bump the advertisement counters of any watches on this topic family.
+	 * Called on every (re-)advertisement; spurious notifications only cost
+	 * the watcher a rescan.
+	 */
+	void notify_advertisement(const struct orb_metadata *meta);
+
 private: //class methods
 	Manager();
 	~Manager();
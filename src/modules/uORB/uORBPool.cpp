@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBPool.hpp"
+#include "uORBTopics.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/*
+ * Each block carries a one-word header holding its size class, so release()
+ * does not need to be told the size. The header is 8 bytes to keep the block
+ * payload 8-byte aligned on 32 bit targets. Freed blocks are threaded onto a
+ * per-class freelist through their first payload word, leaving the header
+ * intact.
+ */
+
+namespace
+{
+
+const size_t class_sizes[] = {16, 32, 64, 128, 256};
+const unsigned num_classes = sizeof(class_sizes) / sizeof(class_sizes[0]);
+
+/* header tag for oversized blocks passed through to the heap */
+const uint64_t CLASS_HEAP = 0xffu;
+
+struct free_block {
+	free_block *next;
+};
+
+free_block *freelists[num_classes] = {};
+pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* add a slab of fresh blocks to a size class freelist; called with the lock held */
+bool grow(unsigned size_class)
+{
+	/* size the slab from the topic count: nodes, map entries and
+	 * subscriptions all scale with the number of topics in use */
+	size_t nblocks = orb_topics_count();
+
+	if (nblocks < 32) {
+		nblocks = 32;
+	}
+
+	size_t stride = sizeof(uint64_t) + class_sizes[size_class];
+	char *slab = (char *)malloc(nblocks * stride);
+
+	if (slab == nullptr) {
+		return false;
+	}
+
+	for (size_t i = 0; i < nblocks; i++) {
+		uint64_t *hdr = (uint64_t *)(slab + i * stride);
+		*hdr = size_class;
+
+		free_block *blk = (free_block *)(hdr + 1);
+		blk->next = freelists[size_class];
+		freelists[size_class] = blk;
+	}
+
+	return true;
+}
+
+} // namespace
+
+void *uORB::Pool::allocate(size_t size)
+{
+	unsigned size_class = 0;
+
+	while (size_class < num_classes && class_sizes[size_class] < size) {
+		size_class++;
+	}
+
+	if (size_class == num_classes) {
+		/* oversized: take it from the heap, but keep the header so
+		 * release() stays uniform */
+		uint64_t *hdr = (uint64_t *)malloc(sizeof(uint64_t) + size);
+
+		if (hdr == nullptr) {
+			return nullptr;
+		}
+
+		*hdr = CLASS_HEAP;
+		return hdr + 1;
+	}
+
+	pthread_mutex_lock(&pool_lock);
+
+	if (freelists[size_class] == nullptr && !grow(size_class)) {
+		pthread_mutex_unlock(&pool_lock);
+		return nullptr;
+	}
+
+	free_block *blk = freelists[size_class];
+	freelists[size_class] = blk->next;
+
+	pthread_mutex_unlock(&pool_lock);
+
+	return blk;
+}
+
+void uORB::Pool::release(void *p)
+{
+	if (p == nullptr) {
+		return;
+	}
+
+	uint64_t *hdr = (uint64_t *)p - 1;
+
+	if (*hdr == CLASS_HEAP) {
+		free(hdr);
+		return;
+	}
+
+	pthread_mutex_lock(&pool_lock);
+
+	free_block *blk = (free_block *)p;
+	blk->next = freelists[*hdr];
+	freelists[*hdr] = blk;
+
+	pthread_mutex_unlock(&pool_lock);
+}
+
+char *uORB::Pool::strdup(const char *s)
+{
+	size_t len = strlen(s) + 1;
+	char *p = (char *)allocate(len);
+
+	if (p != nullptr) {
+		memcpy(p, s, len);
+	}
+
+	return p;
+}
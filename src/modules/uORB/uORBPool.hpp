@@ -0,0 +1,71 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+
+namespace uORB
+{
+class Pool;
+}
+
+/**
+ * Slab-backed allocator for the many small, long-lived objects uORB creates
+ * (device nodes, subscriber state, map entries, node paths).
+ *
+ * Blocks are handed out from per-size-class slabs whose capacity is derived
+ * from the generated topic count, so startup makes a handful of large heap
+ * allocations instead of hundreds of small ones, and both allocation and
+ * release are constant-time freelist operations.
+ */
+class uORB::Pool
+{
+public:
+	/**
+	 * Allocate a block of at least @param size bytes.
+	 * Sizes above the largest size class fall through to the heap.
+	 * @return block pointer, or nullptr on allocation failure
+	 */
+	static void *allocate(size_t size);
+
+	/**
+	 * Return a block obtained from allocate().
+	 */
+	static void release(void *p);
+
+	/**
+	 * Copy a string into pool storage (pool equivalent of strdup()).
+	 */
+	static char *strdup(const char *s);
+};
@@ -43,8 +43,8 @@
 extern size_t orb_topics_count() __EXPORT;
 
 /*
- * Returns array of topics metadata
+ * Returns array of topics metadata (stored in read-only memory)
  */
-extern const struct orb_metadata **orb_get_topics() __EXPORT;
+extern const struct orb_metadata *const *orb_get_topics() __EXPORT;
 
 #endif /* MODULES_UORB_UORBTOPICS_H_ */
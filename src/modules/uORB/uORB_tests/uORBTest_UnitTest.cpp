@@ -697,6 +697,29 @@ int uORBTest::UnitTest::test_queue()
 	CHECK_UPDATED(-1);
 	CHECK_COPY(u.val, t.val);
 
+	test_note("  Testing batch drain...");
+
+	struct orb_test_medium batch[queue_size];
+
+	for (unsigned int i = 0; i < queue_size - 2; ++i) {
+		t.val = i;
+		orb_publish(ORB_ID(orb_test_medium_queue), ptopic, &t);
+	}
+
+	int num_copied = orb_copy_batch(ORB_ID(orb_test_medium_queue), sfd, batch, queue_size);
+
+	if (num_copied != (int)queue_size - 2) {
+		return test_fail("batch drain returned %i, expected %i", num_copied, (int)queue_size - 2);
+	}
+
+	for (unsigned int i = 0; i < queue_size - 2; ++i) {
+		if (batch[i].val != (int)i) {
+			return test_fail("got wrong element from batch drain (got %i, should be %i)", batch[i].val, i);
+		}
+	}
+
+	CHECK_NOT_UPDATED(queue_size);
+
 #undef CHECK_COPY
 #undef CHECK_UPDATED
 #undef CHECK_NOT_UPDATED
@@ -152,13 +152,31 @@ void UavcanEscController::update_outputs(float *outputs, unsigned num_outputs)
 	 * From the standpoint of the PX4 architecture, however, this is a hack. It should be investigated why
 	 * the mixer returns more outputs than are actually used.
 	 */
-	for (int index = int(msg.cmd.size()) - 1; index >= _max_number_of_nonzero_outputs; index--) {
+	int number_of_nonzero_outputs = 0;
+
+	for (int index = int(msg.cmd.size()) - 1; index >= 0; index--) {
 		if (msg.cmd[index] != 0) {
-			_max_number_of_nonzero_outputs = index + 1;
+			number_of_nonzero_outputs = index + 1;
 			break;
 		}
 	}
 
+	if (number_of_nonzero_outputs >= _max_number_of_nonzero_outputs) {
+		_max_number_of_nonzero_outputs = number_of_nonzero_outputs;
+		_shrink_cycles = 0;
+
+	} else {
+		/*
+		 * Don't resize down immediately - a single zero sample would make the
+		 * message length (and hence the frame count) flap. Only shrink after the
+		 * trailing outputs have been zero for a while.
+		 */
+		if (++_shrink_cycles >= OUTPUT_SHRINK_CYCLES) {
+			_max_number_of_nonzero_outputs = number_of_nonzero_outputs;
+			_shrink_cycles = 0;
+		}
+	}
+
 	msg.cmd.resize(_max_number_of_nonzero_outputs);
 
 	/*
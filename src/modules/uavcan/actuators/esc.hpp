@@ -83,6 +83,8 @@ private:
 	static constexpr unsigned ESC_STATUS_UPDATE_RATE_HZ = 10;
 	static constexpr unsigned UAVCAN_COMMAND_TRANSFER_PRIORITY = 5;	///< 0..31, inclusive, 0 - highest, 31 - lowest
 
+	static constexpr unsigned OUTPUT_SHRINK_CYCLES = MAX_RATE_HZ / 4;	///< trailing zeros for this long shrink the message
+
 	typedef uavcan::MethodBinder<UavcanEscController *,
 		void (UavcanEscController::*)(const uavcan::ReceivedDataStructure<uavcan::equipment::esc::Status>&)>
 		StatusCbBinder;
@@ -110,6 +112,7 @@ private:
 	 */
 	uint32_t 			_armed_mask = 0;
 	uint8_t				_max_number_of_nonzero_outputs = 0;
+	unsigned			_shrink_cycles = 0;		///< consecutive cycles with fewer nonzero outputs
 
 	/*
 	 * Perf counters
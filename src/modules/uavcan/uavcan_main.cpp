@@ -683,12 +683,38 @@ int UavcanNode::init(uavcan::NodeID node_id)
 
 void UavcanNode::node_spin_once()
 {
-	const int spin_res = _node.spinOnce();
+	int spin_res = _node.spinOnce();
 
 	if (spin_res < 0) {
 		warnx("node spin error %i", spin_res);
 	}
 
+	/*
+	 * Drain frames that arrived while we were processing. At full bus
+	 * utilization a single spin per 3 ms wakeup falls behind the RX
+	 * queue; keep spinning as long as the bus event device reports
+	 * activity, bounded so actuator output latency stays low.
+	 */
+	if (_busevent_fd >= 0) {
+		::pollfd fds = {};
+		fds.fd = _busevent_fd;
+		fds.events = POLLIN;
+
+		for (unsigned i = 0; i < MaxSpinsPerCycle; i++) {
+			fds.revents = 0;
+
+			if (::poll(&fds, 1, 0) <= 0 || !(fds.revents & POLLIN)) {
+				break;
+			}
+
+			spin_res = _node.spinOnce();
+
+			if (spin_res < 0) {
+				warnx("node spin error %i", spin_res);
+				break;
+			}
+		}
+	}
 
 	if (_tx_injector != nullptr) {
 		_tx_injector->injectTxFramesInto(_node);
@@ -792,9 +818,9 @@ int UavcanNode::run()
 
 	_node_status_monitor.start();
 
-	const int busevent_fd = ::open(uavcan_stm32::BusEvent::DevName, 0);
+	_busevent_fd = ::open(uavcan_stm32::BusEvent::DevName, 0);
 
-	if (busevent_fd < 0) {
+	if (_busevent_fd < 0) {
 		warnx("Failed to open %s", uavcan_stm32::BusEvent::DevName);
 		_task_should_exit = true;
 	}
@@ -812,7 +838,7 @@ int UavcanNode::run()
 	 * the value returned from poll() to detect whether actuator control has timed out or not.
 	 * Instead, all ORB events need to be checked individually (see below).
 	 */
-	add_poll_fd(busevent_fd);
+	add_poll_fd(_busevent_fd);
 
 	/*
 	 * setup poll to look for actuator direct input if we are
@@ -981,7 +1007,8 @@ int UavcanNode::run()
 		}
 	}
 
-	(void)::close(busevent_fd);
+	(void)::close(_busevent_fd);
+	_busevent_fd = -1;
 
 	teardown();
 	warnx("exiting.");
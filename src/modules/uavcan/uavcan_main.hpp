@@ -99,9 +99,20 @@ class UavcanNode : public device::CDev
 	 *  1000000/200
 	 */
 
-	static constexpr unsigned RxQueueLenPerIface	= FramePerMSecond * PollTimeoutMs; // At
+	/*
+	 * Twice the poll period: the spin thread can be held off the node
+	 * mutex (e.g. by firmware server actions), and at full bus
+	 * utilization a single period of headroom overruns the queue.
+	 */
+	static constexpr unsigned RxQueueLenPerIface	= FramePerMSecond * PollTimeoutMs * 2;
 	static constexpr unsigned StackSize		= 2400;
 
+	/*
+	 * Upper bound on the number of extra spinOnce() calls per wakeup
+	 * when draining a backlog of received frames.
+	 */
+	static constexpr unsigned MaxSpinsPerCycle	= 32;
+
 public:
 	typedef uavcan_stm32::CanInitHelper<RxQueueLenPerIface> CanInitHelper;
 	enum eServerAction {None, Start, Stop, CheckFW, Busy};
@@ -162,6 +173,7 @@ private:
 	}
 
 	int			_task = -1;			///< handle to the OS task
+	int			_busevent_fd = -1;		///< bus event device, also polled when draining RX backlog
 	bool			_task_should_exit = false;	///< flag to indicate to tear down the CAN driver
 	volatile eServerAction	_fw_server_action;
 	int			 _fw_server_status;
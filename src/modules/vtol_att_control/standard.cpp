@@ -51,7 +51,8 @@ Standard::Standard(VtolAttitudeControl *attc) :
 	_flag_enable_mc_motors(true),
 	_pusher_throttle(0.0f),
 	_reverse_output(0.0f),
-	_airspeed_trans_blend_margin(0.0f)
+	_airspeed_trans_blend_margin(0.0f),
+	_sin_down_pitch_max(0.0f)
 {
 	_vtol_schedule.flight_mode = MC_MODE;
 	_vtol_schedule.transition_start = 0;
@@ -126,6 +127,7 @@ Standard::parameters_update()
 	/* maximum down pitch allowed */
 	param_get(_params_handles_standard.down_pitch_max, &v);
 	_params_standard.down_pitch_max = math::radians(v);
+	_sin_down_pitch_max = sinf(_params_standard.down_pitch_max);
 
 	/* scale for fixed wing thrust used for forward acceleration in multirotor mode */
 	param_get(_params_handles_standard.forward_thrust_scale, &_params_standard.forward_thrust_scale);
@@ -450,7 +452,11 @@ void Standard::update_mc_state()
 		// desired roll angle in heading frame stays the same
 		float roll_new = -asinf(body_z_sp(1));
 
-		_pusher_throttle = (sinf(-pitch_forward) - sinf(_params_standard.down_pitch_max))
+		// sin(-pitch_forward) follows from the desired body z axis without a trig call:
+		// sin(atan2(x, z)) = x / sqrt(x^2 + z^2)
+		float sin_pitch_forward = -body_z_sp(0) / sqrtf(body_z_sp(0) * body_z_sp(0) + body_z_sp(2) * body_z_sp(2));
+
+		_pusher_throttle = (sin_pitch_forward - _sin_down_pitch_max)
 				   * _v_att_sp->thrust * _params_standard.forward_thrust_scale;
 
 		// return the vehicle to level position
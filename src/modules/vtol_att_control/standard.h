@@ -120,6 +120,7 @@ private:
 	float _pusher_throttle;
 	float _reverse_output;
 	float _airspeed_trans_blend_margin;
+	float _sin_down_pitch_max;	// sine of the down pitch limit, precomputed on parameter updates
 
 	void set_max_mc(unsigned pwm_value);
 
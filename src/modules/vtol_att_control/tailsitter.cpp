@@ -55,6 +55,10 @@ Tailsitter::Tailsitter(VtolAttitudeControl *attc) :
 	_thrust_transition_start(0.0f),
 	_yaw_transition(0.0f),
 	_pitch_transition_start(0.0f),
+	_trans_pitch_min(0.0f),
+	_trans_pitch_scale(0.0f),
+	_q_yaw_cos(1.0f),
+	_q_yaw_sin(0.0f),
 	_loop_perf(perf_alloc(PC_ELAPSED, "vtol_att_control-tailsitter")),
 	_nonfinite_input_perf(perf_alloc(PC_COUNT, "vtol att control-tailsitter nonfinite input"))
 {
@@ -117,6 +121,18 @@ Tailsitter::parameters_update()
 	if (_params_tailsitter.airspeed_trans < _params_tailsitter.airspeed_blend_start + 1.0f) {
 		_params_tailsitter.airspeed_trans = _params_tailsitter.airspeed_blend_start + 1.0f;
 	}
+
+	/* precompute the pitch-axis quaternion terms over the full transition pitch range, so
+	 * the transition code can build the attitude setpoint quaternion by linear interpolation
+	 * instead of evaluating trigonometry every cycle */
+	_trans_pitch_min = -2.0f;
+	_trans_pitch_scale = (TRANS_PITCH_LUT_SIZE - 1) / (M_PI_2_F - _trans_pitch_min);
+
+	for (int j = 0; j < TRANS_PITCH_LUT_SIZE; j++) {
+		float pitch = _trans_pitch_min + (float)j / _trans_pitch_scale;
+		_q_pitch_lut_w[j] = cosf(pitch / 2.0f);
+		_q_pitch_lut_y[j] = sinf(pitch / 2.0f);
+	}
 }
 
 void Tailsitter::update_vtol_state()
@@ -241,6 +257,11 @@ void Tailsitter::update_transition_state()
 		_pitch_transition_start = euler.theta();
 		_thrust_transition_start = _v_att_sp->thrust;
 		_flag_was_in_trans_mode = true;
+
+		// roll stays zero and yaw stays fixed for the whole transition, so the yaw
+		// half-angle terms of the setpoint quaternion only need to be computed once
+		_q_yaw_cos = cosf(_yaw_transition / 2.0f);
+		_q_yaw_sin = sinf(_yaw_transition / 2.0f);
 	}
 
 	if (_vtol_schedule.flight_mode == TRANSITION_FRONT_P1) {
@@ -347,9 +368,19 @@ void Tailsitter::update_transition_state()
 	_v_att_sp->roll_body = 0.0f;
 	_v_att_sp->yaw_body = _yaw_transition;
 
-	math::Quaternion q_sp;
-	q_sp.from_euler(_v_att_sp->roll_body, _v_att_sp->pitch_body, _v_att_sp->yaw_body);
-	memcpy(&_v_att_sp->q_d[0], &q_sp.data[0], sizeof(_v_att_sp->q_d));
+	// interpolate the pitch-axis quaternion terms from the lookup table
+	float idx_f = (math::constrain(_v_att_sp->pitch_body, _trans_pitch_min,
+				       M_PI_2_F) - _trans_pitch_min) * _trans_pitch_scale;
+	int idx = math::min((int)idx_f, TRANS_PITCH_LUT_SIZE - 2);
+	float frac = idx_f - (float)idx;
+	float q_pitch_w = _q_pitch_lut_w[idx] + frac * (_q_pitch_lut_w[idx + 1] - _q_pitch_lut_w[idx]);
+	float q_pitch_y = _q_pitch_lut_y[idx] + frac * (_q_pitch_lut_y[idx + 1] - _q_pitch_lut_y[idx]);
+
+	// compose with the fixed transition heading: q_sp = q_yaw * q_pitch (roll is zero)
+	_v_att_sp->q_d[0] = _q_yaw_cos * q_pitch_w;
+	_v_att_sp->q_d[1] = -_q_yaw_sin * q_pitch_y;
+	_v_att_sp->q_d[2] = _q_yaw_cos * q_pitch_y;
+	_v_att_sp->q_d[3] = _q_yaw_sin * q_pitch_w;
 }
 
 void Tailsitter::waiting_on_tecs()
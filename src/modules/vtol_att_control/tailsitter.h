@@ -105,6 +105,17 @@ private:
 	float _yaw_transition;	// yaw angle in which transition will take place
 	float _pitch_transition_start;  // pitch angle at the start of transition (tailsitter)
 
+	/** lookup table for the pitch-axis terms (w = cos(pitch/2), y = sin(pitch/2)) of the
+	 * transition attitude setpoint quaternion, rebuilt on parameter updates. roll is zero
+	 * and yaw is fixed during a transition, so the remaining terms are constant per transition. */
+	static const int TRANS_PITCH_LUT_SIZE = 33;
+	float _q_pitch_lut_w[TRANS_PITCH_LUT_SIZE];
+	float _q_pitch_lut_y[TRANS_PITCH_LUT_SIZE];
+	float _trans_pitch_min;		/**< pitch angle of the first table entry */
+	float _trans_pitch_scale;	/**< table entries per rad of pitch */
+	float _q_yaw_cos;		/**< cos(yaw/2) for the heading the transition started in */
+	float _q_yaw_sin;		/**< sin(yaw/2) for the heading the transition started in */
+
 
 	/** should this anouncement stay? **/
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
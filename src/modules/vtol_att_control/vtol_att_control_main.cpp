@@ -90,7 +90,8 @@ VtolAttitudeControl::VtolAttitudeControl() :
 	_v_rates_sp_pub(nullptr),
 	_v_att_sp_pub(nullptr),
 	_transition_command(vtol_vehicle_status_s::VEHICLE_VTOL_STATE_MC),
-	_abort_front_transition(false)
+	_abort_front_transition(false),
+	_trans_cycle_perf(perf_alloc(PC_ELAPSED, "vtol_trans_cycle"))
 
 {
 	memset(& _vtol_vehicle_status, 0, sizeof(_vtol_vehicle_status));
@@ -185,6 +186,8 @@ VtolAttitudeControl::~VtolAttitudeControl()
 		delete _vtol_type;
 	}
 
+	perf_free(_trans_cycle_perf);
+
 	VTOL_att_control::g_control = nullptr;
 }
 
@@ -830,8 +833,10 @@ void VtolAttitudeControl::task_main()
 
 			// update transition state if got any new data
 			if (got_new_data) {
+				perf_begin(_trans_cycle_perf);
 				_vtol_type->update_transition_state();
 				fill_mc_att_rates_sp();
+				perf_end(_trans_cycle_perf);
 			}
 
 		} else if (_vtol_type->get_mode() == EXTERNAL) {
@@ -61,6 +61,7 @@
 #include <lib/mathlib/mathlib.h>
 #include <systemlib/err.h>
 #include <systemlib/param/param.h>
+#include <systemlib/perf_counter.h>
 #include <systemlib/systemlib.h>
 
 #include <uORB/topics/actuator_armed.h>
@@ -213,6 +214,8 @@ private:
 	int _transition_command;
 	bool _abort_front_transition;
 
+	perf_counter_t _trans_cycle_perf;	// cost of one transition-mode update cycle
+
 	VtolType *_vtol_type = nullptr;	// base class for different vtol types
 
 //*****************Member functions***********************************************************************
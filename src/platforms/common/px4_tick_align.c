@@ -0,0 +1,78 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file px4_tick_align.c
+ *
+ * Tick alignment for periodic module cycles, see px4_tick_align.h.
+ */
+
+#include <px4_tick_align.h>
+#include <px4_time.h>
+
+#include <stdint.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+
+unsigned px4_tick_align_delay(unsigned interval_us, unsigned phase_us)
+{
+	if (interval_us == 0) {
+		return 0;
+	}
+
+	phase_us %= interval_us;
+
+	const hrt_abstime now = hrt_absolute_time();
+
+	/* boundaries are multiples of the interval since boot, shifted by the
+	 * phase offset; the hrt is the one timebase all modules share */
+	uint64_t next = now - (now % interval_us) + phase_us;
+
+	/* never come back almost immediately: a cycle finishing just before
+	 * its boundary would otherwise run twice in one period */
+	while (next <= now + interval_us / 4) {
+		next += interval_us;
+	}
+
+	return (unsigned)(next - now);
+}
+
+void px4_tick_align_sleep(unsigned interval_us, unsigned phase_us)
+{
+	unsigned delay = px4_tick_align_delay(interval_us, phase_us);
+
+	if (delay > 0) {
+		usleep(delay);
+	}
+}
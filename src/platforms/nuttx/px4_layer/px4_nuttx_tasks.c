@@ -53,6 +53,11 @@
 
 
 #include <px4_log.h>
+#include <drivers/drv_hrt.h>
+#include <semaphore.h>
+#include <errno.h>
+#include <systemlib/boot_trace.h>
+#include <systemlib/cpuload.h>
 #include <systemlib/systemlib.h>
 
 
@@ -85,6 +90,10 @@ int px4_task_spawn_cmd(const char *name, int scheduler, int priority, int stack_
 	pid = task_create(name, priority, stack_size, entry, argv);
 
 	if (pid > 0) {
+		/* boot trace: record when each task came up (no-op after boot) */
+		if (boot_trace_active()) {
+			boot_trace_mark(name);
+		}
 
 		/* configure the scheduler */
 		struct sched_param param;
@@ -105,6 +114,212 @@ int px4_task_delete(int pid)
 	return task_delete(pid);
 }
 
+/*
+ * Time-partition scheduler.
+ *
+ * Task priorities alone do not bound interference: auxiliary load can still
+ * delay the control chain by priority inversion through shared locks. Once
+ * per period a small top-priority housekeeping task raises the designated
+ * critical set to a priority ceiling for a fixed window, so those tasks own
+ * the CPU for that window regardless of what else is going on, and restores
+ * the base priorities when the window closes. Windows that spill past their
+ * budget are counted as overruns.
+ */
+
+#define PART_MAX_CRITICAL_TASKS		8
+#define PART_CEILING_PRIORITY		(SCHED_PRIORITY_MAX - 1)
+
+struct part_task_s {
+	int pid;
+	int base_priority;
+};
+
+static struct part_task_s part_tasks[PART_MAX_CRITICAL_TASKS];
+static px4_task_partition_status_t part_status;
+static struct hrt_call part_call;
+static sem_t part_sem;
+static int part_pid = -1;
+static volatile bool part_should_exit;
+
+static void part_period_tick(void *arg)
+{
+	sem_post(&part_sem);
+}
+
+static int part_sched_main(int argc, char *argv[])
+{
+	while (!part_should_exit) {
+
+		/* wait for the next period boundary */
+		while (sem_wait(&part_sem) != 0 && errno == EINTR) {
+		}
+
+		if (part_should_exit) {
+			break;
+		}
+
+		/* a tick already pending here means the previous window handling
+		 * spilled into this period */
+		int pending;
+
+		if (sem_getvalue(&part_sem, &pending) == 0 && pending > 0) {
+			part_status.overruns++;
+		}
+
+		const hrt_abstime window_start = hrt_absolute_time();
+		struct sched_param param;
+
+		/* open the window: raise the critical set to the ceiling */
+		sched_lock();
+
+		for (unsigned i = 0; i < part_status.critical_tasks; i++) {
+			param.sched_priority = PART_CEILING_PRIORITY;
+			sched_setparam(part_tasks[i].pid, &param);
+		}
+
+		sched_unlock();
+
+		/* for the duration of the window the critical set runs above
+		 * everything except this task and the fast drivers */
+		usleep(part_status.window_us);
+
+		/* close the window: restore the base priorities */
+		sched_lock();
+
+		for (unsigned i = 0; i < part_status.critical_tasks; i++) {
+			param.sched_priority = part_tasks[i].base_priority;
+			sched_setparam(part_tasks[i].pid, &param);
+		}
+
+		sched_unlock();
+
+		/* the sleep should return right at the budget; returning late means
+		 * interrupt load or the critical set itself ate past the window */
+		const uint32_t elapsed = hrt_elapsed_time(&window_start);
+
+		if (elapsed > part_status.window_us) {
+			part_status.last_overrun_us = elapsed - part_status.window_us;
+
+			if (elapsed - part_status.window_us > part_status.period_us / 10) {
+				part_status.overruns++;
+			}
+		}
+
+		part_status.cycles++;
+	}
+
+	part_pid = -1;
+	return 0;
+}
+
+int px4_task_set_critical(const char *name)
+{
+#if CONFIG_TASK_NAME_SIZE > 0
+
+	if (part_status.critical_tasks >= PART_MAX_CRITICAL_TASKS) {
+		return -ENOSPC;
+	}
+
+	int pid = -1;
+
+	sched_lock();
+
+	for (int i = 0; i < CONFIG_MAX_TASKS; i++) {
+		if (system_load.tasks[i].valid && strcmp(system_load.tasks[i].tcb->name, name) == 0) {
+			pid = system_load.tasks[i].tcb->pid;
+			break;
+		}
+	}
+
+	sched_unlock();
+
+	if (pid < 0) {
+		return -ESRCH;
+	}
+
+	for (unsigned i = 0; i < part_status.critical_tasks; i++) {
+		if (part_tasks[i].pid == pid) {
+			/* already in the set */
+			return 0;
+		}
+	}
+
+	struct sched_param param;
+
+	if (sched_getparam(pid, &param) != 0) {
+		return -ESRCH;
+	}
+
+	part_tasks[part_status.critical_tasks].pid = pid;
+	part_tasks[part_status.critical_tasks].base_priority = param.sched_priority;
+	part_status.critical_tasks++;
+
+	return 0;
+#else
+	return -ENOSYS;
+#endif
+}
+
+int px4_task_partition_start(unsigned period_us, unsigned window_us)
+{
+	if (period_us == 0 || window_us == 0 || window_us >= period_us) {
+		return -EINVAL;
+	}
+
+	if (part_pid >= 0) {
+		return -EBUSY;
+	}
+
+	part_status.period_us = period_us;
+	part_status.window_us = window_us;
+	part_status.cycles = 0;
+	part_status.overruns = 0;
+	part_status.last_overrun_us = 0;
+	part_should_exit = false;
+
+	sem_init(&part_sem, 0, 0);
+	sem_setprotocol(&part_sem, SEM_PRIO_NONE);
+
+	part_pid = px4_task_spawn_cmd("part_sched", SCHED_FIFO, SCHED_PRIORITY_MAX, 1200,
+				      part_sched_main, NULL);
+
+	if (part_pid < 0) {
+		return part_pid;
+	}
+
+	part_status.active = true;
+
+	hrt_call_every(&part_call, period_us, period_us, part_period_tick, NULL);
+
+	return 0;
+}
+
+int px4_task_partition_stop(void)
+{
+	if (part_pid < 0) {
+		return -ESRCH;
+	}
+
+	hrt_cancel(&part_call);
+
+	part_should_exit = true;
+	sem_post(&part_sem);
+
+	part_status.active = false;
+	part_status.critical_tasks = 0;
+
+	return 0;
+}
+
+int px4_task_partition_status(px4_task_partition_status_t *status)
+{
+	sched_lock();
+	*status = part_status;
+	sched_unlock();
+
+	return 0;
+}
+
 const char *px4_get_taskname(void)
 {
 #if CONFIG_TASK_NAME_SIZE > 0
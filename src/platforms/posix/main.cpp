@@ -52,6 +52,7 @@
 #include "px4_log.h"
 #include "DriverFramework.hpp"
 #include <termios.h>
+#include <stdlib.h>
 #include <sys/stat.h>
 
 namespace px4
@@ -193,18 +194,12 @@ static void print_prompt()
 
 static void run_cmd(const vector<string> &appargs, bool exit_on_fail, bool silently_fail = false)
 {
-	static apps_map_type apps;
-	static bool initialized = false;
-
-	if (!initialized) {
-		init_app_map(apps);
-		initialized = true;
-	}
-
 	// command is appargs[0]
 	string command = appargs[0];
 
-	if (apps.find(command) != apps.end()) {
+	const px4_app_entry *app = px4_app_find(command.c_str());
+
+	if (app != nullptr) {
 		const char *arg[appargs.size() + 2];
 
 		unsigned int i = 0;
@@ -216,7 +211,7 @@ static void run_cmd(const vector<string> &appargs, bool exit_on_fail, bool silen
 
 		arg[i] = (char *)nullptr;
 
-		int retval = apps[command](i, (char **)arg);
+		int retval = app->main(i, (char **)arg);
 
 		if (retval) {
 			cout << "Command '" << command << "' failed, returned " << retval << endl;
@@ -227,7 +222,7 @@ static void run_cmd(const vector<string> &appargs, bool exit_on_fail, bool silen
 		}
 
 	} else if (command == "help") {
-		list_builtins(apps);
+		list_builtins();
 
 	} else if (command.length() == 0 || command[0] == '#') {
 		// Do nothing
@@ -241,10 +236,12 @@ static void run_cmd(const vector<string> &appargs, bool exit_on_fail, bool silen
 static void usage()
 {
 
-	cout << "./px4 [-d] [data_directory] startup_config [-h]" << endl;
+	cout << "./px4 [-d] [-i <instance>] [data_directory] startup_config [-h]" << endl;
 	cout << "   -d            - Optional flag to run the app in daemon mode and does not listen for user input." <<
 	     endl;
 	cout << "                   This is needed if px4 is intended to be run as a upstart job on linux" << endl;
+	cout << "   -i <instance> - Optional vehicle instance for multi-vehicle SITL. Creates and runs in" << endl;
+	cout << "                   instance_<n> below the CWD and offsets the simulator UDP port by 10*<n>" << endl;
 	cout << "<data_directory> - directory where ROMFS and posix-configs are located (if not given, CWD is used)" << endl;
 	cout << "<startup_config> - config file for starting/stopping px4 modules" << endl;
 	cout << "   -h            - help/usage information" << endl;
@@ -296,6 +293,7 @@ int main(int argc, char **argv)
 {
 	bool daemon_mode = false;
 	bool chroot_on = false;
+	int instance = 0;
 
 	tcgetattr(0, &orig_term);
 	atexit(restore_term);
@@ -338,6 +336,16 @@ int main(int argc, char **argv)
 			} else if (strncmp(argv[index], "-c", 2) == 0) {
 				chroot_on = true;
 
+			} else if (strncmp(argv[index], "-i", 2) == 0) {
+				if (index + 1 >= argc) {
+					PX4_ERR("Error -i requires an instance number");
+					usage();
+					return 1;
+				}
+
+				instance = atoi(argv[index + 1]);
+				++index;
+
 			} else {
 				PX4_ERR("Unknown/unhandled parameter: %s", argv[index]);
 				return 1;
@@ -385,6 +393,25 @@ int main(int argc, char **argv)
 		cout << "data path: " << data_path << endl;
 	}
 
+	if (instance > 0) {
+		// give each vehicle its own rootfs and let the simulator connection
+		// derive its UDP port from the instance number
+		string instance_dir = "instance_" + to_string(instance);
+
+		mkpath(instance_dir.c_str(), S_IRUSR | S_IWUSR | S_IXUSR);
+
+		if (chdir(instance_dir.c_str())) {
+			PX4_ERR("Error changing to instance dir %s: %s", instance_dir.c_str(), strerror(errno));
+			return -1;
+		}
+
+		char instance_str[16];
+		snprintf(instance_str, sizeof(instance_str), "%d", instance);
+		setenv("PX4_SIM_INSTANCE", instance_str, 1);
+
+		cout << "instance: " << instance << endl;
+	}
+
 	cout << "commands file: " << commands_file << endl;
 
 	if (commands_file.empty()) {
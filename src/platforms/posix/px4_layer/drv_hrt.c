@@ -43,6 +43,7 @@
 #include <px4_workqueue.h>
 #include <px4_tasks.h>
 #include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
 #include <semaphore.h>
 #include <time.h>
 #include <string.h>
@@ -58,7 +59,16 @@ __EXPORT const uint16_t latency_bucket_count = LATENCY_BUCKET_COUNT;
 __EXPORT const uint16_t	latency_buckets[LATENCY_BUCKET_COUNT] = { 1, 2, 5, 10, 20, 50, 100, 1000 };
 __EXPORT uint32_t	latency_counters[LATENCY_BUCKET_COUNT + 1];
 
+/* per-callout latency instrumentation (see hrt_call_set_latency_perf()) */
+#define HRT_LATENCY_CLIENTS	8
+
+static struct {
+	struct hrt_call		*entry;
+	perf_counter_t		perf;
+} latency_clients[HRT_LATENCY_CLIENTS];
+
 static void		hrt_call_reschedule(void);
+static void		hrt_tim_isr(void *p);
 
 // Intervals in usec
 #define HRT_INTERVAL_MIN	50
@@ -76,6 +86,72 @@ static hrt_abstime _delay_interval = 0;
 static hrt_abstime max_time = 0;
 pthread_mutex_t _hrt_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+/* lockstep mode: time stands still until an external source (the simulator)
+ * advances it through hrt_lockstep_set_time() */
+static bool _lockstep_enabled = false;
+static hrt_abstime _lockstep_time = 0;
+
+/*
+ * vsyscall-style fast path for hrt_absolute_time(): the CPU cycle counter is
+ * calibrated against CLOCK_MONOTONIC and time is then computed inline from a
+ * cached (time, cycles) base pair, avoiding the mutex and the clock read on
+ * every call. The base pair is refreshed through the locked slow path every
+ * HRT_FAST_REBASE_US so calibration drift stays below a microsecond.
+ */
+#if !defined(__PX4_QURT) && !defined(__PX4_POSIX_EAGLE) && !defined(__PX4_POSIX_EXCELSIOR) \
+	&& (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__))
+#define HRT_FAST_COUNTER 1
+#endif
+
+#ifdef HRT_FAST_COUNTER
+
+#define HRT_FAST_REBASE_US	100000		/* re-sync against the clock every 100 ms */
+#define HRT_FAST_CAL_MIN_US	10000		/* minimum interval for a usable scale estimate */
+
+static hrt_abstime _fast_base_time = 0;		/* internal (pre-delay) time at the last rebase */
+static uint64_t _fast_base_cycles = 0;		/* cycle counter value at the last rebase */
+static double _fast_usec_per_cycle = 0.0;	/* calibrated counter scale */
+static uint64_t _fast_rebase_cycles = 0;	/* cycle count after which a rebase is due */
+static volatile bool _fast_valid = false;	/* true once the scale has been calibrated */
+
+static inline uint64_t _hrt_cycles(void)
+{
+#if defined(__aarch64__)
+	uint64_t val;
+	__asm__ volatile("mrs %0, cntvct_el0" : "=r"(val));
+	return val;
+#else
+	uint32_t lo, hi;
+	__asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+	return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+/* update the fast path base pair; must be called with _hrt_mutex held */
+static void _hrt_fast_rebase(hrt_abstime now_internal)
+{
+	uint64_t cycles = _hrt_cycles();
+
+	if (_fast_base_cycles != 0 && cycles > _fast_base_cycles) {
+		hrt_abstime dt = now_internal - _fast_base_time;
+
+		if (dt >= HRT_FAST_CAL_MIN_US) {
+			_fast_usec_per_cycle = (double)dt / (double)(cycles - _fast_base_cycles);
+			_fast_rebase_cycles = (uint64_t)(HRT_FAST_REBASE_US / _fast_usec_per_cycle);
+			_fast_base_time = now_internal;
+			_fast_base_cycles = cycles;
+			_fast_valid = true;
+		}
+
+	} else {
+		_fast_base_time = now_internal;
+		_fast_base_cycles = cycles;
+		_fast_valid = false;
+	}
+}
+
+#endif /* HRT_FAST_COUNTER */
+
 static void
 hrt_call_invoke(void);
 
@@ -190,21 +266,65 @@ int hrt_set_absolute_time_offset(int32_t time_diff_us)
  */
 hrt_abstime hrt_absolute_time(void)
 {
-	pthread_mutex_lock(&_hrt_mutex);
-
 	hrt_abstime ret;
 
+	if (_lockstep_enabled) {
+		return __atomic_load_n(&_lockstep_time, __ATOMIC_RELAXED);
+	}
+
+#ifdef HRT_FAST_COUNTER
+
+	if (_fast_valid && _start_delay_time == 0) {
+		uint64_t delta = _hrt_cycles() - _fast_base_cycles;
+
+		if (delta < _fast_rebase_cycles) {
+			ret = _fast_base_time + (hrt_abstime)((double)delta * _fast_usec_per_cycle);
+
+			if (ret >= _delay_interval) {
+				ret -= _delay_interval;
+
+				/* lock-free monotonic guard: never return less than a
+				 * previously returned time, small extrapolation steps at
+				 * rebase points are flattened instead of reported */
+				hrt_abstime cur = __atomic_load_n(&max_time, __ATOMIC_RELAXED);
+
+				while (ret > cur) {
+					if (__atomic_compare_exchange_n(&max_time, &cur, ret, false,
+									__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+						return ret;
+					}
+				}
+
+				return cur;
+			}
+		}
+	}
+
+#endif /* HRT_FAST_COUNTER */
+
+	pthread_mutex_lock(&_hrt_mutex);
+
 	if (_start_delay_time > 0) {
 		ret = _start_delay_time;
 
 	} else {
 		ret = _hrt_absolute_time_internal();
+
+#ifdef HRT_FAST_COUNTER
+		/* refresh the fast path base pair while we hold the lock anyway */
+		_hrt_fast_rebase(ret);
+#endif
 	}
 
 	ret -= _delay_interval;
 
 	if (ret < max_time) {
-		PX4_ERR("WARNING! TIME IS NEGATIVE! %d vs %d", (int)ret, (int)max_time);
+		/* sub-100us regressions are expected extrapolation error at fast path
+		 * rebase points and are flattened silently */
+		if (max_time - ret > 100) {
+			PX4_ERR("WARNING! TIME IS NEGATIVE! %d vs %d", (int)ret, (int)max_time);
+		}
+
 		ret = max_time;
 	}
 
@@ -218,6 +338,11 @@ __EXPORT hrt_abstime hrt_reset(void)
 {
 #ifndef __PX4_QURT
 	px4_timestart = 0;
+#endif
+#ifdef HRT_FAST_COUNTER
+	/* the epoch changed, recalibrate from scratch */
+	_fast_valid = false;
+	_fast_base_cycles = 0;
 #endif
 	max_time = 0;
 	return _hrt_absolute_time_internal();
@@ -289,6 +414,35 @@ void	hrt_cancel(struct hrt_call *entry)
 	// endif
 }
 
+/*
+ * Attach (or with perf == NULL, detach) a latency perf counter to a callout.
+ */
+void	hrt_call_set_latency_perf(struct hrt_call *entry, struct perf_ctr_header *perf)
+{
+	hrt_lock();
+	unsigned i;
+
+	/* update an existing registration first */
+	for (i = 0; i < HRT_LATENCY_CLIENTS; i++) {
+		if (latency_clients[i].entry == entry) {
+			latency_clients[i].perf = perf;
+			latency_clients[i].entry = (perf != NULL) ? entry : NULL;
+			hrt_unlock();
+			return;
+		}
+	}
+
+	for (i = 0; i < HRT_LATENCY_CLIENTS; i++) {
+		if (latency_clients[i].entry == NULL && perf != NULL) {
+			latency_clients[i].entry = entry;
+			latency_clients[i].perf = perf;
+			break;
+		}
+	}
+
+	hrt_unlock();
+}
+
 /*
  * initialise a hrt_call structure
  */
@@ -325,6 +479,35 @@ void	hrt_init(void)
 	memset(&_hrt_work, 0, sizeof(_hrt_work));
 }
 
+void	hrt_lockstep_enable(void)
+{
+	pthread_mutex_lock(&_hrt_mutex);
+
+	/* seed lockstep time from the current notion of time so timestamps
+	 * taken before and after the switch stay monotonic */
+	_lockstep_time = _hrt_absolute_time_internal() - _delay_interval;
+	_lockstep_enabled = true;
+
+#ifdef HRT_FAST_COUNTER
+	_fast_valid = false;
+#endif
+
+	pthread_mutex_unlock(&_hrt_mutex);
+}
+
+void	hrt_lockstep_set_time(hrt_abstime time)
+{
+	if (!_lockstep_enabled || time <= __atomic_load_n(&_lockstep_time, __ATOMIC_RELAXED)) {
+		return;
+	}
+
+	__atomic_store_n(&_lockstep_time, time, __ATOMIC_RELAXED);
+
+	/* run any callouts which have become due at the new time */
+	hrt_work_cancel(&_hrt_work);
+	hrt_work_queue(&_hrt_work, (worker_t)&hrt_tim_isr, NULL, 0);
+}
+
 void	hrt_start_delay()
 {
 	pthread_mutex_lock(&_hrt_mutex);
@@ -573,6 +756,14 @@ hrt_call_invoke(void)
 		/* zero the deadline, as the call has occurred */
 		call->deadline = 0;
 
+		/* record deadline-to-dispatch latency for instrumented callouts */
+		for (unsigned i = 0; i < HRT_LATENCY_CLIENTS; i++) {
+			if (latency_clients[i].entry == call) {
+				perf_set_elapsed(latency_clients[i].perf, now - deadline);
+				break;
+			}
+		}
+
 		/* invoke the callout (if there is one) */
 		if (call->callout) {
 			// Unlock so we don't deadlock in callback
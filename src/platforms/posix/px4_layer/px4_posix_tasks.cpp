@@ -39,6 +39,7 @@
 
 #include <px4_log.h>
 #include <px4_defines.h>
+#include <systemlib/boot_trace.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -271,6 +272,11 @@ px4_task_t px4_task_spawn_cmd(const char *name, int scheduler, int priority, int
 	pthread_attr_destroy(&attr);
 	pthread_mutex_unlock(&task_mutex);
 
+	/* boot trace: record when each task came up (no-op after boot) */
+	if (boot_trace_active()) {
+		boot_trace_mark(name);
+	}
+
 	return i;
 }
 
@@ -444,3 +450,44 @@ int px4_prctl(int option, const char *arg2, px4_task_t pid)
 	return rv;
 }
 
+int px4_task_set_affinity(px4_task_t id, int cpu)
+{
+#ifdef __PX4_LINUX
+	pthread_t pid;
+
+	if (id == -1) {
+		pid = pthread_self();
+
+	} else if (id >= 0 && id < PX4_MAX_TASKS && taskmap[id].isused) {
+		pthread_mutex_lock(&task_mutex);
+		pid = taskmap[id].pid;
+		pthread_mutex_unlock(&task_mutex);
+
+	} else {
+		return -EINVAL;
+	}
+
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+
+	if (cpu == -1) {
+		// allow the task to run on all CPUs again
+		for (int i = 0; i < CPU_SETSIZE; i++) {
+			CPU_SET(i, &cpu_set);
+		}
+
+	} else if (cpu >= 0 && cpu < CPU_SETSIZE) {
+		CPU_SET(cpu, &cpu_set);
+
+	} else {
+		return -EINVAL;
+	}
+
+	int rv = pthread_setaffinity_np(pid, sizeof(cpu_set), &cpu_set);
+	return (rv > 0) ? -rv : rv;
+#else
+	// not supported on this platform
+	return -ENOSYS;
+#endif
+}
+
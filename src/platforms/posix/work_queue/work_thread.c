@@ -43,12 +43,15 @@
 #include <px4_time.h>
 #include <px4_tasks.h>
 #include <px4_workqueue.h>
+#include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <queue.h>
 #include <pthread.h>
 #include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
 #include "work_lock.h"
 
 #ifdef CONFIG_SCHED_WORKQUEUE
@@ -73,6 +76,13 @@ struct wqueue_s g_work[NWORKERS];
  ****************************************************************************/
 px4_sem_t _work_lock[NWORKERS];
 
+/* queue-to-execute latency of each work queue, beyond the requested delay */
+static perf_counter_t _latency_perf[NWORKERS];
+
+/* dispatch statistics of each queue, updated under the queue lock and read
+ * by monitors through work_queue_get_stats() */
+static struct work_queue_stats_s _queue_stats[NWORKERS];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -82,16 +92,23 @@ px4_sem_t _work_lock[NWORKERS];
  *
  * Description:
  *   This is the logic that performs actions placed on any work list.
+ *   Several workers may process the same list concurrently; each item is
+ *   removed from the list under the queue lock before it is executed.
  *
  * Input parameters:
- *   wqueue - Describes the work queue to be processed
+ *   wqueue   - Describes the work queue to be processed
+ *   lock_id  - The lock protecting that queue
+ *   one_shot - Execute at most one ready item (used when stealing work
+ *              from another queue)
+ *   ran      - Set to true when at least one item was executed
  *
  * Returned Value:
- *   None
+ *   The time in usec until the next queued item becomes ready, bounded
+ *   by CONFIG_SCHED_WORKPERIOD.
  *
  ****************************************************************************/
 
-static void work_process(struct wqueue_s *wqueue, int lock_id)
+static uint32_t work_process(struct wqueue_s *wqueue, int lock_id, bool one_shot, bool *ran)
 {
 	volatile struct work_s *work;
 	worker_t  worker;
@@ -136,6 +153,22 @@ static void work_process(struct wqueue_s *wqueue, int lock_id)
 
 			work->worker = NULL;
 
+			/* record how long the item waited beyond its requested delay */
+			uint64_t latency = (elapsed - work->delay) * USEC_PER_TICK;
+			perf_set_elapsed(_latency_perf[lock_id], latency);
+
+			struct work_queue_stats_s *stats = &_queue_stats[lock_id];
+			stats->items++;
+			stats->last_dispatch = hrt_absolute_time();
+
+			if (latency > stats->latency_worst) {
+				stats->latency_worst = latency;
+			}
+
+			if (latency > stats->latency_window_worst) {
+				stats->latency_window_worst = latency;
+			}
+
 			/* Do the work.  Re-enable interrupts while the work is being
 			 * performed... we don't have any idea how long that will take!
 			 */
@@ -149,6 +182,13 @@ static void work_process(struct wqueue_s *wqueue, int lock_id)
 				worker(arg);
 			}
 
+			*ran = true;
+
+			if (one_shot) {
+				/* stealing: hand the queue back after a single item */
+				return next;
+			}
+
 			/* Now, unfortunately, since we re-enabled interrupts we don't
 			 * know the state of the work list and we will have to start
 			 * back at the head of the list.
@@ -177,12 +217,80 @@ static void work_process(struct wqueue_s *wqueue, int lock_id)
 		}
 	}
 
-	/* Wait awhile to check the work list.  We will wait here until either
-	 * the time elapses or until we are awakened by a signal.
-	 */
 	work_unlock(lock_id);
 
-	usleep(next);
+	return next;
+}
+
+/****************************************************************************
+ * Name: work_queue_get_stats
+ *
+ * Description:
+ *   Copy out the dispatch statistics of a work queue, optionally resetting
+ *   the windowed worst-case latency.  See px4_workqueue.h.
+ *
+ ****************************************************************************/
+
+int work_queue_get_stats(int qid, struct work_queue_stats_s *stats, bool reset_window)
+{
+	if (qid < 0 || qid >= NWORKERS || stats == NULL) {
+		return -EINVAL;
+	}
+
+	work_lock(qid);
+
+	*stats = _queue_stats[qid];
+
+	if (reset_window) {
+		_queue_stats[qid].latency_window_worst = 0;
+	}
+
+	work_unlock(qid);
+
+	return 0;
+}
+
+/****************************************************************************
+ * Name: work_pool_thread
+ *
+ * Description:
+ *   Main loop shared by all pool workers.  Each worker drains its home
+ *   queue, then steals one ready item at a time from the other queue so
+ *   an idle core keeps making progress on the backlog, and finally waits
+ *   until the next item becomes ready or a signal arrives.
+ *
+ ****************************************************************************/
+
+static int work_pool_thread(int home)
+{
+	const int other = (home == HPWORK) ? LPWORK : HPWORK;
+
+	for (;;) {
+		bool ran = false;
+		uint32_t next = work_process(&g_work[home], home, false, &ran);
+
+		/* home queue drained: steal from the other queue rather than
+		 * going to sleep with ready work pending elsewhere
+		 */
+		bool stolen = false;
+		uint32_t other_next = work_process(&g_work[other], other, true, &stolen);
+
+		if (stolen) {
+			/* there may be more ready work, go around again */
+			continue;
+		}
+
+		if (other_next < next) {
+			next = other_next;
+		}
+
+		/* Wait awhile to check the work lists.  We will wait here until
+		 * either the time elapses or until we are awakened by a signal.
+		 */
+		usleep(next);
+	}
+
+	return PX4_OK; /* To keep some compilers happy */
 }
 
 /****************************************************************************
@@ -192,26 +300,53 @@ void work_queues_init(void)
 {
 	px4_sem_init(&_work_lock[HPWORK], 0, 1);
 	px4_sem_init(&_work_lock[LPWORK], 0, 1);
+
+	_latency_perf[HPWORK] = perf_alloc(PC_ELAPSED, "wq:hpwork latency");
+	_latency_perf[LPWORK] = perf_alloc(PC_ELAPSED, "wq:lpwork latency");
 #ifdef CONFIG_SCHED_USRWORK
 	px4_sem_init(&_work_lock[USRWORK], 0, 1);
 #endif
 
-	// Create high priority worker thread
-	g_work[HPWORK].pid = px4_task_spawn_cmd("hpwork",
-						SCHED_DEFAULT,
-						SCHED_PRIORITY_MAX - 1,
-						2000,
-						work_hpthread,
-						(char *const *)NULL);
-
-	// Create low priority worker thread
-	g_work[LPWORK].pid = px4_task_spawn_cmd("lpwork",
-						SCHED_DEFAULT,
-						SCHED_PRIORITY_MIN,
-						2000,
-						work_lpthread,
-						(char *const *)NULL);
+	char taskname[16];
+
+	// Create the high priority worker pool
+	for (int i = 0; i < CONFIG_SCHED_WORKQUEUE_POOL_SIZE; i++) {
+		snprintf(taskname, sizeof(taskname), "hpwork%d", i);
+		g_work[HPWORK].workers[i] = px4_task_spawn_cmd(taskname,
+					    SCHED_DEFAULT,
+					    SCHED_PRIORITY_MAX - 1,
+					    2000,
+					    work_hpthread,
+					    (char *const *)NULL);
+	}
+
+	// Create the low priority worker pool
+	for (int i = 0; i < CONFIG_SCHED_WORKQUEUE_POOL_SIZE; i++) {
+		snprintf(taskname, sizeof(taskname), "lpwork%d", i);
+		g_work[LPWORK].workers[i] = px4_task_spawn_cmd(taskname,
+					    SCHED_DEFAULT,
+					    SCHED_PRIORITY_MIN,
+					    2000,
+					    work_lpthread,
+					    (char *const *)NULL);
+	}
+
+	g_work[HPWORK].pid = g_work[HPWORK].workers[0];
+	g_work[LPWORK].pid = g_work[LPWORK].workers[0];
+}
 
+void work_signal(int qid)
+{
+	// Wake up every worker serving this queue; idle ones are parked in usleep()
+	for (int i = 0; i < CONFIG_SCHED_WORKQUEUE_POOL_SIZE; i++) {
+		if (g_work[qid].workers[i] > 0) {
+#ifdef __PX4_QURT
+			px4_task_kill(g_work[qid].workers[i], SIGALRM);
+#else
+			px4_task_kill(g_work[qid].workers[i], SIGCONT);
+#endif
+		}
+	}
 }
 
 /****************************************************************************
@@ -249,54 +384,14 @@ void work_queues_init(void)
 
 int work_hpthread(int argc, char *argv[])
 {
-	/* Loop forever */
-
-	for (;;) {
-		/* First, perform garbage collection.  This cleans-up memory de-allocations
-		 * that were queued because they could not be freed in that execution
-		 * context (for example, if the memory was freed from an interrupt handler).
-		 * NOTE: If the work thread is disabled, this clean-up is performed by
-		 * the IDLE thread (at a very, very low priority).
-		 */
-
-#ifndef CONFIG_SCHED_LPWORK
-		sched_garbagecollection();
-#endif
-
-		/* Then process queued work.  We need to keep interrupts disabled while
-		 * we process items in the work list.
-		 */
-
-		work_process(&g_work[HPWORK], HPWORK);
-	}
-
-	return PX4_OK; /* To keep some compilers happy */
+	return work_pool_thread(HPWORK);
 }
 
 #ifdef CONFIG_SCHED_LPWORK
 
 int work_lpthread(int argc, char *argv[])
 {
-	/* Loop forever */
-
-	for (;;) {
-		/* First, perform garbage collection.  This cleans-up memory de-allocations
-		 * that were queued because they could not be freed in that execution
-		 * context (for example, if the memory was freed from an interrupt handler).
-		 * NOTE: If the work thread is disabled, this clean-up is performed by
-		 * the IDLE thread (at a very, very low priority).
-		 */
-
-		//sched_garbagecollection();
-
-		/* Then process queued work.  We need to keep interrupts disabled while
-		 * we process items in the work list.
-		 */
-
-		work_process(&g_work[LPWORK], LPWORK);
-	}
-
-	return PX4_OK; /* To keep some compilers happy */
+	return work_pool_thread(LPWORK);
 }
 
 #endif /* CONFIG_SCHED_LPWORK */
@@ -321,7 +416,10 @@ int work_usrthread(int argc, char *argv[])
 		 * we process items in the work list.
 		 */
 
-		work_process(&g_work[USRWORK], USRWORK);
+		bool ran = false;
+		uint32_t next = work_process(&g_work[USRWORK], USRWORK, false, &ran);
+
+		usleep(next);
 	}
 
 	return PX4_OK; /* To keep some compilers happy */
@@ -46,6 +46,23 @@
 #include "px4_micro_hal.h"
 #include <board_config.h>
 
+/*
+ * Place a hot function into the RAM-resident .ramfunc section so it executes
+ * from zero-wait-state SRAM instead of wait-stated flash. The board linker
+ * scripts put .ramfunc inside .data, so the NuttX startup copies it to RAM
+ * together with the initialized data. long_call is required because SRAM is
+ * out of direct branch range from flash. Only enabled on STM32 chips with
+ * enough RAM to spare; everywhere else the annotation is a no-op.
+ */
+#if defined(CONFIG_STM32_STM32F427) || defined(CONFIG_STM32_STM32F469) || \
+	defined(CONFIG_STM32_STM32F40XX) || defined(CONFIG_ARCH_CHIP_STM32F7)
+#  define PX4_HOT_RAMFUNC __attribute__((noinline, long_call, section(".ramfunc")))
+#endif
+
 #elif defined (__PX4_POSIX)
 # include <board_config.h>
 #endif
+
+#ifndef PX4_HOT_RAMFUNC
+#  define PX4_HOT_RAMFUNC
+#endif
@@ -43,6 +43,7 @@
 
 #include <px4_log.h>
 #include <px4_tasks.h>
+#include <systemlib/boot_trace.h>
 #include <systemlib/px4_macros.h>
 
 #ifdef __cplusplus
@@ -161,6 +162,12 @@ public:
 		_object = T::instantiate(argc, argv);
 
 		if (_object) {
+			/* boot trace: instantiation done, the module is about to serve
+			 * (no-op after boot) */
+			if (boot_trace_active()) {
+				boot_trace_mark(MODULE_NAME " ready");
+			}
+
 			T *object = (T *)_object;
 			object->run();
 
@@ -43,6 +43,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __PX4_ROS
 
@@ -182,6 +183,50 @@ __EXPORT bool px4_task_is_running(const char *taskname);
 #ifdef __PX4_POSIX
 /** set process (and thread) options */
 __EXPORT int px4_prctl(int option, const char *arg2, px4_task_t pid);
+
+/** Pin a task to a CPU (SMP POSIX targets only). This allows to e.g. keep the
+ * estimator/control chain isolated from the mavlink & logging tasks.
+ * @param pid task as returned by px4_task_spawn_cmd(), or -1 for the calling task
+ * @param cpu CPU index to pin the task to, or -1 to allow it to run on all CPUs
+ * @return 0 on success, <0 on error (-ENOSYS if unsupported on this platform)
+ */
+__EXPORT int px4_task_set_affinity(px4_task_t pid, int cpu);
+#endif
+
+#ifdef __PX4_NUTTX
+/** Accounting of the time-partition scheduler */
+typedef struct {
+	uint32_t period_us;	/**< partition period */
+	uint32_t window_us;	/**< guaranteed critical execution window per period */
+	uint32_t cycles;	/**< partition periods elapsed */
+	uint32_t overruns;	/**< periods in which the window spilled past its budget */
+	uint32_t last_overrun_us;	/**< how far the most recent overrun exceeded the window */
+	unsigned critical_tasks;	/**< number of tasks in the critical set */
+	bool active;		/**< partition scheduler is running */
+} px4_task_partition_status_t;
+
+/** Add a running task (by name) to the critical set of the time partition.
+ * Must be called before or while the partition is running; the task keeps
+ * its base priority outside the window.
+ * @return 0 on success, -ESRCH if no task of that name is running
+ */
+__EXPORT int px4_task_set_critical(const char *name);
+
+/** Start the time-partition scheduler. Once per period the critical task
+ * set is raised to a priority ceiling for window_us, guaranteeing it that
+ * execution window regardless of auxiliary load or priority inversion
+ * through shared locks. Priorities alone do not bound such interference.
+ * @param period_us partition period
+ * @param window_us guaranteed critical window, must be less than the period
+ * @return 0 on success, -EBUSY if already running
+ */
+__EXPORT int px4_task_partition_start(unsigned period_us, unsigned window_us);
+
+/** Stop the time-partition scheduler and clear the critical set */
+__EXPORT int px4_task_partition_stop(void);
+
+/** Retrieve the partition accounting */
+__EXPORT int px4_task_partition_status(px4_task_partition_status_t *status);
 #endif
 
 /** return the name of the current task */
@@ -0,0 +1,71 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file px4_tick_align.h
+ *
+ * Tick alignment for periodic module cycles.
+ *
+ * Modules that reschedule with a relative delay drift apart over time,
+ * scattering wakeups across the period. Aligning each cycle to the next
+ * boundary of the shared hrt timebase instead makes harmonic periods
+ * coincide: a 1 Hz boundary is also a 10 Hz and a 50 Hz boundary, so
+ * compatible modules wake in one burst and the system sleeps in between.
+ * Work that should not share a burst can pass a phase offset to get its
+ * own boundary grid.
+ */
+
+#pragma once
+
+#include <px4_defines.h>
+
+__BEGIN_DECLS
+
+/**
+ * Delay from now to the next shared cycle boundary.
+ *
+ * @param interval_us	cycle period in microseconds
+ * @param phase_us	offset of this caller's boundary grid within the
+ *			period (0 = the shared grid)
+ * @return		delay in microseconds; at least a quarter period,
+ *			so an early finishing cycle cannot run twice
+ */
+__EXPORT unsigned px4_tick_align_delay(unsigned interval_us, unsigned phase_us);
+
+/**
+ * Sleep until the next shared cycle boundary (task loop variant of
+ * px4_tick_align_delay()).
+ */
+__EXPORT void px4_tick_align_sleep(unsigned interval_us, unsigned phase_us);
+
+__END_DECLS
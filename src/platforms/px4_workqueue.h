@@ -43,6 +43,7 @@
 #include <nuttx/clock.h>
 #elif defined(__PX4_POSIX)
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <queue.h>
 #include <px4_platform_types.h>
@@ -57,8 +58,22 @@ __BEGIN_DECLS
 #define LPWORK 1
 #define NWORKERS 2
 
+/* Number of worker threads serving each work queue. The workers have
+ * affinity to their own queue but steal ready work from the other queue
+ * when theirs is drained, so independent drivers can run concurrently
+ * on multi-core boards.
+ */
+#ifndef CONFIG_SCHED_WORKQUEUE_POOL_SIZE
+#ifdef __PX4_QURT
+#define CONFIG_SCHED_WORKQUEUE_POOL_SIZE 1
+#else
+#define CONFIG_SCHED_WORKQUEUE_POOL_SIZE 2
+#endif
+#endif
+
 struct wqueue_s {
-	pid_t             pid; /* The task ID of the worker thread */
+	pid_t             pid; /* The task ID of the first worker thread */
+	pid_t             workers[CONFIG_SCHED_WORKQUEUE_POOL_SIZE]; /* All workers serving this queue */
 	struct dq_queue_s q;   /* The queue of pending work */
 };
 
@@ -85,6 +100,36 @@ struct work_s {
  ****************************************************************************/
 void work_queues_init(void);
 
+/* Per-queue dispatch statistics, see work_queue_get_stats(). Latencies are
+ * the time an item waited beyond its requested delay before its worker ran,
+ * i.e. how long the queue was blocked by preceding items.
+ */
+struct work_queue_stats_s {
+	uint64_t items;               /* items dispatched since start */
+	uint64_t last_dispatch;       /* hrt timestamp of the most recent dispatch */
+	uint32_t latency_worst;       /* worst dispatch latency since start (usec) */
+	uint32_t latency_window_worst; /* worst dispatch latency since the window was last reset (usec) */
+};
+
+/****************************************************************************
+ * Name: work_queue_get_stats
+ *
+ * Description:
+ *   Copy out the dispatch statistics of a work queue, optionally resetting
+ *   the windowed worst-case so periodic monitors see per-interval peaks.
+ *
+ * Input parameters:
+ *   qid          - The work queue ID
+ *   stats        - Receives the statistics
+ *   reset_window - Reset latency_window_worst after copying
+ *
+ * Returned Value:
+ *   Zero on success, -EINVAL on a bad queue id
+ *
+ ****************************************************************************/
+
+int work_queue_get_stats(int qid, struct work_queue_stats_s *stats, bool reset_window);
+
 /****************************************************************************
  * Name: work_queue
  *
@@ -135,6 +180,19 @@ int work_queue(int qid, struct work_s *work, worker_t worker, void *arg, uint32_
 
 int work_cancel(int qid, struct work_s *work);
 
+/****************************************************************************
+ * Name: work_signal
+ *
+ * Description:
+ *   Wake up all worker threads serving a work queue.
+ *
+ * Input parameters:
+ *   qid    - The work queue ID
+ *
+ ****************************************************************************/
+
+void work_signal(int qid);
+
 uint32_t clock_systimer(void);
 
 int work_hpthread(int argc, char *argv[]);
@@ -40,6 +40,7 @@
 #include <px4_defines.h>
 #include <px4_workqueue.h>
 #include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
 #include <semaphore.h>
 #include <time.h>
 #include <sys/time.h>
@@ -55,6 +56,14 @@ __EXPORT const uint16_t latency_bucket_count = LATENCY_BUCKET_COUNT;
 __EXPORT const uint16_t	latency_buckets[LATENCY_BUCKET_COUNT] = { 1, 2, 5, 10, 20, 50, 100, 1000 };
 __EXPORT uint32_t	latency_counters[LATENCY_BUCKET_COUNT + 1];
 
+/* per-callout latency instrumentation (see hrt_call_set_latency_perf()) */
+#define HRT_LATENCY_CLIENTS	8
+
+static struct {
+	struct hrt_call		*entry;
+	perf_counter_t		perf;
+} latency_clients[HRT_LATENCY_CLIENTS];
+
 static void		hrt_call_reschedule(void);
 
 // Intervals in ms
@@ -181,6 +190,35 @@ void	hrt_cancel(struct hrt_call *entry)
 	// endif
 }
 
+/*
+ * Attach (or with perf == NULL, detach) a latency perf counter to a callout.
+ */
+void	hrt_call_set_latency_perf(struct hrt_call *entry, struct perf_ctr_header *perf)
+{
+	hrt_lock();
+	unsigned i;
+
+	/* update an existing registration first */
+	for (i = 0; i < HRT_LATENCY_CLIENTS; i++) {
+		if (latency_clients[i].entry == entry) {
+			latency_clients[i].perf = perf;
+			latency_clients[i].entry = (perf != NULL) ? entry : NULL;
+			hrt_unlock();
+			return;
+		}
+	}
+
+	for (i = 0; i < HRT_LATENCY_CLIENTS; i++) {
+		if (latency_clients[i].entry == NULL && perf != NULL) {
+			latency_clients[i].entry = entry;
+			latency_clients[i].perf = perf;
+			break;
+		}
+	}
+
+	hrt_unlock();
+}
+
 /*
  * initialise a hrt_call structure
  */
@@ -413,6 +451,14 @@ hrt_call_invoke(void)
 		/* zero the deadline, as the call has occurred */
 		call->deadline = 0;
 
+		/* record deadline-to-dispatch latency for instrumented callouts */
+		for (unsigned i = 0; i < HRT_LATENCY_CLIENTS; i++) {
+			if (latency_clients[i].entry == call) {
+				perf_set_elapsed(latency_clients[i].perf, now - deadline);
+				break;
+			}
+		}
+
 		/* invoke the callout (if there is one) */
 		if (call->callout) {
 			// Unlock so we don't deadlock in callback
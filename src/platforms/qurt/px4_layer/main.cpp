@@ -44,7 +44,6 @@
 #include <dspal_platform.h>
 #include <vector>
 #include <string>
-#include <map>
 #include <stdio.h>
 #include <stdlib.h>
 #include "get_commands.h"
@@ -68,42 +67,34 @@ void qurt_external_hook(void)
 {
 }
 
-static void run_cmd(apps_map_type &apps, const vector<string> &appargs)
+static void run_cmd(const vector<string> &appargs)
 {
 	// command is appargs[0]
 	string command = appargs[0];
 
-	//replaces app.find with iterator code to avoid null pointer exception
-	for (apps_map_type::iterator it = apps.begin(); it != apps.end(); ++it)
-		if (it->first == command) {
-			// one for command name, one for null terminator
-			const char *arg[MAX_ARGS + 2];
+	const px4_app_entry *app = px4_app_find(command.c_str());
 
-			unsigned int i = 0;
+	if (app != nullptr) {
+		// one for command name, one for null terminator
+		const char *arg[MAX_ARGS + 2];
 
-			if (appargs.size() > MAX_ARGS + 1) {
-				PX4_ERR("%d too many arguments in run_cmd", appargs.size() - (MAX_ARGS + 1));
-				return;
-			}
-
-			while (i < appargs.size() && appargs[i].c_str()[0] != '\0') {
-				arg[i] = (char *)appargs[i].c_str();
-				PX4_DEBUG("  arg%d = '%s'\n", i, arg[i]);
-				++i;
-			}
+		unsigned int i = 0;
 
-			arg[i] = (char *)0;
+		if (appargs.size() > MAX_ARGS + 1) {
+			PX4_ERR("%d too many arguments in run_cmd", appargs.size() - (MAX_ARGS + 1));
+			return;
+		}
 
-			//PX4_DEBUG_PRINTF(i);
-			if (apps[command] == NULL) {
-				PX4_ERR("Null function !!\n");
+		while (i < appargs.size() && appargs[i].c_str()[0] != '\0') {
+			arg[i] = (char *)appargs[i].c_str();
+			PX4_DEBUG("  arg%d = '%s'\n", i, arg[i]);
+			++i;
+		}
 
-			} else {
-				apps[command](i, (char **)arg);
-				break;
-			}
+		arg[i] = (char *)0;
 
-		}
+		app->main(i, (char **)arg);
+	}
 }
 
 void eat_whitespace(const char *&b, int &i)
@@ -115,7 +106,7 @@ void eat_whitespace(const char *&b, int &i)
 	i = 0;
 }
 
-static void process_commands(apps_map_type &apps, const char *cmds)
+static void process_commands(const char *cmds)
 {
 	vector<string> appargs;
 	int i = 0;
@@ -140,7 +131,7 @@ static void process_commands(apps_map_type &apps, const char *cmds)
 					PX4_DEBUG("   > arg: %s", appargs[ai].c_str());
 				}
 
-				run_cmd(apps, appargs);
+				run_cmd(appargs);
 			}
 
 			appargs.clear();
@@ -218,12 +209,10 @@ const char *get_commands()
 int dspal_entry(int argc, char *argv[])
 {
 	PX4_INFO("In dspal_entry");
-	apps_map_type apps;
-	init_app_map(apps);
 	DriverFramework::Framework::initialize();
 	px4::init_once();
 	px4::init(argc, (char **)argv, "px4");
-	process_commands(apps, get_commands());
+	process_commands(get_commands());
 	sleep(1); // give time for all commands to execute before starting external function
 
 	if (qurt_external_hook) {
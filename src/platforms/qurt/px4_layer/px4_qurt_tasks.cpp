@@ -401,3 +401,9 @@ int px4_prctl(int option, const char *arg2, px4_task_t pid)
 
 	return rv;
 }
+
+int px4_task_set_affinity(px4_task_t id, int cpu)
+{
+	// not supported on QuRT
+	return -ENOSYS;
+}
@@ -0,0 +1,169 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file bootlog.c
+ *
+ * Print, save and publish the boot-time event trace recorded by
+ * systemlib/boot_trace (task spawns, module ready points and explicit
+ * marks from the startup script).
+ */
+
+#include <px4_config.h>
+#include <px4_module.h>
+#include <px4_posix.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/boot_trace.h>
+#include <uORB/uORB.h>
+#include <uORB/topics/boot_report.h>
+
+__EXPORT int bootlog_main(int argc, char *argv[]);
+
+static const char *BOOTLOG_DEFAULT_FILE = PX4_ROOTFSDIR"/fs/microsd/bootlog.txt";
+
+static void print_usage(void)
+{
+	PRINT_MODULE_DESCRIPTION("Boot-time event trace tool.\n"
+				 "The trace records every task spawn, the ready point of modules and\n"
+				 "explicit marks from the startup script, so the boot time budget can\n"
+				 "be attributed instead of tuned blind.");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("bootlog", "command");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("mark", "Record a named event (from the startup script)");
+	PRINT_MODULE_USAGE_ARG("<name>", "Event name", false);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("finish", "Stop recording, save the report and publish boot_report");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("show", "Print the trace");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("save", "Write the trace as a report file");
+	PRINT_MODULE_USAGE_ARG("<file>", "Report file (default: " "/fs/microsd/bootlog.txt" ")", true);
+}
+
+static void print_trace(FILE *out)
+{
+	const unsigned count = boot_trace_count();
+	uint64_t prev = count > 0 ? boot_trace_events[0].time : 0;
+
+	fprintf(out, "%10s %8s  %s\n", "time (us)", "gap (us)", "event");
+
+	for (unsigned i = 0; i < count; i++) {
+		const struct boot_trace_event_s *ev = &boot_trace_events[i];
+		fprintf(out, "%10llu %8llu  %s\n", (unsigned long long)ev->time,
+			(unsigned long long)(ev->time - prev), ev->name);
+		prev = ev->time;
+	}
+}
+
+static int save_trace(const char *filename)
+{
+	FILE *fp = fopen(filename, "w");
+
+	if (fp == NULL) {
+		PX4_ERR("failed to open %s", filename);
+		return 1;
+	}
+
+	print_trace(fp);
+	fclose(fp);
+	return 0;
+}
+
+static void publish_report(void)
+{
+	const unsigned count = boot_trace_count();
+
+	struct boot_report_s report;
+	memset(&report, 0, sizeof(report));
+	report.timestamp = hrt_absolute_time();
+	report.event_count = count;
+
+	if (count > 0) {
+		report.boot_duration_ms = (boot_trace_events[count - 1].time - boot_trace_events[0].time) / 1000;
+
+		uint64_t longest_gap = 0;
+
+		for (unsigned i = 1; i < count; i++) {
+			const uint64_t gap = boot_trace_events[i].time - boot_trace_events[i - 1].time;
+
+			if (gap > longest_gap) {
+				longest_gap = gap;
+			}
+		}
+
+		report.longest_gap_ms = longest_gap / 1000;
+	}
+
+	orb_advert_t pub = orb_advertise(ORB_ID(boot_report), &report);
+
+	if (pub == NULL) {
+		PX4_ERR("advertising boot_report failed");
+	}
+}
+
+int
+bootlog_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		print_usage();
+		return 0;
+	}
+
+	if (strcmp(argv[1], "mark") == 0) {
+		if (argc < 3) {
+			print_usage();
+			return 1;
+		}
+
+		boot_trace_mark(argv[2]);
+		return 0;
+	}
+
+	if (strcmp(argv[1], "finish") == 0) {
+		boot_trace_finish();
+		publish_report();
+		return save_trace(argc > 2 ? argv[2] : BOOTLOG_DEFAULT_FILE);
+	}
+
+	if (strcmp(argv[1], "show") == 0) {
+		print_trace(stdout);
+		return 0;
+	}
+
+	if (strcmp(argv[1], "save") == 0) {
+		return save_trace(argc > 2 ? argv[2] : BOOTLOG_DEFAULT_FILE);
+	}
+
+	print_usage();
+	return 0;
+}
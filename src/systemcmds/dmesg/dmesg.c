@@ -0,0 +1,298 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file dmesg.c
+ *
+ * Ring-buffered console with non-blocking writes and message retrieval.
+ *
+ * 'dmesg start' replaces /dev/console with a wrapper driver: writes land
+ * in a RAM ring and return immediately, a low-priority work queue entry
+ * drains the ring to the real console in small paced chunks. A task that
+ * prints therefore never stalls on the 57600 baud UART, and the ring
+ * doubles as retained console history which 'dmesg' prints at any time,
+ * e.g. to read boot messages over USB without a serial cable attached at
+ * boot. Reads and ioctls pass through to the real console unchanged.
+ *
+ * Only opens made after the swap go through the ring, so start it before
+ * the daemons in the startup script.
+ */
+
+#include <px4_config.h>
+#include <px4_log.h>
+#include <px4_module.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+
+__EXPORT int dmesg_main(int argc, char *argv[]);
+
+#ifndef __PX4_NUTTX
+
+int dmesg_main(int argc, char *argv[])
+{
+	PX4_ERR("console ring is only supported on NuttX");
+	return 1;
+}
+
+#else
+
+#include <px4_workqueue.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/fs/fs.h>
+
+/* retained console history and staging space for the drain */
+#define CONSOLE_RING_SIZE		8192
+
+/* drain chunk and pacing; small chunks keep the low priority work queue
+ * responsive while the UART sends */
+#define CONSOLE_RING_DRAIN_CHUNK	64
+#define CONSOLE_RING_DRAIN_INTERVAL_US	2000
+
+static char g_ring[CONSOLE_RING_SIZE];
+static volatile uint32_t g_head;	/* total bytes ever written */
+static volatile uint32_t g_drain_tail;	/* bytes handed to the real console */
+static volatile uint32_t g_dropped;	/* undrained bytes lost to overwrite */
+
+static int g_console_write_fd = -1;	/* the real console, kept open across the swap */
+static int g_console_read_fd = -1;
+static bool g_installed = false;
+
+static struct work_s g_drain_work;
+static volatile bool g_drain_queued = false;
+
+static void drain_worker(FAR void *arg);
+
+/*
+ * Store bytes in the ring and make sure a drain pass is scheduled. Never
+ * blocks; if the drain cannot keep up the oldest undrained bytes are
+ * overwritten and counted.
+ */
+static void
+ring_put(FAR const char *buffer, size_t buflen)
+{
+	irqstate_t flags = px4_enter_critical_section();
+
+	for (size_t i = 0; i < buflen; i++) {
+		g_ring[g_head % CONSOLE_RING_SIZE] = buffer[i];
+		g_head++;
+	}
+
+	if (g_head - g_drain_tail > CONSOLE_RING_SIZE) {
+		g_dropped += (g_head - g_drain_tail) - CONSOLE_RING_SIZE;
+		g_drain_tail = g_head - CONSOLE_RING_SIZE;
+	}
+
+	const bool need_queue = !g_drain_queued;
+	g_drain_queued = true;
+
+	px4_leave_critical_section(flags);
+
+	if (need_queue) {
+		work_queue(LPWORK, &g_drain_work, drain_worker, NULL, 1);
+	}
+}
+
+static void
+drain_worker(FAR void *arg)
+{
+	char chunk[CONSOLE_RING_DRAIN_CHUNK];
+
+	irqstate_t flags = px4_enter_critical_section();
+
+	uint32_t avail = g_head - g_drain_tail;
+	size_t n = (avail < sizeof(chunk)) ? avail : sizeof(chunk);
+
+	for (size_t i = 0; i < n; i++) {
+		chunk[i] = g_ring[(g_drain_tail + i) % CONSOLE_RING_SIZE];
+	}
+
+	g_drain_tail += n;
+
+	const bool more = (g_head != g_drain_tail);
+	g_drain_queued = more;
+
+	px4_leave_critical_section(flags);
+
+	if (n > 0) {
+		write(g_console_write_fd, chunk, n);
+	}
+
+	if (more) {
+		work_queue(LPWORK, &g_drain_work, drain_worker, NULL,
+			   USEC2TICK(CONSOLE_RING_DRAIN_INTERVAL_US));
+	}
+}
+
+static ssize_t
+console_ring_write(FAR struct file *filep, FAR const char *buffer, size_t buflen)
+{
+	ring_put(buffer, buflen);
+	return buflen;
+}
+
+static ssize_t
+console_ring_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	/* blocks the calling task on the real console, like a plain read */
+	return read(g_console_read_fd, buffer, buflen);
+}
+
+static int
+console_ring_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+	return ioctl(g_console_write_fd, cmd, arg);
+}
+
+static const struct file_operations console_ring_fops = {
+	NULL,			/* open */
+	NULL,			/* close */
+	console_ring_read,	/* read */
+	console_ring_write,	/* write */
+	NULL,			/* seek */
+	console_ring_ioctl	/* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+	, NULL			/* poll */
+#endif
+};
+
+static int
+console_ring_install(void)
+{
+	if (g_installed) {
+		PX4_INFO("already started");
+		return 0;
+	}
+
+	/* keep the real console driver reachable through these descriptors */
+	g_console_write_fd = open("/dev/console", O_WRONLY);
+	g_console_read_fd = open("/dev/console", O_RDONLY);
+
+	if (g_console_write_fd < 0 || g_console_read_fd < 0) {
+		PX4_ERR("could not open /dev/console");
+		return 1;
+	}
+
+	(void)unregister_driver("/dev/console");
+
+	if (register_driver("/dev/console", &console_ring_fops, 0666, NULL) < 0) {
+		PX4_ERR("could not register console wrapper");
+		return 1;
+	}
+
+	g_installed = true;
+	return 0;
+}
+
+/*
+ * Print the retained history. The end position is latched first so output
+ * that itself lands in the ring (serial console session) terminates.
+ */
+static void
+print_history(void)
+{
+	char chunk[128];
+
+	const uint32_t end = g_head;
+	uint32_t pos = (end > CONSOLE_RING_SIZE) ? end - CONSOLE_RING_SIZE : 0;
+
+	while (pos != end) {
+		irqstate_t flags = px4_enter_critical_section();
+
+		/* writers may have overwritten the region we are about to print */
+		if (g_head > CONSOLE_RING_SIZE && pos < g_head - CONSOLE_RING_SIZE) {
+			pos = g_head - CONSOLE_RING_SIZE;
+		}
+
+		uint32_t avail = end - pos;
+		size_t n = (avail < sizeof(chunk)) ? avail : sizeof(chunk);
+
+		for (size_t i = 0; i < n; i++) {
+			chunk[i] = g_ring[(pos + i) % CONSOLE_RING_SIZE];
+		}
+
+		px4_leave_critical_section(flags);
+
+		fwrite(chunk, 1, n, stdout);
+		pos += n;
+	}
+
+	fflush(stdout);
+}
+
+static void
+print_usage(void)
+{
+	PRINT_MODULE_DESCRIPTION("Ring-buffered console.\n"
+				 "Once started, console writes return immediately into a RAM ring that a\n"
+				 "background work item drains to the UART, and the ring keeps the last\n"
+				 "8 KB of console output for later retrieval (e.g. boot messages over USB).");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("dmesg", "command");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Install the console wrapper (early in the startup script)");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("status", "Show buffer usage and drop count");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("", "Without a command, print the retained console history");
+}
+
+int
+dmesg_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		print_history();
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "start")) {
+		return console_ring_install();
+	}
+
+	if (!strcmp(argv[1], "status")) {
+		printf("console ring: %s\n", g_installed ? "started" : "not started");
+		printf("buffer size: %u bytes\n", CONSOLE_RING_SIZE);
+		printf("total written: %u bytes\n", g_head);
+		printf("pending drain: %u bytes\n", g_head - g_drain_tail);
+		printf("dropped: %u bytes\n", g_dropped);
+		return 0;
+	}
+
+	print_usage();
+	return 1;
+}
+
+#endif /* __PX4_NUTTX */
@@ -38,6 +38,7 @@
 
 #include <px4_config.h>
 #include <px4_module.h>
+#include <px4_tasks.h>
 #include <nuttx/compiler.h>
 #include <nuttx/arch.h>
 
@@ -1139,12 +1140,33 @@ static void print_usage(void)
 	PRINT_MODULE_USAGE_ARG("0|1", "Hardfault type: 0=divide by 0, 1=Assertion (default=0)", true);
 
 	PRINT_MODULE_USAGE_COMMAND_DESCR("commit",
-					 "Write uncommited hardfault to /fs/microsd/fault_%i.txt (and rearm, but don't reset)");
+					 "Write uncommited hardfault to /fs/microsd/fault_%i.txt (and rearm, but don't reset). "
+					 "With -b, stream it from a low-priority background task and reset on success");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("count",
 					 "Read the reboot counter, counts the number of reboots of an uncommited hardfault (returned as the exit code of the program)");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("reset", "Reset the reboot counter");
 }
 
+/****************************************************************************
+ * hardfault_commit_worker
+ *
+ * Low-priority task streaming the fault snapshot from BBSRAM to the SD
+ * card after boot has continued. On success the reboot counter is reset,
+ * same as the synchronous commit/reset sequence in rcS.
+ ****************************************************************************/
+static int hardfault_commit_worker(int argc, char *argv[])
+{
+	char *self = "hardfault_log bg";
+
+	int ret = hardfault_commit(self);
+
+	if (ret == OK) {
+		ret = hardfault_increment_reboot(self, true);
+	}
+
+	return ret;
+}
+
 /****************************************************************************
  * Name: hardfault_log_main
  ****************************************************************************/
@@ -1177,6 +1199,20 @@ __EXPORT int hardfault_log_main(int argc, char *argv[])
 
 	} else if (!strcmp(argv[1], "commit")) {
 
+		if (argc > 2 && !strcmp(argv[2], "-b")) {
+			/* The fault snapshot is already safe in BBSRAM; stream it to
+			 * the SD card from a low-priority task so the recovery boot
+			 * is not delayed by seconds of SD writes. */
+			int pid = px4_task_spawn_cmd("hardfault_log",
+						     SCHED_DEFAULT,
+						     SCHED_PRIORITY_DEFAULT - 30,
+						     3100,
+						     hardfault_commit_worker,
+						     NULL);
+
+			return (pid < 0) ? -errno : OK;
+		}
+
 		return hardfault_commit(self);
 
 	} else if (!strcmp(argv[1], "count")) {
@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file heapinfo.c
+ *
+ * Report per-task heap usage gathered by the heap trace wrappers.
+ */
+
+#include <px4_config.h>
+#include <px4_module.h>
+#include <px4_log.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/heap_trace.h>
+
+__EXPORT int heapinfo_main(int argc, char *argv[]);
+
+static void print_usage(void)
+{
+	PRINT_MODULE_DESCRIPTION("Tool to print per-task heap usage (live, peak, allocation rate)");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("heapinfo", "command");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("reset", "Reset the peak and rate counters");
+
+	PRINT_MODULE_USAGE_PARAM_COMMENT("Prints the heap usage table if no arguments given. Requires a build with HEAP_TRACE=ON.");
+}
+
+#ifdef HEAP_TRACE
+
+/* snapshot of the last invocation for allocation rates */
+static uint32_t last_allocs[HEAP_TRACE_MAX_TASKS];
+static hrt_abstime last_print_time;
+
+static void print_heap_table(void)
+{
+	struct heap_trace_task_s snapshot[HEAP_TRACE_MAX_TASKS];
+
+	/* copy under the lock, print outside of it */
+	sched_lock();
+	memcpy(snapshot, heap_trace_tasks, sizeof(snapshot));
+	sched_unlock();
+
+	hrt_abstime now = hrt_absolute_time();
+	float dt = (last_print_time != 0) ? (now - last_print_time) / 1e6f : 0.0f;
+
+	printf("%5s %-16s %10s %10s %10s %12s %10s\n",
+	       "PID", "NAME", "LIVE", "PEAK", "ALLOCS", "ALLOC BYTES", "ALLOC/S");
+
+	for (int i = 0; i < HEAP_TRACE_MAX_TASKS; i++) {
+		if (snapshot[i].pid == -1) {
+			continue;
+		}
+
+		float rate = 0.0f;
+
+		if (dt > 0.0f && snapshot[i].allocs >= last_allocs[i]) {
+			rate = (snapshot[i].allocs - last_allocs[i]) / dt;
+		}
+
+		printf("%5d %-16s %10u %10u %10u %12u %10.1f\n",
+		       snapshot[i].pid,
+		       snapshot[i].name,
+		       snapshot[i].live,
+		       snapshot[i].peak,
+		       snapshot[i].allocs,
+		       snapshot[i].alloc_bytes,
+		       (double)rate);
+
+		last_allocs[i] = snapshot[i].allocs;
+	}
+
+	last_print_time = now;
+}
+
+#endif /* HEAP_TRACE */
+
+int heapinfo_main(int argc, char *argv[])
+{
+#ifdef HEAP_TRACE
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") == 0) {
+			heap_trace_reset();
+			memset(last_allocs, 0, sizeof(last_allocs));
+			return 0;
+		}
+
+		print_usage();
+		return -1;
+	}
+
+	print_heap_table();
+	fflush(stdout);
+	return 0;
+
+#else
+	(void)argc;
+	(void)argv;
+	PX4_ERR("heap tracing not compiled in, build with HEAP_TRACE=ON");
+	return 1;
+#endif
+}
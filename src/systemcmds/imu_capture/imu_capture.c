@@ -0,0 +1,183 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file imu_capture.c
+ *
+ * Lossless high-rate IMU capture for vibration surveys.
+ *
+ * Starts a raw capture on an IMU driver (see drv_imu_capture.h) and
+ * drains the driver's ring buffer to a file. The stream bypasses uORB
+ * and the logger, so an 8 kHz survey does not touch the flight logging
+ * path.
+ */
+
+#include <px4_config.h>
+#include <px4_getopt.h>
+#include <px4_module.h>
+#include <px4_posix.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <drivers/drv_hrt.h>
+#include <drivers/drv_accel.h>
+#include <drivers/drv_imu_capture.h>
+
+__EXPORT int imu_capture_main(int argc, char *argv[]);
+
+/* drain interval and chunk size; at 8 kHz the driver produces about
+ * 1.2 kB per 10 ms, so one chunk always keeps up */
+#define IMU_CAPTURE_DRAIN_INTERVAL	10000
+#define IMU_CAPTURE_CHUNK_SIZE		2048
+
+static void print_usage(void)
+{
+	PRINT_MODULE_DESCRIPTION("Capture raw high-rate IMU data to a file.\n"
+				 "The driver copies its raw FIFO bursts into a ring buffer which this\n"
+				 "command drains to the given file, bypassing uORB and the logger.\n"
+				 "The file format is described in drv_imu_capture.h.");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("imu_capture", "command");
+	PRINT_MODULE_USAGE_PARAM_STRING('f', "/fs/microsd/imu_capture.bin", "<file>", "Output file", true);
+	PRINT_MODULE_USAGE_PARAM_INT('t', 10, 1, 60, "Capture duration in seconds", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('d', ACCEL0_DEVICE_PATH, "<file:dev>", "IMU device", true);
+}
+
+int
+imu_capture_main(int argc, char *argv[])
+{
+	const char *filename = PX4_ROOTFSDIR"/fs/microsd/imu_capture.bin";
+	const char *device = ACCEL0_DEVICE_PATH;
+	unsigned duration_s = 10;
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = NULL;
+
+	while ((ch = px4_getopt(argc, argv, "f:t:d:h", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'f':
+			filename = myoptarg;
+			break;
+
+		case 't':
+			duration_s = strtoul(myoptarg, NULL, 0);
+			break;
+
+		case 'd':
+			device = myoptarg;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (duration_s < 1 || duration_s > 60) {
+		PX4_ERR("duration out of range (1..60 s)");
+		return 1;
+	}
+
+	int fd = px4_open(device, 0);
+
+	if (fd < 0) {
+		PX4_ERR("failed to open %s", device);
+		return 1;
+	}
+
+	int out = open(filename, O_CREAT | O_WRONLY | O_TRUNC, PX4_O_MODE_666);
+
+	if (out < 0) {
+		PX4_ERR("failed to open %s", filename);
+		px4_close(fd);
+		return 1;
+	}
+
+	int ret = px4_ioctl(fd, IMUCAPIOCSTART, duration_s);
+
+	if (ret != 0) {
+		PX4_ERR("capture start failed (%d) - driver not in FIFO mode?", ret);
+		close(out);
+		px4_close(fd);
+		return 1;
+	}
+
+	const hrt_abstime deadline = hrt_absolute_time() + duration_s * 1000000ULL;
+	uint8_t chunk[IMU_CAPTURE_CHUNK_SIZE];
+	struct imu_capture_fetch_s fetch = { .buffer = chunk, .length = sizeof(chunk) };
+	unsigned long total = 0;
+	bool write_failed = false;
+
+	for (;;) {
+		usleep(IMU_CAPTURE_DRAIN_INTERVAL);
+
+		int n = px4_ioctl(fd, IMUCAPIOCFETCH, (unsigned long)&fetch);
+
+		if (n < 0) {
+			PX4_ERR("capture fetch failed (%d)", n);
+			break;
+		}
+
+		if (n > 0 && !write_failed) {
+			if (write(out, chunk, n) != n) {
+				/* keep draining so the driver can finish cleanly */
+				PX4_ERR("short write to %s", filename);
+				write_failed = true;
+			}
+
+			total += n;
+		}
+
+		/* done once the duration has elapsed and the ring is drained */
+		if (n == 0 && hrt_absolute_time() > deadline) {
+			break;
+		}
+	}
+
+	px4_ioctl(fd, IMUCAPIOCSTOP, 0);
+	px4_close(fd);
+	fsync(out);
+	close(out);
+
+	if (write_failed) {
+		return 1;
+	}
+
+	PX4_INFO("captured %lu bytes from %s to %s", total, device, filename);
+	return 0;
+}
@@ -200,6 +200,7 @@ int mtd_main(int argc, char *argv[])
 struct mtd_dev_s *ramtron_initialize(FAR struct spi_dev_s *dev);
 struct mtd_dev_s *mtd_partition(FAR struct mtd_dev_s *mtd,
 				off_t firstblock, off_t nblocks);
+struct mtd_dev_s *mtd_combine_initialize(FAR struct mtd_dev_s *parent);
 
 #ifdef CONFIG_MTD_RAMTRON
 static int
@@ -345,6 +346,10 @@ mtd_start(char *partition_names[], unsigned n_partitions)
 			return 1;
 		}
 
+		/* wrap the partition in the write-combining and verify layer
+		 * (falls back to the bare partition on allocation failure) */
+		part[i] = mtd_combine_initialize(part[i]);
+
 		/* Initialize to provide an FTL block driver on the MTD FLASH interface */
 
 		snprintf(blockname, sizeof(blockname), "/dev/mtdblock%d", i);
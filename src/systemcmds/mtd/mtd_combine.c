@@ -0,0 +1,321 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mtd_combine.c
+ *
+ * Write-combining MTD layer for the FRAM/EEPROM partitions.
+ *
+ * The FTL/bch stack above the MTD partitions issues one small block write
+ * per sector, and each of those costs a full bus transaction with fixed
+ * overhead. This layer stages adjacent block writes in RAM and flushes
+ * them as a single bwrite to the parent device, followed by one readback
+ * pass that verifies the data with a CRC32 comparison. A param_save then
+ * costs a handful of large transactions instead of dozens of small ones,
+ * and the shorter bus occupancy leaves more room for px4io traffic.
+ *
+ * Staged data is bounded in time: a low-priority work queue entry flushes
+ * the stage at the latest MTD_COMBINE_WINDOW_US after the first write, so
+ * an fsync-style write burst that ends mid-stage is persisted shortly
+ * after.
+ */
+
+#include <px4_config.h>
+
+#ifdef CONFIG_MTD
+
+#include <px4_defines.h>
+#include <px4_log.h>
+#include <px4_sem.h>
+#include <px4_workqueue.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <crc32.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mtd/mtd.h>
+
+#include <drivers/drv_hrt.h>
+
+#include "systemlib/perf_counter.h"
+
+/* maximum number of blocks staged before a flush is forced; with the usual
+ * 512 byte partition block size this is a 2 KiB stage buffer */
+#define MTD_COMBINE_MAX_BLOCKS	4
+
+/* maximum time a staged write may wait for neighbours [us] */
+#define MTD_COMBINE_WINDOW_US	(50 * 1000)
+
+struct mtd_combine_dev_s {
+	struct mtd_dev_s mtd;		/* our MTD interface (must be first) */
+	FAR struct mtd_dev_s *parent;	/* wrapped partition device */
+	uint32_t blocksize;
+	off_t stage_start;		/* first staged block, -1 = stage empty */
+	size_t stage_nblocks;
+	FAR uint8_t *stage_buf;		/* MTD_COMBINE_MAX_BLOCKS * blocksize */
+	FAR uint8_t *verify_buf;	/* readback buffer, same size */
+	px4_sem_t lock;
+	struct work_s work;
+	bool work_queued;
+
+	perf_counter_t perf_flushes;
+	perf_counter_t perf_combined;
+	perf_counter_t perf_verify_errors;
+};
+
+static void combine_lock(FAR struct mtd_combine_dev_s *priv)
+{
+	do {} while (px4_sem_wait(&priv->lock) != 0);
+}
+
+static void combine_unlock(FAR struct mtd_combine_dev_s *priv)
+{
+	px4_sem_post(&priv->lock);
+}
+
+/*
+ * Write the staged blocks to the parent device and verify them with a
+ * single readback pass. Must be called with the lock held.
+ */
+static int combine_flush(FAR struct mtd_combine_dev_s *priv)
+{
+	if (priv->stage_nblocks == 0) {
+		return OK;
+	}
+
+	const off_t start = priv->stage_start;
+	const size_t nblocks = priv->stage_nblocks;
+	const size_t nbytes = nblocks * priv->blocksize;
+
+	perf_count(priv->perf_flushes);
+
+	/* one write, then one verified readback; a single retry covers
+	 * transient bus upsets */
+	for (int attempt = 0; attempt < 2; attempt++) {
+		if (priv->parent->bwrite(priv->parent, start, nblocks, priv->stage_buf) != (ssize_t)nblocks) {
+			continue;
+		}
+
+		if (priv->parent->bread(priv->parent, start, nblocks, priv->verify_buf) != (ssize_t)nblocks) {
+			continue;
+		}
+
+		if (crc32(priv->stage_buf, nbytes) == crc32(priv->verify_buf, nbytes)) {
+			priv->stage_nblocks = 0;
+			priv->stage_start = -1;
+			return OK;
+		}
+
+		perf_count(priv->perf_verify_errors);
+	}
+
+	PX4_ERR("mtd write verify failed (block %lu, %u blocks)", (unsigned long)start, (unsigned)nblocks);
+	priv->stage_nblocks = 0;
+	priv->stage_start = -1;
+	return -EIO;
+}
+
+static void combine_flush_worker(FAR void *arg)
+{
+	FAR struct mtd_combine_dev_s *priv = (FAR struct mtd_combine_dev_s *)arg;
+
+	combine_lock(priv);
+	priv->work_queued = false;
+	combine_flush(priv);
+	combine_unlock(priv);
+}
+
+/*
+ * Bound the staging latency: make sure a flush runs at the latest
+ * MTD_COMBINE_WINDOW_US from now. Must be called with the lock held.
+ */
+static void combine_schedule_flush(FAR struct mtd_combine_dev_s *priv)
+{
+	if (!priv->work_queued) {
+		priv->work_queued = true;
+		work_queue(LPWORK, &priv->work, combine_flush_worker, priv,
+			   USEC2TICK(MTD_COMBINE_WINDOW_US));
+	}
+}
+
+static int combine_erase(FAR struct mtd_dev_s *dev, off_t startblock, size_t nblocks)
+{
+	FAR struct mtd_combine_dev_s *priv = (FAR struct mtd_combine_dev_s *)dev;
+
+	combine_lock(priv);
+	combine_flush(priv);
+	combine_unlock(priv);
+
+	return priv->parent->erase(priv->parent, startblock, nblocks);
+}
+
+static ssize_t combine_bread(FAR struct mtd_dev_s *dev, off_t startblock,
+			     size_t nblocks, FAR uint8_t *buffer)
+{
+	FAR struct mtd_combine_dev_s *priv = (FAR struct mtd_combine_dev_s *)dev;
+
+	combine_lock(priv);
+
+	/* reads overlapping the stage force it out first */
+	if (priv->stage_nblocks > 0
+	    && startblock < priv->stage_start + (off_t)priv->stage_nblocks
+	    && startblock + (off_t)nblocks > priv->stage_start) {
+		combine_flush(priv);
+	}
+
+	combine_unlock(priv);
+
+	return priv->parent->bread(priv->parent, startblock, nblocks, buffer);
+}
+
+static ssize_t combine_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
+			      size_t nblocks, FAR const uint8_t *buffer)
+{
+	FAR struct mtd_combine_dev_s *priv = (FAR struct mtd_combine_dev_s *)dev;
+
+	if (nblocks > MTD_COMBINE_MAX_BLOCKS) {
+		/* a large write gains nothing from staging: flush and pass through */
+		combine_lock(priv);
+		combine_flush(priv);
+		combine_unlock(priv);
+
+		return priv->parent->bwrite(priv->parent, startblock, nblocks, buffer);
+	}
+
+	combine_lock(priv);
+
+	if (priv->stage_nblocks > 0
+	    && startblock >= priv->stage_start
+	    && startblock <= priv->stage_start + (off_t)priv->stage_nblocks
+	    && startblock + (off_t)nblocks <= priv->stage_start + MTD_COMBINE_MAX_BLOCKS) {
+
+		/* adjacent (or overwriting) blocks within the window: combine */
+		perf_count(priv->perf_combined);
+
+	} else {
+		/* not combinable: flush whatever is staged and start over */
+		combine_flush(priv);
+		priv->stage_start = startblock;
+	}
+
+	memcpy(priv->stage_buf + (startblock - priv->stage_start) * priv->blocksize,
+	       buffer, nblocks * priv->blocksize);
+
+	const size_t stage_end = (startblock - priv->stage_start) + nblocks;
+
+	if (stage_end > priv->stage_nblocks) {
+		priv->stage_nblocks = stage_end;
+	}
+
+	if (priv->stage_nblocks >= MTD_COMBINE_MAX_BLOCKS) {
+		combine_flush(priv);
+
+	} else {
+		combine_schedule_flush(priv);
+	}
+
+	combine_unlock(priv);
+
+	return nblocks;
+}
+
+static int combine_ioctl(FAR struct mtd_dev_s *dev, int cmd, unsigned long arg)
+{
+	FAR struct mtd_combine_dev_s *priv = (FAR struct mtd_combine_dev_s *)dev;
+
+	/* nothing below may observe stale data */
+	combine_lock(priv);
+	combine_flush(priv);
+	combine_unlock(priv);
+
+	return priv->parent->ioctl(priv->parent, cmd, arg);
+}
+
+/****************************************************************************
+ * Name: mtd_combine_initialize
+ *
+ * Description:
+ *   Wrap an MTD partition device in the write-combining layer. On any
+ *   failure the parent device is returned unchanged, so the caller can use
+ *   the result either way.
+ *
+ ****************************************************************************/
+
+FAR struct mtd_dev_s *mtd_combine_initialize(FAR struct mtd_dev_s *parent)
+{
+	struct mtd_geometry_s geo;
+
+	if (parent == NULL || parent->ioctl(parent, MTDIOC_GEOMETRY, (unsigned long)((uintptr_t)&geo)) < 0) {
+		return parent;
+	}
+
+	FAR struct mtd_combine_dev_s *priv = kmm_zalloc(sizeof(struct mtd_combine_dev_s));
+
+	if (priv == NULL) {
+		return parent;
+	}
+
+	priv->stage_buf = kmm_malloc(MTD_COMBINE_MAX_BLOCKS * geo.blocksize);
+	priv->verify_buf = kmm_malloc(MTD_COMBINE_MAX_BLOCKS * geo.blocksize);
+
+	if (priv->stage_buf == NULL || priv->verify_buf == NULL) {
+		kmm_free(priv->stage_buf);
+		kmm_free(priv->verify_buf);
+		kmm_free(priv);
+		return parent;
+	}
+
+	priv->parent = parent;
+	priv->blocksize = geo.blocksize;
+	priv->stage_start = -1;
+
+	priv->mtd.erase = combine_erase;
+	priv->mtd.bread = combine_bread;
+	priv->mtd.bwrite = combine_bwrite;
+	priv->mtd.ioctl = combine_ioctl;
+
+	px4_sem_init(&priv->lock, 0, 1);
+
+	priv->perf_flushes = perf_alloc(PC_COUNT, "mtd_flush");
+	priv->perf_combined = perf_alloc(PC_COUNT, "mtd_combined");
+	priv->perf_verify_errors = perf_alloc(PC_COUNT, "mtd_verify_err");
+
+	return (FAR struct mtd_dev_s *)priv;
+}
+
+#endif /* CONFIG_MTD */
@@ -0,0 +1,255 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file profiler.c
+ *
+ * Statistical sampling profiler. An hrt_call fires at a fixed rate and records
+ * the program counter and link register of whatever the timer interrupt
+ * preempted, aggregating the samples into a flat on-target hash table. Unlike
+ * the perf counters this needs no instrumentation in the profiled code.
+ *
+ * Resolve the dumped addresses on the host, e.g.:
+ *   arm-none-eabi-addr2line -f -e firmware.elf <pc> ...
+ */
+
+#include <px4_config.h>
+#include <px4_module.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <drivers/drv_hrt.h>
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+#include <px4_micro_hal.h>
+#include "up_internal.h"
+#endif
+
+__EXPORT int profiler_main(int argc, char *argv[]);
+
+#ifdef __PX4_NUTTX
+
+/* power of two so the hash can use mask indexing; sized for ~100 distinct
+ * hot locations which is plenty for a flat profile of one firmware image */
+#define PROFILER_TABLE_SIZE	512
+#define PROFILER_TABLE_MASK	(PROFILER_TABLE_SIZE - 1)
+
+#define PROFILER_DEFAULT_RATE_HZ	250
+
+/* one aggregated sample location. A zero pc marks a free slot */
+struct profiler_entry {
+	uint32_t pc;
+	uint32_t lr;	/* lr of the first sample that hit this pc, to disambiguate leaves */
+	uint32_t count;
+};
+
+static struct profiler_entry _table[PROFILER_TABLE_SIZE];
+
+static struct hrt_call _profiler_call;
+static bool _running = false;
+static unsigned _rate_hz = PROFILER_DEFAULT_RATE_HZ;
+
+static uint32_t _total_samples = 0;
+static uint32_t _dropped_samples = 0;	/* samples lost because the table was full */
+
+/*
+ * hrt callback, runs in interrupt context. The context of the preempted task
+ * is in CURRENT_REGS (same mechanism board_crashdump() uses).
+ */
+static void profiler_sample(void *arg)
+{
+	if (!CURRENT_REGS) {
+		return;
+	}
+
+	uint32_t pc = ((uint32_t *)CURRENT_REGS)[REG_PC];
+	uint32_t lr = ((uint32_t *)CURRENT_REGS)[REG_LR];
+
+	_total_samples++;
+
+	/* open addressing with linear probing; bounded so a full table cannot
+	 * stall the timer interrupt */
+	unsigned index = (pc >> 2) & PROFILER_TABLE_MASK;
+
+	for (unsigned probe = 0; probe < PROFILER_TABLE_SIZE; probe++) {
+		struct profiler_entry *entry = &_table[index];
+
+		if (entry->pc == pc) {
+			entry->count++;
+			return;
+		}
+
+		if (entry->pc == 0) {
+			entry->pc = pc;
+			entry->lr = lr;
+			entry->count = 1;
+			return;
+		}
+
+		index = (index + 1) & PROFILER_TABLE_MASK;
+	}
+
+	_dropped_samples++;
+}
+
+static void profiler_start(unsigned rate_hz)
+{
+	if (_running) {
+		printf("already running at %u Hz\n", _rate_hz);
+		return;
+	}
+
+	_rate_hz = rate_hz;
+	hrt_call_every(&_profiler_call, 1000000 / _rate_hz, 1000000 / _rate_hz, profiler_sample, NULL);
+	_running = true;
+	printf("sampling at %u Hz\n", _rate_hz);
+}
+
+static void profiler_stop(void)
+{
+	if (!_running) {
+		return;
+	}
+
+	hrt_cancel(&_profiler_call);
+	_running = false;
+}
+
+static void profiler_reset(void)
+{
+	/* keep the sampler from racing the reset */
+	irqstate_t flags = px4_enter_critical_section();
+
+	memset(_table, 0, sizeof(_table));
+	_total_samples = 0;
+	_dropped_samples = 0;
+
+	px4_leave_critical_section(flags);
+}
+
+static void profiler_dump(void)
+{
+	if (_total_samples == 0) {
+		printf("no samples\n");
+		return;
+	}
+
+	printf("samples: %lu (dropped: %lu), rate: %u Hz, %s\n",
+	       (unsigned long)_total_samples, (unsigned long)_dropped_samples,
+	       _rate_hz, _running ? "running" : "stopped");
+	printf("%-10s %-10s %8s %6s\n", "PC", "LR", "COUNT", "PCT");
+
+	for (unsigned i = 0; i < PROFILER_TABLE_SIZE; i++) {
+		/* snapshot the entry; the sampler may still be running */
+		struct profiler_entry entry = _table[i];
+
+		if (entry.pc == 0) {
+			continue;
+		}
+
+		printf("0x%08lx 0x%08lx %8lu %5lu%%\n",
+		       (unsigned long)entry.pc, (unsigned long)entry.lr,
+		       (unsigned long)entry.count,
+		       (unsigned long)(entry.count * 100 / _total_samples));
+	}
+
+	fflush(stdout);
+}
+
+#endif /* __PX4_NUTTX */
+
+static void print_usage(void)
+{
+	PRINT_MODULE_DESCRIPTION(
+		"Statistical sampling profiler. A high-resolution timer callback periodically records\n"
+		"the program counter of the preempted code and aggregates the samples on-target, so\n"
+		"hot paths show up without adding perf counters to them first.\n"
+		"\n"
+		"Dump the table via the nsh console or the MAVLink shell and resolve the addresses on\n"
+		"the host with addr2line against the matching .elf file.");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("profiler", "command");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Start sampling");
+	PRINT_MODULE_USAGE_PARAM_INT('r', 250, 50, 10000, "Sampling rate in Hz", true);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("stop", "Stop sampling (the table is kept)");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("dump", "Print the aggregated samples");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("reset", "Clear the sample table");
+}
+
+int profiler_main(int argc, char *argv[])
+{
+#ifdef __PX4_NUTTX
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "start") == 0) {
+			unsigned rate_hz = PROFILER_DEFAULT_RATE_HZ;
+
+			if (argc > 3 && strcmp(argv[2], "-r") == 0) {
+				rate_hz = strtoul(argv[3], NULL, 0);
+
+				if (rate_hz < 50 || rate_hz > 10000) {
+					printf("invalid rate %u\n", rate_hz);
+					return -1;
+				}
+			}
+
+			profiler_start(rate_hz);
+			return 0;
+
+		} else if (strcmp(argv[1], "stop") == 0) {
+			profiler_stop();
+			return 0;
+
+		} else if (strcmp(argv[1], "dump") == 0) {
+			profiler_dump();
+			return 0;
+
+		} else if (strcmp(argv[1], "reset") == 0) {
+			profiler_reset();
+			return 0;
+		}
+	}
+
+	print_usage();
+	return -1;
+
+#else
+	print_usage();
+	printf("profiler is only supported on NuttX targets\n");
+	return -1;
+#endif
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file scope_trace_main.c
+ *
+ * Arm, disarm and dump the scoped-zone trace ring.
+ */
+
+#include <px4_config.h>
+#include <px4_module.h>
+#include <px4_log.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <systemlib/scope_trace.h>
+
+__EXPORT int scope_trace_main(int argc, char *argv[]);
+
+static void print_usage(void)
+{
+	PRINT_MODULE_DESCRIPTION("Tool to trace instrumented code zones (see systemlib/scope_trace.h)");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("scope_trace", "command");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Allocate the event ring and arm tracing");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("stop", "Disarm tracing and free the event ring");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("dump", "Print a per-zone timing summary");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("events", "Print the raw event list, oldest first");
+}
+
+int scope_trace_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		print_usage();
+		return 1;
+	}
+
+	if (strcmp(argv[1], "start") == 0) {
+		return (scope_trace_start() == 0) ? 0 : 1;
+	}
+
+	if (strcmp(argv[1], "stop") == 0) {
+		scope_trace_stop();
+		return 0;
+	}
+
+	if (strcmp(argv[1], "dump") == 0) {
+		scope_trace_dump();
+		fflush(stdout);
+		return 0;
+	}
+
+	if (strcmp(argv[1], "events") == 0) {
+		scope_trace_dump_events();
+		fflush(stdout);
+		return 0;
+	}
+
+	print_usage();
+	return 1;
+}
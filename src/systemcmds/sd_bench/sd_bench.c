@@ -55,6 +55,9 @@ static void	usage(void);
 /** sequential write speed test */
 static void	write_test(int fd, uint8_t *block, int block_size);
 
+/** logger access pattern test: periodic fsync, optional interleaved reads */
+static void	logger_test(int fd, uint8_t *block, int block_size);
+
 /**
  * Measure the time for fsync.
  * @param fd
@@ -69,6 +72,12 @@ static const char *BENCHMARK_FILE = PX4_ROOTFSDIR"/fs/microsd/benchmark.tmp";
 static int num_runs; ///< number of runs
 static int run_duration; ///< duration of a single run [ms]
 static bool synchronized; ///< call fsync after each block?
+static bool logger_pattern; ///< use the logger access pattern instead of sequential writes?
+static int sync_cadence; ///< logger pattern: blocks between fsync calls
+static bool interleaved_reads; ///< logger pattern: interleave reads to simulate a download
+
+/** maximum write latency samples kept per run for the percentiles */
+#define MAX_LATENCY_SAMPLES 2048
 
 static void
 usage()
@@ -80,6 +89,9 @@ usage()
 	PRINT_MODULE_USAGE_PARAM_INT('r', 5, 1, 1000, "Number of runs", true);
 	PRINT_MODULE_USAGE_PARAM_INT('d', 2000, 1, 100000, "Duration of a run in ms", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('s', "Call fsync after each block (default=at end of each run)", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('l', "Use the logger access pattern (periodic fsync) and report write latency percentiles", true);
+	PRINT_MODULE_USAGE_PARAM_INT('S', 32, 1, 10000, "Logger pattern: number of blocks between fsync calls", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('R', "Logger pattern: interleave reads to simulate a concurrent download", true);
 }
 
 int
@@ -92,8 +104,11 @@ sd_bench_main(int argc, char *argv[])
 	synchronized = false;
 	num_runs = 5;
 	run_duration = 2000;
+	logger_pattern = false;
+	sync_cadence = 32;
+	interleaved_reads = false;
 
-	while ((ch = px4_getopt(argc, argv, "b:r:d:s", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "b:r:d:slS:R", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'b':
 			block_size = strtol(myoptarg, NULL, 0);
@@ -111,6 +126,18 @@ sd_bench_main(int argc, char *argv[])
 			synchronized = true;
 			break;
 
+		case 'l':
+			logger_pattern = true;
+			break;
+
+		case 'S':
+			sync_cadence = strtol(myoptarg, NULL, 0);
+			break;
+
+		case 'R':
+			interleaved_reads = true;
+			break;
+
 		default:
 			usage();
 			return -1;
@@ -118,7 +145,7 @@ sd_bench_main(int argc, char *argv[])
 		}
 	}
 
-	if (block_size <= 0 || num_runs <= 0) {
+	if (block_size <= 0 || num_runs <= 0 || sync_cadence <= 0) {
 		PX4_ERR("invalid argument");
 		return -1;
 	}
@@ -143,8 +170,15 @@ sd_bench_main(int argc, char *argv[])
 		block[i] = (uint8_t)i;
 	}
 
-	PX4_INFO("Using block size = %i bytes, sync=%i", block_size, (int)synchronized);
-	write_test(bench_fd, block, block_size);
+	if (logger_pattern) {
+		PX4_INFO("Using block size = %i bytes, fsync every %i blocks, reads=%i",
+			 block_size, sync_cadence, (int)interleaved_reads);
+		logger_test(bench_fd, block, block_size);
+
+	} else {
+		PX4_INFO("Using block size = %i bytes, sync=%i", block_size, (int)synchronized);
+		write_test(bench_fd, block, block_size);
+	}
 
 	free(block);
 	close(bench_fd);
@@ -212,3 +246,114 @@ void write_test(int fd, uint8_t *block, int block_size)
 
 	PX4_INFO("  Avg   : %8.2lf KB/s", (double)block_size * total_blocks / total_elapsed / 1024.);
 }
+
+static int compare_latency(const void *a, const void *b)
+{
+	return (int)(*(const uint32_t *)a - * (const uint32_t *)b);
+}
+
+void logger_test(int fd, uint8_t *block, int block_size)
+{
+	PX4_INFO("");
+	PX4_INFO("Testing Logger Access Pattern...");
+
+	uint32_t *latencies = (uint32_t *)malloc(MAX_LATENCY_SAMPLES * sizeof(uint32_t));
+
+	if (!latencies) {
+		PX4_ERR("Failed to allocate latency buffer");
+		return;
+	}
+
+	int read_fd = -1;
+	off_t read_offset = 0;
+
+	if (interleaved_reads) {
+		read_fd = open(BENCHMARK_FILE, O_RDONLY);
+
+		if (read_fd < 0) {
+			PX4_ERR("Can't open benchmark file for reading");
+			free(latencies);
+			return;
+		}
+	}
+
+	off_t write_offset = 0;
+
+	for (int run = 0; run < num_runs; ++run) {
+		hrt_abstime start = hrt_absolute_time();
+		unsigned int num_blocks = 0;
+		unsigned int num_samples = 0;
+		unsigned int max_fsync_time = 0;
+
+		while (hrt_elapsed_time(&start) < run_duration * 1000) {
+
+			// one block write plus any fsync due at this block is what
+			// the logger waits for, so time them as a single sample
+			hrt_abstime write_start = hrt_absolute_time();
+			size_t written = write(fd, block, block_size);
+
+			if ((int)written != block_size) {
+				PX4_ERR("Write error");
+				free(latencies);
+
+				if (read_fd >= 0) {
+					close(read_fd);
+				}
+
+				return;
+			}
+
+			if ((num_blocks + 1) % sync_cadence == 0) {
+				unsigned int fsync_time = time_fsync(fd);
+
+				if (fsync_time > max_fsync_time) {
+					max_fsync_time = fsync_time;
+				}
+			}
+
+			uint32_t write_time = hrt_elapsed_time(&write_start);
+
+			if (num_samples < MAX_LATENCY_SAMPLES) {
+				latencies[num_samples++] = write_time;
+			}
+
+			++num_blocks;
+			write_offset += block_size;
+
+			// a downloading client reads the file sequentially while
+			// the logger keeps writing; interleave one read per write
+			if (read_fd >= 0) {
+				if (read_offset + block_size > write_offset) {
+					read_offset = 0;
+					lseek(read_fd, 0, SEEK_SET);
+				}
+
+				if (read(read_fd, block, block_size) == block_size) {
+					read_offset += block_size;
+				}
+			}
+		}
+
+		fsync(fd);
+
+		if (num_samples == 0) {
+			continue;
+		}
+
+		qsort(latencies, num_samples, sizeof(uint32_t), compare_latency);
+
+		double elapsed = hrt_elapsed_time(&start) / 1.e6;
+		PX4_INFO("  Run %2i: %8.2lf KB/s, latency p50: %lu us, p99: %lu us, max: %lu us, max fsync: %u ms", run,
+			 (double)block_size * num_blocks / elapsed / 1024.,
+			 (unsigned long)latencies[num_samples / 2],
+			 (unsigned long)latencies[(unsigned int)(num_samples * 99ull / 100)],
+			 (unsigned long)latencies[num_samples - 1],
+			 max_fsync_time);
+	}
+
+	if (read_fd >= 0) {
+		close(read_fd);
+	}
+
+	free(latencies);
+}
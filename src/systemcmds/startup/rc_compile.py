@@ -0,0 +1,177 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+"""
+rc_compile.py <script> <name> [<script> <name> ...]
+
+Translate init.d startup scripts into the flat instruction tables
+executed by the 'startup' systemcmd (see rc_script.h). Only the
+restricted shell subset actually used by the init.d scripts is
+supported:
+
+    # comment
+    command args...
+    set VAR VALUE
+    if command args...    /    if [ $VAR ==|!= VALUE ]
+    then / else / fi      (nesting allowed)
+
+Anything else is a hard error so unsupported scripts fail the build
+instead of silently misbooting.
+
+The generated C source is written to stdout.
+"""
+
+from __future__ import print_function
+
+import sys
+
+MAX_ARGS = 8
+
+
+def error(script, lineno, msg):
+    print("rc_compile.py: %s:%d: %s" % (script, lineno, msg), file=sys.stderr)
+    sys.exit(1)
+
+
+def compile_script(path, name):
+    insns = []          # list of [op, args, target]
+    # stack of pending branches: [insn_index, saw_else]
+    stack = []
+
+    with open(path, "r") as f:
+        lines = f.readlines()
+
+    for lineno, line in enumerate(lines, 1):
+        line = line.strip()
+
+        if line == "" or line.startswith("#"):
+            continue
+
+        tokens = line.split()
+
+        if tokens[0] == "then":
+            continue
+
+        if tokens[0] == "if":
+            cond = tokens[1:]
+
+            if not cond:
+                error(path, lineno, "empty if condition")
+
+            if cond[0] == "[":
+                if len(cond) != 5 or cond[4] != "]" or cond[2] not in ("==", "!="):
+                    error(path, lineno, "unsupported test: %s" % line)
+
+                insns.append(["RC_OP_TEST_VAR", [cond[1], cond[2], cond[3]], -1])
+
+            else:
+                insns.append(["RC_OP_TEST", cond, -1])
+
+            stack.append([len(insns) - 1, False])
+            continue
+
+        if tokens[0] == "else":
+            if not stack or stack[-1][1]:
+                error(path, lineno, "else without matching if")
+
+            # terminate the true branch, route the test here
+            insns.append(["RC_OP_JUMP", [], -1])
+            insns[stack[-1][0]][2] = len(insns)
+            stack[-1] = [len(insns) - 1, True]
+            continue
+
+        if tokens[0] == "fi":
+            if not stack:
+                error(path, lineno, "fi without matching if")
+
+            insns[stack[-1][0]][2] = len(insns)
+            stack.pop()
+            continue
+
+        if tokens[0] == "set":
+            if len(tokens) != 3:
+                error(path, lineno, "set needs exactly two arguments")
+
+            insns.append(["RC_OP_SET", tokens[1:], 0])
+            continue
+
+        if tokens[0] in ("unset", "sh", "sleep"):
+            error(path, lineno, "unsupported command: %s" % tokens[0])
+
+        if len(tokens) > MAX_ARGS:
+            error(path, lineno, "too many arguments: %s" % line)
+
+        insns.append(["RC_OP_EXEC", tokens, 0])
+
+    if stack:
+        error(path, len(lines), "unterminated if")
+
+    insns.append(["RC_OP_END", [], 0])
+
+    print("static const struct rc_insn %s_insns[] = {" % name)
+
+    for op, args, target in insns:
+        argv = ", ".join('"%s"' % a.replace('"', '\\"') for a in args) if args else "0"
+        print("\t{%s, %u, %d, {%s}}," % (op, len(args), target, argv))
+
+    print("};")
+    print("")
+
+
+def main():
+    if len(sys.argv) < 3 or len(sys.argv) % 2 == 0:
+        print(__doc__, file=sys.stderr)
+        sys.exit(1)
+
+    pairs = list(zip(sys.argv[1::2], sys.argv[2::2]))
+
+    print("/* startup script tables - automatically generated by rc_compile.py, do not edit */")
+    print("")
+    print('#include "rc_script.h"')
+    print("")
+
+    for path, name in pairs:
+        compile_script(path, name)
+
+    print("const struct rc_script rc_compiled_scripts[] = {")
+
+    for _, name in pairs:
+        print('\t{"%s", %s_insns},' % (name, name))
+
+    print("\t{0, 0},")
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,75 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file rc_script.h
+ *
+ * Instruction format for startup scripts compiled at build time by
+ * rc_compile.py. The compiler turns the restricted init.d shell subset
+ * (commands, if/then/else/fi on command exit codes or [ $VAR op VAL ]
+ * tests, set) into a flat instruction table that the 'startup' command
+ * executes without an nsh interpreter instance per line.
+ */
+
+#ifndef _SYSTEMCMDS_RC_SCRIPT_H
+#define _SYSTEMCMDS_RC_SCRIPT_H
+
+#include <stdint.h>
+
+#define RC_MAX_ARGS	8
+
+enum rc_opcode {
+	RC_OP_END = 0,		/**< end of script */
+	RC_OP_EXEC,		/**< run command, ignore the exit code */
+	RC_OP_TEST,		/**< run command, jump to target if it fails */
+	RC_OP_TEST_VAR,		/**< [ lhs op rhs ], jump to target if false */
+	RC_OP_JUMP,		/**< unconditional jump to target */
+	RC_OP_SET		/**< set variable argv[0] to argv[1] */
+};
+
+struct rc_insn {
+	uint8_t		op;		/**< enum rc_opcode */
+	uint8_t		nargs;
+	int16_t		target;		/**< jump target instruction index */
+	const char	*argv[RC_MAX_ARGS];
+};
+
+struct rc_script {
+	const char		*name;
+	const struct rc_insn	*insns;
+};
+
+/* generated by rc_compile.py, NULL-name terminated */
+extern const struct rc_script rc_compiled_scripts[];
+
+#endif /* _SYSTEMCMDS_RC_SCRIPT_H */
@@ -0,0 +1,274 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file startup.c
+ *
+ * Execute startup scripts compiled into flat instruction tables at
+ * build time (see rc_compile.py). Commands are started directly from
+ * the builtin table instead of going through nsh line parsing, so no
+ * interpreter instance is spawned per script line.
+ */
+
+#include <px4_config.h>
+#include <px4_getopt.h>
+#include <px4_log.h>
+#include <px4_module.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <sys/wait.h>
+
+#include <nuttx/binfmt/builtin.h>
+
+#include <drivers/drv_hrt.h>
+
+#include "rc_script.h"
+
+/* generated builtin command table, see builtin_commands.c.in */
+extern const struct builtin_s g_builtins[];
+extern const int g_builtin_count;
+
+__EXPORT int startup_main(int argc, char *argv[]);
+
+#define RC_MAX_VARS	8
+
+struct rc_var {
+	char	name[16];
+	char	value[16];
+};
+
+static struct rc_var	_vars[RC_MAX_VARS];
+static unsigned		_num_vars;
+static bool		_verbose;
+
+static const char *
+expand(const char *arg)
+{
+	if (arg[0] != '$') {
+		return arg;
+	}
+
+	for (unsigned i = 0; i < _num_vars; i++) {
+		if (strcmp(_vars[i].name, &arg[1]) == 0) {
+			return _vars[i].value;
+		}
+	}
+
+	return "";
+}
+
+static void
+set_var(const char *name, const char *value)
+{
+	for (unsigned i = 0; i < _num_vars; i++) {
+		if (strcmp(_vars[i].name, name) == 0) {
+			strncpy(_vars[i].value, value, sizeof(_vars[i].value) - 1);
+			return;
+		}
+	}
+
+	if (_num_vars < RC_MAX_VARS) {
+		strncpy(_vars[_num_vars].name, name, sizeof(_vars[_num_vars].name) - 1);
+		strncpy(_vars[_num_vars].value, value, sizeof(_vars[_num_vars].value) - 1);
+		_num_vars++;
+
+	} else {
+		PX4_ERR("out of script variables, ignoring %s", name);
+	}
+}
+
+static int
+run_command(unsigned nargs, const char *cmd_argv[])
+{
+	const char *expanded[RC_MAX_ARGS + 1];
+
+	for (unsigned i = 0; i < nargs; i++) {
+		expanded[i] = expand(cmd_argv[i]);
+	}
+
+	expanded[nargs] = NULL;
+
+	const struct builtin_s *b = NULL;
+
+	for (int i = 0; i < g_builtin_count; i++) {
+		if (strcmp(g_builtins[i].name, expanded[0]) == 0) {
+			b = &g_builtins[i];
+			break;
+		}
+	}
+
+	if (b == NULL) {
+		PX4_ERR("unknown command: %s", expanded[0]);
+		return -1;
+	}
+
+	int pid = task_create(b->name, b->priority, b->stacksize, b->main,
+			      (FAR char * const *)&expanded[1]);
+
+	if (pid < 0) {
+		PX4_ERR("failed to start %s", expanded[0]);
+		return -1;
+	}
+
+	int status = -1;
+	int rv = -1;
+
+	if (waitpid(pid, &status, 0) == pid && WIFEXITED(status)) {
+		rv = WEXITSTATUS(status);
+	}
+
+	if (_verbose) {
+		PX4_INFO("%s: %d", expanded[0], rv);
+	}
+
+	return rv;
+}
+
+static int
+run_script(const struct rc_script *script)
+{
+	const struct rc_insn *insns = script->insns;
+	hrt_abstime start_time = hrt_absolute_time();
+	unsigned ip = 0;
+
+	_num_vars = 0;
+
+	while (insns[ip].op != RC_OP_END) {
+		const struct rc_insn *insn = &insns[ip];
+		bool taken = true;
+
+		switch (insn->op) {
+		case RC_OP_EXEC:
+			run_command(insn->nargs, insn->argv);
+			break;
+
+		case RC_OP_TEST:
+			taken = (run_command(insn->nargs, insn->argv) == 0);
+			break;
+
+		case RC_OP_TEST_VAR: {
+				bool equal = (strcmp(expand(insn->argv[0]), expand(insn->argv[2])) == 0);
+				taken = (insn->argv[1][0] == '=') ? equal : !equal;
+				break;
+			}
+
+		case RC_OP_JUMP:
+			taken = false;
+			break;
+
+		case RC_OP_SET:
+			set_var(insn->argv[0], expand(insn->argv[1]));
+			break;
+
+		default:
+			PX4_ERR("%s: bad opcode %u at %u", script->name, insn->op, ip);
+			return 1;
+		}
+
+		if (taken) {
+			ip++;
+
+		} else {
+			if (insn->target < 0) {
+				PX4_ERR("%s: bad jump target at %u", script->name, ip);
+				return 1;
+			}
+
+			ip = insn->target;
+		}
+	}
+
+	PX4_INFO("%s: done in %llu ms", script->name,
+		 (unsigned long long)(hrt_absolute_time() - start_time) / 1000);
+
+	return 0;
+}
+
+static void
+print_usage(void)
+{
+	PRINT_MODULE_DESCRIPTION("Run a startup script compiled into the firmware at build time.\n"
+				 "\n"
+				 "Unlike 'sh', no nsh interpreter instance is spawned per script line,\n"
+				 "which cuts the script overhead out of the boot time. The available\n"
+				 "scripts are translated from ROMFS/px4fmu_common/init.d by rc_compile.py.");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("startup", "command");
+	PRINT_MODULE_USAGE_PARAM_FLAG('v', "Print each command and its exit code", true);
+	PRINT_MODULE_USAGE_ARG("<script>", "Name of the compiled script, e.g. 'sensors'", true);
+}
+
+int
+startup_main(int argc, char *argv[])
+{
+	int ch;
+	int myoptind = 1;
+	const char *myoptarg = NULL;
+
+	_verbose = false;
+
+	while ((ch = px4_getopt(argc, argv, "v", &myoptind, &myoptarg)) != -1) {
+		switch (ch) {
+		case 'v':
+			_verbose = true;
+			break;
+
+		default:
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (myoptind >= argc) {
+		print_usage();
+
+		PX4_INFO("compiled scripts:");
+
+		for (const struct rc_script *s = rc_compiled_scripts; s->name != NULL; s++) {
+			PX4_INFO("  %s", s->name);
+		}
+
+		return 1;
+	}
+
+	for (const struct rc_script *s = rc_compiled_scripts; s->name != NULL; s++) {
+		if (strcmp(s->name, argv[myoptind]) == 0) {
+			return run_script(s);
+		}
+	}
+
+	PX4_ERR("unknown script: %s", argv[myoptind]);
+	return 1;
+}
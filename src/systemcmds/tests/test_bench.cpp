@@ -0,0 +1,294 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_bench.cpp
+ * Microbenchmarks for the hot code paths, to track cycle cost regressions
+ * across firmware releases.
+ *
+ * Each benchmark prints one machine-readable line
+ *
+ *     BENCH,<name>,<iterations>,<min_ns>,<median_ns>,<mean_ns>
+ *
+ * so results can be collected and diffed in CI and on real boards.
+ */
+
+#include <px4_config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <drivers/drv_hrt.h>
+#include <lib/ecl/validation/data_validator_group.h>
+#include <systemlib/mixer/mixer.h>
+#include <systemlib/param/param.h>
+#include <geo/geo.h>
+#include <geo_lookup/geo_mag_declination.h>
+#include <mathlib/mathlib.h>
+#include <uORB/uORB.h>
+
+#include "tests_main.h"
+
+/* matches the definition in uORBTest_UnitTest.cpp */
+struct orb_test_data {
+	int val;
+	hrt_abstime time;
+};
+ORB_DECLARE(orb_test);
+
+namespace
+{
+
+constexpr unsigned BENCH_WARMUP = 10;	/* batches run before measuring */
+constexpr unsigned BENCH_SAMPLES = 50;	/* timed batches per benchmark */
+constexpr unsigned BENCH_BATCH = 100;	/* iterations per timed batch */
+
+/* results are accumulated here so the compiler cannot optimize the
+ * benchmarked calls away */
+volatile float float_sink = 0.0f;
+volatile int int_sink = 0;
+
+int compare_u64(const void *a, const void *b)
+{
+	const uint64_t va = *(const uint64_t *)a;
+	const uint64_t vb = *(const uint64_t *)b;
+	return (va > vb) - (va < vb);
+}
+
+/* Run func BENCH_BATCH times per sample and report per-iteration times in
+ * nanoseconds. The batch amortizes the hrt sampling overhead and gives
+ * sub-microsecond resolution; min and median are robust against preemption
+ * by higher priority tasks. */
+template<typename F>
+void run_bench(const char *name, F func)
+{
+	uint64_t samples[BENCH_SAMPLES];
+
+	for (unsigned i = 0; i < BENCH_WARMUP; i++) {
+		func();
+	}
+
+	for (unsigned s = 0; s < BENCH_SAMPLES; s++) {
+		const hrt_abstime start = hrt_absolute_time();
+
+		for (unsigned i = 0; i < BENCH_BATCH; i++) {
+			func();
+		}
+
+		samples[s] = hrt_elapsed_time(&start);
+	}
+
+	qsort(samples, BENCH_SAMPLES, sizeof(samples[0]), compare_u64);
+
+	uint64_t sum = 0;
+
+	for (unsigned s = 0; s < BENCH_SAMPLES; s++) {
+		sum += samples[s];
+	}
+
+	const uint64_t min_ns = samples[0] * 1000 / BENCH_BATCH;
+	const uint64_t median_ns = samples[BENCH_SAMPLES / 2] * 1000 / BENCH_BATCH;
+	const uint64_t mean_ns = sum * 1000 / (BENCH_SAMPLES * BENCH_BATCH);
+
+	printf("BENCH,%s,%u,%llu,%llu,%llu\n", name, BENCH_SAMPLES * BENCH_BATCH,
+	       (unsigned long long)min_ns, (unsigned long long)median_ns,
+	       (unsigned long long)mean_ns);
+}
+
+float bench_controls[4] = { 0.1f, -0.05f, 0.02f, 0.6f };
+
+int bench_mixer_callback(uintptr_t handle, uint8_t control_group, uint8_t control_index, float &control)
+{
+	if (control_group != 0 || control_index >= 4) {
+		return -1;
+	}
+
+	control = bench_controls[control_index];
+	return 0;
+}
+
+void bench_mixer()
+{
+	MixerGroup mixer_group(bench_mixer_callback, 0);
+
+	const char *quad_x = "R: 4x 10000 10000 10000 0\n";
+	char buf[64];
+	strncpy(buf, quad_x, sizeof(buf) - 1);
+	buf[sizeof(buf) - 1] = '\0';
+	unsigned buflen = strlen(buf);
+
+	if (mixer_group.load_from_buf(buf, buflen) != 0) {
+		printf("BENCH,mixer_mix,SKIP (mixer load failed)\n");
+		return;
+	}
+
+	float outputs[8];
+
+	run_bench("mixer_mix", [&]() {
+		/* vary the inputs slightly so the saturation logic is exercised */
+		bench_controls[3] = (bench_controls[3] > 0.9f) ? 0.2f : bench_controls[3] + 0.001f;
+		mixer_group.mix(outputs, 8, nullptr);
+		float_sink += outputs[0];
+	});
+}
+
+void bench_projection()
+{
+	struct map_projection_reference_s ref;
+	map_projection_init(&ref, 47.3977, 8.5456);
+
+	double lat = 47.3977;
+	double lon = 8.5456;
+	float x, y;
+
+	run_bench("map_projection_project", [&]() {
+		lat += 1e-6;
+		lon += 1e-6;
+		map_projection_project(&ref, lat, lon, &x, &y);
+		float_sink += x + y;
+	});
+}
+
+void bench_orb()
+{
+	struct orb_test_data sample = {};
+	orb_advert_t pub = orb_advertise(ORB_ID(orb_test), &sample);
+	int sub = orb_subscribe(ORB_ID(orb_test));
+
+	if (pub == nullptr || sub < 0) {
+		printf("BENCH,orb_pub_copy,SKIP (advertise/subscribe failed)\n");
+		return;
+	}
+
+	run_bench("orb_pub_copy", [&]() {
+		sample.val++;
+		orb_publish(ORB_ID(orb_test), pub, &sample);
+		struct orb_test_data received;
+		orb_copy(ORB_ID(orb_test), sub, &received);
+		int_sink += received.val;
+	});
+
+	orb_unsubscribe(sub);
+	orb_unadvertise(pub);
+}
+
+void bench_param()
+{
+	param_t handle = param_find("SYS_AUTOSTART");
+
+	if (handle == PARAM_INVALID) {
+		printf("BENCH,param_get,SKIP (SYS_AUTOSTART not found)\n");
+		return;
+	}
+
+	int32_t value;
+
+	run_bench("param_get", [&]() {
+		param_get(handle, &value);
+		int_sink += value;
+	});
+}
+
+void bench_declination()
+{
+	float lat = -60.0f;
+
+	run_bench("mag_declination", [&]() {
+		lat += 0.1f;
+
+		if (lat > 60.0f) {
+			lat = -60.0f;
+		}
+
+		float_sink += get_mag_declination(lat, 8.5f);
+	});
+}
+
+void bench_matrix()
+{
+	math::Matrix<3, 3> a;
+	math::Matrix<3, 3> b;
+	a.identity();
+	b.identity();
+	a(0, 1) = 0.1f;
+	b(1, 2) = -0.2f;
+
+	run_bench("matrix3_mul", [&]() {
+		b(0, 0) += 1e-6f;
+		math::Matrix<3, 3> c = a * b;
+		float_sink += c(2, 2);
+	});
+}
+
+void bench_voting()
+{
+	/* three siblings, matching a triple-redundant IMU setup. one put() per
+	 * sibling plus one vote approximates the per-sample cost the sensors
+	 * module pays at full rate. */
+	DataValidatorGroup voter(3);
+
+	float val[3][3] = {};
+	uint64_t timestamp = hrt_absolute_time();
+
+	run_bench("sensor_vote_3", [&]() {
+		timestamp += 1000;
+
+		for (unsigned s = 0; s < 3; s++) {
+			val[s][0] += 0.001f;
+			val[s][1] -= 0.001f;
+			voter.put(s, timestamp, val[s], 0, 100 - s);
+		}
+
+		int best_index = -1;
+		voter.get_best(timestamp, &best_index);
+		int_sink += best_index;
+	});
+}
+
+} // namespace
+
+int test_bench(int argc, char *argv[])
+{
+	printf("BENCH,name,iterations,min_ns,median_ns,mean_ns\n");
+
+	bench_mixer();
+	bench_projection();
+	bench_orb();
+	bench_param();
+	bench_declination();
+	bench_matrix();
+	bench_voting();
+
+	return 0;
+}
@@ -54,6 +54,7 @@
 static const bool sample_bool = true;
 static const int32_t sample_small_int = 123;
 static const int64_t sample_big_int = (int64_t)INT_MAX + 123LL;
+static const int32_t sample_negative_int = -4567;
 static const double sample_double = 2.5f;
 static const char *sample_string = "this is a test";
 static const uint8_t sample_data[256] = {0};
@@ -77,6 +78,11 @@ encode(bson_encoder_t encoder)
 		return 1;
 	}
 
+	if (bson_encoder_append_varint(encoder, "varint1", sample_negative_int) != 0) {
+		PX4_ERR("FAIL: encoder: append varint failed");
+		return 1;
+	}
+
 	if (bson_encoder_append_double(encoder, "double1", sample_double) != 0) {
 		PX4_ERR("FAIL: encoder: append double failed");
 		return 1;
@@ -149,6 +155,21 @@ decode_callback(bson_decoder_t decoder, void *private, bson_node_t node)
 		return 1;
 	}
 
+	if (!strcmp(node->name, "varint1")) {
+		if (node->type != BSON_VARINT) {
+			PX4_ERR("FAIL: decoder: varint1 type %d, expected %d", node->type, BSON_VARINT);
+			return 1;
+		}
+
+		if (node->i != sample_negative_int) {
+			PX4_ERR("FAIL: decoder: varint1 value %" PRIu64 ", expected %d", node->i, sample_negative_int);
+			return 1;
+		}
+
+		warnx("PASS: decoder: varint1");
+		return 1;
+	}
+
 	if (!strcmp(node->name, "double1")) {
 		if (node->type != BSON_DOUBLE) {
 			PX4_ERR("FAIL: decoder: double1 type %d, expected %d", node->type, BSON_DOUBLE);
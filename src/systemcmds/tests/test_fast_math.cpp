@@ -0,0 +1,193 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_fast_math.cpp
+ *
+ * Accuracy audit and latency comparison for the math::fast_* transcendental
+ * approximations (FastMath.hpp) against libm. The asserted bounds here are
+ * the ones documented in the header; code adopting the approximations may
+ * rely on them.
+ */
+
+#include <unit_test.h>
+
+#include <drivers/drv_hrt.h>
+#include <mathlib/mathlib.h>
+
+#include <math.h>
+#include <stdio.h>
+
+namespace
+{
+
+/* keeps the timed loops from being optimized away */
+volatile float fast_math_sink = 0.0f;
+
+} // namespace
+
+class FastMathTest : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool accuracy_sincos();
+	bool accuracy_atan2();
+	bool accuracy_asin();
+	bool latency();
+};
+
+bool FastMathTest::accuracy_sincos()
+{
+	float max_err = 0.0f;
+
+	/* sweep the full range the documented bound covers */
+	for (float x = -50.0f; x <= 50.0f; x += 1e-3f) {
+		float s;
+		float c;
+		math::fast_sincosf(x, s, c);
+
+		max_err = fmaxf(max_err, fabsf(s - sinf(x)));
+		max_err = fmaxf(max_err, fabsf(c - cosf(x)));
+		max_err = fmaxf(max_err, fabsf(math::fast_sinf(x) - sinf(x)));
+		max_err = fmaxf(max_err, fabsf(math::fast_cosf(x) - cosf(x)));
+	}
+
+	printf("fast_sincosf max error: %.3g\n", (double)max_err);
+	ut_assert("fast sin/cos error exceeds 1e-5", max_err < 1e-5f);
+
+	return true;
+}
+
+bool FastMathTest::accuracy_atan2()
+{
+	float max_err = 0.0f;
+
+	for (float y = -1.0f; y <= 1.0f; y += 5e-3f) {
+		for (float x = -1.0f; x <= 1.0f; x += 5e-3f) {
+			if (fabsf(x) < 1e-6f && fabsf(y) < 1e-6f) {
+				continue;
+			}
+
+			max_err = fmaxf(max_err, fabsf(math::fast_atan2f(y, x) - atan2f(y, x)));
+		}
+	}
+
+	printf("fast_atan2f max error: %.3g rad\n", (double)max_err);
+	ut_assert("fast_atan2f error exceeds 1e-5 rad", max_err < 1e-5f);
+
+	return true;
+}
+
+bool FastMathTest::accuracy_asin()
+{
+	float max_err = 0.0f;
+
+	for (float x = -1.0f; x <= 1.0f; x += 1e-4f) {
+		max_err = fmaxf(max_err, fabsf(math::fast_asinf(x) - asinf(x)));
+	}
+
+	printf("fast_asinf max error: %.3g rad\n", (double)max_err);
+	ut_assert("fast_asinf error exceeds 1e-4 rad", max_err < 1e-4f);
+
+	return true;
+}
+
+bool FastMathTest::latency()
+{
+	const unsigned iterations = 10000;
+
+	float acc = 0.0f;
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		acc += sinf(0.001f * i);
+	}
+
+	fast_math_sink = acc;
+	const hrt_abstime libm_elapsed = hrt_elapsed_time(&start);
+
+	acc = 0.0f;
+	start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		acc += math::fast_sinf(0.001f * i);
+	}
+
+	fast_math_sink = acc;
+	const hrt_abstime fast_elapsed = hrt_elapsed_time(&start);
+
+	printf("sinf: libm %llu ns/call, fast %llu ns/call\n",
+	       (unsigned long long)(libm_elapsed * 1000 / iterations),
+	       (unsigned long long)(fast_elapsed * 1000 / iterations));
+
+	acc = 0.0f;
+	start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		acc += atan2f(0.001f * i, 1.0f);
+	}
+
+	fast_math_sink = acc;
+	const hrt_abstime libm_atan2_elapsed = hrt_elapsed_time(&start);
+
+	acc = 0.0f;
+	start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < iterations; i++) {
+		acc += math::fast_atan2f(0.001f * i, 1.0f);
+	}
+
+	fast_math_sink = acc;
+	const hrt_abstime fast_atan2_elapsed = hrt_elapsed_time(&start);
+
+	printf("atan2f: libm %llu ns/call, fast %llu ns/call\n",
+	       (unsigned long long)(libm_atan2_elapsed * 1000 / iterations),
+	       (unsigned long long)(fast_atan2_elapsed * 1000 / iterations));
+
+	/* informational only: relative speed depends on the libm in use */
+	return true;
+}
+
+bool FastMathTest::run_tests()
+{
+	ut_run_test(accuracy_sincos);
+	ut_run_test(accuracy_atan2);
+	ut_run_test(accuracy_asin);
+	ut_run_test(latency);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_fast_math, FastMathTest)
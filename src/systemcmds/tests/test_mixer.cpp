@@ -110,6 +110,7 @@ public:
 
 private:
 	bool mixerTest();
+	bool mixerQ16Test();
 	bool loadIOPass();
 	bool loadVTOL1Test();
 	bool loadVTOL2Test();
@@ -137,6 +138,7 @@ bool MixerTest::run_tests()
 	ut_run_test(loadComplexTest);
 	ut_run_test(loadAllTest);
 	ut_run_test(mixerTest);
+	ut_run_test(mixerQ16Test);
 
 	return (_tests_failed == 0);
 }
@@ -587,6 +589,70 @@ bool MixerTest::mixerTest()
 	return true;
 }
 
+bool MixerTest::mixerQ16Test()
+{
+	/* build a quad mixer directly so the float and the Q16.16 path (which the
+	 * px4io build selects via MIXER_USE_FIXED_POINT) run on the same instance */
+	const char *buf = "R: 4x 10000 10000 10000 0\n";
+	unsigned buflen = strlen(buf);
+
+	MultirotorMixer *mixer = MultirotorMixer::from_text(mixer_callback, 0, buf, buflen);
+
+	if (mixer == nullptr) {
+		PX4_ERR("failed to create multirotor mixer");
+		return false;
+	}
+
+	should_prearm = false;
+
+	bool ret = true;
+
+	float outputs_float[output_max];
+	float outputs_q16[output_max];
+	uint16_t status_float;
+	uint16_t status_q16;
+
+	/* sweep roll/pitch/yaw/thrust through their ranges, including saturating
+	 * combinations that exercise the boost and yaw rescaling branches */
+	for (int r = -2; r <= 2 && ret; r++) {
+		for (int p = -2; p <= 2 && ret; p++) {
+			for (int y = -2; y <= 2 && ret; y++) {
+				for (int t = 0; t <= 4 && ret; t++) {
+					actuator_controls[0] = r * 0.5f;
+					actuator_controls[1] = p * 0.5f;
+					actuator_controls[2] = y * 0.5f;
+					actuator_controls[3] = t * 0.25f;
+
+					unsigned mixed_float = mixer->mix(&outputs_float[0], output_max, &status_float);
+					unsigned mixed_q16 = mixer->mix_q16(&outputs_q16[0], output_max, &status_q16);
+
+					if (mixed_float != mixed_q16) {
+						PX4_ERR("q16 mixer output count mismatch: %u vs %u", mixed_float, mixed_q16);
+						ret = false;
+						break;
+					}
+
+					for (unsigned i = 0; i < mixed_float; i++) {
+						if (fabsf(outputs_float[i] - outputs_q16[i]) > 0.005f) {
+							fprintf(stderr, "\t %u: float: %8.4f, q16: %8.4f (controls %.2f %.2f %.2f %.2f)\n",
+								i, (double)outputs_float[i], (double)outputs_q16[i],
+								(double)actuator_controls[0], (double)actuator_controls[1],
+								(double)actuator_controls[2], (double)actuator_controls[3]);
+							PX4_ERR("q16 mixer diverged from float mixer");
+							ret = false;
+							break;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	delete mixer;
+
+	return ret;
+}
+
 static int
 mixer_callback(uintptr_t handle, uint8_t control_group, uint8_t control_index, float &control)
 {
@@ -102,9 +102,11 @@ const struct {
 #endif /* __PX4_DARWIN */
 	{"mixer",		test_mixer,	OPT_NOJIGTEST},
 	{"autodeclination",	test_autodeclination,	0},
+	{"bench",		test_bench,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"bson",		test_bson,	0},
 	{"conv",		test_conv, 0},
 	{"dataman",		test_dataman, OPT_NOJIGTEST | OPT_NOALLTEST},
+	{"fast_math",		test_fast_math,	0},
 	{"file2",		test_file2,	OPT_NOJIGTEST},
 	{"float",		test_float,	0},
 	{"gpio",		test_gpio,	OPT_NOJIGTEST | OPT_NOALLTEST},
@@ -54,10 +54,12 @@ __BEGIN_DECLS
 
 extern int	test_adc(int argc, char *argv[]);
 extern int	test_autodeclination(int argc, char *argv[]);
+extern int	test_bench(int argc, char *argv[]);
 extern int	test_hysteresis(int argc, char *argv[]);
 extern int	test_bson(int argc, char *argv[]);
 extern int	test_conv(int argc, char *argv[]);
 extern int	test_dataman(int argc, char *argv[]);
+extern int	test_fast_math(int argc, char *argv[]);
 extern int	test_file(int argc, char *argv[]);
 extern int	test_file2(int argc, char *argv[]);
 extern int	test_float(int argc, char *argv[]);
@@ -9,61 +9,39 @@ import re
 
 # argv[1] must be the full path of the top Firmware dir
 
+# Instead of one if/else branch with inlined print statements per topic, the
+# generated code consists of compact data tables: one field descriptor table
+# per topic (type, array length, struct offset, name) and one topic table
+# sorted by name, walked by a small generic printer. The topic lookup is a
+# binary search over the sorted table.
+
 raw_messages = glob.glob(sys.argv[1]+"/msg/*.msg")
 messages = []
 message_elements = []
 
+# field type tags, must match the listener_field_type enum below
+simple_types = ["bool", "uint8", "int8", "uint16", "int16",
+		"uint32", "int32", "uint64", "int64", "float32", "float64"]
 
 for index,m in enumerate(raw_messages):
-	temp_list_floats = []
-	temp_list_uint64 = []
-	temp_list_bool = []
 	if("pwm_input" not in m and "position_setpoint" not in m):
 		temp_list = []
 		f = open(m,'r')
 		for line in f.readlines():
 			items = re.split('\s+', line.strip())
 
-			if ('float32[' in items[0]):
-				num_floats = int(items[0].split("[")[1].split("]")[0])
-				temp_list.append(("float_array",items[1],num_floats))
-			elif ('float64[' in items[0]):
-				num_floats = int(items[0].split("[")[1].split("]")[0])
-				temp_list.append(("double_array",items[1],num_floats))
-			elif ('uint64[' in items[0]):
-				num_floats = int(items[0].split("[")[1].split("]")[0])
-				temp_list.append(("uint64_array",items[1],num_floats))
-			elif ('uint16[' in items[0]):
-				num_floats = int(items[0].split("[")[1].split("]")[0])
-				temp_list.append(("uint16_array",items[1],num_floats))
-			elif ('int32[' in items[0]):
-				num_floats = int(items[0].split("[")[1].split("]")[0])
-				temp_list.append(("int32_array",items[1],num_floats))
-			elif ('int16[' in items[0]):
-				num_floats = int(items[0].split("[")[1].split("]")[0])
-				temp_list.append(("int16_array",items[1],num_floats))
-			elif(items[0] == "float32"):
-				temp_list.append(("float",items[1]))
-			elif(items[0] == "float64"):
-				temp_list.append(("double",items[1]))
-			elif(items[0] == "uint64") and len(line.split('=')) == 1:
-				temp_list.append(("uint64",items[1]))
-			elif(items[0] == "uint32") and len(line.split('=')) == 1:
-				temp_list.append(("uint32",items[1]))
-			elif(items[0] == "uint16") and len(line.split('=')) == 1:
-				temp_list.append(("uint16",items[1]))
-			elif(items[0] == "int64") and len(line.split('=')) == 1:
-				temp_list.append(("int64",items[1]))
-			elif(items[0] == "int32") and len(line.split('=')) == 1:
-				temp_list.append(("int32",items[1]))
-			elif(items[0] == "int16") and len(line.split('=')) == 1:
-				temp_list.append(("int16",items[1]))
-			elif (items[0] == "bool") and len(line.split('=')) == 1:
-				temp_list.append(("bool",items[1]))
-			elif (items[0] == "uint8") and len(line.split('=')) == 1:
-				temp_list.append(("uint8",items[1]))
-			elif (items[0] == "int8") and len(line.split('=')) == 1:
-				temp_list.append(("int8",items[1]))
+			if len(items) < 2 or len(line.split('=')) != 1:
+				continue
+
+			if '[' in items[0]:
+				base_type = items[0].split("[")[0]
+				count = int(items[0].split("[")[1].split("]")[0])
+			else:
+				base_type = items[0]
+				count = 1
+
+			if base_type in simple_types:
+				temp_list.append((base_type, items[1], count))
 
 		f.close()
 		(m_head, m_tail) = os.path.split(m)
@@ -71,9 +49,9 @@ for index,m in enumerate(raw_messages):
 		if message != "actuator_controls":
 			messages.append(message)
 			message_elements.append(temp_list)
-		#messages.append(m.split('/')[-1].split('.')[0])
 
-num_messages = len(messages);
+# sorted by name so the runtime lookup can binary search
+topics = sorted(zip(messages, message_elements))
 
 print("""
 
@@ -124,6 +102,7 @@ print("""
 #include <px4_config.h>
 #include <uORB/uORB.h>
 #include <string.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -146,115 +125,231 @@ static bool check_timeout(const hrt_abstime& time) {
 }
 
 """)
-for m in messages:
+for (m, elements) in topics:
 	print("#include <uORB/topics/%s.h>" % m)
 
+print("""
+enum listener_field_type : uint8_t {
+	FIELD_BOOL = 0,
+	FIELD_UINT8,
+	FIELD_INT8,
+	FIELD_UINT16,
+	FIELD_INT16,
+	FIELD_UINT32,
+	FIELD_INT32,
+	FIELD_UINT64,
+	FIELD_INT64,
+	FIELD_FLOAT,
+	FIELD_DOUBLE,
+};
+
+struct listener_field {
+	uint8_t type;		///< one of listener_field_type
+	uint8_t count;		///< array length, 1 for scalars
+	uint16_t offset;	///< byte offset of the field in the topic struct
+	const char *name;
+};
+
+struct listener_topic {
+	const char *name;
+	const struct orb_metadata *meta;
+	const listener_field *fields;
+	unsigned num_fields;
+};
+""")
+
+type_tags = {"bool": "FIELD_BOOL", "uint8": "FIELD_UINT8", "int8": "FIELD_INT8",
+	     "uint16": "FIELD_UINT16", "int16": "FIELD_INT16",
+	     "uint32": "FIELD_UINT32", "int32": "FIELD_INT32",
+	     "uint64": "FIELD_UINT64", "int64": "FIELD_INT64",
+	     "float32": "FIELD_FLOAT", "float64": "FIELD_DOUBLE"}
+
+for (m, elements) in topics:
+	print("static const listener_field fields_%s[] = {" % m)
+	for (field_type, name, count) in elements:
+		print("\t{%s, %u, (uint16_t)offsetof(struct %s_s, %s), \"%s\"}," %
+		      (type_tags[field_type], count, m, name, name))
+	print("};")
+	print("")
+
+print("static const listener_topic listener_topics[] = {")
+for (m, elements) in topics:
+	print("\t{\"%s\", ORB_ID(%s), fields_%s, %u}," % (m, m, m, len(elements)))
+print("};")
 
 print("""
+static const listener_topic *find_topic(const char *name)
+{
+	int low = 0;
+	int high = (int)(sizeof(listener_topics) / sizeof(listener_topics[0])) - 1;
+
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		int cmp = strcmp(name, listener_topics[mid].name);
+
+		if (cmp == 0) {
+			return &listener_topics[mid];
+
+		} else if (cmp < 0) {
+			high = mid - 1;
+
+		} else {
+			low = mid + 1;
+		}
+	}
+
+	return nullptr;
+}
+
+static void print_field(const listener_field &field, const uint8_t *data)
+{
+	const uint8_t *ptr = data + field.offset;
+	printf("%s: ", field.name);
+
+	for (unsigned j = 0; j < field.count; j++) {
+		switch (field.type) {
+		case FIELD_BOOL: {
+				printf("%s ", *ptr ? "True" : "False");
+				ptr += sizeof(bool);
+				break;
+			}
+
+		case FIELD_UINT8: {
+				printf("%u ", (unsigned)*ptr);
+				ptr += sizeof(uint8_t);
+				break;
+			}
+
+		case FIELD_INT8: {
+				printf("%d ", (int)(int8_t)*ptr);
+				ptr += sizeof(int8_t);
+				break;
+			}
+
+		case FIELD_UINT16: {
+				uint16_t v;
+				memcpy(&v, ptr, sizeof(v));
+				printf("%u ", (unsigned)v);
+				ptr += sizeof(v);
+				break;
+			}
+
+		case FIELD_INT16: {
+				int16_t v;
+				memcpy(&v, ptr, sizeof(v));
+				printf("%d ", (int)v);
+				ptr += sizeof(v);
+				break;
+			}
+
+		case FIELD_UINT32: {
+				uint32_t v;
+				memcpy(&v, ptr, sizeof(v));
+				printf("%u ", (unsigned)v);
+				ptr += sizeof(v);
+				break;
+			}
+
+		case FIELD_INT32: {
+				int32_t v;
+				memcpy(&v, ptr, sizeof(v));
+				printf("%d ", (int)v);
+				ptr += sizeof(v);
+				break;
+			}
+
+		case FIELD_UINT64: {
+				uint64_t v;
+				memcpy(&v, ptr, sizeof(v));
+				printf("%\" PRIu64 \" ", v);
+				ptr += sizeof(v);
+				break;
+			}
+
+		case FIELD_INT64: {
+				int64_t v;
+				memcpy(&v, ptr, sizeof(v));
+				printf("%\" PRId64 \" ", v);
+				ptr += sizeof(v);
+				break;
+			}
+
+		case FIELD_FLOAT: {
+				float v;
+				memcpy(&v, ptr, sizeof(v));
+				printf("%8.4f ", (double)v);
+				ptr += sizeof(v);
+				break;
+			}
+
+		case FIELD_DOUBLE: {
+				double v;
+				memcpy(&v, ptr, sizeof(v));
+				printf("%8.4f ", v);
+				ptr += sizeof(v);
+				break;
+			}
+		}
+	}
+
+	printf("\\n");
+}
+
 extern "C" __EXPORT int listener_main(int argc, char *argv[]);
 
 int listener_main(int argc, char *argv[]) {
-	int sub = -1;
-	orb_id_t ID;
-	if(argc < 2) {
+	if (argc < 2) {
 		printf("need at least two arguments: topic name. [optional number of messages to print] [optional instance]\\n");
 		return 1;
 	}
-""")
-print("\tunsigned num_msgs = (argc > 2) ? atoi(argv[2]) : 1;")
-print("\tunsigned topic_instance = (argc > 3) ? atoi(argv[3]) : 0;")
-print("\tif (strncmp(argv[1],\"%s\",50) == 0) {" % messages[0])
-print("\t\tsub = orb_subscribe_multi(ORB_ID(%s), topic_instance);" % messages[0])
-print("\t\tID = ORB_ID(%s);" % messages[0])
-print("\t\tstruct %s_s container;" % messages[0])
-print("\t\tmemset(&container, 0, sizeof(container));")
-for index,m in enumerate(messages[1:]):
-	print("\t} else if (strncmp(argv[1],\"%s\",50) == 0) {" % m)
-	print("\t\tsub = orb_subscribe_multi(ORB_ID(%s), topic_instance);" % m)
-	print("\t\tID = ORB_ID(%s);" % m)
-	print("\t\tstruct %s_s container;" % m)
-	print("\t\tmemset(&container, 0, sizeof(container));")
-	print("\t\tbool updated;")
-	print("\t\tunsigned i = 0;")
-	print("\t\thrt_abstime start_time = hrt_absolute_time();")
-	print("\t\twhile(i < num_msgs) {")
-	print("\t\t\torb_check(sub,&updated);")
-	print("\t\t\tif (i == 0) { updated = true; } else { usleep(500); }")
-	print("\t\t\tif (updated) {")
-	print("\t\t\tstart_time = hrt_absolute_time();")
-	print("\t\t\ti++;")
-	print("\t\t\tprintf(\"\\nTOPIC: %s instance %%d #%%d\\n\", topic_instance, i);" % m)
-	print("\t\t\torb_copy(ID,sub,&container);")
-	print("\t\t\tprintf(\"timestamp: %\" PRIu64 \"\\n\", container.timestamp);")
-	for item in message_elements[index+1]:
-		if item[0] == "float":
-			print("\t\t\tprintf(\"%s: %%8.4f\\n\",(double)container.%s);" % (item[1], item[1]))
-		elif item[0] == "float_array":
-			print("\t\t\tprintf(\"%s: \");" % item[1])
-			print("\t\t\tfor (int j = 0; j < %d; j++) {" % item[2])
-			print("\t\t\t\tprintf(\"%%8.4f \",(double)container.%s[j]);" % item[1])
-			print("\t\t\t}")
-			print("\t\t\tprintf(\"\\n\");")
-		elif item[0] == "double":
-			print("\t\t\tprintf(\"%s: %%8.4f\\n\",(double)container.%s);" % (item[1], item[1]))
-		elif item[0] == "double_array":
-			print("\t\t\tprintf(\"%s: \");" % item[1])
-			print("\t\t\tfor (int j = 0; j < %d; j++) {" % item[2])
-			print("\t\t\t\tprintf(\"%%8.4f \",(double)container.%s[j]);" % item[1])
-			print("\t\t\t}")
-			print("\t\t\tprintf(\"\\n\");")
-		elif item[0] == "uint64":
-			print("\t\t\tprintf(\"%s: %%\" PRIu64 \"\\n\",container.%s);" % (item[1], item[1]))
-		elif item[0] == "uint64_array":
-			print("\t\t\tprintf(\"%s: \");" % item[1])
-			print("\t\t\tfor (int j = 0; j < %d; j++) {" % item[2])
-			print("\t\t\t\tprintf(\"%%\" PRIu64 \" \",container.%s[j]);" % item[1])
-			print("\t\t\t}")
-			print("\t\t\tprintf(\"\\n\");")
-		elif item[0] == "uint16_array":
-			print("\t\t\tprintf(\"%s: \");" % item[1])
-			print("\t\t\tfor (int j = 0; j < %d; j++) {" % item[2])
-			print("\t\t\t\tprintf(\"%%u \",container.%s[j]);" % item[1])
-			print("\t\t\t}")
-			print("\t\t\tprintf(\"\\n\");")
-		elif item[0] == "int32_array":
-			print("\t\t\tprintf(\"%s: \");" % item[1])
-			print("\t\t\tfor (int j = 0; j < %d; j++) {" % item[2])
-			print("\t\t\t\tprintf(\"%%d \",container.%s[j]);" % item[1])
-			print("\t\t\t}")
-			print("\t\t\tprintf(\"\\n\");")
-		elif item[0] == "int16_array":
-			print("\t\t\tprintf(\"%s: \");" % item[1])
-			print("\t\t\tfor (int j = 0; j < %d; j++) {" % item[2])
-			print("\t\t\t\tprintf(\"%%d \",container.%s[j]);" % item[1])
-			print("\t\t\t}")
-			print("\t\t\tprintf(\"\\n\");")
-		elif item[0] == "int64":
-			print("\t\t\tprintf(\"%s: %%\" PRId64 \"\\n\",container.%s);" % (item[1], item[1]))
-		elif item[0] == "int32":
-			print("\t\t\tprintf(\"%s: %%d\\n\",container.%s);" % (item[1], item[1]))
-		elif item[0] == "uint32":
-			print("\t\t\tprintf(\"%s: %%u\\n\",container.%s);" % (item[1], item[1]))
-		elif item[0] == "int16":
-			print("\t\t\tprintf(\"%s: %%d\\n\",(int)container.%s);" % (item[1], item[1]))
-		elif item[0] == "uint16":
-			print("\t\t\tprintf(\"%s: %%u\\n\",(unsigned)container.%s);" % (item[1], item[1]))
-		elif item[0] == "int8":
-			print("\t\t\tprintf(\"%s: %%d\\n\",(int)container.%s);" % (item[1], item[1]))
-		elif item[0] == "uint8":
-			print("\t\t\tprintf(\"%s: %%u\\n\",(unsigned)container.%s);" % (item[1], item[1]))
-		elif item[0] == "bool":
-			print("\t\t\tprintf(\"%s: %%s\\n\",container.%s ? \"True\" : \"False\");" % (item[1], item[1]))
-	print("\t\t\t} else {")
-	print("\t\t\t\tif (check_timeout(start_time)) {")
-	print("\t\t\t\t\tbreak;")
-	print("\t\t\t\t}")
-	print("\t\t\t}")
-	print("\t\t}")
-print("\t} else {")
-print("\t\t printf(\" Topic did not match any known topics\\n\");")
-print("\t}")
-print("\t\torb_unsubscribe(sub);")
-print("\t return 0;")
-
-print("}")
+
+	unsigned num_msgs = (argc > 2) ? atoi(argv[2]) : 1;
+	unsigned topic_instance = (argc > 3) ? atoi(argv[3]) : 0;
+
+	const listener_topic *topic = find_topic(argv[1]);
+
+	if (topic == nullptr) {
+		printf(" Topic did not match any known topics\\n");
+		return 1;
+	}
+
+	int sub = orb_subscribe_multi(topic->meta, topic_instance);
+	uint8_t *container = new uint8_t[topic->meta->o_size];
+
+	if (container == nullptr) {
+		orb_unsubscribe(sub);
+		return 1;
+	}
+
+	memset(container, 0, topic->meta->o_size);
+
+	bool updated = false;
+	unsigned i = 0;
+	hrt_abstime start_time = hrt_absolute_time();
+
+	while (i < num_msgs) {
+		orb_check(sub, &updated);
+
+		if (i == 0) { updated = true; } else { usleep(500); }
+
+		if (updated) {
+			start_time = hrt_absolute_time();
+			i++;
+			printf("\\nTOPIC: %s instance %d #%d\\n", topic->name, topic_instance, i);
+			orb_copy(topic->meta, sub, container);
+
+			for (unsigned f = 0; f < topic->num_fields; f++) {
+				print_field(topic->fields[f], container);
+			}
+
+		} else {
+			if (check_timeout(start_time)) {
+				break;
+			}
+		}
+	}
+
+	delete[] container;
+	orb_unsubscribe(sub);
+	return 0;
+}""")
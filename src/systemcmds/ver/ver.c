@@ -45,6 +45,8 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
+#include <uORB/uORB.h>
+#include <uORB/topics/system_version.h>
 #include <version/version.h>
 
 /* string constants for version commands */
@@ -59,6 +61,7 @@ static const char sz_ver_all_str[] 	= "all";
 static const char mcu_ver_str[]		= "mcu";
 static const char mcu_uid_str[]         = "uid";
 static const char mfg_uid_str[]         = "mfguid";
+static const char sz_ver_pub_str[]      = "publish";
 
 #if defined(PX4_CPU_UUID_WORD32_FORMAT)
 #  define CPU_UUID_FORMAT PX4_CPU_UUID_WORD32_FORMAT
@@ -91,6 +94,7 @@ static void usage(const char *reason)
 	PRINT_MODULE_USAGE_COMMAND_DESCR("uid", "UUID");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("mfguid", "Manufacturer UUID");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("uri", "Build URI");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("publish", "Publish the system_version topic (once during boot)");
 
 	PRINT_MODULE_USAGE_COMMAND_DESCR("all", "Print all versions");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("hwcmp", "Compare hardware version (returns 0 on match)");
@@ -145,6 +149,28 @@ int ver_main(int argc, char *argv[])
 				}
 			}
 
+			if (!strncmp(argv[1], sz_ver_pub_str, sizeof(sz_ver_pub_str))) {
+				/* publish the binary version descriptor, so onboard
+				 * consumers don't have to parse any of the text output */
+				struct system_version_s version;
+				memset(&version, 0, sizeof(version));
+
+				version.firmware_version = px4_firmware_version();
+				version.os_version = px4_os_version();
+				version.board_version = px4_board_version();
+				version.firmware_git_hash = px4_firmware_version_binary();
+				version.mavlink_lib_git_hash = px4_mavlink_lib_version_binary();
+
+				orb_advert_t pub = orb_advertise(ORB_ID(system_version), &version);
+
+				if (pub == NULL) {
+					PX4_ERR("advertising system_version failed");
+					return 1;
+				}
+
+				return 0;
+			}
+
 			/* check if we want to show all */
 			bool show_all = !strncmp(argv[1], sz_ver_all_str, sizeof(sz_ver_all_str));
 
@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file wqstat.c
+ *
+ * Print the dispatch statistics of the work queues, to diagnose queue
+ * starvation (items waiting on blocked or overloaded workers).
+ */
+
+#include <px4_config.h>
+#include <px4_module.h>
+#include <px4_workqueue.h>
+#include <stdio.h>
+#include <string.h>
+#include <drivers/drv_hrt.h>
+
+__EXPORT int wqstat_main(int argc, char *argv[]);
+
+static void print_usage(void)
+{
+	PRINT_MODULE_DESCRIPTION("Print work queue dispatch statistics.\n"
+				 "Latencies are how long items waited beyond their requested delay before\n"
+				 "their worker ran; large values mean the queue was starved and the drivers\n"
+				 "on it sampled late.");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("wqstat", "command");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("reset", "Reset the windowed worst-case latencies");
+}
+
+int
+wqstat_main(int argc, char *argv[])
+{
+#ifdef __PX4_NUTTX
+	/* the NuttX work queues live in the OS and are not instrumented */
+	printf("not supported on NuttX\n");
+	return 1;
+#else
+	bool reset = false;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") == 0) {
+			reset = true;
+
+		} else {
+			print_usage();
+			return 0;
+		}
+	}
+
+	static const char *names[NWORKERS] = {"hpwork", "lpwork"};
+	const hrt_abstime now = hrt_absolute_time();
+
+	printf("%-8s %10s %12s %12s %12s\n", "queue", "items", "worst (us)", "window (us)", "idle (us)");
+
+	for (int qid = 0; qid < NWORKERS; qid++) {
+		struct work_queue_stats_s stats;
+
+		if (work_queue_get_stats(qid, &stats, reset) != 0) {
+			continue;
+		}
+
+		printf("%-8s %10llu %12u %12u %12llu\n", names[qid],
+		       (unsigned long long)stats.items, stats.latency_worst, stats.latency_window_worst,
+		       (unsigned long long)(stats.last_dispatch > 0 ? now - stats.last_dispatch : 0));
+	}
+
+	return 0;
+#endif
+}